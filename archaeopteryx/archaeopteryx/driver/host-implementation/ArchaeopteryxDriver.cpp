@@ -7,6 +7,7 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/driver/interface/SimulatorKnobs.h>
 #include <archaeopteryx/driver/host-interface/ArchaeopteryxDriver.h>
+#include <archaeopteryx/executive/host-interface/HostSimulator.h>
 #include <archaeopteryx/util/host-interface/HostReflectionHost.h>
 
 // Ocelot Includes
@@ -28,15 +29,40 @@ void ArchaeopteryxDriver::runSimulation(const std::string& traceFileName,
 	const KnobList& knobs)
 {
 	_knobs = knobs;
-	
+
+	// the host backend interprets the binary directly, no device code
+	// or CUDA driver is involved
+	if(_useHostBackend())
+	{
+		executive::HostSimulator simulator;
+
+		simulator.runSimulation(traceFileName, _knobs);
+
+		return;
+	}
+
 	_loadTraceFile(traceFileName);
-	
+
 	_loadArchaeopteryxDeviceCode();
-	
+
 	_runSimulation();
-	
+
 	_unloadArchaeopteryxDeviceCode();
 }
+
+bool ArchaeopteryxDriver::_useHostBackend() const
+{
+	for(KnobList::const_iterator knob = _knobs.begin();
+		knob != _knobs.end(); ++knob)
+	{
+		if(knob->first == "simulator-backend")
+		{
+			return knob->second == "host";
+		}
+	}
+
+	return false;
+}
 	
 void ArchaeopteryxDriver::_loadTraceFile(const std::string& traceFileName)
 {
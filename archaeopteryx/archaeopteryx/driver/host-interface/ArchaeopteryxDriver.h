@@ -30,6 +30,9 @@ public:
 	void runSimulation(const std::string& traceFileName, const KnobList& knobs);
 
 private:
+	/*! \brief Did the knobs select the host simulation backend? */
+	bool _useHostBackend() const;
+
 	void _loadTraceFile(const std::string& traceFileName);
 	void _loadArchaeopteryxDeviceCode();
 	void _runSimulation();
@@ -56,6 +56,56 @@ __device__ static void loadDefaultKnobs()
 		new util::Knob("simulator-registers-per-thread", "64"));
 	util::KnobDatabase::addKnob(
 		new util::Knob("simulated-link-register", "63"));
+
+	// an empty file name leaves per-PC profiling off
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-instruction-profile", ""));
+
+	// a zero size leaves that level of the cache model off
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-l1-cache-size", "0"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-l1-cache-associativity", "4"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-l2-cache-size", "0"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-l2-cache-associativity", "8"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-cache-line-size", "128"));
+
+	// zero starts detailed simulation from the first instruction
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-fast-forward-instructions", "0"));
+
+	// zero turns periodic snapshots off, otherwise a checkpoint named
+	// 'prefix-N' is written every time this many instructions retire
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-snapshot-instructions", "0"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-snapshot-prefix", "snapshot"));
+
+	// naming a snapshot here replays its window with warp tracing on
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-replay-checkpoint", ""));
+
+	// multi device sharding, each simulator process simulates the CTAs
+	// in [id * ctas / count, (id + 1) * ctas / count)
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-partition-count", "1"));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-partition-id", "0"));
+
+	// naming a file here streams a compressed global address trace into
+	// it, the buffer drains whenever the launch stops
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-memory-trace", ""));
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-memory-trace-buffer-size", "16777216"));
+
+	// each hardware CTA bump allocates its simulated state out of a slab
+	// this large, 0 disables the slabs and falls back to device malloc
+	util::KnobDatabase::addKnob(
+		new util::Knob("simulator-block-slab-size", "65536"));
 }
 
 __device__ void ArchaeopteryxDeviceDriver::loadKnobs(
@@ -204,7 +254,8 @@ __device__ void ArchaeopteryxDeviceDriver::_runSimulation()
 	util::string argumentMemory = util::KnobDatabase::getKnob<util::string>(
 		"simulated-parameter-memory");
 
-	rt::Runtime::setupArgument(argumentMemory.data(), argumentMemory.size(), 0);
+	rt::Runtime::setupArgumentBlock(argumentMemory.data(),
+		argumentMemory.size());
 	
 	device_report(" parameter memory (%d bytes).\n", argumentMemory.size());
 	
@@ -0,0 +1,832 @@
+/*! \file   HostSimulator.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the HostSimulator class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/host-interface/HostSimulator.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/BinaryHeader.h>
+#include <vanaheimr/asm/interface/SymbolTableEntry.h>
+#include <vanaheimr/asm/interface/Instruction.h>
+#include <vanaheimr/asm/interface/Operand.h>
+
+// Standard Library Includes
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+typedef vanaheimr::as::BinaryHeader         BinaryHeader;
+typedef vanaheimr::as::InstructionContainer InstructionContainer;
+typedef vanaheimr::as::Instruction          Instruction;
+typedef vanaheimr::as::Operand              Operand;
+typedef vanaheimr::as::OperandContainer     OperandContainer;
+typedef vanaheimr::as::RegisterOperand      RegisterOperand;
+typedef vanaheimr::as::PredicateOperand     PredicateOperand;
+typedef vanaheimr::as::ImmediateOperand     ImmediateOperand;
+typedef vanaheimr::as::IndirectOperand      IndirectOperand;
+
+typedef uint64_t Value;
+typedef int64_t  SValue;
+typedef float    FValue;
+typedef double   DValue;
+
+template<typename T, typename F>
+static T bitcast(const F& from)
+{
+	union UnionCast
+	{
+		T to;
+		F from;
+	};
+
+	UnionCast cast;
+
+	cast.to   = 0;
+	cast.from = from;
+
+	return cast.to;
+}
+
+HostSimulator::HostSimulator()
+: _instructions(0), _instructionCount(0), _entryPoint(0), _linkRegister(63),
+	_registersPerThread(64), _executedInstructions(0)
+{
+
+}
+
+HostSimulator::~HostSimulator()
+{
+
+}
+
+void HostSimulator::runSimulation(const std::string& binaryFileName,
+	const KnobList& knobs)
+{
+	_knobs = knobs;
+
+	_loadBinary(binaryFileName);
+	_extractSimulatorParameters();
+	_loadInitialMemoryContents();
+	_runBlocks();
+
+	std::cout << "Host simulation of '" << _knob("simulated-kernel-name")
+		<< "' finished (" << _executedInstructions
+		<< " instructions).\n";
+}
+
+void HostSimulator::_loadBinary(const std::string& fileName)
+{
+	std::ifstream file(fileName.c_str(), std::ios::binary);
+
+	if(!file.is_open())
+	{
+		throw std::runtime_error("Failed to open binary file '"
+			+ fileName + "' for host simulation.");
+	}
+
+	file.seekg(0, std::ios::end);
+	_image.resize(file.tellg());
+	file.seekg(0, std::ios::beg);
+
+	file.read(_image.data(), _image.size());
+
+	if(_image.size() < sizeof(BinaryHeader))
+	{
+		throw std::runtime_error("Binary file '" + fileName
+			+ "' is too small to hold a header.");
+	}
+
+	const BinaryHeader& header =
+		*reinterpret_cast<const BinaryHeader*>(_image.data());
+
+	if(header.magic != BinaryHeader::MagicNumber)
+	{
+		throw std::runtime_error("Binary file '" + fileName
+			+ "' has the wrong magic number.");
+	}
+
+	if((header.flags & BinaryHeader::CompressedSections) != 0)
+	{
+		throw std::runtime_error("The host simulator does not support "
+			"compressed binaries yet, rewrite '" + fileName
+			+ "' uncompressed.");
+	}
+
+	_instructions = reinterpret_cast<const InstructionContainer*>(
+		_image.data() + header.codeOffset);
+	_instructionCount = ((uint64_t)header.codePages
+		* BinaryHeader::PageSize) / sizeof(InstructionContainer);
+}
+
+void HostSimulator::_extractSimulatorParameters()
+{
+	// the binary embeds its launch parameters as data symbols, mirror
+	// the device driver and turn them into knobs
+	const char* names[] = {
+		"simulated-ctas",
+		"simulated-parameter-memory-size",
+		"simulated-parameter-memory",
+		"simulated-parameter-memory-address",
+		"simulated-threads-per-cta",
+		"simulated-shared-memory-per-cta",
+		"simulated-kernel-name"
+	};
+
+	for(unsigned int i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+	{
+		_knobs.push_back(std::make_pair(names[i], _symbolData(names[i])));
+	}
+
+	if(!_knob("simulator-registers-per-thread").empty())
+	{
+		_registersPerThread = std::strtoul(
+			_knob("simulator-registers-per-thread").c_str(), 0, 0);
+	}
+
+	if(!_knob("simulated-link-register").empty())
+	{
+		_linkRegister = std::strtoul(
+			_knob("simulated-link-register").c_str(), 0, 0);
+	}
+
+	_entryPoint = _functionPC(_knob("simulated-kernel-name"));
+}
+
+void HostSimulator::_loadInitialMemoryContents()
+{
+	const BinaryHeader& header =
+		*reinterpret_cast<const BinaryHeader*>(_image.data());
+
+	const SymbolTableEntry* symbols =
+		reinterpret_cast<const SymbolTableEntry*>(
+			_image.data() + header.symbolOffset);
+
+	for(unsigned int i = 0; i < header.symbols; ++i)
+	{
+		std::string name = _symbolName(symbols[i]);
+
+		if(name.find("simulated-allocation") != 0) continue;
+
+		// the target address is embedded in the symbol name
+		size_t position = name.find("0x");
+
+		if(position == std::string::npos) continue;
+
+		Address address = std::strtoull(
+			name.substr(position).c_str(), 0, 0);
+
+		if(!_mmap(symbols[i].size, address)) continue;
+
+		std::memcpy(_translate(address),
+			_image.data() + symbols[i].offset, symbols[i].size);
+	}
+
+	// parameter memory is placed like any other allocation and filled
+	// from the embedded argument blob
+	Address parameterAddress = std::strtoull(
+		_knob("simulated-parameter-memory-address").c_str(), 0, 0);
+	uint64_t parameterSize = std::strtoull(
+		_knob("simulated-parameter-memory-size").c_str(), 0, 0);
+
+	std::string argumentMemory = _knob("simulated-parameter-memory");
+
+	if(parameterSize < argumentMemory.size())
+	{
+		parameterSize = argumentMemory.size();
+	}
+
+	if(parameterSize > 0)
+	{
+		_mmap(parameterSize, parameterAddress);
+
+		std::memcpy(_translate(parameterAddress), argumentMemory.data(),
+			argumentMemory.size());
+	}
+}
+
+void HostSimulator::_runBlocks()
+{
+	int ctas = std::strtoul(_knob("simulated-ctas").c_str(), 0, 0);
+
+	// blocks never share anything but global memory, so they simulate
+	// independently in parallel host threads
+	#pragma omp parallel for schedule(dynamic)
+	for(int block = 0; block < ctas; ++block)
+	{
+		_executeBlock(block);
+	}
+}
+
+void HostSimulator::_executeBlock(unsigned int blockId)
+{
+	unsigned int threadsPerBlock = std::strtoul(
+		_knob("simulated-threads-per-cta").c_str(), 0, 0);
+
+	ThreadVector threads(threadsPerBlock);
+
+	for(unsigned int tid = 0; tid < threadsPerBlock; ++tid)
+	{
+		threads[tid].registers.assign(_registersPerThread, 0);
+		threads[tid].pc        = _entryPoint;
+		threads[tid].finished  = false;
+		threads[tid].atBarrier = false;
+
+		// r32 is parameter memory (0x00000000 for now)
+		threads[tid].registers[32] = 0;
+		// r33 is the global thread id
+		threads[tid].registers[33] = tid;
+	}
+
+	uint64_t executed = 0;
+
+	while(true)
+	{
+		bool anyRunning = false;
+
+		for(unsigned int tid = 0; tid < threadsPerBlock; ++tid)
+		{
+			if(threads[tid].finished) continue;
+
+			anyRunning = true;
+
+			uint64_t before = _executedInstructions;
+
+			_executeThread(threads[tid], blockId);
+
+			executed += _executedInstructions - before;
+		}
+
+		if(!anyRunning) break;
+
+		// every runnable thread is parked at a barrier now, release it
+		for(unsigned int tid = 0; tid < threadsPerBlock; ++tid)
+		{
+			threads[tid].atBarrier = false;
+		}
+	}
+
+	#pragma omp atomic
+	_executedInstructions += executed;
+}
+
+void HostSimulator::_executeThread(Thread& thread, unsigned int blockId)
+{
+	while(!thread.finished && !thread.atBarrier)
+	{
+		if(thread.pc >= _instructionCount)
+		{
+			thread.finished = true;
+			break;
+		}
+
+		thread.pc = _executeInstruction(thread,
+			_instructions[thread.pc], thread.pc);
+	}
+}
+
+HostSimulator::PC HostSimulator::_executeInstruction(Thread& thread,
+	const InstructionContainer& container, PC pc)
+{
+	typedef vanaheimr::as::UnaryInstruction  UnaryInstruction;
+	typedef vanaheimr::as::BinaryInstruction BinaryInstruction;
+
+	const Instruction& instruction = container.asInstruction;
+
+	switch(instruction.opcode)
+	{
+	case Instruction::Add:
+	{
+		const BinaryInstruction& add =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, add.d,
+			_operand(thread, add.a) + _operand(thread, add.b));
+		return pc + 1;
+	}
+	case Instruction::And:
+	{
+		const BinaryInstruction& andd =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, andd.d,
+			_operand(thread, andd.a) & _operand(thread, andd.b));
+		return pc + 1;
+	}
+	case Instruction::Ashr:
+	{
+		const BinaryInstruction& ashr =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		SValue a = _operand(thread, ashr.a);
+		Value  b = _operand(thread, ashr.b);
+
+		_setRegister(thread, ashr.d, a >> b);
+		return pc + 1;
+	}
+	case Instruction::Bar:
+	{
+		thread.atBarrier = true;
+		return pc + 1;
+	}
+	case Instruction::Bitcast:
+	{
+		const UnaryInstruction& cast =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		_setRegister(thread, cast.d, _operand(thread, cast.a));
+		return pc + 1;
+	}
+	case Instruction::Bra:
+	{
+		const vanaheimr::as::Bra& bra =
+			static_cast<const vanaheimr::as::Bra&>(instruction);
+
+		return _operand(thread, bra.target);
+	}
+	case Instruction::Call:
+	{
+		const vanaheimr::as::Call& call =
+			static_cast<const vanaheimr::as::Call&>(instruction);
+
+		Value a = _operand(thread, call.target);
+
+		thread.registers[_linkRegister] = pc + 1;
+
+		return a;
+	}
+	case Instruction::Fdiv:
+	{
+		const BinaryInstruction& div =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		FValue a = bitcast<FValue>(_operand(thread, div.a));
+		FValue b = bitcast<FValue>(_operand(thread, div.b));
+
+		_setRegister(thread, div.d, a / b);
+		return pc + 1;
+	}
+	case Instruction::Fmul:
+	{
+		const BinaryInstruction& mul =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		FValue a = bitcast<FValue>(_operand(thread, mul.a));
+		FValue b = bitcast<FValue>(_operand(thread, mul.b));
+
+		_setRegister(thread, mul.d, a * b);
+		return pc + 1;
+	}
+	case Instruction::Fpext:
+	{
+		const UnaryInstruction& ext =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		float  temp = bitcast<float>(_operand(thread, ext.a));
+		double d    = temp;
+
+		_setRegister(thread, ext.d, d);
+		return pc + 1;
+	}
+	case Instruction::Fptosi:
+	{
+		const UnaryInstruction& cast =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		float  temp = bitcast<float>(_operand(thread, cast.a));
+		SValue d    = temp;
+
+		_setRegister(thread, cast.d, d);
+		return pc + 1;
+	}
+	case Instruction::Fptoui:
+	{
+		const UnaryInstruction& cast =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		float temp = bitcast<float>(_operand(thread, cast.a));
+		Value d    = temp;
+
+		_setRegister(thread, cast.d, d);
+		return pc + 1;
+	}
+	case Instruction::Fptrunc:
+	{
+		const UnaryInstruction& trunc =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		double temp = bitcast<double>(_operand(thread, trunc.a));
+		float  d    = temp;
+
+		_setRegister(thread, trunc.d, d);
+		return pc + 1;
+	}
+	case Instruction::Ld:
+	{
+		const vanaheimr::as::Ld& ld =
+			static_cast<const vanaheimr::as::Ld&>(instruction);
+
+		Value a = _operand(thread, ld.a);
+
+		void* physical = _translate(a);
+
+		Value d = 0;
+
+		switch(ld.d.asIndirect.type)
+		{
+		case vanaheimr::as::i1:
+		case vanaheimr::as::i8:
+		{
+			d = *reinterpret_cast<uint8_t*>(physical);
+			break;
+		}
+		case vanaheimr::as::i16:
+		{
+			d = *reinterpret_cast<uint16_t*>(physical);
+			break;
+		}
+		case vanaheimr::as::f32:
+		case vanaheimr::as::i32:
+		{
+			d = *reinterpret_cast<uint32_t*>(physical);
+			break;
+		}
+		default:
+		{
+			d = *reinterpret_cast<uint64_t*>(physical);
+			break;
+		}
+		}
+
+		_setRegister(thread, ld.d, d);
+		return pc + 1;
+	}
+	case Instruction::Lshr:
+	{
+		const BinaryInstruction& shr =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, shr.d,
+			_operand(thread, shr.a) >> _operand(thread, shr.b));
+		return pc + 1;
+	}
+	case Instruction::Membar:
+	{
+		return pc + 1;
+	}
+	case Instruction::Mul:
+	{
+		const BinaryInstruction& mul =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, mul.d,
+			_operand(thread, mul.a) * _operand(thread, mul.b));
+		return pc + 1;
+	}
+	case Instruction::Or:
+	{
+		const BinaryInstruction& orr =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, orr.d,
+			_operand(thread, orr.a) | _operand(thread, orr.b));
+		return pc + 1;
+	}
+	case Instruction::Ret:
+	{
+		thread.finished = true;
+		return pc + 1;
+	}
+	case Instruction::Setp:
+	{
+		const BinaryInstruction& setp =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		Value a = _operand(thread, setp.a);
+		Value b = _operand(thread, setp.b);
+
+		_setRegister(thread, setp.d, a > b ? 1 : 0);
+		return pc + 1;
+	}
+	case Instruction::Sext:
+	{
+		const UnaryInstruction& ext =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		int    temp = bitcast<int>(_operand(thread, ext.a));
+		SValue d    = temp;
+
+		_setRegister(thread, ext.d, d);
+		return pc + 1;
+	}
+	case Instruction::Sdiv:
+	{
+		const BinaryInstruction& div =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		SValue a = _operand(thread, div.a);
+		SValue b = _operand(thread, div.b);
+
+		_setRegister(thread, div.d, a / b);
+		return pc + 1;
+	}
+	case Instruction::Shl:
+	{
+		const BinaryInstruction& shl =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, shl.d,
+			_operand(thread, shl.a) << _operand(thread, shl.b));
+		return pc + 1;
+	}
+	case Instruction::Sitofp:
+	{
+		const UnaryInstruction& cast =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		float d = (SValue)_operand(thread, cast.a);
+
+		_setRegister(thread, cast.d, d);
+		return pc + 1;
+	}
+	case Instruction::Srem:
+	{
+		const BinaryInstruction& rem =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		SValue a = _operand(thread, rem.a);
+		SValue b = _operand(thread, rem.b);
+
+		_setRegister(thread, rem.d, a % b);
+		return pc + 1;
+	}
+	case Instruction::St:
+	{
+		const vanaheimr::as::St& st =
+			static_cast<const vanaheimr::as::St&>(instruction);
+
+		Value d = _operand(thread, st.d);
+
+		void* physical = _translate(d);
+
+		Value a = _operand(thread, st.a);
+
+		switch(st.a.asIndirect.type)
+		{
+		case vanaheimr::as::i1:
+		case vanaheimr::as::i8:
+		{
+			*reinterpret_cast<uint8_t*>(physical) = a;
+			break;
+		}
+		case vanaheimr::as::i16:
+		{
+			*reinterpret_cast<uint16_t*>(physical) = a;
+			break;
+		}
+		case vanaheimr::as::f32:
+		case vanaheimr::as::i32:
+		{
+			*reinterpret_cast<uint32_t*>(physical) = a;
+			break;
+		}
+		default:
+		{
+			*reinterpret_cast<uint64_t*>(physical) = a;
+			break;
+		}
+		}
+
+		return pc + 1;
+	}
+	case Instruction::Sub:
+	{
+		const BinaryInstruction& sub =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, sub.d,
+			_operand(thread, sub.a) - _operand(thread, sub.b));
+		return pc + 1;
+	}
+	case Instruction::Trunc:
+	{
+		const UnaryInstruction& trunc =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		Value d = (unsigned int)(_operand(thread, trunc.a)
+			& 0x00000000FFFFFFFFULL);
+
+		_setRegister(thread, trunc.d, d);
+		return pc + 1;
+	}
+	case Instruction::Udiv:
+	{
+		const BinaryInstruction& div =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, div.d,
+			_operand(thread, div.a) / _operand(thread, div.b));
+		return pc + 1;
+	}
+	case Instruction::Uitofp:
+	{
+		const UnaryInstruction& cast =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		float d = _operand(thread, cast.a);
+
+		_setRegister(thread, cast.d, d);
+		return pc + 1;
+	}
+	case Instruction::Urem:
+	{
+		const BinaryInstruction& rem =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, rem.d,
+			_operand(thread, rem.a) % _operand(thread, rem.b));
+		return pc + 1;
+	}
+	case Instruction::Xor:
+	{
+		const BinaryInstruction& xorr =
+			static_cast<const BinaryInstruction&>(instruction);
+
+		_setRegister(thread, xorr.d,
+			_operand(thread, xorr.a) ^ _operand(thread, xorr.b));
+		return pc + 1;
+	}
+	case Instruction::Zext:
+	{
+		const UnaryInstruction& ext =
+			static_cast<const UnaryInstruction&>(instruction);
+
+		_setRegister(thread, ext.d,
+			(unsigned int)_operand(thread, ext.a));
+		return pc + 1;
+	}
+	default:
+	{
+		std::stringstream message;
+
+		message << "Host simulator hit unsupported opcode "
+			<< instruction.opcode << " at pc " << pc << ".";
+
+		throw std::runtime_error(message.str());
+	}
+	}
+}
+
+const HostSimulator::SymbolTableEntry* HostSimulator::_findSymbol(
+	const std::string& name) const
+{
+	const BinaryHeader& header =
+		*reinterpret_cast<const BinaryHeader*>(_image.data());
+
+	const SymbolTableEntry* symbols =
+		reinterpret_cast<const SymbolTableEntry*>(
+			_image.data() + header.symbolOffset);
+
+	for(unsigned int i = 0; i < header.symbols; ++i)
+	{
+		if(_symbolName(symbols[i]) == name) return symbols + i;
+	}
+
+	return 0;
+}
+
+std::string HostSimulator::_symbolName(const SymbolTableEntry& symbol) const
+{
+	const BinaryHeader& header =
+		*reinterpret_cast<const BinaryHeader*>(_image.data());
+
+	return std::string(_image.data() + header.stringsOffset
+		+ symbol.stringOffset);
+}
+
+std::string HostSimulator::_symbolData(const std::string& name) const
+{
+	const SymbolTableEntry* symbol = _findSymbol(name);
+
+	if(symbol == 0)
+	{
+		throw std::runtime_error("Binary has no symbol named '"
+			+ name + "'.");
+	}
+
+	return std::string(_image.data() + symbol->offset,
+		_image.data() + symbol->offset + symbol->size);
+}
+
+HostSimulator::PC HostSimulator::_functionPC(const std::string& name) const
+{
+	const SymbolTableEntry* symbol = _findSymbol(name);
+
+	if(symbol == 0 || symbol->type != SymbolTableEntry::FunctionType)
+	{
+		throw std::runtime_error("Binary has no function named '"
+			+ name + "'.");
+	}
+
+	const BinaryHeader& header =
+		*reinterpret_cast<const BinaryHeader*>(_image.data());
+
+	return (symbol->offset - header.codeOffset)
+		/ sizeof(InstructionContainer);
+}
+
+std::string HostSimulator::_knob(const std::string& name) const
+{
+	for(KnobList::const_iterator knob = _knobs.begin();
+		knob != _knobs.end(); ++knob)
+	{
+		if(knob->first == name) return knob->second;
+	}
+
+	return "";
+}
+
+bool HostSimulator::_mmap(uint64_t bytes, Address address)
+{
+	if(bytes == 0) return false;
+
+	_allocations[address].resize(bytes);
+
+	return true;
+}
+
+void* HostSimulator::_translate(Address address)
+{
+	AllocationMap::iterator allocation = _allocations.upper_bound(address);
+
+	if(allocation != _allocations.begin())
+	{
+		--allocation;
+
+		if(address < allocation->first + allocation->second.size())
+		{
+			return allocation->second.data()
+				+ (address - allocation->first);
+		}
+	}
+
+	std::stringstream message;
+
+	message << "Host simulator accessed unmapped address 0x"
+		<< std::hex << address << ".";
+
+	throw std::runtime_error(message.str());
+}
+
+uint64_t HostSimulator::_operand(const Thread& thread,
+	const OperandContainer& container) const
+{
+	const Operand& operand = container.asOperand;
+
+	switch(operand.mode)
+	{
+	case Operand::Register:
+	{
+		return thread.registers[container.asRegister.reg];
+	}
+	case Operand::Immediate:
+	{
+		return container.asImmediate.uint;
+	}
+	case Operand::Predicate:
+	{
+		return thread.registers[container.asPredicate.reg];
+	}
+	case Operand::Indirect:
+	{
+		return thread.registers[container.asIndirect.reg]
+			+ container.asIndirect.offset;
+	}
+	default:
+	{
+		throw std::runtime_error("Symbol operands not supported in the "
+			"host simulator, they should have been lowered!");
+	}
+	}
+}
+
+void HostSimulator::_setRegister(Thread& thread,
+	const OperandContainer& container, uint64_t value)
+{
+	thread.registers[container.asRegister.reg] = value;
+}
+
+}
+
+}
@@ -0,0 +1,114 @@
+/*! \file   HostSimulator.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the HostSimulator class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace as { class InstructionContainer; } }
+namespace vanaheimr { namespace as { class SymbolTableEntry;     } }
+namespace vanaheimr { namespace as { union OperandContainer;     } }
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief A functional simulation backend that runs on the host.
+
+	Interprets the same binaries with the same CoreSimThread execution
+	semantics as the device executive, but without the timing models,
+	scheduling fairness, or statistics: each simulated thread runs until
+	it blocks at a barrier or returns, and the simulated blocks execute
+	in parallel host threads.  Machines without a CUDA driver get fast
+	functional runs and a debuggable simulator. */
+class HostSimulator
+{
+public:
+	typedef uint64_t Address;
+	typedef uint64_t PC;
+	typedef std::pair<std::string, std::string> Knob;
+	typedef std::list<Knob>                     KnobList;
+
+public:
+	HostSimulator();
+	~HostSimulator();
+
+public:
+	/*! \brief Load the named binary and simulate the kernel it names */
+	void runSimulation(const std::string& binaryFileName,
+		const KnobList& knobs);
+
+private:
+	/*! \brief The register file and control state of one thread */
+	class Thread
+	{
+	public:
+		std::vector<uint64_t> registers;
+		PC                    pc;
+		bool                  finished;
+		bool                  atBarrier;
+	};
+
+	typedef std::vector<char>               ByteVector;
+	typedef std::map<Address, ByteVector>   AllocationMap;
+	typedef std::vector<Thread>             ThreadVector;
+	typedef vanaheimr::as::SymbolTableEntry SymbolTableEntry;
+
+private:
+	void _loadBinary(const std::string& fileName);
+	void _extractSimulatorParameters();
+	void _loadInitialMemoryContents();
+	void _runBlocks();
+	void _executeBlock(unsigned int blockId);
+
+	/*! \brief Run one thread until it parks at a barrier or returns */
+	void _executeThread(Thread& thread, unsigned int blockId);
+	PC   _executeInstruction(Thread& thread,
+		const vanaheimr::as::InstructionContainer& container, PC pc);
+
+private:
+	const SymbolTableEntry* _findSymbol(const std::string& name) const;
+	std::string _symbolName(const SymbolTableEntry& symbol) const;
+	std::string _symbolData(const std::string& name) const;
+	PC          _functionPC(const std::string& name) const;
+
+	std::string _knob(const std::string& name) const;
+
+	bool  _mmap(uint64_t bytes, Address address);
+	void* _translate(Address address);
+
+	uint64_t _operand(const Thread& thread,
+		const vanaheimr::as::OperandContainer& operand) const;
+	void _setRegister(Thread& thread,
+		const vanaheimr::as::OperandContainer& operand, uint64_t value);
+
+private:
+	ByteVector    _image;
+	KnobList      _knobs;
+	AllocationMap _allocations;
+
+	const vanaheimr::as::InstructionContainer* _instructions;
+	uint64_t                                   _instructionCount;
+
+	PC           _entryPoint;
+	unsigned int _linkRegister;
+	unsigned int _registersPerThread;
+
+	uint64_t _executedInstructions;
+};
+
+}
+
+}
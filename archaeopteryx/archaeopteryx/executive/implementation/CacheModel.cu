@@ -0,0 +1,107 @@
+/*! \file   CacheModel.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CacheModel class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/CacheModel.h>
+
+#include <archaeopteryx/util/interface/debug.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ CacheModel::CacheModel()
+: m_tags(0), m_victims(0), m_sets(0), m_ways(0), m_lineSize(0)
+{
+
+}
+
+__device__ void CacheModel::setup(unsigned int size,
+	unsigned int associativity, unsigned int lineSize)
+{
+	clear();
+
+	if(size == 0) return;
+
+	device_assert(associativity != 0);
+	device_assert(lineSize      != 0);
+
+	m_ways     = associativity;
+	m_lineSize = lineSize;
+	m_sets     = size / (associativity * lineSize);
+
+	if(m_sets == 0) m_sets = 1;
+
+	m_tags    = new uint64_t[m_sets * m_ways];
+	m_victims = new unsigned int[m_sets];
+
+	for(unsigned int line = 0; line < m_sets * m_ways; ++line)
+	{
+		m_tags[line] = (uint64_t)(-1);
+	}
+
+	for(unsigned int set = 0; set < m_sets; ++set)
+	{
+		m_victims[set] = 0;
+	}
+}
+
+__device__ void CacheModel::clear()
+{
+	delete[] m_tags;
+	delete[] m_victims;
+
+	m_tags    = 0;
+	m_victims = 0;
+	m_sets    = 0;
+	m_ways    = 0;
+}
+
+__device__ bool CacheModel::enabled() const
+{
+	return m_tags != 0;
+}
+
+__device__ bool CacheModel::access(Address address)
+{
+	if(m_tags == 0) return false;
+
+	unsigned int set = _set(address);
+	uint64_t     tag = _tag(address);
+
+	uint64_t* ways = m_tags + set * m_ways;
+
+	for(unsigned int way = 0; way < m_ways; ++way)
+	{
+		if(ways[way] == tag) return true;
+	}
+
+	// miss, fill over the set's round robin victim.  Concurrent warps
+	// race on the tags and the victim pointer, the coarse model accepts
+	// the occasional lost fill.
+	unsigned int victim = m_victims[set];
+
+	ways[victim]   = tag;
+	m_victims[set] = (victim + 1) % m_ways;
+
+	return false;
+}
+
+__device__ unsigned int CacheModel::_set(Address address) const
+{
+	return (address / m_lineSize) % m_sets;
+}
+
+__device__ uint64_t CacheModel::_tag(Address address) const
+{
+	return address / (m_lineSize * m_sets);
+}
+
+}
+
+}
@@ -0,0 +1,61 @@
+/*! \file   CoalescingModel.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CoalescingModel class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/CoalescingModel.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief Count the distinct values among the addresses shifted down by
+	the granularity, quadratic in the warp size */
+static __device__ unsigned int countDistinct(const unsigned int* addresses,
+	unsigned int count, unsigned int logGranularity)
+{
+	unsigned int distinct = 0;
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		unsigned int block = addresses[i] >> logGranularity;
+
+		bool firstAccess = true;
+
+		for (unsigned int j = 0; j < i; ++j)
+		{
+			if ((addresses[j] >> logGranularity) == block)
+			{
+				firstAccess = false;
+				break;
+			}
+		}
+
+		if (firstAccess)
+		{
+			++distinct;
+		}
+	}
+
+	return distinct;
+}
+
+__device__ unsigned int CoalescingModel::transactions(
+	const unsigned int* addresses, unsigned int count)
+{
+	return countDistinct(addresses, count, LogSegmentSize);
+}
+
+__device__ unsigned int CoalescingModel::sectors(
+	const unsigned int* addresses, unsigned int count)
+{
+	return countDistinct(addresses, count, LogSectorSize);
+}
+
+}
+
+}
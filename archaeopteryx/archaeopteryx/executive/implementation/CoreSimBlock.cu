@@ -8,7 +8,10 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/executive/interface/CoreSimBlock.h>
 #include <archaeopteryx/executive/interface/CoreSimKernel.h>
+#include <archaeopteryx/executive/interface/SharedMemoryModel.h>
+#include <archaeopteryx/executive/interface/CoalescingModel.h>
 
+#include <archaeopteryx/util/interface/File.h>
 #include <archaeopteryx/util/interface/debug.h>
 
 // Vanaheimr Includes
@@ -30,6 +33,15 @@ namespace archaeopteryx
 namespace executive
 {
 
+__device__ CoreSimBlock::CoreSimBlock()
+: m_scalarRegisters(0), m_vectorRegisters(0), m_threads(0), m_schedulers(0),
+	m_warp(0), m_kernel(0), m_statistics(0), m_accessedAddresses(0),
+	m_accessCounts(0), m_globalAddresses(0), m_globalCounts(0),
+	m_barrierArrived(0), m_arrivedWarps(0)
+{
+
+}
+
 __device__ void CoreSimBlock::setupCoreSimBlock(unsigned int blockId,
 	unsigned int registers, const CoreSimKernel* kernel)
 {
@@ -40,22 +52,89 @@ __device__ void CoreSimBlock::setupCoreSimBlock(unsigned int blockId,
 	device_report("Setting up core sim block %p, %d threads, %d registers\n",
 		this, m_blockState.threadsPerBlock, m_blockState.registersPerThread);
 
-	m_registerFiles = new Register[m_blockState.registersPerThread *
-		m_blockState.threadsPerBlock];
-		
-	m_threads = new CoreSimThread[m_blockState.threadsPerBlock];
+	unsigned int slots = (m_blockState.threadsPerBlock / WARP_SIZE) *
+		m_blockState.registersPerThread;
+
+	// most registers hold the same value in every thread of a warp, so
+	// they start out uniform with a single scalar slot per warp, the lane
+	// vectors are allocated lazily on the first divergent write
+	m_scalarRegisters = (Register* )allocateState(sizeof(Register ) * slots);
+	m_vectorRegisters = (Register**)allocateState(sizeof(Register*) * slots);
+
+	for(unsigned int s = 0; s < slots; ++s)
+	{
+		m_scalarRegisters[s] = 0;
+		m_vectorRegisters[s] = 0;
+	}
+
+	m_threads = (CoreSimThread*)allocateState(
+		sizeof(CoreSimThread) * m_blockState.threadsPerBlock);
 	m_warp    = m_threads + (threadIdx.x - getThreadIdInWarp());
-	
+
+	// the schedulers start out invalid and are rebuilt lazily on the
+	// first scheduling step of each warp
+	m_schedulers = (TraceScheduler*)allocateState(
+		sizeof(TraceScheduler) * (m_blockState.threadsPerBlock / WARP_SIZE));
+
+	for(unsigned w = 0; w < m_blockState.threadsPerBlock / WARP_SIZE; ++w)
+	{
+		new (m_schedulers + w) TraceScheduler;
+	}
+
+	m_barrierArrived = (unsigned int*)allocateState(
+		sizeof(unsigned int) * (m_blockState.threadsPerBlock / WARP_SIZE));
+
+	for(unsigned w = 0; w < m_blockState.threadsPerBlock / WARP_SIZE; ++w)
+	{
+		m_barrierArrived[w] = 0;
+	}
+
+	m_arrivedWarps = 0;
+
+	// the event queue starts empty, nothing sleeps until a timing model
+	// posts a latency, so the functional path is unchanged
+	m_eventQueue.setup(m_blockState.threadsPerBlock / WARP_SIZE);
+
 	for(unsigned i = 0; i < m_blockState.threadsPerBlock; ++i)
 	{
-		m_threads[i].setParentBlock(this);
-		m_threads[i].setThreadId(i);
+		new (m_threads + i) CoreSimThread(this, i);
 	}
 }
 
+__device__ EventQueue* CoreSimBlock::eventQueue()
+{
+	return &m_eventQueue;
+}
+
+__device__ void* CoreSimBlock::allocateState(size_t bytes)
+{
+	void* storage = m_slab.allocate(bytes);
+
+	if(storage == 0)
+	{
+		storage = new char[bytes];
+	}
+
+	return storage;
+}
+
+__device__ void CoreSimBlock::freeState(void* address)
+{
+	if(address == 0)        return;
+	if(m_slab.owns(address)) return;
+
+	delete[] (char*)address;
+}
+
+__device__ void CoreSimBlock::setSlabArena(void* buffer, size_t bytes)
+{
+	m_slab.initialize(buffer, bytes);
+}
+
 __device__ void CoreSimBlock::setupBinary(ir::Binary* binary)
 {
 	m_blockState.binary = binary;
+	m_fetchUnit         = FetchUnit(binary);
 }
 
 __device__ ir::Binary* CoreSimBlock::binary()
@@ -118,56 +197,37 @@ __device__ void CoreSimBlock::roundRobinScheduler()
 
 __device__ unsigned int CoreSimBlock::findNextPC(unsigned int& returnPriority)
 {
-	__shared__ uint2 priority[WARP_SIZE];
-	unsigned int localThreadPriority = 0;
-	unsigned int localThreadPC	   = 0;
+	__shared__ uint2 selected[WARP_SIZE];
 
-	device_report("Getting next PC\n");
-	
-	// only give threads a non-zero priority if they are NOT waiting at a barrier
-	if (m_warp[getThreadIdInWarp()].barrierBit == false)
-	{
-		localThreadPriority = m_warp[getThreadIdInWarp()].instructionPriority;
-		localThreadPC	   = m_warp[getThreadIdInWarp()].pc;
+	unsigned int warp = threadIdx.x >> LOG_WARP_SIZE;
 
-		priority[getThreadIdInWarp()].x = localThreadPriority;
-		priority[getThreadIdInWarp()].y = localThreadPC;
-	}
- 
-	device_report("FindNextPC for threadId %d, input priority %d, threadIdInWarp: %d \n",
-		threadIdx.x, localThreadPriority, getThreadIdInWarp());
-	
-	// warp_barrier
+	device_report("Getting next PC\n");
 
-	for (unsigned int i = 2; i < WARP_SIZE; i*=2)
+	if (getThreadIdInWarp() == 0)
 	{
-		if (getThreadIdInWarp() % i == 0)
-		{
-			unsigned int neighborsThreadId = getThreadIdInWarp() + i/2;
-			unsigned int neighborsPriority = priority[neighborsThreadId].x;
-			unsigned int neighborsPC	   = priority[neighborsThreadId].y;
-
-			bool local = localThreadPriority > neighborsPriority;
+		TraceScheduler* scheduler = warpScheduler();
 
-			localThreadPriority = local ? localThreadPriority : neighborsPriority;
-			localThreadPC	   = local ? localThreadPC	   : neighborsPC;
-			device_report("\tThread [%d]: LocalThreadPriority: %d, neighborsPriority[%d]: %d \n",
-				threadIdx.x, localThreadPriority, neighborsThreadId, neighborsPriority);
-		}
-		// warp_barrier
-		if (getThreadIdInWarp() % i == 0)
+		// rebuilds are rare, they only happen on the first step of a warp
+		// and after the barrier bits are cleared in bulk, every other step
+		// reads the incrementally maintained PC groups
+		if (!scheduler->valid())
 		{
-			priority[getThreadIdInWarp()].x = localThreadPriority;
-			priority[getThreadIdInWarp()].y = localThreadPC;
+			scheduler->rebuild(m_warp);
 		}
-		// warp_barrier
+
+		unsigned int maxPriority = 0;
+
+		selected[warp].y = scheduler->nextPC(maxPriority);
+		selected[warp].x = maxPriority;
 	}
 
-	unsigned int maxPriority = priority[0].x;
-	unsigned int maxPC	   = priority[0].y;
- 
+	// warp_barrier
+
+	unsigned int maxPriority = selected[warp].x;
+	unsigned int maxPC	   = selected[warp].y;
+
 	cta_report(" max priority is %d, max pc is %d\n", maxPriority, maxPC);
- 
+
 	returnPriority = maxPriority;
 
 	return maxPC;
@@ -179,31 +239,275 @@ __device__ bool CoreSimBlock::setPredicateMaskForWarp(PC pc)
 	return pc == m_warp[getThreadIdInWarp()].pc;
 }
 
-__device__ CoreSimBlock::InstructionContainer CoreSimBlock::fetchInstruction(
-	PC pc)
+__device__ unsigned int CoreSimBlock::fetchInstruction(
+	PC pc, InstructionContainer* instructions)
 {
-	__shared__ InstructionContainer instruction;
-	
+	__shared__ InstructionContainer fetched[2];
+	__shared__ unsigned int fetchedCount;
+	__shared__ char fetchCache[FETCH_CACHE_SIZE];
+	__shared__ FetchUnit::Fill fill;
+
+	if (getThreadIdInWarp() == 0)
+	{
+		if (!m_fetchUnit.hasCache())
+		{
+			m_fetchUnit.setCache(fetchCache, sizeof(fetchCache));
+		}
+
+		m_fetchUnit.probe(pc, fill);
+	}
+	// barrier
+
+	// on a miss every lane of the warp helps copy the line in
+	m_fetchUnit.fillLine(fill);
+	// warp_barrier
+
 	if (getThreadIdInWarp() == 0)
 	{
-		m_blockState.binary->copyCode(&instruction, pc, 1);
+		bool fused = false;
+
+		const InstructionContainer* container =
+			m_fetchUnit.finishFetch(pc, fill, fused);
+
+		fetched[0]   = container[0];
+		fetchedCount = 1;
+
+		// the successor of a fused pair sits in the same cache line
+		if (fused)
+		{
+			fetched[1]   = container[1];
+			fetchedCount = 2;
+		}
 	}
 	// barrier
-	return instruction;
+	instructions[0] = fetched[0];
+
+	if (fetchedCount == 2)
+	{
+		instructions[1] = fetched[1];
+	}
+
+	return fetchedCount;
 }
 
 __device__ void CoreSimBlock::executeWarp(
-	InstructionContainer* instruction, PC pc)
+	InstructionContainer* instructions, unsigned int count, PC pc)
 {
-	bool predicateMask = setPredicateMaskForWarp(pc);	
-	
+	__shared__ unsigned int movedCount[WARP_SIZE];
+	__shared__ uint2 moved[WARP_SIZE][WARP_SIZE];
+	__shared__ CoreSimThread::ExecuteFunction handler[WARP_SIZE];
+
+	unsigned int warp = threadIdx.x >> LOG_WARP_SIZE;
+
+	if (getThreadIdInWarp() == 0)
+	{
+		movedCount[warp]     = 0;
+		m_accessCounts[warp] = 0;
+		m_globalCounts[warp] = 0;
+
+		// the warp executes a single instruction, one lane decodes the
+		// opcode handler for all of them
+		handler[warp] = CoreSimThread::decode(&instructions[0].asInstruction);
+	}
+
+	// warp_barrier
+
+	bool predicateMask = setPredicateMaskForWarp(pc);
+
 	//some function for all threads if predicateMask is true
 	if (predicateMask)
 	{
-		PC newPC = m_warp[getThreadIdInWarp()].executeInstruction(
-			&instruction->asInstruction, pc);
+		PC newPC = 0;
+
+		if (count == 2)
+		{
+			newPC = m_warp[getThreadIdInWarp()].executeFusedInstructions(
+				&instructions[0].asInstruction,
+				&instructions[1].asInstruction, pc);
+		}
+		else
+		{
+			newPC = m_warp[getThreadIdInWarp()].executeInstruction(
+				&instructions[0].asInstruction, pc, handler[warp]);
+		}
+
 		m_warp[getThreadIdInWarp()].pc = newPC;
 		m_warp[getThreadIdInWarp()].instructionPriority = newPC + 1;
+
+		// record the move for the scheduler, only threads that actually
+		// executed show up, so the group update below is proportional to
+		// the number of changed threads
+		unsigned int slot = atomicAdd(&movedCount[warp], 1);
+
+		moved[warp][slot].x = (unsigned int)newPC;
+		moved[warp][slot].y = m_warp[getThreadIdInWarp()].barrierBit ? 1 : 0;
+	}
+
+	// warp_barrier
+
+	if (getThreadIdInWarp() == 0)
+	{
+		TraceScheduler* scheduler = warpScheduler();
+
+		unsigned int taken   = 0;
+		unsigned int firstPC = 0;
+
+		bool divergent = false;
+
+		for (unsigned int i = 0; i < movedCount[warp]; ++i)
+		{
+			scheduler->threadMoved(pc, moved[warp][i].x,
+				moved[warp][i].x + 1, moved[warp][i].y != 0);
+
+			// any thread leaving the fallthrough path took a branch
+			if (moved[warp][i].x != (unsigned int)(pc + count))
+			{
+				++taken;
+			}
+
+			if (i == 0)
+			{
+				firstPC = moved[warp][i].x;
+			}
+			else if (moved[warp][i].x != firstPC)
+			{
+				divergent = true;
+			}
+		}
+
+		// a branch just split the warp, park the new groups at its
+		// immediate post-dominator so they re-merge there
+		if (divergent)
+		{
+			PC reconvergePC = m_blockState.binary->findReconvergencePoint(
+				pc + count - 1);
+
+			if (reconvergePC != ir::Binary::InvalidPC)
+			{
+				scheduler->pushReconvergencePoint(reconvergePC);
+			}
+		}
+
+		unsigned int executed = movedCount[warp];
+
+		// replay tracing is gated at runtime, the report macros are
+		// compile time switches and stay off in release builds
+		if (m_kernel->replayTracing && executed > 0)
+		{
+			printf("trace: cta %u warp %u pc 0x%llx executed %u taken %u\n",
+				m_blockState.blockId, warp, (unsigned long long)pc,
+				executed, taken);
+		}
+
+		if (executed > 0 && m_kernel->inFastForward())
+		{
+			// warm up, retire against the window and skip all of the
+			// accounting and timing models
+			m_kernel->countFastForward(
+				(unsigned long long)executed * count);
+		}
+		else if (executed > 0)
+		{
+			atomicAdd(&m_statistics->instructions,
+				(unsigned long long)executed * count);
+			atomicAdd(&m_statistics->scheduledSteps, 1ULL);
+
+			if (executed != WARP_SIZE)
+			{
+				atomicAdd(&m_statistics->divergentSteps, 1ULL);
+			}
+
+			typedef vanaheimr::as::Instruction Instruction;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				Instruction::Opcode opcode =
+					instructions[i].asInstruction.opcode;
+
+				if (opcode == Instruction::Ld || opcode == Instruction::St ||
+					opcode == Instruction::Atom)
+				{
+					atomicAdd(&m_statistics->memoryTransactions,
+						(unsigned long long)executed);
+				}
+			}
+
+			if (m_kernel->profile.enabled())
+			{
+				m_kernel->countProfile(pc,
+					(unsigned long long)executed,
+					(unsigned long long)taken);
+			}
+
+			unsigned int accesses = m_accessCounts[warp];
+
+			if (accesses > 0)
+			{
+				// the warp's shared accesses issue together, the deepest
+				// bank sets how many passes they serialize into
+				unsigned int passes = SharedMemoryModel::serializedPasses(
+					m_accessedAddresses + warp * 2 * WARP_SIZE, accesses);
+
+				atomicAdd(&m_statistics->sharedMemoryAccesses,
+					(unsigned long long)accesses);
+				atomicAdd(&m_statistics->sharedMemoryCycles,
+					(unsigned long long)passes);
+
+				if (passes > 1)
+				{
+					atomicAdd(&m_statistics->bankConflicts,
+						(unsigned long long)(passes - 1));
+				}
+			}
+
+			unsigned int globalAccesses = m_globalCounts[warp];
+
+			if (globalAccesses > 0)
+			{
+				// one transaction per segment spanned, one cycle per
+				// sector moved
+				const unsigned int* addresses =
+					m_globalAddresses + warp * 2 * WARP_SIZE;
+
+				if (m_kernel->memoryTrace.enabled())
+				{
+					m_kernel->recordMemoryTrace(m_blockState.blockId, pc,
+						addresses, globalAccesses);
+				}
+
+				unsigned int transactions = CoalescingModel::transactions(
+					addresses, globalAccesses);
+				unsigned int sectors = CoalescingModel::sectors(
+					addresses, globalAccesses);
+
+				atomicAdd(&m_statistics->globalMemoryAccesses,
+					(unsigned long long)globalAccesses);
+				atomicAdd(&m_statistics->globalTransactions,
+					(unsigned long long)transactions);
+				atomicAdd(&m_statistics->globalMemoryCycles,
+					(unsigned long long)sectors);
+
+				if (m_kernel->l1Cache.enabled())
+				{
+					unsigned long long hierarchy[3] = {0, 0, 0};
+
+					for (unsigned int i = 0; i < globalAccesses; ++i)
+					{
+						++hierarchy[m_kernel->accessCache(addresses[i])];
+					}
+
+					atomicAdd(&m_statistics->l1CacheHits, hierarchy[0]);
+					atomicAdd(&m_statistics->l1CacheMisses,
+						hierarchy[1] + hierarchy[2]);
+					atomicAdd(&m_statistics->l2CacheHits,   hierarchy[1]);
+					atomicAdd(&m_statistics->l2CacheMisses, hierarchy[2]);
+				}
+			}
+		}
+
+		// barrier and exit bits only change during execution, so this is
+		// the one place a warp can newly arrive at the barrier
+		updateBarrierArrival();
 	}
 }
 
@@ -212,6 +516,11 @@ __device__ unsigned int CoreSimBlock::getThreadIdInWarp()
 	return (threadIdx.x % WARP_SIZE);
 }
 
+__device__ TraceScheduler* CoreSimBlock::warpScheduler()
+{
+	return m_schedulers + (m_warp - m_threads) / WARP_SIZE;
+}
+
 __device__ void CoreSimBlock::initializeSpecialRegisters()
 {
 	cta_report("Intializing special registers for %d threads\n", 
@@ -231,15 +540,34 @@ __device__ void CoreSimBlock::initializeSpecialRegisters()
 // Entry point to the block simulation
 // It performs the following operations
 //   1) Schedule group of simulated threads onto CUDA warps (static/round-robin)
-//   2) Pick the next PC to execute (the one with the highest priority using a reduction)
+//   2) Pick the next PC to execute (the highest priority PC group tracked
+//      incrementally by the trace scheduler)
 //   3) Set the predicate mask (true if threadPC == next PC, else false)
 //   4) Fetch the instruction at the selected PC
 //   5) Execute all threads with true predicate masks
 //   6) Save the new PC, goto 1 if all threads are not done
  __device__ void CoreSimBlock::runBlock()
 {
+	__shared__ SimulationStatistics blockStatistics;
+	__shared__ unsigned int accessedAddresses[WARP_SIZE * 2 * WARP_SIZE];
+	__shared__ unsigned int accessCounts[WARP_SIZE];
+	__shared__ unsigned int globalAddresses[WARP_SIZE * 2 * WARP_SIZE];
+	__shared__ unsigned int globalCounts[WARP_SIZE];
+
 	m_warp = m_threads + threadIdx.x - getThreadIdInWarp();
 
+	if (threadIdx.x == 0)
+	{
+		blockStatistics.clear();
+		m_statistics = &blockStatistics;
+
+		m_accessedAddresses = accessedAddresses;
+		m_accessCounts      = accessCounts;
+		m_globalAddresses   = globalAddresses;
+		m_globalCounts      = globalCounts;
+	}
+	// barrier
+
 	initializeSpecialRegisters();
 
 	cta_report("Running core-sim-block loop for simulated cta %d\n", 
@@ -251,6 +579,25 @@ __device__ void CoreSimBlock::initializeSpecialRegisters()
 
 	while (!areAllThreadsFinished())
 	{
+		unsigned int warpIndex =
+			(unsigned int)(m_warp - m_threads) >> LOG_WARP_SIZE;
+
+		// a warp sleeping on a timed event is skipped without touching
+		// its scheduler, and when every warp sleeps the clock jumps
+		// straight to the earliest pending wakeup instead of spinning
+		if (m_eventQueue.asleep(warpIndex))
+		{
+			if (getThreadIdInWarp() == 0 && m_eventQueue.sleepingWarps() ==
+				m_blockState.threadsPerBlock / WARP_SIZE)
+			{
+				m_eventQueue.wake();
+			}
+
+			roundRobinScheduler();
+
+			continue;
+		}
+
 		++scheduledCount;
 		PC nextPC = findNextPC(priority);
 
@@ -259,34 +606,80 @@ __device__ void CoreSimBlock::initializeSpecialRegisters()
 		// only execute if all threads in this warp are NOT waiting on a barrier
 		if (priority != 0)
 		{
-			 InstructionContainer instruction = fetchInstruction(nextPC);
-			 executeWarp(&instruction, nextPC);
+			 InstructionContainer instructions[2];
+			 unsigned int count = fetchInstruction(nextPC, instructions);
+			 executeWarp(instructions, count, nextPC);
 			 ++executedCount;
+
+			 // while anything is runnable the clock counts issued steps
+			 if (getThreadIdInWarp() == 0)
+			 {
+				m_eventQueue.tick();
+			 }
+		}
+		else if (getThreadIdInWarp() == 0 && !m_kernel->inFastForward())
+		{
+			atomicAdd(&blockStatistics.barrierWaits, 1ULL);
+		}
+
+		// every warp has arrived (or finished), release the barrier right
+		// away instead of proving the stall with an idle rotation through
+		// the schedulers
+		if (m_arrivedWarps == m_blockState.threadsPerBlock / WARP_SIZE)
+		{
+			clearAllBarrierBits();
 		}
 
 		if (scheduledCount == m_blockState.threadsPerBlock / WARP_SIZE)
 		{
 			if (executedCount == 0)
 			{
+				// safety net for stalls the arrival count cannot see
 				clearAllBarrierBits();
 			}
 			scheduledCount = 0;
 			executedCount  = 0;
 		}
 
-		roundRobinScheduler();
+		// during warm up a warp that made progress keeps running at
+		// maximum rate, rotating for fairness only when it stalls
+		if (!(priority != 0 && m_kernel->inFastForward()))
+		{
+			roundRobinScheduler();
+		}
 	}
-	
-	cta_report(" core-sim-block finished simulating cta %d\n", 
+
+	// barrier
+
+	if (threadIdx.x == 0)
+	{
+		m_kernel->addStatistics(blockStatistics);
+	}
+
+	cta_report(" core-sim-block finished simulating cta %d\n",
 		m_blockState.blockId);
 
 }
 
+__device__ unsigned int CoreSimBlock::registerSlot(unsigned int threadId,
+	unsigned int reg)
+{
+	unsigned int warp = threadId >> LOG_WARP_SIZE;
+
+	return warp * m_blockState.registersPerThread + reg;
+}
+
 __device__ CoreSimThread::Value CoreSimBlock::getRegister(unsigned int threadId,
 	unsigned int reg)
 {
-	CoreSimThread::Value v =
-		m_registerFiles[(m_blockState.registersPerThread * threadId)+reg];
+	unsigned int slot = registerSlot(threadId, reg);
+
+	Register* vector = m_vectorRegisters[slot];
+
+	// a uniform register is a single broadcast load for the whole warp, a
+	// divergent one is a coalesced load from the contiguous lane vector
+	CoreSimThread::Value v = vector == 0 ? m_scalarRegisters[slot] :
+		vector[threadId & (WARP_SIZE - 1)];
 
 	device_report("(%d): reading register r%d, (%p)\n", threadId, reg, v);
 
@@ -299,7 +692,76 @@ __device__ void CoreSimBlock::setRegister(unsigned int threadId,
 	device_report("(%d): setting register r%d, (%p)\n",
 		threadId, reg, result);
 
-	m_registerFiles[(m_blockState.registersPerThread*threadId)+reg] = result;
+	unsigned int slot = registerSlot(threadId, reg);
+	unsigned int lane = threadId & (WARP_SIZE - 1);
+
+	Register* vector = m_vectorRegisters[slot];
+
+	if (vector != 0)
+	{
+		vector[lane] = result;
+		return;
+	}
+
+	// The register is uniform.  The writing lanes elect a leader, count
+	// themselves, and count how many of them agree with the leader's
+	// value to decide whether the register stays uniform.
+	__shared__ unsigned int writers[WARP_SIZE];
+	__shared__ unsigned int agreers[WARP_SIZE];
+	__shared__ Register     elected[WARP_SIZE];
+
+	unsigned int hardwareWarp = threadIdx.x >> LOG_WARP_SIZE;
+
+	writers[hardwareWarp] = 0;
+	agreers[hardwareWarp] = 0;
+	// warp_barrier
+
+	unsigned int order = atomicAdd(&writers[hardwareWarp], 1);
+
+	if (order == 0)
+	{
+		elected[hardwareWarp] = result;
+	}
+	// warp_barrier
+
+	if (elected[hardwareWarp] == result)
+	{
+		atomicAdd(&agreers[hardwareWarp], 1);
+	}
+	// warp_barrier
+
+	Register previous = m_scalarRegisters[slot];
+
+	if (agreers[hardwareWarp] == writers[hardwareWarp])
+	{
+		// every writer stored the same value, the register stays uniform
+		// when the whole warp wrote or when the value did not change, a
+		// partial write of a new value diverges because the inactive
+		// lanes keep the old one
+		if (writers[hardwareWarp] == WARP_SIZE || result == previous)
+		{
+			m_scalarRegisters[slot] = result;
+			return;
+		}
+	}
+
+	// the write diverges the register, the leader moves the scalar into a
+	// freshly allocated lane vector and every writer stores its own lane
+	if (order == 0)
+	{
+		Register* fresh = (Register*)allocateState(
+			sizeof(Register) * WARP_SIZE);
+
+		for (unsigned int i = 0; i < WARP_SIZE; ++i)
+		{
+			fresh[i] = previous;
+		}
+
+		m_vectorRegisters[slot] = fresh;
+	}
+	// warp_barrier
+
+	m_vectorRegisters[slot][lane] = result;
 }
 
 __device__ CoreSimThread::Value CoreSimBlock::translateVirtualToPhysical(
@@ -308,6 +770,30 @@ __device__ CoreSimThread::Value CoreSimBlock::translateVirtualToPhysical(
 	return m_kernel->translateVirtualToPhysicalAddress(v);
 }
 
+__device__ void CoreSimBlock::recordMemoryAccess(CoreSimThread::Value address)
+{
+	unsigned int warp = threadIdx.x >> LOG_WARP_SIZE;
+
+	// the shared memory window sits at the bottom of the simulated
+	// virtual address space, everything above it is timed as global.
+	// Banking and segmentation only depend on the low address bits, the
+	// narrow word is enough for both models.
+	if (address < m_blockState.sharedMemoryPerBlock)
+	{
+		unsigned int slot = atomicAdd(&m_accessCounts[warp], 1);
+
+		m_accessedAddresses[warp * 2 * WARP_SIZE + slot] =
+			(unsigned int)address;
+	}
+	else
+	{
+		unsigned int slot = atomicAdd(&m_globalCounts[warp], 1);
+
+		m_globalAddresses[warp * 2 * WARP_SIZE + slot] =
+			(unsigned int)address;
+	}
+}
+
 
 __device__ void CoreSimBlock::barrier(unsigned int threadId)
 {
@@ -342,8 +828,64 @@ __device__ void CoreSimBlock::clearAllBarrierBits()
 		unsigned int logicalThread = i * WARP_SIZE + getThreadIdInWarp();
 		m_threads[logicalThread].barrierBit = false;
 		//barrier should be here but it is slow (every warp)
-	} 
+	}
 	//barrier -> we gurantee that we wont clobber values (blocks are not overlapping)
+
+	// the barrier threads are schedulable again, the PC groups are stale
+	// until the next rebuild
+	if (getThreadIdInWarp() == 0)
+	{
+		for (unsigned int i = 0; i < (m_blockState.threadsPerBlock)/WARP_SIZE; ++i)
+		{
+			m_schedulers[i].invalidate();
+		}
+
+		// rearm the arrival tracking, fully finished warps stay arrived
+		// so the next barrier only waits on the live ones
+		unsigned int arrived = 0;
+
+		for (unsigned int w = 0;
+			w < (m_blockState.threadsPerBlock)/WARP_SIZE; ++w)
+		{
+			bool finished = true;
+
+			for (unsigned int lane = 0; lane < WARP_SIZE; ++lane)
+			{
+				if (!m_threads[w * WARP_SIZE + lane].finished)
+				{
+					finished = false;
+					break;
+				}
+			}
+
+			m_barrierArrived[w] = finished ? 1 : 0;
+
+			arrived += finished ? 1 : 0;
+		}
+
+		m_arrivedWarps = arrived;
+	}
+}
+
+__device__ void CoreSimBlock::updateBarrierArrival()
+{
+	unsigned int warp = (m_warp - m_threads) / WARP_SIZE;
+
+	// the flag is sticky until the barrier releases, the warp only pays
+	// for the scan on the step that could have changed its state
+	if (m_barrierArrived[warp] != 0) return;
+
+	for (unsigned int lane = 0; lane < WARP_SIZE; ++lane)
+	{
+		if (!m_warp[lane].barrierBit && !m_warp[lane].finished)
+		{
+			return;
+		}
+	}
+
+	m_barrierArrived[warp] = 1;
+
+	atomicAdd(&m_arrivedWarps, 1);
 }
 
 __device__ void CoreSimBlock::setNumberOfThreadsPerBlock(unsigned int threads)
@@ -363,6 +905,166 @@ __device__ void CoreSimBlock::setBlockState(const BlockState& blockState)
 	m_blockState = blockState;
 }
 
+__device__ void CoreSimBlock::saveState(util::File& file)
+{
+	file.write(&m_blockState, sizeof(BlockState));
+
+	bool resident = m_threads != 0;
+
+	file.write(&resident, sizeof(bool));
+
+	if(!resident) return;
+
+	file.write(m_threads, sizeof(CoreSimThread) *
+		m_blockState.threadsPerBlock);
+
+	unsigned int slots = (m_blockState.threadsPerBlock / WARP_SIZE) *
+		m_blockState.registersPerThread;
+
+	file.write(m_scalarRegisters, sizeof(Register) * slots);
+
+	for(unsigned int s = 0; s < slots; ++s)
+	{
+		bool divergent = m_vectorRegisters[s] != 0;
+
+		file.write(&divergent, sizeof(bool));
+
+		if(divergent)
+		{
+			file.write(m_vectorRegisters[s], sizeof(Register) * WARP_SIZE);
+		}
+	}
+}
+
+__device__ void CoreSimBlock::loadState(util::File& file)
+{
+	file.read(&m_blockState, sizeof(BlockState));
+
+	// the saved binary pointer is meaningless in this process, the runtime
+	// rebinds it with setupBinary after loading
+	m_blockState.binary = 0;
+
+	bool resident = false;
+
+	file.read(&resident, sizeof(bool));
+
+	if(!resident) return;
+
+	unsigned int slots = (m_blockState.threadsPerBlock / WARP_SIZE) *
+		m_blockState.registersPerThread;
+
+	if(m_scalarRegisters == 0)
+	{
+		m_scalarRegisters = (Register* )allocateState(
+			sizeof(Register ) * slots);
+		m_vectorRegisters = (Register**)allocateState(
+			sizeof(Register*) * slots);
+
+		for(unsigned int s = 0; s < slots; ++s)
+		{
+			m_vectorRegisters[s] = 0;
+		}
+	}
+
+	if(m_threads == 0)
+	{
+		// raw storage is enough, every thread context is read back from
+		// the checkpoint below
+		m_threads = (CoreSimThread*)allocateState(
+			sizeof(CoreSimThread) * m_blockState.threadsPerBlock);
+	}
+
+	if(m_schedulers == 0)
+	{
+		m_schedulers = (TraceScheduler*)allocateState(
+			sizeof(TraceScheduler) * (m_blockState.threadsPerBlock
+			/ WARP_SIZE));
+
+		for(unsigned w = 0; w < m_blockState.threadsPerBlock
+			/ WARP_SIZE; ++w)
+		{
+			new (m_schedulers + w) TraceScheduler;
+		}
+	}
+
+	file.read(m_threads, sizeof(CoreSimThread) *
+		m_blockState.threadsPerBlock);
+
+	file.read(m_scalarRegisters, sizeof(Register) * slots);
+
+	for(unsigned int s = 0; s < slots; ++s)
+	{
+		bool divergent = false;
+
+		file.read(&divergent, sizeof(bool));
+
+		if(divergent)
+		{
+			if(m_vectorRegisters[s] == 0)
+			{
+				m_vectorRegisters[s] = (Register*)allocateState(
+					sizeof(Register) * WARP_SIZE);
+			}
+
+			file.read(m_vectorRegisters[s], sizeof(Register) * WARP_SIZE);
+		}
+		else if(m_vectorRegisters[s] != 0)
+		{
+			// the slot was divergent before the load, it is uniform in
+			// the checkpoint
+			freeState(m_vectorRegisters[s]);
+
+			m_vectorRegisters[s] = 0;
+		}
+	}
+
+	m_warp = m_threads;
+
+	for(unsigned i = 0; i < m_blockState.threadsPerBlock; ++i)
+	{
+		// the saved parent pointers are also stale, reattach the threads
+		m_threads[i].setParentBlock(this);
+		m_threads[i].setThreadId(i);
+	}
+
+	// the schedulers are rebuilt lazily from the restored thread contexts
+	for(unsigned w = 0; w < m_blockState.threadsPerBlock / WARP_SIZE; ++w)
+	{
+		m_schedulers[w].invalidate();
+	}
+
+	// the arrival tracking is derived state, recompute it from the
+	// restored barrier and exit bits rather than saving it
+	if(m_barrierArrived == 0)
+	{
+		m_barrierArrived = (unsigned int*)allocateState(
+			sizeof(unsigned int) * (m_blockState.threadsPerBlock
+			/ WARP_SIZE));
+	}
+
+	m_arrivedWarps = 0;
+
+	for(unsigned w = 0; w < m_blockState.threadsPerBlock / WARP_SIZE; ++w)
+	{
+		bool arrived = true;
+
+		for(unsigned int lane = 0; lane < WARP_SIZE; ++lane)
+		{
+			CoreSimThread& thread = m_threads[w * WARP_SIZE + lane];
+
+			if(!thread.barrierBit && !thread.finished)
+			{
+				arrived = false;
+				break;
+			}
+		}
+
+		m_barrierArrived[w] = arrived ? 1 : 0;
+
+		if(arrived) ++m_arrivedWarps;
+	}
+}
+
 }
 
 }
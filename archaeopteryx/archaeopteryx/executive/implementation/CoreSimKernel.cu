@@ -24,9 +24,31 @@ __device__ void CoreSimKernel::launchKernel(CoreSimBlock* blocks,
 	unsigned int registerCount = util::KnobDatabase::getKnob<unsigned int>(
 			"simulator-registers-per-thread");
 
-	for (unsigned int simulatedBlock = blockIdx.x;
-		simulatedBlock < simulatedBlocks; simulatedBlock += gridDim.x)
+	__shared__ unsigned int simulatedBlock;
+
+	// persistent threads, each hardware block pulls the next pending
+	// simulated CTA instead of walking a static stride, so a long running
+	// simulated block no longer leaves the other blocks idle at the tail
+	while(true)
 	{
+		if(threadIdx.x == 0)
+		{
+			// a pending snapshot stops the block from starting new
+			// work, the runtime saves state and relaunches
+			if(snapshotRequested())
+			{
+				simulatedBlock = simulatedBlocks;
+			}
+			else
+			{
+				simulatedBlock = atomicAdd(&nextSimulatedBlock, 1);
+			}
+		}
+
+		__syncthreads();
+
+		if(simulatedBlock >= simulatedBlocks) break;
+
 		if(threadIdx.x == 0)
 		{
 			blocks[blockIdx.x].setupBinary(binary);
@@ -37,6 +59,8 @@ __device__ void CoreSimKernel::launchKernel(CoreSimBlock* blocks,
 		__syncthreads();
 
 		blocks[blockIdx.x].runBlock();
+
+		__syncthreads();
 	}
 }
 
@@ -46,6 +70,66 @@ __device__ CoreSimKernel::Address
     return rt::Runtime::translateVirtualToPhysicalAddress(va);
 }
 
+__device__ void CoreSimKernel::addStatistics(
+	const SimulationStatistics& blockStatistics) const
+{
+	// the aggregate is logically shared mutable state, the blocks merge
+	// into it atomically
+	const_cast<SimulationStatistics&>(statistics).add(blockStatistics);
+}
+
+__device__ void CoreSimKernel::countProfile(uint64_t pc,
+	unsigned long long executions, unsigned long long taken) const
+{
+	// the table is shared mutable state like the statistics aggregate,
+	// count() updates it atomically
+	const_cast<InstructionProfile&>(profile).count(pc, executions, taken);
+}
+
+__device__ void CoreSimKernel::recordMemoryTrace(unsigned int blockId,
+	uint64_t pc, const unsigned int* addresses, unsigned int count) const
+{
+	// the trace buffer is shared mutable state like the statistics
+	// aggregate, record() reserves its bytes atomically
+	const_cast<MemoryTrace&>(memoryTrace).record(blockId, pc,
+		addresses, count);
+}
+
+__device__ bool CoreSimKernel::inFastForward() const
+{
+	return fastForwardedInstructions < fastForwardInstructions;
+}
+
+__device__ void CoreSimKernel::countFastForward(
+	unsigned long long instructions) const
+{
+	// the window counter is shared mutable state like the statistics
+	// aggregate, the blocks retire into it atomically
+	atomicAdd(&const_cast<CoreSimKernel*>(this)->fastForwardedInstructions,
+		instructions);
+}
+
+__device__ unsigned long long CoreSimKernel::retiredInstructions() const
+{
+	return statistics.instructions + fastForwardedInstructions;
+}
+
+__device__ bool CoreSimKernel::snapshotRequested() const
+{
+	return snapshotInstructions != 0
+		&& retiredInstructions() >= snapshotBoundary;
+}
+
+__device__ unsigned int CoreSimKernel::accessCache(Address address) const
+{
+	// the tag arrays are shared mutable state like the statistics
+	// aggregate, the coarse model tolerates their races
+	if(const_cast<CacheModel&>(l1Cache).access(address)) return 0;
+	if(const_cast<CacheModel&>(l2Cache).access(address)) return 1;
+
+	return 2;
+}
+
 }
 
 }
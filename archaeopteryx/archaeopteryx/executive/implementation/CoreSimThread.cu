@@ -11,6 +11,8 @@
 #include <archaeopteryx/executive/interface/Intrinsics.h>
 #include <archaeopteryx/executive/interface/OperandAccess.h>
 
+#include <archaeopteryx/ir/interface/DecodedOperand.h>
+
 #include <archaeopteryx/util/interface/debug.h>
 
 // Vanaheimr Includes
@@ -351,6 +353,8 @@ static __device__ ir::Binary::PC executeLd(Instruction* instruction,
 
 	Value a = getOperand(ld->a, parentBlock, threadId);
 
+	parentBlock->recordMemoryAccess(a);
+
 	Value physical = parentBlock->translateVirtualToPhysical(a);
 
 	device_report(" Thread %d, loading from (%p virtual) (%p physical)\n",
@@ -358,7 +362,7 @@ static __device__ ir::Binary::PC executeLd(Instruction* instruction,
 
 	Value d = 0;
 	
-	switch(ld->d.asIndirect.type)
+	switch(ir::asDecoded(ld->d).type)
 	{
 		case vanaheimr::as::i1:
 		case vanaheimr::as::i8:
@@ -556,11 +560,14 @@ static __device__ ir::Binary::PC executeSt(Instruction* instruction,
 	St* st = static_cast<St*>(instruction);
 
 	Value d = getOperand(st->d, parentBlock, threadId);
+
+	parentBlock->recordMemoryAccess(d);
+
 	Value physical = parentBlock->translateVirtualToPhysical(d);
 
 	Value a = getOperand(st->a, parentBlock, threadId);
 
-	switch(st->a.asIndirect.type)
+	switch(ir::asDecoded(st->a).type)
 	{
 		case vanaheimr::as::i1:
 		case vanaheimr::as::i8:
@@ -825,17 +832,92 @@ static __device__ const char* toString(Instruction::Opcode opcode)
 	return "invalid_instruction";
 }
 
+__device__ CoreSimThread::ExecuteFunction CoreSimThread::decode(
+	const Instruction* instruction)
+{
+	return decodeTable[instruction->opcode];
+}
+
+__device__ bool CoreSimThread::canFuse(const Instruction* first,
+	const Instruction* second)
+{
+	typedef vanaheimr::as::Add  Add;
+	typedef vanaheimr::as::Mul  Mul;
+	typedef vanaheimr::as::Ld   Ld;
+
+	switch(first->opcode)
+	{
+	case Instruction::Setp:
+	{
+		// compare + branch
+		return second->opcode == Instruction::Bra;
+	}
+	case Instruction::Mul:
+	{
+		// multiply + dependent add
+		if(second->opcode != Instruction::Add) return false;
+
+		const Mul* mul = static_cast<const Mul*>(first);
+		const Add* add = static_cast<const Add*>(second);
+
+		if(ir::asDecoded(mul->d).mode() != Operand::Register) return false;
+
+		unsigned int reg = ir::asDecoded(mul->d).reg;
+
+		bool readsA = ir::asDecoded(add->a).mode() == Operand::Register &&
+			ir::asDecoded(add->a).reg == reg;
+		bool readsB = ir::asDecoded(add->b).mode() == Operand::Register &&
+			ir::asDecoded(add->b).reg == reg;
+
+		return readsA || readsB;
+	}
+	case Instruction::Add:
+	{
+		// address computation + dependent load
+		if(second->opcode != Instruction::Ld) return false;
+
+		const Add* add = static_cast<const Add*>(first);
+		const Ld*  ld  = static_cast<const Ld*>(second);
+
+		if(ir::asDecoded(add->d).mode() != Operand::Register) return false;
+
+		return ir::asDecoded(ld->a).mode() == Operand::Indirect &&
+			ir::asDecoded(ld->a).reg == ir::asDecoded(add->d).reg;
+	}
+	default: break;
+	}
+
+	return false;
+}
+
 __device__ ir::Binary::PC CoreSimThread::executeInstruction(
 	Instruction* instruction, ir::Binary::PC pc)
 {
-	JumpTablePointer decoderFunction = decodeTable[instruction->opcode];
-	
+	return executeInstruction(instruction, pc, decode(instruction));
+}
+
+__device__ ir::Binary::PC CoreSimThread::executeInstruction(
+	Instruction* instruction, ir::Binary::PC pc,
+	ExecuteFunction decoderFunction)
+{
 	device_report("Thread %d, executing instruction[%d] '%s'\n", m_tId, (int)pc,
 		toString(instruction->opcode));
-	
+
 	return decoderFunction(instruction, pc, m_parentBlock, m_tId);
 }
 
+__device__ ir::Binary::PC CoreSimThread::executeFusedInstructions(
+	Instruction* first, Instruction* second, ir::Binary::PC pc)
+{
+	ir::Binary::PC middlePC = executeInstruction(first, pc);
+
+	// the patterns all fall through, guard anyway so a misdetected pair
+	// can never change results
+	if(middlePC != pc + 1) return middlePC;
+
+	return executeInstruction(second, middlePC);
+}
+
 }
 
 }
@@ -0,0 +1,210 @@
+/*! \file   EventQueue.cu
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the EventQueue class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/EventQueue.h>
+
+#include <archaeopteryx/util/interface/debug.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ EventQueue::EventQueue()
+: m_events(0), m_asleep(0), m_size(0), m_capacity(0), m_sleeping(0),
+	m_cycle(0), m_mutex(0xffffffff)
+{
+
+}
+
+__device__ void EventQueue::setup(unsigned int warps)
+{
+	clear();
+
+	if(warps == 0) return;
+
+	// a warp waits on at most one event at a time
+	m_capacity = warps;
+
+	m_events = new Event[m_capacity];
+	m_asleep = new bool[m_capacity];
+
+	for(unsigned int warp = 0; warp < m_capacity; ++warp)
+	{
+		m_asleep[warp] = false;
+	}
+}
+
+__device__ void EventQueue::clear()
+{
+	delete[] m_events;
+	delete[] m_asleep;
+
+	m_events   = 0;
+	m_asleep   = 0;
+	m_size     = 0;
+	m_capacity = 0;
+	m_sleeping = 0;
+	m_cycle    = 0;
+}
+
+__device__ EventQueue::Cycle EventQueue::now() const
+{
+	return m_cycle;
+}
+
+__device__ void EventQueue::tick()
+{
+	// hardware warps issue concurrently, the coarse clock counts their
+	// steps rather than serializing them
+	atomicAdd((unsigned long long*)&m_cycle, 1ULL);
+}
+
+__device__ void EventQueue::sleep(unsigned int warp, Cycle delay,
+	Event::Type type)
+{
+	device_assert(warp < m_capacity);
+	device_assert(!m_asleep[warp]);
+
+	Event event;
+
+	event.cycle = m_cycle + delay;
+	event.warp  = warp;
+	event.type  = type;
+
+	_lock();
+
+	_push(event);
+
+	m_asleep[warp] = true;
+	++m_sleeping;
+
+	_unlock();
+
+	device_report("warp %d sleeping until cycle %lld\n", warp,
+		(long long)event.cycle);
+}
+
+__device__ bool EventQueue::asleep(unsigned int warp) const
+{
+	if(m_asleep == 0) return false;
+
+	device_assert(warp < m_capacity);
+
+	return m_asleep[warp];
+}
+
+__device__ unsigned int EventQueue::sleepingWarps() const
+{
+	return m_sleeping;
+}
+
+__device__ unsigned int EventQueue::wake()
+{
+	unsigned int woken = 0;
+
+	_lock();
+
+	if(m_size != 0)
+	{
+		// the block is idle, jump the clock instead of spinning it
+		if(m_events[0].cycle > m_cycle)
+		{
+			m_cycle = m_events[0].cycle;
+		}
+
+		while(m_size != 0 && m_events[0].cycle <= m_cycle)
+		{
+			Event event = _pop();
+
+			m_asleep[event.warp] = false;
+			--m_sleeping;
+			++woken;
+
+			device_report("warp %d woken at cycle %lld\n", event.warp,
+				(long long)m_cycle);
+		}
+	}
+
+	_unlock();
+
+	return woken;
+}
+
+__device__ void EventQueue::_push(const Event& event)
+{
+	device_assert(m_size < m_capacity);
+
+	unsigned int position = m_size++;
+
+	while(position != 0)
+	{
+		unsigned int parent = (position - 1) / 2;
+
+		if(m_events[parent].cycle <= event.cycle) break;
+
+		m_events[position] = m_events[parent];
+
+		position = parent;
+	}
+
+	m_events[position] = event;
+}
+
+__device__ EventQueue::Event EventQueue::_pop()
+{
+	device_assert(m_size != 0);
+
+	Event earliest = m_events[0];
+
+	Event displaced = m_events[--m_size];
+
+	unsigned int position = 0;
+
+	while(true)
+	{
+		unsigned int child = position * 2 + 1;
+
+		if(child >= m_size) break;
+
+		if(child + 1 < m_size &&
+			m_events[child + 1].cycle < m_events[child].cycle)
+		{
+			++child;
+		}
+
+		if(displaced.cycle <= m_events[child].cycle) break;
+
+		m_events[position] = m_events[child];
+
+		position = child;
+	}
+
+	if(m_size != 0)
+	{
+		m_events[position] = displaced;
+	}
+
+	return earliest;
+}
+
+__device__ void EventQueue::_lock()
+{
+	unsigned int gid = threadIdx.x + blockIdx.x * blockDim.x;
+
+	while(atomicCAS(&m_mutex, 0xffffffff, gid) != 0xffffffff);
+}
+
+__device__ void EventQueue::_unlock()
+{
+	atomicCAS(&m_mutex, threadIdx.x + blockIdx.x * blockDim.x, 0xffffffff);
+}
+
+}
+
+}
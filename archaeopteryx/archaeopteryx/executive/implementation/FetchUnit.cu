@@ -0,0 +1,223 @@
+/*! \file   FetchUnit.cu
+	\date   Tuesday April 26, 2011
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	        Sudnya  Diamos <mailsudnya@gmail.com>
+	\brief  The source file for the FetchUnit class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/FetchUnit.h>
+#include <archaeopteryx/executive/interface/CoreSimThread.h>
+
+#include <archaeopteryx/util/interface/debug.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/Instruction.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ FetchUnit::FetchUnit()
+: _tags(0), _lines(0), _sets(0), _victim(0), _hits(0), _misses(0), _fused(0),
+	_binary(0)
+{
+
+}
+
+__device__ FetchUnit::FetchUnit(ir::Binary* b)
+: _tags(0), _lines(0), _sets(0), _victim(0), _hits(0), _misses(0), _fused(0),
+	_binary(b)
+{
+
+}
+
+__device__ void FetchUnit::setCache(void* cache, unsigned int size)
+{
+	const unsigned int bytesPerLine = sizeof(LineTag) +
+		sizeof(InstructionContainer) * LineSize;
+
+	unsigned int lines = size / bytesPerLine;
+
+	_sets = lines / Associativity;
+
+	device_assert(_sets > 0);
+
+	_tags  = (LineTag*)cache;
+	_lines = (InstructionContainer*)(_tags + _sets * Associativity);
+
+	for(unsigned int line = 0; line < _sets * Associativity; ++line)
+	{
+		_tags[line].basePC       = InvalidPC;
+		_tags[line].instructions = 0;
+		_tags[line].fusionMask   = 0;
+	}
+
+	_victim = 0;
+	_hits   = 0;
+	_misses = 0;
+	_fused  = 0;
+
+	device_report("Fetch cache holds %d lines of %d instructions "
+		"in %d sets\n", _sets * Associativity, LineSize, _sets);
+}
+
+__device__ bool FetchUnit::hasCache() const
+{
+	return _sets != 0;
+}
+
+__device__ const FetchUnit::InstructionContainer*
+	FetchUnit::getInstruction(PC pc)
+{
+	bool fusedWithNext = false;
+
+	return getInstruction(pc, fusedWithNext);
+}
+
+__device__ const FetchUnit::InstructionContainer*
+	FetchUnit::getInstruction(PC pc, bool& fusedWithNext)
+{
+	Fill fill;
+
+	probe(pc, fill);
+	fillLine(fill);
+
+	return finishFetch(pc, fill, fusedWithNext);
+}
+
+__device__ void FetchUnit::probe(PC pc, Fill& fill)
+{
+	device_assert(hasCache());
+
+	const unsigned int instructionsPerPage =
+		sizeof(ir::Binary::PageDataType) / sizeof(InstructionContainer);
+
+	PC lineBase = pc - (pc % LineSize);
+
+	// a fill never crosses a code page, clip the line at the page end and
+	// restart it at the pc when the alignment put the base on the previous
+	// page
+	unsigned int pageOffset   = (unsigned int)(lineBase % instructionsPerPage);
+	unsigned int instructions = LineSize;
+
+	if(pageOffset + instructions > instructionsPerPage)
+	{
+		instructions = instructionsPerPage - pageOffset;
+	}
+
+	if(pc - lineBase >= instructions)
+	{
+		lineBase     = pc;
+		instructions = LineSize;
+		pageOffset   = (unsigned int)(lineBase % instructionsPerPage);
+
+		if(pageOffset + instructions > instructionsPerPage)
+		{
+			instructions = instructionsPerPage - pageOffset;
+		}
+	}
+
+	fill.lineBase     = lineBase;
+	fill.instructions = instructions;
+
+	unsigned int set = (unsigned int)((lineBase / LineSize) % _sets);
+
+	LineTag* tags = _tags + set * Associativity;
+
+	for(unsigned int way = 0; way < Associativity; ++way)
+	{
+		if(tags[way].basePC == lineBase)
+		{
+			++_hits;
+
+			fill.needed = false;
+			fill.line   = set * Associativity + way;
+
+			return;
+		}
+	}
+
+	// miss, fill a victim line chosen round robin within the set
+	++_misses;
+
+	unsigned int way = _victim++ % Associativity;
+
+	fill.needed = true;
+	fill.line   = set * Associativity + way;
+
+	// fault the code page in from this one thread, the page lock must
+	// never be contended within a warp, and the cooperative copy in
+	// fillLine then runs on a resident page
+	_binary->getCodePage(_binary->code_begin() +
+		lineBase / instructionsPerPage);
+
+	device_report("Fetch miss at PC %d, filling line %d with %d "
+		"instructions\n", (unsigned int)pc, fill.line, instructions);
+}
+
+__device__ void FetchUnit::fillLine(const Fill& fill)
+{
+	if(!fill.needed) return;
+
+	_binary->copyCode(_line(fill.line), fill.lineBase, fill.instructions);
+}
+
+__device__ const FetchUnit::InstructionContainer* FetchUnit::finishFetch(
+	PC pc, const Fill& fill, bool& fusedWithNext)
+{
+	if(fill.needed)
+	{
+		// detect macro-op patterns once per fill, pairs never span a line
+		// so the last instruction of a line always executes on its own
+		unsigned int fusionMask = 0;
+
+		#if MACRO_OP_FUSION
+		for(unsigned int i = 0; i + 1 < fill.instructions; ++i)
+		{
+			if(CoreSimThread::canFuse(&_line(fill.line)[i].asInstruction,
+				&_line(fill.line)[i + 1].asInstruction))
+			{
+				fusionMask |= 1 << i;
+			}
+		}
+		#endif
+
+		_tags[fill.line].basePC       = fill.lineBase;
+		_tags[fill.line].instructions = fill.instructions;
+		_tags[fill.line].fusionMask   = fusionMask;
+	}
+
+	fusedWithNext =
+		(_tags[fill.line].fusionMask >> (pc - fill.lineBase)) & 0x1;
+
+	if(fusedWithNext) ++_fused;
+
+	return _line(fill.line) + (pc - fill.lineBase);
+}
+
+__device__ unsigned long long FetchUnit::hits() const
+{
+	return _hits;
+}
+
+__device__ unsigned long long FetchUnit::misses() const
+{
+	return _misses;
+}
+
+__device__ unsigned long long FetchUnit::fused() const
+{
+	return _fused;
+}
+
+__device__ FetchUnit::InstructionContainer* FetchUnit::_line(unsigned int line)
+{
+	return _lines + line * LineSize;
+}
+
+}
+
+}
@@ -0,0 +1,141 @@
+/*! \file   InstructionProfile.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the InstructionProfile class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/InstructionProfile.h>
+
+#include <archaeopteryx/ir/interface/Binary.h>
+
+#include <archaeopteryx/util/interface/File.h>
+#include <archaeopteryx/util/interface/cstring.h>
+#include <archaeopteryx/util/interface/debug.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ InstructionProfile::InstructionProfile()
+: counters(0), size(0)
+{
+
+}
+
+__device__ void InstructionProfile::setup(ir::Binary* binary)
+{
+	clear();
+
+	const size_t instructionsPerPage = sizeof(ir::Binary::PageDataType) /
+		sizeof(ir::Binary::InstructionContainer);
+
+	size = instructionsPerPage *
+		(binary->code_end() - binary->code_begin());
+
+	counters = new Counter[size];
+
+	for(uint64_t pc = 0; pc < size; ++pc)
+	{
+		counters[pc].executions = 0;
+		counters[pc].taken      = 0;
+	}
+}
+
+__device__ void InstructionProfile::clear()
+{
+	delete[] counters;
+
+	counters = 0;
+	size     = 0;
+}
+
+__device__ bool InstructionProfile::enabled() const
+{
+	return counters != 0;
+}
+
+__device__ void InstructionProfile::count(PC pc,
+	unsigned long long executions, unsigned long long taken)
+{
+	if(counters == 0) return;
+	if(pc >= size)    return;
+
+	atomicAdd(&counters[pc].executions, executions);
+
+	if(taken != 0)
+	{
+		atomicAdd(&counters[pc].taken, taken);
+	}
+}
+
+__device__ void InstructionProfile::writeToFile(const char* fileName,
+	ir::Binary* binary) const
+{
+	typedef ir::Binary::StringVector      StringVector;
+	typedef ir::Binary::SymbolTableEntry  SymbolTableEntry;
+
+	if(counters == 0) return;
+
+	device_report("Writing instruction profile to '%s'\n", fileName);
+
+	// the empty substring matches every symbol
+	StringVector names = binary->getSymbolNamesThatMatch("");
+
+	util::File file(fileName, "w");
+
+	FileHeader header;
+
+	util::memcpy(header.magic, "VIRPROF0", sizeof(header.magic));
+
+	header.symbols = 0;
+
+	for(StringVector::iterator name = names.begin();
+		name != names.end(); ++name)
+	{
+		SymbolTableEntry* symbol = binary->findSymbol(name->c_str());
+
+		if(symbol == 0)                                   continue;
+		if(symbol->type != SymbolTableEntry::FunctionType) continue;
+
+		++header.symbols;
+	}
+
+	file.write(&header, sizeof(FileHeader));
+
+	for(StringVector::iterator name = names.begin();
+		name != names.end(); ++name)
+	{
+		SymbolTableEntry* symbol = binary->findSymbol(name->c_str());
+
+		if(symbol == 0)                                   continue;
+		if(symbol->type != SymbolTableEntry::FunctionType) continue;
+
+		PC pc = binary->findFunctionsPC(name->c_str());
+
+		SymbolRecord record;
+
+		util::strlcpy(record.name, name->c_str(), sizeof(record.name));
+
+		record.instructions = symbol->size /
+			sizeof(ir::Binary::InstructionContainer);
+
+		if(pc + record.instructions > size)
+		{
+			record.instructions = pc < size ? size - pc : 0;
+		}
+
+		file.write(&record, sizeof(SymbolRecord));
+		file.write(counters + pc, record.instructions * sizeof(Counter));
+	}
+
+	device_report(" wrote records for %d function symbols\n",
+		(unsigned int)header.symbols);
+}
+
+}
+
+}
+
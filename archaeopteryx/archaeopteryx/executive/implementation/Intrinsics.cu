@@ -11,6 +11,7 @@
 #include <archaeopteryx/executive/interface/OperandAccess.h>
 
 #include <archaeopteryx/ir/interface/Binary.h>
+#include <archaeopteryx/ir/interface/DecodedOperand.h>
 
 #include <archaeopteryx/util/interface/debug.h>
 #include <archaeopteryx/util/interface/string.h>
@@ -38,18 +39,19 @@ __device__ bool Intrinsics::isIntrinsic(const vanaheimr::as::Call* call,
 {
 	cta_report("Checking if call is an intrinsic.\n");
 
-	if(call->target.asOperand.mode != vanaheimr::as::Operand::Symbol)
+	const ir::DecodedOperand& target = ir::asDecoded(call->target);
+
+	if(target.mode() != vanaheimr::as::Operand::Symbol)
 	{
 		return false;
 	}
 
-	const vanaheimr::as::SymbolOperand* symbol = &call->target.asSymbol;
-
+	// a decoded symbol operand keeps its symbol table offset as the
+	// addend
 	cta_report(" checking if symbol '%d' is "
-		"an intrinsisc...\n", symbol->symbolTableOffset);
+		"an intrinsisc...\n", target.addend);
 
-	util::string name = block->binary()->getSymbolName(
-		symbol->symbolTableOffset);
+	util::string name = block->binary()->getSymbolName(target.addend);
 
 	bool isIntrinsic = name.find("_Zintrinsic") == 0;
 
@@ -98,13 +100,11 @@ __device__ IntrinsicDatabase* _intrinsics = 0;
 __device__ void Intrinsics::execute(const vanaheimr::as::Call* call,
 	CoreSimBlock* block, unsigned int threadId)
 {
-	device_assert(call->target.asOperand.mode ==
-		vanaheimr::as::Operand::Symbol);
+	const ir::DecodedOperand& target = ir::asDecoded(call->target);
 
-	const vanaheimr::as::SymbolOperand* symbol = &call->target.asSymbol;
+	device_assert(target.mode() == vanaheimr::as::Operand::Symbol);
 
-	util::string name = block->binary()->getSymbolName(
-		symbol->symbolTableOffset);
+	util::string name = block->binary()->getSymbolName(target.addend);
 
 	device_report("thread %d, executing intrinsic '%s'\n", threadId,
 		name.c_str());
@@ -0,0 +1,134 @@
+/*! \file   MemoryTrace.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the MemoryTrace class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/MemoryTrace.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ MemoryTrace::MemoryTrace()
+: m_buffer(0), m_size(0), m_offset(0), m_full(0), m_dropped(0)
+{
+
+}
+
+__device__ void MemoryTrace::setup(size_t bytes)
+{
+	clear();
+
+	if(bytes == 0) return;
+
+	m_buffer = new char[bytes];
+	m_size   = bytes;
+	m_full   = bytes;
+}
+
+__device__ void MemoryTrace::clear()
+{
+	delete[] m_buffer;
+
+	m_buffer  = 0;
+	m_size    = 0;
+	m_offset  = 0;
+	m_full    = 0;
+	m_dropped = 0;
+}
+
+__device__ bool MemoryTrace::enabled() const
+{
+	return m_buffer != 0;
+}
+
+// Unsigned LEB128, seven payload bits per byte, high bit continues
+static __device__ unsigned int encode(char* buffer, uint64_t value)
+{
+	unsigned int bytes = 0;
+
+	do
+	{
+		char byte = value & 0x7f;
+
+		value >>= 7;
+
+		if(value != 0) byte |= 0x80;
+
+		buffer[bytes++] = byte;
+	}
+	while(value != 0);
+
+	return bytes;
+}
+
+// Fold the sign into the low bit so small negative deltas encode small
+static __device__ uint64_t zigzag(int64_t value)
+{
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+__device__ void MemoryTrace::record(unsigned int blockId, uint64_t pc,
+	const unsigned int* addresses, unsigned int count)
+{
+	// the capture arrays hold at most two accesses per thread and every
+	// field encodes to at most ten bytes
+	char scratch[512];
+
+	unsigned int bytes = 0;
+
+	bytes += encode(scratch + bytes, blockId);
+	bytes += encode(scratch + bytes, pc);
+	bytes += encode(scratch + bytes, count);
+	bytes += encode(scratch + bytes, addresses[0]);
+
+	for(unsigned int i = 1; i < count; ++i)
+	{
+		bytes += encode(scratch + bytes,
+			zigzag((int64_t)addresses[i] - (int64_t)addresses[i - 1]));
+	}
+
+	unsigned long long offset = atomicAdd(&m_offset,
+		(unsigned long long)bytes);
+
+	if(offset + bytes > m_size)
+	{
+		// reservations are handed out in order, so everything from the
+		// first failure on is dropped and the data below it stays valid
+		atomicMin(&m_full, offset);
+		atomicAdd(&m_dropped, 1ULL);
+
+		return;
+	}
+
+	std::memcpy(m_buffer + offset, scratch, bytes);
+}
+
+__device__ const char* MemoryTrace::data() const
+{
+	return m_buffer;
+}
+
+__device__ size_t MemoryTrace::bytes() const
+{
+	return m_offset < m_full ? m_offset : m_full;
+}
+
+__device__ unsigned long long MemoryTrace::dropped() const
+{
+	return m_dropped;
+}
+
+__device__ void MemoryTrace::reset()
+{
+	m_offset = 0;
+	m_full   = m_size;
+}
+
+}
+
+}
@@ -8,6 +8,8 @@
 #include <archaeopteryx/executive/interface/OperandAccess.h>
 #include <archaeopteryx/executive/interface/CoreSimBlock.h>
 
+#include <archaeopteryx/ir/interface/DecodedOperand.h>
+
 // Vanaheimr Includes
 #include <vanaheimr/asm/interface/Operand.h>
 #include <vanaheimr/asm/interface/Instruction.h>
@@ -22,114 +24,46 @@ namespace executive
 {
 
 typedef vanaheimr::as::Operand          Operand;
-typedef vanaheimr::as::RegisterOperand  RegisterOperand;
-typedef vanaheimr::as::PredicateOperand PredicateOperand;
-typedef vanaheimr::as::ImmediateOperand ImmediateOperand;
-typedef vanaheimr::as::IndirectOperand  IndirectOperand;
 typedef vanaheimr::as::OperandContainer OperandContainer;
 
-__device__ uint64_t getRegisterOperand(
-	const Operand& operand, CoreSimBlock* block, unsigned threadId)
+__device__ uint64_t getOperand(
+	const OperandContainer& operandContainer,
+	CoreSimBlock* parentBlock, unsigned threadId)
 {
-	const RegisterOperand& reg =
-		static_cast<const RegisterOperand&>(operand); 
-
-	uint64_t value = block->getRegister(threadId, reg.reg);
-
-	return value;
-}
+	const ir::DecodedOperand& operand = ir::asDecoded(operandContainer);
 
-__device__ uint64_t getImmediateOperand(
-	const Operand& operand, CoreSimBlock* block, unsigned threadId)
-{
-	const ImmediateOperand& imm =
-		static_cast<const ImmediateOperand&>(operand); 
+	// instruction operands were rewritten when their code page loaded
+	device_assert(operand.decoded());
+	device_assert_m(operand.mode() != Operand::Symbol,
+		"Symbol operands not supported in emulator, "
+		"they should have been lowered!");
 
-	return imm.uint;
-}
+	// a single uniform path, a flagged register resolves and the
+	// extracted immediate value or indirect offset adds on top
+	uint64_t value = operand.addend;
 
-__device__ uint64_t getPredicateOperand(
-	const Operand& operand, CoreSimBlock* block, unsigned threadId)
-{
-	const PredicateOperand& reg =
-		static_cast<const PredicateOperand&>(operand); 
-	//FIX ME	
-	
-	uint64_t value = block->getRegister(threadId, reg.reg);
-
-	switch(reg.modifier)
-	{
-	case PredicateOperand::StraightPredicate:
+	if(operand.flags & ir::DecodedOperand::ReadsRegister)
 	{
-		value = value;
-		break;
-	}
-	// TODO
+		// a uniform register is one broadcast load for the whole warp,
+		// a divergent one is a coalesced load from the lane vector
+		value += parentBlock->getRegister(threadId, operand.reg);
 	}
 
 	return value;
 }
 
-__device__ uint64_t getIndirectOperand(
-	const Operand& operand, CoreSimBlock* block, unsigned threadId)
-{
-	const IndirectOperand& indirect =
-		static_cast<const IndirectOperand&>(operand); 
-	
-	uint64_t address = block->getRegister(threadId, indirect.reg) +
-		indirect.offset;
-
-	//FIXMe	
-	return address;
-}
-
-__device__ uint64_t getSymbolOperand(
-	const Operand& operand, CoreSimBlock* block, unsigned threadId)
-{
-	device_assert_m(false, "Symbol operands not supported in emulator, "
-		"they should have been lowered!");
-
-	return 0;
-}
-
-typedef uint64_t (*GetOperandValuePointer)(const Operand&,
-	CoreSimBlock*, unsigned);
-
-__device__ GetOperandValuePointer getOperandFunctionTable[] = {
-	getRegisterOperand,
-	getImmediateOperand,
-	getPredicateOperand,
-	getIndirectOperand,
-	getSymbolOperand
-};
-
-__device__ uint64_t getOperand(const Operand& operand,
-	CoreSimBlock* parentBlock, unsigned threadId)
-{
-	GetOperandValuePointer function = getOperandFunctionTable[operand.mode];
-
-	return function(operand, parentBlock, threadId);
-}
-
-__device__ uint64_t getOperand(
-	const OperandContainer& operandContainer,
-	CoreSimBlock* parentBlock, unsigned threadId)
-{
-	return getOperand(operandContainer.asOperand, parentBlock, threadId);
-}
-
 __device__ unsigned int getReturnRegister(const vanaheimr::as::Call* call,
 	CoreSimBlock* block)
 {
 	device_assert(call->returnArguments > 0);
-	
+
 	vanaheimr::as::OperandContainer operand;
-	
+
 	block->binary()->copyDataToAddress(&operand, call->returnArgumentOffset,
 		sizeof(vanaheimr::as::OperandContainer));
 
 	device_assert(operand.asOperand.mode == vanaheimr::as::Operand::Register);
-	
+
 	return operand.asRegister.reg;
 }
 
@@ -137,20 +71,23 @@ __device__ uint64_t getOperand(const vanaheimr::as::Call* call,
 	CoreSimBlock* block, unsigned threadId, unsigned int index)
 {
 	device_assert(call->arguments > index);
-	
+
 	vanaheimr::as::OperandContainer operand;
-	
+
 	block->binary()->copyDataToAddress(&operand,
 		call->argumentOffset + index * sizeof(vanaheimr::as::OperandContainer),
 		sizeof(vanaheimr::as::OperandContainer));
-	
+
+	// argument operands come out of the data section in bytecode form
+	ir::decodeOperand(operand);
+
 	return getOperand(operand, block, threadId);
 }
 
 __device__ void setRegister(OperandContainer& operandContainer,
 	CoreSimBlock* parentBlock, unsigned threadId, uint64_t result)
 {
-	const RegisterOperand& reg = operandContainer.asRegister;
+	const ir::DecodedOperand& reg = ir::asDecoded(operandContainer);
 
 	parentBlock->setRegister(threadId, reg.reg, result);
 }
@@ -164,5 +101,3 @@ __device__ void setRegister(unsigned int reg, CoreSimBlock* parentBlock,
 }
 
 }
-
-
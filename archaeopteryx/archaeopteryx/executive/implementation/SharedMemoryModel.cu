@@ -0,0 +1,69 @@
+/*! \file   SharedMemoryModel.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the SharedMemoryModel class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/SharedMemoryModel.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ unsigned int SharedMemoryModel::bank(unsigned int address)
+{
+	return (address >> LogBankWidth) % Banks;
+}
+
+__device__ unsigned int SharedMemoryModel::serializedPasses(
+	const unsigned int* addresses, unsigned int count)
+{
+	unsigned int depth[Banks];
+
+	for (unsigned int b = 0; b < Banks; ++b)
+	{
+		depth[b] = 0;
+	}
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		unsigned int word = addresses[i] >> LogBankWidth;
+
+		// accesses to the same word broadcast, only the first one deepens
+		// the bank
+		bool firstAccess = true;
+
+		for (unsigned int j = 0; j < i; ++j)
+		{
+			if ((addresses[j] >> LogBankWidth) == word)
+			{
+				firstAccess = false;
+				break;
+			}
+		}
+
+		if (firstAccess)
+		{
+			++depth[word % Banks];
+		}
+	}
+
+	unsigned int passes = count > 0 ? 1 : 0;
+
+	for (unsigned int b = 0; b < Banks; ++b)
+	{
+		if (depth[b] > passes)
+		{
+			passes = depth[b];
+		}
+	}
+
+	return passes;
+}
+
+}
+
+}
@@ -0,0 +1,135 @@
+/*! \file   SimulationStatistics.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the SimulationStatistics class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/SimulationStatistics.h>
+
+#include <archaeopteryx/util/interface/HostReflectionDevice.h>
+#include <archaeopteryx/util/interface/cstring.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ void SimulationStatistics::clear()
+{
+	instructions       = 0;
+	scheduledSteps     = 0;
+	memoryTransactions = 0;
+	divergentSteps     = 0;
+	barrierWaits       = 0;
+
+	sharedMemoryAccesses = 0;
+	bankConflicts        = 0;
+	sharedMemoryCycles   = 0;
+
+	globalMemoryAccesses = 0;
+	globalTransactions   = 0;
+	globalMemoryCycles   = 0;
+
+	l1CacheHits   = 0;
+	l1CacheMisses = 0;
+	l2CacheHits   = 0;
+	l2CacheMisses = 0;
+}
+
+__device__ void SimulationStatistics::add(
+	const SimulationStatistics& statistics)
+{
+	atomicAdd(&instructions,       statistics.instructions);
+	atomicAdd(&scheduledSteps,     statistics.scheduledSteps);
+	atomicAdd(&memoryTransactions, statistics.memoryTransactions);
+	atomicAdd(&divergentSteps,     statistics.divergentSteps);
+	atomicAdd(&barrierWaits,       statistics.barrierWaits);
+
+	atomicAdd(&sharedMemoryAccesses, statistics.sharedMemoryAccesses);
+	atomicAdd(&bankConflicts,        statistics.bankConflicts);
+	atomicAdd(&sharedMemoryCycles,   statistics.sharedMemoryCycles);
+
+	atomicAdd(&globalMemoryAccesses, statistics.globalMemoryAccesses);
+	atomicAdd(&globalTransactions,   statistics.globalTransactions);
+	atomicAdd(&globalMemoryCycles,   statistics.globalMemoryCycles);
+
+	atomicAdd(&l1CacheHits,   statistics.l1CacheHits);
+	atomicAdd(&l1CacheMisses, statistics.l1CacheMisses);
+	atomicAdd(&l2CacheHits,   statistics.l2CacheHits);
+	atomicAdd(&l2CacheMisses, statistics.l2CacheMisses);
+}
+
+/*! \brief Carries a counter block to the host, the layout is mirrored by
+	the host side handler */
+class StatisticsMessage : public util::HostReflectionDevice::Message
+{
+public:
+	class Payload
+	{
+	public:
+		unsigned long long counters[15];
+		char               name[64];
+	};
+
+public:
+	__device__ StatisticsMessage(const SimulationStatistics& statistics,
+		const char* name)
+	{
+		_payload.counters[0] = statistics.instructions;
+		_payload.counters[1] = statistics.scheduledSteps;
+		_payload.counters[2] = statistics.memoryTransactions;
+		_payload.counters[3] = statistics.divergentSteps;
+		_payload.counters[4] = statistics.barrierWaits;
+		_payload.counters[5] = statistics.sharedMemoryAccesses;
+		_payload.counters[6] = statistics.bankConflicts;
+		_payload.counters[7] = statistics.sharedMemoryCycles;
+		_payload.counters[8]  = statistics.globalMemoryAccesses;
+		_payload.counters[9]  = statistics.globalTransactions;
+		_payload.counters[10] = statistics.globalMemoryCycles;
+		_payload.counters[11] = statistics.l1CacheHits;
+		_payload.counters[12] = statistics.l1CacheMisses;
+		_payload.counters[13] = statistics.l2CacheHits;
+		_payload.counters[14] = statistics.l2CacheMisses;
+
+		unsigned int i = 0;
+
+		for(; i < sizeof(_payload.name) - 1 && name[i] != '\0'; ++i)
+		{
+			_payload.name[i] = name[i];
+		}
+
+		_payload.name[i] = '\0';
+	}
+
+public:
+	__device__ virtual void* payload() const
+	{
+		return (void*)&_payload;
+	}
+
+	__device__ virtual size_t payloadSize() const
+	{
+		return sizeof(Payload);
+	}
+
+	__device__ virtual util::HostReflectionDevice::HandlerId handler() const
+	{
+		return util::HostReflectionDevice::SimulationStatisticsMessageHandler;
+	}
+
+private:
+	Payload _payload;
+};
+
+__device__ void SimulationStatistics::report(const char* name) const
+{
+	StatisticsMessage message(*this, name);
+
+	util::HostReflectionDevice::sendAsynchronous(message);
+}
+
+}
+
+}
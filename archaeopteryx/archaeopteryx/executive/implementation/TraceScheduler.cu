@@ -0,0 +1,196 @@
+/*! \file   TraceScheduler.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the TraceScheduler class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/TraceScheduler.h>
+#include <archaeopteryx/executive/interface/CoreSimThread.h>
+
+#include <archaeopteryx/util/interface/debug.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+__device__ TraceScheduler::TraceScheduler()
+: _valid(false), _count(0), _stackDepth(0)
+{
+
+}
+
+__device__ void TraceScheduler::invalidate()
+{
+	_valid = false;
+	_count = 0;
+
+	// a bulk barrier release means the whole warp synchronized, any
+	// divergence has already reconverged
+	_stackDepth = 0;
+}
+
+__device__ bool TraceScheduler::valid() const
+{
+	return _valid;
+}
+
+__device__ void TraceScheduler::rebuild(const CoreSimThread* warp)
+{
+	_count = 0;
+
+	for(unsigned int thread = 0; thread < WARP_SIZE; ++thread)
+	{
+		// threads waiting at a barrier are not schedulable, they rejoin
+		// at the next rebuild after the barrier bits are cleared
+		if(warp[thread].barrierBit) continue;
+
+		_addMember(warp[thread].pc, warp[thread].instructionPriority);
+	}
+
+	_valid = true;
+
+	device_report("Rebuilt trace scheduler groups, %d PCs\n", _count);
+}
+
+__device__ TraceScheduler::PC TraceScheduler::nextPC(
+	unsigned int& priority)
+{
+	if(_count == 0)
+	{
+		// every thread is waiting at a barrier
+		priority = 0;
+
+		return 0;
+	}
+
+	// the groups are sorted, pick the highest priority group that has
+	// not reached a pending reconvergence point yet
+	for(unsigned int group = 0; group < _count; ++group)
+	{
+		if(_isReconvergencePoint(_groups[group].pc)) continue;
+
+		priority = _groups[group].priority;
+
+		return _groups[group].pc;
+	}
+
+	// every group is parked, release the most recently pushed point so
+	// the innermost divergence reconverges first
+	while(_stackDepth > 0)
+	{
+		PC pc = _reconvergeStack[--_stackDepth];
+
+		Group* group = _findGroup(pc);
+
+		// a stale point, every thread that was headed there exited
+		if(group == 0) continue;
+
+		device_report("Releasing reconvergence point at pc %d\n", (int)pc);
+
+		priority = group->priority;
+
+		return pc;
+	}
+
+	priority = _groups[0].priority;
+
+	return _groups[0].pc;
+}
+
+__device__ void TraceScheduler::pushReconvergencePoint(PC pc)
+{
+	// a full stack or a repeated point degrades to priority order, the
+	// warp still reconverges, just later than the post-dominator
+	if(_stackDepth == WARP_SIZE) return;
+	if(_stackDepth > 0 && _reconvergeStack[_stackDepth - 1] == pc) return;
+
+	device_report("Pushed reconvergence point at pc %d\n", (int)pc);
+
+	_reconvergeStack[_stackDepth++] = pc;
+}
+
+__device__ void TraceScheduler::threadMoved(PC oldPC, PC newPC,
+	unsigned int priority, bool barrier)
+{
+	_removeMember(oldPC);
+
+	if(!barrier)
+	{
+		_addMember(newPC, priority);
+	}
+}
+
+__device__ bool TraceScheduler::_isReconvergencePoint(PC pc) const
+{
+	for(unsigned int point = 0; point < _stackDepth; ++point)
+	{
+		if(_reconvergeStack[point] == pc) return true;
+	}
+
+	return false;
+}
+
+__device__ TraceScheduler::Group* TraceScheduler::_findGroup(PC pc)
+{
+	for(unsigned int group = 0; group < _count; ++group)
+	{
+		if(_groups[group].pc == pc)
+		{
+			return _groups + group;
+		}
+	}
+
+	return 0;
+}
+
+__device__ void TraceScheduler::_removeMember(PC pc)
+{
+	Group* group = _findGroup(pc);
+
+	device_assert(group != 0);
+
+	if(--group->members != 0) return;
+
+	// the group emptied out, erase it to keep lookups short
+	for(unsigned int next = (group - _groups) + 1; next < _count; ++next)
+	{
+		_groups[next - 1] = _groups[next];
+	}
+
+	--_count;
+}
+
+__device__ void TraceScheduler::_addMember(PC pc, unsigned int priority)
+{
+	Group* group = _findGroup(pc);
+
+	if(group != 0)
+	{
+		++group->members;
+
+		return;
+	}
+
+	device_assert(_count < WARP_SIZE);
+
+	// walk back from the tail to the sorted position of the new group
+	unsigned int position = _count++;
+
+	while(position > 0 && _groups[position - 1].priority < priority)
+	{
+		_groups[position] = _groups[position - 1];
+
+		--position;
+	}
+
+	_groups[position].pc       = pc;
+	_groups[position].members  = 1;
+	_groups[position].priority = priority;
+}
+
+}
+
+}
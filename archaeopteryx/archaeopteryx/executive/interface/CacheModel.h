@@ -0,0 +1,65 @@
+/*! \file   CacheModel.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CacheModel class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/IntTypes.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief One level of a simulated cache.
+
+	A set associative tag array in device memory, geometry comes from the
+	knob database when the runtime configures a launch.  The model is
+	deliberately coarse: it tracks residency with round robin
+	replacement and tolerates racy tag updates from concurrent warps,
+	only the hit and miss counters it feeds are exact.  A size of zero
+	leaves the level disabled and every access reported as a miss. */
+class CacheModel
+{
+public:
+	typedef uint64_t Address;
+
+public:
+	/*! \brief Starts out disabled with no tag array attached */
+	__device__ CacheModel();
+
+	/*! \brief Allocate and invalidate the tag array for the geometry */
+	__device__ void setup(unsigned int size, unsigned int associativity,
+		unsigned int lineSize);
+
+	/*! \brief Free the tag array and disable the level */
+	__device__ void clear();
+
+	/*! \brief Is a tag array attached? */
+	__device__ bool enabled() const;
+
+	/*! \brief Probe and update the tag array, true on a hit */
+	__device__ bool access(Address address);
+
+private:
+	__device__ unsigned int _set(Address address) const;
+	__device__ uint64_t     _tag(Address address) const;
+
+private:
+	/*! \brief The resident line tags, sets x ways, invalid lines hold -1 */
+	uint64_t* m_tags;
+	/*! \brief The next victim way in each set */
+	unsigned int* m_victims;
+
+	unsigned int m_sets;
+	unsigned int m_ways;
+	unsigned int m_lineSize;
+};
+
+}
+
+}
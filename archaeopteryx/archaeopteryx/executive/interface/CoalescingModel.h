@@ -0,0 +1,48 @@
+/*! \file   CoalescingModel.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CoalescingModel class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/StaticKnob.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief The timing model for simulated global memory.
+
+	Functionally a simulated access completes in unit time, but the
+	memory system issues a warp's request as one transaction per distinct
+	segment the addresses span, and moves one sector per distinct sector
+	touched.  A fully coalesced warp costs one transaction while a
+	scattered one costs up to a transaction per lane.  CoreSimBlock
+	gathers the addresses one warp touches in a step and charges the
+	transaction and sector counts through the statistics counters.  The
+	segment and sector sizes are static knobs. */
+class CoalescingModel
+{
+public:
+	static const unsigned int LogSegmentSize = util::StaticKnob<
+		util::knobs::LogMemorySegmentSize>::value;
+	static const unsigned int LogSectorSize = util::StaticKnob<
+		util::knobs::LogMemorySectorSize>::value;
+
+public:
+	/*! \brief The number of distinct segments a warp's accesses span */
+	static __device__ unsigned int transactions(
+		const unsigned int* addresses, unsigned int count);
+
+	/*! \brief The number of distinct sectors a warp's accesses touch */
+	static __device__ unsigned int sectors(
+		const unsigned int* addresses, unsigned int count);
+};
+
+}
+
+}
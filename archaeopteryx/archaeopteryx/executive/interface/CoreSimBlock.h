@@ -10,13 +10,29 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/ir/interface/Binary.h>
 #include <archaeopteryx/executive/interface/CoreSimThread.h>
+#include <archaeopteryx/executive/interface/FetchUnit.h>
+#include <archaeopteryx/executive/interface/TraceScheduler.h>
+#include <archaeopteryx/executive/interface/EventQueue.h>
+#include <archaeopteryx/executive/interface/SimulationStatistics.h>
+#include <archaeopteryx/util/interface/SlabAllocator.h>
+#include <archaeopteryx/util/interface/StaticKnob.h>
 
 // Forward declarations
 namespace archaeopteryx { namespace executive { class CoreSimKernel; } }
+namespace archaeopteryx { namespace util      { class File;          } }
 
-// Preprocessor Macros
-#define WARP_SIZE	 32
-#define LOG_WARP_SIZE 5
+// Preprocessor Macros, the values are compile time knobs
+#ifdef WARP_SIZE
+#undef WARP_SIZE
+#endif
+#define WARP_SIZE \
+	(archaeopteryx::util::StaticKnob<archaeopteryx::util::knobs::WarpSize>::value)
+#define LOG_WARP_SIZE \
+	(archaeopteryx::util::StaticKnob<archaeopteryx::util::knobs::LogWarpSize>::value)
+
+// Shared memory dedicated to the decoded instruction cache, in bytes
+#define FETCH_CACHE_SIZE \
+	(archaeopteryx::util::StaticKnob<archaeopteryx::util::knobs::FetchCacheSize>::value)
 
 namespace archaeopteryx
 {
@@ -45,26 +61,74 @@ class CoreSimBlock
 		};
 		
 	private:
-		//FetchUnit m_fetchUnit;
+		FetchUnit m_fetchUnit;
 		typedef unsigned long long Register;
-		Register* m_registerFiles;
+		// a register is stored once per warp in a scalar slot while every
+		// thread holds the same value, the lane vector is only allocated
+		// on a divergent write and its pointer doubles as the uniformity
+		// tag (0 means uniform)
+		Register*  m_scalarRegisters;
+		Register** m_vectorRegisters;
 		BlockState m_blockState;
 		CoreSimThread* m_threads;
+		// one scheduler per simulated warp, grouping its threads by PC
+		TraceScheduler* m_schedulers;
 		typedef CoreSimThread* Warp;
 		Warp m_warp;
-		bool m_predicateMask[WARP_SIZE]; 
+		bool m_predicateMask[WARP_SIZE];
 		const CoreSimKernel* m_kernel;
+		// the block's event counters, they live in shared memory while
+		// runBlock executes and merge into the kernel aggregate at the end
+		SimulationStatistics* m_statistics;
+		// per-warp memory addresses gathered during a step, the bank
+		// conflict and coalescing models walk them.  Two slots per lane
+		// cover a fused pair of memory operations.
+		unsigned int* m_accessedAddresses;
+		unsigned int* m_accessCounts;
+		unsigned int* m_globalAddresses;
+		unsigned int* m_globalCounts;
+		// one arrival flag per simulated warp plus a count of arrived
+		// warps, so reaching a barrier costs one atomic per warp and
+		// releasing it never rescans every thread
+		unsigned int* m_barrierArrived;
+		unsigned int  m_arrivedWarps;
+		// the simulated clock and timed wakeup queue, warps sleeping on
+		// it are skipped by the scheduling loop until their event is due
+		EventQueue m_eventQueue;
+		// the block's simulated state is bump allocated out of this slab,
+		// falling back to device malloc when it is detached or full
+		util::SlabAllocator m_slab;
 
 	private:
 		__device__ void clearAllBarrierBits();
+		// mark the current warp arrived once every thread in it is at
+		// the barrier or finished, a single atomic on the edge
+		__device__ void updateBarrierArrival();
 		__device__ bool areAllThreadsFinished();
 		__device__ void roundRobinScheduler();
 		__device__ unsigned int findNextPC(unsigned int&);
 		__device__ bool setPredicateMaskForWarp(PC pc);
-		__device__ InstructionContainer fetchInstruction(PC pc);
-		__device__ void executeWarp(InstructionContainer* instruction, PC pc);
+		// fetch the instruction at pc and, when it heads a fused macro-op
+		// pair, its successor.  Returns the number fetched (1 or 2).
+		__device__ unsigned int fetchInstruction(PC pc,
+			InstructionContainer* instructions);
+		__device__ void executeWarp(InstructionContainer* instructions,
+			unsigned int count, PC pc);
 		__device__ unsigned int getThreadIdInWarp();
+		__device__ TraceScheduler* warpScheduler();
+		// index of a register's (warp, register) slot in the scalar and
+		// vector register files
+		__device__ unsigned int registerSlot(unsigned int threadId,
+			unsigned int reg);
 		__device__ void initializeSpecialRegisters();
+		// raw storage for simulated state, a pointer bump in the slab or
+		// a device malloc when the slab cannot serve the request
+		__device__ void* allocateState(size_t bytes);
+		__device__ void freeState(void* address);
+
+	public:
+		// Starts out with no simulated state resident
+		__device__ CoreSimBlock();
 
 	public:
 		// Initializes the state of the block
@@ -82,19 +146,38 @@ class CoreSimBlock
 		__device__ void runBlock();
 	
 	public:
-		// Interfaces to CoreSimThread
+		// Interfaces to CoreSimThread.  Reading a uniform register is a
+		// single broadcast load, a divergent one is a coalesced load from
+		// the per-warp lane vector.  Writes vote on uniformity, they must
+		// be made in lockstep by the lanes of one hardware warp.
 		__device__ CoreSimThread::Value getRegister(unsigned int, unsigned int);
 		__device__ void setRegister(unsigned int, unsigned int, const CoreSimThread::Value&);
 		__device__ CoreSimThread::Value translateVirtualToPhysical(const CoreSimThread::Value);
+		// Note a memory access for the timing models.  Addresses inside
+		// the block's shared memory window feed the bank conflict model,
+		// the rest feed the coalescing model.
+		__device__ void recordMemoryAccess(CoreSimThread::Value address);
 		__device__ void barrier(unsigned int);
 		__device__ unsigned int returned(unsigned int, unsigned int);
 		__device__ unsigned int getLinkRegister() const;
 		__device__ unsigned int getSimulatedBlockCount() const;
+		// The block's simulated clock and wakeup queue, the timing models
+		// post sleeps through it when an access misses or a barrier has a
+		// modeled release latency
+		__device__ EventQueue* eventQueue();
 
 	public:
 		//Interface to Runtime
 		__device__ void setNumberOfThreadsPerBlock(unsigned int);
 		__device__ void setMemoryState(unsigned int, unsigned int);
+		// Attach a pre-provisioned slab that serves the block's
+		// allocations, the caller retains ownership of the buffer
+		__device__ void setSlabArena(void* buffer, size_t bytes);
+		// Serialize the block state, thread contexts, and register file
+		// to a checkpoint file.  The binary pointer is not saved, it is
+		// rebound with setupBinary on resume.
+		__device__ void saveState(util::File& file);
+		__device__ void loadState(util::File& file);
 
 	public:
 		//Interface to CoreSimKernel
@@ -7,6 +7,12 @@
 
 #pragma once
 
+// Archaeopteryx Includes
+#include <archaeopteryx/executive/interface/SimulationStatistics.h>
+#include <archaeopteryx/executive/interface/InstructionProfile.h>
+#include <archaeopteryx/executive/interface/CacheModel.h>
+#include <archaeopteryx/executive/interface/MemoryTrace.h>
+
 // Vanaheimr Includes
 #include <vanaheimr/util/interface/IntTypes.h>
 
@@ -33,10 +39,61 @@ public:
 	// Interface to CoreSimBlock
 	__device__ Address translateVirtualToPhysicalAddress(
 		Address virtualAddress) const;
+	// Merge a finished block's counters into the kernel wide aggregate
+	__device__ void addStatistics(
+		const SimulationStatistics& blockStatistics) const;
+	// Merge one warp step into the per-PC profile, a no-op unless
+	// profiling was enabled for this launch
+	__device__ void countProfile(uint64_t pc, unsigned long long executions,
+		unsigned long long taken) const;
+	// Append one warp step to the address trace, a no-op unless the
+	// trace knob named an output file
+	__device__ void recordMemoryTrace(unsigned int blockId, uint64_t pc,
+		const unsigned int* addresses, unsigned int count) const;
+	// Walk a global access through the cache hierarchy, returns the
+	// level that hit (0 for L1, 1 for L2) or 2 for a miss to memory
+	__device__ unsigned int accessCache(Address address) const;
+	// Is the launch still inside its functional warm up window?
+	__device__ bool inFastForward() const;
+	// Retire instructions against the fast forward window
+	__device__ void countFastForward(unsigned long long instructions) const;
+	// Total simulated instructions retired so far in this launch
+	__device__ unsigned long long retiredInstructions() const;
+	// Has the launch crossed the next snapshot boundary?  Blocks stop
+	// pulling new work so the runtime can save state and relaunch
+	__device__ bool snapshotRequested() const;
 
 public:
 	unsigned int linkRegister;
 	unsigned int simulatedBlocks;
+	// Head of the queue of pending simulated CTAs, hardware blocks pull
+	// from it with an atomic increment.  Reset before every launch.
+	unsigned int nextSimulatedBlock;
+	// Event counters aggregated across all simulated blocks, cleared
+	// before every launch and reported when the simulation finishes
+	SimulationStatistics statistics;
+	// Per-PC counters feeding profile guided optimization, the table is
+	// only attached when the profile knob names an output file
+	InstructionProfile profile;
+	// The simulated cache hierarchy, only attached when the cache size
+	// knobs are nonzero
+	CacheModel l1Cache;
+	CacheModel l2Cache;
+	// The global address trace, only attached when the trace knob
+	// names an output file
+	MemoryTrace memoryTrace;
+	// Detailed accounting is skipped until this many simulated
+	// instructions have retired, zero runs detailed from the start
+	unsigned long long fastForwardInstructions;
+	// Instructions retired while fast forwarding, reset every launch
+	unsigned long long fastForwardedInstructions;
+	// Snapshot period in simulated instructions, zero disables
+	// periodic snapshots
+	unsigned long long snapshotInstructions;
+	// The retirement count the next snapshot stops at
+	unsigned long long snapshotBoundary;
+	// Print every warp step, set while replaying a snapshot window
+	bool replayTracing;
 
 };
 
@@ -35,10 +35,30 @@ class CoreSimThread
         
         typedef long long unsigned int Address;
     
+    public:
+        // The handler executing one opcode for one thread
+        typedef PC (*ExecuteFunction)(Instruction*, PC,
+        	CoreSimBlock*, unsigned);
+
 	public:
         __device__ CoreSimThread(CoreSimBlock* parentBlock = 0,
         	unsigned threadId = 0, unsigned priority = 1, bool barrier = false);
         __device__ PC executeInstruction(Instruction*, PC);
+        // Execute through a handler that was already decoded, the lanes of
+        // a warp all run the same instruction so one lane decodes for all
+        __device__ PC executeInstruction(Instruction*, PC, ExecuteFunction);
+        // Execute a fused macro-op pair in a single simulated cycle, the
+        // second instruction only runs when the first falls through
+        __device__ PC executeFusedInstructions(Instruction* first,
+        	Instruction* second, PC);
+
+    public:
+        // Look up the handler for an instruction in the dispatch table
+        static __device__ ExecuteFunction decode(const Instruction*);
+        // Do two adjacent instructions form a known macro-op pattern
+        // (compare+branch, multiply+add, address-compute+load)?
+        static __device__ bool canFuse(const Instruction* first,
+        	const Instruction* second);
 
 	public:
 		__device__ void setParentBlock(CoreSimBlock* parentBlock);
@@ -0,0 +1,119 @@
+/*! \file   EventQueue.h
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the EventQueue class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/IntTypes.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief A simulated clock and timed wakeup queue for one block.
+
+	The skeleton of event driven timing.  A warp that would stall on a
+	timed event (a memory completion, a delayed barrier release) goes to
+	sleep here instead of being rescheduled every iteration, and when
+	every warp in the block is asleep the clock jumps straight to the
+	earliest pending event, so idle warps cost nothing.  Events live in
+	a binary min heap keyed by wakeup cycle, one pending event per warp
+	bounds its size.
+
+	The clock counts issued warp steps while any warp is runnable, which
+	keeps the functional path exact today, the detailed cache and
+	coalescing timing models plug in by posting sleeps with real
+	latencies.  Posts and wakeups take a spin lock, they come from the
+	lane zero threads of concurrent hardware warps. */
+class EventQueue
+{
+public:
+	typedef uint64_t Cycle;
+
+public:
+	/*! \brief A pending wakeup for one sleeping warp */
+	class Event
+	{
+	public:
+		/*! \brief What the warp is waiting for */
+		enum Type
+		{
+			MemoryCompletion,
+			BarrierRelease
+		};
+
+	public:
+		/*! \brief The cycle the warp becomes runnable again */
+		Cycle cycle;
+		/*! \brief The sleeping warp */
+		unsigned int warp;
+		/*! \brief What the warp is waiting for */
+		Type type;
+	};
+
+public:
+	/*! \brief Starts out with no storage attached and the clock at zero */
+	__device__ EventQueue();
+
+	/*! \brief Allocate the heap and sleep flags for a warp count */
+	__device__ void setup(unsigned int warps);
+
+	/*! \brief Free the storage and detach */
+	__device__ void clear();
+
+public:
+	/*! \brief The current simulated cycle */
+	__device__ Cycle now() const;
+
+	/*! \brief Advance the clock over one issued warp step */
+	__device__ void tick();
+
+public:
+	/*! \brief Put a warp to sleep until delay cycles from now */
+	__device__ void sleep(unsigned int warp, Cycle delay, Event::Type type);
+
+	/*! \brief Is the warp waiting on a pending event? */
+	__device__ bool asleep(unsigned int warp) const;
+
+	/*! \brief The number of warps waiting on pending events */
+	__device__ unsigned int sleepingWarps() const;
+
+	/*! \brief Jump the clock to the earliest pending event and wake every
+		warp due at that cycle, returns the number woken (zero when no
+		events are pending) */
+	__device__ unsigned int wake();
+
+private:
+	/*! \brief Add an event at its heap position, the lock is held */
+	__device__ void _push(const Event& event);
+
+	/*! \brief Remove the earliest event, the lock is held */
+	__device__ Event _pop();
+
+	__device__ void _lock();
+	__device__ void _unlock();
+
+private:
+	/*! \brief The pending events, a min heap on the wakeup cycle */
+	Event* m_events;
+	/*! \brief One flag per warp, set while it has a pending event */
+	bool* m_asleep;
+
+	unsigned int m_size;
+	unsigned int m_capacity;
+	unsigned int m_sleeping;
+
+	Cycle m_cycle;
+
+	/*! \brief Guards the heap and flags, 0xffffffff when free */
+	unsigned int m_mutex;
+};
+
+}
+
+}
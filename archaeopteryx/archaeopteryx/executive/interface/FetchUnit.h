@@ -8,34 +8,140 @@
 #pragma once
 
 // Archaeopteryx Includes
-#include <archaeoteryx/executive/interface/Binary.h>
+#include <archaeopteryx/ir/interface/Binary.h>
+
+// Preprocessor Macros
+
+// Set to 0 to disable macro-op fusion of adjacent dependent instructions
+#define MACRO_OP_FUSION 1
+
+namespace archaeopteryx
+{
 
 namespace executive
 {
 
-/*! \brief The simulator's interface to a binary file */
+/*! \brief A set associative cache of decoded instructions sitting in front
+	of the binary's code pages.
+
+	The backing storage is supplied by the caller with setCache, normally
+	a shared memory buffer, so instructions in hot loop bodies are served
+	from shared memory instead of paying a global memory page access on
+	every simulated cycle.  Lines hold several contiguous instructions to
+	exploit the spatial locality of straight line code. */
 class FetchUnit
 {
 public:
+	typedef ir::Binary::PC                   PC;
+	typedef ir::Binary::InstructionContainer InstructionContainer;
+
+public:
+	/*! \brief Instructions per cache line */
+	static const unsigned int LineSize      = 4;
+	/*! \brief Lines per set */
+	static const unsigned int Associativity = 4;
+
+	/*! \brief The tag of an empty line */
+	static const PC InvalidPC = (PC)-1;
+
+public:
+	/*! \brief Create a fetch unit with no binary, setupBinary follows */
+	__device__ FetchUnit();
 	/*! \brief Create a new fetch unit */
 	__device__ FetchUnit(ir::Binary* binary);
 
 public:
-	/*! \brief Set the size of the cache and the memory that should be used */
-	__device__ void setCache(const void* cache, unsigned int size);
-	
+	/*! \brief Set the memory backing the cache, the line tags and data
+		lines are both carved out of the buffer */
+	__device__ void setCache(void* cache, unsigned int size);
+
+	/*! \brief Was cache storage attached yet? */
+	__device__ bool hasCache() const;
+
+public:
+	/*! \brief The parameters of a pending line fill, produced by probe
+		and consumed by fillLine and finishFetch */
+	class Fill
+	{
+	public:
+		/*! \brief Does the line still need to be copied in? */
+		bool needed;
+		/*! \brief The aligned PC of the first instruction in the line */
+		PC lineBase;
+		/*! \brief The cache line being accessed or filled */
+		unsigned int line;
+		/*! \brief The number of valid instructions in the line */
+		unsigned int instructions;
+	};
+
 public:
 	/*! \brief Given a PC, return the instruction container */
-	__device__ const ir::InstructionContainer*
-		getInstruction(ir::Binary::PC pc);
+	__device__ const InstructionContainer* getInstruction(PC pc);
+
+	/*! \brief Given a PC, return the instruction container.  On return
+		fusedWithNext is true when the instruction forms a macro-op with
+		its successor, which is then valid at the next array position. */
+	__device__ const InstructionContainer* getInstruction(PC pc,
+		bool& fusedWithNext);
+
+public:
+	/*! \brief The split phase fetch interface.  One thread probes the
+		tags, then the whole warp calls fillLine so a missed line is
+		copied in cooperatively, and finally the probing thread calls
+		finishFetch to publish the tag and read the instruction. */
+	__device__ void probe(PC pc, Fill& fill);
+
+	/*! \brief Copy a missed line in from the binary, a no-op when the
+		probe hit.  Convergent callers split the copy across the warp. */
+	__device__ void fillLine(const Fill& fill);
+
+	/*! \brief Detect macro-ops in a filled line, publish its tag, and
+		return the instruction the probe asked for */
+	__device__ const InstructionContainer* finishFetch(PC pc,
+		const Fill& fill, bool& fusedWithNext);
+
+public:
+	/*! \brief The number of fetches served from the cache */
+	__device__ unsigned long long hits() const;
+	/*! \brief The number of fetches that filled a line from the binary */
+	__device__ unsigned long long misses() const;
+	/*! \brief The number of fetches that returned a fused pair */
+	__device__ unsigned long long fused() const;
 
 private:
-	/*! \brief The cache array */
-	const ir::InstructionContainer* _cache;
-	/*! \brief The cache size in instruction container units */
-	unsigned int _cacheSize;
-	/*! \brief The PC stored in the cache */
-	ir::Binary::PC _tag;
+	/*! \brief The PC range held by one cache line */
+	class LineTag
+	{
+	public:
+		/*! \brief The aligned PC of the first instruction in the line */
+		PC basePC;
+		/*! \brief The number of valid instructions in the line */
+		unsigned int instructions;
+		/*! \brief Bit i is set when instruction i fuses with i+1, the
+			patterns are detected once when the line is filled */
+		unsigned int fusionMask;
+	};
+
+private:
+	/*! \brief Get a pointer to the data of the specified line */
+	__device__ InstructionContainer* _line(unsigned int line);
+
+private:
+	/*! \brief The line tags, carved from the caller's buffer */
+	LineTag* _tags;
+	/*! \brief The data lines, placed after the tags */
+	InstructionContainer* _lines;
+	/*! \brief The number of sets in the cache */
+	unsigned int _sets;
+	/*! \brief Round robin victim counter for line replacement */
+	unsigned int _victim;
+
+	/*! \brief The number of fetches served from the cache */
+	unsigned long long _hits;
+	/*! \brief The number of fetches that filled a line */
+	unsigned long long _misses;
+	/*! \brief The number of fetches that returned a fused pair */
+	unsigned long long _fused;
 
 	/*! \brief A pointer to the binary being fetched from */
 	ir::Binary* _binary;
@@ -43,3 +149,4 @@ private:
 
 }
 
+}
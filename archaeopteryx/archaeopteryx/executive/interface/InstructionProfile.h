@@ -0,0 +1,94 @@
+/*! \file   InstructionProfile.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the InstructionProfile class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/IntTypes.h>
+
+// Forward Declarations
+namespace archaeopteryx { namespace ir { class Binary; } }
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief A table of per-PC event counters for one simulated binary.
+
+	Warps accumulate into it atomically while they execute, so collection
+	costs a global atomic per scheduling step and is only enabled when the
+	simulator-instruction-profile knob names an output file.  The dump is
+	keyed by VIR function symbol, the compiler reads it back and attaches
+	the counts to the matching IR as metadata. */
+class InstructionProfile
+{
+public:
+	typedef uint64_t PC;
+
+	/*! \brief The events recorded for a single PC */
+	class Counter
+	{
+	public:
+		/*! \brief The times any thread executed the instruction */
+		unsigned long long executions;
+		/*! \brief The times a thread left the fallthrough path */
+		unsigned long long taken;
+	};
+
+	/*! \brief The file header of a dumped profile, the compiler side
+		reader mirrors the layout */
+	class FileHeader
+	{
+	public:
+		char     magic[8]; // "VIRPROF0"
+		uint64_t symbols;
+	};
+
+	/*! \brief One function symbol record, followed in the file by one
+		Counter per instruction */
+	class SymbolRecord
+	{
+	public:
+		char     name[64];
+		uint64_t instructions;
+	};
+
+public:
+	/*! \brief Start with no table, counting disabled */
+	__device__ InstructionProfile();
+
+public:
+	/*! \brief Allocate one counter per instruction in the binary */
+	__device__ void setup(ir::Binary* binary);
+
+	/*! \brief Free the table and disable counting */
+	__device__ void clear();
+
+	/*! \brief Is a table attached? */
+	__device__ bool enabled() const;
+
+public:
+	/*! \brief Merge one warp step at pc into the table */
+	__device__ void count(PC pc, unsigned long long executions,
+		unsigned long long taken);
+
+public:
+	/*! \brief Dump the table to a file, one record per function symbol */
+	__device__ void writeToFile(const char* fileName,
+		ir::Binary* binary) const;
+
+public:
+	Counter* counters;
+	uint64_t size;
+
+};
+
+}
+
+}
+
@@ -0,0 +1,78 @@
+/*! \file   MemoryTrace.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the MemoryTrace class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/IntTypes.h>
+
+// Standard Library Includes
+#include <cstring>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief An address trace of the simulated global memory accesses.
+
+	One record per warp step that touched memory, encoded into a device
+	buffer: the block id, pc, and access count are variable length
+	integers, then the first address followed by zigzag deltas between
+	consecutive accesses.  A coalesced warp collapses to about one byte
+	per access, which is what makes tracing feasible at simulation
+	rates.  The runtime drains the buffer to a file through the host
+	reflection channel whenever the launch is stopped; records that do
+	not fit before a drain are dropped and counted. */
+class MemoryTrace
+{
+public:
+	/*! \brief Starts out disabled with no buffer attached */
+	__device__ MemoryTrace();
+
+	/*! \brief Allocate an empty trace buffer of the requested size */
+	__device__ void setup(size_t bytes);
+
+	/*! \brief Free the buffer and disable tracing */
+	__device__ void clear();
+
+	/*! \brief Is a buffer attached? */
+	__device__ bool enabled() const;
+
+	/*! \brief Append one warp step's accesses, drops the record when
+		the buffer is full */
+	__device__ void record(unsigned int blockId, uint64_t pc,
+		const unsigned int* addresses, unsigned int count);
+
+public:
+	/*! \brief The encoded bytes waiting to be drained */
+	__device__ const char* data() const;
+	__device__ size_t      bytes() const;
+
+	/*! \brief Records dropped because the buffer filled */
+	__device__ unsigned long long dropped() const;
+
+	/*! \brief Empty the buffer after a drain */
+	__device__ void reset();
+
+private:
+	char* m_buffer;
+	/*! \brief The buffer capacity in bytes */
+	unsigned long long m_size;
+	/*! \brief The reservation cursor, warps move it atomically and it
+		runs past the capacity once records start dropping */
+	unsigned long long m_offset;
+	/*! \brief The start of the first dropped record, everything below
+		it is valid encoded data */
+	unsigned long long m_full;
+
+	unsigned long long m_dropped;
+};
+
+}
+
+}
@@ -20,14 +20,12 @@ namespace archaeopteryx
 namespace executive
 {
 
-// Operand Access
+// Operand Access, the containers must be in the pre-decoded form code
+// pages are rewritten into when they load, see DecodedOperand.h
 __device__ uint64_t getOperand(
 	const vanaheimr::as::OperandContainer& operandContainer,
 	CoreSimBlock* parentBlock, unsigned threadId);
 
-__device__ uint64_t getOperand(const vanaheimr::as::Operand& operand,
-	CoreSimBlock* parentBlock, unsigned threadId);
-
 __device__ unsigned int getReturnRegister(const vanaheimr::as::Call* call,
 	CoreSimBlock* parentBlock);
 	
@@ -0,0 +1,50 @@
+/*! \file   SharedMemoryModel.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SharedMemoryModel class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/StaticKnob.h>
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief The timing model for simulated shared memory.
+
+	Simulated shared memory is stored flat, so correctness never sees the
+	banks, but timing does: a warp's accesses to different words in the
+	same bank serialize into multiple passes, while accesses to the same
+	word broadcast.  CoreSimBlock gathers the addresses one warp touches
+	in a step and charges the serialized pass count through the statistics
+	counters.  The bank count and width are static knobs. */
+class SharedMemoryModel
+{
+public:
+	static const unsigned int Banks = util::StaticKnob<
+		util::knobs::SharedMemoryBanks>::value;
+	static const unsigned int LogBankWidth = util::StaticKnob<
+		util::knobs::LogSharedMemoryBankWidth>::value;
+
+public:
+	/*! \brief The bank an address falls in, consecutive words rotate
+		through the banks */
+	static __device__ unsigned int bank(unsigned int address);
+
+	/*! \brief The number of passes a warp's accesses serialize into.
+
+		One pass per distinct word in the deepest bank, so a conflict free
+		or broadcast access pattern costs a single pass.  Zero accesses
+		cost zero passes. */
+	static __device__ unsigned int serializedPasses(
+		const unsigned int* addresses, unsigned int count);
+};
+
+}
+
+}
@@ -0,0 +1,69 @@
+/*! \file   SimulationStatistics.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SimulationStatistics class.
+*/
+
+#pragma once
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief A block of event counters describing a simulation.
+
+	Each simulated block accumulates into a copy in shared memory, lane
+	zero of a warp updates it atomically, and the block merges its copy
+	into the kernel wide aggregate when it finishes.  The aggregate is
+	reported through the host reflection channel, so counting stays cheap
+	enough to leave on permanently. */
+class SimulationStatistics
+{
+public:
+	/*! \brief Dynamic instructions executed, fused pairs count as two */
+	unsigned long long instructions;
+	/*! \brief Scheduling steps that executed at least one thread */
+	unsigned long long scheduledSteps;
+	/*! \brief Executed loads, stores, and atomic operations */
+	unsigned long long memoryTransactions;
+	/*! \brief Steps where only part of the warp executed */
+	unsigned long long divergentSteps;
+	/*! \brief Steps skipped with every thread waiting at a barrier */
+	unsigned long long barrierWaits;
+	/*! \brief Thread level accesses that landed in shared memory */
+	unsigned long long sharedMemoryAccesses;
+	/*! \brief Extra serialized passes caused by bank conflicts */
+	unsigned long long bankConflicts;
+	/*! \brief Cycles charged to shared memory, one per serialized pass */
+	unsigned long long sharedMemoryCycles;
+	/*! \brief Thread level accesses that landed in global memory */
+	unsigned long long globalMemoryAccesses;
+	/*! \brief Segment sized transactions issued for global accesses */
+	unsigned long long globalTransactions;
+	/*! \brief Cycles charged to global memory, one per sector moved */
+	unsigned long long globalMemoryCycles;
+	/*! \brief Global accesses that hit in the simulated L1 */
+	unsigned long long l1CacheHits;
+	/*! \brief Global accesses that missed the simulated L1 */
+	unsigned long long l1CacheMisses;
+	/*! \brief L1 misses that hit in the simulated L2 */
+	unsigned long long l2CacheHits;
+	/*! \brief L1 misses that went all the way to memory */
+	unsigned long long l2CacheMisses;
+
+public:
+	/*! \brief Zero all of the counters */
+	__device__ void clear();
+
+	/*! \brief Atomically merge another counter block into this one */
+	__device__ void add(const SimulationStatistics& statistics);
+
+	/*! \brief Send the counters to the host for reporting */
+	__device__ void report(const char* name) const;
+};
+
+}
+
+}
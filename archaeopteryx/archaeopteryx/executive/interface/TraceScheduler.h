@@ -0,0 +1,122 @@
+/*! \file   TraceScheduler.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the TraceScheduler class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/ir/interface/Binary.h>
+#include <archaeopteryx/util/interface/StaticKnob.h>
+
+// Preprocessor Macros, the value is a compile time knob
+#ifndef WARP_SIZE
+#define WARP_SIZE \
+	(archaeopteryx::util::StaticKnob<archaeopteryx::util::knobs::WarpSize>::value)
+#endif
+
+// Forward Declarations
+namespace archaeopteryx { namespace executive { class CoreSimThread; } }
+
+namespace archaeopteryx
+{
+
+namespace executive
+{
+
+/*! \brief Groups the threads of one simulated warp by their next PC.
+
+	The groups are kept sorted by scheduling priority and are maintained
+	incrementally as threads branch, so picking the next PC to issue and
+	updating the schedule after a step are both proportional to the number
+	of distinct PCs and changed threads rather than to the warp size.  The
+	table is rebuilt from the raw thread state only when it is invalidated,
+	which happens when barrier bits are cleared in bulk.
+
+	A stack of pending reconvergence points models SIMT divergence.  When
+	a branch splits the warp the PC of its immediate post-dominator is
+	pushed, groups that reach a pushed PC park there, and the most
+	recently pushed point releases once every group is parked, so nested
+	divergence reconverges inside out at the earliest point the program
+	structure allows. */
+class TraceScheduler
+{
+public:
+	typedef ir::Binary::PC PC;
+
+public:
+	/*! \brief A group of threads all waiting at the same PC */
+	class Group
+	{
+	public:
+		/*! \brief The common PC of the member threads */
+		PC pc;
+		/*! \brief The number of threads waiting at the PC */
+		unsigned int members;
+		/*! \brief The scheduling priority of the group */
+		unsigned int priority;
+	};
+
+public:
+	/*! \brief Create a scheduler with no groups, a rebuild follows */
+	__device__ TraceScheduler();
+
+public:
+	/*! \brief Discard the groups, the next query rebuilds them */
+	__device__ void invalidate();
+
+	/*! \brief Do the groups reflect the thread state? */
+	__device__ bool valid() const;
+
+	/*! \brief Regroup the threads of a warp from scratch, threads waiting
+		at a barrier are left out until the next rebuild */
+	__device__ void rebuild(const CoreSimThread* warp);
+
+public:
+	/*! \brief Get the PC of the highest priority group that has not
+		reached a pending reconvergence point, releasing the innermost
+		point when every group is parked.  The priority is zero when
+		every thread is waiting at a barrier */
+	__device__ PC nextPC(unsigned int& priority);
+
+	/*! \brief Move one thread from its old group to the group of its new
+		PC, threads that just arrived at a barrier leave the schedule */
+	__device__ void threadMoved(PC oldPC, PC newPC, unsigned int priority,
+		bool barrier);
+
+	/*! \brief Record the reconvergence point of a branch that just split
+		the warp, groups that reach it wait there for the rest */
+	__device__ void pushReconvergencePoint(PC pc);
+
+private:
+	/*! \brief Find the group at the specified PC, 0 if there is none */
+	__device__ Group* _findGroup(PC pc);
+
+	/*! \brief Take one thread out of the group at the specified PC */
+	__device__ void _removeMember(PC pc);
+
+	/*! \brief Add one thread to the group at the specified PC, creating
+		the group at its sorted position if it does not exist yet */
+	__device__ void _addMember(PC pc, unsigned int priority);
+
+	/*! \brief Is the PC a pending reconvergence point? */
+	__device__ bool _isReconvergencePoint(PC pc) const;
+
+private:
+	/*! \brief Do the groups match the thread state? */
+	bool _valid;
+	/*! \brief The number of live groups */
+	unsigned int _count;
+	/*! \brief The groups, sorted by descending priority.  A warp can
+		never diverge to more PCs than it has threads. */
+	Group _groups[WARP_SIZE];
+	/*! \brief The pending reconvergence points, innermost last */
+	PC _reconvergeStack[WARP_SIZE];
+	/*! \brief The number of pending reconvergence points */
+	unsigned int _stackDepth;
+};
+
+}
+
+}
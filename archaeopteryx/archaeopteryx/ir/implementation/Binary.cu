@@ -6,6 +6,7 @@
 
 // Archaeopteryx Includes
 #include <archaeopteryx/ir/interface/Binary.h>
+#include <archaeopteryx/ir/interface/DecodedOperand.h>
 
 #include <archaeopteryx/util/interface/File.h>
 
@@ -48,6 +49,8 @@ __device__ Binary::~Binary()
 {
 	device_report("Destroying binary.\n");
 
+	_finishPrefetch();
+
 	device_report(" deleting copied pages from the binary file...\n");
 
 	for(unsigned int c = 0; c != _header.codePages; ++c)
@@ -68,6 +71,9 @@ __device__ Binary::~Binary()
 	device_report(" deleting symbol tables...\n");
 
 	delete[] _symbolTable;
+	delete[] _hashIndex;
+	delete[] _pageTable;
+	delete[] _reconvergenceTable;
 	delete[] _codeSection;
 	delete[] _dataSection;
 	delete[] _stringSection;
@@ -80,17 +86,41 @@ __device__ Binary::~Binary()
 __device__ Binary::SymbolTableEntry* Binary::findSymbol(const char* name)
 {
 	_loadSymbolTable();
-	
+	_loadHashIndex();
+
+	if(_hashIndex != 0)
+	{
+		// probe the open addressed index, an empty slot ends the search
+		unsigned int hash = vanaheimr::as::hashSymbolName(name);
+
+		for(uint64_t slot = hash & (_header.hashSlots - 1); ;
+			slot = (slot + 1) & (_header.hashSlots - 1))
+		{
+			SymbolHashEntry* entry = _hashIndex + slot;
+
+			if(entry->symbol == SymbolHashEntry::InvalidSymbol) return 0;
+			if(entry->hash != hash) continue;
+
+			SymbolTableEntry* symbol = _symbolTable + entry->symbol;
+
+			if(_strcmp(_header.stringsOffset + symbol->stringOffset, name) == 0)
+			{
+				return symbol;
+			}
+		}
+	}
+
+	// binaries without a hash index fall back to a linear scan
 	for(unsigned int i = 0; i < _header.symbols; ++i)
 	{
 		SymbolTableEntry* symbol = _symbolTable + i;
-		
+
 		if(_strcmp(_header.stringsOffset + symbol->stringOffset, name) == 0)
 		{
 			return symbol;
 		}
 	}
-	
+
 	return 0;
 }
 
@@ -119,7 +149,9 @@ __device__ void Binary::copyCode(InstructionContainer* code, PC pc,
 		InstructionContainer* container =
 			reinterpret_cast<InstructionContainer*>(pageData);
 	
-		util::memcpy(code, container + pageOffset,
+		// a convergent warp splits the copy across its lanes, a single
+		// threaded caller takes the serial path automatically
+		util::memcpyWarp(code, container + pageOffset,
 			sizeof(InstructionContainer) * instructionsInThisPage);
 	
 		instructions -= instructionsInThisPage;
@@ -240,6 +272,64 @@ __device__ void Binary::copySymbolDataToAddress(void* address,
 	_datacpy((char*)address, symbol->offset, symbol->size);
 }
 
+__device__ void Binary::loadReconvergencePointTable()
+{
+	if(_reconvergencePoints != (unsigned int)-1) return;
+
+	// binaries from toolchains that predate the table simply lack the
+	// symbol, every branch then falls back to priority scheduling
+	SymbolTableEntry* symbol = findSymbol("_Zreconvergence_point_table");
+
+	if(symbol == 0)
+	{
+		_reconvergencePoints = 0;
+
+		return;
+	}
+
+	unsigned int points = symbol->size / (2 * sizeof(uint64_t));
+
+	_reconvergenceTable = new uint64_t[2 * points];
+
+	_datacpy((char*)_reconvergenceTable, symbol->offset, symbol->size);
+
+	_reconvergencePoints = points;
+
+	device_report(" loaded %d reconvergence points\n", points);
+}
+
+__device__ Binary::PC Binary::findReconvergencePoint(PC branchPC)
+{
+	loadReconvergencePointTable();
+
+	// the pairs are sorted by branch PC
+	unsigned int begin = 0;
+	unsigned int end   = _reconvergencePoints;
+
+	while(begin < end)
+	{
+		unsigned int middle = begin + (end - begin) / 2;
+
+		uint64_t pc = _reconvergenceTable[2 * middle];
+
+		if(pc == branchPC)
+		{
+			return _reconvergenceTable[2 * middle + 1];
+		}
+
+		if(pc < branchPC)
+		{
+			begin = middle + 1;
+		}
+		else
+		{
+			end = middle;
+		}
+	}
+
+	return InvalidPC;
+}
+
 __device__ Binary::StringVector Binary::getSymbolNamesThatMatch(
 	const char* substring)
 {
@@ -281,6 +371,31 @@ __device__ Binary::PC Binary::findFunctionsPC(const char* name)
 	return instructionsPerPage * (page - code_begin()) + offset;
 }
 
+__device__ Binary::symbol_table_iterator Binary::symbol_table_begin()
+{
+	_loadSymbolTable();
+
+	return _symbolTable;
+}
+
+__device__ Binary::symbol_table_iterator Binary::symbol_table_end()
+{
+	_loadSymbolTable();
+
+	return _symbolTable + _header.symbols;
+}
+
+__device__ Binary::PC Binary::getFunctionPC(SymbolTableEntry* symbol)
+{
+	device_assert(symbol->type == SymbolTableEntry::FunctionType);
+
+	const size_t instructionsPerPage = sizeof(PageDataType) /
+		sizeof(InstructionContainer);
+
+	return instructionsPerPage * _getCodePageId(symbol->offset) +
+		_getCodePageOffset(symbol->offset);
+}
+
 __device__ Binary::page_iterator Binary::code_begin()
 {
 	return _codeSection;
@@ -313,47 +428,102 @@ __device__ Binary::page_iterator Binary::string_end()
 
 __device__ Binary::PageDataType* Binary::getCodePage(page_iterator page)
 {
+	_finishPrefetch();
+
 	while(*page == 0)
 	{
 		if(!_lock(page)) continue;
-	
-		size_t offset = _getCodePageOffset(page);
 
-		device_report("Loading code page (%p) at offset (%p) now...\n",
-			page, offset);
-	
-		_file->seekg(offset);
 		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
+
+		if(_header.flags & Header::CompressedSections)
+		{
+			_loadCompressedPage(*page,
+				_header.dataPages + (page - code_begin()));
+		}
+		else
+		{
+			size_t offset = _getCodePageOffset(page);
+
+			device_report("Loading code page (%p) at offset (%p) now...\n",
+				page, offset);
+
+			_file->seekg(offset);
+			_file->read(*page, sizeof(PageDataType));
+		}
+
+		// rewrite the operands into the pre-decoded form once, every
+		// execution out of this page then reads resolved fields instead
+		// of re-interpreting the bytecode unions
+		_decodeCodePage(*page);
 
 		_unlock(page);
-	
+
+		// code access is overwhelmingly sequential, overlap the fill of
+		// the next page with execution out of this one
+		if(page + 1 != code_end())
+		{
+			_startCodePagePrefetch(page + 1);
+		}
+
 		break;
 	}
-	
+
 	return *page;
 }
 
+__device__ void Binary::_decodeCodePage(PageDataType* page)
+{
+	const size_t instructionsPerPage = sizeof(PageDataType) /
+		sizeof(InstructionContainer);
+
+	InstructionContainer* instructions =
+		reinterpret_cast<InstructionContainer*>(page);
+
+	for(size_t i = 0; i < instructionsPerPage; ++i)
+	{
+		// the tail of the last page holds no real instructions, skip
+		// anything with a garbage opcode
+		if((unsigned int)instructions[i].asInstruction.opcode >=
+			(unsigned int)vanaheimr::as::Instruction::InvalidOpcode)
+		{
+			continue;
+		}
+
+		decodeInstructionOperands(instructions[i]);
+	}
+}
+
 __device__ Binary::PageDataType* Binary::getDataPage(page_iterator page)
 {
+	_finishPrefetch();
+
 	while(*page == 0)
 	{
 		if(!_lock(page)) continue;
-		
-		size_t offset = _getDataPageOffset(page);
-	
-		device_report("Loading data page (%p) at offset (%p) now...\n",
-			page, offset);
 
-		_file->seekg(offset);
 		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
-		
+
+		if(_header.flags & Header::CompressedSections)
+		{
+			_loadCompressedPage(*page, page - data_begin());
+		}
+		else
+		{
+			size_t offset = _getDataPageOffset(page);
+
+			device_report("Loading data page (%p) at offset (%p) now...\n",
+				page, offset);
+
+			_file->seekg(offset);
+			_file->read(*page, sizeof(PageDataType));
+		}
+
 		_unlock(page);
 
 		break;
 	}
-	
+
 	return *page;
 }
 
@@ -361,24 +531,35 @@ __device__ Binary::PageDataType* Binary::getStringPage(page_iterator page)
 {
 	device_assert(page < string_end());
 
+	_finishPrefetch();
+
 	while(*page == 0)
 	{
 		if(!_lock(page)) continue;
-		
-		size_t offset = _getStringPageOffset(page);
-
-		device_report("Loading string page (%p) at offset (%p) now...\n",
-			page, offset);
 
-		_file->seekg(offset);
 		*page = (PageDataType*)new PageDataType;
-		_file->read(*page, sizeof(PageDataType));
-		
+
+		if(_header.flags & Header::CompressedSections)
+		{
+			_loadCompressedPage(*page, _header.dataPages +
+				_header.codePages + (page - string_begin()));
+		}
+		else
+		{
+			size_t offset = _getStringPageOffset(page);
+
+			device_report("Loading string page (%p) at offset (%p) now...\n",
+				page, offset);
+
+			_file->seekg(offset);
+			_file->read(*page, sizeof(PageDataType));
+		}
+
 		_unlock(page);
-		
+
 		break;
 	}
-	
+
 	return *page;
 }
 
@@ -396,6 +577,15 @@ __device__ void Binary::_loadHeader()
 	_stringSection = new PagePointer[_header.stringPages];
 
 	_symbolTable = 0;
+	_hashIndex   = 0;
+	_pageTable   = 0;
+
+	_reconvergenceTable  = 0;
+	_reconvergencePoints = (unsigned int)-1;
+
+	_prefetchTarget = 0;
+	_prefetchData   = 0;
+	_prefetchBytes  = 0;
 
 	util::memset(_dataSection,   0, _header.dataPages   * sizeof(PagePointer));
 	util::memset(_codeSection,   0, _header.codePages   * sizeof(PagePointer));
@@ -415,14 +605,90 @@ __device__ void Binary::_loadHeader()
 	{
 		_locks.insert(util::make_pair(page, Lock()));
 	}
-	
+
+	// load it eagerly, the page getters only hold their own page's lock
+	if(_header.flags & Header::CompressedSections)
+	{
+		_loadPageTable();
+	}
+
 	device_report("Loaded binary (%d data pages, %d code pages, "
 		"%d symbols, %d string pages)\n", _header.dataPages, _header.codePages,
 		_header.symbols, _header.stringPages);
 }
 
+__device__ void Binary::_startCodePagePrefetch(page_iterator page)
+{
+	// compressed pages have per-entry sizes and offsets, only the raw
+	// layout streams sequentially
+	if(_header.flags & Header::CompressedSections) return;
+
+	if(*page != 0) return;
+
+	// a held lock means another prefetch is still in flight
+	if(!_prefetchLock.lock()) return;
+
+	device_report("Prefetching code page (%p) at offset (%p)...\n",
+		page, _getCodePageOffset(page));
+
+	_prefetchTarget = page;
+	_prefetchData   = (PageDataType*)new PageDataType;
+
+	_file->seekg(_getCodePageOffset(page));
+
+	_prefetchBytes = _file->startRead(sizeof(PageDataType));
+}
+
+__device__ void Binary::_finishPrefetch()
+{
+	if(_prefetchTarget == 0) return;
+
+	// the replies come back to the issuing thread, everyone else loads
+	// pages normally and the prefetch is discarded when it loses the race
+	if(!_prefetchLock.owned()) return;
+
+	page_iterator page = _prefetchTarget;
+
+	_file->finishRead(_prefetchData, _prefetchBytes);
+
+	// pre-decode the operands while the buffer is still private to the
+	// issuing thread, installed pages are always in the decoded form
+	_decodeCodePage(_prefetchData);
+
+	bool installed = false;
+
+	if(*page == 0)
+	{
+		if(_lock(page))
+		{
+			if(*page == 0)
+			{
+				*page     = _prefetchData;
+				installed = true;
+
+				device_report("Installed prefetched code page (%p)\n", page);
+			}
+
+			_unlock(page);
+		}
+	}
+
+	if(!installed)
+	{
+		delete[] _prefetchData;
+	}
+
+	_prefetchData   = 0;
+	_prefetchTarget = 0;
+	_prefetchBytes  = 0;
+
+	_prefetchLock.unlock();
+}
+
 __device__ void Binary::_loadSymbolTable()
 {
+	_finishPrefetch();
+
 	if(_header.symbols == 0) return;
 	if(_symbolTable != 0)    return;
 
@@ -442,6 +708,80 @@ __device__ void Binary::_loadSymbolTable()
 	device_report("   loaded %d symbols...\n", _header.symbols);
 }
 
+__device__ void Binary::_loadHashIndex()
+{
+	_finishPrefetch();
+
+	if(_header.hashSlots == 0) return;
+	if(_hashIndex != 0)        return;
+
+	device_report(" Loading symbol hash index now.\n");
+
+	_hashIndex = new SymbolHashEntry[_header.hashSlots];
+
+	device_report("  hash index offset %d.\n", (int)_header.hashOffset);
+	device_assert(_file != 0);
+
+	_file->seekg(_header.hashOffset);
+
+	_file->read(_hashIndex, _header.hashSlots * sizeof(SymbolHashEntry));
+
+	device_report("   loaded %d slots...\n", (int)_header.hashSlots);
+}
+
+__device__ void Binary::_loadPageTable()
+{
+	if((_header.flags & Header::CompressedSections) == 0) return;
+	if(_pageTable != 0)                                   return;
+
+	device_report(" Loading compressed page table now.\n");
+
+	size_t pages = _header.dataPages + _header.codePages +
+		_header.stringPages;
+
+	_pageTable = new CompressedPageEntry[pages];
+
+	device_report("  page table offset %d.\n", (int)_header.pageTableOffset);
+	device_assert(_file != 0);
+
+	_file->seekg(_header.pageTableOffset);
+
+	_file->read(_pageTable, pages * sizeof(CompressedPageEntry));
+
+	device_report("   loaded %d entries...\n", (int)pages);
+}
+
+__device__ void Binary::_loadCompressedPage(PageDataType* page,
+	size_t pageTableIndex)
+{
+	device_assert(_pageTable != 0);
+
+	CompressedPageEntry* entry = _pageTable + pageTableIndex;
+
+	device_report("Loading compressed page %d (%d bytes at offset %p) "
+		"now...\n", (int)pageTableIndex, (int)entry->size,
+		(void*)(size_t)entry->offset);
+
+	_file->seekg(entry->offset);
+
+	if(entry->size == sizeof(PageDataType))
+	{
+		// incompressible pages are stored raw
+		_file->read(page, sizeof(PageDataType));
+
+		return;
+	}
+
+	char* compressed = new char[entry->size];
+
+	_file->read(compressed, entry->size);
+
+	vanaheimr::as::decompressPage((const unsigned char*)compressed,
+		entry->size, page);
+
+	delete[] compressed;
+}
+
 __device__ size_t Binary::_getCodePageOffset(page_iterator page)
 {
 	return _header.codeOffset +	(page - code_begin()) * sizeof(PageDataType);
@@ -672,6 +1012,13 @@ __device__ bool Binary::Lock::unlock()
 	return original == gid;
 }
 
+__device__ bool Binary::Lock::owned() const
+{
+	unsigned int gid = threadIdx.x + blockIdx.x * blockDim.x;
+
+	return _lock == gid;
+}
+
 }
 
 }
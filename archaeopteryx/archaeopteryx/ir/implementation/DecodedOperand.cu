@@ -0,0 +1,159 @@
+/*! \file   DecodedOperand.cu
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the DecodedOperand class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/ir/interface/DecodedOperand.h>
+
+namespace archaeopteryx
+{
+
+namespace ir
+{
+
+typedef vanaheimr::as::Instruction      Instruction;
+typedef vanaheimr::as::Operand          Operand;
+typedef vanaheimr::as::PredicateOperand PredicateOperand;
+typedef vanaheimr::as::RegisterType     RegisterType;
+typedef vanaheimr::as::DataType         DataType;
+
+typedef vanaheimr::as::OperandContainer     OperandContainer;
+typedef vanaheimr::as::InstructionContainer InstructionContainer;
+
+__device__ void decodeOperand(OperandContainer& operand)
+{
+	DecodedOperand& decoded = asDecoded(operand);
+
+	if(decoded.decoded()) return;
+
+	Operand::OperandMode mode = operand.asOperand.mode;
+
+	uint32_t     flags    = DecodedOperand::Marker | mode;
+	RegisterType reg      = 0;
+	uint64_t     addend   = 0;
+	DataType     type     = vanaheimr::as::InvalidDataType;
+	uint32_t     modifier = PredicateOperand::StraightPredicate;
+
+	// read the bytecode fields into locals before any of the stores
+	// below overwrite the union
+	switch(mode)
+	{
+	case Operand::Register:
+	{
+		flags |= DecodedOperand::ReadsRegister;
+		reg    = operand.asRegister.reg;
+		type   = operand.asRegister.type;
+		break;
+	}
+	case Operand::Immediate:
+	{
+		addend = operand.asImmediate.uint;
+		type   = operand.asImmediate.type;
+		break;
+	}
+	case Operand::Predicate:
+	{
+		flags   |= DecodedOperand::ReadsRegister;
+		reg      = operand.asPredicate.reg;
+		modifier = operand.asPredicate.modifier;
+		break;
+	}
+	case Operand::Indirect:
+	{
+		flags |= DecodedOperand::ReadsRegister;
+		reg    = operand.asIndirect.reg;
+		addend = operand.asIndirect.offset;
+		type   = operand.asIndirect.type;
+		break;
+	}
+	case Operand::Symbol:
+	{
+		addend = operand.asSymbol.symbolTableOffset;
+		break;
+	}
+	default: break;
+	}
+
+	decoded.flags    = flags;
+	decoded.reg      = reg;
+	decoded.addend   = addend;
+	decoded.type     = type;
+	decoded.modifier = modifier;
+}
+
+__device__ void decodeInstructionOperands(InstructionContainer& instruction)
+{
+	switch(instruction.asInstruction.opcode)
+	{
+	case Instruction::Atom:
+	{
+		decodeOperand(instruction.asAtom.c);
+	}
+	// fall through, the remaining operands are a binary instruction's
+	case Instruction::Add:
+	case Instruction::And:
+	case Instruction::Ashr:
+	case Instruction::Fdiv:
+	case Instruction::Fmul:
+	case Instruction::Frem:
+	case Instruction::Lshr:
+	case Instruction::Mul:
+	case Instruction::Or:
+	case Instruction::Setp:
+	case Instruction::Sdiv:
+	case Instruction::Shl:
+	case Instruction::Srem:
+	case Instruction::Sub:
+	case Instruction::Udiv:
+	case Instruction::Urem:
+	case Instruction::Xor:
+	{
+		decodeOperand(instruction.asBinaryInstruction.b);
+	}
+	// fall through, the remaining operands are a unary instruction's
+	case Instruction::Bitcast:
+	case Instruction::Fpext:
+	case Instruction::Fptosi:
+	case Instruction::Fptoui:
+	case Instruction::Fptrunc:
+	case Instruction::Ld:
+	case Instruction::Ret:
+	case Instruction::Sext:
+	case Instruction::Sitofp:
+	case Instruction::St:
+	case Instruction::Trunc:
+	case Instruction::Uitofp:
+	case Instruction::Zext:
+	{
+		decodeOperand(instruction.asUnaryInstruction.d);
+		decodeOperand(instruction.asUnaryInstruction.a);
+		break;
+	}
+	case Instruction::Bra:
+	{
+		decodeOperand(instruction.asBra.target);
+		break;
+	}
+	case Instruction::Call:
+	{
+		// the argument operands live in the data section and are
+		// decoded when they are read
+		decodeOperand(instruction.asCall.target);
+		break;
+	}
+	case Instruction::Phi:
+	{
+		// the source operands live in the data section
+		decodeOperand(instruction.asPhi.destination);
+		break;
+	}
+	default: break;
+	}
+}
+
+}
+
+}
+
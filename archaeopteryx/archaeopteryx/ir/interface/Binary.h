@@ -9,7 +9,7 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/util/interface/string.h>
 #include <archaeopteryx/util/interface/vector.h>
-#include <archaeopteryx/util/interface/map.h>
+#include <archaeopteryx/util/interface/HashMap.h>
 
 // Vanaheimr Includes
 #include <vanaheimr/asm/interface/BinaryHeader.h>
@@ -39,12 +39,16 @@ public:
 
 	/*! \brief a 64-bit program counter */
 	typedef uint64_t PC;
+	/*! \brief A PC that no instruction lives at */
+	static const PC InvalidPC = (PC)-1;
 	/*! \brief a file handle */
 	typedef util::File File;
 
 	/*! \brief A binary header */
 	typedef vanaheimr::as::BinaryHeader     Header;
-	typedef vanaheimr::as::SymbolTableEntry SymbolTableEntry;
+	typedef vanaheimr::as::SymbolTableEntry    SymbolTableEntry;
+	typedef vanaheimr::as::SymbolHashEntry     SymbolHashEntry;
+	typedef vanaheimr::as::CompressedPageEntry CompressedPageEntry;
 
 	/*! \brief A 32-KB page */
 	static const unsigned int PageSize = Header::PageSize / sizeof(uint32_t);
@@ -100,11 +104,28 @@ public:
 	/*! \brief Get symbol names that match a substring */
 	__device__ StringVector getSymbolNamesThatMatch(const char* substring);
 
+public:
+	/*! \brief Load the reconvergence point table, a no-op for binaries
+		from toolchains that do not emit one */
+	__device__ void loadReconvergencePointTable();
+	/*! \brief Get the reconvergence point of a potentially divergent
+		branch, the PC of its immediate post-dominator.  InvalidPC when
+		the binary has no table or the PC is not a branch in it */
+	__device__ PC findReconvergencePoint(PC branchPC);
+
 public:
 	/*! \brief Copy from the data section to an address */
 	__device__ void copyDataToAddress(void* address, uint64_t offset,
 		uint64_t bytes);
 
+public:
+	/*! \brief Get an iterator to the first symbol table entry */
+	__device__ symbol_table_iterator symbol_table_begin();
+	/*! \brief Get an iterator to one past the last symbol table entry */
+	__device__ symbol_table_iterator symbol_table_end();
+	/*! \brief Get the entry PC of a function symbol */
+	__device__ PC getFunctionPC(SymbolTableEntry* symbol);
+
 public:
 	/*! \brief Get an iterator to the first code page */
 	__device__ page_iterator code_begin();
@@ -138,6 +159,31 @@ private:
 	/*! \brief Load the symbol table */
 	__device__ void _loadSymbolTable();
 
+	/*! \brief Load the symbol name hash index */
+	__device__ void _loadHashIndex();
+
+	/*! \brief Load the page table of a binary with compressed sections */
+	__device__ void _loadPageTable();
+
+	/*! \brief Rewrite the operands of a freshly loaded code page into
+		the simulator's pre-decoded form, see DecodedOperand.h */
+	__device__ void _decodeCodePage(PageDataType* page);
+
+	/*! \brief Read one compressed page and expand it into place */
+	__device__ void _loadCompressedPage(PageDataType* page,
+		size_t pageTableIndex);
+
+	/*! \brief Start an asynchronous read of a code page that has not been
+		touched yet, the fill overlaps with ongoing execution.  Does
+		nothing when a prefetch is already in flight or the sections are
+		compressed. */
+	__device__ void _startCodePagePrefetch(page_iterator page);
+
+	/*! \brief Claim the data of an in-flight prefetch and install it,
+		only the issuing thread can do so.  Every other read on the file
+		must be preceded by this, the replies arrive in issue order. */
+	__device__ void _finishPrefetch();
+
 	/*! \brief Get an offset in the file for a specific code page */
 	__device__ size_t _getCodePageOffset(page_iterator page);
 	/*! \brief Get an offset in the file for a specific data page */
@@ -195,6 +241,18 @@ private:
 	/*! \brief The actual symbol table */
 	SymbolTableEntry* _symbolTable;
 
+	/*! \brief The symbol name hash index, zero for binaries without one */
+	SymbolHashEntry* _hashIndex;
+
+	/*! \brief The page table, zero for binaries without compression */
+	CompressedPageEntry* _pageTable;
+
+	/*! \brief (branch PC, reconvergence PC) pairs sorted by branch PC,
+		zero for binaries without a reconvergence table */
+	uint64_t* _reconvergenceTable;
+	/*! \brief The number of pairs, -1 until the table is looked up */
+	unsigned int _reconvergencePoints;
+
 private:
 	class Lock
 	{
@@ -207,17 +265,31 @@ private:
 		__device__ bool lock();
 		/*! \brief attempt to release the lock */
 		__device__ bool unlock();
-	
+		/*! \brief does the calling thread hold the lock? */
+		__device__ bool owned() const;
+
 	private:
-		unsigned int _lock;	
-	
+		unsigned int _lock;
+
 	};
 
-	typedef util::map<page_iterator, Lock> LockMap;
+	/*! The locks are probed on every locked page access, the open
+		addressed table keeps that to a single cache line */
+	typedef util::hash_map<page_iterator, Lock> LockMap;
 
 private:
 	LockMap _locks;
 
+private:
+	/*! \brief Held by the thread with a prefetch in flight */
+	Lock _prefetchLock;
+	/*! \brief The page a prefetch is in flight for, zero when idle */
+	page_iterator _prefetchTarget;
+	/*! \brief The buffer the prefetched page lands in */
+	PageDataType* _prefetchData;
+	/*! \brief The bytes requested by the in-flight prefetch */
+	size_t _prefetchBytes;
+
 
 };
 
@@ -0,0 +1,102 @@
+/*! \file   DecodedOperand.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the DecodedOperand class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/asm/interface/Operand.h>
+#include <vanaheimr/asm/interface/Instruction.h>
+
+namespace archaeopteryx
+{
+
+namespace ir
+{
+
+/*! \brief The simulator-friendly form of an instruction operand.
+
+	Code pages rewrite their operands into this form once when they are
+	loaded, so executing an instruction reads a resolved register index,
+	an extracted immediate, and unpacked mode flags instead of
+	re-interpreting the bytecode operand unions on every iteration of a
+	hot loop.  The decoded form overlays the OperandContainer it
+	replaced, instruction sizes and PCs do not change.  Operands stored
+	in the data section (e.g. call arguments) stay in bytecode form and
+	are decoded when they are read. */
+class DecodedOperand
+{
+public:
+	/*! \brief The decoded marker in the upper flag bits, a bytecode
+		operand never aliases it because its mode is a small enum */
+	static const uint32_t Marker     = 0xdec00000;
+	static const uint32_t MarkerMask = 0xfff00000;
+
+	/*! \brief The original operand mode lives in the low flag bits */
+	static const uint32_t ModeMask = 0xff;
+
+	/*! \brief Set when reading the operand loads a register */
+	static const uint32_t ReadsRegister = 0x100;
+
+public:
+	/*! \brief The marker, the original mode, and the unpacked flags */
+	uint32_t flags;
+	/*! \brief The resolved register index, only read when flagged.
+		Shares the offset of the register field of every bytecode
+		operand class */
+	vanaheimr::as::RegisterType reg;
+	/*! \brief The extracted immediate value, indirect offset, or symbol
+		table offset, zero for plain register operands */
+	uint64_t addend;
+	/*! \brief The data type of the operand */
+	vanaheimr::as::DataType type;
+	/*! \brief The predicate modifier, straight for everything else */
+	uint32_t modifier;
+
+public:
+	/*! \brief The mode the operand had in the bytecode */
+	__device__ vanaheimr::as::Operand::OperandMode mode() const
+	{
+		return (vanaheimr::as::Operand::OperandMode)(flags & ModeMask);
+	}
+
+	/*! \brief Was the container rewritten into the decoded form? */
+	__device__ bool decoded() const
+	{
+		return (flags & MarkerMask) == Marker;
+	}
+};
+
+/*! \brief The decoded form overlays the container it was rewritten from */
+static_assert(sizeof(DecodedOperand) <=
+	sizeof(vanaheimr::as::OperandContainer),
+	"DecodedOperand must fit inside an OperandContainer");
+
+/*! \brief View a rewritten operand container in its decoded form */
+__device__ inline DecodedOperand& asDecoded(
+	vanaheimr::as::OperandContainer& container)
+{
+	return *reinterpret_cast<DecodedOperand*>(&container);
+}
+
+/*! \brief View a rewritten operand container in its decoded form */
+__device__ inline const DecodedOperand& asDecoded(
+	const vanaheimr::as::OperandContainer& container)
+{
+	return *reinterpret_cast<const DecodedOperand*>(&container);
+}
+
+/*! \brief Rewrite one operand into the decoded form in place, idempotent */
+__device__ void decodeOperand(vanaheimr::as::OperandContainer& operand);
+
+/*! \brief Rewrite the operands of one instruction in place.  Operands
+	the instruction keeps in the data section are left alone */
+__device__ void decodeInstructionOperands(
+	vanaheimr::as::InstructionContainer& instruction);
+
+}
+
+}
+
@@ -7,6 +7,7 @@
 // Archaeopteryx Includes
 #include <archaeopteryx/runtime/interface/MemoryPool.h>
 
+#include <archaeopteryx/util/interface/File.h>
 #include <archaeopteryx/util/interface/debug.h>
 
 #ifdef REPORT_BASE
@@ -21,60 +22,96 @@ namespace archaeopteryx
 namespace rt
 {
 
+__device__ MemoryPool::MemoryPool()
+{
+	_statistics.clear();
+}
+
 __device__ bool MemoryPool::allocate(uint64_t size, Address address)
 {
 	device_report("Attempting to allocate %d bytes at %p\n", size, address);
-	
-	PageMap::iterator page = _pages.lower_bound(address);
 
-	if(page != _pages.end())
+	if(_buddy.contains(address) || _buddy.contains(address + size - 1))
 	{
-		// check against the next allocation
-		if(page->second.address() < address + size)
+		// placements that land inside the buddy region are claimed from
+		// the buddy allocator so that it never hands the range out again
+		if(!_buddy.reserve(size, address))
 		{
-			device_report(" failed, collision with subsequent "
-				"allocation at 0x%p\n", page->second.address());
+			device_report(" failed, collision with a buddy "
+				"allocator block\n");
 			return false;
 		}
-	}
 
-	if(page != _pages.begin())
+		_statistics.reservedBytes += _buddy.blockSize(size);
+	}
+	else
 	{
-		--page;
+		PageMap::iterator page = _pages.lower_bound(address);
 
-		// check against the previous allocation
-		if(page->second.endAddress() > address)
+		if(page != _pages.end())
 		{
-			device_report(" failed, collision with next "
-				"allocation at 0x%p\n", page->second.address());
-			return false;
+			// check against the next allocation
+			if(page->second.address() < address + size)
+			{
+				device_report(" failed, collision with subsequent "
+					"allocation at 0x%p\n", page->second.address());
+				return false;
+			}
+		}
+
+		if(page != _pages.begin())
+		{
+			--page;
+
+			// check against the previous allocation
+			if(page->second.endAddress() > address)
+			{
+				device_report(" failed, collision with next "
+					"allocation at 0x%p\n", page->second.address());
+				return false;
+			}
 		}
 	}
-	
+
 	_pages.insert(util::make_pair(address, Page(size, address)));
 
+	_statistics.allocations    += 1;
+	_statistics.allocatedBytes += size;
+
+	if(_statistics.reservedBytes > _statistics.peakReservedBytes)
+	{
+		_statistics.peakReservedBytes = _statistics.reservedBytes;
+	}
+
 	device_report(" success\n");
 	return true;
 }
 
 __device__ MemoryPool::Address MemoryPool::allocate(uint64_t size)
 {
-	// Get the next available address
-	Address address = 0;
+	// grab a block from the buddy allocator, this walks the free lists
+	// rather than scanning the existing allocations first-fit
+	Address address = _buddy.allocate(size);
 
-	// TODO use a more efficient divide-and-conquer algorithm here
-	for(PageMap::iterator page = _pages.begin(); page != _pages.end(); ++page)
+	if(address == InvalidAddress)
 	{
-		if(address + size <= page->second.address())
-		{
-			break;
-		}
+		device_report("Failed to allocate %d bytes, the buddy region "
+			"is full\n", (int)size);
 
-		address = page->second.endAddress();
+		return InvalidAddress;
 	}
 
 	_pages.insert(util::make_pair(address, Page(size, address)));
-	
+
+	_statistics.allocations    += 1;
+	_statistics.allocatedBytes += size;
+	_statistics.reservedBytes  += _buddy.blockSize(size);
+
+	if(_statistics.reservedBytes > _statistics.peakReservedBytes)
+	{
+		_statistics.peakReservedBytes = _statistics.reservedBytes;
+	}
+
 	return address;
 }
 
@@ -84,6 +121,18 @@ __device__ void MemoryPool::deallocate(Address address)
 
 	if(page == _pages.end()) return;
 
+	uint64_t size = page->second.size();
+
+	if(_buddy.contains(address))
+	{
+		_buddy.deallocate(address, size);
+
+		_statistics.reservedBytes -= _buddy.blockSize(size);
+	}
+
+	_statistics.deallocations  += 1;
+	_statistics.allocatedBytes -= size;
+
 	_pages.erase(page);
 }
 
@@ -117,6 +166,256 @@ __device__ MemoryPool::Address MemoryPool::translate(Address address)
 	return InvalidAddress;
 }
 
+__device__ void MemoryPool::save(util::File& file)
+{
+	uint64_t pages = _pages.size();
+
+	device_report("Saving %d pages to a checkpoint\n", (int)pages);
+
+	file.write(&pages, sizeof(uint64_t));
+
+	for(PageMap::iterator page = _pages.begin(); page != _pages.end(); ++page)
+	{
+		Address  address = page->second.address();
+		uint64_t size    = page->second.size();
+
+		device_report(" page at 0x%p (%d bytes)\n", address, (int)size);
+
+		file.write(&address, sizeof(Address));
+		file.write(&size,    sizeof(uint64_t));
+		file.write((const void*)page->second.physicalAddress(), size);
+	}
+}
+
+__device__ void MemoryPool::load(util::File& file)
+{
+	_pages.clear();
+	_buddy.clear();
+	_statistics.clear();
+
+	uint64_t pages = 0;
+
+	file.read(&pages, sizeof(uint64_t));
+
+	device_report("Loading %d pages from a checkpoint\n", (int)pages);
+
+	for(uint64_t i = 0; i < pages; ++i)
+	{
+		Address  address = 0;
+		uint64_t size    = 0;
+
+		file.read(&address, sizeof(Address));
+		file.read(&size,    sizeof(uint64_t));
+
+		device_report(" page at 0x%p (%d bytes)\n", address, (int)size);
+
+		bool success = allocate(size, address);
+
+		device_assert(success);
+
+		file.read((void*)translate(address), size);
+	}
+}
+
+__device__ MemoryPool::Statistics MemoryPool::statistics() const
+{
+	Statistics result = _statistics;
+
+	result.splits = _buddy.splits();
+	result.merges = _buddy.merges();
+
+	return result;
+}
+
+__device__ void MemoryPool::reportStatistics() const
+{
+	Statistics s = statistics();
+
+	device_report("Memory pool statistics:\n");
+	device_report(" live allocations:  %d\n", (int)(s.allocations -
+		s.deallocations));
+	device_report(" total allocations: %d\n", (int)s.allocations);
+	device_report(" allocated bytes:   %d\n", (int)s.allocatedBytes);
+	device_report(" reserved bytes:    %d\n", (int)s.reservedBytes);
+	device_report(" peak reserved:     %d\n", (int)s.peakReservedBytes);
+	device_report(" block splits:      %d\n", (int)s.splits);
+	device_report(" block merges:      %d\n", (int)s.merges);
+}
+
+__device__ void MemoryPool::Statistics::clear()
+{
+	allocations       = 0;
+	deallocations     = 0;
+	allocatedBytes    = 0;
+	reservedBytes     = 0;
+	peakReservedBytes = 0;
+	splits            = 0;
+	merges            = 0;
+}
+
+__device__ MemoryPool::BuddyAllocator::BuddyAllocator()
+: _splits(0), _merges(0)
+{
+	clear();
+}
+
+__device__ MemoryPool::Address MemoryPool::BuddyAllocator::allocate(
+	uint64_t size)
+{
+	unsigned int order = _order(size);
+
+	if(order >= BuddyOrderCount) return InvalidAddress;
+
+	// find the smallest free block that fits
+	unsigned int source = order;
+
+	while(source < BuddyOrderCount && _freeLists[source].empty()) ++source;
+
+	if(source == BuddyOrderCount) return InvalidAddress;
+
+	Address address = _freeLists[source].begin()->first;
+
+	_freeLists[source].erase(_freeLists[source].begin());
+
+	// split it down to the requested order, freeing the upper halves
+	while(source > order)
+	{
+		--source;
+
+		uint64_t half = (uint64_t)1 << (BuddyMinBlockLogSize + source);
+
+		_freeLists[source].insert(util::make_pair(address + half, source));
+
+		++_splits;
+	}
+
+	return address;
+}
+
+__device__ bool MemoryPool::BuddyAllocator::reserve(uint64_t size,
+	Address address)
+{
+	unsigned int order = _order(size);
+
+	if(order >= BuddyOrderCount) return false;
+
+	uint64_t bytes = blockSize(size);
+
+	// the block must be naturally aligned and fit inside the region
+	if((address - BuddyRegionBase) % bytes != 0)    return false;
+	if(!contains(address))                          return false;
+	if(!contains(address + bytes - 1))              return false;
+
+	return _reserveBlock(address, order);
+}
+
+__device__ void MemoryPool::BuddyAllocator::deallocate(Address address,
+	uint64_t size)
+{
+	unsigned int order = _order(size);
+
+	// coalesce with the buddy block while it is also free
+	while(order + 1 < BuddyOrderCount)
+	{
+		uint64_t bytes = (uint64_t)1 << (BuddyMinBlockLogSize + order);
+
+		Address buddy = (((address - BuddyRegionBase) ^ bytes) +
+			BuddyRegionBase);
+
+		FreeList::iterator freeBuddy = _freeLists[order].find(buddy);
+
+		if(freeBuddy == _freeLists[order].end()) break;
+
+		_freeLists[order].erase(freeBuddy);
+
+		if(buddy < address) address = buddy;
+
+		++order;
+		++_merges;
+	}
+
+	_freeLists[order].insert(util::make_pair(address, order));
+}
+
+__device__ void MemoryPool::BuddyAllocator::clear()
+{
+	for(unsigned int order = 0; order < BuddyOrderCount; ++order)
+	{
+		_freeLists[order].clear();
+	}
+
+	_freeLists[BuddyOrderCount - 1].insert(
+		util::make_pair(BuddyRegionBase, BuddyOrderCount - 1));
+}
+
+__device__ bool MemoryPool::BuddyAllocator::contains(Address address) const
+{
+	return address >= BuddyRegionBase &&
+		address < BuddyRegionBase + ((uint64_t)1 << BuddyRegionLogSize);
+}
+
+__device__ uint64_t MemoryPool::BuddyAllocator::blockSize(uint64_t size) const
+{
+	return (uint64_t)1 << (BuddyMinBlockLogSize + _order(size));
+}
+
+__device__ uint64_t MemoryPool::BuddyAllocator::splits() const
+{
+	return _splits;
+}
+
+__device__ uint64_t MemoryPool::BuddyAllocator::merges() const
+{
+	return _merges;
+}
+
+__device__ unsigned int MemoryPool::BuddyAllocator::_order(
+	uint64_t size) const
+{
+	uint64_t bytes = (uint64_t)1 << BuddyMinBlockLogSize;
+
+	unsigned int order = 0;
+
+	while(bytes < size)
+	{
+		bytes <<= 1;
+		++order;
+	}
+
+	return order;
+}
+
+__device__ bool MemoryPool::BuddyAllocator::_reserveBlock(Address address,
+	unsigned int order)
+{
+	FreeList::iterator block = _freeLists[order].find(address);
+
+	if(block != _freeLists[order].end())
+	{
+		_freeLists[order].erase(block);
+
+		return true;
+	}
+
+	if(order + 1 >= BuddyOrderCount) return false;
+
+	uint64_t bytes = (uint64_t)1 << (BuddyMinBlockLogSize + order);
+
+	Address parent = BuddyRegionBase +
+		(((address - BuddyRegionBase) / (2 * bytes)) * (2 * bytes));
+
+	if(!_reserveBlock(parent, order + 1)) return false;
+
+	// free the half of the parent that was not requested
+	Address sibling = parent == address ? address + bytes : parent;
+
+	_freeLists[order].insert(util::make_pair(sibling, order));
+
+	++_splits;
+
+	return true;
+}
+
 __device__ MemoryPool::Page::Page(uint64_t size, Address address)
 : _address(address), _data(size)
 {
@@ -13,7 +13,10 @@
 #include <archaeopteryx/runtime/interface/Runtime.h>
 #include <archaeopteryx/runtime/interface/MemoryPool.h>
 
+#include <archaeopteryx/util/interface/File.h>
+#include <archaeopteryx/util/interface/HashMap.h>
 #include <archaeopteryx/util/interface/Knob.h>
+#include <archaeopteryx/util/interface/map.h>
 #include <archaeopteryx/util/interface/debug.h>
 
 // Preprocessor Defines
@@ -34,6 +37,7 @@ class RuntimeState
 public:
 	typedef util::vector<executive::CoreSimBlock> CTAVector;
 	typedef util::map<util::string, ir::Binary*>  BinaryMap;
+	typedef util::hash_map<util::string, size_t>  FunctionPCMap;
 	typedef executive::CoreSimKernel              Kernel;
 
 public:
@@ -41,6 +45,10 @@ public:
 	CTAVector  hardwareCTAs;
 	BinaryMap  binaries;
 	MemoryPool memory;
+
+public:
+	/*! Function name to entry PC, filled when a binary loads */
+	FunctionPCMap functionPCs;
 	
 public:
 	size_t parameterMemoryAddress;
@@ -53,6 +61,21 @@ public:
 
 __device__ static RuntimeState* state = 0;
 
+/*! The fixed size prefix of a checkpoint file, everything else is the
+	memory pool pages followed by the per-CTA state */
+class CheckpointHeader
+{
+public:
+	uint64_t magic;
+	uint64_t parameterMemoryAddress;
+	uint64_t simulatedBlockCount;
+	uint64_t programEntryPointAddress;
+	uint64_t nextSimulatedBlock;
+	uint64_t hardwareCTACount;
+};
+
+__device__ static const uint64_t CheckpointMagic = 0x31746b7063726141ULL;
+
 __device__ void Runtime::create()
 {
 	device_report("Creating runtime.\n");
@@ -69,6 +92,8 @@ __device__ void Runtime::destroy()
 	
 	unloadBinaries();
 
+	state->memory.reportStatistics();
+
 	device_report(" destroying runtime state..\n");
 
 	executive::Intrinsics::unloadIntrinsics();
@@ -80,7 +105,29 @@ __device__ void Runtime::destroy()
 
 __device__ void Runtime::loadBinary(const char* fileName)
 {
-    state->binaries.insert(util::make_pair(fileName, new ir::Binary(fileName)));
+	ir::Binary* binary = new ir::Binary(fileName);
+
+    state->binaries.insert(util::make_pair(fileName, binary));
+
+	// resolve every function to its entry PC once at load time, each
+	// launch then hits the hash map instead of walking the symbol table
+	// and comparing strings
+	for(ir::Binary::symbol_table_iterator symbol =
+		binary->symbol_table_begin();
+		symbol != binary->symbol_table_end(); ++symbol)
+	{
+		if(symbol->type != ir::Binary::SymbolTableEntry::FunctionType)
+		{
+			continue;
+		}
+
+		state->functionPCs.insert(util::make_pair(
+			binary->getSymbolName(symbol), binary->getFunctionPC(symbol)));
+	}
+
+	// pull in the reconvergence point table while loading is still
+	// single threaded, the simulated blocks only read it
+	binary->loadReconvergencePointTable();
 }
 
 __device__ bool Runtime::mmap(size_t bytes, Address address)
@@ -110,6 +157,23 @@ __device__ void Runtime::loadKnobs()
 		util::KnobDatabase::getKnob<unsigned int>("simulator-ctas");
 	state->hardwareCTAs.resize(ctas);
 
+	// one up front allocation carved into per-block slabs, the blocks
+	// then bump allocate their simulated state instead of contending on
+	// the global device malloc lock
+	size_t slabSize = util::KnobDatabase::getKnob<size_t>(
+		"simulator-block-slab-size");
+
+	if(slabSize > 0)
+	{
+		char* slabs = new char[slabSize * ctas];
+
+		for(unsigned int i = 0; i < ctas; ++i)
+		{
+			state->hardwareCTAs[i].setSlabArena(
+				slabs + slabSize * i, slabSize);
+		}
+	}
+
 	state->kernel.simulatedBlocks = ctas;
 	state->kernel.linkRegister =
 		util::KnobDatabase::getKnob<unsigned int>("simulated-link-register");
@@ -177,6 +241,20 @@ __device__ void Runtime::setupArgument(const void* data,
 	std::memcpy(parameterBase + offset, data, size);
 }
 
+__device__ void Runtime::setupArgumentBlock(const void* data, size_t size)
+{
+	device_report("Installing argument block (address 0x%p, %d bytes) "
+		"in parameter memory (%p)\n", data, (int)size,
+		state->parameterMemoryAddress);
+
+	// one translation and one copy for the whole launch, the caller
+	// composed the buffer up front
+	char* parameterBase =
+		(char*)translateVirtualToPhysicalAddress(state->parameterMemoryAddress);
+
+	std::memcpy(parameterBase, data, size);
+}
+
 // Set the PC of all threads to the PC of the specified function
 //   Call into the binary to get the PC
 __device__ void Runtime::setupKernelEntryPoint(const char* functionName)
@@ -184,6 +262,13 @@ __device__ void Runtime::setupKernelEntryPoint(const char* functionName)
     state->programEntryPointAddress = findFunctionsPC(functionName);
 }
 
+// Set the PC directly from a handle that findFunctionsPC resolved, the
+// short launch path skips the name lookup entirely
+__device__ void Runtime::setupKernelEntryPoint(size_t entryPointPC)
+{
+    state->programEntryPointAddress = entryPointPC;
+}
+
 __global__ void launchSimulationInParallel()
 {
     kernel_report("Booting up parallel simulation entry point with "
@@ -193,6 +278,30 @@ __global__ void launchSimulationInParallel()
     	Runtime::getSelectedBinary());    
 }
 
+// Format 'prefix-index' into the buffer for a snapshot file name
+static __device__ void formatSnapshotFileName(char* fileName,
+	const char* prefix, unsigned int index)
+{
+	while(*prefix != 0) *fileName++ = *prefix++;
+
+	*fileName++ = '-';
+
+	char digits[12];
+
+	unsigned int digitCount = 0;
+
+	do
+	{
+		digits[digitCount++] = '0' + index % 10;
+		index /= 10;
+	}
+	while(index != 0);
+
+	while(digitCount != 0) *fileName++ = digits[--digitCount];
+
+	*fileName = 0;
+}
+
 // Start a new asynchronous kernel with the right number of HW CTAs/threads
 __device__ void Runtime::launchSimulation()
 {
@@ -200,14 +309,254 @@ __device__ void Runtime::launchSimulation()
 		util::KnobDatabase::getKnob<unsigned int>("simulator-ctas");
 	unsigned int threads =
 		util::KnobDatabase::getKnob<unsigned int>("simulator-threads-per-cta");
-	
-	state->kernel.simulatedBlocks = ctas;
-	launchSimulationInParallel<<<ctas, threads>>>();
-	cudaDeviceSynchronize();
+
+	// multi device runs shard the simulated grid by CTA range, one
+	// simulator process per device owns one contiguous shard and the
+	// shards only touch their own memory
+	unsigned int partitions = util::KnobDatabase::getKnob<unsigned int>(
+		"simulator-partition-count");
+	unsigned int partition  = util::KnobDatabase::getKnob<unsigned int>(
+		"simulator-partition-id");
+
+	if(partitions == 0) partitions = 1;
+
+	unsigned int shardSize  = (ctas + partitions - 1) / partitions;
+	unsigned int firstBlock = partition * shardSize;
+	unsigned int lastBlock  = firstBlock + shardSize < ctas
+		? firstBlock + shardSize : ctas;
+
+	state->kernel.simulatedBlocks = lastBlock;
+	state->kernel.replayTracing   = false;
+
+	util::string replayFile = util::KnobDatabase::getKnob<util::string>(
+		"simulator-replay-checkpoint");
+
+	if(!replayFile.empty())
+	{
+		// deterministic replay, restart from the named snapshot with
+		// every warp step traced instead of running from the beginning
+		if(!loadCheckpoint(replayFile.c_str()))
+		{
+			kernel_report("Replay checkpoint did not load, giving up.\n");
+			return;
+		}
+
+		state->kernel.replayTracing           = true;
+		state->kernel.fastForwardInstructions = 0;
+	}
+	else
+	{
+		state->kernel.nextSimulatedBlock = firstBlock;
+		state->kernel.statistics.clear();
+
+		// functional warm up, detailed accounting starts once this many
+		// instructions have retired
+		state->kernel.fastForwardInstructions =
+			util::KnobDatabase::getKnob<unsigned long long>(
+				"simulator-fast-forward-instructions");
+	}
+
+	state->kernel.fastForwardedInstructions = 0;
+
+	// periodic snapshots slice the launch at retirement boundaries, each
+	// slice drains the hardware blocks so the saved state is consistent.
+	// During a replay the same boundary ends the run after one window.
+	state->kernel.snapshotInstructions =
+		util::KnobDatabase::getKnob<unsigned long long>(
+			"simulator-snapshot-instructions");
+	state->kernel.snapshotBoundary = state->kernel.retiredInstructions()
+		+ state->kernel.snapshotInstructions;
+
+	util::string profileFile = util::KnobDatabase::getKnob<util::string>(
+		"simulator-instruction-profile");
+
+	if(!profileFile.empty())
+	{
+		state->kernel.profile.setup(getSelectedBinary());
+	}
+
+	// a zero sized level leaves that part of the cache model off
+	state->kernel.l1Cache.setup(
+		util::KnobDatabase::getKnob<unsigned int>("simulator-l1-cache-size"),
+		util::KnobDatabase::getKnob<unsigned int>(
+			"simulator-l1-cache-associativity"),
+		util::KnobDatabase::getKnob<unsigned int>(
+			"simulator-cache-line-size"));
+	state->kernel.l2Cache.setup(
+		util::KnobDatabase::getKnob<unsigned int>("simulator-l2-cache-size"),
+		util::KnobDatabase::getKnob<unsigned int>(
+			"simulator-l2-cache-associativity"),
+		util::KnobDatabase::getKnob<unsigned int>(
+			"simulator-cache-line-size"));
+
+	util::string memoryTraceFile = util::KnobDatabase::getKnob<util::string>(
+		"simulator-memory-trace");
+
+	util::File* traceFile = 0;
+
+	if(!memoryTraceFile.empty())
+	{
+		state->kernel.memoryTrace.setup(
+			util::KnobDatabase::getKnob<unsigned long long>(
+				"simulator-memory-trace-buffer-size"));
+
+		traceFile = new util::File(memoryTraceFile.c_str());
+	}
+
+	util::string snapshotPrefix = util::KnobDatabase::getKnob<util::string>(
+		"simulator-snapshot-prefix");
+
+	unsigned int snapshotIndex = 0;
+
+	while(true)
+	{
+		launchSimulationInParallel<<<ctas, threads>>>();
+		cudaDeviceSynchronize();
+
+		// drain the encoded address trace while the simulation is
+		// stopped, the writes stream through the host reflection channel
+		if(traceFile != 0)
+		{
+			traceFile->write(state->kernel.memoryTrace.data(),
+				state->kernel.memoryTrace.bytes());
+
+			state->kernel.memoryTrace.reset();
+		}
+
+		if(state->kernel.nextSimulatedBlock >= state->kernel.simulatedBlocks)
+		{
+			break;
+		}
+
+		// the replay re-executes a single snapshot window
+		if(state->kernel.replayTracing) break;
+
+		// the launch drained at a snapshot boundary, save it and resume
+		char fileName[256];
+
+		formatSnapshotFileName(fileName, snapshotPrefix.c_str(),
+			snapshotIndex++);
+
+		saveCheckpoint(fileName);
+
+		state->kernel.snapshotBoundary +=
+			state->kernel.snapshotInstructions;
+	}
+
+	state->kernel.statistics.report(state->binaries.begin()->first.c_str());
+
+	if(state->kernel.profile.enabled())
+	{
+		state->kernel.profile.writeToFile(profileFile.c_str(),
+			getSelectedBinary());
+
+		state->kernel.profile.clear();
+	}
+
+	if(traceFile != 0)
+	{
+		if(state->kernel.memoryTrace.dropped() != 0)
+		{
+			kernel_report("Dropped %llu memory trace records, raise "
+				"simulator-memory-trace-buffer-size or snapshot more "
+				"often.\n", state->kernel.memoryTrace.dropped());
+		}
+
+		state->kernel.memoryTrace.clear();
+
+		delete traceFile;
+	}
+
+	state->kernel.l1Cache.clear();
+	state->kernel.l2Cache.clear();
 
     kernel_report("Parallel simulation finished.\n");
 }
 
+__device__ void Runtime::saveCheckpoint(const char* fileName)
+{
+	device_report("Saving simulation checkpoint to '%s'\n", fileName);
+
+	util::File file(fileName);
+
+	CheckpointHeader header;
+
+	header.magic                    = CheckpointMagic;
+	header.parameterMemoryAddress   = state->parameterMemoryAddress;
+	header.simulatedBlockCount      = state->simulatedBlockCount;
+	header.programEntryPointAddress = state->programEntryPointAddress;
+	header.nextSimulatedBlock       = state->kernel.nextSimulatedBlock;
+	header.hardwareCTACount         = state->hardwareCTAs.size();
+
+	file.write(&header, sizeof(CheckpointHeader));
+	file.write(&state->kernel.statistics,
+		sizeof(executive::SimulationStatistics));
+
+	state->memory.save(file);
+
+	for(RuntimeState::CTAVector::iterator cta = state->hardwareCTAs.begin();
+		cta != state->hardwareCTAs.end(); ++cta)
+	{
+		cta->saveState(file);
+	}
+
+	device_report(" checkpoint saved\n");
+}
+
+__device__ bool Runtime::loadCheckpoint(const char* fileName)
+{
+	device_report("Loading simulation checkpoint from '%s'\n", fileName);
+
+	util::File file(fileName);
+
+	if(file.size() < sizeof(CheckpointHeader))
+	{
+		device_report(" file is too small to hold a checkpoint\n");
+		return false;
+	}
+
+	CheckpointHeader header;
+
+	file.read(&header, sizeof(CheckpointHeader));
+
+	if(header.magic != CheckpointMagic)
+	{
+		device_report(" not a checkpoint file\n");
+		return false;
+	}
+
+	state->parameterMemoryAddress   = header.parameterMemoryAddress;
+	state->simulatedBlockCount      = header.simulatedBlockCount;
+	state->programEntryPointAddress = header.programEntryPointAddress;
+
+	state->kernel.nextSimulatedBlock =
+		(unsigned int)header.nextSimulatedBlock;
+
+	file.read(&state->kernel.statistics,
+		sizeof(executive::SimulationStatistics));
+
+	state->memory.load(file);
+
+	if(state->hardwareCTAs.size() != header.hardwareCTACount)
+	{
+		state->hardwareCTAs.resize(header.hardwareCTACount);
+	}
+
+	for(RuntimeState::CTAVector::iterator cta = state->hardwareCTAs.begin();
+		cta != state->hardwareCTAs.end(); ++cta)
+	{
+		cta->loadState(file);
+
+		// checkpoints do not contain the binary, it is identified by name
+		// and must have been loaded again before resuming
+		cta->setupBinary(getSelectedBinary());
+	}
+
+	device_report(" checkpoint loaded\n");
+
+	return true;
+}
+
 __device__ void Runtime::unloadBinaries()
 {
 	for(RuntimeState::BinaryMap::iterator binary = state->binaries.begin();
@@ -217,21 +566,32 @@ __device__ void Runtime::unloadBinaries()
 	}
 	
 	device_report("   clearing binary map...\n");
-	
+
 	device_assert(state != 0);
 	state->binaries.clear();
-	
+	state->functionPCs.clear();
+
 	device_report("    finished...\n");
 }
 
 __device__ size_t Runtime::findFunctionsPC(const char* functionName)
 {
+	RuntimeState::FunctionPCMap::iterator cached =
+		state->functionPCs.find(functionName);
+
+	if(cached != state->functionPCs.end()) return cached->second;
+
 	for(RuntimeState::BinaryMap::iterator binary = state->binaries.begin();
 		binary != state->binaries.end(); ++binary)
 	{
 		if(!binary->second->containsFunction(functionName)) continue;
 
-		return binary->second->findFunctionsPC(functionName);
+		size_t pc = binary->second->findFunctionsPC(functionName);
+
+		state->functionPCs.insert(util::make_pair(
+			util::string(functionName), pc));
+
+		return pc;
 	}
 
 	//assertM(false, "Function name not found.");
@@ -8,9 +8,12 @@
 
 // Archaeopteryx Includes
 #include <archaeopteryx/util/interface/IntTypes.h>
-#include <archaeopteryx/util/interface/map.h>
+#include <archaeopteryx/util/interface/BTree.h>
 #include <archaeopteryx/util/interface/vector.h>
 
+// Forward Declarations
+namespace archaeopteryx { namespace util { class File; } }
+
 namespace archaeopteryx
 {
 
@@ -25,6 +28,43 @@ public:
 public:
 	static const Address InvalidAddress = (Address)(-1);
 
+	/*! Unplaced allocations are served by a binary buddy allocator out of
+		this range of the virtual address space, well above any fixed
+		placements */
+	static const Address  BuddyRegionBase      = (Address)1 << 40;
+	static const uint64_t BuddyRegionLogSize   = 34;
+	static const uint64_t BuddyMinBlockLogSize = 8;
+	static const unsigned int BuddyOrderCount  =
+		BuddyRegionLogSize - BuddyMinBlockLogSize + 1;
+
+public:
+	/*! Occupancy statistics for the pool */
+	class Statistics
+	{
+	public:
+		/*! The number of live allocations */
+		uint64_t allocations;
+		/*! The number of completed deallocations */
+		uint64_t deallocations;
+		/*! Bytes requested by the live allocations */
+		uint64_t allocatedBytes;
+		/*! Bytes held in buddy blocks, includes the rounding up to the
+			next power of two block size */
+		uint64_t reservedBytes;
+		/*! The high water mark of reservedBytes */
+		uint64_t peakReservedBytes;
+		/*! The number of times a free block was split */
+		uint64_t splits;
+		/*! The number of times two buddies were coalesced */
+		uint64_t merges;
+
+	public:
+		__device__ void clear();
+	};
+
+public:
+	__device__ MemoryPool();
+
 public:
 	/*! Attempt to create an allocation at the specified virtual address */
 	__device__ bool    allocate(uint64_t size, Address address);
@@ -36,6 +76,17 @@ public:
 	/*! Translate a virtual address to a physical address that can be dereferenced */
 	__device__ Address translate(Address address);
 
+	/*! Get the occupancy statistics of the pool */
+	__device__ Statistics statistics() const;
+	/*! Print the occupancy statistics */
+	__device__ void reportStatistics() const;
+
+	/*! Serialize every allocation to a checkpoint file */
+	__device__ void save(util::File& file);
+	/*! Restore the allocations from a checkpoint file, replacing the
+		current contents of the pool */
+	__device__ void load(util::File& file);
+
 private:
 	/*! A Page describes a memory allocation and contains the physical storage */
 	class Page
@@ -58,11 +109,59 @@ private:
 	};
 
 
+	/*! A binary buddy allocator over the virtual addresses of the buddy
+		region.  It keeps one free list per power of two block size, so an
+		allocation is a walk up the lists and a deallocation coalesces
+		with its buddy in one lookup per order. */
+	class BuddyAllocator
+	{
+	public:
+		__device__ BuddyAllocator();
+
+	public:
+		/*! Take the smallest free block that fits, splitting larger
+			blocks as needed.  Returns InvalidAddress when full. */
+		__device__ Address allocate(uint64_t size);
+		/*! Claim the block holding [address, address + size), the address
+			must be aligned to the block size */
+		__device__ bool reserve(uint64_t size, Address address);
+		/*! Return a block and coalesce it with its free buddies */
+		__device__ void deallocate(Address address, uint64_t size);
+		/*! Reset the region to one maximally sized free block */
+		__device__ void clear();
+
+	public:
+		/*! Does the address fall inside the buddy region? */
+		__device__ bool contains(Address address) const;
+		/*! The power of two block size backing an allocation */
+		__device__ uint64_t blockSize(uint64_t size) const;
+		__device__ uint64_t splits() const;
+		__device__ uint64_t merges() const;
+
+	private:
+		/*! The free lists double as sets, the payload is unused */
+		typedef util::btree_map<Address, unsigned int> FreeList;
+
+	private:
+		__device__ unsigned int _order(uint64_t size) const;
+		__device__ bool _reserveBlock(Address address, unsigned int order);
+
+	private:
+		FreeList _freeLists[BuddyOrderCount];
+		uint64_t _splits;
+		uint64_t _merges;
+	};
+
 private:
-	typedef util::map<Address, Page> PageMap;
+	/*! The address space maps are searched on every translate, the
+		B+-tree keeps a lookup to a few cache lines instead of one line
+		per element */
+	typedef util::btree_map<Address, Page> PageMap;
 
 private:
-	PageMap _pages;	
+	PageMap        _pages;
+	BuddyAllocator _buddy;
+	Statistics     _statistics;
 
 };
 
@@ -53,11 +53,28 @@ public:
 	__device__ static void setupMemoryConfig(unsigned int threadStackSize);
 	__device__ static void setupArgument(const void* data, size_t size,
 		size_t offset);
+	/*! Install a fully composed argument buffer in one copy, callers
+		should marshal all of their arguments into one block rather than
+		calling setupArgument per argument */
+	__device__ static void setupArgumentBlock(const void* data, size_t size);
 	__device__ static void setupKernelEntryPoint(const char* functionName);
+	/*! Set the entry point from a PC that findFunctionsPC already
+		resolved, launches that reuse a handle skip the name lookup */
+	__device__ static void setupKernelEntryPoint(size_t entryPointPC);
 
 public:
 	__device__ static void launchSimulation();
 
+public:
+	/*! Serialize the full simulation state (memory pool contents, register
+		files, thread PCs, and block state) to the named file so that a
+		long simulation can survive preemption */
+	__device__ static void saveCheckpoint(const char* fileName);
+	/*! Restore the simulation state from a checkpoint file, the same
+		binary must already be loaded.  Returns false if the file does not
+		hold a compatible checkpoint. */
+	__device__ static bool loadCheckpoint(const char* fileName);
+
 public:
 	__device__ static size_t findFunctionsPC(const char* functionName);
 	__device__ static ir::Binary* getSelectedBinary();
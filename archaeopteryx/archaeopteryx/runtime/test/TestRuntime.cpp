@@ -7,6 +7,8 @@
 
 #include <archaeopteryx/runtime/interface/Runtime.h>
 
+#include <cstring>
+
 // High level:
 // Create i/p data, load binary, launch threads/run kernel, read outputs and verify outputs 
 // Detailed steps:
@@ -57,9 +59,14 @@ extern "C" __global__ void runTest()
         	util::HostReflection::createPayload(
         	rt::Runtime::translateSimulatedAddressToCudaAddress((void*)baseY)));
 		
-		rt::Runtime::setupArgument(&baseX, sizeof(size_t),       0 );
-		rt::Runtime::setupArgument(&baseY, sizeof(size_t),       8 );
-		rt::Runtime::setupArgument(&a,     sizeof(unsigned int), 16);
+		// marshal the arguments into one block, one copy per launch
+		char arguments[20];
+
+		std::memcpy(arguments,      &baseX, sizeof(size_t));
+		std::memcpy(arguments + 8,  &baseY, sizeof(size_t));
+		std::memcpy(arguments + 16, &a,     sizeof(unsigned int));
+
+		rt::Runtime::setupArgumentBlock(arguments, sizeof(arguments));
 		rt::Runtime::setupLaunchConfig(ARRAY_SIZE/128, 128);
         rt::Runtime::setupKernelEntryPoint("main");
         rt::Runtime::launchSimulation();
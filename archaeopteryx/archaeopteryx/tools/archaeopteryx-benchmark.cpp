@@ -0,0 +1,364 @@
+/*	\file   archaeopteryx-benchmark.cpp
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The source file for the archaeopteryx benchmark harness.
+
+	Runs a fixed suite of workloads through the simulator, reports the
+	simulation rate (MIPS) and the counter mix for each one, and compares
+	the rates against stored baselines.  Built by 'scons benchmarks'.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/driver/host-interface/ArchaeopteryxDriver.h>
+#include <archaeopteryx/util/host-interface/HostReflectionHost.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+#include <hydrazine/interface/string.h>
+
+// Standard Library Includes
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace archaeopteryx
+{
+
+/*! \brief One workload in the suite manifest */
+class Workload
+{
+public:
+	std::string name;
+	std::string traceFileName;
+};
+
+typedef std::vector<Workload> WorkloadVector;
+typedef std::map<std::string, double> BaselineMap;
+
+/*! \brief One measured workload */
+class BenchmarkResult
+{
+public:
+	Workload workload;
+	double   seconds;
+	double   mips;
+
+	util::HostReflectionHost::SimulationStatistics statistics;
+};
+
+typedef std::vector<BenchmarkResult> BenchmarkResultVector;
+
+/*! \brief Parse a suite manifest with one '<name> <trace>' pair per
+	line, blank lines and lines starting with '#' are skipped */
+static WorkloadVector readSuite(const std::string& suiteFileName)
+{
+	std::ifstream suite(suiteFileName.c_str());
+
+	if(!suite.is_open())
+	{
+		throw std::runtime_error("Could not open suite manifest file '"
+			+ suiteFileName + "' for reading.");
+	}
+
+	WorkloadVector workloads;
+
+	std::string line;
+
+	while(std::getline(suite, line))
+	{
+		std::stringstream stream(line);
+
+		Workload workload;
+
+		stream >> workload.name;
+
+		if(workload.name.empty())        continue;
+		if(workload.name.front() == '#') continue;
+
+		stream >> workload.traceFileName;
+
+		if(workload.traceFileName.empty())
+		{
+			throw std::runtime_error("Suite manifest line '" + line
+				+ "' is missing a trace file.");
+		}
+
+		workloads.push_back(workload);
+	}
+
+	return workloads;
+}
+
+/*! \brief Parse '<name> <mips>' pairs, missing file means no baselines */
+static BaselineMap readBaselines(const std::string& baselineFileName)
+{
+	BaselineMap baselines;
+
+	std::ifstream file(baselineFileName.c_str());
+
+	if(!file.is_open()) return baselines;
+
+	std::string name;
+	double      mips;
+
+	while(file >> name >> mips)
+	{
+		baselines[name] = mips;
+	}
+
+	return baselines;
+}
+
+static void writeBaselines(const std::string& baselineFileName,
+	const BenchmarkResultVector& results)
+{
+	std::ofstream file(baselineFileName.c_str());
+
+	if(!file.is_open())
+	{
+		throw std::runtime_error("Could not open baseline file '"
+			+ baselineFileName + "' for writing.");
+	}
+
+	for(auto& result : results)
+	{
+		file << result.workload.name << " " << result.mips << "\n";
+	}
+}
+
+static BenchmarkResult runWorkload(const Workload& workload,
+	const driver::ArchaeopteryxDriver::KnobList& knobs)
+{
+	typedef std::chrono::duration<double> Seconds;
+
+	BenchmarkResult result;
+
+	result.workload = workload;
+
+	driver::ArchaeopteryxDriver driver;
+
+	auto start = std::chrono::steady_clock::now();
+
+	driver.runSimulation(workload.traceFileName, knobs);
+
+	auto end = std::chrono::steady_clock::now();
+
+	result.seconds = Seconds(end - start).count();
+
+	if(!util::HostReflectionHost::lastSimulationStatistics(
+		result.statistics))
+	{
+		throw std::runtime_error("Workload '" + workload.name
+			+ "' finished without reporting simulation statistics.");
+	}
+
+	result.mips = result.statistics.instructions
+		/ result.seconds / 1.0e6;
+
+	return result;
+}
+
+/*! \brief The counter mix, as fractions of the executed instructions.
+
+	The simulator does not time its fetch/decode/execute phases
+	separately, the statistics counters are the per-phase signal: how
+	many scheduling steps the instructions needed, how many of those
+	diverged or waited at barriers, and how many instructions touched
+	memory. */
+static void printResult(const BenchmarkResult& result)
+{
+	auto& statistics = result.statistics;
+
+	std::cout << result.workload.name << ":\n";
+	std::cout << "  simulation rate:   " << result.mips << " MIPS ("
+		<< statistics.instructions << " instructions in "
+		<< result.seconds << "s)\n";
+
+	if(statistics.scheduledSteps > 0)
+	{
+		std::cout << "  instructions/step: "
+			<< (double)statistics.instructions
+				/ statistics.scheduledSteps << "\n";
+		std::cout << "  divergent steps:   "
+			<< (double)statistics.divergentSteps
+				/ statistics.scheduledSteps << "\n";
+	}
+
+	if(statistics.instructions > 0)
+	{
+		std::cout << "  memory fraction:   "
+			<< (double)statistics.memoryTransactions
+				/ statistics.instructions << "\n";
+	}
+
+	std::cout << "  barrier waits:     " << statistics.barrierWaits << "\n";
+}
+
+static void writeReport(const std::string& outputFileName,
+	const BenchmarkResultVector& results)
+{
+	std::ofstream file(outputFileName.c_str());
+
+	if(!file.is_open())
+	{
+		throw std::runtime_error("Could not open report file '"
+			+ outputFileName + "' for writing.");
+	}
+
+	file << "[";
+
+	bool first = true;
+
+	for(auto& result : results)
+	{
+		if(!first) file << ",";
+
+		first = false;
+
+		file << "\n\t{"
+			<<   "\"name\": \""              << result.workload.name << "\""
+			<< ", \"trace\": \""
+				<< result.workload.traceFileName << "\""
+			<< ", \"seconds\": "             << result.seconds
+			<< ", \"mips\": "                << result.mips
+			<< ", \"instructions\": "
+				<< result.statistics.instructions
+			<< ", \"scheduledSteps\": "
+				<< result.statistics.scheduledSteps
+			<< ", \"memoryTransactions\": "
+				<< result.statistics.memoryTransactions
+			<< ", \"divergentSteps\": "
+				<< result.statistics.divergentSteps
+			<< ", \"barrierWaits\": "
+				<< result.statistics.barrierWaits
+			<< "}";
+	}
+
+	file << "\n]\n";
+}
+
+static driver::ArchaeopteryxDriver::KnobList extractKnobs(
+	const std::string& commaSeparatedKnobs)
+{
+	auto individualKnobs = hydrazine::split(commaSeparatedKnobs, ",");
+
+	driver::ArchaeopteryxDriver::KnobList knobs;
+
+	for(auto knob : individualKnobs)
+	{
+		auto keyValuePair = hydrazine::split(knob, "=");
+
+		if(keyValuePair.empty()) continue;
+
+		if(keyValuePair.size() == 1)
+		{
+			knobs.push_back(std::make_pair(keyValuePair[0], "0"));
+			continue;
+		}
+
+		knobs.push_back(std::make_pair(keyValuePair[0], keyValuePair[1]));
+	}
+
+	return knobs;
+}
+
+static int benchmark(const std::string& suiteFileName,
+	const std::string& baselineFileName, const std::string& knobString,
+	const std::string& outputFileName, double threshold,
+	bool updateBaselines)
+{
+	auto workloads = readSuite(suiteFileName);
+	auto baselines = readBaselines(baselineFileName);
+	auto knobs     = extractKnobs(knobString);
+
+	BenchmarkResultVector results;
+
+	unsigned int regressions = 0;
+
+	for(auto& workload : workloads)
+	{
+		auto result = runWorkload(workload, knobs);
+
+		printResult(result);
+
+		auto baseline = baselines.find(workload.name);
+
+		if(baseline != baselines.end() && !updateBaselines)
+		{
+			double floor = baseline->second * threshold;
+
+			if(result.mips < floor)
+			{
+				std::cout << "  REGRESSION: below " << floor
+					<< " MIPS (baseline " << baseline->second
+					<< " * threshold " << threshold << ")\n";
+
+				++regressions;
+			}
+		}
+
+		results.push_back(result);
+	}
+
+	if(!outputFileName.empty())
+	{
+		writeReport(outputFileName, results);
+	}
+
+	if(updateBaselines && !baselineFileName.empty())
+	{
+		writeBaselines(baselineFileName, results);
+	}
+
+	return regressions == 0 ? 0 : 1;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+	parser.description("Benchmarks the Archaeopteryx simulator over a "
+		"suite of workloads and compares the simulation rate against "
+		"stored baselines.");
+
+	std::string suite;
+	std::string baselines;
+	std::string knobs;
+	std::string output;
+
+	double threshold = 0.0;
+	bool   update    = false;
+
+	parser.parse( "-i", "--suite", suite, "",
+		"The suite manifest file (one '<name> <trace>' pair per line)." );
+	parser.parse( "-b", "--baselines", baselines, "",
+		"The stored baseline file ('<name> <mips>' per line)." );
+	parser.parse( "-t", "--threshold", threshold, 0.9,
+		"Fail a workload whose rate drops below baseline * threshold." );
+	parser.parse( "-u", "--update-baselines", update, false,
+		"Rewrite the baseline file with the measured rates." );
+	parser.parse( "-o", "--output", output, "",
+		"Write the measurements to this file as JSON." );
+	parser.parse( "-k", "--knobs", knobs, "",
+		"Comma separated list of knobs passed to every workload." );
+
+	parser.parse();
+
+	try
+	{
+		return archaeopteryx::benchmark(suite, baselines, knobs,
+			output, threshold, update);
+	}
+	catch(const std::exception& e)
+	{
+		std::cout << "Benchmark Error:\n";
+		std::cout << " Message: " << e.what() << "\n";
+	}
+
+	return 2;
+}
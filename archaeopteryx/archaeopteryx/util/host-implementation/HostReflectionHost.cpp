@@ -6,6 +6,7 @@
 
 // Archaeopteryx Includes
 #include <archaeopteryx/util/host-interface/HostReflectionHost.h>
+#include <archaeopteryx/util/host-interface/PinnedBufferPool.h>
 
 // Ocelot Includes
 #include <ocelot/api/interface/ocelot.h>
@@ -18,7 +19,15 @@
 #include <cstring>
 #include <cassert>
 #include <fstream>
+#include <iostream>
 #include <algorithm>
+#include <map>
+
+// System Includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -36,6 +45,84 @@ namespace util
 // device/host shared memory region
 static char* _deviceHostSharedMemory = 0;
 
+/*! \brief A read-only file mapped into the host address space.
+
+	Binary page requests are a sequential scan followed by random
+	touches, so read-only files are served straight out of an mmapped
+	view with sequential readahead hinted to the OS.  Repeated page
+	requests then hit the page cache with no syscalls at all.  All
+	handlers run on the single reflection worker thread, so the map
+	needs no locking */
+class FileMapping
+{
+public:
+	const char* data;
+	size_t      size;
+	int         fd;
+};
+
+typedef std::map<const void*, FileMapping> FileMappingMap;
+
+static FileMappingMap _mappedFiles;
+
+static void _mapFile(const void* handle, const std::string& filename)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+
+	if(fd < 0) return;
+
+	struct stat attributes;
+
+	if(fstat(fd, &attributes) != 0 || attributes.st_size == 0)
+	{
+		close(fd);
+		return;
+	}
+
+	void* data = mmap(0, attributes.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if(data == MAP_FAILED)
+	{
+		// fall back silently, the fstream path still works
+		close(fd);
+		return;
+	}
+
+	madvise(data, attributes.st_size, MADV_SEQUENTIAL);
+
+	FileMapping mapping;
+
+	mapping.data = (const char*)data;
+	mapping.size = attributes.st_size;
+	mapping.fd   = fd;
+
+	_mappedFiles.insert(std::make_pair(handle, mapping));
+
+	report("     mapped '" << filename << "' ("
+		<< attributes.st_size << " bytes) at " << data);
+}
+
+static const FileMapping* _findMapping(const void* handle)
+{
+	FileMappingMap::const_iterator mapping = _mappedFiles.find(handle);
+
+	if(mapping == _mappedFiles.end()) return 0;
+
+	return &mapping->second;
+}
+
+static void _unmapFile(const void* handle)
+{
+	FileMappingMap::iterator mapping = _mappedFiles.find(handle);
+
+	if(mapping == _mappedFiles.end()) return;
+
+	munmap((void*)mapping->second.data, mapping->second.size);
+	close(mapping->second.fd);
+
+	_mappedFiles.erase(mapping);
+}
+
 void HostReflectionHost::create(const std::string& module)
 {
 	assert(_booter == 0);
@@ -87,7 +174,13 @@ void HostReflectionHost::handleOpenFile(HostQueue& queue,
 
 	report("     handle: " << file);
 	report("     good:   " << (file->good() ? "yes" : "no"));
-	
+
+	// serve read-only files out of an mmapped view
+	if(file->good() && openmode == std::ios_base::in)
+	{
+		_mapFile(file, filename);
+	}
+
 	Header reply(*header);
 	
 	reply.handler = OpenFileReplyHandler;
@@ -114,7 +207,9 @@ void HostReflectionHost::handleTeardownFile(HostQueue& queue,
 	std::fstream* file(*(std::fstream**)(header + 1));
 
 	report("     handle: " << file);
-	
+
+	_unmapFile(file);
+
 	delete file;
 
 	report("     file closed...");
@@ -162,20 +257,101 @@ void HostReflectionHost::handleFileRead(HostQueue& queue,
 	size_t bytes = readHeader->size;
 
 	report("     reading " << bytes << " from file " << file);
-	
-	file->seekg(readHeader->pointer);
 
-	char* buffer = new char[bytes];
+	char* buffer = PinnedBufferPool::allocate(bytes);
+
+	const FileMapping* mapping = _findMapping(file);
+
+	if(mapping != 0)
+	{
+		size_t copied = std::min(bytes,
+			mapping->size - std::min(mapping->size, readHeader->pointer));
 
-	file->read(buffer, bytes);
+		std::memcpy(buffer, mapping->data + readHeader->pointer, copied);
+	}
+	else
+	{
+		file->seekg(readHeader->pointer);
+		file->read(buffer, bytes);
+	}
 
 	Header reply(*header);
-	
+
 	reply.size = sizeof(Header) + bytes;
 
 	hostSendAsynchronous(queue, reply, buffer);
 
-	delete[] buffer;
+	PinnedBufferPool::free(buffer);
+}
+
+void HostReflectionHost::handleBulkFileRead(HostQueue& queue,
+	const Header* header)
+{
+	struct BulkReadHeader
+	{
+		size_t count;
+		void*  flag;
+		size_t handle;
+	};
+
+	struct ReadDescriptor
+	{
+		size_t offset;
+		size_t size;
+		void*  data;
+	};
+
+	report("    handling bulk file read message");
+
+	BulkReadHeader* readHeader  = (BulkReadHeader*)(header     + 1);
+	ReadDescriptor* descriptors = (ReadDescriptor*)(readHeader + 1);
+
+	std::fstream* file = (std::fstream*)readHeader->handle;
+
+	report("     " << readHeader->count << " segments from file " << file);
+
+	// service every segment in one pass, the staging buffers are pinned
+	// so the copies genuinely run asynchronously on the stream and
+	// overlap with the file read filling the next segment
+	std::vector<char*> buffers;
+
+	const FileMapping* mapping = _findMapping(file);
+
+	for(size_t i = 0; i < readHeader->count; ++i)
+	{
+		char* buffer = PinnedBufferPool::allocate(descriptors[i].size);
+
+		if(mapping != 0)
+		{
+			std::memcpy(buffer, mapping->data + descriptors[i].offset,
+				descriptors[i].size);
+		}
+		else
+		{
+			file->seekg(descriptors[i].offset);
+			file->read(buffer, descriptors[i].size);
+		}
+
+		cudaMemcpyAsync(descriptors[i].data, buffer, descriptors[i].size,
+			cudaMemcpyHostToDevice, 0);
+
+		buffers.push_back(buffer);
+	}
+
+	// the ack is ordered behind the segment copies on the same stream, so
+	// the device wakes up only after all of its destinations are filled
+	bool value = true;
+
+	cudaMemcpyAsync(readHeader->flag, &value, sizeof(bool),
+		cudaMemcpyHostToDevice, 0);
+
+	cudaStreamSynchronize(0);
+
+	for(std::vector<char*>::iterator buffer = buffers.begin();
+		buffer != buffers.end(); ++buffer)
+	{
+		PinnedBufferPool::free(*buffer);
+	}
 }
 
 void HostReflectionHost::handleKernelLaunch(HostQueue& queue,
@@ -195,6 +371,68 @@ void HostReflectionHost::handleKernelLaunch(HostQueue& queue,
 	launchFromHost(*ctas, *threads, kernelName, arguments);
 }
 
+void HostReflectionHost::handleSimulationStatistics(HostQueue& queue,
+	const Header* header)
+{
+	struct StatisticsPayload
+	{
+		unsigned long long counters[15];
+		char               name[64];
+	};
+
+	report("    handling simulation statistics message");
+
+	StatisticsPayload* payload = (StatisticsPayload*)(header + 1);
+
+	// statistics are the product of the run, print them unconditionally
+	std::cout << "Simulation statistics for '" << payload->name << "':\n";
+	std::cout << " instructions:        " << payload->counters[0] << "\n";
+	std::cout << " scheduled steps:     " << payload->counters[1] << "\n";
+	std::cout << " memory transactions: " << payload->counters[2] << "\n";
+	std::cout << " divergent steps:     " << payload->counters[3] << "\n";
+	std::cout << " barrier waits:       " << payload->counters[4] << "\n";
+	std::cout << " shared accesses:     " << payload->counters[5] << "\n";
+	std::cout << " bank conflicts:      " << payload->counters[6] << "\n";
+	std::cout << " shared cycles:       " << payload->counters[7] << "\n";
+	std::cout << " global accesses:     " << payload->counters[8] << "\n";
+	std::cout << " global transactions: " << payload->counters[9] << "\n";
+	std::cout << " global cycles:       " << payload->counters[10] << "\n";
+	std::cout << " l1 cache hits:       " << payload->counters[11] << "\n";
+	std::cout << " l1 cache misses:     " << payload->counters[12] << "\n";
+	std::cout << " l2 cache hits:       " << payload->counters[13] << "\n";
+	std::cout << " l2 cache misses:     " << payload->counters[14] << "\n";
+
+	// keep a copy that the host can query after the run finishes
+	_lastStatistics.instructions         = payload->counters[0];
+	_lastStatistics.scheduledSteps       = payload->counters[1];
+	_lastStatistics.memoryTransactions   = payload->counters[2];
+	_lastStatistics.divergentSteps       = payload->counters[3];
+	_lastStatistics.barrierWaits         = payload->counters[4];
+	_lastStatistics.sharedMemoryAccesses = payload->counters[5];
+	_lastStatistics.bankConflicts        = payload->counters[6];
+	_lastStatistics.sharedMemoryCycles   = payload->counters[7];
+	_lastStatistics.globalMemoryAccesses = payload->counters[8];
+	_lastStatistics.globalTransactions   = payload->counters[9];
+	_lastStatistics.globalMemoryCycles   = payload->counters[10];
+	_lastStatistics.l1CacheHits          = payload->counters[11];
+	_lastStatistics.l1CacheMisses        = payload->counters[12];
+	_lastStatistics.l2CacheHits          = payload->counters[13];
+	_lastStatistics.l2CacheMisses        = payload->counters[14];
+	_lastStatistics.name                 = payload->name;
+
+	_hasStatistics = true;
+}
+
+bool HostReflectionHost::lastSimulationStatistics(
+	SimulationStatistics& statistics)
+{
+	if(!_hasStatistics) return false;
+
+	statistics = _lastStatistics;
+
+	return true;
+}
+
 void HostReflectionHost::hostSendAsynchronous(HostQueue& queue,
 	const Header& header, const void* payload)
 {
@@ -254,26 +492,35 @@ bool HostReflectionHost::HostQueue::push(const void* data, size_t size)
 	return true;
 }
 
-bool HostReflectionHost::HostQueue::pull(void* data, size_t size)
+size_t HostReflectionHost::HostQueue::available() const
+{
+	// the device publishes complete messages in order, everything up to
+	// ready is safe to read
+	return _metadata->ready - _metadata->tail;
+}
+
+void HostReflectionHost::HostQueue::peekAt(size_t offset, void* data,
+	size_t size)
 {
-	if(size > _used()) return false;
+	size_t end   = _metadata->size;
+	size_t start = (_metadata->tail + offset) % end;
+
+	size_t remainder = end - start;
+	size_t firstCopy = std::min(remainder, size);
 
-	report("   pulling " << size << " bytes from gpu->cpu queue (" << _used()
-		<< " used, " << _capacity() << " remaining, " << this->size()
-		<< " size)");
+	std::memcpy(data, _metadata->hostBegin + start, firstCopy);
 
-	_metadata->tail = _read(data, size);
+	bool secondCopyNecessary = firstCopy != size;
 
-	report("    after pull (" << _used()
-		<< " used, " << _capacity() << " remaining, " << this->size()
-		<< " size)");
+	size_t secondCopy = secondCopyNecessary ? size - firstCopy : 0;
 
-	return true;
+	std::memcpy((char*)data + firstCopy, _metadata->hostBegin, secondCopy);
 }
 
-bool HostReflectionHost::HostQueue::peek()
+void HostReflectionHost::HostQueue::advance(size_t size)
 {
-	return _used() >= sizeof(Header);
+	// one write of the shared tail retires the whole drained batch
+	_metadata->tail = _metadata->tail + size;
 }
 
 size_t HostReflectionHost::HostQueue::size() const
@@ -300,32 +547,15 @@ size_t HostReflectionHost::HostQueue::_capacity() const
 	return size() - _used();
 }
 
-size_t HostReflectionHost::HostQueue::_read(void* data, size_t size)
-{
-	size_t end  = _metadata->size;
-	size_t tail = _metadata->tail;
-
-	size_t remainder = end - tail;
-	size_t firstCopy = std::min(remainder, size);
-
-	std::memcpy(data, _metadata->hostBegin + tail, firstCopy);
-
-	bool secondCopyNecessary = firstCopy != size;
-
-	size_t secondCopy = secondCopyNecessary ? size - firstCopy : 0;
-	
-	std::memcpy((char*)data + firstCopy, _metadata->hostBegin, secondCopy);
-	
-	return secondCopyNecessary ? secondCopy : tail + firstCopy;
-}
-
 void HostReflectionHost::BootUp::_addMessageHandlers()
 {
 	addHandler(OpenFileMessageHandler,     handleOpenFile);
 	addHandler(TeardownFileMessageHandler, handleTeardownFile);
 	addHandler(FileWriteMessageHandler,    handleFileWrite);
 	addHandler(FileReadMessageHandler,     handleFileRead);
+	addHandler(BulkFileReadMessageHandler, handleBulkFileRead);
 	addHandler(KernelLaunchMessageHandler, handleKernelLaunch);
+	addHandler(SimulationStatisticsMessageHandler, handleSimulationStatistics);
 }
 
 HostReflectionHost::BootUp::BootUp(const std::string& module)
@@ -336,44 +566,42 @@ HostReflectionHost::BootUp::BootUp(const std::string& module)
 	// add message handlers
 	_addMessageHandlers();
 
-	// allocate memory for the queue
+	// allocate memory for the queues, one host-to-device queue and one
+	// device-to-host ring per channel
 	size_t queueDataSize = maxMessageSize() * 2;
-	size_t size = 2 * (queueDataSize + sizeof(QueueMetaData));
+	size_t queues = 1 + DeviceToHostChannels;
+	size_t size = queues * (queueDataSize + sizeof(QueueMetaData));
 
 	_deviceHostSharedMemory = new char[size];
 
 	// setup the queue meta data
-	QueueMetaData* hostToDeviceMetaData =
-		(QueueMetaData*)_deviceHostSharedMemory;
-	QueueMetaData* deviceToHostMetaData =
-		(QueueMetaData*)_deviceHostSharedMemory + 1;
-
-	char* hostToDeviceData = _deviceHostSharedMemory +
-		2 * sizeof(QueueMetaData);
-	char* deviceToHostData = _deviceHostSharedMemory +
-		2 * sizeof(QueueMetaData) + queueDataSize;
-
-	hostToDeviceMetaData->hostBegin = hostToDeviceData;
-	hostToDeviceMetaData->size      = queueDataSize;
-	hostToDeviceMetaData->head      = 0;
-	hostToDeviceMetaData->tail      = 0;
-	hostToDeviceMetaData->mutex     = (size_t)-1;
-
-	deviceToHostMetaData->hostBegin = deviceToHostData;
-	deviceToHostMetaData->size      = queueDataSize;
-	deviceToHostMetaData->head      = 0;
-	deviceToHostMetaData->tail      = 0;
-	deviceToHostMetaData->mutex     = (size_t)-1;
+	QueueMetaData* metadata = (QueueMetaData*)_deviceHostSharedMemory;
+
+	char* data = _deviceHostSharedMemory + queues * sizeof(QueueMetaData);
+
+	for(size_t i = 0; i < queues; ++i)
+	{
+		metadata[i].hostBegin = data + i * queueDataSize;
+		metadata[i].size      = queueDataSize;
+		metadata[i].head      = 0;
+		metadata[i].tail      = 0;
+		metadata[i].ready     = 0;
+		metadata[i].mutex     = (size_t)-1;
+	}
 
 	// Allocate the queues
-	_hostToDeviceQueue = new HostQueue(hostToDeviceMetaData);
-	_deviceToHostQueue = new HostQueue(deviceToHostMetaData);
+	_hostToDeviceQueue = new HostQueue(metadata);
+
+	for(size_t i = 0; i < DeviceToHostChannels; ++i)
+	{
+		_deviceToHostQueues.push_back(new HostQueue(metadata + 1 + i));
+	}
 
 	// Map the memory onto the device
 	cudaHostRegister(_deviceHostSharedMemory, size, 0);
 
 	char* devicePointer = 0;
-	
+
 	cudaHostGetDevicePointer((void**)&devicePointer,
 		_deviceHostSharedMemory, 0);
 
@@ -383,10 +611,11 @@ HostReflectionHost::BootUp::BootUp(const std::string& module)
 	QueueMetaData* deviceToHostMetaDataPointer =
 		(QueueMetaData*)devicePointer + 1;
 
-	hostToDeviceMetaData->deviceBegin = devicePointer +
-		2 * sizeof(QueueMetaData);
-	deviceToHostMetaData->deviceBegin = devicePointer +
-		2 * sizeof(QueueMetaData) + queueDataSize;
+	for(size_t i = 0; i < queues; ++i)
+	{
+		metadata[i].deviceBegin = devicePointer +
+			queues * sizeof(QueueMetaData) + i * queueDataSize;
+	}
 
 	cudaConfigureCall(dim3(1, 1, 1), dim3(1, 1, 1), 0, 0);
 
@@ -416,10 +645,18 @@ HostReflectionHost::BootUp::~BootUp()
 	
 	// destroy the host queues
 	delete _hostToDeviceQueue;
-	delete _deviceToHostQueue;
-	
+
+	for(ChannelVector::iterator queue = _deviceToHostQueues.begin();
+		queue != _deviceToHostQueues.end(); ++queue)
+	{
+		delete *queue;
+	}
+
 	// delete the queue memory
 	delete[] _deviceHostSharedMemory;
+
+	// hand the pooled staging buffers back to the driver
+	PinnedBufferPool::clear();
 }
 
 void HostReflectionHost::BootUp::addHandler(int handlerId,
@@ -443,54 +680,96 @@ void HostReflectionHost::BootUp::addLaunch(const KernelLaunch& launch)
 	_launches.push(launch);
 }
 
-bool HostReflectionHost::BootUp::_handleMessage()
+bool HostReflectionHost::BootUp::_handleMessages()
 {
-	if(!_deviceToHostQueue->peek())
+	bool handledAny = false;
+
+	for(ChannelVector::iterator queue = _deviceToHostQueues.begin();
+		queue != _deviceToHostQueues.end(); ++queue)
 	{
-		return false;
+		handledAny |= _drainChannel(**queue);
 	}
-	
-	report("  found message in gpu->cpu queue, pulling it...");
-	
-	Header header;
-	
-	_deviceToHostQueue->pull(&header, sizeof(Header));
+
+	return handledAny;
+}
+
+bool HostReflectionHost::BootUp::_drainChannel(HostQueue& queue)
+{
+	size_t bytes = queue.available();
+
+	if(bytes < sizeof(Header)) return false;
+
+	report("  draining " << bytes << " bytes from a gpu->cpu channel...");
+
+	// handle every published message in one pass, the shared tail is only
+	// written once at the end of the batch
+	size_t offset = 0;
+
+	while(offset + sizeof(Header) <= bytes)
+	{
+		Header header;
+
+		queue.peekAt(offset, &header, sizeof(Header));
+
+		assert(header.size >= sizeof(Header));
+
+		if(offset + header.size > bytes) break;
+
+		char* message = PinnedBufferPool::allocate(header.size);
+
+		queue.peekAt(offset, message, header.size);
+
+		_handleMessage(reinterpret_cast<Header*>(message));
+
+		PinnedBufferPool::free(message);
+
+		offset += header.size;
+	}
+
+	queue.advance(offset);
+
+	return offset != 0;
+}
+
+void HostReflectionHost::BootUp::_handleMessage(const Header* message)
+{
+	Header header = *message;
+
+	const char* payload = (const char*)(message + 1);
 
 	report("   type     " << header.type);
 	report("   threadId " << header.threadId);
 	report("   size     " << header.size);
 	report("   handler  " << header.handler);
-	
+
 	HandlerMap::iterator handler = _handlers.find(header.handler);
 	assert(handler != _handlers.end());
-	
+
 	if(header.type == Synchronous)
 	{
 		void* address = 0;
-		_deviceToHostQueue->pull(&address, sizeof(void*));
-	
+		std::memcpy(&address, payload, sizeof(void*));
+		payload += sizeof(void*);
+
 		report("   synchronous ack to address: " << address);
 		bool value = true;
-		
+
 		cudaMemcpyAsync(address, &value, sizeof(bool),
 			cudaMemcpyHostToDevice, 0);
 		header.size -= sizeof(void*);
 	}
 
-	unsigned int size = header.size + sizeof(Header);
-	
-	Header* message = reinterpret_cast<Header*>(new char[size]);
-	
-	std::memcpy(message, &header, sizeof(Header));
+	// the handlers expect the payload directly behind the header
+	Header* buffer = reinterpret_cast<Header*>(
+		PinnedBufferPool::allocate(header.size));
+
+	std::memcpy(buffer, &header, sizeof(Header));
+	std::memcpy(buffer + 1, payload, header.size - sizeof(Header));
 
-	_deviceToHostQueue->pull(message + 1, header.size - sizeof(Header));
-	
 	report("   invoking message handler...");
-	handler->second(*_hostToDeviceQueue, message);
-	
-	delete[] reinterpret_cast<char*>(message);
-	
-	return true;
+	handler->second(*_hostToDeviceQueue, buffer);
+
+	PinnedBufferPool::free(reinterpret_cast<char*>(buffer));
 }
 
 static bool areAnyCudaKernelsRunning()
@@ -518,24 +797,24 @@ void HostReflectionHost::BootUp::_run()
 		{
 			if(!areAnyCudaKernelsRunning())
 			{
-				if(_launches.empty() && !_handleMessage())
+				if(_launches.empty() && !_handleMessages())
 				{
 					break;
 				}
 			}
 		}
-	
+
 		if(!_launches.empty())
 		{
 			_launchNextKernel();
 		}
-		else if(!_handleMessage())
+		else if(!_handleMessages())
 		{
 			boost::this_thread::sleep(boost::posix_time::milliseconds(20));
 		}
 		else
 		{
-			while(_handleMessage());
+			while(_handleMessages());
 		}
 	}
 
@@ -568,6 +847,9 @@ void HostReflectionHost::BootUp::_runThread(BootUp* booter)
 
 HostReflectionHost::BootUp* HostReflectionHost::_booter = 0;
 
+HostReflectionHost::SimulationStatistics HostReflectionHost::_lastStatistics;
+bool HostReflectionHost::_hasStatistics = false;
+
 }
 
 }
@@ -0,0 +1,107 @@
+/*	\file   PinnedBufferPool.cpp
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The source file for the PinnedBufferPool class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/host-interface/PinnedBufferPool.h>
+
+// Ocelot Includes
+#include <ocelot/cuda/interface/cuda_runtime.h>
+
+// Boost Includes
+#include <boost/thread.hpp>
+
+// Standard Library Includes
+#include <cassert>
+#include <map>
+#include <vector>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+typedef std::map<size_t, std::vector<char*> > FreeListMap;
+typedef std::map<char*, size_t>               SizeMap;
+
+// buffers below this share one class, pinning has page granularity anyway
+static const size_t MinimumBufferSize = 4096;
+
+static boost::mutex _mutex;
+static FreeListMap  _freeLists;
+static SizeMap      _outstanding;
+
+static size_t _sizeClass(size_t size)
+{
+	size_t rounded = MinimumBufferSize;
+
+	while(rounded < size) rounded *= 2;
+
+	return rounded;
+}
+
+char* PinnedBufferPool::allocate(size_t size)
+{
+	size_t rounded = _sizeClass(size);
+
+	boost::mutex::scoped_lock lock(_mutex);
+
+	std::vector<char*>& freeList = _freeLists[rounded];
+
+	char* buffer = 0;
+
+	if(!freeList.empty())
+	{
+		buffer = freeList.back();
+		freeList.pop_back();
+	}
+	else
+	{
+		cudaMallocHost((void**)&buffer, rounded);
+	}
+
+	_outstanding.insert(std::make_pair(buffer, rounded));
+
+	return buffer;
+}
+
+void PinnedBufferPool::free(char* buffer)
+{
+	if(buffer == 0) return;
+
+	boost::mutex::scoped_lock lock(_mutex);
+
+	SizeMap::iterator size = _outstanding.find(buffer);
+
+	assert(size != _outstanding.end());
+
+	_freeLists[size->second].push_back(buffer);
+
+	_outstanding.erase(size);
+}
+
+void PinnedBufferPool::clear()
+{
+	boost::mutex::scoped_lock lock(_mutex);
+
+	assert(_outstanding.empty());
+
+	for(FreeListMap::iterator list = _freeLists.begin();
+		list != _freeLists.end(); ++list)
+	{
+		for(std::vector<char*>::iterator buffer = list->second.begin();
+			buffer != list->second.end(); ++buffer)
+		{
+			cudaFreeHost(*buffer);
+		}
+	}
+
+	_freeLists.clear();
+}
+
+}
+
+}
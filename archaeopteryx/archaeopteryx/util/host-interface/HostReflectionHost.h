@@ -15,6 +15,8 @@
 // Standard Library Includes
 #include <map>
 #include <queue>
+#include <string>
+#include <vector>
 
 namespace archaeopteryx
 {
@@ -46,11 +48,19 @@ public:
 		~HostQueue();
 
 	public:
+		/*! Host-to-device producer interface */
 		bool push(const void* data, size_t size);
-		bool pull(void* data, size_t size);
 
 	public:
-		bool peek();
+		/*! Device-to-host batch draining interface.  available reads the
+			published prefix, peekAt copies bytes out without dequeuing,
+			and advance retires a whole batch with one write of the
+			shared tail. */
+		size_t available() const;
+		void peekAt(size_t offset, void* data, size_t size);
+		void advance(size_t size);
+
+	public:
 		size_t size() const;
 
 	private:
@@ -59,10 +69,7 @@ public:
 	private:
 		size_t _capacity() const;
 		size_t _used() const;
-
-	private:
-		size_t _read(void* data, size_t size);
-	};	
+	};
 
 public:
 	/*! \brief Handle an open message on the host */
@@ -77,9 +84,42 @@ public:
 	/*! \brief Handle a file read message on the host */
 	static void handleFileRead(HostQueue& q, const Header*);
 
+	/*! \brief Handle a scatter/gather bulk file read on the host */
+	static void handleBulkFileRead(HostQueue& q, const Header*);
+
 	/*! \brief Handle a kernel launch message on the host */
 	static void handleKernelLaunch(HostQueue& q, const Header*);
 
+	/*! \brief Handle a simulation statistics message from a device */
+	static void handleSimulationStatistics(HostQueue& q, const Header*);
+
+public:
+	/*! \brief The counters from one simulation statistics message */
+	class SimulationStatistics
+	{
+	public:
+		unsigned long long instructions;
+		unsigned long long scheduledSteps;
+		unsigned long long memoryTransactions;
+		unsigned long long divergentSteps;
+		unsigned long long barrierWaits;
+		unsigned long long sharedMemoryAccesses;
+		unsigned long long bankConflicts;
+		unsigned long long sharedMemoryCycles;
+		unsigned long long globalMemoryAccesses;
+		unsigned long long globalTransactions;
+		unsigned long long globalMemoryCycles;
+		unsigned long long l1CacheHits;
+		unsigned long long l1CacheMisses;
+		unsigned long long l2CacheHits;
+		unsigned long long l2CacheMisses;
+		std::string        name;
+	};
+
+	/*! \brief Get the most recent statistics message, false if none has
+		arrived yet.  Final once the reflection thread has been torn down */
+	static bool lastSimulationStatistics(SimulationStatistics& statistics);
+
 public:
 	static size_t maxMessageSize();
 
@@ -100,6 +140,7 @@ private:
 		typedef void (*KernelFunctionType)(Payload& payload);
 		typedef std::map<std::string, KernelFunctionType> KernelMap;
 		typedef std::queue<KernelLaunch> LaunchQueue;
+		typedef std::vector<HostQueue*> ChannelVector;
 	
 	public:
 		BootUp(const std::string& n);
@@ -114,7 +155,7 @@ private:
 	private:
 		boost::thread* _thread;
 		HostQueue*     _hostToDeviceQueue;
-		HostQueue*     _deviceToHostQueue;
+		ChannelVector  _deviceToHostQueues;
 		bool           _kill;
 		std::string    _module;
 	
@@ -126,7 +167,9 @@ private:
 	private:
 		void _run();
 		void _launchNextKernel();
-		bool _handleMessage();
+		bool _handleMessages();
+		bool _drainChannel(HostQueue& queue);
+		void _handleMessage(const Header* message);
 		void _addMessageHandlers();
 	
 	private:
@@ -135,6 +178,9 @@ private:
 
 private:
 	static BootUp* _booter;
+
+	static SimulationStatistics _lastStatistics;
+	static bool                 _hasStatistics;
 };
 
 }
@@ -0,0 +1,43 @@
+/*	\file   PinnedBufferPool.h
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The header file for the PinnedBufferPool class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstddef>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! \brief A pool of reusable page-locked staging buffers.
+
+	Transfers through pageable memory make the driver stage internally
+	and roughly halve the achievable bandwidth, and the reflection
+	handlers used to allocate a fresh staging buffer for every message.
+	The pool hands out pinned buffers in power of two size classes and
+	keeps returned buffers for reuse, so the hot paths see neither an
+	allocation nor a pin after warm up, and cudaMemcpyAsync from a
+	pooled buffer genuinely overlaps with the file read that fills the
+	next one. */
+class PinnedBufferPool
+{
+public:
+	/*! \brief Get a pinned buffer of at least the requested size */
+	static char* allocate(size_t size);
+
+	/*! \brief Return a buffer to its size class for reuse */
+	static void free(char* buffer);
+
+	/*! \brief Release every pooled buffer back to the driver */
+	static void clear();
+};
+
+}
+
+}
@@ -105,17 +105,50 @@ __device__ void File::read(void* data, size_t bytes)
 		bytes = size() - _get;
 	}
 
-	char* pointer = reinterpret_cast<char*>(data);
-
 	device_report("performing file read (%d size, %d pointer)\n",
 		(int)bytes, (int)_get);
 
-	while(bytes > 0)
+	// a single scatter/gather segment, the host copies the bytes straight
+	// into the destination rather than streaming chunked replies through
+	// the message queue
+	ReadDescriptor descriptor;
+
+	descriptor.offset = _get;
+	descriptor.size   = bytes;
+	descriptor.data   = data;
+
+	readBulk(&descriptor, 1);
+
+	_get += bytes;
+}
+
+__device__ void File::readBulk(const ReadDescriptor* descriptors,
+	size_t count)
+{
+	size_t maxDescriptors = (HostReflectionDevice::maxMessageSize() -
+		sizeof(HostReflectionShared::Header) - 3 * sizeof(size_t)) /
+		sizeof(ReadDescriptor);
+
+	while(count > 0)
 	{
-		size_t bytesRead = readSome(pointer, bytes);
-	
-		pointer += bytesRead;
-		bytes   -= bytesRead;
+		size_t batch = util::min(count, maxDescriptors);
+
+		volatile bool* flag = new bool;
+
+		*flag = false;
+
+		BulkReadMessage message(descriptors, batch, (void*)flag, _handle);
+
+		HostReflectionDevice::sendAsynchronous(message);
+
+		// the host acks once every segment of the batch has been copied
+		// into its destination
+		while(*flag == false);
+
+		delete flag;
+
+		descriptors += batch;
+		count       -= batch;
 	}
 }
 
@@ -148,6 +181,63 @@ __device__ size_t File::readSome(void* data, size_t bytes)
 	return attemptedSize;
 }
 
+__device__ size_t File::startRead(size_t bytes)
+{
+	if(_get + bytes > size())
+	{
+		bytes = size() - _get;
+	}
+
+	size_t remaining = bytes;
+	size_t pointer   = _get;
+
+	device_report("starting asynchronous file read (%d size, %d pointer)\n",
+		(int)bytes, (int)pointer);
+
+	// queue up the requests for the whole range, the host answers them in
+	// order while the device keeps executing
+	while(remaining > 0)
+	{
+		size_t attemptedSize =
+			util::min(remaining, util::max((size_t)1,
+				(size_t)(HostReflectionDevice::maxMessageSize() / 2)));
+
+		ReadMessage message(attemptedSize, pointer, _handle);
+
+		HostReflectionDevice::sendSynchronous(message);
+
+		pointer   += attemptedSize;
+		remaining -= attemptedSize;
+	}
+
+	_get = pointer;
+
+	return bytes;
+}
+
+__device__ void File::finishRead(void* data, size_t bytes)
+{
+	char* pointer = reinterpret_cast<char*>(data);
+
+	device_report("finishing asynchronous file read (%d size)\n", (int)bytes);
+
+	while(bytes > 0)
+	{
+		size_t attemptedSize =
+			util::min(bytes, util::max((size_t)1,
+				(size_t)(HostReflectionDevice::maxMessageSize() / 2)));
+
+		ReadReply reply(attemptedSize);
+
+		HostReflectionDevice::receive(reply);
+
+		util::memcpy(pointer, reply.payload(), attemptedSize);
+
+		pointer += attemptedSize;
+		bytes   -= attemptedSize;
+	}
+}
+
 __device__ size_t File::size() const
 {
 	return _size;
@@ -368,6 +458,44 @@ __device__ HostReflectionDevice::HandlerId File::ReadReply::handler() const
 	return HostReflectionDevice::FileReadReplyHandler;
 }
 
+__device__ File::BulkReadMessage::BulkReadMessage(
+	const ReadDescriptor* descriptors, size_t count, void* flag,
+	Handle handle)
+: _data(new char[sizeof(Header) + count * sizeof(ReadDescriptor)]),
+	_size(sizeof(Header) + count * sizeof(ReadDescriptor))
+{
+	Header header;
+
+	header.count  = count;
+	header.flag   = flag;
+	header.handle = handle;
+
+	util::memcpy(_data, &header, sizeof(Header));
+	util::memcpy(_data + sizeof(Header), descriptors,
+		count * sizeof(ReadDescriptor));
+}
+
+__device__ File::BulkReadMessage::~BulkReadMessage()
+{
+	delete[] _data;
+}
+
+__device__ void* File::BulkReadMessage::payload() const
+{
+	return _data;
+}
+
+__device__ size_t File::BulkReadMessage::payloadSize() const
+{
+	return _size;
+}
+
+__device__ HostReflectionDevice::HandlerId
+	File::BulkReadMessage::handler() const
+{
+	return HostReflectionDevice::BulkFileReadMessageHandler;
+}
+
 }
 
 }
@@ -26,7 +26,16 @@ namespace util
 
 // TODO Remove these when __device__ can be embedded in a clas
 __device__ HostReflectionDevice::DeviceQueue* _hostToDevice;
-__device__ HostReflectionDevice::DeviceQueue* _deviceToHost;
+__device__ HostReflectionDevice::DeviceQueue*
+	_deviceToHost[HostReflectionShared::DeviceToHostChannels];
+
+// blocks hash onto independent device->host rings so that logging and
+// file traffic from different blocks do not serialize on one queue
+__device__ static HostReflectionDevice::DeviceQueue* _channel()
+{
+	return _deviceToHost[blockIdx.x %
+		HostReflectionShared::DeviceToHostChannels];
+}
 
 __device__ HostReflectionDevice::KernelLaunchMessage::KernelLaunchMessage(
 	unsigned int ctas, unsigned int threads,
@@ -74,63 +83,96 @@ __device__ HostReflectionShared::HandlerId
 
 __device__ void HostReflectionDevice::sendAsynchronous(const Message& m)
 {
-	unsigned int bytes = m.payloadSize() + sizeof(Header);
+	const Message* message = &m;
 
-	char* buffer = new char[bytes];
-	
-	Header* header = reinterpret_cast<Header*>(buffer);
-	
-	header->type     = Asynchronous;
-	header->threadId = threadIdx.x;
-	header->size     = bytes;
-	header->handler  = m.handler();
-	
-	util::memcpy(buffer + sizeof(Header), m.payload(), m.payloadSize());
-	 
-	device_report(" sending asynchronous gpu->host message "
-		"(%d type, %d id, %d size, %d handler)\n", Asynchronous,	
-		header->threadId, bytes, m.handler());
-	
-	while(!_deviceToHost->push(buffer, bytes));
+	sendBulk(&message, 1);
+}
 
-	delete[] buffer;
+__device__ void HostReflectionDevice::sendBulk(const Message* const* messages,
+	unsigned int count)
+{
+	DeviceQueue* queue = _channel();
+
+	size_t bytes = 0;
+
+	for(unsigned int i = 0; i < count; ++i)
+	{
+		bytes += messages[i]->payloadSize() + sizeof(Header);
+	}
+
+	device_assert(bytes <= queue->size());
+
+	device_report(" sending %d asynchronous gpu->host messages "
+		"(%d bytes)\n", count, (int)bytes);
+
+	// one reservation covers the whole batch, the headers and payloads
+	// are written straight into the ring without an intermediate buffer
+	size_t offset = 0;
+
+	while(!queue->reserve(bytes, offset));
+
+	size_t position = offset;
+
+	for(unsigned int i = 0; i < count; ++i)
+	{
+		Header header;
+
+		header.type     = Asynchronous;
+		header.threadId = threadIdx.x;
+		header.size     = messages[i]->payloadSize() + sizeof(Header);
+		header.handler  = messages[i]->handler();
+
+		queue->write(position, &header, sizeof(Header));
+		queue->write(position + sizeof(Header), messages[i]->payload(),
+			messages[i]->payloadSize());
+
+		position += header.size;
+	}
+
+	queue->publish(offset, bytes);
 }
 
 __device__ void HostReflectionDevice::sendSynchronous(const Message& m)
 {
-	unsigned int bytes = m.payloadSize() + sizeof(SynchronousHeader);
+	DeviceQueue* queue = _channel();
+
+	size_t bytes = m.payloadSize() + sizeof(SynchronousHeader);
+
+	device_assert(bytes <= queue->size());
+
+	SynchronousHeader header;
+
+	header.type     = Synchronous;
+	header.threadId = threadIdx.x;
+	header.size     = bytes;
+	header.handler  = m.handler();
 
-	char* buffer = new char[bytes];
-	
-	SynchronousHeader* header = reinterpret_cast<SynchronousHeader*>(buffer);
-	
-	header->type     = Synchronous;
-	header->threadId = threadIdx.x;
-	header->size     = bytes;
-	header->handler  = m.handler();
-	
 	volatile bool* flag = new bool;
 	*flag = false;
 
-	header->address = (void*)flag;	
+	header.address = (void*)flag;
 
-	util::memcpy(buffer + sizeof(SynchronousHeader), m.payload(),
-		m.payloadSize());
-	 
 	device_report(" sending synchronous gpu->host message "
-		"(%d type, %d id, %d size, %d handler, %x flag)\n", Synchronous,	
-		header->threadId, bytes, m.handler(), header->address);
-	
-	while(!_deviceToHost->push(buffer, bytes));
+		"(%d type, %d id, %d size, %d handler, %x flag)\n", Synchronous,
+		header.threadId, (int)bytes, m.handler(), header.address);
+
+	size_t offset = 0;
+
+	while(!queue->reserve(bytes, offset));
+
+	queue->write(offset, &header, sizeof(SynchronousHeader));
+	queue->write(offset + sizeof(SynchronousHeader), m.payload(),
+		m.payloadSize());
+
+	queue->publish(offset, bytes);
 
 	device_report("  waiting for ack...\n");
-	
+
 	while(*flag == false);
 
 	device_report("   ...received ack\n");
-	
+
 	delete flag;
-	delete[] buffer;
 }
 
 __device__ void HostReflectionDevice::receive(Message& m)
@@ -258,33 +300,69 @@ __device__ bool HostReflectionDevice::DeviceQueue::push(const void* data,
 {
 	device_assert(size <= this->size());
 
-	if(size > _capacity()) return false;
-	
-	if(!_lock()) return false;	
+	size_t offset = 0;
 
-	device_report("pushing %d bytes into gpu->cpu queue.\n", (int)size);
+	if(!reserve(size, offset)) return false;
 
-	size_t end  = _metadata->size;
-	size_t head = _metadata->head;
+	write(offset, data, size);
+	publish(offset, size);
+
+	return true;
+}
+
+__device__ bool HostReflectionDevice::DeviceQueue::reserve(size_t size,
+	size_t& offset)
+{
+	while(true)
+	{
+		size_t head = _metadata->head;
+
+		// full, the host has not drained far enough yet
+		if(head + size > _metadata->tail + _metadata->size) return false;
+
+		if(atomicCAS((long long unsigned int*)&_metadata->head,
+			(long long unsigned int)head,
+			(long long unsigned int)(head + size)) == head)
+		{
+			offset = head;
+
+			return true;
+		}
+	}
+}
 
-	size_t remainder = end - head;
+__device__ void HostReflectionDevice::DeviceQueue::write(size_t offset,
+	const void* data, size_t size)
+{
+	size_t end   = _metadata->size;
+	size_t start = offset % end;
+
+	size_t remainder = end - start;
 	size_t firstCopy = min(remainder, size);
 
-	util::memcpy(_metadata->deviceBegin + head, data, firstCopy);
+	util::memcpy(_metadata->deviceBegin + start, data, firstCopy);
 
 	bool secondCopyNecessary = firstCopy != size;
 
 	size_t secondCopy = secondCopyNecessary ? size - firstCopy : 0;
-	
+
 	util::memcpy(_metadata->deviceBegin, (char*)data + firstCopy, secondCopy);
-	_metadata->head = secondCopyNecessary ? secondCopy : head + firstCopy;
-	
-	device_report(" after push (%d used, %d remaining, %d size)\n",
-		(int)_used(), (int)_capacity(), (int)this->size());
-	
-	_unlock();
-	
-	return true;
+}
+
+__device__ void HostReflectionDevice::DeviceQueue::publish(size_t offset,
+	size_t size)
+{
+	// earlier reservations publish first, so the host only ever sees a
+	// prefix of completely written messages
+	while(_metadata->ready != offset);
+
+	__threadfence_system();
+
+	_metadata->ready = offset + size;
+
+	device_report(" published %d bytes into gpu->cpu queue (%d used, "
+		"%d size)\n", (int)size,
+		(int)(_metadata->ready - _metadata->tail), (int)this->size());
 }
 
 __device__ bool HostReflectionDevice::DeviceQueue::pull(void* data, size_t size)
@@ -381,13 +459,24 @@ extern "C" __global__ void _bootupHostReflection(
 	HostReflectionDevice::QueueMetaData* deviceToHostMetadata)
 {
 	_hostToDevice = new HostReflectionDevice::DeviceQueue(hostToDeviceMetadata);
-	_deviceToHost = new HostReflectionDevice::DeviceQueue(deviceToHostMetadata);
+
+	for(unsigned int i = 0;
+		i < HostReflectionShared::DeviceToHostChannels; ++i)
+	{
+		_deviceToHost[i] = new HostReflectionDevice::DeviceQueue(
+			deviceToHostMetadata + i);
+	}
 }
 
 extern "C" __global__ void _teardownHostReflection()
 {
 	delete _hostToDevice;
-	delete _deviceToHost;
+
+	for(unsigned int i = 0;
+		i < HostReflectionShared::DeviceToHostChannels; ++i)
+	{
+		delete _deviceToHost[i];
+	}
 }
 
 }
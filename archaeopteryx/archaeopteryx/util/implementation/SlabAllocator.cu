@@ -0,0 +1,68 @@
+/*	\file   SlabAllocator.cu
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The source file for the SlabAllocator class.
+*/
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/SlabAllocator.h>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+__device__ SlabAllocator::SlabAllocator()
+: m_buffer(0), m_size(0), m_offset(0)
+{
+
+}
+
+__device__ void SlabAllocator::initialize(void* buffer, size_t bytes)
+{
+	m_buffer = reinterpret_cast<char*>(buffer);
+	m_size   = bytes;
+	m_offset = 0;
+}
+
+__device__ void* SlabAllocator::allocate(size_t bytes)
+{
+	if(m_buffer == 0) return 0;
+
+	unsigned long long aligned = (bytes + (Alignment - 1)) &
+		~((unsigned long long)(Alignment - 1));
+
+	unsigned long long offset = atomicAdd(&m_offset, aligned);
+
+	if(offset + aligned > m_size) return 0;
+
+	return m_buffer + offset;
+}
+
+__device__ bool SlabAllocator::owns(const void* address) const
+{
+	const char* pointer = reinterpret_cast<const char*>(address);
+
+	return pointer >= m_buffer && pointer < m_buffer + m_size;
+}
+
+__device__ void SlabAllocator::reset()
+{
+	m_offset = 0;
+}
+
+__device__ size_t SlabAllocator::capacity() const
+{
+	return m_size;
+}
+
+__device__ size_t SlabAllocator::used() const
+{
+	return m_offset < m_size ? m_offset : m_size;
+}
+
+}
+
+}
+
@@ -6,6 +6,8 @@
 
 // Archaeopteryx Includes
 #include <archaeopteryx/util/interface/cstring.h>
+#include <archaeopteryx/util/interface/IntTypes.h>
+#include <archaeopteryx/util/interface/StaticKnob.h>
 
 namespace archaeopteryx
 {
@@ -64,16 +66,132 @@ __device__ void* memcpy(void* s1, const void* s2, size_t n)
 	      unsigned char* p1 =       (unsigned char*)s1;
 	const unsigned char* p2 = (const unsigned char*)s2;
 
+	// most copies here relocate container storage, move whole words when
+	// both pointers share an alignment
+	if(((size_t)p1 & (sizeof(uint64_t) - 1)) ==
+		((size_t)p2 & (sizeof(uint64_t) - 1)))
+	{
+		while(n != 0 && ((size_t)p1 & (sizeof(uint64_t) - 1)) != 0)
+		{
+			*p1++ = *p2++;
+			--n;
+		}
+
+		      uint64_t* w1 = (uint64_t*)p1;
+		const uint64_t* w2 = (const uint64_t*)p2;
+
+		for(; n >= sizeof(uint64_t); n -= sizeof(uint64_t))
+		{
+			*w1++ = *w2++;
+		}
+
+		p1 = (unsigned char*)w1;
+		p2 = (const unsigned char*)w2;
+	}
+
 	while(n--)
 	{
 		*p1 = *p2;
 		++p1;
 		++p2;
 	}
-	
+
 	return p1;
 }
 
+__device__ void* memmove(void* s1, const void* s2, size_t n)
+{
+	if(s1 == s2 || n == 0) return s1;
+
+	// non overlapping regions take the wide forward loop
+	if((char*)s1 < (const char*)s2 || (const char*)s2 + n <= (char*)s1)
+	{
+		memcpy(s1, s2, n);
+
+		return s1;
+	}
+
+	      unsigned char* p1 =       (unsigned char*)s1 + n;
+	const unsigned char* p2 = (const unsigned char*)s2 + n;
+
+	while(n--)
+	{
+		*--p1 = *--p2;
+	}
+
+	return s1;
+}
+
+__device__ void* memcpyWarp(void* s1, const void* s2, size_t n)
+{
+	const unsigned int warpSize = StaticKnob<knobs::WarpSize>::value;
+
+	// a partial warp cannot split the work safely, every active lane
+	// performs the whole copy instead, writing the same bytes
+	if(__ballot(true) != 0xffffffffu)
+	{
+		return memcpy(s1, s2, n);
+	}
+
+	unsigned int lane = threadIdx.x & (warpSize - 1);
+
+	      unsigned char* p1 =       (unsigned char*)s1;
+	const unsigned char* p2 = (const unsigned char*)s2;
+
+	// interleaved words when everything is word aligned, bytes otherwise
+	if((((size_t)p1 | (size_t)p2 | n) & (sizeof(uint32_t) - 1)) == 0)
+	{
+		      uint32_t* w1 =       (uint32_t*)p1;
+		const uint32_t* w2 = (const uint32_t*)p2;
+
+		size_t words = n / sizeof(uint32_t);
+
+		for(size_t i = lane; i < words; i += warpSize)
+		{
+			w1[i] = w2[i];
+		}
+	}
+	else
+	{
+		for(size_t i = lane; i < n; i += warpSize)
+		{
+			p1[i] = p2[i];
+		}
+	}
+
+	return p1 + n;
+}
+
+__device__ int strcmpWarp(const char* left, const char* right)
+{
+	const unsigned int warpSize = StaticKnob<knobs::WarpSize>::value;
+
+	if(__ballot(true) != 0xffffffffu)
+	{
+		return strcmp(left, right);
+	}
+
+	unsigned int lane = threadIdx.x & (warpSize - 1);
+
+	for(size_t base = 0; ; base += warpSize)
+	{
+		char l = left[base + lane];
+		char r = right[base + lane];
+
+		unsigned int mismatches = __ballot(l != r);
+		unsigned int ends       = __ballot(l == '\0');
+
+		// a mismatch only counts when it comes before the terminator
+		if(mismatches != 0 &&
+			(ends == 0 || __ffs(mismatches) <= __ffs(ends)))
+		{
+			return -1;
+		}
+
+		if(ends != 0) return 0;
+	}
+}
+
 __device__ size_t strlen(const char* s)
 {
 	size_t size = 0;
@@ -86,12 +204,33 @@ __device__ size_t strlen(const char* s)
 __device__ void* memset(void* s, int c, size_t n)
 {
 	unsigned char* p1 = (unsigned char*)s;
-	
-	for(unsigned int i = 0; i < n; ++i, ++p1)
+
+	uint64_t word = (unsigned char)c;
+
+	word |= word << 8;
+	word |= word << 16;
+	word |= word << 32;
+
+	while(n != 0 && ((size_t)p1 & (sizeof(uint64_t) - 1)) != 0)
+	{
+		*p1++ = c;
+		--n;
+	}
+
+	uint64_t* w1 = (uint64_t*)p1;
+
+	for(; n >= sizeof(uint64_t); n -= sizeof(uint64_t))
+	{
+		*w1++ = word;
+	}
+
+	p1 = (unsigned char*)w1;
+
+	for(; n != 0; --n, ++p1)
 	{
 		*p1 = c;
 	}
-	
+
 	return p1;
 }
 
@@ -0,0 +1,702 @@
+/*	\file   BTree.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the btree_map class
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/utility.h>
+#include <archaeopteryx/util/interface/functional.h>
+#include <archaeopteryx/util/interface/cstring.h>
+#include <archaeopteryx/util/interface/vector.h>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! \brief A B+-tree backed map for device code.
+
+	The red black tree behind util::map chases one pointer per element,
+	which is the worst possible access pattern for a GPU.  This container
+	packs several elements into each node, sized to fill a 128 byte cache
+	line, so a lookup touches a handful of lines instead of one line per
+	element.  All of the values live in the leaves, which are linked
+	together for iteration.
+
+	It keeps the common part of the map interface.  Deletion is lazy:
+	empty leaves are unlinked immediately but interior nodes are never
+	rebalanced.  Keys must be default constructible, mapped types need
+	only be copy constructible.
+*/
+template <class _Key, class _Tp, class _Compare = less<_Key> >
+class btree_map
+{
+public:
+	typedef _Key     key_type;
+	typedef _Tp      mapped_type;
+	typedef _Compare key_compare;
+	typedef pair<_Key, _Tp> value_type;
+	typedef size_t size_type;
+
+public:
+	/*! \brief Nodes are sized to fill one of these */
+	static const size_type TargetNodeBytes = 128;
+
+	static const size_type LeafValues =
+		TargetNodeBytes / sizeof(value_type) < 2 ?
+		2 : TargetNodeBytes / sizeof(value_type);
+
+	static const size_type InternalKeys =
+		TargetNodeBytes / (sizeof(_Key) + sizeof(void*)) < 4 ?
+		4 : TargetNodeBytes / (sizeof(_Key) + sizeof(void*));
+
+private:
+	class Internal;
+
+	class Node
+	{
+	public:
+		bool      leaf;
+		size_type count;
+		Internal* parent;
+	};
+
+	class Leaf : public Node
+	{
+	public:
+		Leaf* next;
+		Leaf* previous;
+
+	public:
+		__device__ value_type* values()
+		{
+			return reinterpret_cast<value_type*>(_storage);
+		}
+
+	private:
+		/*! raw storage, the values are constructed in place so that
+			mapped types without default constructors can be stored */
+		union
+		{
+			char      _storage[sizeof(value_type) * LeafValues];
+			long long _alignment;
+		};
+	};
+
+	class Internal : public Node
+	{
+	public:
+		/*! keys[i] separates children[i] (smaller) from
+			children[i + 1] (greater or equal) */
+		_Key  keys[InternalKeys];
+		Node* children[InternalKeys + 1];
+	};
+
+public:
+	class iterator
+	{
+	public:
+		__device__ iterator()
+		: _tree(0), _leaf(0), _index(0)
+		{
+		}
+
+		__device__ iterator(const btree_map* tree, Leaf* leaf,
+			size_type index)
+		: _tree(tree), _leaf(leaf), _index(index)
+		{
+		}
+
+	public:
+		__device__ value_type& operator*() const
+		{
+			return _leaf->values()[_index];
+		}
+
+		__device__ value_type* operator->() const
+		{
+			return _leaf->values() + _index;
+		}
+
+		__device__ iterator& operator++()
+		{
+			if(++_index == _leaf->count)
+			{
+				_leaf  = _leaf->next;
+				_index = 0;
+			}
+
+			return *this;
+		}
+
+		__device__ iterator operator++(int)
+		{
+			iterator previous(*this);
+
+			++*this;
+
+			return previous;
+		}
+
+		__device__ iterator& operator--()
+		{
+			if(_leaf == 0)
+			{
+				_leaf  = _tree->_tail;
+				_index = _leaf->count - 1;
+			}
+			else if(_index == 0)
+			{
+				_leaf  = _leaf->previous;
+				_index = _leaf->count - 1;
+			}
+			else
+			{
+				--_index;
+			}
+
+			return *this;
+		}
+
+		__device__ iterator operator--(int)
+		{
+			iterator next(*this);
+
+			--*this;
+
+			return next;
+		}
+
+	public:
+		__device__ bool operator==(const iterator& right) const
+		{
+			return _leaf == right._leaf && _index == right._index;
+		}
+
+		__device__ bool operator!=(const iterator& right) const
+		{
+			return !(*this == right);
+		}
+
+	private:
+		const btree_map* _tree;
+		Leaf*            _leaf;
+		size_type        _index;
+
+	private:
+		friend class btree_map;
+	};
+
+	typedef iterator const_iterator;
+
+public:
+	__device__ btree_map()
+	: _head(_newLeaf()), _size(0)
+	{
+		_root = _head;
+		_tail = _head;
+	}
+
+	__device__ ~btree_map()
+	{
+		_destroyNode(_root);
+	}
+
+public:
+	__device__ iterator begin()
+	{
+		if(_size == 0) return end();
+
+		return iterator(this, _head, 0);
+	}
+
+	__device__ iterator end()
+	{
+		return iterator(this, 0, 0);
+	}
+
+public:
+	__device__ size_type size() const
+	{
+		return _size;
+	}
+
+	__device__ bool empty() const
+	{
+		return _size == 0;
+	}
+
+public:
+	__device__ iterator lower_bound(const key_type& key)
+	{
+		if(_size == 0) return end();
+
+		Leaf* leaf = _findLeaf(key);
+
+		for(size_type i = 0; i < leaf->count; ++i)
+		{
+			if(!_compare(leaf->values()[i].first, key))
+			{
+				return iterator(this, leaf, i);
+			}
+		}
+
+		// everything in this leaf is smaller, the successor leads the
+		// next leaf
+		if(leaf->next == 0) return end();
+
+		return iterator(this, leaf->next, 0);
+	}
+
+	__device__ iterator find(const key_type& key)
+	{
+		iterator position = lower_bound(key);
+
+		if(position == end())            return end();
+		if(_compare(key, position->first)) return end();
+
+		return position;
+	}
+
+public:
+	__device__ pair<iterator, bool> insert(const value_type& value)
+	{
+		Leaf* leaf = _findLeaf(value.first);
+
+		size_type position = _leafPosition(leaf, value.first);
+
+		if(position < leaf->count &&
+			!_compare(value.first, leaf->values()[position].first))
+		{
+			return make_pair(iterator(this, leaf, position), false);
+		}
+
+		if(leaf->count == LeafValues)
+		{
+			leaf     = _splitLeaf(leaf, value.first);
+			position = _leafPosition(leaf, value.first);
+		}
+
+		// shift the tail up one slot, the values are relocated bitwise
+		for(size_type i = leaf->count; i > position; --i)
+		{
+			memcpy(leaf->values() + i, leaf->values() + i - 1,
+				sizeof(value_type));
+		}
+
+		::new((void*)(leaf->values() + position)) value_type(value);
+
+		++leaf->count;
+		++_size;
+
+		return make_pair(iterator(this, leaf, position), true);
+	}
+
+	__device__ void erase(iterator position)
+	{
+		Leaf* leaf = position._leaf;
+
+		leaf->values()[position._index].~value_type();
+
+		for(size_type i = position._index; i + 1 < leaf->count; ++i)
+		{
+			memcpy(leaf->values() + i, leaf->values() + i + 1,
+				sizeof(value_type));
+		}
+
+		--leaf->count;
+		--_size;
+
+		// empty leaves are unlinked immediately, interior nodes are left
+		// underfull rather than rebalanced
+		if(leaf->count == 0 && leaf->parent != 0)
+		{
+			if(leaf->previous != 0) leaf->previous->next = leaf->next;
+			else                    _head = leaf->next;
+
+			if(leaf->next != 0) leaf->next->previous = leaf->previous;
+			else                _tail = leaf->previous;
+
+			_removeFromParent(leaf);
+
+			delete leaf;
+		}
+	}
+
+	__device__ size_type erase(const key_type& key)
+	{
+		iterator position = find(key);
+
+		if(position == end()) return 0;
+
+		erase(position);
+
+		return 1;
+	}
+
+	__device__ void clear()
+	{
+		_destroyNode(_root);
+
+		_head = _newLeaf();
+		_root = _head;
+		_tail = _head;
+		_size = 0;
+	}
+
+public:
+	/*! \brief Build the tree from a sorted sequence in one batched pass,
+		filling the leaves completely instead of splitting on the way
+		up */
+	template <class _Iterator>
+	__device__ void assign(_Iterator first, _Iterator last)
+	{
+		clear();
+
+		// fill the leaf level left to right
+		for(; first != last; ++first)
+		{
+			Leaf* leaf = _tail;
+
+			if(leaf->count == LeafValues)
+			{
+				Leaf* fresh = _newLeaf();
+
+				fresh->previous = leaf;
+				leaf->next      = fresh;
+				_tail           = fresh;
+
+				leaf = fresh;
+			}
+
+			::new((void*)(leaf->values() + leaf->count))
+				value_type(*first);
+
+			++leaf->count;
+			++_size;
+		}
+
+		if(_head == _tail) return;
+
+		// build each internal level on top of the one below
+		vector<Node*> level;
+
+		for(Leaf* leaf = _head; leaf != 0; leaf = leaf->next)
+		{
+			level.push_back(leaf);
+		}
+
+		while(level.size() > 1)
+		{
+			vector<Node*> next;
+
+			size_type position = 0;
+
+			while(position < level.size())
+			{
+				size_type remaining = level.size() - position;
+
+				size_type children = remaining > InternalKeys + 1 ?
+					InternalKeys + 1 : remaining;
+
+				// never leave a single orphan child for the next node
+				if(remaining == children + 1) --children;
+
+				Internal* node = _newInternal();
+
+				node->count = children - 1;
+
+				for(size_type i = 0; i < children; ++i)
+				{
+					node->children[i] = level[position + i];
+					node->children[i]->parent = node;
+
+					if(i > 0)
+					{
+						node->keys[i - 1] =
+							_firstKey(level[position + i]);
+					}
+				}
+
+				next.push_back(node);
+
+				position += children;
+			}
+
+			level = next;
+		}
+
+		_root = level[0];
+		_root->parent = 0;
+	}
+
+private:
+	__device__ Leaf* _newLeaf()
+	{
+		Leaf* leaf = new Leaf;
+
+		leaf->leaf     = true;
+		leaf->count    = 0;
+		leaf->parent   = 0;
+		leaf->next     = 0;
+		leaf->previous = 0;
+
+		return leaf;
+	}
+
+	__device__ Internal* _newInternal()
+	{
+		Internal* node = new Internal;
+
+		node->leaf   = false;
+		node->count  = 0;
+		node->parent = 0;
+
+		return node;
+	}
+
+	__device__ void _destroyNode(Node* node)
+	{
+		if(node->leaf)
+		{
+			Leaf* leaf = static_cast<Leaf*>(node);
+
+			for(size_type i = 0; i < leaf->count; ++i)
+			{
+				leaf->values()[i].~value_type();
+			}
+
+			delete leaf;
+
+			return;
+		}
+
+		Internal* internal = static_cast<Internal*>(node);
+
+		for(size_type i = 0; i <= internal->count; ++i)
+		{
+			_destroyNode(internal->children[i]);
+		}
+
+		delete internal;
+	}
+
+	__device__ Leaf* _findLeaf(const key_type& key) const
+	{
+		Node* node = _root;
+
+		while(!node->leaf)
+		{
+			Internal* internal = static_cast<Internal*>(node);
+
+			size_type i = 0;
+
+			while(i < internal->count &&
+				!_compare(key, internal->keys[i]))
+			{
+				++i;
+			}
+
+			node = internal->children[i];
+		}
+
+		return static_cast<Leaf*>(node);
+	}
+
+	__device__ size_type _leafPosition(Leaf* leaf, const key_type& key)
+	{
+		size_type position = 0;
+
+		while(position < leaf->count &&
+			_compare(leaf->values()[position].first, key))
+		{
+			++position;
+		}
+
+		return position;
+	}
+
+	/*! split a full leaf, returning the half that should hold key */
+	__device__ Leaf* _splitLeaf(Leaf* leaf, const key_type& key)
+	{
+		Leaf* right = _newLeaf();
+
+		size_type half = leaf->count / 2;
+
+		memcpy(right->values(), leaf->values() + half,
+			sizeof(value_type) * (leaf->count - half));
+
+		right->count = leaf->count - half;
+		leaf->count  = half;
+
+		right->next     = leaf->next;
+		right->previous = leaf;
+
+		if(leaf->next != 0) leaf->next->previous = right;
+		else                _tail = right;
+
+		leaf->next = right;
+
+		_insertIntoParent(leaf, right->values()[0].first, right);
+
+		return _compare(key, right->values()[0].first) ? leaf : right;
+	}
+
+	__device__ void _insertIntoParent(Node* left,
+		const key_type& separator, Node* right)
+	{
+		if(left->parent == 0)
+		{
+			Internal* root = _newInternal();
+
+			root->count       = 1;
+			root->keys[0]     = separator;
+			root->children[0] = left;
+			root->children[1] = right;
+
+			left->parent  = root;
+			right->parent = root;
+
+			_root = root;
+
+			return;
+		}
+
+		Internal* parent = left->parent;
+
+		if(parent->count == InternalKeys)
+		{
+			// split the parent, promoting its middle separator
+			Internal* sibling = _newInternal();
+
+			size_type middle = parent->count / 2;
+
+			key_type promoted = parent->keys[middle];
+
+			sibling->count = parent->count - middle - 1;
+
+			for(size_type i = 0; i < sibling->count; ++i)
+			{
+				sibling->keys[i] = parent->keys[middle + 1 + i];
+			}
+
+			for(size_type i = 0; i <= sibling->count; ++i)
+			{
+				sibling->children[i] = parent->children[middle + 1 + i];
+				sibling->children[i]->parent = sibling;
+			}
+
+			parent->count = middle;
+
+			_insertIntoParent(parent, promoted, sibling);
+
+			if(!_compare(separator, promoted))
+			{
+				parent = sibling;
+			}
+		}
+
+		size_type position = 0;
+
+		while(position < parent->count &&
+			!_compare(separator, parent->keys[position]))
+		{
+			++position;
+		}
+
+		for(size_type i = parent->count; i > position; --i)
+		{
+			parent->keys[i]         = parent->keys[i - 1];
+			parent->children[i + 1] = parent->children[i];
+		}
+
+		parent->keys[position]         = separator;
+		parent->children[position + 1] = right;
+
+		right->parent = parent;
+
+		++parent->count;
+	}
+
+	__device__ void _removeFromParent(Node* child)
+	{
+		Internal* parent = child->parent;
+
+		size_type position = 0;
+
+		while(parent->children[position] != child) ++position;
+
+		// removing child i drops separator i - 1 (or 0 for the first
+		// child), the neighbor's range simply widens
+		size_type keyPosition = position == 0 ? 0 : position - 1;
+
+		for(size_type i = keyPosition; i + 1 < parent->count; ++i)
+		{
+			parent->keys[i] = parent->keys[i + 1];
+		}
+
+		for(size_type i = position; i + 1 <= parent->count; ++i)
+		{
+			parent->children[i] = parent->children[i + 1];
+		}
+
+		--parent->count;
+
+		if(parent->count == 0)
+		{
+			// a single child remains, it splices into the parent's place
+			Node* survivor = parent->children[0];
+
+			if(parent->parent == 0)
+			{
+				_root = survivor;
+
+				survivor->parent = 0;
+			}
+			else
+			{
+				Internal* grandparent = parent->parent;
+
+				size_type i = 0;
+
+				while(grandparent->children[i] != parent) ++i;
+
+				grandparent->children[i] = survivor;
+
+				survivor->parent = grandparent;
+			}
+
+			delete parent;
+		}
+	}
+
+	__device__ const key_type& _firstKey(Node* node)
+	{
+		while(!node->leaf)
+		{
+			node = static_cast<Internal*>(node)->children[0];
+		}
+
+		return static_cast<Leaf*>(node)->values()[0].first;
+	}
+
+private:
+	/*! not implemented, the tree is not copyable */
+	__device__ btree_map(const btree_map&);
+	__device__ btree_map& operator=(const btree_map&);
+
+private:
+	Node*       _root;
+	Leaf*       _head;
+	Leaf*       _tail;
+	size_type   _size;
+	key_compare _compare;
+};
+
+}
+
+}
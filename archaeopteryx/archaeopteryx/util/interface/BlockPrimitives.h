@@ -0,0 +1,156 @@
+/*	\file   BlockPrimitives.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for block cooperative scan and sort primitives
+*/
+
+#pragma once
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! Every thread of the block must call these convergently, they
+	synchronize internally with __syncthreads.  The caller supplies the
+	scratch storage, normally a shared memory buffer, in the same way the
+	fetch unit receives its cache. */
+
+/*! \brief Exclusive scan of one value per thread
+
+	Returns the sum of the values of the lower thread ids, and the block
+	total through the output parameter.  storage must hold blockDim.x
+	values and is free for reuse on return.
+*/
+inline __device__ unsigned int blockExclusiveScan(unsigned int value,
+	unsigned int* storage, unsigned int& total)
+{
+	unsigned int id = threadIdx.x;
+
+	storage[id] = value;
+
+	__syncthreads();
+
+	// Hillis-Steele, log2(blockDim.x) rounds
+	for(unsigned int offset = 1; offset < blockDim.x; offset <<= 1)
+	{
+		unsigned int partial = 0;
+
+		if(id >= offset) partial = storage[id - offset];
+
+		__syncthreads();
+
+		storage[id] += partial;
+
+		__syncthreads();
+	}
+
+	unsigned int inclusive = storage[id];
+
+	total = storage[blockDim.x - 1];
+
+	__syncthreads();
+
+	return inclusive - value;
+}
+
+/*! \brief Stable least significant digit radix sort of count key value
+	pairs, one element per thread
+
+	count must not exceed blockDim.x.  keys and values live in caller
+	supplied storage along with equally sized key and value buffers and a
+	blockDim.x entry scan scratch array.  One split pass is made per bit,
+	pass sizeof(Key) * 8 bits to sort on the full key, fewer when the
+	keys are known to be small.
+*/
+template <typename Key, typename Value>
+__device__ void blockRadixSortPairs(Key* keys, Value* values,
+	Key* keyBuffer, Value* valueBuffer, unsigned int* storage,
+	unsigned int count, unsigned int bits)
+{
+	unsigned int id = threadIdx.x;
+
+	for(unsigned int bit = 0; bit < bits; ++bit)
+	{
+		Key   key   = Key();
+		Value value = Value();
+
+		if(id < count)
+		{
+			key   = keys[id];
+			value = values[id];
+		}
+
+		unsigned int flag =
+			id < count && ((key >> bit) & 1) == 0 ? 1 : 0;
+
+		unsigned int zeros = 0;
+
+		unsigned int zerosBefore = blockExclusiveScan(flag, storage,
+			zeros);
+
+		if(id < count)
+		{
+			// zeros keep their order in front and ones follow, id -
+			// zerosBefore counts the ones below this thread
+			unsigned int position = flag != 0 ?
+				zerosBefore : zeros + (id - zerosBefore);
+
+			keyBuffer[position]   = key;
+			valueBuffer[position] = value;
+		}
+
+		__syncthreads();
+
+		if(id < count)
+		{
+			keys[id]   = keyBuffer[id];
+			values[id] = valueBuffer[id];
+		}
+
+		__syncthreads();
+	}
+}
+
+/*! \brief Stable least significant digit radix sort of count keys, one
+	element per thread, see blockRadixSortPairs */
+template <typename Key>
+__device__ void blockRadixSortKeys(Key* keys, Key* keyBuffer,
+	unsigned int* storage, unsigned int count, unsigned int bits)
+{
+	unsigned int id = threadIdx.x;
+
+	for(unsigned int bit = 0; bit < bits; ++bit)
+	{
+		Key key = Key();
+
+		if(id < count) key = keys[id];
+
+		unsigned int flag =
+			id < count && ((key >> bit) & 1) == 0 ? 1 : 0;
+
+		unsigned int zeros = 0;
+
+		unsigned int zerosBefore = blockExclusiveScan(flag, storage,
+			zeros);
+
+		if(id < count)
+		{
+			unsigned int position = flag != 0 ?
+				zerosBefore : zeros + (id - zerosBefore);
+
+			keyBuffer[position] = key;
+		}
+
+		__syncthreads();
+
+		if(id < count) keys[id] = keyBuffer[id];
+
+		__syncthreads();
+	}
+}
+
+}
+
+}
@@ -32,12 +32,41 @@ public:
 	/*! \brief Read data from the file at the current offset into a buffer */
 	__device__ void read(void* data, size_t size);
 
+	/*! \brief One segment of a scatter/gather bulk transfer */
+	class ReadDescriptor
+	{
+	public:
+		/*! \brief The byte offset of the segment in the file */
+		size_t offset;
+		/*! \brief The number of bytes to read */
+		size_t size;
+		/*! \brief The destination of the segment */
+		void*  data;
+	};
+
+	/*! \brief Read a list of segments with one host round trip per batch,
+		the host copies each segment directly into its destination.  The
+		get pointer is not moved. */
+	__device__ void readBulk(const ReadDescriptor* descriptors,
+		size_t count);
+
 	/*! \brief Try to write data into the file, return the bytes written */
 	__device__ size_t writeSome(const void* data, size_t size);
 
 	/*! \brief Try to read from the file, return the bytes read */
 	__device__ size_t readSome(void* data, size_t size);
 
+	/*! \brief Issue a read at the current offset without waiting for the
+		data, it is claimed later with finishRead.  Returns the bytes
+		actually requested.  The replies arrive in issue order, so no
+		other read may touch the file until the in-flight read is
+		finished. */
+	__device__ size_t startRead(size_t size);
+
+	/*! \brief Wait for the data of a startRead and copy it out, size must
+		be the value that startRead returned */
+	__device__ void finishRead(void* data, size_t size);
+
 	/*! \brief Delete the file */
 	__device__ void remove();
 
@@ -180,6 +209,32 @@ private:
 		Payload _payload;
 	};
 
+	class BulkReadMessage : public HostReflectionDevice::Message
+	{
+	public:
+		__device__ BulkReadMessage(const ReadDescriptor* descriptors,
+			size_t count, void* flag, Handle handle);
+		__device__ ~BulkReadMessage();
+
+	public:
+		__device__ virtual void* payload() const;
+		__device__ virtual size_t payloadSize() const;
+		__device__ virtual HostReflectionDevice::HandlerId handler() const;
+
+	private:
+		class Header
+		{
+		public:
+			size_t count;
+			void*  flag;
+			Handle handle;
+		};
+
+	private:
+		char*  _data;
+		size_t _size;
+	};
+
 	class ReadReply : public HostReflectionDevice::Message
 	{
 	public:
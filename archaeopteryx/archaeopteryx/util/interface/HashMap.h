@@ -0,0 +1,409 @@
+/*	\file   HashMap.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the hash_map class
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/utility.h>
+#include <archaeopteryx/util/interface/cstring.h>
+#include <archaeopteryx/util/interface/string.h>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! \brief The default hash, it mixes the bits of an integral key */
+template <class _Key>
+class hash
+{
+public:
+	__device__ size_t operator()(const _Key& key) const
+	{
+		size_t value = (size_t)key;
+
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdULL;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ULL;
+		value ^= value >> 33;
+
+		return value;
+	}
+};
+
+/*! \brief FNV-1a over the characters, the same hash that the symbol index
+	in the binary format uses */
+template <>
+class hash<string>
+{
+public:
+	__device__ size_t operator()(const string& key) const
+	{
+		size_t value = 2166136261u;
+
+		for(const char* c = key.c_str(); *c != '\0'; ++c)
+		{
+			value ^= (size_t)(unsigned char)*c;
+			value *= 16777619u;
+		}
+
+		return value;
+	}
+};
+
+/*! \brief An open addressing hash map for device code.
+
+	Slots live in one flat power of two sized array and a lookup probes
+	linearly from the masked hash, so the entire search usually touches a
+	single cache line instead of one line per tree node like util::map.
+	Erased slots leave tombstones behind, the table is rebuilt when it
+	reaches two thirds occupancy.  Keys need operator==, mapped types need
+	only be copy constructible.
+*/
+template <class _Key, class _Tp, class _Hash = hash<_Key> >
+class hash_map
+{
+public:
+	typedef _Key   key_type;
+	typedef _Tp    mapped_type;
+	typedef _Hash  hasher;
+	typedef pair<_Key, _Tp> value_type;
+	typedef size_t size_type;
+
+public:
+	/*! \brief The initial slot count of the first insertion */
+	static const size_type InitialSlots = 16;
+	/*! \brief Lanes cooperating in a findWarp probe window */
+	static const size_type WarpWidth = 32;
+
+private:
+	enum SlotState
+	{
+		EmptySlot    = 0,
+		OccupiedSlot = 1,
+		DeletedSlot  = 2
+	};
+
+public:
+	class iterator
+	{
+	public:
+		__device__ iterator()
+		: _map(0), _slot(0)
+		{
+		}
+
+		__device__ iterator(const hash_map* map, size_type slot)
+		: _map(map), _slot(slot)
+		{
+		}
+
+	public:
+		__device__ value_type& operator*() const
+		{
+			return _map->_values[_slot];
+		}
+
+		__device__ value_type* operator->() const
+		{
+			return _map->_values + _slot;
+		}
+
+		__device__ iterator& operator++()
+		{
+			++_slot;
+
+			while(_slot < _map->_capacity &&
+				_map->_states[_slot] != OccupiedSlot)
+			{
+				++_slot;
+			}
+
+			return *this;
+		}
+
+		__device__ iterator operator++(int)
+		{
+			iterator previous(*this);
+
+			++*this;
+
+			return previous;
+		}
+
+	public:
+		__device__ bool operator==(const iterator& right) const
+		{
+			return _slot == right._slot;
+		}
+
+		__device__ bool operator!=(const iterator& right) const
+		{
+			return !(*this == right);
+		}
+
+	private:
+		const hash_map* _map;
+		size_type       _slot;
+
+	private:
+		friend class hash_map;
+	};
+
+	typedef iterator const_iterator;
+
+public:
+	__device__ hash_map()
+	: _states(0), _values(0), _capacity(0), _size(0), _occupied(0)
+	{
+	}
+
+	__device__ ~hash_map()
+	{
+		clear();
+
+		delete[] _states;
+		delete[] reinterpret_cast<char*>(_values);
+	}
+
+public:
+	__device__ iterator begin()
+	{
+		size_type slot = 0;
+
+		while(slot < _capacity && _states[slot] != OccupiedSlot) ++slot;
+
+		return iterator(this, slot);
+	}
+
+	__device__ iterator end()
+	{
+		return iterator(this, _capacity);
+	}
+
+public:
+	__device__ size_type size() const
+	{
+		return _size;
+	}
+
+	__device__ bool empty() const
+	{
+		return _size == 0;
+	}
+
+public:
+	__device__ iterator find(const key_type& key)
+	{
+		if(_size == 0) return end();
+
+		for(size_type slot = _hash(key) & (_capacity - 1); ;
+			slot = (slot + 1) & (_capacity - 1))
+		{
+			if(_states[slot] == EmptySlot) return end();
+			if(_states[slot] == DeletedSlot) continue;
+
+			if(_values[slot].first == key)
+			{
+				return iterator(this, slot);
+			}
+		}
+	}
+
+	/*! \brief Warp cooperative lookup, every active lane calls with the
+		same key.  Each lane probes one slot of a WarpWidth wide window so
+		a whole probe sequence costs one coalesced load per window.  All
+		callers receive the same result. */
+	__device__ iterator findWarp(const key_type& key)
+	{
+		if(_size == 0) return end();
+
+		unsigned int lane = threadIdx.x & (WarpWidth - 1);
+
+		size_type start = _hash(key) & (_capacity - 1);
+
+		for(size_type window = 0; window < _capacity;
+			window += WarpWidth)
+		{
+			size_type slot = (start + window + lane) & (_capacity - 1);
+
+			bool hit = _states[slot] == OccupiedSlot &&
+				_values[slot].first == key;
+
+			unsigned int hits    = __ballot(hit);
+			unsigned int empties = __ballot(_states[slot] == EmptySlot);
+
+			// the probe ends at the first empty slot, a hit counts only
+			// if it comes first in probe order
+			if(hits != 0 &&
+				(empties == 0 || __ffs(hits) < __ffs(empties)))
+			{
+				return iterator(this,
+					(start + window + __ffs(hits) - 1) &
+					(_capacity - 1));
+			}
+
+			if(empties != 0) return end();
+		}
+
+		return end();
+	}
+
+public:
+	__device__ pair<iterator, bool> insert(const value_type& value)
+	{
+		// rebuild before the table passes two thirds occupancy
+		if((_occupied + 1) * 3 >= _capacity * 2) _grow();
+
+		size_type target  = _capacity;
+		bool      reused  = false;
+
+		for(size_type slot = _hash(value.first) & (_capacity - 1); ;
+			slot = (slot + 1) & (_capacity - 1))
+		{
+			if(_states[slot] == OccupiedSlot)
+			{
+				if(_values[slot].first == value.first)
+				{
+					return make_pair(iterator(this, slot), false);
+				}
+
+				continue;
+			}
+
+			if(_states[slot] == DeletedSlot)
+			{
+				// remember the first tombstone, but keep probing in
+				// case the key lives further along
+				if(target == _capacity)
+				{
+					target = slot;
+					reused = true;
+				}
+
+				continue;
+			}
+
+			if(target == _capacity) target = slot;
+
+			break;
+		}
+
+		::new((void*)(_values + target)) value_type(value);
+
+		_states[target] = OccupiedSlot;
+
+		++_size;
+
+		if(!reused) ++_occupied;
+
+		return make_pair(iterator(this, target), true);
+	}
+
+	__device__ mapped_type& operator[](const key_type& key)
+	{
+		return insert(make_pair(key, mapped_type())).first->second;
+	}
+
+	__device__ void erase(iterator position)
+	{
+		_values[position._slot].~value_type();
+
+		_states[position._slot] = DeletedSlot;
+
+		--_size;
+	}
+
+	__device__ size_type erase(const key_type& key)
+	{
+		iterator position = find(key);
+
+		if(position == end()) return 0;
+
+		erase(position);
+
+		return 1;
+	}
+
+	__device__ void clear()
+	{
+		for(size_type slot = 0; slot < _capacity; ++slot)
+		{
+			if(_states[slot] == OccupiedSlot)
+			{
+				_values[slot].~value_type();
+			}
+
+			_states[slot] = EmptySlot;
+		}
+
+		_size     = 0;
+		_occupied = 0;
+	}
+
+private:
+	/*! \brief Double the table and reinsert, dropping the tombstones */
+	__device__ void _grow()
+	{
+		size_type capacity = _capacity == 0 ?
+			InitialSlots : _capacity * 2;
+
+		unsigned char* states = new unsigned char[capacity];
+		value_type*    values = reinterpret_cast<value_type*>(
+			new char[sizeof(value_type) * capacity]);
+
+		for(size_type slot = 0; slot < capacity; ++slot)
+		{
+			states[slot] = EmptySlot;
+		}
+
+		for(size_type slot = 0; slot < _capacity; ++slot)
+		{
+			if(_states[slot] != OccupiedSlot) continue;
+
+			size_type target =
+				_hash(_values[slot].first) & (capacity - 1);
+
+			while(states[target] != EmptySlot)
+			{
+				target = (target + 1) & (capacity - 1);
+			}
+
+			// the values are relocated bitwise
+			memcpy(values + target, _values + slot,
+				sizeof(value_type));
+
+			states[target] = OccupiedSlot;
+		}
+
+		delete[] _states;
+		delete[] reinterpret_cast<char*>(_values);
+
+		_states   = states;
+		_values   = values;
+		_capacity = capacity;
+		_occupied = _size;
+	}
+
+private:
+	/*! not implemented, the table is not copyable */
+	__device__ hash_map(const hash_map&);
+	__device__ hash_map& operator=(const hash_map&);
+
+private:
+	unsigned char* _states;
+	value_type*    _values;
+	size_type      _capacity;
+	size_type      _size;
+	size_type      _occupied;
+	hasher         _hash;
+};
+
+}
+
+}
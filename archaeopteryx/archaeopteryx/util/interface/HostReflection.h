@@ -25,7 +25,11 @@ public:
 	typedef unsigned int HandlerId;
 	
 	static const size_t MaxMessageSize = 16384;
-	
+
+	/*! The number of independent device-to-host rings, blocks hash onto
+		them so that senders in different blocks do not contend */
+	static const size_t DeviceToHostChannels = 8;
+
 	enum MessageHandler
 	{
 		OpenFileMessageHandler     = 0,
@@ -35,6 +39,8 @@ public:
 		FileReadMessageHandler     = 3,
 		FileReadReplyHandler       = 3,
 		KernelLaunchMessageHandler = 4,
+		SimulationStatisticsMessageHandler = 5,
+		BulkFileReadMessageHandler = 6,
 		InvalidMessageHandler      = -1
 	};
 
@@ -82,8 +88,15 @@ public:
 		char*  deviceBegin;
 
 		size_t size;
+		/*! In the device-to-host direction head, ready, and tail are
+			monotonic byte counters (position modulo size): head is the
+			reservation cursor bumped with an atomic, ready marks the end
+			of the fully written prefix, and tail is advanced by the host
+			after draining.  The host-to-device direction keeps head and
+			tail as wrapped offsets guarded by the mutex. */
 		size_t head;
 		size_t tail;
+		size_t ready;
 		size_t mutex;
 	};
 
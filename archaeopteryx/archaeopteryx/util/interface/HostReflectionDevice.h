@@ -46,6 +46,10 @@ public:
 public:
 	__device__ static void sendAsynchronous(const Message& m);
 	__device__ static void sendSynchronous(const Message& m);
+	/*! Send several asynchronous messages back to back with a single
+		queue reservation and a single publication */
+	__device__ static void sendBulk(const Message* const* messages,
+		unsigned int count);
 	__device__ static void receive(Message& m);
 
 public:
@@ -85,20 +89,30 @@ public:
 		__device__ ~DeviceQueue();
 
 	public:
+		/*! Lock-free device-to-host producer interface.  reserve bumps
+			the shared head with an atomic, write fills the reserved
+			range, and publish hands it to the host once every earlier
+			reservation is published, so nothing is held across the
+			copy. */
 		__device__ bool push(const void* data, size_t size);
+		__device__ bool reserve(size_t size, size_t& offset);
+		__device__ void write(size_t offset, const void* data, size_t size);
+		__device__ void publish(size_t offset, size_t size);
+
+		/*! Locked host-to-device consumer interface */
 		__device__ bool pull(void* data, size_t size);
 
 	public:
 		__device__ bool peek();
 		__device__ size_t size() const;
-	
+
 	private:
 		volatile QueueMetaData* _metadata;
-		
+
 	private:
 		__device__ size_t _capacity() const;
 		__device__ size_t _used() const;
-		
+
 	private:
 		__device__ bool _lock();
 		__device__ void _unlock();
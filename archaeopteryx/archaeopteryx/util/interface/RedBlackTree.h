@@ -1109,7 +1109,7 @@ RedBlackTree<_Tp, _Compare, _Allocator>::swap(RedBlackTree& __t)
 {
     using util::swap;
     swap(__begin_node_, __t.__begin_node_);
-    swap(__pair1_.first(), __t.__pair1_.first());
+    swap(__pair1_.first, __t.__pair1_.first);
     __swap_alloc(__node_alloc(), __t.__node_alloc());
     __pair3_.swap(__t.__pair3_);
     if (size() == 0)
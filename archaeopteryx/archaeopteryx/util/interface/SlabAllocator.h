@@ -0,0 +1,132 @@
+/*	\file   SlabAllocator.h
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The header file for the SlabAllocator class.
+*/
+
+#pragma once
+
+// Archaeopteryx Includes
+#include <archaeopteryx/util/interface/allocator_traits.h>
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! \brief A bump allocator over a pre-provisioned arena.
+
+	Device malloc takes a global lock, so structures built by every
+	simulated block at once serialize the whole machine.  A slab is
+	carved out of one up front allocation instead, an allocation is a
+	single atomicAdd on the slab's cursor, and deallocation is deferred
+	until the whole slab is reset. */
+class SlabAllocator
+{
+public:
+	/*! Every allocation is aligned to this boundary */
+	static const unsigned int Alignment = 16;
+
+public:
+	/*! \brief Starts out detached, every allocation fails over to the heap */
+	__device__ SlabAllocator();
+
+public:
+	/*! \brief Attach the slab to a buffer owned by the caller */
+	__device__ void initialize(void* buffer, size_t bytes);
+
+	/*! \brief Bump allocate, returns 0 when the slab is exhausted */
+	__device__ void* allocate(size_t bytes);
+
+	/*! \brief Does the address fall inside the slab?  Memory the slab
+		owns is never freed individually, it is reclaimed by reset */
+	__device__ bool owns(const void* address) const;
+
+	/*! \brief Discard every allocation at once */
+	__device__ void reset();
+
+public:
+	__device__ size_t capacity() const;
+	__device__ size_t used() const;
+
+private:
+	char*              m_buffer;
+	unsigned long long m_size;
+	unsigned long long m_offset;
+
+};
+
+/*! \brief An allocator over a SlabAllocator arena, compatible with
+	allocator_traits so that util containers can bump allocate.  Falls
+	back to the global heap when no arena is attached or the slab fills. */
+template <class _Tp>
+class slab_allocator
+{
+public:
+    typedef size_t     size_type;
+    typedef ptrdiff_t  difference_type;
+    typedef _Tp*       pointer;
+    typedef const _Tp* const_pointer;
+    typedef _Tp&       reference;
+    typedef const _Tp& const_reference;
+    typedef _Tp        value_type;
+
+    template <class _Up> struct rebind {typedef slab_allocator<_Up> other;};
+
+    __device__ slab_allocator() : __arena_(0) {}
+    __device__ explicit slab_allocator(SlabAllocator* __a) : __arena_(__a) {}
+    template <class _Up>
+        __device__ slab_allocator(const slab_allocator<_Up>& __a)
+        : __arena_(__a.arena()) {}
+
+    __device__ pointer address(reference __x) const
+        {return util::addressof(__x);}
+    __device__ const_pointer address(const_reference __x) const
+        {return util::addressof(__x);}
+    __device__ pointer allocate(size_type __n, const void* = 0)
+    {
+        if(__arena_ != 0)
+        {
+            pointer __p = static_cast<pointer>(
+                __arena_->allocate(__n * sizeof(_Tp)));
+            if(__p != 0) return __p;
+        }
+        return static_cast<pointer>(::operator new(__n * sizeof(_Tp)));
+    }
+    __device__ void deallocate(pointer __p, size_type)
+    {
+        if(__arena_ != 0 && __arena_->owns(__p)) return;
+        ::operator delete((void*)__p);
+    }
+    __device__ size_type max_size() const
+        {return size_type(~0) / sizeof(_Tp);}
+
+    template <class... _Args>
+        __device__ void
+        construct(pointer __p, _Args&&... __args)
+        {
+            ::new((void*)__p) _Tp(util::forward<_Args>(__args)...);
+        }
+    __device__ void destroy(pointer __p) {__p->~_Tp();}
+
+    __device__ SlabAllocator* arena() const {return __arena_;}
+
+private:
+    SlabAllocator* __arena_;
+};
+
+template <class _Tp, class _Up>
+__device__ inline bool operator==(const slab_allocator<_Tp>& __x,
+    const slab_allocator<_Up>& __y)
+    {return __x.arena() == __y.arena();}
+
+template <class _Tp, class _Up>
+__device__ inline bool operator!=(const slab_allocator<_Tp>& __x,
+    const slab_allocator<_Up>& __y)
+    {return !(__x == __y);}
+
+}
+
+}
+
@@ -0,0 +1,98 @@
+/*	\file   StaticKnob.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StaticKnob class
+*/
+
+#pragma once
+
+namespace archaeopteryx
+{
+
+namespace util
+{
+
+/*! \brief A knob resolved at compile time.
+
+	Performance critical settings must never pay for a string lookup on a
+	device path, so they are bound when the simulator is built: one
+	specialization per knob tag, read as StaticKnob<knobs::WarpSize>::value.
+	The string database in Knob.h stays for genuinely dynamic configuration
+	like file names and grid shapes.
+*/
+template <typename Tag>
+class StaticKnob;
+
+namespace knobs
+{
+
+/*! \brief The number of threads in a simulated warp */
+class WarpSize       {};
+/*! \brief log2 of WarpSize */
+class LogWarpSize    {};
+/*! \brief Shared memory dedicated to the decoded instruction cache, in
+	bytes */
+class FetchCacheSize {};
+/*! \brief The number of banks in simulated shared memory */
+class SharedMemoryBanks {};
+/*! \brief log2 of the width of one shared memory bank, in bytes */
+class LogSharedMemoryBankWidth {};
+/*! \brief log2 of a global memory transaction segment, in bytes */
+class LogMemorySegmentSize {};
+/*! \brief log2 of a global memory sector, in bytes */
+class LogMemorySectorSize {};
+
+}
+
+template <>
+class StaticKnob<knobs::WarpSize>
+{
+public:
+	static const unsigned int value = 32;
+};
+
+template <>
+class StaticKnob<knobs::LogWarpSize>
+{
+public:
+	static const unsigned int value = 5;
+};
+
+template <>
+class StaticKnob<knobs::FetchCacheSize>
+{
+public:
+	static const unsigned int value = 8192;
+};
+
+template <>
+class StaticKnob<knobs::SharedMemoryBanks>
+{
+public:
+	static const unsigned int value = 32;
+};
+
+template <>
+class StaticKnob<knobs::LogSharedMemoryBankWidth>
+{
+public:
+	static const unsigned int value = 2;
+};
+
+template <>
+class StaticKnob<knobs::LogMemorySegmentSize>
+{
+public:
+	static const unsigned int value = 7;
+};
+
+template <>
+class StaticKnob<knobs::LogMemorySectorSize>
+{
+public:
+	static const unsigned int value = 5;
+};
+
+}
+
+}
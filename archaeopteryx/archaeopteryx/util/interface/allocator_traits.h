@@ -614,27 +614,11 @@ struct allocator_traits
     __device__ static void deallocate(allocator_type& __a, pointer __p, size_type __n)
         {__a.deallocate(__p, __n);}
 
-    template <class _Tp>
-                __device__ static void construct(allocator_type& __a, _Tp* __p)
-            {
-                ::new ((void*)__p) _Tp();
-            }
-    template <class _Tp, class _A0>
-                __device__ static void construct(allocator_type& __a, _Tp* __p, const _A0& __a0)
-            {
-                ::new ((void*)__p) _Tp(__a0);
-            }
-    template <class _Tp, class _A0, class _A1>
-                __device__ static void construct(allocator_type& __a, _Tp* __p, const _A0& __a0,
-                              const _A1& __a1)
+    template <class _Tp, class... _Args>
+                __device__ static void construct(allocator_type& __a, _Tp* __p,
+                              _Args&&... __args)
             {
-                ::new ((void*)__p) _Tp(__a0, __a1);
-            }
-    template <class _Tp, class _A0, class _A1, class _A2>
-                __device__ static void construct(allocator_type& __a, _Tp* __p, const _A0& __a0,
-                              const _A1& __a1, const _A2& __a2)
-            {
-                ::new ((void*)__p) _Tp(__a0, __a1, __a2);
+                ::new ((void*)__p) _Tp(util::forward<_Args>(__args)...);
             }
 
     template <class _Tp>
@@ -769,48 +753,11 @@ public:
         {::operator delete((void*)__p);}
     __device__ size_type max_size() const
         {return size_type(~0) / sizeof(_Tp);}
+    template <class... _Args>
         __device__ void
-        construct(pointer __p)
+        construct(pointer __p, _Args&&... __args)
         {
-            ::new((void*)__p) _Tp();
-        }
-
-    template <class _A0>
-        __device__ void
-        construct(pointer __p, _A0& __a0)
-        {
-            ::new((void*)__p) _Tp(__a0);
-        }
-    template <class _A0>
-        __device__ void
-        construct(pointer __p, const _A0& __a0)
-        {
-            ::new((void*)__p) _Tp(__a0);
-        }
-        
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, _A0& __a0, _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, const _A0& __a0, _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, _A0& __a0, const _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, const _A0& __a0, const _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
+            ::new((void*)__p) _Tp(util::forward<_Args>(__args)...);
         }
     __device__ void destroy(pointer __p) {__p->~_Tp();}
 };
@@ -842,48 +789,11 @@ public:
     __device__ size_type max_size() const
         {return size_type(~0) / sizeof(_Tp);}
         
+    template <class... _Args>
         __device__ void
-        construct(pointer __p)
-        {
-            ::new((void*)__p) _Tp();
-        }
-
-    template <class _A0>
-        __device__ void
-        construct(pointer __p, _A0& __a0)
-        {
-            ::new((void*)__p) _Tp(__a0);
-        }
-    template <class _A0>
-        __device__ void
-        construct(pointer __p, const _A0& __a0)
-        {
-            ::new((void*)__p) _Tp(__a0);
-        }
-        
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, _A0& __a0, _A1& __a1)
+        construct(pointer __p, _Args&&... __args)
         {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, const _A0& __a0, _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, _A0& __a0, const _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
-        }
-    template <class _A0, class _A1>
-        __device__ void
-        construct(pointer __p, const _A0& __a0, const _A1& __a1)
-        {
-            ::new((void*)__p) _Tp(__a0, __a1);
+            ::new((void*)__p) _Tp(util::forward<_Args>(__args)...);
         }
     __device__ void destroy(pointer __p) {__p->~_Tp();}
 };
@@ -991,6 +901,16 @@ public:
     __device__ unique_ptr(__rv<unique_ptr> __u)
         : __ptr_(__u->release(), util::forward<deleter_type>(__u->get_deleter())) {}
 
+    __device__ unique_ptr(unique_ptr&& __u)
+        : __ptr_(__u.release(), util::forward<deleter_type>(__u.get_deleter())) {}
+
+    __device__ unique_ptr& operator=(unique_ptr&& __u)
+    {
+        reset(__u.release());
+        __ptr_.second = util::forward<deleter_type>(__u.get_deleter());
+        return *this;
+    }
+
     template <class _Up, class _Ep>
     __device__ unique_ptr& operator=(unique_ptr<_Up, _Ep> __u)
     {
@@ -1077,7 +997,17 @@ public:
         __ptr_.second() = util::forward<deleter_type>(__u->get_deleter());
         return *this;
     }
-    
+
+    __device__ unique_ptr(unique_ptr&& __u)
+        : __ptr_(__u.release(), util::forward<deleter_type>(__u.get_deleter())) {}
+
+    __device__ unique_ptr& operator=(unique_ptr&& __u)
+    {
+        reset(__u.release());
+        __ptr_.second() = util::forward<deleter_type>(__u.get_deleter());
+        return *this;
+    }
+
     __device__ ~unique_ptr() {reset();}
 
     __device__ typename add_lvalue_reference<_Tp>::type operator[](size_t __i) const
@@ -1143,13 +1073,6 @@ template <class _T1, class _D1, class _T2, class _D2>
 __device__ inline bool
 operator>=(const unique_ptr<_T1, _D1>& __x, const unique_ptr<_T2, _D2>& __y) {return !(__x < __y);}
 
-template <class _Tp, class _Dp>
-__device__ inline unique_ptr<_Tp, _Dp>
-move(unique_ptr<_Tp, _Dp>& __t)
-{
-    return unique_ptr<_Tp, _Dp>(__rv<unique_ptr<_Tp, _Dp> >(__t));
-}
-
 struct __destruct_n
 {
 private:
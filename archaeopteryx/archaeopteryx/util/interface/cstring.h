@@ -38,6 +38,25 @@ __device__ void* memmove(void* s1, const void* s2, size_t n);
 __device__ void* memcpy(void* s1, const void* s2, size_t n);
 __device__ void* memset(void* s, int c, size_t n);
 
+/*! \brief A copy that a fully convergent warp performs cooperatively
+
+	Every participating lane must pass identical arguments.  A fully
+	convergent warp splits the copy across its lanes, otherwise each
+	active lane falls back to the serial copy, which stays correct
+	because all lanes write identical bytes.
+*/
+__device__ void* memcpyWarp(void* s1, const void* s2, size_t n);
+
+/*! \brief A string compare that a fully convergent warp performs
+	cooperatively, every lane receives the same result
+
+	Both strings must be readable through the next warp sized boundary
+	after their terminators, which page backed storage satisfies.
+	Divergent callers fall back to the serial compare, which has no such
+	requirement.
+*/
+__device__ int strcmpWarp(const char* left, const char* right);
+
 }
 
 }
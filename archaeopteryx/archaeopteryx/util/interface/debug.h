@@ -17,12 +17,23 @@
 #define REPORT_BASE 0
 
 // Preprocessor macros
+
+// A production build (NDEBUG) expands every reporting and assertion macro
+// to nothing before the compiler ever sees the arguments, so instrumented
+// code carries literally zero overhead.  Debug builds keep the per-file
+// REPORT_BASE switch, the disabled branches constant fold away.
 #ifdef device_assert
 #undef device_assert
 #endif
 
-#define device_assert(x) util::_assert(x, #x, __FILE__, __LINE__)
-#define device_assert_m(x, y) device_report(y "\n"); device_assert(x)
+#ifndef NDEBUG
+	#define device_assert(x) util::_assert(x, #x, __FILE__, __LINE__)
+	#define device_assert_m(x, y) device_report(y "\n"); device_assert(x)
+#else
+	// sizeof keeps the operands used without evaluating or emitting them
+	#define device_assert(x) ((void)sizeof(x))
+	#define device_assert_m(x, y) ((void)sizeof(x))
+#endif
 
 #ifndef NDEBUG
 	#define report(y) \
@@ -42,31 +53,37 @@
 #undef device_report
 #endif
 
-#define device_report(...) \
-	if(REPORT_BASE > 0)\
-	{ \
-		printf(__VA_ARGS__);\
-	}
-
 #ifdef cta_report
 #undef cta_report
 #endif
 
-#define cta_report(...) \
-	if(threadIdx.x == 0)\
-	{ \
-		device_report(__VA_ARGS__);\
-	}
-
 #ifdef kernel_report
 #undef kernel_report
 #endif
 
-#define kernel_report(...) \
-	if(blockIdx.x == 0)\
-	{ \
-		cta_report(__VA_ARGS__);\
-	}
+#ifndef NDEBUG
+	#define device_report(...) \
+		if(REPORT_BASE > 0)\
+		{ \
+			printf(__VA_ARGS__);\
+		}
+
+	#define cta_report(...) \
+		if(threadIdx.x == 0)\
+		{ \
+			device_report(__VA_ARGS__);\
+		}
+
+	#define kernel_report(...) \
+		if(blockIdx.x == 0)\
+		{ \
+			cta_report(__VA_ARGS__);\
+		}
+#else
+	#define device_report(...)
+	#define cta_report(...)
+	#define kernel_report(...)
+#endif
 
 namespace archaeopteryx
 {
@@ -383,7 +383,7 @@ iterator_category;
     typedef typename iterator_traits<iterator_type>::difference_type
 difference_type;
     typedef typename iterator_traits<iterator_type>::pointer pointer;
-    typedef typename iterator_traits<iterator_type>::reference reference;
+    typedef value_type&& reference;
 
      __device__ move_iterator() : __i() {}
      __device__ explicit move_iterator(_Iter __x) : __i(__x) {}
@@ -314,6 +314,22 @@ public:
             return *this;
         }
 
+    __device__ map(map&& __m)
+        : __tree_(__vc(__m.key_comp()))
+        {
+            __tree_.swap(__m.__tree_);
+        }
+
+    __device__ map& operator=(map&& __m)
+        {
+            if (this != &__m)
+            {
+                clear();
+                __tree_.swap(__m.__tree_);
+            }
+            return *this;
+        }
+
     __device__ explicit map(const allocator_type& __a)
         : __tree_(__a)
         {
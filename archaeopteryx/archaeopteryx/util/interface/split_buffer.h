@@ -86,6 +86,9 @@ public:
     __device__ void shrink_to_fit();
     __device__ void push_front(const_reference __x);
     __device__ void push_back(const_reference __x);
+    __device__ void push_back(value_type&& __x);
+    template <class... _Args>
+        __device__ void emplace_back(_Args&&... __args);
 
     __device__ void pop_front() {__destruct_at_begin(__begin_+1);}
     __device__ void pop_back() {__destruct_at_end(__end_-1);}
@@ -419,6 +422,67 @@ __split_buffer<_Tp, _Allocator>::push_back(const_reference __x)
     ++__end_;
 }
 
+template <class _Tp, class _Allocator> inline
+__device__ void
+__split_buffer<_Tp, _Allocator>::push_back(value_type&& __x)
+{
+    if (__end_ == __end_cap())
+    {
+        if (__begin_ > __first_)
+        {
+            difference_type __d = __begin_ - __first_;
+            __d = (__d + 1) / 2;
+            __end_ = util::move(__begin_, __end_, __begin_ - __d);
+            __begin_ -= __d;
+        }
+        else
+        {
+            size_type __c = max<size_type>(2 * static_cast<size_t>(__end_cap() - __first_), 1);
+            __split_buffer<value_type, __alloc_rr&> __t(__c, __c / 4, __alloc());
+            __t.__construct_at_end(move_iterator<pointer>(__begin_),
+                                   move_iterator<pointer>(__end_));
+            util::swap(__first_, __t.__first_);
+            util::swap(__begin_, __t.__begin_);
+            util::swap(__end_, __t.__end_);
+            util::swap(__end_cap(), __t.__end_cap());
+        }
+    }
+    __alloc_traits::construct(__alloc(), util::__to_raw_pointer(__end_),
+                              util::move(__x));
+    ++__end_;
+}
+
+template <class _Tp, class _Allocator>
+template <class... _Args>
+__device__ void
+__split_buffer<_Tp, _Allocator>::emplace_back(_Args&&... __args)
+{
+    if (__end_ == __end_cap())
+    {
+        if (__begin_ > __first_)
+        {
+            difference_type __d = __begin_ - __first_;
+            __d = (__d + 1) / 2;
+            __end_ = util::move(__begin_, __end_, __begin_ - __d);
+            __begin_ -= __d;
+        }
+        else
+        {
+            size_type __c = max<size_type>(2 * static_cast<size_t>(__end_cap() - __first_), 1);
+            __split_buffer<value_type, __alloc_rr&> __t(__c, __c / 4, __alloc());
+            __t.__construct_at_end(move_iterator<pointer>(__begin_),
+                                   move_iterator<pointer>(__end_));
+            util::swap(__first_, __t.__first_);
+            util::swap(__begin_, __t.__begin_);
+            util::swap(__end_, __t.__end_);
+            util::swap(__end_cap(), __t.__end_cap());
+        }
+    }
+    __alloc_traits::construct(__alloc(), util::__to_raw_pointer(__end_),
+                              util::forward<_Args>(__args)...);
+    ++__end_;
+}
+
 template <class _Tp, class _Allocator> inline
 __device__ void
 swap(__split_buffer<_Tp, _Allocator>& __x, __split_buffer<_Tp, _Allocator>& __y)
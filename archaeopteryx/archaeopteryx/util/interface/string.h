@@ -352,6 +352,7 @@ public:
     __device__ explicit basic_string(const allocator_type& __a);
     __device__ basic_string(const basic_string& __str);
     __device__ basic_string(const basic_string& __str, const allocator_type& __a);
+    __device__ basic_string(basic_string&& __str);
     __device__ basic_string(const_pointer __s);
    
     __device__ basic_string(const_pointer __s, const allocator_type& __a);
@@ -375,6 +376,7 @@ public:
     __device__ ~basic_string();
 
     __device__ basic_string& operator=(const basic_string& __str);
+    __device__ basic_string& operator=(basic_string&& __str);
 
     __device__ basic_string& operator=(const_pointer __s) {return assign(__s);}
     __device__ basic_string& operator=(value_type __c);
@@ -932,6 +934,13 @@ __device__ basic_string<_CharT, _Traits, _Allocator>::basic_string(const basic_s
         __init(__str.__get_long_pointer(), __str.__get_long_size());
 }
 
+template <class _CharT, class _Traits, class _Allocator>
+__device__ basic_string<_CharT, _Traits, _Allocator>::basic_string(basic_string&& __str)
+    : __r_(__str.__r_.first, util::move(__str.__alloc()))
+{
+    __str.__zero();
+}
+
 template <class _CharT, class _Traits, class _Allocator>
 __device__ void
 basic_string<_CharT, _Traits, _Allocator>::__init(size_type __n, value_type __c)
@@ -1186,6 +1195,26 @@ basic_string<_CharT, _Traits, _Allocator>::operator=(const basic_string& __str)
     return *this;
 }
 
+template <class _CharT, class _Traits, class _Allocator>
+__device__ basic_string<_CharT, _Traits, _Allocator>&
+basic_string<_CharT, _Traits, _Allocator>::operator=(basic_string&& __str)
+{
+    if (this != &__str)
+    {
+        if (__alloc() != __str.__alloc())
+            assign(__str);
+        else
+        {
+            clear();
+            shrink_to_fit();
+            __move_assign_alloc(__str);
+            __r_.first.__r = __str.__r_.first.__r;
+            __str.__zero();
+        }
+    }
+    return *this;
+}
+
 template <class _CharT, class _Traits, class _Allocator>
 template<class _InputIterator>
 __device__ typename enable_if
@@ -223,9 +223,11 @@ template <class _Tp> struct is_lvalue_reference       : public false_type {};
 template <class _Tp> struct is_lvalue_reference<_Tp&> : public true_type {};
 
 template <class _Tp> struct is_rvalue_reference        : public false_type {};
+template <class _Tp> struct is_rvalue_reference<_Tp&&> : public true_type {};
 
 template <class _Tp> struct is_reference        : public false_type {};
 template <class _Tp> struct is_reference<_Tp&>  : public true_type {};
+template <class _Tp> struct is_reference<_Tp&&> : public true_type {};
 
 // is_union
 
@@ -279,23 +281,27 @@ template <class _Tp> struct is_abstract : public __libcpp_abstract<_Tp> {};
 
 // move
 template <class _Tp>
-__device__ inline _Tp&
-move(_Tp& __t)
+__device__ inline typename remove_reference<_Tp>::type&&
+move(_Tp&& __t)
 {
-    return __t;
+    typedef typename remove_reference<_Tp>::type _Up;
+    return static_cast<_Up&&>(__t);
 }
 
 template <class _Tp>
-__device__ inline const _Tp&
-move(const _Tp& __t)
+__device__ inline _Tp&&
+forward(typename util::remove_reference<_Tp>::type& __t)
 {
-    return __t;
+    return static_cast<_Tp&&>(__t);
 }
 
 template <class _Tp>
-__device__ inline _Tp& forward(typename util::remove_reference<_Tp>::type& __t)
+__device__ inline _Tp&&
+forward(typename util::remove_reference<_Tp>::type&& __t)
 {
-    return __t;
+    static_assert(!is_lvalue_reference<_Tp>::value,
+                  "can not forward an rvalue as an lvalue");
+    return static_cast<_Tp&&>(__t);
 }
 
 template <class _Tp>
@@ -360,6 +366,7 @@ template <class _Tp> struct is_empty : public __libcpp_empty<_Tp> {};
 namespace __is_convertible_imp
 {
 template <class _Tp> char  __test(_Tp);
+template <class _Tp> __two __test(...);
 template <class _Tp> typename remove_reference<_Tp>::type& __source();
 
 template <class _Tp, bool _IsArray =    is_array<_Tp>::value,
@@ -512,6 +519,7 @@ template <class _Tp> struct is_arithmetic
 
 template <class _Tp> struct remove_reference        {typedef _Tp type;};
 template <class _Tp> struct remove_reference<_Tp&>  {typedef _Tp type;};
+template <class _Tp> struct remove_reference<_Tp&&> {typedef _Tp type;};
 
 // add_lvalue_reference
 
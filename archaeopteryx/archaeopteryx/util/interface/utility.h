@@ -65,7 +65,7 @@ swap(_Tp (&__a)[_Np], _Tp (&__b)[_Np])
 }
 
 template <class _Tp>
-__device__ inline const _Tp&
+__device__ inline _Tp&&
 move_if_noexcept(_Tp& __x)
 {
     return util::move(__x);
@@ -90,23 +90,40 @@ struct pair
 
     __device__ pair(const _T1& __x, const _T2& __y)
         : first(__x), second(__y) {}
-		
+
     template<class _U1, class _U2>
                 __device__ pair(const pair<_U1, _U2>& __p)
             : first(__p.first), second(__p.second) {}
 
+    template<class _U1, class _U2>
+                __device__ pair(pair<_U1, _U2>&& __p)
+            : first(util::move(__p.first)), second(util::move(__p.second)) {}
+
     __device__ pair(const pair& __p)
         : first(__p.first),
           second(__p.second)
     {
     }
 
+    __device__ pair(pair&& __p)
+        : first(util::move(__p.first)),
+          second(util::move(__p.second))
+    {
+    }
+
     __device__ pair& operator=(const pair& __p)
     {
         first = __p.first;
         second = __p.second;
         return *this;
     }
+
+    __device__ pair& operator=(pair&& __p)
+    {
+        first = util::move(__p.first);
+        second = util::move(__p.second);
+        return *this;
+    }
     
     __device__ void
     swap(pair& __p)
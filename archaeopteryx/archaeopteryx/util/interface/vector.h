@@ -228,6 +228,10 @@ public:
     __device__ vector(const vector& __x, const allocator_type& __a);
     __device__ vector& operator=(const vector& __x);
 
+    __device__ vector(vector&& __x);
+    __device__ vector(vector&& __x, const allocator_type& __a);
+    __device__ vector& operator=(vector&& __x);
+
     template <class _InputIterator>
         __device__ typename enable_if
         <
@@ -311,12 +315,22 @@ public:
         {return util::__to_raw_pointer(this->__begin_);}
 
     __device__ void push_back(const_reference __x);
+    __device__ void push_back(value_type&& __x);
+
+    template <class... _Args>
+        __device__ void emplace_back(_Args&&... __args);
+
 	__device__ void pop_back();
 
     __device__ iterator insert(const_iterator __position, size_type __n, const_reference __x);
-    
+
     __device__ iterator insert(const_iterator __position, const_reference __x);
-    
+
+    __device__ iterator insert(const_iterator __position, value_type&& __x);
+
+    template <class... _Args>
+        __device__ iterator emplace(const_iterator __position, _Args&&... __args);
+
     template <class _InputIterator>
         __device__ typename enable_if
         <
@@ -379,7 +393,10 @@ private:
 		}
     template <class _Up>
         __device__ void
-        __push_back_slow_path(_Up& __x);
+        __push_back_slow_path(_Up&& __x);
+    template <class... _Args>
+        __device__ void
+        __emplace_back_slow_path(_Args&&... __args);
 };
 
 template <class _Tp, class _Allocator>
@@ -684,6 +701,71 @@ vector<_Tp, _Allocator>::operator=(const vector& __x)
     return *this;
 }
 
+template <class _Tp, class _Allocator>
+__device__ inline
+vector<_Tp, _Allocator>::vector(vector&& __x)
+    : __base(util::move(__x.__alloc()))
+{
+    this->__begin_ = __x.__begin_;
+    this->__end_ = __x.__end_;
+    this->__end_cap() = __x.__end_cap();
+    __x.__begin_ = __x.__end_ = __x.__end_cap() = 0;
+}
+
+template <class _Tp, class _Allocator>
+__device__ inline
+vector<_Tp, _Allocator>::vector(vector&& __x, const allocator_type& __a)
+    : __base(__a)
+{
+    if (__a == __x.__alloc())
+    {
+        this->__begin_ = __x.__begin_;
+        this->__end_ = __x.__end_;
+        this->__end_cap() = __x.__end_cap();
+        __x.__begin_ = __x.__end_ = __x.__end_cap() = 0;
+    }
+    else
+    {
+        typedef move_iterator<iterator> _Ip;
+        assign(_Ip(__x.begin()), _Ip(__x.end()));
+    }
+}
+
+template <class _Tp, class _Allocator>
+__device__ inline
+vector<_Tp, _Allocator>&
+vector<_Tp, _Allocator>::operator=(vector&& __x)
+{
+    __move_assign(__x, integral_constant<bool,
+        __alloc_traits::propagate_on_container_move_assignment::value>());
+    return *this;
+}
+
+template <class _Tp, class _Allocator>
+__device__ void
+vector<_Tp, _Allocator>::__move_assign(vector& __c, false_type)
+{
+    if (__base::__alloc() != __c.__alloc())
+    {
+        typedef move_iterator<iterator> _Ip;
+        assign(_Ip(__c.begin()), _Ip(__c.end()));
+    }
+    else
+        __move_assign(__c, true_type());
+}
+
+template <class _Tp, class _Allocator>
+__device__ void
+vector<_Tp, _Allocator>::__move_assign(vector& __c, true_type)
+{
+    deallocate();
+    __base::__move_assign_alloc(__c);
+    this->__begin_ = __c.__begin_;
+    this->__end_ = __c.__end_;
+    this->__end_cap() = __c.__end_cap();
+    __c.__begin_ = __c.__end_ = __c.__end_cap() = 0;
+}
+
 template <class _Tp, class _Allocator>
 template <class _InputIterator>
 __device__ typename enable_if
@@ -863,7 +945,7 @@ vector<_Tp, _Allocator>::shrink_to_fit()
 template <class _Tp, class _Allocator>
 template <class _Up>
 __device__ void
-vector<_Tp, _Allocator>::__push_back_slow_path(_Up& __x)
+vector<_Tp, _Allocator>::__push_back_slow_path(_Up&& __x)
 {
     allocator_type& __a = this->__alloc();
     __split_buffer<value_type, allocator_type&> __v(__recommend(size() + 1), size(), __a);
@@ -886,6 +968,50 @@ vector<_Tp, _Allocator>::push_back(const_reference __x)
         __push_back_slow_path(__x);
 }
 
+template <class _Tp, class _Allocator>
+__device__ inline
+void
+vector<_Tp, _Allocator>::push_back(value_type&& __x)
+{
+    if (this->__end_ != this->__end_cap())
+    {
+        __alloc_traits::construct(this->__alloc(),
+                                  util::__to_raw_pointer(this->__end_),
+                                  util::move(__x));
+        ++this->__end_;
+    }
+    else
+        __push_back_slow_path(util::move(__x));
+}
+
+template <class _Tp, class _Allocator>
+template <class... _Args>
+__device__ void
+vector<_Tp, _Allocator>::__emplace_back_slow_path(_Args&&... __args)
+{
+    allocator_type& __a = this->__alloc();
+    __split_buffer<value_type, allocator_type&> __v(__recommend(size() + 1), size(), __a);
+    __alloc_traits::construct(__a, util::__to_raw_pointer(__v.__end_++), util::forward<_Args>(__args)...);
+    __swap_out_circular_buffer(__v);
+}
+
+template <class _Tp, class _Allocator>
+template <class... _Args>
+__device__ inline
+void
+vector<_Tp, _Allocator>::emplace_back(_Args&&... __args)
+{
+    if (this->__end_ != this->__end_cap())
+    {
+        __alloc_traits::construct(this->__alloc(),
+                                  util::__to_raw_pointer(this->__end_),
+                                  util::forward<_Args>(__args)...);
+        ++this->__end_;
+    }
+    else
+        __emplace_back_slow_path(util::forward<_Args>(__args)...);
+}
+
 template <class _Tp, class _Allocator>
 __device__ inline
 void
@@ -961,6 +1087,70 @@ vector<_Tp, _Allocator>::insert(const_iterator __position, const_reference __x)
     return __make_iter(__p);
 }
 
+template <class _Tp, class _Allocator>
+__device__ typename vector<_Tp, _Allocator>::iterator
+vector<_Tp, _Allocator>::insert(const_iterator __position, value_type&& __x)
+{
+    pointer __p = this->__begin_ + (__position - begin());
+    if (this->__end_ < this->__end_cap())
+    {
+        if (__p == this->__end_)
+        {
+            __alloc_traits::construct(this->__alloc(),
+                                  util::__to_raw_pointer(this->__end_),
+                                  util::move(__x));
+            ++this->__end_;
+        }
+        else
+        {
+            __move_range(__p, this->__end_, __p + 1);
+            *__p = util::move(__x);
+        }
+    }
+    else
+    {
+        allocator_type& __a = this->__alloc();
+        __split_buffer<value_type, allocator_type&> __v(__recommend(size() + 1),
+        	__p - this->__begin_, __a);
+        __v.push_back(util::move(__x));
+        __p = __swap_out_circular_buffer(__v, __p);
+    }
+    return __make_iter(__p);
+}
+
+template <class _Tp, class _Allocator>
+template <class... _Args>
+__device__ typename vector<_Tp, _Allocator>::iterator
+vector<_Tp, _Allocator>::emplace(const_iterator __position, _Args&&... __args)
+{
+    pointer __p = this->__begin_ + (__position - begin());
+    if (this->__end_ < this->__end_cap())
+    {
+        if (__p == this->__end_)
+        {
+            __alloc_traits::construct(this->__alloc(),
+                                  util::__to_raw_pointer(this->__end_),
+                                  util::forward<_Args>(__args)...);
+            ++this->__end_;
+        }
+        else
+        {
+            value_type __tmp(util::forward<_Args>(__args)...);
+            __move_range(__p, this->__end_, __p + 1);
+            *__p = util::move(__tmp);
+        }
+    }
+    else
+    {
+        allocator_type& __a = this->__alloc();
+        __split_buffer<value_type, allocator_type&> __v(__recommend(size() + 1),
+        	__p - this->__begin_, __a);
+        __v.emplace_back(util::forward<_Args>(__args)...);
+        __p = __swap_out_circular_buffer(__v, __p);
+    }
+    return __make_iter(__p);
+}
+
 template <class _Tp, class _Allocator>
 __device__ typename vector<_Tp, _Allocator>::iterator
 vector<_Tp, _Allocator>::insert(const_iterator __position, size_type __n, const_reference __x)
@@ -12,6 +12,7 @@
 
 // Standard Library Includes
 #include <cstdio>
+#include <cstring>
 #include <stdexcept>
 
 namespace baldr
@@ -52,7 +53,35 @@ void ImageFile::setPixel(unsigned int x, unsigned int y,
 	_pixels[_getIndex(x, y)] = p;
 }
 
+void ImageFile::setTile(unsigned int x, unsigned int y,
+	unsigned int width, unsigned int height, const Pixel* pixels)
+{
+	for(unsigned int row = 0; row < height; ++row)
+	{
+		std::memcpy(&_pixels[_getIndex(x, y + row)],
+			pixels + row * width, width * sizeof(Pixel));
+	}
+}
+
+ImageFile::Pixel ImageFile::getPixel(unsigned int x, unsigned int y)
+{
+	return _pixels[_getIndex(x, y)];
+}
+
 void ImageFile::write(const std::string& filename)
+{
+	if(filename.size() >= 4 &&
+		filename.compare(filename.size() - 4, 4, ".ppm") == 0)
+	{
+		_writePPM(filename);
+	}
+	else
+	{
+		_writePNG(filename);
+	}
+}
+
+void ImageFile::_writePPM(const std::string& filename)
 {
 	FILE* file = std::fopen(filename.c_str(), "wb");
 
@@ -61,7 +90,45 @@ void ImageFile::write(const std::string& filename)
 		throw std::runtime_error("Could not open image file "
 			+ filename + " for writing.");
 	}
-	
+
+	// stage the packed RGB bytes in memory so the file sees one
+	// streaming write instead of one call per pixel
+	std::vector<unsigned char> staging;
+
+	staging.reserve(3 * _pixels.size());
+
+	for(PixelVector::iterator pixel = _pixels.begin();
+		pixel != _pixels.end(); ++pixel)
+	{
+		staging.push_back(pixel->red);
+		staging.push_back(pixel->green);
+		staging.push_back(pixel->blue);
+	}
+
+	std::fprintf(file, "P6\n%u %u\n255\n", _width, _height);
+
+	if(std::fwrite(staging.data(), 1, staging.size(), file)
+		!= staging.size())
+	{
+		std::fclose(file);
+
+		throw std::runtime_error("Writing image file "
+			+ filename + " failed.");
+	}
+
+	std::fclose(file);
+}
+
+void ImageFile::_writePNG(const std::string& filename)
+{
+	FILE* file = std::fopen(filename.c_str(), "wb");
+
+	if(file == 0)
+	{
+		throw std::runtime_error("Could not open image file "
+			+ filename + " for writing.");
+	}
+
 	png_structp writeStructure = png_create_write_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0);
 
 	if(writeStructure == 0)
@@ -83,11 +150,16 @@ void ImageFile::write(const std::string& filename)
 
 	png_write_info(writeStructure, pngInfo);
 
+	// hand libpng every row at once rather than calling in per row
+	std::vector<png_bytep> rows(_height);
+
 	for(unsigned int i = 0; i < _height; ++i)
 	{
-		png_write_row(writeStructure, (png_bytep)&_pixels[_getIndex(0,i)]);
+		rows[i] = (png_bytep)&_pixels[_getIndex(0, i)];
 	}
 
+	png_write_image(writeStructure, rows.data());
+
 	png_write_end(writeStructure, 0);
 
 	std::fclose(file);
@@ -95,7 +167,8 @@ void ImageFile::write(const std::string& filename)
 
 unsigned int ImageFile::_getIndex(unsigned int x, unsigned int y)
 {
-	return y * _height + x;
+	// pixels are stored row by row
+	return y * _width + x;
 }
 
 }
@@ -6,46 +6,214 @@
 */
 
 // Standard Library Includes
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 //other includes
-#include <baldr/include/Renderer.h> 
+#include <baldr/include/Renderer.h>
 //Forward declarations
 
 namespace baldr
 {
+    //32 pixels of 4 bytes each, a tile row spans whole cache lines so
+    //workers never write into each other's lines
+    static const unsigned TileSize = 32;
+
     void Renderer::renderScene()
     {
-        XYZ sampleOffsetX = (m_viewport.m_dx.getRayEquation()).scalarDivide(m_width);
-        XYZ sampleOffsetY = (m_viewport.m_dy.getRayEquation()).scalarDivide(m_height);
-
         std::cout << "Start renderer\n";
-        std::cout << "Camera at: " << m_camera.getX() << " , " << m_camera.getY() << " , " 
-            << m_camera.getZ() << "\n"; 
+        std::cout << "Camera at: " << m_camera.getX() << " , " << m_camera.getY() << " , "
+            << m_camera.getZ() << "\n";
+
+        ImageFile image(m_width, m_height);
+
+        renderScene(image);
+
         for (unsigned h = 0; h < m_height; ++h)
         {
             for (unsigned w = 0; w < m_width; ++w)
             {
-                XYZ currentPixOffsetY = sampleOffsetY.scalarProduct(h);
-                XYZ currentPixOffsetX = sampleOffsetX.scalarProduct(w);
-                XYZ currentPos        = (currentPixOffsetX.add(currentPixOffsetY)).add(m_viewport.m_corner);
-                Ray testRay(currentPos, m_camera);
-//                std::cout << "Ray starts at : " << testRay.getRayStart().getX() << testRay.getRayStart().getY() << testRay.getRayStart().getZ() << "\n";
-//                std::cout << "Ray equation is :" << testRay.getRayEquation().getX() << "," << testRay.getRayEquation().getY() << "," << testRay.getRayEquation().getZ() << "\n"; 
-
-                for (ObjectsInScene::iterator obj = m_objects.begin(); obj != m_objects.end(); ++obj)
+                std::cout << (image.getPixel(w, h).red != 0 ? "#" : " ");
+            }
+            std::cout << "\n";
+        }
+    }
+
+    void Renderer::renderScene(ImageFile& image)
+    {
+        renderScene(image, 1);
+    }
+
+    void Renderer::renderScene(ImageFile& image, unsigned maxPasses)
+    {
+        //sub pixel sample positions for successive passes - pass zero
+        //samples where the single pass renderer always has, later passes
+        //spread evenly over the pixel
+        static const float jitter[][2] =
+        {
+            {0.0f,    0.0f},    {0.5f,    0.5f},
+            {0.25f,   0.75f},   {0.75f,   0.25f},
+            {0.125f,  0.625f},  {0.625f,  0.125f},
+            {0.375f,  0.875f},  {0.875f,  0.375f},
+            {0.0625f, 0.9375f}, {0.5625f, 0.4375f},
+            {0.3125f, 0.6875f}, {0.8125f, 0.1875f},
+            {0.1875f, 0.3125f}, {0.6875f, 0.8125f},
+            {0.4375f, 0.0625f}, {0.9375f, 0.5625f},
+        };
+
+        const unsigned jitterCount = sizeof(jitter) / sizeof(jitter[0]);
+
+        if (maxPasses == 0) maxPasses = 1;
+
+        XYZ sampleOffsetX = (m_viewport.m_dx.getRayEquation()).scalarDivide(m_width);
+        XYZ sampleOffsetY = (m_viewport.m_dy.getRayEquation()).scalarDivide(m_height);
+
+        image.resize(m_width, m_height);
+
+        //sort the objects into the bounding volume hierarchy once, every
+        //ray below queries the hierarchy instead of the object list
+        m_scene.build();
+
+        unsigned tilesAcross = (m_width  + TileSize - 1) / TileSize;
+        unsigned tilesDown   = (m_height + TileSize - 1) / TileSize;
+        unsigned tileCount   = tilesAcross * tilesDown;
+
+        //one running hit count per pixel, and per tile a sample count
+        //and a settled flag - a settled tile drops out of later passes
+        std::vector<float>         hitCounts(m_width * m_height, 0.0f);
+        std::vector<unsigned>      tileSamples(tileCount, 0);
+        std::vector<unsigned char> converged(tileCount, 0);
+
+        //tiles are claimed through a shared counter, a worker finishing a
+        //cheap tile just comes back for another, so uneven tiles balance
+        //themselves without a queue per worker
+        std::atomic<unsigned> nextTile(0);
+        std::atomic<unsigned> convergedTiles(0);
+
+        auto renderTiles = [&](unsigned pass)
+        {
+            //a packet is one tile row of rays, adjacent pixels aimed at
+            //the same camera stay coherent through the hierarchy
+            std::vector<Ray> packet;
+            packet.reserve(TileSize);
+
+            bool hits[TileSize];
+
+            //each tile is shaded into this local buffer and committed to
+            //the framebuffer as one copy per tile
+            std::vector<ImageFile::Pixel> tilePixels(TileSize * TileSize);
+
+            while (true)
+            {
+                unsigned tile = nextTile++;
+
+                if (tile >= tileCount) break;
+
+                if (converged[tile]) continue;
+
+                unsigned beginX = (tile % tilesAcross) * TileSize;
+                unsigned beginY = (tile / tilesAcross) * TileSize;
+
+                unsigned endX = beginX + TileSize < m_width  ? beginX + TileSize : m_width;
+                unsigned endY = beginY + TileSize < m_height ? beginY + TileSize : m_height;
+
+                unsigned tileWidth = endX - beginX;
+
+                const float* offset = jitter[pass % jitterCount];
+
+                unsigned samples = tileSamples[tile] + 1;
+
+                bool changed = false;
+
+                for (unsigned h = beginY; h < endY; ++h)
                 {
-                    if (obj->doesIntersect(testRay))
+                    XYZ currentPixOffsetY =
+                        sampleOffsetY.scalarProduct(h + offset[1]);
+
+                    packet.clear();
+
+                    for (unsigned w = beginX; w < endX; ++w)
                     {
-                        std::cout << "#";
+                        XYZ currentPixOffsetX =
+                            sampleOffsetX.scalarProduct(w + offset[0]);
+                        XYZ currentPos        = (currentPixOffsetX.add(currentPixOffsetY)).add(m_viewport.m_corner);
+
+                        packet.push_back(Ray(currentPos, m_camera));
                     }
-                    else
+
+                    m_scene.doesIntersect(packet.data(), packet.size(), hits);
+
+                    //the pixel writes batch up behind the packet, pixel
+                    //value is the fraction of this tile's samples so far
+                    //that hit something
+                    for (unsigned w = beginX; w < endX; ++w)
                     {
-                        std::cout << " ";
+                        float& count = hitCounts[h*m_width + w];
+
+                        if (hits[w - beginX]) count += 1.0f;
+
+                        unsigned value =
+                            (unsigned)(255.0f*count/samples + 0.5f);
+
+                        if (pass > 0 && image.getPixel(w, h).red != value)
+                        {
+                            changed = true;
+                        }
+
+                        ImageFile::Pixel& pixel =
+                            tilePixels[(h - beginY)*tileWidth + (w - beginX)];
+
+                        pixel.red   = value;
+                        pixel.green = value;
+                        pixel.blue  = value;
+                        pixel.alpha = 255;
                     }
                 }
 
+                tileSamples[tile] = samples;
+
+                //one commit per finished tile
+                image.setTile(beginX, beginY, tileWidth, endY - beginY,
+                    tilePixels.data());
+
+                //a pass that moved no pixel means the tile has settled
+                if (pass > 0 && !changed)
+                {
+                    converged[tile] = 1;
+                    ++convergedTiles;
+                }
+            }
+        };
+
+        unsigned workerCount = std::thread::hardware_concurrency();
+
+        if (workerCount == 0) workerCount = 1;
+        if (workerCount > tileCount) workerCount = tileCount;
+
+        for (unsigned pass = 0; pass < maxPasses; ++pass)
+        {
+            //everything settled, later passes would claim tiles and skip
+            //every one of them
+            if (convergedTiles.load() == tileCount) break;
+
+            nextTile.store(0);
+
+            std::vector<std::thread> workers;
+
+            for (unsigned i = 1; i < workerCount; ++i)
+            {
+                workers.push_back(std::thread(renderTiles, pass));
+            }
+
+            //this thread is a worker too
+            renderTiles(pass);
+
+            for (std::vector<std::thread>::iterator worker = workers.begin();
+                worker != workers.end(); ++worker)
+            {
+                worker->join();
             }
-            std::cout << "\n";
         }
     }
 }
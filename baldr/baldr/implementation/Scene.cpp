@@ -0,0 +1,443 @@
+/*! \file   Scene.cpp
+        \date   Saturday August 29, 2026
+        \author Sudnya Diamos <mailsudnya@gmail.com>
+        \brief  The implementation file for the Scene class
+
+*/
+
+// Standard Library Includes
+#include <algorithm>
+//other includes
+#include <baldr/include/Scene.h>
+//Forward declarations
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace baldr
+{
+    //keep leaves small enough that the linear scan inside one is cheap
+    static const unsigned MaxObjectsInLeaf = 8;
+    //a middle split halves the range, so this bounds the traversal stack
+    static const unsigned MaxDepth = 60;
+
+    static float centroidComponent(SceneObjects::Sphere& object, unsigned axis)
+    {
+        XYZ centroid = object.getBounds().centroid();
+
+        if (axis == 0) return centroid.getX();
+        if (axis == 1) return centroid.getY();
+
+        return centroid.getZ();
+    }
+
+    unsigned Scene::buildNode(std::vector<unsigned>& order,
+        unsigned begin, unsigned end, unsigned depth)
+    {
+        unsigned index = m_nodes.size();
+        m_nodes.push_back(FlatNode());
+
+        unsigned count = end - begin;
+
+        BoundingBox bounds;
+        BoundingBox centroidBounds;
+
+        for (unsigned i = begin; i < end; ++i)
+        {
+            BoundingBox objectBounds = m_objects[order[i]].getBounds();
+            XYZ centroid = objectBounds.centroid();
+
+            bounds.expand(objectBounds);
+            centroidBounds.expand(BoundingBox(centroid, centroid));
+        }
+
+        m_nodes[index].m_bounds = bounds;
+
+        //the depth check keeps a degenerate SAH chain from outrunning the
+        //traversal stack
+        if (count <= 2 || depth >= MaxDepth)
+        {
+            m_nodes[index].m_firstObject = begin;
+            m_nodes[index].m_objectCount = count;
+
+            return index;
+        }
+
+        //split along the widest centroid axis
+        XYZ extent = centroidBounds.getMax().subtract(centroidBounds.getMin());
+
+        unsigned axis = 0;
+        float axisExtent = extent.getX();
+
+        if (extent.getY() > axisExtent) { axis = 1; axisExtent = extent.getY(); }
+        if (extent.getZ() > axisExtent) { axis = 2; axisExtent = extent.getZ(); }
+
+        unsigned mid = begin + count/2;
+
+        float parentArea = bounds.surfaceArea();
+
+        if (axisExtent > 0.0f && parentArea > 0.0f)
+        {
+            std::sort(order.begin() + begin, order.begin() + end,
+                [&](unsigned left, unsigned right)
+                {
+                    return centroidComponent(m_objects[left], axis) <
+                        centroidComponent(m_objects[right], axis);
+                });
+
+            //sweep the sorted objects, measuring the SAH cost of every
+            //possible split
+            std::vector<float> rightArea(count);
+
+            BoundingBox running;
+
+            for (unsigned i = count - 1; i > 0; --i)
+            {
+                running.expand(m_objects[order[begin + i]].getBounds());
+                rightArea[i] = running.surfaceArea();
+            }
+
+            running = BoundingBox();
+
+            float bestCost  = 1e30f;
+            unsigned bestSplit = count/2;
+
+            for (unsigned i = 1; i < count; ++i)
+            {
+                running.expand(m_objects[order[begin + i - 1]].getBounds());
+
+                float cost = 0.125f + (i*running.surfaceArea()
+                    + (count - i)*rightArea[i]) / parentArea;
+
+                if (cost < bestCost)
+                {
+                    bestCost  = cost;
+                    bestSplit = i;
+                }
+            }
+
+            //splitting has to beat testing every object right here
+            if (bestCost >= (float)count && count <= MaxObjectsInLeaf)
+            {
+                m_nodes[index].m_firstObject = begin;
+                m_nodes[index].m_objectCount = count;
+
+                return index;
+            }
+
+            mid = begin + bestSplit;
+        }
+
+        //the first child lands right after this node in the array, only
+        //the second child's position needs to be remembered
+        buildNode(order, begin, mid, depth + 1);
+
+        unsigned secondChild = buildNode(order, mid, end, depth + 1);
+
+        m_nodes[index].m_objectCount = 0;
+        m_nodes[index].m_secondChild = secondChild;
+
+        return index;
+    }
+
+    void Scene::build()
+    {
+        m_nodes.clear();
+
+        if (m_objects.empty()) return;
+
+        std::vector<unsigned> order(m_objects.size());
+
+        for (unsigned i = 0; i < order.size(); ++i) order[i] = i;
+
+        m_nodes.reserve(2*m_objects.size());
+
+        buildNode(order, 0, m_objects.size(), 0);
+
+        //reorder the objects so that every leaf covers a contiguous range
+        ObjectsInScene sorted;
+        sorted.reserve(m_objects.size());
+
+        for (unsigned i = 0; i < order.size(); ++i)
+        {
+            sorted.push_back(m_objects[order[i]]);
+        }
+
+        m_objects.swap(sorted);
+
+        //mirror the sphere data into structure of arrays form so that the
+        //leaf kernel loads whole vectors of centres and radii
+        m_centreX.resize(m_objects.size());
+        m_centreY.resize(m_objects.size());
+        m_centreZ.resize(m_objects.size());
+        m_radiusSquared.resize(m_objects.size());
+
+        for (unsigned i = 0; i < m_objects.size(); ++i)
+        {
+            XYZ centre = m_objects[i].getCentre();
+            float radius = m_objects[i].getRadius();
+
+            m_centreX[i] = centre.getX();
+            m_centreY[i] = centre.getY();
+            m_centreZ[i] = centre.getZ();
+            m_radiusSquared[i] = radius*radius;
+        }
+    }
+
+    bool Scene::intersectLeaf(unsigned first, unsigned count,
+        const RayValues& ray)
+    {
+        unsigned i = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        //eight spheres per iteration against the one ray
+        __m256 startX = _mm256_set1_ps(ray.m_startX);
+        __m256 startY = _mm256_set1_ps(ray.m_startY);
+        __m256 startZ = _mm256_set1_ps(ray.m_startZ);
+
+        __m256 directionX = _mm256_set1_ps(ray.m_directionX);
+        __m256 directionY = _mm256_set1_ps(ray.m_directionY);
+        __m256 directionZ = _mm256_set1_ps(ray.m_directionZ);
+
+        __m256 inverseLengthSquared =
+            _mm256_set1_ps(ray.m_inverseLengthSquared);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 toCentreX = _mm256_sub_ps(
+                _mm256_loadu_ps(&m_centreX[first + i]), startX);
+            __m256 toCentreY = _mm256_sub_ps(
+                _mm256_loadu_ps(&m_centreY[first + i]), startY);
+            __m256 toCentreZ = _mm256_sub_ps(
+                _mm256_loadu_ps(&m_centreZ[first + i]), startZ);
+
+            __m256 projection = _mm256_fmadd_ps(toCentreX, directionX,
+                _mm256_fmadd_ps(toCentreY, directionY,
+                    _mm256_mul_ps(toCentreZ, directionZ)));
+
+            __m256 t = _mm256_mul_ps(projection, inverseLengthSquared);
+
+            //toCentre - t*direction is the offset from the closest point
+            //on the ray line to the centre
+            __m256 offsetX = _mm256_fnmadd_ps(t, directionX, toCentreX);
+            __m256 offsetY = _mm256_fnmadd_ps(t, directionY, toCentreY);
+            __m256 offsetZ = _mm256_fnmadd_ps(t, directionZ, toCentreZ);
+
+            __m256 distanceSquared = _mm256_fmadd_ps(offsetX, offsetX,
+                _mm256_fmadd_ps(offsetY, offsetY,
+                    _mm256_mul_ps(offsetZ, offsetZ)));
+
+            __m256 hits = _mm256_cmp_ps(distanceSquared,
+                _mm256_loadu_ps(&m_radiusSquared[first + i]), _CMP_LE_OQ);
+
+            if (_mm256_movemask_ps(hits) != 0) return true;
+        }
+#endif
+
+        //the scalar loop covers the tail, and everything when AVX2 is not
+        //compiled in - it is branch free per sphere and auto vectorizes
+        for (; i < count; ++i)
+        {
+            float toCentreX = m_centreX[first + i] - ray.m_startX;
+            float toCentreY = m_centreY[first + i] - ray.m_startY;
+            float toCentreZ = m_centreZ[first + i] - ray.m_startZ;
+
+            float projection = toCentreX*ray.m_directionX
+                + toCentreY*ray.m_directionY + toCentreZ*ray.m_directionZ;
+
+            float t = projection * ray.m_inverseLengthSquared;
+
+            float offsetX = toCentreX - t*ray.m_directionX;
+            float offsetY = toCentreY - t*ray.m_directionY;
+            float offsetZ = toCentreZ - t*ray.m_directionZ;
+
+            float distanceSquared = offsetX*offsetX + offsetY*offsetY
+                + offsetZ*offsetZ;
+
+            if (distanceSquared <= m_radiusSquared[first + i]) return true;
+        }
+
+        return false;
+    }
+
+    Scene::RayValues Scene::rayValues(const Ray& R)
+    {
+        XYZ start     = R.getRayStart();
+        XYZ direction = R.getRayEquation();
+
+        float lengthSquared = direction.dotProduct(direction);
+
+        RayValues ray;
+
+        ray.m_startX = start.getX();
+        ray.m_startY = start.getY();
+        ray.m_startZ = start.getZ();
+
+        ray.m_directionX = direction.getX();
+        ray.m_directionY = direction.getY();
+        ray.m_directionZ = direction.getZ();
+
+        //a zero direction degenerates to testing the start point itself
+        ray.m_inverseLengthSquared =
+            lengthSquared == 0.0f ? 0.0f : 1.0f / lengthSquared;
+
+        return ray;
+    }
+
+    bool Scene::intersectExotic(const Ray& R)
+    {
+        //shapes outside the closed set pay the virtual call, they are
+        //expected to be a handful per scene
+        for (ExoticObjects::iterator obj = m_exoticObjects.begin();
+            obj != m_exoticObjects.end(); ++obj)
+        {
+            if ((*obj)->doesIntersect(R)) return true;
+        }
+
+        return false;
+    }
+
+    bool Scene::doesIntersect(const Ray& R)
+    {
+        //an unbuilt scene falls back to the linear scan
+        if (m_nodes.empty())
+        {
+            for (ObjectsInScene::iterator obj = m_objects.begin();
+                obj != m_objects.end(); ++obj)
+            {
+                if (obj->doesIntersect(R)) return true;
+            }
+
+            return intersectExotic(R);
+        }
+
+        //hoist the per ray values out of the leaf kernel
+        RayValues ray = rayValues(R);
+
+        unsigned stack[MaxDepth + 4];
+        unsigned stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            unsigned index = stack[--stackSize];
+
+            FlatNode& node = m_nodes[index];
+
+            if (!node.m_bounds.doesIntersect(R)) continue;
+
+            if (node.m_objectCount != 0)
+            {
+                if (intersectLeaf(node.m_firstObject, node.m_objectCount,
+                    ray))
+                {
+                    return true;
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.m_secondChild;
+                stack[stackSize++] = index + 1;
+            }
+        }
+
+        return intersectExotic(R);
+    }
+
+    void Scene::doesIntersect(const Ray* rays, unsigned count, bool* hits)
+    {
+        for (unsigned i = 0; i < count; ++i) hits[i] = false;
+
+        //oversized packets and unbuilt scenes take the single ray path
+        if (m_nodes.empty() || count > MaxPacketSize)
+        {
+            for (unsigned i = 0; i < count; ++i)
+            {
+                hits[i] = doesIntersect(rays[i]);
+            }
+
+            return;
+        }
+
+        RayValues values[MaxPacketSize];
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            values[i] = rayValues(rays[i]);
+        }
+
+        unsigned unresolved = count;
+
+        unsigned stack[MaxDepth + 4];
+        unsigned stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0 && unresolved > 0)
+        {
+            //once the packet thins out to one unresolved ray the packet
+            //overhead stops paying for itself, hand it to the single ray
+            //walk and let the tighter culling finish it
+            if (unresolved == 1)
+            {
+                for (unsigned i = 0; i < count; ++i)
+                {
+                    if (!hits[i]) hits[i] = doesIntersect(rays[i]);
+                }
+
+                return;
+            }
+
+            unsigned index = stack[--stackSize];
+
+            FlatNode& node = m_nodes[index];
+
+            //the node is loaded once, the packet descends if any ray
+            //that has not hit yet touches its bounds
+            bool anyTouches = false;
+
+            for (unsigned i = 0; i < count; ++i)
+            {
+                if (!hits[i] && node.m_bounds.doesIntersect(rays[i]))
+                {
+                    anyTouches = true;
+                    break;
+                }
+            }
+
+            if (!anyTouches) continue;
+
+            if (node.m_objectCount != 0)
+            {
+                for (unsigned i = 0; i < count; ++i)
+                {
+                    if (hits[i]) continue;
+
+                    if (intersectLeaf(node.m_firstObject,
+                        node.m_objectCount, values[i]))
+                    {
+                        hits[i] = true;
+                        --unresolved;
+                    }
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.m_secondChild;
+                stack[stackSize++] = index + 1;
+            }
+        }
+
+        //rays the hierarchy never resolved still have to see the shapes
+        //outside of it
+        if (!m_exoticObjects.empty())
+        {
+            for (unsigned i = 0; i < count; ++i)
+            {
+                if (!hits[i]) hits[i] = intersectExotic(rays[i]);
+            }
+        }
+    }
+}
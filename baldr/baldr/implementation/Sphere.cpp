@@ -29,16 +29,34 @@ namespace SceneObjects
         std::cout << "dist to pt in q = " << distanceToPointInQuestion << " radius "
             << m_radius << "\n";
         */
-        float rayMag = std::sqrt((R.getRayEquation().getX()*R.getRayEquation().getX())
-                +(R.getRayEquation().getY()*R.getRayEquation().getY())
-                +(R.getRayEquation().getZ()*R.getRayEquation().getZ()));
-        float centreMag = std::sqrt((m_centre.getX()*m_centre.getX())+(m_centre.getY()*m_centre.getY())+(m_centre.getZ()*m_centre.getZ()));
-        XYZ unitRay(R.getRayEquation().getX()/rayMag, R.getRayEquation().getY()/rayMag, R.getRayEquation().getZ()/rayMag);
-        XYZ pointInQuestion(unitRay.getX()*centreMag, unitRay.getY()*centreMag, unitRay.getZ()*centreMag);
+        //closest approach of the ray line to the centre, starting from the
+        //ray's actual start rather than the origin so that the test agrees
+        //with the bounding boxes used by the Scene hierarchy
+        XYZ direction = R.getRayEquation();
+        XYZ toCentre  = m_centre.subtract(R.getRayStart());
+
+        float lengthSquared = direction.dotProduct(direction);
+
+        if (lengthSquared == 0.0f)
+        {
+            return toCentre.dotProduct(toCentre) <= m_radius*m_radius;
+        }
+
+        float t = toCentre.dotProduct(direction) / lengthSquared;
+
+        XYZ pointInQuestion = R.getRayStart().addScaled(direction, t);
+
         float distanceToPointInQuestion = pointInQuestion.distance(m_centre);
 //        std::cout << "dist to pt in q = " << distanceToPointInQuestion << " radius "
 //            << m_radius << "\n";
         return distanceToPointInQuestion > m_radius ? 0 : 1;
     }
+
+    BoundingBox Sphere::getBounds()
+    {
+        XYZ extent(m_radius, m_radius, m_radius);
+
+        return BoundingBox(m_centre.subtract(extent), m_centre.add(extent));
+    }
 }
 }
@@ -0,0 +1,89 @@
+/*! \file   BoundingBox.h
+        \date   Saturday August 29, 2026
+        \author Sudnya Diamos <mailsudnya@gmail.com>
+        \brief  The header file for the BoundingBox class
+
+*/
+#pragma once
+// Standard Library Includes
+
+//other includes
+#include <baldr/include/XYZ.h>
+#include <baldr/include/Ray.h>
+// Forward Declarations
+
+namespace baldr
+{
+class BoundingBox
+{
+    public:
+        //an empty box, expanding it by anything gives that thing's box
+        BoundingBox() : m_min(1e30f, 1e30f, 1e30f), m_max(-1e30f, -1e30f, -1e30f) {};
+        BoundingBox(XYZ min, XYZ max) : m_min(min), m_max(max) {};
+
+        XYZ getMin() { return m_min; };
+        XYZ getMax() { return m_max; };
+
+        void expand(BoundingBox b)
+        {
+            if (b.getMin().getX() < m_min.getX()) m_min.setX(b.getMin().getX());
+            if (b.getMin().getY() < m_min.getY()) m_min.setY(b.getMin().getY());
+            if (b.getMin().getZ() < m_min.getZ()) m_min.setZ(b.getMin().getZ());
+            if (b.getMax().getX() > m_max.getX()) m_max.setX(b.getMax().getX());
+            if (b.getMax().getY() > m_max.getY()) m_max.setY(b.getMax().getY());
+            if (b.getMax().getZ() > m_max.getZ()) m_max.setZ(b.getMax().getZ());
+        };
+
+        XYZ centroid()
+        {
+            return (m_min.add(m_max)).scalarProduct(0.5f);
+        };
+
+        float surfaceArea()
+        {
+            XYZ d = m_max.subtract(m_min);
+            if (d.getX() < 0.0f || d.getY() < 0.0f || d.getZ() < 0.0f) return 0.0f;
+            return 2.0f*(d.getX()*d.getY() + d.getY()*d.getZ() + d.getZ()*d.getX());
+        };
+
+        //slab test against the ray treated as a full line, matching the
+        //way Sphere tests for intersection
+        bool doesIntersect(const Ray& R)
+        {
+            XYZ direction = R.getRayEquation();
+            XYZ start     = R.getRayStart();
+
+            float tMin = -1e30f;
+            float tMax =  1e30f;
+
+            float s[3] = { start.getX(),     start.getY(),     start.getZ()     };
+            float d[3] = { direction.getX(), direction.getY(), direction.getZ() };
+            float l[3] = { m_min.getX(),     m_min.getY(),     m_min.getZ()     };
+            float u[3] = { m_max.getX(),     m_max.getY(),     m_max.getZ()     };
+
+            for (unsigned axis = 0; axis < 3; ++axis)
+            {
+                if (d[axis] == 0.0f)
+                {
+                    if (s[axis] < l[axis] || s[axis] > u[axis]) return false;
+                    continue;
+                }
+
+                float tNear = (l[axis] - s[axis]) / d[axis];
+                float tFar  = (u[axis] - s[axis]) / d[axis];
+
+                if (tNear > tFar) { float t = tNear; tNear = tFar; tFar = t; }
+
+                if (tNear > tMin) tMin = tNear;
+                if (tFar  < tMax) tMax = tFar;
+
+                if (tMin > tMax) return false;
+            }
+
+            return true;
+        };
+
+    private:
+        XYZ m_min, m_max;
+};
+}
@@ -43,9 +43,27 @@ public:
 		unsigned int red, unsigned int green,
 		unsigned int blue, unsigned int alpha);
 
+	/*! \brief Copy a rectangle of pixels into the framebuffer at once
+
+		One call per tile is much cheaper than one setPixel call per
+		pixel, the rows are copied as whole spans. */
+	void setTile(unsigned int x, unsigned int y,
+		unsigned int width, unsigned int height, const Pixel* pixels);
+
+	Pixel getPixel(unsigned int x, unsigned int y);
+
 public:
+	/*! \brief Write the framebuffer out, the extension picks the format
+
+		A '.ppm' filename gets a raw PPM written as one binary write,
+		anything else gets a PNG.  Either way the pixels are staged in
+		memory first so the file write is one streaming pass. */
 	void write(const std::string& filename);
 
+private:
+	void _writePPM(const std::string& filename);
+	void _writePNG(const std::string& filename);
+
 private:
 	typedef std::vector<Pixel> PixelVector;
 
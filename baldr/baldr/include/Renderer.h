@@ -11,8 +11,10 @@
 //other includes
 //#include <baldr/include/Shape.h>
 #include <baldr/include/Sphere.h>
+#include <baldr/include/Scene.h>
 #include <baldr/include/XYZ.h>
 #include <baldr/include/Ray.h>
+#include <baldr/include/ImageFile.h>
 
 //Forward declarations
 
@@ -30,17 +32,30 @@ class Renderer
 {
     public:
         //typedef std::vector<SceneObjects::Shape*> ObjectsInScene;
-        typedef std::vector<SceneObjects::Sphere> ObjectsInScene;
+        typedef Scene::ObjectsInScene ObjectsInScene;
 
         Renderer(XYZ camera, Viewport viewport, unsigned width, unsigned height) :
             m_camera(camera), m_viewport(viewport), m_width(width), m_height(height) {};
         //void AddObjectToScene(SceneObjects::Shape s) { m_objects.push_back(s); };
-        void AddObjectToScene(SceneObjects::Sphere s) { m_objects.push_back(s); };
+        void AddObjectToScene(SceneObjects::Sphere s) { m_scene.addObject(s); };
+        //shapes outside the closed set, the scene does not own them
+        void AddObjectToScene(SceneObjects::Shape* s) { m_scene.addObject(s); };
 
         void renderScene();
 
+        //render in parallel, one cache sized tile of pixels per task
+        void renderScene(ImageFile& image);
+
+        /*! Render progressively, refining the image one pass at a time.
+
+            Every pass adds one jittered sample per pixel and a tile
+            whose pixels stop changing drops out of later passes, so
+            flat regions settle after two passes while edges keep
+            refining.  One pass is exactly the single pass renderer. */
+        void renderScene(ImageFile& image, unsigned maxPasses);
+
     private:
-        ObjectsInScene m_objects;
+        Scene m_scene;
         XYZ m_camera;
         Viewport m_viewport;
         unsigned m_width, m_height;
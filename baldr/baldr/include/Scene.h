@@ -0,0 +1,115 @@
+/*! \file   Scene.h
+        \date   Saturday August 29, 2026
+        \author Sudnya Diamos <mailsudnya@gmail.com>
+        \brief  The header file for the Scene class
+
+*/
+#pragma once
+// Standard Library Includes
+#include <vector>
+
+//other includes
+#include <baldr/include/Sphere.h>
+#include <baldr/include/BoundingBox.h>
+#include <baldr/include/Ray.h>
+
+//Forward declarations
+
+namespace baldr
+{
+/*! A container for scene objects behind a bounding volume hierarchy.
+
+    Objects are added one at a time, build() sorts them into an SAH built
+    hierarchy flattened into a contiguous node array, and doesIntersect()
+    answers ray queries by walking that array instead of the object list.
+
+    Spheres are the closed set of shapes the fast path knows about - they
+    are stored by value in packed arrays and the traversal loop never
+    makes a virtual call for them.  Anything else comes in through the
+    open Shape interface and is tested with a linear scan after the
+    hierarchy, which stays cheap as long as exotic shapes stay rare.
+*/
+class Scene
+{
+    public:
+        typedef std::vector<SceneObjects::Sphere> ObjectsInScene;
+        typedef std::vector<SceneObjects::Shape*> ExoticObjects;
+
+        void addObject(SceneObjects::Sphere s) { m_objects.push_back(s); };
+
+        //! Add a shape outside the closed set, the scene does not own it
+        void addObject(SceneObjects::Shape* s)
+            { m_exoticObjects.push_back(s); };
+
+        std::size_t objectCount()
+            { return m_objects.size() + m_exoticObjects.size(); };
+
+        //! Build the hierarchy, call once after all objects are added
+        void build();
+
+        //! Does the ray hit anything in the scene?
+        bool doesIntersect(const Ray& R);
+
+        //the widest packet a single query will take
+        static const unsigned MaxPacketSize = 64;
+
+        /*! Trace a packet of coherent rays together.
+
+            The packet walks the hierarchy once, testing each node against
+            the rays that are still unresolved and descending if any of
+            them touches it, so node data is loaded once per packet rather
+            than once per ray.  When the packet thins out to a single
+            unresolved ray it falls back to the single ray walk. */
+        void doesIntersect(const Ray* rays, unsigned count, bool* hits);
+
+    private:
+        //one node of the flattened hierarchy - children of an interior
+        //node are the next node in the array and m_secondChild
+        class FlatNode
+        {
+            public:
+                BoundingBox m_bounds;
+                unsigned    m_firstObject;
+                unsigned    m_objectCount; //0 for interior nodes
+                unsigned    m_secondChild;
+        };
+
+        typedef std::vector<FlatNode> FlatNodeVector;
+        typedef std::vector<float>    FloatVector;
+
+        //per ray values hoisted out of the leaf kernel
+        class RayValues
+        {
+            public:
+                float m_startX, m_startY, m_startZ;
+                float m_directionX, m_directionY, m_directionZ;
+                float m_inverseLengthSquared;
+        };
+
+    private:
+        unsigned buildNode(std::vector<unsigned>& order,
+            unsigned begin, unsigned end, unsigned depth);
+
+        //! Hoist the values the leaf kernel needs out of a ray
+        RayValues rayValues(const Ray& R);
+
+        //! Test the ray against a leaf's range of spheres, many at a time
+        bool intersectLeaf(unsigned first, unsigned count,
+            const RayValues& ray);
+
+        //! The virtual scan over everything outside the closed set
+        bool intersectExotic(const Ray& R);
+
+    private:
+        ObjectsInScene m_objects;
+        ExoticObjects  m_exoticObjects;
+        FlatNodeVector m_nodes;
+
+        //structure of arrays copies of the sphere data, in leaf order -
+        //the leaf kernel streams these eight lanes at a time
+        FloatVector m_centreX;
+        FloatVector m_centreY;
+        FloatVector m_centreZ;
+        FloatVector m_radiusSquared;
+};
+}
@@ -11,6 +11,7 @@
 #include <baldr/include/Shape.h>
 #include <baldr/include/XYZ.h>
 #include <baldr/include/Ray.h>
+#include <baldr/include/BoundingBox.h>
 // Forward Declarations
 
 namespace baldr
@@ -22,6 +23,11 @@ class Sphere : public Shape
     public:
         Sphere(float radius, XYZ centre) : m_radius(radius), m_centre(centre) {};
         virtual bool doesIntersect(const Ray& R);
+        //the axis aligned box enclosing the sphere, used to build the
+        //bounding volume hierarchy in Scene
+        BoundingBox getBounds();
+        float getRadius() { return m_radius; };
+        XYZ getCentre() { return m_centre; };
     //something specific to only spheres
     private:
         float m_radius;
@@ -1,26 +1,82 @@
 /*! \file   XYZ.h
         \date   Sunday March 18, 2012
         \author Sudnya Diamos <mailsudnya@gmail.com>
-        \brief  The header file for the XVZ class for 3 D coordinates 
+        \brief  The header file for the XVZ class for 3 D coordinates
 */
 #pragma once
+// Standard Library Includes
+#include <cmath>
+
 namespace baldr
 {
-class XYZ
+/*  Every operation in the renderer funnels through this class, so all of
+    the arithmetic lives in the header where it inlines into the callers
+    and stays in registers.  The padding byte from the alignment lets the
+    compiler move a whole XYZ with one aligned vector load. */
+class alignas(16) XYZ
 {
     public:
         XYZ(float X=0.0f, float Y=0.0f, float Z=0.0f) : m_x(X), m_y(Y), m_z(Z) {};
-        float dotProduct(XYZ v2);
-        XYZ crossProduct(XYZ v2);
-        XYZ scalarProduct(float k);
-        XYZ scalarDivide(float k);
-        XYZ add(XYZ v2);
-        XYZ subtract(XYZ v2);
-        float distance(XYZ v2);
-        float getX() { return m_x; };
-        float getY() { return m_y; };
-        float getZ() { return m_z; };
-        
+
+        float dotProduct(XYZ v2) const
+        {
+            return (m_x*v2.m_x) + (m_y*v2.m_y) + (m_z*v2.m_z);
+        };
+
+        XYZ crossProduct(XYZ v2) const
+        {
+            return XYZ((m_y*v2.m_z) - (m_z*v2.m_y),
+                       (m_z*v2.m_x) - (m_x*v2.m_z),
+                       (m_x*v2.m_y) - (m_y*v2.m_x));
+        };
+
+        XYZ scalarProduct(float k) const
+        {
+            return XYZ((m_x*k), (m_y*k), (m_z*k));
+        };
+
+        XYZ scalarDivide(float k) const
+        {
+            return XYZ((m_x/k), (m_y/k), (m_z/k));
+        };
+
+        XYZ add(XYZ v2) const
+        {
+            return XYZ((m_x + v2.m_x), (m_y + v2.m_y), (m_z + v2.m_z));
+        };
+
+        XYZ subtract(XYZ v2) const
+        {
+            return XYZ((m_x - v2.m_x), (m_y - v2.m_y), (m_z - v2.m_z));
+        };
+
+        //this + v2*k in one step, the compiler contracts each component
+        //into a fused multiply add when the target has one
+        XYZ addScaled(XYZ v2, float k) const
+        {
+            return XYZ((m_x + v2.m_x*k), (m_y + v2.m_y*k), (m_z + v2.m_z*k));
+        };
+
+        //this - v2*k, the mirrored fused form
+        XYZ subtractScaled(XYZ v2, float k) const
+        {
+            return XYZ((m_x - v2.m_x*k), (m_y - v2.m_y*k), (m_z - v2.m_z*k));
+        };
+
+        float lengthSquared() const
+        {
+            return dotProduct(*this);
+        };
+
+        float distance(XYZ v2) const
+        {
+            return std::sqrt(subtract(v2).lengthSquared());
+        };
+
+        float getX() const { return m_x; };
+        float getY() const { return m_y; };
+        float getZ() const { return m_z; };
+
         void setX(float x) { m_x = x; };
         void setY(float y) { m_y = y; };
         void setZ(float z) { m_z = z; };
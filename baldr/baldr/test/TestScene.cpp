@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <baldr/include/Scene.h>
+
+//The hierarchy has to agree with a linear scan over every object for any
+//ray, try a pile of random spheres against a pile of random rays.  The
+//packet query has to agree with the single ray query in turn.
+int main()
+{
+    std::cout << "Starting TestScene\n";
+
+    std::srand(0);
+
+    const unsigned sphereCount = 2000;
+    const unsigned rayCount    = 2000;
+
+    baldr::Scene scene;
+    baldr::Scene::ObjectsInScene objects;
+
+    for (unsigned i = 0; i < sphereCount; ++i)
+    {
+        baldr::XYZ centre(
+            (float)(std::rand() % 2000 - 1000) / 10.0f,
+            (float)(std::rand() % 2000 - 1000) / 10.0f,
+            (float)(std::rand() % 2000 - 1000) / 10.0f);
+
+        float radius = (float)(std::rand() % 100 + 1) / 50.0f;
+
+        baldr::SceneObjects::Sphere sphere(radius, centre);
+
+        scene.addObject(sphere);
+        objects.push_back(sphere);
+    }
+
+    scene.build();
+
+    unsigned hits = 0;
+
+    std::vector<baldr::Ray> rays;
+    std::vector<bool>       expected;
+
+    for (unsigned i = 0; i < rayCount; ++i)
+    {
+        baldr::XYZ start(
+            (float)(std::rand() % 2000 - 1000) / 10.0f,
+            (float)(std::rand() % 2000 - 1000) / 10.0f,
+            (float)(std::rand() % 2000 - 1000) / 10.0f);
+
+        baldr::XYZ direction(
+            (float)(std::rand() % 200 - 100) / 100.0f,
+            (float)(std::rand() % 200 - 100) / 100.0f,
+            (float)(std::rand() % 200 - 100) / 100.0f);
+
+        baldr::Ray ray(direction, start);
+
+        bool linear = false;
+
+        for (baldr::Scene::ObjectsInScene::iterator obj = objects.begin();
+            obj != objects.end(); ++obj)
+        {
+            if (obj->doesIntersect(ray)) { linear = true; break; }
+        }
+
+        if (scene.doesIntersect(ray) != linear)
+        {
+            std::cout << "FAILED: hierarchy disagrees with the linear "
+                "scan on ray " << i << "\n";
+            return 1;
+        }
+
+        if (linear) ++hits;
+
+        rays.push_back(ray);
+        expected.push_back(linear);
+    }
+
+    //the same rays again, bundled into packets this time
+    const unsigned packetSize = 32;
+
+    bool packetHits[packetSize];
+
+    for (unsigned i = 0; i < rayCount; i += packetSize)
+    {
+        unsigned count = rayCount - i < packetSize ? rayCount - i : packetSize;
+
+        scene.doesIntersect(&rays[i], count, packetHits);
+
+        for (unsigned j = 0; j < count; ++j)
+        {
+            if (packetHits[j] != expected[i + j])
+            {
+                std::cout << "FAILED: packet disagrees with the single "
+                    "ray query on ray " << (i + j) << "\n";
+                return 1;
+            }
+        }
+    }
+
+    //a shape added through the open interface has to be seen by both
+    //query paths, a sphere through a Shape pointer exercises it with
+    //known geometry
+    baldr::SceneObjects::Sphere exotic(30.0f, baldr::XYZ(0.0f, 0.0f, 0.0f));
+
+    scene.addObject((baldr::SceneObjects::Shape*)&exotic);
+
+    for (unsigned i = 0; i < rayCount; i += packetSize)
+    {
+        unsigned count = rayCount - i < packetSize ? rayCount - i : packetSize;
+
+        scene.doesIntersect(&rays[i], count, packetHits);
+
+        for (unsigned j = 0; j < count; ++j)
+        {
+            bool withExotic = expected[i + j]
+                || exotic.doesIntersect(rays[i + j]);
+
+            if (scene.doesIntersect(rays[i + j]) != withExotic
+                || packetHits[j] != withExotic)
+            {
+                std::cout << "FAILED: exotic shape missed on ray "
+                    << (i + j) << "\n";
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "Pass (" << hits << "/" << rayCount << " rays hit)\n";
+    return 0;
+}
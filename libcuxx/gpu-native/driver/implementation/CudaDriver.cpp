@@ -8,6 +8,7 @@
 #include <gpu-native/driver/interface/CudaDriver.h>
 
 #include <gpu-native/util/interface/Casts.h>
+#include <gpu-native/util/interface/Profiler.h>
 #include <gpu-native/util/interface/debug.h>
 
 // System Specific Includes
@@ -15,6 +16,8 @@
 
 // Standard Library Includes
 #include <stdexcept>
+#include <vector>
+#include <map>
 
 namespace gpunative
 {
@@ -22,6 +25,46 @@ namespace gpunative
 namespace driver
 {
 
+/*! Batched launch state for one function.  Parameter setup calls are
+	recorded here and coalesced into single driver calls when the launch
+	is issued, and state the driver already holds is never resent. */
+class PendingLaunch
+{
+public:
+	PendingLaunch()
+	: blockX(0), blockY(0), blockZ(0), blockShapeDirty(false),
+		sharedSize(0), sharedSizeDirty(false),
+		parameterSize(0), parameterSizeDirty(false), parametersDirty(false)
+	{
+
+	}
+
+public:
+	int  blockX;
+	int  blockY;
+	int  blockZ;
+	bool blockShapeDirty;
+
+	unsigned int sharedSize;
+	bool         sharedSizeDirty;
+
+	unsigned int parameterSize;
+	bool         parameterSizeDirty;
+
+	std::vector<char> parameters;
+	bool              parametersDirty;
+};
+
+typedef std::map<CUfunction, PendingLaunch>                    PendingLaunchMap;
+typedef std::map<std::pair<CUdevice_attribute, CUdevice>, int> AttributeMap;
+typedef std::map<std::pair<CUmodule, std::string>, CUfunction> FunctionMap;
+
+// Driver call overhead dominates a many small kernel launch pattern, so
+// repeated queries are answered from these caches instead of the driver
+static PendingLaunchMap pendingLaunches;
+static AttributeMap     attributeCache;
+static FunctionMap      functionCache;
+
 void CudaDriver::load()
 {
 	_interface.load();
@@ -34,6 +77,8 @@ bool CudaDriver::loaded()
 
 void CudaDriver::cuInit(unsigned int f)
 {
+	util::ProfilerZone zone("CudaDriver::cuInit");
+
 	_check();
 	
 	_checkResult((*_interface.cuInit)(f));
@@ -91,12 +136,26 @@ void CudaDriver::cuDeviceGetProperties(CUdevprop* p, CUdevice d)
 void CudaDriver::cuDeviceGetAttribute(int* p, CUdevice_attribute a, CUdevice d)
 {
 	_check();
-	
+
+	// device attributes never change, answer repeated queries locally
+	auto attribute = attributeCache.find(std::make_pair(a, d));
+
+	if(attribute != attributeCache.end())
+	{
+		*p = attribute->second;
+
+		return;
+	}
+
 	_checkResult((*_interface.cuDeviceGetAttribute)(p, a, d));
+
+	attributeCache.insert(std::make_pair(std::make_pair(a, d), *p));
 }
 
 void CudaDriver::cuCtxCreate(CUcontext* c, unsigned int f, CUdevice d)
 {
+	util::ProfilerZone zone("CudaDriver::cuCtxCreate");
+
 	_check();
 	
 	_checkResult((*_interface.cuCtxCreate)(c, f, d));
@@ -118,6 +177,8 @@ void CudaDriver::cuCtxDestroy(CUcontext c)
 
 void CudaDriver::cuCtxSynchronize(void)
 {
+	util::ProfilerZone zone("CudaDriver::cuCtxSynchronize");
+
 	_check();
 	
 	_checkResult((*_interface.cuCtxSynchronize)());
@@ -134,14 +195,84 @@ void CudaDriver::cuModuleLoadDataEx(CUmodule* m,
 void CudaDriver::cuModuleUnload(CUmodule h)
 {
 	_check();
-	
+
+	// function handles die with the module, and a later module may reuse
+	// them, so drop every cached handle and all batched launch state
+	for(auto function = functionCache.begin();
+		function != functionCache.end();)
+	{
+		if(function->first.first == h)
+		{
+			function = functionCache.erase(function);
+		}
+		else
+		{
+			++function;
+		}
+	}
+
+	pendingLaunches.clear();
+
 	_checkResult((*_interface.cuModuleUnload)(h));
 }
+bool CudaDriver::canLink()
+{
+	load();
+
+	return loaded() && _interface.cuLinkCreate != nullptr;
+}
+
+void CudaDriver::cuLinkCreate(unsigned int n, CUjit_option* o,
+	void** v, CUlinkState* s)
+{
+	_check();
+
+	_checkResult((*_interface.cuLinkCreate)(n, o, v, s));
+}
+
+void CudaDriver::cuLinkAddData(CUlinkState s, CUjitInputType t,
+	void* d, size_t size, const char* n, unsigned int numOptions,
+	CUjit_option* o, void** v)
+{
+	_check();
+
+	_checkResult((*_interface.cuLinkAddData)(s, t, d, size, n,
+		numOptions, o, v));
+}
+
+void CudaDriver::cuLinkComplete(CUlinkState s, void** c, size_t* size)
+{
+	util::ProfilerZone zone("CudaDriver::cuLinkComplete");
+
+	_check();
+
+	_checkResult((*_interface.cuLinkComplete)(s, c, size));
+}
+
+void CudaDriver::cuLinkDestroy(CUlinkState s)
+{
+	_check();
+
+	_checkResult((*_interface.cuLinkDestroy)(s));
+}
+
 void CudaDriver::cuModuleGetFunction(CUfunction* f, CUmodule m, const char* n)
 {
 	_check();
-	
+
+	auto function = functionCache.find(std::make_pair(m, std::string(n)));
+
+	if(function != functionCache.end())
+	{
+		*f = function->second;
+
+		return;
+	}
+
 	_checkResult((*_interface.cuModuleGetFunction)(f, m, n));
+
+	functionCache.insert(
+		std::make_pair(std::make_pair(m, std::string(n)), *f));
 }
 void CudaDriver::cuModuleGetGlobal(CUdeviceptr* p, 
 		size_t* b, CUmodule m, const char* n)
@@ -246,42 +377,123 @@ void CudaDriver::cuMemcpyDtoH(void* d, CUdeviceptr s,
 	_checkResult((*_interface.cuMemcpyDtoH)(d, s, b));
 }
 
-void CudaDriver::cuFuncSetBlockShape(CUfunction h, int x, 
+void CudaDriver::cuFuncSetBlockShape(CUfunction h, int x,
 	int y, int z)
 {
 	_check();
-	
-	_checkResult((*_interface.cuFuncSetBlockShape)(h, x, y, z));
+
+	PendingLaunch& pending = pendingLaunches[h];
+
+	// the driver holds this state across launches, only resend changes
+	if(pending.blockShapeDirty || pending.blockX != x ||
+		pending.blockY != y || pending.blockZ != z)
+	{
+		pending.blockX = x;
+		pending.blockY = y;
+		pending.blockZ = z;
+
+		pending.blockShapeDirty = true;
+	}
 }
 
 void CudaDriver::cuFuncSetSharedSize(CUfunction h, unsigned int b)
 {
 	_check();
-	
-	_checkResult((*_interface.cuFuncSetSharedSize)(h, b));
+
+	PendingLaunch& pending = pendingLaunches[h];
+
+	if(pending.sharedSizeDirty || pending.sharedSize != b)
+	{
+		pending.sharedSize      = b;
+		pending.sharedSizeDirty = true;
+	}
 }
 
 void CudaDriver::cuParamSetSize(CUfunction h, unsigned int n)
 {
 	_check();
 
-	_checkResult((*_interface.cuParamSetSize)(h, n));
+	PendingLaunch& pending = pendingLaunches[h];
+
+	if(pending.parameterSizeDirty || pending.parameterSize != n)
+	{
+		pending.parameterSize      = n;
+		pending.parameterSizeDirty = true;
+	}
+
+	if(pending.parameters.size() < n)
+	{
+		pending.parameters.resize(n, 0);
+	}
 }
 
 void CudaDriver::cuParamSetv(CUfunction f, int o, void* p, unsigned int b)
 {
 	_check();
-	
-	_checkResult((*_interface.cuParamSetv)(f, o, p, b));
+
+	PendingLaunch& pending = pendingLaunches[f];
+
+	if(pending.parameters.size() < o + b)
+	{
+		pending.parameters.resize(o + b, 0);
+	}
+
+	std::memcpy(pending.parameters.data() + o, p, b);
+
+	pending.parametersDirty = true;
 }
 
 void CudaDriver::cuLaunchGrid (CUfunction f, int w, int h)
 {
 	_check();
-	
+
+	_flushLaunchState(f);
+
 	_checkResult((*_interface.cuLaunchGrid)(f, w, h));
 }
 
+void CudaDriver::_flushLaunchState(CUfunction f)
+{
+	auto pending = pendingLaunches.find(f);
+
+	if(pending == pendingLaunches.end()) return;
+
+	PendingLaunch& launch = pending->second;
+
+	if(launch.blockShapeDirty)
+	{
+		_checkResult((*_interface.cuFuncSetBlockShape)(f,
+			launch.blockX, launch.blockY, launch.blockZ));
+
+		launch.blockShapeDirty = false;
+	}
+
+	if(launch.sharedSizeDirty)
+	{
+		_checkResult((*_interface.cuFuncSetSharedSize)(f,
+			launch.sharedSize));
+
+		launch.sharedSizeDirty = false;
+	}
+
+	if(launch.parameterSizeDirty)
+	{
+		_checkResult((*_interface.cuParamSetSize)(f,
+			launch.parameterSize));
+
+		launch.parameterSizeDirty = false;
+	}
+
+	// every queued cuParamSetv collapses into this one coalesced call
+	if(launch.parametersDirty && !launch.parameters.empty())
+	{
+		_checkResult((*_interface.cuParamSetv)(f, 0,
+			launch.parameters.data(), launch.parameters.size()));
+	}
+
+	launch.parametersDirty = false;
+}
+
 void CudaDriver::cuEventCreate(CUevent* e, unsigned int f)
 {
 	_check();
@@ -305,6 +517,8 @@ void CudaDriver::cuEventQuery(CUevent e)
 
 void CudaDriver::cuEventSynchronize(CUevent e)
 {
+	util::ProfilerZone zone("CudaDriver::cuEventSynchronize");
+
 	_check();
 	
 	_checkResult((*_interface.cuEventSynchronize)(e));
@@ -365,7 +579,12 @@ std::string CudaDriver::toString(CUresult result)
 bool CudaDriver::doesFunctionExist(CUmodule m, const char* n)
 {
 	_check();
-	
+
+	if(functionCache.count(std::make_pair(m, std::string(n))) != 0)
+	{
+		return true;
+	}
+
 	CUfunction f;
 
 	CUresult result = (*_interface.cuModuleGetFunction)(&f, m, n);
@@ -374,7 +593,29 @@ bool CudaDriver::doesFunctionExist(CUmodule m, const char* n)
 	{
 		return false;
 	}
-	
+
+	_checkResult(result);
+
+	functionCache.insert(
+		std::make_pair(std::make_pair(m, std::string(n)), f));
+
+	return true;
+}
+
+bool CudaDriver::doesGlobalExist(CUmodule m, const char* n)
+{
+	_check();
+
+	CUdeviceptr pointer = 0;
+	size_t      bytes   = 0;
+
+	CUresult result = (*_interface.cuModuleGetGlobal)(&pointer, &bytes, m, n);
+
+	if(result == CUDA_ERROR_NOT_FOUND)
+	{
+		return false;
+	}
+
 	_checkResult(result);
 
 	return true;
@@ -473,6 +714,15 @@ void CudaDriver::Interface::load()
 	DynLink(cuModuleUnload);
 	DynLink(cuModuleGetFunction);
 	DynLink(cuModuleGetGlobal);
+
+	// the linker entry points are missing from older drivers, callers
+	// check canLink() before using them
+	#define DynLinkOptional( function ) util::bit_cast(function, dlsym(_library, #function))
+
+	DynLinkOptional(cuLinkCreate);
+	DynLinkOptional(cuLinkAddData);
+	DynLinkOptional(cuLinkComplete);
+	DynLinkOptional(cuLinkDestroy);
 	DynLink(cuFuncSetBlockShape);
 	DynLink(cuFuncSetSharedSize);
 
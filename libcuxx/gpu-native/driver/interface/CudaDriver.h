@@ -76,9 +76,27 @@ public:
 	static void cuModuleUnload(CUmodule hmod);
 	static void cuModuleGetFunction(CUfunction* hfunc, 
 		CUmodule hmod, const char* name);
-	static void cuModuleGetGlobal(CUdeviceptr* dptr, 
+	static void cuModuleGetGlobal(CUdeviceptr* dptr,
 		size_t* bytes, CUmodule hmod, const char* name);
 
+	/************************************
+	**
+	**    Linker - a JIT whose compiled output can be retrieved
+	**
+	***********************************/
+
+	/*! \brief Are the linker entry points available in the driver? */
+	static bool canLink();
+
+	static void cuLinkCreate(unsigned int numOptions, CUjit_option* options,
+		void** optionValues, CUlinkState* stateOut);
+	static void cuLinkAddData(CUlinkState state, CUjitInputType type,
+		void* data, size_t size, const char* name, unsigned int numOptions,
+		CUjit_option* options, void** optionValues);
+	static void cuLinkComplete(CUlinkState state, void** cubinOut,
+		size_t* sizeOut);
+	static void cuLinkDestroy(CUlinkState state);
+
 	/************************************
 	**
 	**    Memory management
@@ -184,11 +202,15 @@ public:
 	**
 	***********************************/
 	static bool doesFunctionExist(CUmodule hmod, const char* name);
+	static bool doesGlobalExist(CUmodule hmod, const char* name);
 
 private:
 	static void _check();
 	static void _checkResult(CUresult);
 
+	/*! \brief Issue the batched function state ahead of a launch */
+	static void _flushLaunchState(CUfunction f);
+
 private:
 	class Interface
 	{
@@ -218,8 +240,18 @@ private:
 		CUresult (*cuModuleUnload)(CUmodule hmod);
 		CUresult (*cuModuleGetFunction)(CUfunction* hfunc, 
 			CUmodule hmod, const char* name);
-		CUresult (*cuModuleGetGlobal)(CUdeviceptr* dptr, 
+		CUresult (*cuModuleGetGlobal)(CUdeviceptr* dptr,
 			size_t* bytes, CUmodule hmod, const char* name);
+		CUresult (*cuLinkCreate)(unsigned int numOptions,
+			CUjit_option* options, void** optionValues,
+			CUlinkState* stateOut);
+		CUresult (*cuLinkAddData)(CUlinkState state, CUjitInputType type,
+			void* data, size_t size, const char* name,
+			unsigned int numOptions, CUjit_option* options,
+			void** optionValues);
+		CUresult (*cuLinkComplete)(CUlinkState state, void** cubinOut,
+			size_t* sizeOut);
+		CUresult (*cuLinkDestroy)(CUlinkState state);
 		CUresult (*cuFuncSetBlockShape)(CUfunction hfunc, int x, 
 			int y, int z);
 		CUresult (*cuFuncSetSharedSize)(CUfunction hfunc, 
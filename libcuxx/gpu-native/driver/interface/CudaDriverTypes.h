@@ -18,6 +18,7 @@ typedef int CUdevice;
 typedef int CUdevice_attribute;
 
 typedef struct CUctx_st*     CUcontext;
+typedef struct CUlinkState_st* CUlinkState;
 typedef struct CUmod_st*     CUmodule;
 typedef struct CUfunc_st*    CUfunction;
 typedef struct CUevent_st*   CUevent;
@@ -493,6 +494,42 @@ typedef enum CUjit_option_enum
 
 } CUjit_option;
 
+typedef enum CUjitInputType_enum
+{
+    /**
+     * Compiled device-class-specific device code\n
+     * Applicable options: none
+     */
+    CU_JIT_INPUT_CUBIN = 0,
+
+    /**
+     * PTX source code\n
+     * Applicable options: PTX compiler options
+     */
+    CU_JIT_INPUT_PTX,
+
+    /**
+     * Bundle of multiple cubins and/or PTX of some device code\n
+     * Applicable options: PTX compiler options, ::CU_JIT_FALLBACK_STRATEGY
+     */
+    CU_JIT_INPUT_FATBINARY,
+
+    /**
+     * Host object with embedded device code\n
+     * Applicable options: PTX compiler options, ::CU_JIT_FALLBACK_STRATEGY
+     */
+    CU_JIT_INPUT_OBJECT,
+
+    /**
+     * Archive of host objects with embedded device code\n
+     * Applicable options: PTX compiler options, ::CU_JIT_FALLBACK_STRATEGY
+     */
+    CU_JIT_INPUT_LIBRARY,
+
+    CU_JIT_NUM_INPUT_TYPES
+
+} CUjitInputType;
+
 }
 
 }
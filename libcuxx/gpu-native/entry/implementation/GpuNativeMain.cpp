@@ -73,3 +73,31 @@ extern int gpuNativeMain(int argc, const char** argv)
 	return loader.getReturnValue();
 }
 
+extern int gpuNativeServerMain()
+{
+	#ifdef NDEBUG
+	bool verbose = false;
+	#else
+	bool verbose = true;
+	#endif
+
+	if(verbose)
+	{
+		gpunative::util::enableAllLogs();
+	}
+
+	gpunative::runtime::LoaderServer server;
+
+	try
+	{
+		server.serve(std::cin, std::cout);
+	}
+	catch(const std::exception& e)
+	{
+		std::cout << "Warm instance failed: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
+
@@ -10,5 +10,9 @@ extern void setEmbeddedPTX(const char* ptx);
 extern const char* getEmbeddedPTX();
 extern int gpuNativeMain(int argc, const char** argv);
 
+/*! Stay resident with the driver warm and binaries cached on the device,
+	serving launch requests from stdin until it closes */
+extern int gpuNativeServerMain();
+
 
 
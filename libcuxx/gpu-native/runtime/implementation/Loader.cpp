@@ -6,19 +6,32 @@
 
 // GPU Native Includes
 #include <gpu-native/runtime/interface/Loader.h>
+#include <gpu-native/runtime/interface/StdioRing.h>
 
 #include <gpu-native/driver/interface/CudaDriver.h>
 
 #include <gpu-native/entry/interface/GpuNativeMain.h>
 
 #include <gpu-native/util/interface/Casts.h>
+#include <gpu-native/util/interface/Knobs.h>
+#include <gpu-native/util/interface/Profiler.h>
 #include <gpu-native/util/interface/debug.h>
+#include <gpu-native/util/interface/paths.h>
 #include <gpu-native/util/interface/string.h>
 
+// System Specific Includes
+#include <sys/stat.h>
+
 // Standard Library Includes
 #include <fstream>
+#include <future>
+#include <map>
 #include <stdexcept>
 #include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <sstream>
 
 namespace gpunative
 {
@@ -43,8 +56,12 @@ class LoaderState
 {
 public:
 	LoaderState(const std::string& path, const StringVector& arguments, bool isEmbedded);
+	/*! \brief Construct over a warm context and an already resident
+		module, the caller keeps ownership of both */
+	LoaderState(const std::string& path, const StringVector& arguments,
+		driver::CUcontext context, driver::CUmodule module);
 	~LoaderState();
-	
+
 public:
 	void runBinary();
 
@@ -58,6 +75,7 @@ private:
 
 private:
 	void _loadState();
+	void _loadFunctions();
 	void _runGlobalConstructors();
 	void _runMain();
 
@@ -75,6 +93,7 @@ private:
 	bool         _isEmbedded;
 
 	CUcontext    _context;
+	bool         _ownsContext;
 	CUmodule     _module;
 	CUfunction   _main;
 	CUfunction   _init;
@@ -88,6 +107,9 @@ private:
 
 	int                 _returnValue;
 	driver::CUdeviceptr _returnValuePointer;
+
+private:
+	std::unique_ptr<StdioRing> _stdioRing;
 };
 
 void Loader::loadBinary()
@@ -112,21 +134,41 @@ int Loader::getReturnValue() const
 }
 
 LoaderState::LoaderState(const std::string& p, const StringVector& a, bool isEmbedded)
-: _path(p), _arguments(a), _isEmbedded(isEmbedded), _context(0), _returnValue(-1)
+: _path(p), _arguments(a), _isEmbedded(isEmbedded), _context(0),
+	_ownsContext(true), _returnValue(-1)
 {
 	_loadState();
 }
 
+LoaderState::LoaderState(const std::string& p, const StringVector& a,
+	driver::CUcontext context, driver::CUmodule module)
+: _path(p), _arguments(a), _isEmbedded(false), _context(context),
+	_ownsContext(false), _module(module), _returnValue(-1)
+{
+	// the driver is already initialized and the module resident, only
+	// the per-launch function state is set up
+	_loadFunctions();
+}
+
 LoaderState::~LoaderState()
 {
-	driver::CudaDriver::cuCtxDestroy(_context);
+	if(_ownsContext)
+	{
+		driver::CudaDriver::cuCtxDestroy(_context);
+	}
 }
 
 void LoaderState::runBinary()
 {
+	// Drain device stdio while the kernels run
+	_stdioRing->start();
+
 	_runGlobalConstructors();
 	_runMain();
 
+	// _runMain already synchronized, this only drains the stragglers
+	_stdioRing->stop();
+
 	util::log("Loader") << "Successfully ran binary, exiting...." << "\n";
 }
 
@@ -352,10 +394,11 @@ static std::string loadBinary(const std::string& path)
 	return result;
 }
 
-static void loadModule(driver::CUmodule& module, const std::string& binary)
+static void loadModuleFromImage(driver::CUmodule& module,
+	const std::string& binary)
 {
 	util::log("Loader") << "Loading module from binary data.\n";
-	
+
 	driver::CUjit_option options[] = {
 	//	CU_JIT_TARGET,
 		driver::CU_JIT_ERROR_LOG_BUFFER, 
@@ -391,6 +434,175 @@ static void loadModule(driver::CUmodule& module, const std::string& binary)
 	
 }
 
+static uint64_t hashBinary(const std::string& binary)
+{
+	// FNV-1a, the cache key only needs to change when the text changes
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for(auto character : binary)
+	{
+		hash ^= (unsigned char)character;
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+static std::string getJitCacheDirectory()
+{
+	const char* home = std::getenv("HOME");
+
+	// an empty path disables the cache, read the string knob directly
+	// since the templated accessor cannot default construct a string
+	if(util::KnobDatabase::knobExists("Loader::JitCachePath"))
+	{
+		return util::KnobDatabase::getKnobValueAsString(
+			"Loader::JitCachePath");
+	}
+
+	return home == nullptr ? "" :
+		util::joinPaths(home, ".gpu-native/jit-cache");
+}
+
+static void makeDirectories(const std::string& path)
+{
+	for(size_t position = 1; position != std::string::npos;
+		position = path.find(util::separator(), position + 1))
+	{
+		mkdir(path.substr(0, position).c_str(), 0755);
+	}
+
+	mkdir(path.c_str(), 0755);
+}
+
+static bool readCachedModule(const std::string& path, std::string& image)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if(not file.is_open()) return false;
+
+	size_t size = getFileLength(file);
+
+	image.resize(size);
+
+	file.read(const_cast<char*>(image.data()), size);
+
+	return !file.fail();
+}
+
+static void writeCachedModule(const std::string& path,
+	const void* data, size_t size)
+{
+	// write to the side and rename so a concurrent run never sees a
+	// partial image, failures just mean the next run compiles again
+	std::string temporary = path + ".tmp";
+
+	std::ofstream file(temporary, std::ios::binary);
+
+	if(not file.is_open()) return;
+
+	file.write((const char*)data, size);
+
+	file.close();
+
+	if(file.fail() || std::rename(temporary.c_str(), path.c_str()) != 0)
+	{
+		std::remove(temporary.c_str());
+	}
+}
+
+static void loadModule(driver::CUmodule& module, const std::string& binary)
+{
+	util::ProfilerZone zone("Loader::loadModule");
+
+	// compiled cubins load without a JIT, only PTX is worth caching
+	if(!isPTX(binary) || !driver::CudaDriver::canLink())
+	{
+		loadModuleFromImage(module, binary);
+
+		return;
+	}
+
+	std::string directory = getJitCacheDirectory();
+
+	if(directory.empty())
+	{
+		loadModuleFromImage(module, binary);
+
+		return;
+	}
+
+	std::stringstream filename;
+
+	filename << std::hex << hashBinary(binary) << ".cubin";
+
+	std::string path = util::joinPaths(directory, filename.str());
+
+	std::string cachedImage;
+
+	if(readCachedModule(path, cachedImage))
+	{
+		util::log("Loader") << "Loading jitted module from cache '"
+			<< path << "'.\n";
+
+		try
+		{
+			loadModuleFromImage(module, cachedImage);
+
+			return;
+		}
+		catch(const std::exception& e)
+		{
+			util::log("Loader") << " cached module was stale, rejitting.\n";
+		}
+	}
+
+	// miss - jit through the linker, whose compiled output can be read
+	// back and persisted, unlike cuModuleLoadDataEx
+	try
+	{
+		driver::CUlinkState state = 0;
+
+		driver::CudaDriver::cuLinkCreate(0, nullptr, nullptr, &state);
+
+		try
+		{
+			driver::CudaDriver::cuLinkAddData(state,
+				driver::CU_JIT_INPUT_PTX,
+				const_cast<char*>(binary.c_str()), binary.size() + 1,
+				"module.ptx", 0, nullptr, nullptr);
+
+			void*  image     = nullptr;
+			size_t imageSize = 0;
+
+			driver::CudaDriver::cuLinkComplete(state, &image, &imageSize);
+
+			loadModuleFromImage(module,
+				std::string((const char*)image, imageSize));
+
+			makeDirectories(directory);
+			writeCachedModule(path, image, imageSize);
+		}
+		catch(...)
+		{
+			driver::CudaDriver::cuLinkDestroy(state);
+
+			throw;
+		}
+
+		driver::CudaDriver::cuLinkDestroy(state);
+
+		util::log("Loader") << "Cached jitted module at '" << path << "'.\n";
+	}
+	catch(const std::exception& e)
+	{
+		util::log("Loader") << " linker jit failed ("
+			<< e.what() << "), falling back to a direct load.\n";
+
+		loadModuleFromImage(module, binary);
+	}
+}
+
 static std::string getEmbeddedBinary()
 {
 	std::string result = getEmbeddedPTX();
@@ -404,31 +616,50 @@ static std::string getEmbeddedBinary()
 
 void LoaderState::_loadState()
 {
+	util::ProfilerZone zone("Loader::loadState");
+
+	// Reading and patching the binary is pure host work, overlap it with
+	// driver initialization and context creation on a worker thread
+	bool isEmbedded = _isEmbedded;
+	std::string path = _path;
+
+	auto binaryFuture = std::async(std::launch::async,
+		[=]()
+		{
+			util::ProfilerZone zone("Loader::loadBinary");
+
+			if(isEmbedded)
+			{
+				return getEmbeddedBinary();
+			}
+
+			return loadBinary(path);
+		});
+
 	util::log("Loader") << "Initializing CUDA driver.\n";
-	
+
 	driver::CudaDriver::cuInit(0);
-	
+
 	util::log("Loader") << "Creating context on device " << _getDevice()
 		<< ": name '" << _getDeviceName() << "'.\n";
-	
+
 	driver::CudaDriver::cuCtxCreate(&_context, 0, _getDevice());
-	
-	std::string binary;
 
-	if(_isEmbedded)
-	{
-		binary = getEmbeddedBinary();
-	}
-	else
-	{
-		binary = loadBinary(_path);
-	}
+	// Joins with the worker, rethrows any error from the load here
+	std::string binary = binaryFuture.get();
 
 	loadModule(_module, binary);
-	
+
+	_loadFunctions();
+}
+
+void LoaderState::_loadFunctions()
+{
+	_stdioRing = std::unique_ptr<StdioRing>(new StdioRing(_module));
+
 	util::log("Loader") << "Loading 'main' function from module.\n";
 	driver::CudaDriver::cuModuleGetFunction(&_main, _module, "_pre_main");
-	
+
 	util::log("Loader") << "Checking for global initialization function.\n";
 	if(driver::CudaDriver::doesFunctionExist(_module, "__cxx_global_var_init"))
 	{
@@ -445,6 +676,8 @@ void LoaderState::_loadState()
 
 void LoaderState::_runGlobalConstructors()
 {
+	util::ProfilerZone zone("Loader::runGlobalConstructors");
+
 	// Skip programs without global constructors
 	if(_init == 0) return;
 	
@@ -457,6 +690,8 @@ void LoaderState::_runGlobalConstructors()
 
 void LoaderState::_runMain()
 {
+	util::ProfilerZone zone("Loader::runMain");
+
 	util::log("Loader") << "Running 'main'.\n";
 
 	// Setup dimensions
@@ -598,8 +833,117 @@ std::string LoaderState::_getDeviceName()
 	char name[2048];
 
 	driver::CudaDriver::cuDeviceGetName(name, sizeof(name), _getDevice());
-	
-	return name;	
+
+	return name;
+}
+
+class LoaderServerState
+{
+public:
+	LoaderServerState();
+	~LoaderServerState();
+
+public:
+	void serve(std::istream& requests, std::ostream& responses);
+
+private:
+	typedef std::map<std::string, driver::CUmodule> ModuleMap;
+
+private:
+	/*! \brief Get the resident module for a binary, loading it on the
+		first request */
+	driver::CUmodule _getModule(const std::string& path);
+
+private:
+	driver::CUcontext _context;
+
+	/*! \brief Loaded binaries, they stay resident in device memory for
+		the life of the server */
+	ModuleMap _modules;
+};
+
+LoaderServerState::LoaderServerState()
+: _context(0)
+{
+	util::log("Loader") << "Starting warm instance.\n";
+
+	driver::CudaDriver::cuInit(0);
+
+	driver::CudaDriver::cuCtxCreate(&_context, 0, 0);
+}
+
+LoaderServerState::~LoaderServerState()
+{
+	driver::CudaDriver::cuCtxDestroy(_context);
+}
+
+driver::CUmodule LoaderServerState::_getModule(const std::string& path)
+{
+	auto module = _modules.find(path);
+
+	if(module != _modules.end())
+	{
+		util::log("Loader") << "Reusing resident module for '"
+			<< path << "'.\n";
+
+		return module->second;
+	}
+
+	driver::CUmodule loaded = 0;
+
+	loadModule(loaded, loadBinary(path));
+
+	_modules.insert(std::make_pair(path, loaded));
+
+	return loaded;
+}
+
+void LoaderServerState::serve(std::istream& requests, std::ostream& responses)
+{
+	std::string request;
+
+	while(std::getline(requests, request))
+	{
+		// one request per line, the binary path followed by its arguments
+		StringVector arguments = util::split(request, " ");
+
+		if(arguments.empty()) continue;
+
+		try
+		{
+			std::string path = arguments.front();
+
+			LoaderState state(path, arguments, _context, _getModule(path));
+
+			state.runBinary();
+
+			responses << "exit " << state.getReturnValue() << "\n";
+		}
+		catch(const std::exception& e)
+		{
+			responses << "error " << e.what() << "\n";
+		}
+
+		responses.flush();
+	}
+
+	util::log("Loader") << "Warm instance request stream ended, exiting.\n";
+}
+
+LoaderServer::LoaderServer()
+: _state(new LoaderServerState)
+{
+
+}
+
+LoaderServer::~LoaderServer()
+{
+
+}
+
+void LoaderServer::serve(std::istream& requests, std::ostream& responses)
+{
+	_state->serve(requests, responses);
 }
 
 }
@@ -0,0 +1,180 @@
+/*	\file   StdioRing.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the StdioRing class.
+*/
+
+// GPU Native Includes
+#include <gpu-native/runtime/interface/StdioRing.h>
+
+#include <gpu-native/driver/interface/CudaDriver.h>
+
+#include <gpu-native/util/interface/Knobs.h>
+#include <gpu-native/util/interface/debug.h>
+
+// Standard Library Includes
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace gpunative
+{
+
+namespace runtime
+{
+
+// The layout is shared with the device side in libc's stdio.cpp, keep
+// the two in sync: a 64 byte header (capacity at offset 0, head at
+// offset 8, tail at offset 16) followed by the payload.  Each record is
+// an 8 byte word (bit 63 commit, bit 32 stream, low 32 bits length) and
+// the payload bytes, rounded up to 8 bytes.
+static const size_t HeaderSize = 64;
+static const size_t HeadOffset = 8;
+static const size_t TailOffset = 16;
+
+static const uint64_t CommitFlag = 0x8000000000000000ULL;
+static const uint64_t StderrFlag = 0x0000000100000000ULL;
+
+static const char* RingSymbolName = "__gpunative_stdio_ring";
+
+static size_t getRingCapacity()
+{
+	size_t capacity = util::KnobDatabase::getKnobValue(
+		"Loader::StdioRingSize", (1 << 20));
+
+	// record offsets are 8 byte aligned, the capacity has to be too
+	return (capacity + 7) & ~(size_t)7;
+}
+
+StdioRing::StdioRing(driver::CUmodule module)
+: _enabled(false), _running(false)
+{
+	if(!driver::CudaDriver::doesGlobalExist(module, RingSymbolName))
+	{
+		util::log("StdioRing") << "Binary has no ring pointer global, "
+			"device stdio is left alone.\n";
+
+		return;
+	}
+
+	size_t capacity = getRingCapacity();
+
+	_buffer.assign(HeaderSize + capacity, 0);
+
+	*reinterpret_cast<uint64_t*>(_buffer.data()) = capacity;
+
+	driver::CudaDriver::cuMemHostRegister(_buffer.data(), _buffer.size(),
+		driver::CU_MEMHOSTREGISTER_DEVICEMAP);
+
+	driver::CUdeviceptr ringPointer = 0;
+
+	driver::CudaDriver::cuMemHostGetDevicePointer(&ringPointer,
+		_buffer.data(), 0);
+
+	driver::CUdeviceptr global = 0;
+	size_t              bytes  = 0;
+
+	driver::CudaDriver::cuModuleGetGlobal(&global, &bytes, module,
+		RingSymbolName);
+
+	driver::CudaDriver::cuMemcpyHtoD(global, &ringPointer,
+		sizeof(driver::CUdeviceptr));
+
+	util::log("StdioRing") << "Mapped a " << capacity
+		<< " byte stdio ring into the module.\n";
+
+	_enabled = true;
+}
+
+StdioRing::~StdioRing()
+{
+	stop();
+
+	if(_enabled)
+	{
+		driver::CudaDriver::cuMemHostUnregister(_buffer.data());
+	}
+}
+
+void StdioRing::start()
+{
+	if(!_enabled) return;
+
+	_running = true;
+
+	_drainer = std::thread(&StdioRing::_drain, this);
+}
+
+void StdioRing::stop()
+{
+	if(!_enabled || !_running) return;
+
+	_running = false;
+
+	_drainer.join();
+
+	// catch records committed after the drainer's last pass
+	while(_drainOnce());
+
+	std::fflush(stdout);
+	std::fflush(stderr);
+}
+
+void StdioRing::_drain()
+{
+	while(_running)
+	{
+		if(!_drainOnce())
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	}
+}
+
+bool StdioRing::_drainOnce()
+{
+	uint64_t capacity = *reinterpret_cast<uint64_t*>(_buffer.data());
+
+	volatile uint64_t* head = reinterpret_cast<volatile uint64_t*>(
+		_buffer.data() + HeadOffset);
+	volatile uint64_t* tail = reinterpret_cast<volatile uint64_t*>(
+		_buffer.data() + TailOffset);
+
+	char* payload = _buffer.data() + HeaderSize;
+
+	if(*head == *tail) return false;
+
+	volatile uint64_t* record = reinterpret_cast<volatile uint64_t*>(
+		payload + (*tail % capacity));
+
+	uint64_t word = *record;
+
+	// reserved but not committed yet, come back later
+	if((word & CommitFlag) == 0) return false;
+
+	size_t length = (uint32_t)word;
+
+	FILE* stream = (word & StderrFlag) ? stderr : stdout;
+
+	ByteVector text(length);
+
+	for(size_t i = 0; i < length; ++i)
+	{
+		text[i] = payload[(*tail + sizeof(uint64_t) + i) % capacity];
+	}
+
+	std::fwrite(text.data(), 1, length, stream);
+
+	// clear the word before publishing the space so that a lapped
+	// record is never mistaken for a committed one
+	*record = 0;
+
+	*tail += sizeof(uint64_t) + ((length + 7) & ~(uint64_t)7);
+
+	return true;
+}
+
+}
+
+}
+
@@ -10,6 +10,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <iosfwd>
 
 namespace gpunative
 {
@@ -18,6 +19,7 @@ namespace runtime
 {
 
 class LoaderState;
+class LoaderServerState;
 
 class Loader
 {
@@ -52,6 +54,33 @@ private:
 
 };
 
+/*! \brief A resident warm instance that serves successive launches.
+
+	The driver is initialized and the context created once when the
+	server starts, and every binary it loads stays resident in device
+	memory, so a request for a binary that ran before pays only for the
+	launch itself rather than for startup.  Requests arrive one per
+	line - a binary path followed by its arguments - and each is
+	answered with one 'exit <code>' or 'error <message>' line. */
+class LoaderServer
+{
+public:
+	LoaderServer();
+	~LoaderServer();
+
+public:
+	LoaderServer(const LoaderServer&) = delete;
+	LoaderServer& operator=(const LoaderServer&) = delete;
+
+public:
+	/*! \brief Serve launch requests until the stream ends. */
+	void serve(std::istream& requests, std::ostream& responses);
+
+private:
+	std::unique_ptr<LoaderServerState> _state;
+
+};
+
 }
 
 }
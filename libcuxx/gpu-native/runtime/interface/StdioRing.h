@@ -0,0 +1,71 @@
+/*	\file   StdioRing.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StdioRing class.
+*/
+
+#pragma once
+
+// GPU Native Includes
+#include <gpu-native/driver/interface/CudaDriverTypes.h>
+
+// Standard Library Includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gpunative
+{
+
+namespace runtime
+{
+
+/*! \brief A mapped ring buffer that carries device stdout/stderr records
+	to the host.
+
+	The device reserves space in the ring with an atomic add and commits
+	each record by flagging its header word.  A host thread drains
+	committed records to the matching host stream while the kernel is
+	still running, so device output is fire and forget - a writer only
+	ever waits when the ring is completely full.
+*/
+class StdioRing
+{
+public:
+	/*! \brief Map the ring and patch the module's ring pointer global.
+
+		A binary built without the device side of the ring is left
+		untouched and the ring stays disabled. */
+	StdioRing(driver::CUmodule module);
+	~StdioRing();
+
+public:
+	StdioRing(const StdioRing&) = delete;
+	StdioRing& operator=(const StdioRing&) = delete;
+
+public:
+	/*! \brief Start the drainer thread. */
+	void start();
+
+	/*! \brief Drain whatever is left and stop the drainer thread. */
+	void stop();
+
+private:
+	void _drain();
+	bool _drainOnce();
+
+private:
+	typedef std::vector<char> ByteVector;
+
+private:
+	bool       _enabled;
+	ByteVector _buffer;
+
+	std::thread       _drainer;
+	std::atomic<bool> _running;
+};
+
+}
+
+}
+
@@ -9,6 +9,7 @@
 #include <gpu-native/util/interface/ArgumentParser.h>
 
 // Standard Library Includes
+#include <iostream>
 #include <string>
 #include <stdexcept>
 
@@ -42,6 +43,20 @@ static void runBinary(const std::string& inputBinaryPath,
 	}
 }
 
+static void serveLaunchRequests()
+{
+	gpunative::runtime::LoaderServer server;
+
+	try
+	{
+		server.serve(std::cin, std::cout);
+	}
+	catch(const std::exception& e)
+	{
+		std::cout << "Warm instance failed: " << e.what() << "\n";
+	}
+}
+
 static StringVector getArguments(const std::string& path, int argc, char** argv)
 {
 	StringVector arguments;
@@ -77,20 +92,32 @@ int main(int argc, char** argv)
 	
 	std::string inputBinary;
 	bool verbose = false;
-	
+	bool warmInstance = false;
+
 	parser.parse("-i", "--input", inputBinary, "", "The path to the binary "
 		"being executed (.ptx/.cubin).");
+	parser.parse("-w", "--warm-instance", warmInstance, false,
+		"Stay resident and serve launch requests from stdin, one per line "
+		"(a binary path followed by its arguments), keeping the driver "
+		"initialized and binaries cached on the device between runs.");
 	parser.parse("-v", "--verbose", verbose, false,
 		"Print out status information while running.");
 	parser.parse();
-	
+
 	if(verbose)
 	{
 		gpunative::util::enableAllLogs();
 	}
-	
+
+	if(warmInstance)
+	{
+		serveLaunchRequests();
+
+		return 0;
+	}
+
 	runBinary(inputBinary, getArguments(inputBinary, argc, argv));
-	
+
 	return 0;
 }
 
@@ -9,6 +9,7 @@
 
 // Standard Library Includes
 #include <cstdlib>
+#include <cstring>
 
 namespace gpunative
 {
@@ -17,7 +18,101 @@ namespace util
 {
 
 	////////////////////////////////////////////////////////////////////////////
-	// Argument parser	
+	// Option table scanning
+
+	static const char* skipDashes( const char* text )
+	{
+		if( *text == '-' ) ++text;
+		if( *text == '-' ) ++text;
+
+		return text;
+	}
+
+	/*! Match one argv entry against an option name, returning the value
+		text carried by the entry or by its successor.  Nothing here
+		allocates, the returned pointer aims into argv. */
+	static const char* matchArgument( const char* argument, const char* name,
+		const char* next )
+	{
+		if( *argument != '-' ) return nullptr;
+
+		const char* body       = skipDashes( argument );
+		const char* identifier = skipDashes( name );
+
+		size_t length = std::strlen( identifier );
+
+		if( std::strncmp( body, identifier, length ) != 0 ) return nullptr;
+
+		const char* tail = body + length;
+
+		// '-o value'
+		if( *tail == '\0' ) return next;
+
+		// '-o=value'
+		if( *tail == '=' ) ++tail;
+
+		if( *tail == '\0' ) return nullptr;
+
+		// '-O2'
+		return tail;
+	}
+
+	const char* findOptionValue( int argc, char** argv,
+		const OptionDescriptor& option )
+	{
+		for( int i = 0; i < argc; ++i )
+		{
+			const char* next = i + 1 < argc ? argv[ i + 1 ] : nullptr;
+
+			// the long name goes first so that a short name is never
+			// taken as a prefix of it
+			if( option.longName != nullptr && *option.longName != '\0' )
+			{
+				const char* value = matchArgument( argv[ i ],
+					option.longName, next );
+
+				if( value != nullptr ) return value;
+			}
+
+			if( option.shortName != nullptr && *option.shortName != '\0' )
+			{
+				const char* value = matchArgument( argv[ i ],
+					option.shortName, next );
+
+				if( value != nullptr ) return value;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool isOptionPresent( int argc, char** argv,
+		const OptionDescriptor& option )
+	{
+		for( int i = 0; i < argc; ++i )
+		{
+			if( option.shortName != nullptr && *option.shortName != '\0' )
+			{
+				if( std::strcmp( argv[ i ], option.shortName ) == 0 )
+				{
+					return true;
+				}
+			}
+
+			if( option.longName != nullptr && *option.longName != '\0' )
+			{
+				if( std::strcmp( argv[ i ], option.longName ) == 0 )
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	// Argument parser
 	ArgumentParser::ArgumentParser(int _argc, char* _argv[])
 	{
 		argc = _argc;
@@ -40,25 +135,45 @@ namespace util
 
 	bool ArgumentParser::isPresent(const std::string& identifier)
 	{
-		bool found = false;
-	
 		report( "Searching for " << identifier );
-	
-		for(int i = 0; i < argc; i++)
+
+		OptionDescriptor option = { identifier.c_str(), "", "" };
+
+		return isOptionPresent( argc, argv, option );
+	}
+
+	const char* ArgumentParser::findValue( const std::string& identifier,
+		const std::string& longIdentifier ) const
+	{
+		// the long form wins when both appear, matching the old behavior
+		// of searching for it last
+		if( !longIdentifier.empty() )
 		{
-			std::string str = argv[i];
-			size_t pos = str.find(identifier);
-			if( pos == 0 && str.size() == identifier.size() )
-			{
-				report( "Found in " << str );
-				found = true;
-				break;
-			}
+			OptionDescriptor option = { "", longIdentifier.c_str(), "" };
+
+			const char* value = findOptionValue( argc, argv, option );
+
+			if( value != nullptr ) return value;
 		}
-	
-		return found;
+
+		if( !identifier.empty() )
+		{
+			OptionDescriptor option = { identifier.c_str(), "", "" };
+
+			const char* value = findOptionValue( argc, argv, option );
+
+			if( value != nullptr ) return value;
+		}
+
+		return nullptr;
 	}
-	
+
+	void ArgumentParser::addHelp( const std::string& identifier,
+		const std::string& message, const std::string& value )
+	{
+		arguments.push_back( HelpEntry{ identifier, message, value } );
+	}
+
 	void ArgumentParser::setValue(std::string& value, const std::string& s)
 	{
 		value = s;
@@ -69,8 +184,25 @@ namespace util
 		std::stringstream stream;
 		stream << "\nProgram : " << argv[0] << "\n\n";
 		stream << _description;
-		stream << "Arguments : \n\n";		
-		stream << arguments.str();
+		stream << "Arguments : \n\n";
+
+		// the formatting deferred by addHelp happens here, off of the
+		// parse path
+		std::string regularPrefix( MESSAGE_OFFSET, ' ' );
+
+		for( auto& entry : arguments )
+		{
+			int prefixSpacing = MESSAGE_OFFSET - ( int )entry.identifier.size();
+
+			std::string prefix( MAX( prefixSpacing, 0 ), ' ' );
+
+			std::string result = format( entry.message + '\n', prefix,
+				regularPrefix, SCREEN_WIDTH );
+
+			stream << entry.identifier << result << regularPrefix
+				<< "value = " << entry.value << "\n" << "\n";
+		}
+
 		stream << "\n";
 		return stream.str();
 	}
@@ -90,24 +222,8 @@ namespace util
 		{
 			b = starting;
 		}
-		
-		std::string identifier( ' ' + _identifier );
-
-		int prefixSpacing = MESSAGE_OFFSET - ( int )identifier.size();
-		
-		std::string prefix( MAX( prefixSpacing, 0 ), ' ' );
-		std::string regularPrefix( MESSAGE_OFFSET, ' ' );
 
-		std::stringstream secondStream( string + '\n' );
-		
-		std::string result = format( secondStream.str(), prefix, 
-			regularPrefix, SCREEN_WIDTH );
-		
-		std::stringstream thirdStream;
-		thirdStream << result << regularPrefix << "value = " << std::boolalpha 
-			<< b << "\n";
-			
-		arguments << identifier << thirdStream.str() << "\n";
+		addHelp( ' ' + _identifier, string, b ? "true" : "false" );
 	}
 
 	void ArgumentParser::parse(const std::string& _identifier, 
@@ -132,25 +248,9 @@ namespace util
 		{
 			b = starting;
 		}
-		
-		std::string identifier( ' ' + _identifier + '(' 
-			+ _longIdentifier + ')' );
 
-		int prefixSpacing = MESSAGE_OFFSET - ( int )identifier.size();
-		
-		std::string prefix( MAX( prefixSpacing, 0 ), ' ' );
-		std::string regularPrefix( MESSAGE_OFFSET, ' ' );
-
-		std::stringstream secondStream( string + '\n' );
-		
-		std::string result = format( secondStream.str(), prefix, 
-			regularPrefix, SCREEN_WIDTH );
-		
-		std::stringstream thirdStream;
-		thirdStream << result << regularPrefix << "value = " << std::boolalpha 
-			<< b << "\n";
-		
-		arguments << identifier << thirdStream.str() << "\n";
+		addHelp( ' ' + _identifier + '(' + _longIdentifier + ')',
+			string, b ? "true" : "false" );
 	}
 	
 	void ArgumentParser::parse()
@@ -0,0 +1,199 @@
+/*	\file   Profiler.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the scoped zone profiler.
+*/
+
+// GPU Native Includes
+#include <gpu-native/util/interface/Profiler.h>
+
+#include <gpu-native/util/interface/Knobs.h>
+#include <gpu-native/util/interface/LowLevelTimer.h>
+#include <gpu-native/util/interface/debug.h>
+#include <gpu-native/util/interface/json.h>
+
+// Standard Library Includes
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+
+namespace gpunative
+{
+
+namespace util
+{
+
+/*! One completed zone.  The name points at a string literal, so records
+	are trivially copyable and a full ring never allocates. */
+class ProfilerRecord
+{
+public:
+	const char* name;
+	double      start;
+	double      seconds;
+};
+
+/*! The per thread ring.  The newest records win when a thread produces
+	more than the ring holds, startup phases are recorded first and are
+	short enough to fit. */
+class ProfilerBuffer
+{
+public:
+	static const size_t Size = 4096;
+
+public:
+	ProfilerBuffer() : count(0), next(nullptr)
+	{
+
+	}
+
+public:
+	ProfilerRecord records[Size];
+	size_t         count;
+
+	ProfilerBuffer* next;
+};
+
+// The buffers of exited threads stay linked here until the process ends
+// so their records survive into the merge
+static std::mutex      bufferLock;
+static ProfilerBuffer* bufferList = nullptr;
+
+static thread_local ProfilerBuffer* threadBuffer = nullptr;
+
+static ProfilerBuffer* getThreadBuffer()
+{
+	if(threadBuffer == nullptr)
+	{
+		threadBuffer = new ProfilerBuffer;
+
+		std::lock_guard<std::mutex> guard(bufferLock);
+
+		threadBuffer->next = bufferList;
+		bufferList         = threadBuffer;
+
+		if(threadBuffer->next == nullptr)
+		{
+			std::atexit(Profiler::write);
+		}
+	}
+
+	return threadBuffer;
+}
+
+bool Profiler::enabled()
+{
+	static bool isEnabled =
+		KnobDatabase::getKnobValue("Profiler::Enable", false);
+
+	return isEnabled;
+}
+
+void Profiler::record(const char* name, double startSeconds, double seconds)
+{
+	ProfilerBuffer* buffer = getThreadBuffer();
+
+	ProfilerRecord& slot =
+		buffer->records[buffer->count % ProfilerBuffer::Size];
+
+	slot.name    = name;
+	slot.start   = startSeconds;
+	slot.seconds = seconds;
+
+	++buffer->count;
+}
+
+void Profiler::write()
+{
+	if(!enabled()) return;
+
+	// read the string knob directly, the templated accessor cannot
+	// default construct a string from 0
+	std::string path = KnobDatabase::knobExists("Profiler::Path") ?
+		KnobDatabase::getKnobValueAsString("Profiler::Path") :
+		"profile.json";
+
+	std::lock_guard<std::mutex> guard(bufferLock);
+
+	json::Object* report = new json::Object;
+
+	json::Array* threads = new json::Array;
+
+	report->dictionary.insert(std::make_pair("threads", threads));
+
+	int threadId = 0;
+
+	for(ProfilerBuffer* buffer = bufferList; buffer != nullptr;
+		buffer = buffer->next, ++threadId)
+	{
+		json::Object* thread = new json::Object;
+
+		thread->dictionary.insert(std::make_pair("id",
+			new json::Number(threadId)));
+
+		json::Array* zones = new json::Array;
+
+		thread->dictionary.insert(std::make_pair("zones", zones));
+
+		size_t begin = buffer->count > ProfilerBuffer::Size ?
+			buffer->count - ProfilerBuffer::Size : 0;
+
+		for(size_t i = begin; i < buffer->count; ++i)
+		{
+			const ProfilerRecord& record =
+				buffer->records[i % ProfilerBuffer::Size];
+
+			json::Object* zone = new json::Object;
+
+			zone->dictionary.insert(std::make_pair("name",
+				new json::String(record.name)));
+			zone->dictionary.insert(std::make_pair("start",
+				new json::Number(record.start)));
+			zone->dictionary.insert(std::make_pair("seconds",
+				new json::Number(record.seconds)));
+
+			zones->sequence.push_back(zone);
+		}
+
+		thread->dictionary.insert(std::make_pair("dropped",
+			new json::Number((int)begin)));
+
+		threads->sequence.push_back(thread);
+	}
+
+	std::ofstream file(path);
+
+	if(file.is_open())
+	{
+		json::Emitter emitter;
+
+		emitter.emit_pretty(file, report);
+
+		util::log("Profiler") << "Wrote profile to '" << path << "'\n";
+	}
+
+	delete report;
+}
+
+ProfilerZone::ProfilerZone(const char* name)
+: _name(name), _start(0.0)
+{
+	if(!Profiler::enabled()) return;
+
+	LowLevelTimer timer;
+
+	_start = timer.absolute();
+}
+
+ProfilerZone::~ProfilerZone()
+{
+	if(!Profiler::enabled()) return;
+
+	LowLevelTimer timer;
+
+	Profiler::record(_name, _start, timer.absolute() - _start);
+}
+
+}
+
+}
@@ -9,10 +9,12 @@
 #include <gpu-native/util/interface/TarArchive.h>
 #include <gpu-native/util/interface/TarLibrary.h>
 
+#include <gpu-native/util/interface/Profiler.h>
 #include <gpu-native/util/interface/debug.h>
 
 // Standard Library Includes
 #include <stdexcept>
+#include <unordered_map>
 
 namespace gpunative
 {
@@ -35,9 +37,12 @@ static size_t getSize(std::istream& stream)
 
 class TarArchiveImplementation
 {
+public:
+	typedef TarArchive::StringVector StringVector;
+
 public:
 	TarArchiveImplementation(const std::string& p, const std::string& m)
-	: _path(p), _mode(m), _archive(nullptr), _file(nullptr)
+	: _path(p), _mode(m), _archive(nullptr), _file(nullptr), _position(0)
 	{
 		util::log("TarArchive") << "Creating tar archive '" + p +
 			"' with mode '" + m + "'\n";
@@ -170,14 +175,49 @@ public:
 	void reset()
 	{
 		util::log("TarArchive") << " Resetting archive...\n";
-		
+
 		close();
-		
+
 		initialize();
+
+		_position = 0;
+	}
+
+	void buildIndex()
+	{
+		if(!isReadMode()) return;
+
+		ProfilerZone zone("TarArchive::buildIndex");
+
+		util::log("TarArchive") << " Indexing archive members...\n";
+
+		TarLibrary::archive_entry* entry = nullptr;
+
+		while(TarLibrary::archive_read_next_header(_archive, &entry) ==
+			TarLibrary::OK)
+		{
+			std::string name = TarLibrary::archive_entry_pathname(entry);
+
+			_index.insert(std::make_pair(name, _names.size()));
+			_names.push_back(name);
+		}
+
+		util::log("TarArchive") << "  indexed " << _names.size()
+			<< " members.\n";
+
+		// The scan consumed the stream, reopen it for extraction
+		reset();
+	}
+
+	StringVector list() const
+	{
+		return _names;
 	}
 
 	void addFile(const std::string& name, std::istream& file)
 	{
+		ProfilerZone zone("TarArchive::addFile");
+
 		util::log("TarArchive") << " Adding file '" + name +
 			"' to archive '" + _path + "'\n";
 		
@@ -236,51 +276,67 @@ public:
 
 		TarLibrary::archive_entry_free(entry);
 
+		_index.insert(std::make_pair(name, _names.size()));
+		_names.push_back(name);
+
 		util::log("TarArchive") << "  File added successfully...\n";
 	}
 
 	void extractFile(const std::string& name, std::ostream& file)
 	{
-		reset();
-		
+		ProfilerZone zone("TarArchive::extractFile");
+
+		// The index rejects misses without touching the stream and turns
+		// the lookup into an entry count rather than a name scan
+		auto member = _index.find(name);
+
+		if(member == _index.end())
+		{
+			throw std::runtime_error("Could not find filename '" + name +
+				"' in archive '" + _path + "'");
+		}
+
+		// The stream only moves forward, rewind when the target is behind it
+		if(_position > member->second)
+		{
+			reset();
+		}
+
 		TarLibrary::archive_entry* entry = nullptr;
-		
-		int status = TarLibrary::archive_read_next_header(_archive, &entry);
-		
-		while(status == TarLibrary::OK)
+
+		while(_position <= member->second)
 		{
-			if(name == TarLibrary::archive_entry_pathname(entry))
+			if(TarLibrary::archive_read_next_header(_archive, &entry) !=
+				TarLibrary::OK)
 			{
-				size_t size = TarLibrary::archive_entry_size(entry);
-
-				char buffer[1024];
-				
-				while(size > 0)
-				{
-					size_t transferSize = std::min((size_t)1024, size);
-				
-					if(TarLibrary::archive_read_data(_archive, buffer,
-						transferSize) != transferSize)
-					{
-						TarLibrary::archive_entry_free(entry);
-						
-						throw std::runtime_error("Failed to read data "
-							"from archive.");
-					}
-					
-					file.write(buffer, transferSize);
-					
-					size -= transferSize;
-				}
-			
-				return;
+				throw std::runtime_error("Failed to seek to filename '" +
+					name + "' in archive '" + _path + "'");
 			}
-			
-			status = TarLibrary::archive_read_next_header(_archive, &entry);
+
+			++_position;
+		}
+
+		size_t size = TarLibrary::archive_entry_size(entry);
+
+		char buffer[1024];
+
+		while(size > 0)
+		{
+			size_t transferSize = std::min((size_t)1024, size);
+
+			if(TarLibrary::archive_read_data(_archive, buffer,
+				transferSize) != transferSize)
+			{
+				TarLibrary::archive_entry_free(entry);
+
+				throw std::runtime_error("Failed to read data "
+					"from archive.");
+			}
+
+			file.write(buffer, transferSize);
+
+			size -= transferSize;
 		}
-		
-		throw std::runtime_error("Could not find filename '" + name +
-			"' in archive '" + _path + "'");
 	}
 
 private:
@@ -298,10 +354,20 @@ private:
 	std::string _path;
 	std::string _mode;
 	
+private:
+	typedef std::unordered_map<std::string, size_t> MemberIndex;
+
 private:
 	TarLibrary::archive* _archive;
 	FILE*                _file;
-	
+
+	//! Member name to entry ordinal, built with one pass at open
+	MemberIndex  _index;
+	StringVector _names;
+
+	//! The ordinal of the next header the reader will return
+	size_t _position;
+
 };
 
 TarArchive::TarArchive(const std::string& path, const std::string& mode)
@@ -310,6 +376,7 @@ TarArchive::TarArchive(const std::string& path, const std::string& mode)
 	try
 	{
 		_archive->initialize();
+		_archive->buildIndex();
 	}
 	catch(...)
 	{
@@ -326,11 +393,7 @@ TarArchive::~TarArchive()
 
 TarArchive::StringVector TarArchive::list() const
 {
-	StringVector files;
-	
-	assertM(false, "Get list of files not implemented.");
-	
-	return files;
+	return _archive->list();
 }
 
 void TarArchive::addFile(const std::string& name, std::istream& file)
@@ -15,7 +15,9 @@
 #include <sstream>
 #include <deque>
 #include <stdexcept>
+#include <algorithm>
 #include <cstring>
+#include <cstdlib>
 
 #define EXCEPTION(message) std::runtime_error(message)
 
@@ -1388,6 +1390,333 @@ json::Value *json::Visitor::find(const std::string & obj) const {
 	return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// StringRef
+
+json::StringRef::StringRef(): string_begin(0), string_end(0) {
+
+}
+
+json::StringRef::StringRef(const char *begin, const char *end):
+	string_begin(begin), string_end(end) {
+
+}
+
+const char *json::StringRef::begin() const {
+	return string_begin;
+}
+
+const char *json::StringRef::end() const {
+	return string_end;
+}
+
+size_t json::StringRef::size() const {
+	return string_end - string_begin;
+}
+
+bool json::StringRef::empty() const {
+	return string_begin == string_end;
+}
+
+std::string json::StringRef::to_string() const {
+	return std::string(string_begin, string_end);
+}
+
+bool json::StringRef::operator==(const char *text) const {
+	size_t length = std::strlen(text);
+	return length == size() && std::memcmp(string_begin, text, length) == 0;
+}
+
+bool json::StringRef::operator==(const std::string &text) const {
+	return text.size() == size() &&
+		std::memcmp(string_begin, text.data(), text.size()) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SaxHandler - default callbacks ignore the event
+
+json::SaxHandler::~SaxHandler() {
+
+}
+
+void json::SaxHandler::begin_object() {
+
+}
+
+void json::SaxHandler::end_object() {
+
+}
+
+void json::SaxHandler::begin_array() {
+
+}
+
+void json::SaxHandler::end_array() {
+
+}
+
+void json::SaxHandler::key(const StringRef &) {
+
+}
+
+void json::SaxHandler::string_value(const StringRef &) {
+
+}
+
+void json::SaxHandler::integer_value(long long int) {
+
+}
+
+void json::SaxHandler::real_value(double) {
+
+}
+
+void json::SaxHandler::boolean_value(bool) {
+
+}
+
+void json::SaxHandler::null_value() {
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BufferParser
+
+json::BufferParser::BufferParser(): line_number(0) {
+
+}
+
+void json::BufferParser::error(const char *message, char *position,
+	char *end) const {
+	std::stringstream ss;
+	char buffer[32];
+	std::memset(buffer, 0, 32);
+	std::memcpy(buffer, position, std::min((size_t)31, (size_t)(end - position)));
+	ss << "line " << line_number << ": " << message << "\n at: " << buffer;
+	throw std::runtime_error(ss.str());
+}
+
+char *json::BufferParser::skip_whitespace(char *position, char *end) {
+	for (; position != end; ++position) {
+		char ch = *position;
+		if (ch == '\n') {
+			++line_number;
+		}
+		else if (ch != ' ' && ch != '\t' && ch != '\r') {
+			break;
+		}
+	}
+	return position;
+}
+
+void json::BufferParser::parse(char *begin, char *end, SaxHandler &handler) {
+	line_number = 0;
+	char *position = skip_whitespace(begin, end);
+	if (position == end) {
+		error("BufferParser::parse() - empty input", position, end);
+	}
+	position = parse_value(position, end, handler);
+	position = skip_whitespace(position, end);
+	if (position != end) {
+		error("BufferParser::parse() - trailing characters after value",
+			position, end);
+	}
+}
+
+char *json::BufferParser::parse_value(char *position, char *end,
+	SaxHandler &handler) {
+	if (position == end) {
+		error("BufferParser::parse_value() - unexpected end of input",
+			position, end);
+	}
+	switch (*position) {
+		case '{':
+			return parse_object(position, end, handler);
+		case '[':
+			return parse_array(position, end, handler);
+		case '"':
+		{
+			StringRef value;
+			position = parse_string(position, end, value);
+			handler.string_value(value);
+			return position;
+		}
+		case 't':
+			if (end - position >= 4 && std::memcmp(position, "true", 4) == 0) {
+				handler.boolean_value(true);
+				return position + 4;
+			}
+			break;
+		case 'f':
+			if (end - position >= 5 && std::memcmp(position, "false", 5) == 0) {
+				handler.boolean_value(false);
+				return position + 5;
+			}
+			break;
+		case 'n':
+			if (end - position >= 4 && std::memcmp(position, "null", 4) == 0) {
+				handler.null_value();
+				return position + 4;
+			}
+			break;
+		default:
+			return parse_number(position, end, handler);
+	}
+	error("BufferParser::parse_value() - unexpected character", position, end);
+	return 0;
+}
+
+char *json::BufferParser::parse_object(char *position, char *end,
+	SaxHandler &handler) {
+	handler.begin_object();
+	position = skip_whitespace(position + 1, end);
+	if (position != end && *position == '}') {
+		handler.end_object();
+		return position + 1;
+	}
+	while (true) {
+		if (position == end || *position != '"') {
+			error("BufferParser::parse_object() - expected key string",
+				position, end);
+		}
+		StringRef name;
+		position = parse_string(position, end, name);
+		handler.key(name);
+		position = skip_whitespace(position, end);
+		if (position == end || *position != ':') {
+			error("BufferParser::parse_object() - expected colon after key",
+				position, end);
+		}
+		position = skip_whitespace(position + 1, end);
+		position = parse_value(position, end, handler);
+		position = skip_whitespace(position, end);
+		if (position == end) {
+			error("BufferParser::parse_object() - unterminated object",
+				position, end);
+		}
+		if (*position == '}') {
+			handler.end_object();
+			return position + 1;
+		}
+		if (*position != ',') {
+			error("BufferParser::parse_object() - expected ',' or '}'",
+				position, end);
+		}
+		position = skip_whitespace(position + 1, end);
+	}
+}
+
+char *json::BufferParser::parse_array(char *position, char *end,
+	SaxHandler &handler) {
+	handler.begin_array();
+	position = skip_whitespace(position + 1, end);
+	if (position != end && *position == ']') {
+		handler.end_array();
+		return position + 1;
+	}
+	while (true) {
+		position = parse_value(position, end, handler);
+		position = skip_whitespace(position, end);
+		if (position == end) {
+			error("BufferParser::parse_array() - unterminated array",
+				position, end);
+		}
+		if (*position == ']') {
+			handler.end_array();
+			return position + 1;
+		}
+		if (*position != ',') {
+			error("BufferParser::parse_array() - expected ',' or ']'",
+				position, end);
+		}
+		position = skip_whitespace(position + 1, end);
+	}
+}
+
+char *json::BufferParser::parse_string(char *position, char *end,
+	StringRef &result) {
+	// escapes decode in place - the decoded text is never longer than the
+	// source, so the write cursor trails the read cursor
+	char *write = ++position;
+	char *read = position;
+	while (true) {
+		if (read == end) {
+			error("BufferParser::parse_string() - unterminated string",
+				read, end);
+		}
+		char ch = *read;
+		if (ch == '"') {
+			result = StringRef(position, write);
+			return read + 1;
+		}
+		if (ch != '\\') {
+			*write++ = ch;
+			++read;
+			continue;
+		}
+		if (end - read < 2) {
+			error("BufferParser::parse_string() - unterminated escape",
+				read, end);
+		}
+		switch (read[1]) {
+			case '"': *write++ = '"'; break;
+			case '\\': *write++ = '\\'; break;
+			case '/': *write++ = '/'; break;
+			case 'b': *write++ = '\b'; break;
+			case 'f': *write++ = '\f'; break;
+			case 'n': *write++ = '\n'; break;
+			case 'r': *write++ = '\r'; break;
+			case 't': *write++ = '\t'; break;
+			default:
+				error("BufferParser::parse_string() - unsupported escape",
+					read, end);
+		}
+		read += 2;
+	}
+}
+
+char *json::BufferParser::parse_number(char *position, char *end,
+	SaxHandler &handler) {
+	// numbers are short, copy to a terminated buffer for strtod/strtoll
+	char buffer[64];
+	size_t length = 0;
+	bool real = false;
+	char *read = position;
+	for (; read != end && length + 1 < sizeof(buffer); ++read) {
+		char ch = *read;
+		if (ch == '.' || ch == 'e' || ch == 'E') {
+			real = true;
+		}
+		else if (ch != '-' && ch != '+' && !(ch >= '0' && ch <= '9')) {
+			break;
+		}
+		buffer[length++] = ch;
+	}
+	if (length == 0) {
+		error("BufferParser::parse_number() - expected a number",
+			position, end);
+	}
+	buffer[length] = '\0';
+	char *parseEnd = 0;
+	if (real) {
+		double value = std::strtod(buffer, &parseEnd);
+		if (parseEnd != buffer + length) {
+			error("BufferParser::parse_number() - malformed real number",
+				position, end);
+		}
+		handler.real_value(value);
+	}
+	else {
+		long long int value = std::strtoll(buffer, &parseEnd, 10);
+		if (parseEnd != buffer + length) {
+			error("BufferParser::parse_number() - malformed integer",
+				position, end);
+		}
+		handler.integer_value(value);
+	}
+	return read;
+}
+
 }
 }
 
@@ -16,12 +16,46 @@ namespace gpunative
 namespace util
 {
 
+	typedef long long unsigned int WordType;
+
+	static bool containsAZeroByte( WordType word )
+	{
+		return ( ( word - 0x0101010101010101ULL ) & ~word
+			& 0x8080808080808080ULL ) != 0;
+	}
+
 	void strlcpy( char* dest, const char* src, unsigned int length )
 	{
+		if( length == 0 ) return;
+
 		const char* end = src + ( length - 1 );
+
+		// copy bytes until the source reaches a natural word boundary
+		for( ; src != end && ( ( (WordType) src ) & 7 ) != 0; ++src, ++dest )
+		{
+			*dest = *src;
+			if( *src == '\0' )
+			{
+				return;
+			}
+		}
+
+		// copy a word at a time while no terminator appears
+		if( ( ( (WordType) dest ) & 7 ) == 0 )
+		{
+			for( ; src + 8 <= end; src += 8, dest += 8 )
+			{
+				WordType word = *( (const WordType*) src );
+
+				if( containsAZeroByte( word ) ) break;
+
+				*( (WordType*) dest ) = word;
+			}
+		}
+
 		for( ; src != end; ++src, ++dest )
 		{
-			*dest = *src;	
+			*dest = *src;
 			if( *src == '\0' )
 			{
 				return;
@@ -30,73 +64,44 @@ namespace util
 		*dest = '\0';
 	}
 	
-	StringVector split( const std::string& string, 
+	StringVector split( const std::string& string,
 		const std::string& delimiter )
 	{
-		size_t begin = 0;
-		size_t end = 0;
+		StringViewVector views = splitView( string, delimiter );
+
 		StringVector strings;
-		
-		while( end != std::string::npos )
+
+		strings.reserve( views.size() );
+
+		for( auto& view : views )
 		{
-			end = string.find( delimiter, begin );
-			
-			if( end > begin )
-			{
-				std::string substring = string.substr( begin, end - begin );
-				
-				if( !substring.empty() ) strings.push_back( substring );
-			}
-			
-			begin = end + delimiter.size();
+			strings.push_back( view.to_string() );
 		}
 
 		return strings;
 	}
-	
+
 	std::string strip( const std::string& string, const std::string& delimiter )
 	{
 		std::string result;
 		size_t begin = 0;
 		size_t end = 0;
-		
+
+		result.reserve( string.size() );
+
 		while( end != std::string::npos )
 		{
 			end = string.find( delimiter, begin );
 			result += string.substr( begin, end - begin );
 			begin = end + delimiter.size();
 		}
-		
+
 		return result;
 	}
-	
-	static bool isWhitespace(char c)
-	{
-		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
-	}
 
 	std::string removeWhitespace(const std::string& string)
 	{
-		size_t start = 0;
-		size_t end   = string.size();
-
-		for(; start < end; ++start)
-		{
-			if(!isWhitespace(string[start]))
-			{
-				break;
-			}
-		}
-
-		for(; end > start + 1; --end)
-		{
-			if(!isWhitespace(string[end-1]))
-			{
-				break;
-			}
-		}
-
-		return string.substr(start, end - start);
+		return removeWhitespaceView(string).to_string();
 	}
 
 	std::string format( const std::string& input, 
@@ -28,7 +28,36 @@ namespace gpunative
 namespace util
 {
 
-	/*! 
+	/*!
+		\class OptionDescriptor
+		\brief A static description of one command line option
+
+		Descriptors are aggregates of string literals, so a tool can lay
+		its whole option table out in a static array and scan argv against
+		it without constructing anything.
+	*/
+	class OptionDescriptor
+	{
+		public:
+			/*! A short name beginning with "-", or an empty string */
+			const char* shortName;
+			/*! A long name beginning with "--", or an empty string */
+			const char* longName;
+			/*! The help message for the option */
+			const char* help;
+	};
+
+	/*! \brief Scan argv once for an option that carries a value, return
+		the value text or nullptr.  Nothing on this path allocates. */
+	const char* findOptionValue( int argc, char** argv,
+		const OptionDescriptor& option );
+
+	/*! \brief Scan argv once for an option used as a flag.  Nothing on
+		this path allocates. */
+	bool isOptionPresent( int argc, char** argv,
+		const OptionDescriptor& option );
+
+	/*!
 		\class ArgumentParser
 		\brief A class that can be used to parse arguments from argv and argc
 	*/
@@ -42,35 +71,52 @@ namespace util
 			*/
 			char** argv;
 			
-			/*! A string to hold the descriptions of arguments
+			/*! One registered option, formatting of the help message is
+				deferred until it is actually requested
+			*/
+			class HelpEntry
+			{
+				public:
+					std::string identifier;
+					std::string message;
+					std::string value;
+			};
+
+			/*! A vector of registered options
 			*/
-			std::stringstream arguments;
-			/*!	\brief Format a string to fit a specific length. */			
+			std::vector< HelpEntry > arguments;
 
 			/*!
 				\brief A string to hold the description of the program.
 			*/
 			std::string _description;
-		
+
 		private:
-		
-			/*! A function for parsing an argument
-				\param identifier a string used to 
-					match strings in argv.
-				\param value The value to set if the identifier is found
-						
+
+			/*! A function for finding the value text of an argument
+				\param identifier a short name used to
+					match strings in argv, or an empty string.
+				\param longIdentifier a long name used to
+					match strings in argv, or an empty string.
+				\return the value text, or nullptr if the argument is
+					not present.  Nothing on this path allocates.
+
 			*/
-			template<class T>
-			void find( const std::string& identifier, T& value );
+			const char* findValue( const std::string& identifier,
+				const std::string& longIdentifier ) const;
 
 			/*! A function determining if an argument is present
-				\param identifier a string used to 
+				\param identifier a string used to
 					match strings in argv.
 				\return true if the identifier was found in argv false otherwise
-						
-			*/			
+
+			*/
 			bool isPresent(const std::string& identifier);
 
+			/*! \brief Record an option for the help message */
+			void addHelp( const std::string& identifier,
+				const std::string& message, const std::string& value );
+
 			/*! \brief Set the value of an arbitrary type given a string */
 			template< typename T >
 			void setValue(T& value, const std::string& s);
@@ -185,143 +231,58 @@ namespace util
 	
 	void setValue(std::string& value, const std::string& s);
 
-	template< typename T >
-	void ArgumentParser::find(const std::string& identifier, T& value)
-	{
-		std::string str;
-	
-		bool found = false;
-	
-		for(int i = 0; i < argc; i++)
-		{
-			str = argv[i];
-			if( str.size() > 0 )
-			{
-			    if( str[0] == '-' )
-			    {
-			        str = str.substr( 1 );
-           			if( str.size() > 0 )
-			        {
-			            if( str[0] == '-' )
-			            {
-			                str = str.substr( 1 );
-			            }
-			        }
-			    }
-			    else
-			    {
-			    	continue;
-			    }
-			}
-			
-			report( "Searching for " << identifier << " in " << str );
-			
-			size_t pos = str.find(identifier);
-			if( pos == 0 )
-			{
-			    report( " Found " << identifier );
-				if( str.size() == identifier.size() )
-				{
-					if( i < argc - 1 )
-					{
-        			    found = true;
-						str = argv[i+1];
-						report( "  Setting to next value " << str );
-						break;
-					}
-				}
-				else
-				{
-					pos = identifier.size();
-					if( pos < str.size() )
-					{
-					    if( str[pos] == '=' )
-				        {
-					        ++pos;
-				        }
-					}
-					if( pos < str.size() )
-					{
-						found = true;
-						str = str.substr( pos );
-						report( "  Setting to substring " << str );
-						break;					
-					}
-				}
-			}
-		}
-	
-		if( found )
-		{
-			setValue(value, str);
-		}
-		
-	}
-
 	template< class T, class V >
-	void ArgumentParser::parse(const std::string& _identifier, T& i, 
+	void ArgumentParser::parse(const std::string& _identifier, T& i,
 		const V& starting, const std::string& _string)
 	{
 		assert( _identifier.size() == 2 );
 		assert( _identifier[0] == '-' );
 
 		i = starting;
-		find( _identifier.substr(1), i );
-		
-		std::string identifier( ' ' + _identifier );
-
-		int prefixSpacing = MESSAGE_OFFSET - ( int )identifier.size();
-		
-		std::string prefix( MAX( prefixSpacing, 0 ), ' ' );
-		std::string regularPrefix( MESSAGE_OFFSET, ' ' );
-
-		std::stringstream secondStream( _string + '\n' );
-
-		std::string result = format( secondStream.str(), prefix, 
-			regularPrefix, SCREEN_WIDTH );
-		
-		std::stringstream thirdStream;
-		thirdStream << result << regularPrefix << "value = " << i << "\n";
-			
-		arguments << identifier << thirdStream.str() << "\n";
+
+		const char* value = findValue( _identifier, "" );
+
+		if( value != nullptr )
+		{
+			report( " Found " << _identifier << ", setting to " << value );
+			setValue( i, value );
+		}
+
+		std::stringstream stream;
+		stream << std::boolalpha << i;
+
+		addHelp( ' ' + _identifier, _string, stream.str() );
 	}
 
 	template< class T, class V >
-	void ArgumentParser::parse(const std::string& _identifier, 
-		const std::string& _longIdentifier, T& i, 
+	void ArgumentParser::parse(const std::string& _identifier,
+		const std::string& _longIdentifier, T& i,
 		const V& starting, const std::string& _string)
 	{
 		i = starting;
-		
+
 		if( !_identifier.empty() )
 		{
 			assert( _identifier.size() == 2 );
 			assert( _identifier[0] == '-' );
-			find( _identifier.substr(1), i );
 		}
-		
+
 		assert( _longIdentifier.size() > 2 );
 		assert( 0 == _longIdentifier.find( "--" ) );
 
-		find( _longIdentifier.substr(2), i );
-		
-		std::string identifier( ' ' + _identifier 
-			+ '(' + _longIdentifier + ')' );
+		const char* value = findValue( _identifier, _longIdentifier );
 
-		int prefixSpacing = MESSAGE_OFFSET - ( int )identifier.size();
-		
-		std::string prefix( MAX( prefixSpacing, 0 ), ' ' );
-		std::string regularPrefix( MESSAGE_OFFSET, ' ' );
+		if( value != nullptr )
+		{
+			report( " Found " << _longIdentifier << ", setting to " << value );
+			setValue( i, value );
+		}
 
-		std::stringstream secondStream( _string + '\n' );
+		std::stringstream stream;
+		stream << std::boolalpha << i;
 
-		std::string result = format( secondStream.str(), prefix, 
-			regularPrefix, SCREEN_WIDTH );
-		
-		std::stringstream thirdStream;
-		thirdStream << result << regularPrefix << "value = " << i << "\n";
-			
-		arguments << identifier << thirdStream.str() << "\n";
+		addHelp( ' ' + _identifier + '(' + _longIdentifier + ')',
+			_string, stream.str() );
 	}
 
 }
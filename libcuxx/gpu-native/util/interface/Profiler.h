@@ -0,0 +1,54 @@
+/*	\file   Profiler.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the scoped zone profiler.
+*/
+
+#pragma once
+
+namespace gpunative
+{
+
+namespace util
+{
+
+/*! A low overhead profiler.  Zones write fixed size records into per
+	thread ring buffers, which are merged and emitted as JSON when the
+	process exits.  Profiling is off unless the Profiler::Enable knob is
+	set, and a disabled zone costs one branch. */
+class Profiler
+{
+public:
+	/*! \brief Is profiling enabled?  Controlled by the Profiler::Enable
+		knob, read once on first use */
+	static bool enabled();
+
+	/*! \brief Record a completed zone.  The name must be a string
+		literal, records keep the pointer */
+	static void record(const char* name, double startSeconds,
+		double seconds);
+
+	/*! \brief Merge the per thread buffers and emit JSON to the path
+		named by the Profiler::Path knob.  Runs automatically at exit */
+	static void write();
+};
+
+/*! \brief An RAII zone, records the enclosed interval under a literal name */
+class ProfilerZone
+{
+public:
+	ProfilerZone(const char* name);
+	~ProfilerZone();
+
+public:
+	ProfilerZone(const ProfilerZone&) = delete;
+	ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+	const char* _name;
+	double      _start;
+};
+
+}
+
+}
@@ -247,6 +247,83 @@ namespace json {
 		String *parse_identifier(std::istream &input);
 	};
 
+	/*!
+		A non-owning reference to a character range inside a parsed buffer
+	*/
+	class StringRef {
+	public:
+		StringRef();
+		StringRef(const char *begin, const char *end);
+
+		const char *begin() const;
+		const char *end() const;
+
+		size_t size() const;
+		bool empty() const;
+
+		//! copies the referenced characters into an owned string
+		std::string to_string() const;
+
+		bool operator==(const char *text) const;
+		bool operator==(const std::string &text) const;
+
+	public:
+
+		const char *string_begin;
+		const char *string_end;
+	};
+
+	/*!
+		Receives parse events from BufferParser - override the callbacks of
+		interest. String references point into the parsed buffer and remain
+		valid for the buffer's lifetime.
+	*/
+	class SaxHandler {
+	public:
+		virtual ~SaxHandler();
+
+	public:
+		virtual void begin_object();
+		virtual void end_object();
+		virtual void begin_array();
+		virtual void end_array();
+		virtual void key(const StringRef &name);
+		virtual void string_value(const StringRef &value);
+		virtual void integer_value(long long int value);
+		virtual void real_value(double value);
+		virtual void boolean_value(bool value);
+		virtual void null_value();
+	};
+
+	/*!
+		Parses JSON text in place over a caller-owned mutable buffer and
+		streams events to a SaxHandler. String escapes are decoded
+		destructively into the buffer, so keys and string values are
+		zero-copy references - no DOM node or std::string is allocated.
+	*/
+	class BufferParser {
+	public:
+		BufferParser();
+
+		/*!
+			parses the buffer [begin, end), delivering events to the handler
+		*/
+		void parse(char *begin, char *end, SaxHandler &handler);
+
+		int line_number;
+
+	public:
+
+		char *skip_whitespace(char *position, char *end);
+		char *parse_value(char *position, char *end, SaxHandler &handler);
+		char *parse_object(char *position, char *end, SaxHandler &handler);
+		char *parse_array(char *position, char *end, SaxHandler &handler);
+		char *parse_string(char *position, char *end, StringRef &result);
+		char *parse_number(char *position, char *end, SaxHandler &handler);
+
+		void error(const char *message, char *position, char *end) const;
+	};
+
 	/*!
 		Emits a JSON object to an ostream
 	*/
@@ -18,6 +18,240 @@ namespace util
 	/*! \brief A vector of strings */
 	typedef std::vector< std::string > StringVector;
 
+	/*! \brief A non-owning view of a character range
+
+		The header-only routines below cut strings apart without copying
+		characters, startup parsing produces a lot of short lived
+		substrings. */
+	class StringView
+	{
+	public:
+		static const size_t npos = (size_t)-1;
+
+	public:
+		StringView() : _begin( nullptr ), _end( nullptr )
+		{
+
+		}
+
+		StringView( const char* begin, const char* end )
+			: _begin( begin ), _end( end )
+		{
+
+		}
+
+		StringView( const char* string ) : _begin( string ), _end( string )
+		{
+			while( *_end != '\0' ) ++_end;
+		}
+
+		StringView( const std::string& string )
+			: _begin( string.data() ), _end( string.data() + string.size() )
+		{
+
+		}
+
+	public:
+		const char* data()  const { return _begin;         }
+		size_t      size()  const { return _end - _begin;  }
+		bool        empty() const { return _begin == _end; }
+
+		char operator[]( size_t index ) const { return _begin[ index ]; }
+
+		const char* begin() const { return _begin; }
+		const char* end()   const { return _end;   }
+
+	public:
+		StringView substr( size_t offset, size_t length ) const
+		{
+			return StringView( _begin + offset, _begin + offset + length );
+		}
+
+		size_t find( const StringView& pattern, size_t offset = 0 ) const
+		{
+			if( pattern.size() > size() ) return npos;
+
+			for( size_t i = offset; i + pattern.size() <= size(); ++i )
+			{
+				size_t j = 0;
+
+				for( ; j < pattern.size(); ++j )
+				{
+					if( _begin[ i + j ] != pattern[ j ] ) break;
+				}
+
+				if( j == pattern.size() ) return i;
+			}
+
+			return npos;
+		}
+
+		std::string to_string() const
+		{
+			return std::string( _begin, _end );
+		}
+
+		bool operator==( const StringView& view ) const
+		{
+			if( size() != view.size() ) return false;
+
+			for( size_t i = 0; i < size(); ++i )
+			{
+				if( _begin[ i ] != view[ i ] ) return false;
+			}
+
+			return true;
+		}
+
+		bool operator!=( const StringView& view ) const
+		{
+			return !( *this == view );
+		}
+
+	private:
+		const char* _begin;
+		const char* _end;
+	};
+
+	/*! \brief A vector of views with inline storage for the common case
+
+		Splitting a knob or a path rarely produces more than a handful of
+		pieces, the results live on the stack and the heap is only touched
+		on overflow. */
+	class StringViewVector
+	{
+	public:
+		static const size_t InlineSize = 8;
+
+	public:
+		StringViewVector() : _data( _inline ), _size( 0 ),
+			_capacity( InlineSize )
+		{
+
+		}
+
+		StringViewVector( const StringViewVector& vector )
+			: _data( _inline ), _size( 0 ), _capacity( InlineSize )
+		{
+			for( size_t i = 0; i < vector.size(); ++i )
+			{
+				push_back( vector[ i ] );
+			}
+		}
+
+		StringViewVector& operator=( const StringViewVector& vector )
+		{
+			if( this == &vector ) return *this;
+
+			_size = 0;
+
+			for( size_t i = 0; i < vector.size(); ++i )
+			{
+				push_back( vector[ i ] );
+			}
+
+			return *this;
+		}
+
+		~StringViewVector()
+		{
+			if( _data != _inline ) delete[] _data;
+		}
+
+	public:
+		void push_back( const StringView& view )
+		{
+			if( _size == _capacity ) _grow();
+
+			_data[ _size++ ] = view;
+		}
+
+		size_t size()  const { return _size;      }
+		bool   empty() const { return _size == 0; }
+
+		const StringView& operator[]( size_t index ) const
+		{
+			return _data[ index ];
+		}
+
+		const StringView* begin() const { return _data;         }
+		const StringView* end()   const { return _data + _size; }
+
+	private:
+		void _grow()
+		{
+			size_t capacity = _capacity * 2;
+
+			StringView* data = new StringView[ capacity ];
+
+			for( size_t i = 0; i < _size; ++i ) data[ i ] = _data[ i ];
+
+			if( _data != _inline ) delete[] _data;
+
+			_data     = data;
+			_capacity = capacity;
+		}
+
+	private:
+		StringView  _inline[ InlineSize ];
+		StringView* _data;
+		size_t      _size;
+		size_t      _capacity;
+	};
+
+	/*! \brief Is the character whitespace? */
+	inline bool isWhitespace( char c )
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	/*! \brief Split a view into subviews divided on a delimiter, no
+		characters are copied */
+	inline StringViewVector splitView( const StringView& string,
+		const StringView& delimiter = " " )
+	{
+		size_t begin = 0;
+		size_t end = 0;
+		StringViewVector views;
+
+		while( end != StringView::npos )
+		{
+			end = string.find( delimiter, begin );
+
+			size_t length = ( end == StringView::npos ?
+				string.size() : end ) - begin;
+
+			if( length != 0 )
+			{
+				views.push_back( string.substr( begin, length ) );
+			}
+
+			begin = end + delimiter.size();
+		}
+
+		return views;
+	}
+
+	/*! \brief Removing leading and trailing whitespace, as a view into
+		the original string */
+	inline StringView removeWhitespaceView( const StringView& string )
+	{
+		size_t start = 0;
+		size_t end   = string.size();
+
+		for( ; start < end; ++start )
+		{
+			if( !isWhitespace( string[ start ] ) ) break;
+		}
+
+		for( ; end > start + 1; --end )
+		{
+			if( !isWhitespace( string[ end - 1 ] ) ) break;
+		}
+
+		return string.substr( start, end - start );
+	}
+
 	/*! \brief Safe string copy
 		
 		\param destination The target string
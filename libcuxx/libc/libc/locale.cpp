@@ -1,6 +1,8 @@
 
 #include <locale.h>
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 extern locale_t newlocale(int category_mask, const char *locale,
        locale_t base)
@@ -309,18 +311,38 @@ extern int sscanf_l(const char *, locale_t, const char *, ...)
 	return 0;
 }
 
-extern int snprintf_l(char *, size_t, locale_t, const char *, ...)
+/* the "C" locale is the only locale here, formatting goes straight to
+   the locale independent core in stdio.cpp */
+extern int snprintf_l(char * s, size_t n, locale_t, const char * format, ...)
 {
-	assert(false && "not implemented");
+	va_list arguments;
 
-	return 0;
+	va_start(arguments, format);
+	int total = vsnprintf(s, n, format, arguments);
+	va_end(arguments);
+
+	return total;
 }
 
 extern int asprintf_l(char **strp, locale_t, const char *fmt, ...)
 {
-	assert(false && "not implemented");
+	va_list arguments;
 
-	return 0;
+	va_start(arguments, fmt);
+	int total = vsnprintf(0, 0, fmt, arguments);
+	va_end(arguments);
+
+	if(total < 0) return total;
+
+	*strp = (char*)malloc(total + 1);
+
+	if(*strp == 0) return -1;
+
+	va_start(arguments, fmt);
+	total = vsnprintf(*strp, total + 1, fmt, arguments);
+	va_end(arguments);
+
+	return total;
 }
 
 extern size_t strftime_l(char * s, size_t maxsize, const char * format, const struct tm * timeptr, locale_t locale)
@@ -0,0 +1,209 @@
+/*! \file   AliasAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the AliasAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/AliasAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Variable.h>
+#include <vanaheimr/ir/interface/Argument.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+AliasAnalysis::AliasAnalysis()
+: FunctionAnalysis("AliasAnalysis")
+{
+
+}
+
+const ir::Operand* AliasAnalysis::getAddress(
+	const ir::Instruction& instruction)
+{
+	switch(instruction.opcode)
+	{
+	case ir::Instruction::Ld:
+	{
+		return static_cast<const ir::UnaryInstruction&>(instruction).a();
+	}
+	case ir::Instruction::St:
+	{
+		return static_cast<const ir::St&>(instruction).d();
+	}
+	case ir::Instruction::Atom:
+	{
+		return static_cast<const ir::BinaryInstruction&>(instruction).a();
+	}
+	default: break;
+	}
+
+	return nullptr;
+}
+
+/*! \brief The operand holding the moved value, its type gives the
+	access width */
+static const ir::Operand* getValue(const ir::Instruction& instruction)
+{
+	switch(instruction.opcode)
+	{
+	case ir::Instruction::Ld:
+	{
+		return static_cast<const ir::UnaryInstruction&>(instruction).d();
+	}
+	case ir::Instruction::St:
+	{
+		return static_cast<const ir::St&>(instruction).a();
+	}
+	case ir::Instruction::Atom:
+	{
+		return static_cast<const ir::BinaryInstruction&>(instruction).d();
+	}
+	default: break;
+	}
+
+	return nullptr;
+}
+
+/*! \brief The bytes the operation touches, zero when unknown */
+static size_t accessedBytes(const ir::Instruction& instruction)
+{
+	auto value = getValue(instruction);
+
+	if(value == nullptr)         return 0;
+	if(value->type() == nullptr) return 0;
+
+	return value->type()->bytes();
+}
+
+/*! \brief Split an address into a base register and constant offset */
+static bool getBaseAndOffset(const ir::VirtualRegister*& base,
+	int64_t& offset, const ir::Operand* address)
+{
+	if(address->mode() == ir::Operand::Register)
+	{
+		base   = static_cast<const ir::RegisterOperand*>(
+			address)->virtualRegister;
+		offset = 0;
+
+		return base != nullptr;
+	}
+
+	if(address->mode() == ir::Operand::Indirect)
+	{
+		auto indirect = static_cast<const ir::IndirectOperand*>(address);
+
+		base   = indirect->virtualRegister;
+		offset = indirect->offset;
+
+		return base != nullptr;
+	}
+
+	return false;
+}
+
+AliasAnalysis::AliasResult AliasAnalysis::alias(const ir::Instruction& first,
+	const ir::Instruction& second) const
+{
+	if(!first.accessesMemory())  return NoAlias;
+	if(!second.accessesMemory()) return NoAlias;
+
+	auto firstAddress  = getAddress(first);
+	auto secondAddress = getAddress(second);
+
+	if(firstAddress  == nullptr) return MayAlias;
+	if(secondAddress == nullptr) return MayAlias;
+
+	// distinct named variables occupy distinct storage, this also
+	// separates the PTX address spaces since a variable lives in one
+	if(firstAddress->isAddress() && secondAddress->isAddress())
+	{
+		auto firstVariable = static_cast<const ir::AddressOperand*>(
+			firstAddress)->globalValue;
+		auto secondVariable = static_cast<const ir::AddressOperand*>(
+			secondAddress)->globalValue;
+
+		if(firstVariable  == nullptr) return MayAlias;
+		if(secondVariable == nullptr) return MayAlias;
+
+		return firstVariable == secondVariable ? MustAlias : NoAlias;
+	}
+
+	// arguments live in parameter space, nothing overlaps it but the
+	// argument itself
+	if(firstAddress->isArgument() || secondAddress->isArgument())
+	{
+		if(firstAddress->isArgument() && secondAddress->isArgument())
+		{
+			auto firstArgument = static_cast<const ir::ArgumentOperand*>(
+				firstAddress)->argument;
+			auto secondArgument = static_cast<const ir::ArgumentOperand*>(
+				secondAddress)->argument;
+
+			if(firstArgument  == nullptr) return MayAlias;
+			if(secondArgument == nullptr) return MayAlias;
+
+			return firstArgument == secondArgument ? MustAlias : NoAlias;
+		}
+
+		if(firstAddress->isAddress())  return NoAlias;
+		if(secondAddress->isAddress()) return NoAlias;
+
+		return MayAlias;
+	}
+
+	// accesses off the same base register are separated by their
+	// constant offsets and widths, different bases tell us nothing
+	const ir::VirtualRegister* firstBase  = nullptr;
+	const ir::VirtualRegister* secondBase = nullptr;
+
+	int64_t firstOffset  = 0;
+	int64_t secondOffset = 0;
+
+	if(!getBaseAndOffset(firstBase,  firstOffset,  firstAddress))
+	{
+		return MayAlias;
+	}
+
+	if(!getBaseAndOffset(secondBase, secondOffset, secondAddress))
+	{
+		return MayAlias;
+	}
+
+	if(firstBase != secondBase) return MayAlias;
+
+	if(firstOffset == secondOffset) return MustAlias;
+
+	int64_t firstBytes  = accessedBytes(first);
+	int64_t secondBytes = accessedBytes(second);
+
+	if(firstBytes  == 0) return MayAlias;
+	if(secondBytes == 0) return MayAlias;
+
+	if(firstOffset  + firstBytes  <= secondOffset) return NoAlias;
+	if(secondOffset + secondBytes <= firstOffset)  return NoAlias;
+
+	return MayAlias;
+}
+
+void AliasAnalysis::analyze(Function& function)
+{
+	// all of the rules are local to an operand pair, there is nothing
+	// to precompute per function
+}
+
+}
+
+}
@@ -19,7 +19,7 @@ namespace analysis
 {
 
 Analysis::Analysis(Type t, const std::string& n, const StringVector& r)
-: type(t), name(n), required(r), _manager(0)
+: type(t), name(n), required(r), _manager(0), _localAnalyses(nullptr)
 {
 
 }
@@ -41,19 +41,43 @@ ModuleAnalysis::ModuleAnalysis(const std::string& n, const StringVector& r)
 
 }
 
+void Analysis::invalidateFunction(Function& function)
+{
+	// analyses that hold per-function caches override this
+}
+
 void Analysis::setPassManager(transforms::PassManager* m)
 {
 	_manager = m;
 }
 
+void Analysis::setLocalAnalyses(AnalysisMap* analyses)
+{
+	_localAnalyses = analyses;
+}
+
 Analysis* Analysis::getAnalysis(const std::string& name)
 {
+	if(_localAnalyses != nullptr)
+	{
+		auto analysis = _localAnalyses->find(name);
+
+		return analysis == _localAnalyses->end() ? nullptr : analysis->second;
+	}
+
 	assert(_manager != 0);
 	return _manager->getAnalysis(name);
 }
 
 const Analysis* Analysis::getAnalysis(const std::string& name) const
 {
+	if(_localAnalyses != nullptr)
+	{
+		auto analysis = _localAnalyses->find(name);
+
+		return analysis == _localAnalyses->end() ? nullptr : analysis->second;
+	}
+
 	assert(_manager != 0);
 	return _manager->getAnalysis(name);
 }
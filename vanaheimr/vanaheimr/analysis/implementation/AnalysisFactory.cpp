@@ -11,10 +11,27 @@
 #include <vanaheimr/analysis/interface/ControlFlowGraph.h>
 #include <vanaheimr/analysis/interface/DataflowAnalysis.h>
 #include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
 #include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
 #include <vanaheimr/analysis/interface/DependenceAnalysis.h>
 #include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
 #include <vanaheimr/analysis/interface/InterferenceAnalysis.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+#include <vanaheimr/analysis/interface/ThreadFrontierAnalysis.h>
+#include <vanaheimr/analysis/interface/CallGraphAnalysis.h>
+#include <vanaheimr/analysis/interface/RegisterPressureAnalysis.h>
+#include <vanaheimr/analysis/interface/BranchProbabilityAnalysis.h>
+#include <vanaheimr/analysis/interface/BlockFrequencyAnalysis.h>
+#include <vanaheimr/analysis/interface/AliasAnalysis.h>
+#include <vanaheimr/analysis/interface/InductionVariableAnalysis.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+
+// Standard Library Includes
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cassert>
 
 namespace vanaheimr
 {
@@ -39,6 +56,10 @@ Analysis* AnalysisFactory::createAnalysis(const std::string& name,
 	{
 		analysis = new DominatorAnalysis;
 	}
+	else if (name == "PostDominatorAnalysis")
+	{
+		analysis = new PostDominatorAnalysis;
+	}
 	else if (name == "ReversePostOrderTraversal")
 	{
 		analysis = new ReversePostOrderTraversal;
@@ -55,6 +76,38 @@ Analysis* AnalysisFactory::createAnalysis(const std::string& name,
 	{
 		analysis = new InterferenceAnalysis;
 	}
+	else if (name == "LoopAnalysis")
+	{
+		analysis = new LoopAnalysis;
+	}
+	else if (name == "ThreadFrontierAnalysis")
+	{
+		analysis = new ThreadFrontierAnalysis;
+	}
+	else if (name == "CallGraphAnalysis")
+	{
+		analysis = new CallGraphAnalysis;
+	}
+	else if (name == "RegisterPressureAnalysis")
+	{
+		analysis = new RegisterPressureAnalysis;
+	}
+	else if (name == "BranchProbabilityAnalysis")
+	{
+		analysis = new BranchProbabilityAnalysis;
+	}
+	else if (name == "BlockFrequencyAnalysis")
+	{
+		analysis = new BlockFrequencyAnalysis;
+	}
+	else if (name == "AliasAnalysis")
+	{
+		analysis = new AliasAnalysis;
+	}
+	else if (name == "InductionVariableAnalysis")
+	{
+		analysis = new InductionVariableAnalysis;
+	}
 
 	if(analysis != nullptr)
 	{
@@ -64,6 +117,96 @@ Analysis* AnalysisFactory::createAnalysis(const std::string& name,
 	return analysis;
 }
 
+typedef AnalysisFactory::AnalysisMap AnalysisMap;
+
+Analysis* AnalysisFactory::createAnalysisForFunction(const std::string& name,
+	ir::Function& function, AnalysisMap& analyses)
+{
+	auto existing = analyses.find(name);
+
+	if(existing != analyses.end()) return existing->second;
+
+	auto newAnalysis = AnalysisFactory::createAnalysis(name);
+	assert(newAnalysis != nullptr);
+
+	// dependencies are resolved through the caller's private map
+	newAnalysis->setLocalAnalyses(&analyses);
+
+	for(auto required : newAnalysis->required)
+	{
+		createAnalysisForFunction(required, function, analyses);
+	}
+
+	assert(newAnalysis->type == Analysis::FunctionAnalysis);
+
+	static_cast<FunctionAnalysis*>(newAnalysis)->analyze(function);
+
+	analyses.insert(std::make_pair(name, newAnalysis));
+
+	return newAnalysis;
+}
+
+void AnalysisFactory::createAnalysesForModule(ir::Module& module,
+	const StringVector& names, FunctionAnalysisMap& analyses,
+	unsigned int workers)
+{
+	typedef std::vector<ir::Function*> FunctionVector;
+	typedef std::vector<AnalysisMap*>  AnalysisMapVector;
+	typedef std::vector<std::thread>   ThreadVector;
+
+	if(workers == 0) workers = std::thread::hardware_concurrency();
+	if(workers == 0) workers = 1;
+
+	FunctionVector    functions;
+	AnalysisMapVector maps;
+
+	// materialize serially, binary reads are not thread safe, and create
+	// the map entries up front so workers never mutate the outer map
+	for(auto function = module.begin();
+		function != module.end(); ++function)
+	{
+		function->materialize();
+
+		auto map = analyses.insert(std::make_pair(
+			function->name(), AnalysisMap())).first;
+
+		functions.push_back(&*function);
+		maps.push_back(&map->second);
+	}
+
+	std::atomic<size_t> nextFunction(0);
+
+	auto worker = [&]()
+	{
+		while(true)
+		{
+			size_t index = nextFunction++;
+
+			if(index >= functions.size()) break;
+
+			for(auto& name : names)
+			{
+				createAnalysisForFunction(name,
+					*functions[index], *maps[index]);
+			}
+		}
+	};
+
+	ThreadVector threads;
+
+	for(unsigned int i = 1; i < workers; ++i)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	worker();
+
+	for(auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
 }
 
 }
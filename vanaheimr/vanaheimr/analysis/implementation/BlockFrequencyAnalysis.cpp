@@ -0,0 +1,148 @@
+/*! \file   BlockFrequencyAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the BlockFrequencyAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/BlockFrequencyAnalysis.h>
+
+#include <vanaheimr/analysis/interface/BranchProbabilityAnalysis.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief The largest factor one loop may scale its members by, keeps
+	unknown trip counts from drowning out everything else */
+static const double MaximumLoopScale = 64.0;
+
+BlockFrequencyAnalysis::BlockFrequencyAnalysis()
+: FunctionAnalysis("BlockFrequencyAnalysis", {"ControlFlowGraph",
+	"ReversePostOrderTraversal", "BranchProbabilityAnalysis",
+	"LoopAnalysis"}), _maxFrequency(0.0)
+{
+
+}
+
+double BlockFrequencyAnalysis::getFrequency(const BasicBlock& block) const
+{
+	if(block.id() >= _frequencies.size()) return 0.0;
+
+	return _frequencies[block.id()];
+}
+
+double BlockFrequencyAnalysis::maxFrequency() const
+{
+	return _maxFrequency;
+}
+
+void BlockFrequencyAnalysis::analyze(Function& function)
+{
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto rpo = static_cast<ReversePostOrderTraversal*>(
+		getAnalysis("ReversePostOrderTraversal"));
+	assert(rpo != nullptr);
+
+	auto probabilities = static_cast<BranchProbabilityAnalysis*>(
+		getAnalysis("BranchProbabilityAnalysis"));
+	assert(probabilities != nullptr);
+
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	_frequencies.clear();
+	_maxFrequency = 0.0;
+
+	// propagate in reverse post order, every non-back predecessor is
+	// final before its successors are visited
+	for(auto block : rpo->order)
+	{
+		double frequency = block == rpo->order.front() ? 1.0 : 0.0;
+
+		for(auto predecessor : cfg->getPredecessors(*block))
+		{
+			// back edges are folded into the loop scale instead
+			bool backEdge = false;
+
+			for(auto loop = loops->getLoopAt(*predecessor);
+				loop != nullptr; loop = loop->parent)
+			{
+				if(loop->header == block)
+				{
+					backEdge = true;
+					break;
+				}
+			}
+
+			if(backEdge) continue;
+
+			frequency += getFrequency(*predecessor) *
+				probabilities->getEdgeProbability(*predecessor, *block);
+		}
+
+		if(block->id() >= _frequencies.size())
+		{
+			_frequencies.resize(block->id() + 1, 0.0);
+		}
+
+		_frequencies[block->id()] = frequency;
+	}
+
+	// every loop scales its members by the expected trip count, nested
+	// blocks compound because they are members of each enclosing loop
+	for(auto loop = loops->begin(); loop != loops->end(); ++loop)
+	{
+		double scale = loops->getTripCount(*loop);
+
+		if(scale == 0.0)
+		{
+			double backEdge = 0.0;
+
+			auto latch = loops->getLatch(*loop);
+
+			if(latch != nullptr)
+			{
+				backEdge = probabilities->getEdgeProbability(
+					*latch, *loop->header);
+			}
+
+			scale = backEdge < 1.0 ? 1.0 / (1.0 - backEdge)
+				: MaximumLoopScale;
+		}
+
+		scale = std::max(1.0, std::min(scale, MaximumLoopScale));
+
+		for(auto block : loop->blocks)
+		{
+			if(block->id() >= _frequencies.size()) continue;
+
+			_frequencies[block->id()] *= scale;
+		}
+	}
+
+	for(auto frequency : _frequencies)
+	{
+		_maxFrequency = std::max(_maxFrequency, frequency);
+	}
+}
+
+}
+
+}
+
@@ -0,0 +1,149 @@
+/*! \file   BranchProbabilityAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the BranchProbabilityAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/BranchProbabilityAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/ProfileMetaData.h>
+
+// Standard Library Includes
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief The static odds that a branch staying in its loop is taken */
+static const double LoopBranchProbability = 0.875;
+
+BranchProbabilityAnalysis::BranchProbabilityAnalysis()
+: FunctionAnalysis("BranchProbabilityAnalysis",
+	{"ControlFlowGraph", "LoopAnalysis"})
+{
+
+}
+
+double BranchProbabilityAnalysis::getEdgeProbability(
+	const BasicBlock& head, const BasicBlock& tail) const
+{
+	if(head.id() >= _probabilities.size()) return 0.0;
+
+	auto& successors = _probabilities[head.id()];
+
+	auto probability = successors.find(tail.id());
+
+	if(probability == successors.end()) return 0.0;
+
+	return probability->second;
+}
+
+void BranchProbabilityAnalysis::analyze(Function& function)
+{
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	_probabilities.clear();
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto successors = cfg->getSuccessors(*block);
+
+		if(successors.empty()) continue;
+
+		if(block->id() >= _probabilities.size())
+		{
+			_probabilities.resize(block->id() + 1);
+		}
+
+		auto& probabilities = _probabilities[block->id()];
+
+		if(successors.size() == 1)
+		{
+			probabilities[(*successors.begin())->id()] = 1.0;
+
+			continue;
+		}
+
+		auto terminator = block->terminator();
+
+		auto target = static_cast<BasicBlock*>(nullptr);
+		auto other  = static_cast<BasicBlock*>(nullptr);
+
+		if(successors.size() == 2 && terminator != nullptr &&
+			terminator->isBranch())
+		{
+			auto branch = static_cast<ir::Bra*>(terminator);
+
+			target = branch->targetBasicBlock();
+
+			if(successors.count(target) == 0) target = nullptr;
+
+			for(auto successor : successors)
+			{
+				if(successor != target) other = successor;
+			}
+		}
+
+		if(target != nullptr && other != nullptr)
+		{
+			// measured counts beat any heuristic
+			auto profile = dynamic_cast<const ir::ProfileMetaData*>(
+				terminator->metadata());
+
+			if(profile != nullptr && profile->executions > 0 &&
+				profile->taken <= profile->executions)
+			{
+				double taken = (double)profile->taken /
+					(double)profile->executions;
+
+				probabilities[target->id()] = taken;
+				probabilities[other->id()]  = 1.0 - taken;
+
+				continue;
+			}
+
+			// edges that stay in the loop beat edges that leave it
+			auto loop = loops->getLoopAt(*block);
+
+			if(loop != nullptr &&
+				loop->contains(target) != loop->contains(other))
+			{
+				auto inside  = loop->contains(target) ? target : other;
+				auto outside = inside == target       ? other  : target;
+
+				probabilities[inside->id()]  = LoopBranchProbability;
+				probabilities[outside->id()] = 1.0 - LoopBranchProbability;
+
+				continue;
+			}
+		}
+
+		// nothing is known, split evenly
+		double even = 1.0 / successors.size();
+
+		for(auto successor : successors)
+		{
+			probabilities[successor->id()] = even;
+		}
+	}
+}
+
+}
+
+}
+
@@ -0,0 +1,281 @@
+/*! \file   CallGraphAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CallGraphAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/CallGraphAnalysis.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <stack>
+#include <algorithm>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+CallGraphAnalysis::CallGraphAnalysis()
+: ModuleAnalysis("CallGraphAnalysis")
+{
+
+}
+
+const CallGraphAnalysis::FunctionVector& CallGraphAnalysis::getCallees(
+	const Function& function) const
+{
+	auto callees = _callees.find(&function);
+
+	return callees == _callees.end() ? _empty : callees->second;
+}
+
+const CallGraphAnalysis::FunctionVector& CallGraphAnalysis::getCallers(
+	const Function& function) const
+{
+	auto callers = _callers.find(&function);
+
+	return callers == _callers.end() ? _empty : callers->second;
+}
+
+const CallGraphAnalysis::FunctionVector&
+	CallGraphAnalysis::getBottomUpOrder() const
+{
+	return _bottomUpOrder;
+}
+
+unsigned int CallGraphAnalysis::getComponent(const Function& function) const
+{
+	auto component = _components.find(&function);
+
+	assert(component != _components.end());
+
+	return component->second;
+}
+
+bool CallGraphAnalysis::isRecursive(const Function& function) const
+{
+	if(_selfRecursive.count(&function) != 0) return true;
+
+	auto component = _components.find(&function);
+
+	if(component == _components.end()) return false;
+
+	return _componentSizes[component->second] > 1;
+}
+
+/*! \brief The function a call targets directly, nullptr for indirect
+	calls and calls leaving the module */
+static ir::Function* getDirectCallee(ir::Module& module,
+	ir::Instruction* instruction)
+{
+	auto call = static_cast<ir::Call*>(instruction);
+
+	auto target = call->target();
+
+	if(target == nullptr)                               return nullptr;
+	if(target->mode() != ir::Operand::Address)          return nullptr;
+
+	auto value = static_cast<ir::AddressOperand*>(target)->globalValue;
+
+	if(value == nullptr) return nullptr;
+
+	// Variable is not polymorphic, resolve through the module
+	auto function = module.getFunction(value->name());
+
+	if(function == module.end())    return nullptr;
+	if(&*function != value)         return nullptr;
+
+	return &*function;
+}
+
+void CallGraphAnalysis::analyze(Module& module)
+{
+	report("Building call graph for module '" << module.name << "'");
+
+	_callees.clear();
+	_callers.clear();
+	_components.clear();
+	_componentSizes.clear();
+	_selfRecursive.clear();
+	_bottomUpOrder.clear();
+
+	for(auto function = module.begin();
+		function != module.end(); ++function)
+	{
+		auto& callees = _callees[&*function];
+
+		for(auto block = function->begin();
+			block != function->end(); ++block)
+		{
+			for(auto instruction : *block)
+			{
+				if(!instruction->isCall())      continue;
+				if(instruction->isIntrinsic())  continue;
+
+				auto callee = getDirectCallee(module, instruction);
+
+				if(callee == nullptr) continue;
+
+				report(" " << function->name()
+					<< " -> " << callee->name());
+
+				if(callee == &*function)
+				{
+					_selfRecursive.insert(&*function);
+				}
+
+				// parallel edges are kept, they carry call frequency
+				callees.push_back(callee);
+
+				_callers[callee].push_back(&*function);
+			}
+		}
+	}
+
+	_findComponents();
+}
+
+void CallGraphAnalysis::_findComponents()
+{
+	// Iterative Tarjan over the callee edges.  Components complete in
+	// callees-first order, which is exactly the bottom-up order
+	class NodeState
+	{
+	public:
+		unsigned int index;
+		unsigned int lowLink;
+		bool         onStack;
+		bool         visited;
+	};
+
+	typedef std::unordered_map<const Function*, NodeState> NodeStateMap;
+
+	class Frame
+	{
+	public:
+		Function*    function;
+		unsigned int nextCallee;
+	};
+
+	NodeStateMap states;
+
+	std::stack<Frame>     callStack;
+	std::vector<Function*> componentStack;
+
+	unsigned int nextIndex = 0;
+
+	for(auto& entry : _callees)
+	{
+		auto root = const_cast<Function*>(entry.first);
+
+		if(states[root].visited) continue;
+
+		callStack.push(Frame{root, 0});
+
+		states[root] = NodeState{nextIndex, nextIndex, true, true};
+
+		++nextIndex;
+
+		componentStack.push_back(root);
+
+		while(!callStack.empty())
+		{
+			auto& frame = callStack.top();
+
+			auto& callees = _callees[frame.function];
+
+			if(frame.nextCallee < callees.size())
+			{
+				auto callee = callees[frame.nextCallee++];
+
+				auto& calleeState = states[callee];
+
+				if(!calleeState.visited)
+				{
+					calleeState = NodeState{nextIndex, nextIndex,
+						true, true};
+
+					++nextIndex;
+
+					componentStack.push_back(callee);
+					callStack.push(Frame{callee, 0});
+				}
+				else if(calleeState.onStack)
+				{
+					auto& state = states[frame.function];
+
+					state.lowLink = std::min(state.lowLink,
+						calleeState.index);
+				}
+
+				continue;
+			}
+
+			// the node is finished, pop and propagate the low link
+			auto finished = frame.function;
+
+			callStack.pop();
+
+			auto& state = states[finished];
+
+			if(!callStack.empty())
+			{
+				auto& parentState = states[callStack.top().function];
+
+				parentState.lowLink = std::min(parentState.lowLink,
+					state.lowLink);
+			}
+
+			if(state.lowLink != state.index) continue;
+
+			// a component root, everything above it on the stack
+			// belongs to the component
+			unsigned int component = _componentSizes.size();
+
+			_componentSizes.push_back(0);
+
+			while(true)
+			{
+				auto member = componentStack.back();
+
+				componentStack.pop_back();
+
+				states[member].onStack = false;
+
+				_components[member] = component;
+
+				++_componentSizes[component];
+
+				_bottomUpOrder.push_back(member);
+
+				if(member == finished) break;
+			}
+		}
+	}
+
+	report(" found " << _componentSizes.size() << " components over "
+		<< _bottomUpOrder.size() << " functions");
+}
+
+}
+
+}
+
@@ -12,6 +12,7 @@
 #include <vanaheimr/ir/interface/Instruction.h>
 
 // Standard Library Includes
+#include <algorithm>
 #include <cassert>
 
 namespace vanaheimr
@@ -21,7 +22,8 @@ namespace analysis
 {
 
 ControlFlowGraph::ControlFlowGraph()
-: FunctionAnalysis("ControlFlowGraph"), _function(nullptr)
+: FunctionAnalysis("ControlFlowGraph"), _compressedGraphValid(false),
+	_function(nullptr)
 {
 
 }
@@ -69,6 +71,122 @@ bool ControlFlowGraph::isFallthroughEdge(const BasicBlock& head,
 	return isEdge(head, tail);
 }
 
+void ControlFlowGraph::addEdge(BasicBlock* head, BasicBlock* tail)
+{
+	assert(head->id() < _successors.size());
+	assert(tail->id() < _predecessors.size());
+
+	  _successors[head->id()].insert(tail);
+	_predecessors[tail->id()].insert(head);
+
+	_compressedGraphValid = false;
+}
+
+void ControlFlowGraph::removeEdge(BasicBlock* head, BasicBlock* tail)
+{
+	assert(head->id() < _successors.size());
+	assert(tail->id() < _predecessors.size());
+
+	  _successors[head->id()].erase(tail);
+	_predecessors[tail->id()].erase(head);
+
+	_compressedGraphValid = false;
+}
+
+void ControlFlowGraph::disconnectBlock(BasicBlock* block)
+{
+	assert(block->id() < _successors.size());
+
+	for(auto successor : _successors[block->id()])
+	{
+		_predecessors[successor->id()].erase(block);
+	}
+
+	for(auto predecessor : _predecessors[block->id()])
+	{
+		_successors[predecessor->id()].erase(block);
+	}
+
+	  _successors[block->id()].clear();
+	_predecessors[block->id()].clear();
+
+	_compressedGraphValid = false;
+}
+
+ControlFlowGraph::CompressedGraph::const_iterator
+	ControlFlowGraph::CompressedGraph::successors_begin(Id block) const
+{
+	return successors.begin() + successorOffsets[block];
+}
+
+ControlFlowGraph::CompressedGraph::const_iterator
+	ControlFlowGraph::CompressedGraph::successors_end(Id block) const
+{
+	return successors.begin() + successorOffsets[block + 1];
+}
+
+ControlFlowGraph::CompressedGraph::const_iterator
+	ControlFlowGraph::CompressedGraph::predecessors_begin(Id block) const
+{
+	return predecessors.begin() + predecessorOffsets[block];
+}
+
+ControlFlowGraph::CompressedGraph::const_iterator
+	ControlFlowGraph::CompressedGraph::predecessors_end(Id block) const
+{
+	return predecessors.begin() + predecessorOffsets[block + 1];
+}
+
+size_t ControlFlowGraph::CompressedGraph::size() const
+{
+	return successorOffsets.empty() ? 0 : successorOffsets.size() - 1;
+}
+
+const ControlFlowGraph::CompressedGraph& ControlFlowGraph::compressedGraph()
+{
+	if(_compressedGraphValid) return _compressedGraph;
+	
+	_compressedGraph.successorOffsets.clear();
+	_compressedGraph.successors.clear();
+	_compressedGraph.predecessorOffsets.clear();
+	_compressedGraph.predecessors.clear();
+	
+	_compressedGraph.successorOffsets.reserve(_successors.size() + 1);
+	_compressedGraph.predecessorOffsets.reserve(_predecessors.size() + 1);
+	
+	for(auto& successors : _successors)
+	{
+		_compressedGraph.successorOffsets.push_back(
+			_compressedGraph.successors.size());
+		
+		for(auto successor : successors)
+		{
+			_compressedGraph.successors.push_back(successor->id());
+		}
+	}
+	
+	_compressedGraph.successorOffsets.push_back(
+		_compressedGraph.successors.size());
+	
+	for(auto& predecessors : _predecessors)
+	{
+		_compressedGraph.predecessorOffsets.push_back(
+			_compressedGraph.predecessors.size());
+		
+		for(auto predecessor : predecessors)
+		{
+			_compressedGraph.predecessors.push_back(predecessor->id());
+		}
+	}
+	
+	_compressedGraph.predecessorOffsets.push_back(
+		_compressedGraph.predecessors.size());
+	
+	_compressedGraphValid = true;
+	
+	return _compressedGraph;
+}
+
 ir::Function* ControlFlowGraph::function()
 {
 	return _function;
@@ -79,32 +197,132 @@ const ir::Function* ControlFlowGraph::function() const
 	return _function;
 }
 
-void ControlFlowGraph::analyze(Function& function)
+void ControlFlowGraph::beginBulkConstruction(Function& function)
 {
-	// perform the analysis sequentially
+	_function = &function;
+
+	  _successors.clear();
+	_predecessors.clear();
+
 	  _successors.resize(function.size());
 	_predecessors.resize(function.size());
-		
-	_function = &function;
-		
+
+	_bulkEdges.clear();
+
+	_compressedGraphValid = false;
+}
+
+void ControlFlowGraph::addBulkEdge(BasicBlock* head, BasicBlock* tail)
+{
+	assert(head->id() < _successors.size());
+	assert(tail->id() < _successors.size());
+
+	_bulkEdges.push_back(Edge(head, tail));
+}
+
+void ControlFlowGraph::freeze()
+{
+	auto& csr = _compressedGraph;
+
+	csr.successorOffsets.clear();
+	csr.successors.clear();
+	csr.predecessorOffsets.clear();
+	csr.predecessors.clear();
+
+	csr.successorOffsets.reserve(_successors.size() + 1);
+	csr.predecessorOffsets.reserve(_predecessors.size() + 1);
+
+	// sorting by head groups each block's out edges, and ascending tail
+	// pointers append to the sorted sets instead of shifting them
+	std::sort(_bulkEdges.begin(), _bulkEdges.end(),
+		[](const Edge& left, const Edge& right)
+		{
+			if(left.first->id() != right.first->id())
+			{
+				return left.first->id() < right.first->id();
+			}
+
+			return left.second < right.second;
+		});
+
+	_bulkEdges.erase(std::unique(_bulkEdges.begin(), _bulkEdges.end()),
+		_bulkEdges.end());
+
+	csr.successors.reserve(_bulkEdges.size());
+	csr.predecessors.reserve(_bulkEdges.size());
+
+	auto edge = _bulkEdges.begin();
+
+	for(size_t id = 0; id != _successors.size(); ++id)
+	{
+		csr.successorOffsets.push_back(csr.successors.size());
+
+		for(; edge != _bulkEdges.end() && edge->first->id() == id; ++edge)
+		{
+			_successors[id].insert(edge->second);
+
+			csr.successors.push_back(edge->second->id());
+		}
+	}
+
+	csr.successorOffsets.push_back(csr.successors.size());
+
+	// regroup by tail for the in edges
+	std::sort(_bulkEdges.begin(), _bulkEdges.end(),
+		[](const Edge& left, const Edge& right)
+		{
+			if(left.second->id() != right.second->id())
+			{
+				return left.second->id() < right.second->id();
+			}
+
+			return left.first < right.first;
+		});
+
+	edge = _bulkEdges.begin();
+
+	for(size_t id = 0; id != _predecessors.size(); ++id)
+	{
+		csr.predecessorOffsets.push_back(csr.predecessors.size());
+
+		for(; edge != _bulkEdges.end() && edge->second->id() == id; ++edge)
+		{
+			_predecessors[id].insert(edge->first);
+
+			csr.predecessors.push_back(edge->first->id());
+		}
+	}
+
+	csr.predecessorOffsets.push_back(csr.predecessors.size());
+
+	_bulkEdges.clear();
+
+	_compressedGraphValid = true;
+}
+
+void ControlFlowGraph::analyze(Function& function)
+{
+	beginBulkConstruction(function);
+
 	// should be for-all
 	for(auto block = function.begin(); block != function.end(); ++block)
 	{
 		BasicBlock* nextBlock = nullptr;
-		
+
 		auto next = block; ++next;
-		
+
 		if(next != function.end())
 		{
 			nextBlock = &*next;
 		}
-			
-		_initializePredecessorsAndSuccessors(&*block, nextBlock);
+
+		_addBlockEdges(&*block, nextBlock);
 	}
+
+	freeze();
 }
 
-void ControlFlowGraph::_initializePredecessorsAndSuccessors(BasicBlock* block,
-	BasicBlock* next)
+void ControlFlowGraph::_addBlockEdges(BasicBlock* block, BasicBlock* next)
 {
 	BasicBlock* fallthrough = nullptr;
 	BasicBlock* target      = nullptr;
@@ -150,46 +368,16 @@ void ControlFlowGraph::_initializePredecessorsAndSuccessors(BasicBlock* block,
 		target = branch->targetBasicBlock();
 	}
 	
-	// populate successor set
-	BasicBlockSet& successors = _successors[block->id()];
-	
+	// collect the edges, freeze() groups them into the sets and the
+	// CSR form in one pass over the sorted batch
 	if(fallthrough != nullptr)
 	{
-		successors.insert(fallthrough);
-	}
-	
-	if(target != nullptr)
-	{
-		successors.insert(target);
+		addBulkEdge(block, fallthrough);
 	}
-	
-	// populate predecessor sets, for a parallel algorithm, this 
-	//  would need to create lists of predecessors for each block and
-	//  then convert them into sets.
-	// 
-	// One of these algorithms would be possible:
-	// 1) add (head, tail) pairs to an array, sort them by tail,
-	//    then group by tail, each group becomes a set
-	// 2) atomically add pairs by tail
-	//
-	//
-	// For all of these, fallthroughs can go in parallel first since no
-	// collisions are possible
-	
-	// in parallel
-	if(fallthrough != nullptr)
-	{
-		BasicBlockSet& predecessors = _predecessors[fallthrough->id()];
-		
-		predecessors.insert(&*block);
-	}
-	
-	// TODO: handle conflicts
+
 	if(target != nullptr)
 	{
-		BasicBlockSet& predecessors = _predecessors[target->id()];
-		
-		predecessors.insert(&*block);
+		addBulkEdge(block, target);
 	}
 }
 
@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/DataflowAnalysis.h>
 #include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
@@ -16,6 +17,8 @@
 
 // Standard Library Includes
 #include <cassert>
+#include <list>
+#include <algorithm>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -31,7 +34,8 @@ namespace analysis
 {
 
 DataflowAnalysis::DataflowAnalysis()
-: FunctionAnalysis("DataflowAnalysis", StringVector(1, "ControlFlowGraph"))
+: FunctionAnalysis("DataflowAnalysis", StringVector({"ControlFlowGraph",
+	"ReversePostOrderTraversal"}))
 {
 
 }
@@ -39,17 +43,29 @@ DataflowAnalysis::DataflowAnalysis()
 DataflowAnalysis::VirtualRegisterSet
 	DataflowAnalysis::getLiveIns(const BasicBlock& block)
 {
-	assert(block.id() < _liveins.size());
+	assert(block.id() < _liveinBits.size());
 	
-	return _liveins[block.id()];
+	return _setFromRow(_liveinBits[block.id()]);
 }
 
 DataflowAnalysis::VirtualRegisterSet
 	DataflowAnalysis::getLiveOuts(const BasicBlock& block)
 {
-	assert(block.id() < _liveouts.size());
+	assert(block.id() < _liveoutBits.size());
 	
-	return _liveouts[block.id()];
+	return _setFromRow(_liveoutBits[block.id()]);
+}
+
+bool DataflowAnalysis::isLiveIn(const VirtualRegister& value,
+	const BasicBlock& block) const
+{
+	assert(block.id() < _liveinBits.size());
+
+	auto& row = _liveinBits[block.id()];
+
+	if(value.id >= row.size()) return false;
+
+	return row.test(value.id);
 }
 
 DataflowAnalysis::InstructionSet
@@ -92,9 +108,16 @@ DataflowAnalysis::InstructionSet
 void DataflowAnalysis::setLiveOuts(const BasicBlock& block,
 	const VirtualRegisterSet& liveOuts)
 {
-	assert(block.id() < _liveouts.size());
+	assert(block.id() < _liveoutBits.size());
 	
-	_liveouts[block.id()] = liveOuts;
+	auto& row = _liveoutBits[block.id()];
+
+	row.resetAll();
+
+	for(auto value : liveOuts)
+	{
+		row.set(value->id);
+	}
 }
 
 void DataflowAnalysis::addReachingDefinition(VirtualRegister& value,
@@ -127,20 +150,101 @@ void DataflowAnalysis::analyze(Function& function)
 
 void DataflowAnalysis::_analyzeLiveInsAndOuts(Function& function)
 {
-	 _liveins.resize(function.size());
-	_liveouts.resize(function.size());
+	typedef std::list<BasicBlock*> BlockList;
+
+	// Size the dense rows, one bit per register id
+	size_t maxId = 0;
+	
+	_registersById.clear();
+	
+	for(auto reg = function.register_begin();
+		reg != function.register_end(); ++reg)
+	{
+		maxId = std::max(maxId, (size_t)reg->id + 1);
+	}
+	
+	_registersById.assign(maxId, nullptr);
+	
+	for(auto reg = function.register_begin();
+		reg != function.register_end(); ++reg)
+	{
+		_registersById[reg->id] = &*reg;
+	}
 	
-	BasicBlockSet worklist;
+	 _liveinBits.assign(function.size(), BitRow(maxId));
+	_liveoutBits.assign(function.size(), BitRow(maxId));
+	    _useBits.assign(function.size(), BitRow(maxId));
+	    _defBits.assign(function.size(), BitRow(maxId));
 	
-	// should be for-all
+	// Precompute block-local use (upward-exposed) and def rows
 	for(auto block = function.begin(); block != function.end(); ++block)
 	{
-		worklist.insert(&*block);
+		auto& use = _useBits[block->id()];
+		auto& def = _defBits[block->id()];
+		
+		for(auto instruction = block->rbegin();
+			instruction != block->rend(); ++instruction)
+		{
+			for(auto write : (*instruction)->writes)
+			{
+				if(!write->isRegister()) continue;
+			
+				auto reg = static_cast<ir::RegisterOperand*>(write);
+				auto id  = reg->virtualRegister->id;
+
+				def.set(id);
+				use.reset(id);
+			}
+			
+			for(auto read : (*instruction)->reads)
+			{
+				if(!read->isRegister()) continue;
+			
+				auto reg = static_cast<ir::RegisterOperand*>(read);
+				auto id  = reg->virtualRegister->id;
+
+				use.set(id);
+			}
+		}
+	}
+	
+	// Seed the worklist in post order, the fastest-converging order for
+	// a backward problem
+	auto reversePostOrder = static_cast<ReversePostOrderTraversal*>(
+		getAnalysis("ReversePostOrderTraversal"));
+	
+	BlockList worklist;
+	
+	std::vector<bool> queued(function.size(), false);
+	
+	for(auto block = reversePostOrder->order.rbegin();
+		block != reversePostOrder->order.rend(); ++block)
+	{
+		worklist.push_back(*block);
+		queued[(*block)->id()] = true;
 	}
 	
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
+	
 	while(!worklist.empty())
 	{
-		_computeLocalLiveInsAndOuts(worklist);
+		auto block = worklist.front();
+		worklist.pop_front();
+		
+		queued[block->id()] = false;
+		
+		if(_recomputeLiveInsAndOutsForBlock(block))
+		{
+			auto predecessors = cfg->getPredecessors(*block);
+			
+			for(auto predecessor : predecessors)
+			{
+				if(queued[predecessor->id()]) continue;
+				
+				worklist.push_back(predecessor);
+				queued[predecessor->id()] = true;
+			}
+		}
 	}
 }
 
@@ -199,76 +303,53 @@ void DataflowAnalysis::_analyzeReachingDefinitions(Function& function)
 	}
 }
 
-void DataflowAnalysis::_computeLocalLiveInsAndOuts(BasicBlockSet& worklist)
-{
-	BasicBlockSet newList;
-
-	// should be for-all
-	for(auto block : worklist)
-	{
-		bool changed = _recomputeLiveInsAndOutsForBlock(block);
-
-		if(changed)
-		{
-			// TODO: queue up predecessors
-			newList.insert(block);
-		}
-	}
-
-	// gather blocks to form the new worklist
-	worklist = std::move(newList);
-}	
-
 bool DataflowAnalysis::_recomputeLiveInsAndOutsForBlock(BasicBlock* block)
 {
-	// live outs is the union of live-ins of all successors
-	VirtualRegisterSet liveout;
-
 	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));	
 
+	// live-out is the union (word-wise or) of successor live-ins
+	auto& liveout = _liveoutBits[block->id()];
+
+	liveout.resetAll();
+
 	auto successors = cfg->getSuccessors(*block);
 
 	for(auto successor : successors)
 	{
-		auto livein = getLiveIns(*successor);
-
-		liveout.insert(livein.begin(), livein.end());
+		liveout.unionWith(_liveinBits[successor->id()]);
 	}
 
-	_liveouts[block->id()] = liveout;
+	// transfer: in = use | (out & ~def), fused over the packed words
+	auto& use = _useBits[block->id()];
+	auto& def = _defBits[block->id()];
 
-	VirtualRegisterSet livein = std::move(liveout);
+	auto& livein = _liveinBits[block->id()];
 
-	// apply def/use rules in reverse order
-	for(auto instruction = block->rbegin(); instruction != block->rend();
-		++instruction)
+	bool changed = false;
+
+	for(size_t word = 0; word < livein.words(); ++word)
 	{
-		// spawn on uses
-		for(auto read : (*instruction)->reads)
-		{
-			if(!read->isRegister()) continue;
-		
-			auto reg = static_cast<ir::RegisterOperand*>(read);
+		uint64_t newWord = use.data()[word] |
+			(liveout.data()[word] & ~def.data()[word]);
 
-			livein.insert(reg->virtualRegister);
-		}
+		changed            |= newWord != livein.data()[word];
+		livein.data()[word] = newWord;
+	}
 
-		// kill on defs
-		for(auto write : (*instruction)->writes)
-		{
-			if(!write->isRegister()) continue;
-		
-			auto reg = static_cast<ir::RegisterOperand*>(write);
+	return changed;
+}
 
-			livein.erase(reg->virtualRegister);
-		}
-	}
+DataflowAnalysis::VirtualRegisterSet
+	DataflowAnalysis::_setFromRow(const BitRow& row) const
+{
+	VirtualRegisterSet values;
 
-	bool changed = _liveins[block->id()] != livein;
+	row.forEachSetBit([&](size_t bit)
+	{
+		values.insert(_registersById[bit]);
+	});
 
-	_liveins[block->id()] = std::move(livein);
-	
-	return changed;
+	return values;
 }
 
 }
@@ -6,6 +6,7 @@
 
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/DependenceAnalysis.h>
+#include <vanaheimr/analysis/interface/AliasAnalysis.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
@@ -31,9 +32,37 @@ namespace analysis
 {
 
 DependenceAnalysis::DependenceAnalysis()
-: FunctionAnalysis("DependenceAnalysis", {"ControlFlowGraph"})
+: FunctionAnalysis("DependenceAnalysis", {"ControlFlowGraph",
+	"AliasAnalysis"})
 {
+	_blockDAG.block = nullptr;
+}
+
+const DependenceAnalysis::BlockDependenceDAG::Node&
+	DependenceAnalysis::BlockDependenceDAG::getNode(
+	const Instruction& instruction) const
+{
+	assert(instruction.block == block);
+	assert(instruction.index() < nodes.size());
+
+	return nodes[instruction.index()];
+}
+
+DependenceAnalysis::BlockDependenceDAG::const_iterator
+	DependenceAnalysis::BlockDependenceDAG::begin() const
+{
+	return nodes.begin();
+}
+
+DependenceAnalysis::BlockDependenceDAG::const_iterator
+	DependenceAnalysis::BlockDependenceDAG::end() const
+{
+	return nodes.end();
+}
 
+size_t DependenceAnalysis::BlockDependenceDAG::size() const
+{
+	return nodes.size();
 }
 
 bool DependenceAnalysis::hasLocalDependence(const Instruction& predecessor,
@@ -55,6 +84,15 @@ DependenceAnalysis::InstructionSet DependenceAnalysis::getLocalPredecessors(
 {
 	auto block = _localPredecessors.find(successor.block->id());
 	
+	if(block == _localPredecessors.end())
+	{
+		// dependences are discovered on demand, block by block
+		const_cast<DependenceAnalysis*>(this)->_setLocalDependences(
+			*successor.block);
+
+		block = _localPredecessors.find(successor.block->id());
+	}
+
 	if(block == _localPredecessors.end()) return InstructionSet();
 	
 	assert(successor.index() < block->second.size());
@@ -67,6 +105,14 @@ DependenceAnalysis::InstructionSet DependenceAnalysis::getLocalSuccessors(
 {
 	auto block = _localSuccessors.find(predecessor.block->id());
 	
+	if(block == _localSuccessors.end())
+	{
+		const_cast<DependenceAnalysis*>(this)->_setLocalDependences(
+			*predecessor.block);
+
+		block = _localSuccessors.find(predecessor.block->id());
+	}
+
 	if(block == _localSuccessors.end()) return InstructionSet();
 	
 	assert(predecessor.index() < block->second.size());
@@ -74,26 +120,43 @@ DependenceAnalysis::InstructionSet DependenceAnalysis::getLocalSuccessors(
 	return block->second[predecessor.index()];
 }
 
+const DependenceAnalysis::BlockDependenceDAG& DependenceAnalysis::getBlockDAG(
+	BasicBlock& block)
+{
+	if(_blockDAG.block != &block)
+	{
+		_buildBlockDAG(block);
+	}
+
+	return _blockDAG;
+}
+
 void DependenceAnalysis::analyze(Function& function)
 {
 	report("Running dependence analysis on '" << function.name() << "'");
 
-	// for all
-	for(auto block = function.begin(); block != function.end(); ++block)
-	{
-		_setLocalDependences(*block);
-	}
+	// dependences are built lazily, a scheduler that only ever looks at
+	// single blocks never pays for the rest of the function
+	_localPredecessors.clear();
+	_localSuccessors.clear();
+
+	_blockDAG.block = nullptr;
+	_dagArena.clear();
 }
 
 typedef DependenceAnalysis::InstructionSet InstructionSet;
 
 static void addPredecessors(InstructionSet& predecessors,
-	ir::BasicBlock::const_iterator instruction);
+	ir::BasicBlock::const_iterator instruction,
+	const AliasAnalysis* aliases);
 
 void DependenceAnalysis::_setLocalDependences(BasicBlock& block)
 {
 	report(" for basic block '" << block.name() << "'");
 
+	auto aliases = static_cast<const AliasAnalysis*>(
+		getAnalysis("AliasAnalysis"));
+
 	auto predecessor = _localPredecessors.insert(std::make_pair(block.id(),
 			InstructionSetVector())).first;
 	auto successor   =   _localSuccessors.insert(std::make_pair(block.id(),
@@ -111,7 +174,7 @@ void DependenceAnalysis::_setLocalDependences(BasicBlock& block)
 		InstructionSet& instructionPredecessors =
 			predecessor->second[(*instruction)->index()];
 	
-		addPredecessors(instructionPredecessors, instruction);
+		addPredecessors(instructionPredecessors, instruction, aliases);
 	}
 	
 	// TODO: collect successors in parallel
@@ -130,6 +193,66 @@ void DependenceAnalysis::_setLocalDependences(BasicBlock& block)
 	}
 }
 
+void DependenceAnalysis::_buildBlockDAG(BasicBlock& block)
+{
+	report(" building dependence DAG for basic block '"
+		<< block.name() << "'");
+
+	if(_localPredecessors.count(block.id()) == 0)
+	{
+		_setLocalDependences(block);
+	}
+
+	// one DAG is alive at a time, reuse its storage
+	_dagArena.clear();
+
+	_blockDAG.block = &block;
+	_blockDAG.nodes.clear();
+	_blockDAG.nodes.resize(block.size());
+
+	for(auto instruction : block)
+	{
+		_blockDAG.nodes[instruction->index()].instruction = instruction;
+	}
+
+	auto& predecessors = _localPredecessors.find(block.id())->second;
+	auto&   successors =   _localSuccessors.find(block.id())->second;
+
+	for(auto instruction : block)
+	{
+		auto& node = _blockDAG.nodes[instruction->index()];
+
+		auto& instructionPredecessors = predecessors[instruction->index()];
+		auto& instructionSuccessors   =   successors[instruction->index()];
+
+		node.predecessorCount = instructionPredecessors.size();
+		node.successorCount   = instructionSuccessors.size();
+
+		node.predecessors = static_cast<BlockDependenceDAG::Node**>(
+			_dagArena.allocate(sizeof(BlockDependenceDAG::Node*) *
+			node.predecessorCount, alignof(BlockDependenceDAG::Node*)));
+		node.successors = static_cast<BlockDependenceDAG::Node**>(
+			_dagArena.allocate(sizeof(BlockDependenceDAG::Node*) *
+			node.successorCount, alignof(BlockDependenceDAG::Node*)));
+
+		unsigned int index = 0;
+
+		for(auto predecessor : instructionPredecessors)
+		{
+			node.predecessors[index++] =
+				&_blockDAG.nodes[predecessor->index()];
+		}
+
+		index = 0;
+
+		for(auto successor : instructionSuccessors)
+		{
+			node.successors[index++] =
+				&_blockDAG.nodes[successor->index()];
+		}
+	}
+}
+
 static bool hasDataflowDependence(const ir::Instruction& predecessor,
 	const ir::Instruction& successor)
 {
@@ -173,32 +296,44 @@ static bool hasBarrierDependence(const ir::Instruction& predecessor,
 }
 
 static bool hasMemoryDependence(const ir::Instruction& predecessor,
-	const ir::Instruction& successor)
+	const ir::Instruction& successor, const AliasAnalysis* aliases)
 {
-	return (predecessor.accessesMemory() && successor.isStore()) ||
+	bool ordered = (predecessor.accessesMemory() && successor.isStore()) ||
 		(predecessor.isStore() && successor.accessesMemory());
+
+	if(!ordered) return false;
+
+	// provably disjoint addresses leave the pair free to reorder
+	if(aliases != nullptr && aliases->alias(predecessor, successor) ==
+		AliasAnalysis::NoAlias)
+	{
+		return false;
+	}
+
+	return true;
 }
 
 static bool hasDependence(const ir::Instruction& predecessor,
-	const ir::Instruction& successor)
+	const ir::Instruction& successor, const AliasAnalysis* aliases)
 {
 	if(hasControlflowDependence(predecessor, successor)) return true;
 	if(    hasBarrierDependence(predecessor, successor)) return true;
-	if(     hasMemoryDependence(predecessor, successor)) return true;
+	if(     hasMemoryDependence(predecessor, successor, aliases)) return true;
 	if(   hasDataflowDependence(predecessor, successor)) return true;
-	
+
 	return false;
 }
 
 static void addPredecessors(InstructionSet& predecessors,
-	ir::BasicBlock::const_iterator instruction)
+	ir::BasicBlock::const_iterator instruction,
+	const AliasAnalysis* aliases)
 {
 	auto      end = (*instruction)->block->rend();
 	auto position = ir::BasicBlock::const_reverse_iterator(instruction);
-	
+
 	for(; position != end; ++position)
 	{
-		if(!hasDependence(**position, **instruction)) continue;
+		if(!hasDependence(**position, **instruction, aliases)) continue;
 		
 		report("  " << (*position)->toString() << " (" << (*position)->index()
 			<< ") -> " << (*instruction)->toString() << " ("
@@ -18,6 +18,7 @@
 
 // Standard Library Includes
 #include <cassert>
+#include <list>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -34,7 +35,7 @@ namespace analysis
 
 DominatorAnalysis::DominatorAnalysis()
 : FunctionAnalysis("DominatorAnalysis", StringVector({"ControlFlowGraph",
-	"ReversePostOrderTraversal"}))
+	"ReversePostOrderTraversal"})), _function(nullptr)
 {
 
 }
@@ -93,10 +94,108 @@ static ir::BasicBlock* intersect(DominatorAnalysis* tree,
 	return finger1;
 }
 
+void DominatorAnalysis::insertEdge(BasicBlock* from, BasicBlock* to)
+{
+	typedef std::list<BasicBlock*> BlockList;
+	
+	assert(_function != nullptr);
+	
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
+	
+	report("Updating dominator tree for inserted edge "
+		<< from->name() << " -> " << to->name());
+	
+	// Cooper-style intersection restricted to blocks whose immediate
+	// dominator actually changes, seeded with the edge target
+	BlockList worklist(1, to);
+	
+	while(!worklist.empty())
+	{
+		auto block = worklist.front();
+		worklist.pop_front();
+		
+		if(block == &*_function->entry_block()) continue;
+		
+		auto predecessors = cfg->getPredecessors(*block);
+		
+		BasicBlock* newDominator = nullptr;
+		
+		for(auto predecessor : predecessors)
+		{
+			if(getDominator(*predecessor) == nullptr) continue;
+			
+			if(newDominator == nullptr)
+			{
+				newDominator = predecessor;
+				continue;
+			}
+			
+			newDominator = intersect(this, _postOrderNumbers,
+				predecessor, newDominator);
+		}
+		
+		if(newDominator != nullptr &&
+			newDominator != getDominator(*block))
+		{
+			report(" " << newDominator->name() << " now dominates "
+				<< block->name());
+			
+			_immediateDominators[block->id()] = newDominator;
+			
+			auto successors = cfg->getSuccessors(*block);
+			
+			for(auto successor : successors)
+			{
+				worklist.push_back(successor);
+			}
+		}
+	}
+	
+	_recomputeDerivedSets();
+}
+
+void DominatorAnalysis::deleteEdge(BasicBlock* from, BasicBlock* to)
+{
+	assert(_function != nullptr);
+	
+	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
+	
+	report("Updating dominator tree for deleted edge "
+		<< from->name() << " -> " << to->name());
+	
+	auto predecessors = cfg->getPredecessors(*to);
+	
+	// A sole remaining predecessor that already immediately dominates
+	// the target leaves the tree unchanged, only the frontier and
+	// dominated sets depend on the removed edge
+	if(predecessors.size() == 1 &&
+		*predecessors.begin() == getDominator(*to))
+	{
+		_recomputeDerivedSets();
+		
+		return;
+	}
+	
+	// Deletion can tighten dominance anywhere below the target,
+	// recompute from scratch
+	analyze(*_function);
+}
+
+void DominatorAnalysis::_recomputeDerivedSets()
+{
+	_dominatedBlocks.assign(_function->size(), BasicBlockSet());
+	_dominanceFrontiers.assign(_function->size(), BasicBlockSet());
+	
+	_determineDominatedSets(*_function);
+	_determineDominanceFrontiers(*_function);
+}
+
 void DominatorAnalysis::analyze(Function& function)
 {
 	report("Running dominator analysis over function " << function.name());
 	
+	_function = &function;
+	
 	_determineImmediateDominators(function);
 	      _determineDominatedSets(function);
 	 _determineDominanceFrontiers(function);
@@ -113,7 +212,9 @@ void DominatorAnalysis::_determineImmediateDominators(Function& function)
 		getAnalysis("ReversePostOrderTraversal"));
 	
 	// Determine post order numbers
-	IntVector postOrderNumbers(function.size());
+	_postOrderNumbers.assign(function.size(), 0);
+	
+	IntVector& postOrderNumbers = _postOrderNumbers;
 	
 	report(" creating post order sequence...");
 	for(auto block = reversePostOrder->order.begin();
@@ -0,0 +1,191 @@
+/*! \file   InductionVariableAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the InductionVariableAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/InductionVariableAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+InductionVariableAnalysis::InductionVariableAnalysis()
+: FunctionAnalysis("InductionVariableAnalysis", {"LoopAnalysis"})
+{
+
+}
+
+InductionVariableAnalysis::InductionVariableVector
+	InductionVariableAnalysis::getInductionVariables(const Loop& loop) const
+{
+	auto variables = _variables.find(loop.header->id());
+
+	if(variables == _variables.end()) return InductionVariableVector();
+
+	return variables->second;
+}
+
+static ir::Instruction* findDefinitionInLoop(
+	const InductionVariableAnalysis::Loop& loop,
+	const ir::VirtualRegister* value)
+{
+	for(auto block : loop.blocks)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+
+				if(static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister == value)
+				{
+					return instruction;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+/*! \brief Match 'next = add value, immediate' in either operand order */
+static bool matchAdvance(const ir::Instruction* advance,
+	const ir::VirtualRegister* value, int64_t& step)
+{
+	if(advance->opcode != ir::Instruction::Add) return false;
+	if(advance->reads.size() != 3)              return false;
+
+	if(advance->reads[1]->isRegister() && advance->reads[2]->isImmediate())
+	{
+		if(static_cast<const ir::RegisterOperand*>(
+			advance->reads[1])->virtualRegister != value) return false;
+
+		step = static_cast<const ir::ImmediateOperand*>(
+			advance->reads[2])->uint;
+
+		return true;
+	}
+
+	if(advance->reads[2]->isRegister() && advance->reads[1]->isImmediate())
+	{
+		if(static_cast<const ir::RegisterOperand*>(
+			advance->reads[2])->virtualRegister != value) return false;
+
+		step = static_cast<const ir::ImmediateOperand*>(
+			advance->reads[1])->uint;
+
+		return true;
+	}
+
+	return false;
+}
+
+void InductionVariableAnalysis::analyze(Function& function)
+{
+	_variables.clear();
+
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	report("Finding induction variables in '" << function.name() << "'");
+
+	for(auto& loop : *loops)
+	{
+		InductionVariableVector variables;
+
+		for(auto instruction : *loop.header)
+		{
+			if(!instruction->isPhi()) break;
+
+			auto phi = static_cast<ir::Phi*>(instruction);
+
+			if(phi->d() == nullptr)                  continue;
+			if(phi->d()->virtualRegister == nullptr) continue;
+
+			auto sources       = phi->sources();
+			auto blockOperands = phi->blockOperands();
+
+			if(sources.size() != 2) continue;
+
+			InductionVariable variable;
+
+			variable.loop       = &loop;
+			variable.phi        = phi;
+			variable.value      = phi->d()->virtualRegister;
+			variable.next       = nullptr;
+			variable.initial    = nullptr;
+			variable.advance    = nullptr;
+			variable.latchBlock = nullptr;
+			variable.step       = 0;
+
+			for(unsigned int source = 0; source != sources.size(); ++source)
+			{
+				auto block = static_cast<ir::BasicBlock*>(
+					blockOperands[source]->globalValue);
+
+				if(loop.contains(block))
+				{
+					variable.next       = sources[source]->virtualRegister;
+					variable.latchBlock = block;
+				}
+				else
+				{
+					variable.initial = sources[source]->virtualRegister;
+				}
+			}
+
+			if(variable.next    == nullptr) continue;
+			if(variable.initial == nullptr) continue;
+
+			variable.advance = findDefinitionInLoop(loop, variable.next);
+
+			if(variable.advance == nullptr) continue;
+
+			if(!matchAdvance(variable.advance, variable.value,
+				variable.step))
+			{
+				continue;
+			}
+
+			report(" '" << variable.value->toString() << "' steps by "
+				<< variable.step << " in loop at '"
+				<< loop.header->name() << "'");
+
+			variables.push_back(variable);
+		}
+
+		if(!variables.empty())
+		{
+			_variables.insert(std::make_pair(loop.header->id(),
+				std::move(variables)));
+		}
+	}
+}
+
+}
+
+}
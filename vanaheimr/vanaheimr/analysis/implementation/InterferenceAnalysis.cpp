@@ -23,7 +23,8 @@ namespace analysis
 {
 
 InterferenceAnalysis::InterferenceAnalysis()
-: FunctionAnalysis("InterferenceAnalysis", {"LiveRangeAnalysis"})
+: FunctionAnalysis("InterferenceAnalysis", {"LiveRangeAnalysis"}),
+	_registerCount(0)
 {
 
 }
@@ -31,11 +32,71 @@ InterferenceAnalysis::InterferenceAnalysis()
 bool InterferenceAnalysis::doLiveRangesInterfere(const VirtualRegister& one,
 	const VirtualRegister& two) const
 {
+	// high-degree nodes answer with a single word test
+	auto denseRow = _denseRows.find(one.id);
+	
+	if(denseRow != _denseRows.end())
+	{
+		return denseRow->second.test(two.id);
+	}
+
 	const VirtualRegisterSet& interferences = getInterferences(one);
 
 	return interferences.count(const_cast<VirtualRegister*>(&two)) != 0;
 }
 
+void InterferenceAnalysis::addInterference(VirtualRegister& one,
+	VirtualRegister& two)
+{
+	assert(one.id < _interferences.size());
+	assert(two.id < _interferences.size());
+	
+	_interferences[one.id].insert(&two);
+	_interferences[two.id].insert(&one);
+	
+	auto oneRow = _denseRows.find(one.id);
+	
+	if(oneRow != _denseRows.end())
+	{
+		oneRow->second.set(two.id);
+	}
+	else if(_interferences[one.id].size() >= DenseDegreeThreshold)
+	{
+		_promoteToDenseRow(one);
+	}
+	
+	auto twoRow = _denseRows.find(two.id);
+	
+	if(twoRow != _denseRows.end())
+	{
+		twoRow->second.set(one.id);
+	}
+	else if(_interferences[two.id].size() >= DenseDegreeThreshold)
+	{
+		_promoteToDenseRow(two);
+	}
+}
+
+size_t InterferenceAnalysis::getInterferenceDegree(
+	const VirtualRegister& value) const
+{
+	assert(value.id < _interferences.size());
+	
+	return _interferences[value.id].size();
+}
+
+void InterferenceAnalysis::_promoteToDenseRow(const VirtualRegister& value)
+{
+	BitRow row(_registerCount);
+
+	for(auto interference : _interferences[value.id])
+	{
+		row.set(interference->id);
+	}
+
+	_denseRows.emplace(value.id, std::move(row));
+}
+
 InterferenceAnalysis::VirtualRegisterSet&
 	InterferenceAnalysis::getInterferences(
 		const VirtualRegister& virtualRegister)
@@ -74,7 +135,12 @@ void InterferenceAnalysis::analyze(Function& function)
 		getAnalysis("LiveRangeAnalysis"));
 	assert(ranges != nullptr);
 
+	_interferences.clear();
+	_denseRows.clear();
+	
 	_interferences.resize(function.register_size());
+	
+	_registerCount = function.register_size();
 
 	// map live ranges into partiions that are alive in the same blocks
 	auto blocksToRanges = mapBlocksToLiveRanges(ranges);
@@ -150,9 +216,9 @@ static void checkIntersectionsInOverlappingRanges(
 
 				if(one->second->interferesWith(*two->second))
 				{
-					interefernceAnalysis->getInterferences(
-						*one->second->virtualRegister()).insert(
-							two->second->virtualRegister());
+					interefernceAnalysis->addInterference(
+						*one->second->virtualRegister(),
+						*two->second->virtualRegister());
 				}
 			}
 		}
@@ -17,6 +17,7 @@
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
+#include <algorithm>
 #include <cassert>
 
 namespace vanaheimr
@@ -25,6 +26,17 @@ namespace vanaheimr
 namespace analysis
 {
 
+LiveRangeAnalysis::Interval::Interval(uint64_t b, uint64_t e)
+: begin(b), end(e)
+{
+
+}
+
+bool LiveRangeAnalysis::Interval::overlaps(const Interval& interval) const
+{
+	return begin < interval.end && interval.begin < end;
+}
+
 LiveRange::LiveRange(LiveRangeAnalysis* liveRangeAnalysis, VirtualRegister* vr)
 : _analysis(liveRangeAnalysis), _virtualRegister(vr)
 {
@@ -111,6 +123,44 @@ bool LiveRangeAnalysis::LiveRange::interferesWith(const LiveRange& range) const
 	return false;
 }
 
+static bool intervalEndsBefore(const LiveRangeAnalysis::Interval& interval,
+	uint64_t position)
+{
+	return interval.end <= position;
+}
+
+bool LiveRangeAnalysis::LiveRange::overlaps(const LiveRange& range) const
+{
+	// probe with the range owning fewer intervals
+	auto& small = intervals.size() <= range.intervals.size()
+		? *this : range;
+	auto& large = intervals.size() <= range.intervals.size()
+		? range : *this;
+
+	for(auto& interval : small.intervals)
+	{
+		// intervals are sorted and disjoint, so ends are sorted too
+		auto candidate = std::lower_bound(large.intervals.begin(),
+			large.intervals.end(), interval.begin, intervalEndsBefore);
+
+		if(candidate == large.intervals.end()) continue;
+
+		if(candidate->begin < interval.end) return true;
+	}
+
+	return false;
+}
+
+bool LiveRangeAnalysis::LiveRange::covers(uint64_t linearIndex) const
+{
+	auto candidate = std::lower_bound(intervals.begin(),
+		intervals.end(), linearIndex, intervalEndsBefore);
+
+	if(candidate == intervals.end()) return false;
+
+	return candidate->begin <= linearIndex;
+}
+
 LiveRangeAnalysis::LiveRangeAnalysis()
 : FunctionAnalysis("LiveRangeAnalysis",
   {"DataflowAnalysis", "ControlFlowGraph"})
@@ -149,6 +199,7 @@ void LiveRangeAnalysis::analyze(Function& function)
 	assert(cfg != nullptr);
 
 	_initializeLiveRanges(function);
+	_numberInstructions(function);
 
 	hydrazine::log("LiveRangeAnalysis") << " Discovering live ranges\n";
 	
@@ -159,6 +210,18 @@ void LiveRangeAnalysis::analyze(Function& function)
 	{
 		findLiveRange(*getLiveRange(*virtualRegister), dfg, cfg);
 	}
+
+	_buildIntervals(dfg);
+}
+
+uint64_t LiveRangeAnalysis::getLinearIndex(
+	const Instruction* instruction) const
+{
+	auto position = _linearIndices.find(instruction);
+
+	assert(position != _linearIndices.end());
+
+	return position->second;
 }
 
 LiveRangeAnalysis::iterator LiveRangeAnalysis::begin()
@@ -205,6 +268,26 @@ void LiveRangeAnalysis::_initializeLiveRanges(Function& function)
 	}
 }
 
+void LiveRangeAnalysis::_numberInstructions(Function& function)
+{
+	_linearIndices.clear();
+	_blockExtents.assign(function.size(), Interval());
+
+	uint64_t position = 0;
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		uint64_t blockBegin = position;
+
+		for(auto instruction : *block)
+		{
+			_linearIndices.insert(std::make_pair(instruction, position++));
+		}
+
+		_blockExtents[block->id()] = Interval(blockBegin, position);
+	}
+}
+
 typedef ir::BasicBlock BasicBlock;
 
 static bool isLiveOut(LiveRange& liveRange, BasicBlock* block,
@@ -307,6 +390,88 @@ static void findLiveRange(LiveRangeAnalysis::LiveRange& liveRange,
 	}
 }
 
+static bool intervalStartsBefore(const LiveRangeAnalysis::Interval& left,
+	const LiveRangeAnalysis::Interval& right)
+{
+	return left.begin < right.begin;
+}
+
+void LiveRangeAnalysis::_buildIntervals(DataflowAnalysis* dfg)
+{
+	hydrazine::log("LiveRangeAnalysis") << " Compressing live ranges "
+		"into sorted intervals\n";
+
+	for(auto& liveRange : _liveRanges)
+	{
+		auto& intervals = liveRange.intervals;
+
+		intervals.clear();
+
+		// live-through blocks contribute their whole extent
+		for(auto block : liveRange.fullyCoveredBlocks)
+		{
+			intervals.push_back(_blockExtents[block->id()]);
+		}
+
+		// a definition is live to the end of its block when the value
+		// escapes, otherwise to the last local use
+		for(auto definition : liveRange.definingInstructions)
+		{
+			uint64_t begin = getLinearIndex(definition);
+			uint64_t end   = begin + 1;
+
+			if(isLiveOut(liveRange, definition->block, dfg))
+			{
+				end = _blockExtents[definition->block->id()].end;
+			}
+			else
+			{
+				for(auto use : liveRange.usingInstructions)
+				{
+					if(use->block != definition->block) continue;
+
+					end = std::max(end, getLinearIndex(use) + 1);
+				}
+			}
+
+			intervals.push_back(Interval(begin, end));
+		}
+
+		// a use without a prior local definition extends the live-in
+		// segment from the top of the block
+		for(auto use : liveRange.usingInstructions)
+		{
+			uint64_t end   = getLinearIndex(use) + 1;
+			uint64_t begin = blockHasPriorDefinitions(liveRange, use)
+				? end - 1 : _blockExtents[use->block->id()].begin;
+
+			intervals.push_back(Interval(begin, end));
+		}
+
+		// sort and coalesce into disjoint intervals
+		std::sort(intervals.begin(), intervals.end(), intervalStartsBefore);
+
+		IntervalVector merged;
+
+		for(auto& interval : intervals)
+		{
+			if(!merged.empty() && interval.begin <= merged.back().end)
+			{
+				merged.back().end = std::max(merged.back().end, interval.end);
+				continue;
+			}
+
+			merged.push_back(interval);
+		}
+
+		intervals = std::move(merged);
+
+		hydrazine::log("LiveRangeAnalysis") << "  '"
+			<< liveRange.virtualRegister()->toString() << "' compressed to "
+			<< intervals.size() << " intervals\n";
+	}
+}
+
 }
 
 }
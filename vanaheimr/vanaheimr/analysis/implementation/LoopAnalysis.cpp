@@ -0,0 +1,648 @@
+/*! \file   LoopAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LoopAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+#include <algorithm>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Does dominator (transitively) dominate the block? */
+static bool isDominatedBy(DominatorAnalysis* dominators,
+	ir::BasicBlock* block, ir::BasicBlock* dominator)
+{
+	auto runner = block;
+
+	while(true)
+	{
+		if(runner == dominator) return true;
+
+		auto next = dominators->getDominator(*runner);
+
+		if(next == nullptr || next == runner) return false;
+
+		runner = next;
+	}
+}
+
+LoopAnalysis::Loop::Loop(BasicBlock* h, Loop* p)
+: header(h), parent(p)
+{
+
+}
+
+bool LoopAnalysis::Loop::contains(const BasicBlock* block) const
+{
+	return blocks.count(const_cast<BasicBlock*>(block)) != 0;
+}
+
+unsigned int LoopAnalysis::Loop::depth() const
+{
+	unsigned int nestingDepth = 1;
+
+	for(auto loop = parent; loop != nullptr; loop = loop->parent)
+	{
+		++nestingDepth;
+	}
+
+	return nestingDepth;
+}
+
+LoopAnalysis::LoopAnalysis()
+: FunctionAnalysis("LoopAnalysis", StringVector({"ControlFlowGraph",
+	"DominatorAnalysis"})), _function(nullptr), _valid(false)
+{
+
+}
+
+LoopAnalysis::iterator LoopAnalysis::begin()
+{
+	_refresh();
+
+	return _loops.begin();
+}
+
+LoopAnalysis::const_iterator LoopAnalysis::begin() const
+{
+	return _loops.begin();
+}
+
+LoopAnalysis::iterator LoopAnalysis::end()
+{
+	_refresh();
+
+	return _loops.end();
+}
+
+LoopAnalysis::const_iterator LoopAnalysis::end() const
+{
+	return _loops.end();
+}
+
+size_t LoopAnalysis::size() const
+{
+	return _loops.size();
+}
+
+bool LoopAnalysis::empty() const
+{
+	return _loops.empty();
+}
+
+LoopAnalysis::Loop* LoopAnalysis::getLoopAt(const BasicBlock& block)
+{
+	_refresh();
+
+	assert(block.id() < _innermostLoops.size());
+
+	return _innermostLoops[block.id()];
+}
+
+bool LoopAnalysis::isContainedInLoop(const BasicBlock& block)
+{
+	return getLoopAt(block) != nullptr;
+}
+
+unsigned int LoopAnalysis::getLoopDepth(const BasicBlock& block)
+{
+	auto loop = getLoopAt(block);
+
+	if(loop == nullptr) return 0;
+
+	return loop->depth();
+}
+
+LoopAnalysis::BasicBlock* LoopAnalysis::getLatch(const Loop& loop)
+{
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	BasicBlock* latch = nullptr;
+
+	auto predecessors = cfg->getPredecessors(*loop.header);
+
+	for(auto predecessor : predecessors)
+	{
+		if(!loop.contains(predecessor)) continue;
+
+		// more than one back edge
+		if(latch != nullptr) return nullptr;
+
+		latch = predecessor;
+	}
+
+	return latch;
+}
+
+/*! \brief The single in-loop instruction writing the register,
+	nullptr if there is none or it is ambiguous */
+static ir::Instruction* findDefinitionInLoop(
+	const LoopAnalysis::Loop& loop, ir::VirtualRegister* value)
+{
+	ir::Instruction* definition = nullptr;
+
+	for(auto block : loop.blocks)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				if(static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister != value)
+				{
+					continue;
+				}
+
+				if(definition != nullptr) return nullptr;
+
+				definition = instruction;
+			}
+		}
+	}
+
+	return definition;
+}
+
+/*! \brief The constant a register holds on loop entry, matched through
+	a single-immediate materializing instruction */
+static bool findConstantInitialValue(ir::Function* function,
+	ir::VirtualRegister* value, uint64_t& initialValue)
+{
+	for(auto block = function->begin(); block != function->end(); ++block)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(!write->isRegister()) continue;
+
+				if(static_cast<ir::RegisterOperand*>(
+					write)->virtualRegister != value)
+				{
+					continue;
+				}
+
+				if(instruction->reads.size() != 2)        return false;
+				if(!instruction->reads[1]->isImmediate()) return false;
+
+				initialValue = static_cast<ir::ImmediateOperand*>(
+					instruction->reads[1])->uint;
+
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static uint64_t maskToWidth(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return value;
+
+	return value & (((uint64_t)1 << bits) - 1);
+}
+
+static int64_t signExtend(uint64_t value, unsigned int bits)
+{
+	if(bits >= 64) return (int64_t)value;
+
+	uint64_t signBit = (uint64_t)1 << (bits - 1);
+
+	return (int64_t)((value ^ signBit) - signBit);
+}
+
+static bool evaluateComparison(ir::ComparisonInstruction::Comparison
+	comparison, uint64_t a, uint64_t b, unsigned int bits, bool& result)
+{
+	typedef ir::ComparisonInstruction Cmp;
+
+	int64_t sa = signExtend(a, bits);
+	int64_t sb = signExtend(b, bits);
+
+	switch(comparison)
+	{
+	case Cmp::OrderedEqual:            result = a == b;   break;
+	case Cmp::OrderedNotEqual:         result = a != b;   break;
+	case Cmp::OrderedLessThan:         result = sa <  sb; break;
+	case Cmp::OrderedLessOrEqual:      result = sa <= sb; break;
+	case Cmp::OrderedGreaterThan:      result = sa >  sb; break;
+	case Cmp::OrderedGreaterOrEqual:   result = sa >= sb; break;
+	case Cmp::UnorderedEqual:          result = a == b;   break;
+	case Cmp::UnorderedNotEqual:       result = a != b;   break;
+	case Cmp::UnorderedLessThan:       result = a <  b;   break;
+	case Cmp::UnorderedLessOrEqual:    result = a <= b;   break;
+	case Cmp::UnorderedGreaterThan:    result = a >  b;   break;
+	case Cmp::UnorderedGreaterOrEqual: result = a >= b;   break;
+	default: return false;
+	}
+
+	return true;
+}
+
+uint64_t LoopAnalysis::getTripCount(const Loop& loop)
+{
+	// simulation cap, longer loops report an unknown count
+	const uint64_t maximumTripCount = 1 << 20;
+
+	auto latch = getLatch(loop);
+
+	if(latch == nullptr) return 0;
+
+	auto terminator = latch->terminator();
+
+	if(terminator == nullptr || !terminator->isBranch()) return 0;
+
+	auto branch = static_cast<ir::Bra*>(terminator);
+
+	if(branch->isUnconditional())                  return 0;
+	if(branch->targetBasicBlock() != loop.header)  return 0;
+
+	auto guard = branch->guard();
+
+	if(guard->virtualRegister == nullptr) return 0;
+
+	bool continueOnTrue;
+
+	if(guard->modifier == ir::PredicateOperand::StraightPredicate)
+	{
+		continueOnTrue = true;
+	}
+	else if(guard->modifier == ir::PredicateOperand::InversePredicate)
+	{
+		continueOnTrue = false;
+	}
+	else
+	{
+		return 0;
+	}
+
+	// the branch predicate comes from an immediate comparison in the loop
+	auto compareInstruction = findDefinitionInLoop(loop,
+		guard->virtualRegister);
+
+	if(compareInstruction == nullptr)                          return 0;
+	if(compareInstruction->opcode != ir::Instruction::Setp)    return 0;
+	if(compareInstruction->reads.size() != 3)                  return 0;
+
+	auto comparison = static_cast<ir::ComparisonInstruction*>(
+		compareInstruction)->comparison;
+
+	ir::VirtualRegister* counter = nullptr;
+
+	uint64_t bound          = 0;
+	bool     counterIsLeft  = false;
+
+	if(compareInstruction->reads[1]->isRegister() &&
+		compareInstruction->reads[2]->isImmediate())
+	{
+		counter = static_cast<ir::RegisterOperand*>(
+			compareInstruction->reads[1])->virtualRegister;
+		bound = static_cast<ir::ImmediateOperand*>(
+			compareInstruction->reads[2])->uint;
+		counterIsLeft = true;
+	}
+	else if(compareInstruction->reads[2]->isRegister() &&
+		compareInstruction->reads[1]->isImmediate())
+	{
+		counter = static_cast<ir::RegisterOperand*>(
+			compareInstruction->reads[2])->virtualRegister;
+		bound = static_cast<ir::ImmediateOperand*>(
+			compareInstruction->reads[1])->uint;
+	}
+
+	if(counter == nullptr) return 0;
+
+	// the counter cycles through a header phi advanced by an immediate
+	auto update = findDefinitionInLoop(loop, counter);
+
+	if(update == nullptr) return 0;
+
+	ir::Phi* phi = nullptr;
+
+	// true when the comparison reads the advanced value, false when it
+	// reads the phi value of the current iteration
+	bool comparesNextValue = true;
+
+	if(update->isPhi())
+	{
+		phi               = static_cast<ir::Phi*>(update);
+		comparesNextValue = false;
+	}
+
+	ir::Instruction* advance = update;
+
+	if(phi != nullptr)
+	{
+		// find the in-loop value feeding the phi
+		ir::VirtualRegister* latchValue = nullptr;
+
+		auto sources      = phi->sources();
+		auto predecessors = phi->blocks();
+
+		auto predecessor = predecessors.begin();
+
+		for(auto source = sources.begin(); source != sources.end();
+			++source, ++predecessor)
+		{
+			if(!loop.contains(*predecessor)) continue;
+
+			latchValue = (*source)->virtualRegister;
+		}
+
+		if(latchValue == nullptr) return 0;
+
+		advance = findDefinitionInLoop(loop, latchValue);
+	}
+
+	if(advance == nullptr)                           return 0;
+	if(advance->opcode != ir::Instruction::Add)      return 0;
+	if(advance->reads.size() != 3)                   return 0;
+
+	ir::VirtualRegister* advanceSource = nullptr;
+
+	uint64_t step = 0;
+
+	if(advance->reads[1]->isRegister() && advance->reads[2]->isImmediate())
+	{
+		advanceSource = static_cast<ir::RegisterOperand*>(
+			advance->reads[1])->virtualRegister;
+		step = static_cast<ir::ImmediateOperand*>(
+			advance->reads[2])->uint;
+	}
+	else if(advance->reads[2]->isRegister() &&
+		advance->reads[1]->isImmediate())
+	{
+		advanceSource = static_cast<ir::RegisterOperand*>(
+			advance->reads[2])->virtualRegister;
+		step = static_cast<ir::ImmediateOperand*>(
+			advance->reads[1])->uint;
+	}
+
+	if(advanceSource == nullptr) return 0;
+
+	if(phi == nullptr)
+	{
+		// the comparison read the advanced value, its input is the phi
+		auto definition = findDefinitionInLoop(loop, advanceSource);
+
+		if(definition == nullptr || !definition->isPhi()) return 0;
+
+		phi = static_cast<ir::Phi*>(definition);
+	}
+	else if(advanceSource != phi->d()->virtualRegister)
+	{
+		return 0;
+	}
+
+	if(step == 0) return 0;
+
+	// the phi's out-of-loop input must be a known constant
+	ir::VirtualRegister* initialRegister = nullptr;
+
+	auto sources      = phi->sources();
+	auto predecessors = phi->blocks();
+
+	auto predecessor = predecessors.begin();
+
+	for(auto source = sources.begin(); source != sources.end();
+		++source, ++predecessor)
+	{
+		if(loop.contains(*predecessor)) continue;
+
+		if(initialRegister != nullptr) return 0;
+
+		initialRegister = (*source)->virtualRegister;
+	}
+
+	if(initialRegister == nullptr) return 0;
+
+	uint64_t initialValue = 0;
+
+	if(!findConstantInitialValue(loop.header->function(),
+		initialRegister, initialValue))
+	{
+		return 0;
+	}
+
+	unsigned int bits = 64;
+
+	if(phi->d()->type() != nullptr)
+	{
+		bits = phi->d()->type()->bytes() * 8;
+	}
+
+	// simulate the counter, exact for every comparison kind including
+	// wraparound, bounded so pathological loops stay cheap to reject
+	uint64_t value = initialValue;
+
+	for(uint64_t trip = 1; trip <= maximumTripCount; ++trip)
+	{
+		value = maskToWidth(value + step, bits);
+
+		uint64_t compared = comparesNextValue ? value
+			: maskToWidth(value - step, bits);
+
+		uint64_t left  = counterIsLeft ? compared : bound;
+		uint64_t right = counterIsLeft ? bound    : compared;
+
+		bool taken = false;
+
+		if(!evaluateComparison(comparison, left, right, bits, taken))
+		{
+			return 0;
+		}
+
+		if(taken != continueOnTrue) return trip;
+	}
+
+	return 0;
+}
+
+void LoopAnalysis::invalidateLoop(Loop* loop)
+{
+	// Rewriting one nest can change the forest shape around it, mark
+	// the cache stale and rediscover lazily on the next query.  This
+	// keeps eager recomputation off the unrolling hot path, other
+	// functions' analyses are untouched.
+	_valid = false;
+}
+
+void LoopAnalysis::invalidateFunction(Function& function)
+{
+	if(&function != _function) return;
+
+	_valid = false;
+}
+
+void LoopAnalysis::analyze(Function& function)
+{
+	// cache hit, nothing was invalidated since the last discovery
+	if(_valid && _function == &function) return;
+
+	_function = &function;
+
+	_discoverLoops(function);
+
+	_valid = true;
+}
+
+void LoopAnalysis::_refresh()
+{
+	if(_valid || _function == nullptr) return;
+
+	_discoverLoops(*_function);
+
+	_valid = true;
+}
+
+void LoopAnalysis::_discoverLoops(Function& function)
+{
+	typedef std::vector<BasicBlock*> BlockStack;
+
+	report("Discovering loops in function " << function.name());
+
+	_loops.clear();
+	_innermostLoops.assign(function.size(), nullptr);
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	auto dominators = static_cast<DominatorAnalysis*>(
+		getAnalysis("DominatorAnalysis"));
+
+	// Find back edges (tail -> header where the header dominates the
+	// tail), outer loops before inner so nesting links resolve simply
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto successors = cfg->getSuccessors(*block);
+
+		for(auto successor : successors)
+		{
+			if(!isDominatedBy(dominators, &*block, successor)) continue;
+
+			report(" found back edge " << block->name()
+				<< " -> " << successor->name());
+
+			// The natural loop is everything that reaches the tail
+			// without passing the header
+			Loop* existing = nullptr;
+
+			for(auto& loop : _loops)
+			{
+				if(loop.header == successor)
+				{
+					existing = &loop;
+					break;
+				}
+			}
+
+			if(existing == nullptr)
+			{
+				_loops.push_back(Loop(successor, nullptr));
+				existing = &_loops.back();
+
+				existing->blocks.insert(successor);
+			}
+
+			BlockStack stack;
+
+			if(existing->blocks.insert(&*block).second)
+			{
+				stack.push_back(&*block);
+			}
+
+			while(!stack.empty())
+			{
+				auto node = stack.back();
+				stack.pop_back();
+
+				auto predecessors = cfg->getPredecessors(*node);
+
+				for(auto predecessor : predecessors)
+				{
+					if(existing->blocks.insert(predecessor).second)
+					{
+						stack.push_back(predecessor);
+					}
+				}
+			}
+		}
+	}
+
+	// Link the nesting forest: the parent is the smallest strictly
+	// containing loop
+	for(auto& loop : _loops)
+	{
+		Loop* parent = nullptr;
+
+		for(auto& candidate : _loops)
+		{
+			if(&candidate == &loop)                   continue;
+			if(!candidate.contains(loop.header))      continue;
+			if(candidate.header == loop.header)       continue;
+
+			if(parent == nullptr ||
+				parent->blocks.size() > candidate.blocks.size())
+			{
+				parent = &candidate;
+			}
+		}
+
+		loop.parent = parent;
+
+		if(parent != nullptr) parent->children.push_back(&loop);
+	}
+
+	// Record the innermost loop of every block
+	for(auto& loop : _loops)
+	{
+		for(auto block : loop.blocks)
+		{
+			auto& innermost = _innermostLoops[block->id()];
+
+			if(innermost == nullptr ||
+				innermost->blocks.size() > loop.blocks.size())
+			{
+				innermost = &loop;
+			}
+		}
+	}
+
+	report(" found " << _loops.size() << " loops");
+}
+
+}
+
+}
@@ -0,0 +1,248 @@
+/*! \file   PostDominatorAnalysis.cpp
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\date   Tuesday June 23, 2009
+	\file   The source file for the PostDominatorAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <cassert>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 1
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+PostDominatorAnalysis::PostDominatorAnalysis()
+: FunctionAnalysis("PostDominatorAnalysis", StringVector({"ControlFlowGraph"}))
+{
+
+}
+
+bool PostDominatorAnalysis::postDominates(const BasicBlock& b,
+	const BasicBlock& potentialPostDominator)
+{
+	auto postDominator = const_cast<BasicBlock*>(&potentialPostDominator);
+
+	// walk up the post-dominator tree, the exit ends it by
+	// post-dominating itself
+	auto block = &b;
+
+	while(true)
+	{
+		auto next = getPostDominator(*block);
+
+		if(next == postDominator) return true;
+
+		if(next == nullptr || next == block) return false;
+
+		block = next;
+	}
+}
+
+PostDominatorAnalysis::BasicBlock* PostDominatorAnalysis::getPostDominator(
+	const BasicBlock& b)
+{
+	assert(b.id() < _immediatePostDominators.size());
+	return _immediatePostDominators[b.id()];
+}
+
+const PostDominatorAnalysis::BasicBlockSet&
+	PostDominatorAnalysis::getPostDominatedBlocks(const BasicBlock& b)
+{
+	assert(b.id() < _postDominatedBlocks.size());
+	return _postDominatedBlocks[b.id()];
+}
+
+typedef std::vector<unsigned int> IntVector;
+
+static ir::BasicBlock* intersect(PostDominatorAnalysis* tree,
+	const IntVector& postOrderNumbers,
+	ir::BasicBlock* left, ir::BasicBlock* right)
+{
+	auto finger1 = left;
+	auto finger2 = right;
+
+	while(postOrderNumbers[finger1->id()] != postOrderNumbers[finger2->id()])
+	{
+		while(postOrderNumbers[finger1->id()] < postOrderNumbers[finger2->id()])
+		{
+			finger1 = tree->getPostDominator(*finger1);
+		}
+		while(postOrderNumbers[finger2->id()] < postOrderNumbers[finger1->id()])
+		{
+			finger2 = tree->getPostDominator(*finger2);
+		}
+	}
+
+	return finger1;
+}
+
+void PostDominatorAnalysis::analyze(Function& function)
+{
+	report("Running post-dominator analysis over function "
+		<< function.name());
+
+	_determineImmediatePostDominators(function);
+	      _determinePostDominatedSets(function);
+}
+
+void PostDominatorAnalysis::_determineImmediatePostDominators(
+	Function& function)
+{
+	_immediatePostDominators.clear();
+
+	// Get dependent analyses
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	// Determine post order numbers of the reversed CFG, a depth first
+	// walk of the predecessor edges starting from the exit.  Blocks that
+	// cannot reach the exit are never visited and keep no number.
+	_postOrderNumbers.assign(function.size(), 0);
+
+	IntVector& postOrderNumbers = _postOrderNumbers;
+
+	BasicBlockVector order;
+	order.reserve(function.size());
+
+	std::vector<bool> visited(function.size(), false);
+
+	BasicBlockVector stack(1, &*function.exit_block());
+
+	visited[function.exit_block()->id()] = true;
+
+	report(" creating post order sequence over the reversed CFG...");
+	while(!stack.empty())
+	{
+		auto block = stack.back();
+
+		bool descended = false;
+
+		auto predecessors = cfg->getPredecessors(*block);
+
+		for(auto predecessor : predecessors)
+		{
+			if(visited[predecessor->id()]) continue;
+
+			visited[predecessor->id()] = true;
+
+			stack.push_back(predecessor);
+
+			descended = true;
+			break;
+		}
+
+		if(descended) continue;
+
+		stack.pop_back();
+
+		postOrderNumbers[block->id()] = order.size();
+		order.push_back(block);
+
+		report("  " << block->name() << " -> "
+			<< postOrderNumbers[block->id()]);
+	}
+
+	// All blocks start being uninitialized
+	_immediatePostDominators.assign(function.size(), nullptr);
+
+	// The exit starts post-dominating itself
+	_immediatePostDominators[function.exit_block()->id()] =
+		&*function.exit_block();
+	report(" " << function.exit_block()->name() << " post-dominates "
+		<< function.exit_block()->name());
+
+	// Propagate changes, serial for each iteration
+	bool changed = true;
+
+	while(changed)
+	{
+		changed = false;
+
+		// Run over blocks in reverse post order of the reversed CFG
+		for(auto block = order.rbegin(); block != order.rend(); ++block)
+		{
+			if(*block == &*function.exit_block()) continue;
+
+			report(" checking " << (*block)->name());
+
+			// Get all successors, the predecessors in the reversed CFG
+			auto successors = cfg->getSuccessors(**block);
+
+			if(successors.empty()) continue;
+
+			// The new post-dominator is the first successor
+			BasicBlock* newPostDominator = nullptr;
+
+			for(auto successor : successors)
+			{
+				if(getPostDominator(*successor) == nullptr) continue;
+
+				if(newPostDominator == nullptr)
+				{
+					newPostDominator = successor;
+					report("  setting to first successor "
+						<< newPostDominator->name());
+					continue;
+				}
+
+				report("  intersection of "
+						<< newPostDominator->name() << " with "
+						<< successor->name());
+				newPostDominator = intersect(this, postOrderNumbers,
+					successor, newPostDominator);
+				report("   yielded " << newPostDominator->name());
+			}
+
+			if(newPostDominator != nullptr &&
+				newPostDominator != getPostDominator(**block))
+			{
+				report("  " << newPostDominator->name()
+					<< " post-dominates " << (*block)->name());
+				_immediatePostDominators[(*block)->id()] = newPostDominator;
+				changed = true;
+			}
+		}
+	}
+}
+
+void PostDominatorAnalysis::_determinePostDominatedSets(Function& function)
+{
+	_postDominatedBlocks.assign(function.size(), BasicBlockSet());
+
+	// Update the post-dominated set,
+	//  This is another reverse insert operation
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto postDominator = getPostDominator(*block);
+
+		// blocks that cannot reach the exit have no post-dominator
+		if(postDominator == nullptr) continue;
+
+		_postDominatedBlocks[postDominator->id()].insert(&*block);
+	}
+}
+
+}
+
+}
+
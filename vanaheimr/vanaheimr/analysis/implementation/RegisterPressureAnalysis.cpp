@@ -0,0 +1,135 @@
+/*! \file   RegisterPressureAnalysis.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the RegisterPressureAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/RegisterPressureAnalysis.h>
+
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+RegisterPressureAnalysis::RegisterPressureAnalysis()
+: FunctionAnalysis("RegisterPressureAnalysis", {"LiveRangeAnalysis"}),
+	_maxLive(0)
+{
+
+}
+
+unsigned int RegisterPressureAnalysis::maxLive() const
+{
+	return _maxLive;
+}
+
+unsigned int RegisterPressureAnalysis::maxLiveInBlock(
+	const BasicBlock& block) const
+{
+	if(block.id() >= _blockExtents.size()) return 0;
+
+	auto extent = _blockExtents[block.id()];
+
+	if(extent.first == extent.second) return 0;
+
+	// the step in effect entering the block
+	auto step = std::upper_bound(_steps.begin(), _steps.end(), extent.first,
+		[](uint64_t index, const PressureStep& step)
+		{
+			return index < step.first;
+		});
+
+	unsigned int pressure = 0;
+
+	if(step != _steps.begin()) pressure = (step - 1)->second;
+
+	for( ; step != _steps.end() && step->first < extent.second; ++step)
+	{
+		pressure = std::max(pressure, step->second);
+	}
+
+	return pressure;
+}
+
+void RegisterPressureAnalysis::analyze(Function& function)
+{
+	typedef std::pair<uint64_t, int> Event;
+	typedef std::vector<Event>       EventVector;
+
+	auto ranges = static_cast<LiveRangeAnalysis*>(
+		getAnalysis("LiveRangeAnalysis"));
+	assert(ranges != nullptr);
+
+	_maxLive = 0;
+
+	_steps.clear();
+	_blockExtents.clear();
+
+	// one event per interval endpoint, ends sort before begins at the
+	// same index because the intervals are half open
+	EventVector events;
+
+	for(auto range = ranges->begin(); range != ranges->end(); ++range)
+	{
+		for(auto& interval : range->intervals)
+		{
+			if(interval.begin == interval.end) continue;
+
+			events.push_back(Event(interval.begin,  1));
+			events.push_back(Event(interval.end,   -1));
+		}
+	}
+
+	std::sort(events.begin(), events.end());
+
+	// sweep, recording the live count after each distinct index
+	int live = 0;
+
+	for(auto event = events.begin(); event != events.end(); )
+	{
+		uint64_t index = event->first;
+
+		for( ; event != events.end() && event->first == index; ++event)
+		{
+			live += event->second;
+		}
+
+		assert(live >= 0);
+
+		_steps.push_back(PressureStep(index, live));
+
+		_maxLive = std::max(_maxLive, (unsigned int)live);
+	}
+
+	// linear extents of each block, for the per-block queries
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		if(block->empty()) continue;
+
+		if(block->id() >= _blockExtents.size())
+		{
+			_blockExtents.resize(block->id() + 1, Extent(0, 0));
+		}
+
+		uint64_t begin = ranges->getLinearIndex(block->front());
+
+		_blockExtents[block->id()] =
+			Extent(begin, ranges->getLinearIndex(block->back()) + 1);
+	}
+}
+
+}
+
+}
+
@@ -34,7 +34,7 @@ namespace analysis
 
 ReversePostOrderTraversal::ReversePostOrderTraversal()
 : FunctionAnalysis("ReversePostOrderTraversal",
-  StringVector(1, "ControlFlowGraph"))
+  StringVector(1, "ControlFlowGraph")), _function(nullptr), _valid(false)
 {
 
 }
@@ -44,6 +44,11 @@ void ReversePostOrderTraversal::analyze(Function& function)
 	typedef util::LargeSet<BasicBlock*> BlockSet;
 	typedef std::stack<BasicBlock*>     BlockStack;
 
+	// the ordering is cached until the CFG of the function changes
+	if(_valid && _function == &function) return;
+
+	_function = &function;
+
 	order.clear();
 	
 	BlockSet   visited;
@@ -122,6 +127,69 @@ void ReversePostOrderTraversal::analyze(Function& function)
 	
 	// reverse the order
 	std::reverse(order.begin(), order.end());
+
+	_valid = true;
+}
+
+const ReversePostOrderTraversal::BasicBlockVector&
+	ReversePostOrderTraversal::getRegionOrder(BasicBlock& entry,
+	const BasicBlockSet& region)
+{
+	typedef std::pair<BasicBlock*, bool> BlockState;
+	typedef std::stack<BlockState>       BlockStateStack;
+	typedef util::LargeSet<BasicBlock*>  BlockSet;
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	report("Creating reverse post order traversal over region rooted at '"
+		+ entry.name() + "'");
+
+	_regionOrder.clear();
+
+	BlockSet        visited;
+	BlockStateStack stack;
+
+	stack.push(BlockState(&entry, false));
+	visited.insert(&entry);
+
+	while(!stack.empty())
+	{
+		auto state = stack.top();
+		stack.pop();
+
+		if(state.second)
+		{
+			_regionOrder.push_back(state.first);
+			continue;
+		}
+
+		stack.push(BlockState(state.first, true));
+
+		auto successors = cfg->getSuccessors(*state.first);
+
+		for(auto successor : successors)
+		{
+			// stay inside the region
+			if(region.count(successor) == 0) continue;
+
+			if(visited.insert(successor).second)
+			{
+				stack.push(BlockState(successor, false));
+			}
+		}
+	}
+
+	std::reverse(_regionOrder.begin(), _regionOrder.end());
+
+	return _regionOrder;
+}
+
+void ReversePostOrderTraversal::invalidateFunction(Function& function)
+{
+	if(&function != _function) return;
+
+	_valid = false;
 }
 
 }
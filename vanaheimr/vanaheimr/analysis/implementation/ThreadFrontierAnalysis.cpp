@@ -0,0 +1,180 @@
+/*! \file   ThreadFrontierAnalysis.cpp
+	\date   Monday September 10, 2012
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ThreadFrontierAnalysis class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/ThreadFrontierAnalysis.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/ReversePostOrderTraversal.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+ThreadFrontierAnalysis::ThreadFrontierAnalysis()
+: FunctionAnalysis("ThreadFrontierAnalysis", StringVector(
+	{"ControlFlowGraph", "ReversePostOrderTraversal"})), _function(nullptr)
+{
+
+}
+
+const ThreadFrontierAnalysis::BasicBlockSet&
+	ThreadFrontierAnalysis::getThreadFrontier(const BasicBlock& block) const
+{
+	assert(block.id() < _frontiers.size());
+
+	return _frontiers[block.id()];
+}
+
+ThreadFrontierAnalysis::Priority ThreadFrontierAnalysis::getPriority(
+	const BasicBlock& block) const
+{
+	assert(block.id() < _priorities.size());
+
+	return _priorities[block.id()];
+}
+
+bool ThreadFrontierAnalysis::isInThreadFrontier(const BasicBlock& block,
+	const BasicBlock& potentialBlockInFrontier) const
+{
+	auto& frontier = getThreadFrontier(block);
+
+	return frontier.count(const_cast<BasicBlock*>(
+		&potentialBlockInFrontier)) != 0;
+}
+
+ThreadFrontierAnalysis::BasicBlockSetVector
+	ThreadFrontierAnalysis::getThreadFrontiers(
+	const BasicBlockVector& blocks) const
+{
+	BasicBlockSetVector frontiers;
+
+	frontiers.reserve(blocks.size());
+
+	for(auto block : blocks)
+	{
+		frontiers.push_back(getThreadFrontier(*block));
+	}
+
+	return frontiers;
+}
+
+void ThreadFrontierAnalysis::insertEdge(BasicBlock* from, BasicBlock* to)
+{
+	// priorities stay valid for edits between existing blocks, only the
+	// frontier sweep needs to be replayed
+	assert(from->id() < _priorities.size());
+	assert(  to->id() < _priorities.size());
+
+	_computeFrontiers();
+}
+
+void ThreadFrontierAnalysis::deleteEdge(BasicBlock* from, BasicBlock* to)
+{
+	assert(from->id() < _priorities.size());
+	assert(  to->id() < _priorities.size());
+
+	_computeFrontiers();
+}
+
+void ThreadFrontierAnalysis::analyze(Function& function)
+{
+	report("Computing thread frontiers for function " << function.name());
+
+	_function = &function;
+
+	_computePriorities(function);
+	_computeFrontiers();
+}
+
+void ThreadFrontierAnalysis::_computePriorities(Function& function)
+{
+	auto traversal = static_cast<ReversePostOrderTraversal*>(
+		getAnalysis("ReversePostOrderTraversal"));
+
+	_priorities.assign(function.size(), 0);
+
+	// blocks earlier in the reverse post order execute first and get
+	// higher priorities
+	_schedule = traversal->order;
+
+	Priority priority = _schedule.size();
+
+	for(auto block : _schedule)
+	{
+		assert(block->id() < _priorities.size());
+
+		_priorities[block->id()] = priority--;
+	}
+}
+
+void ThreadFrontierAnalysis::_computeFrontiers()
+{
+	typedef std::unordered_map<BasicBlock*, unsigned int> OpenEdgeCountMap;
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	_frontiers.assign(_priorities.size(), BasicBlockSet());
+
+	// Sweep blocks in scheduling order.  An edge is open when its source
+	// has executed and its target has not, the frontier of a block is the
+	// set of open edge targets while it executes
+	OpenEdgeCountMap openTargets;
+
+	for(auto block : _schedule)
+	{
+		openTargets.erase(block);
+
+		auto& frontier = _frontiers[block->id()];
+
+		for(auto& target : openTargets)
+		{
+			frontier.insert(target.first);
+		}
+
+		reportE(!frontier.empty(), " frontier of " << block->name()
+			<< " has " << frontier.size() << " blocks");
+
+		auto successors = cfg->getSuccessors(*block);
+
+		for(auto successor : successors)
+		{
+			// back edges target already-executed blocks and stay closed
+			if(_priorities[successor->id()] >= _priorities[block->id()])
+			{
+				continue;
+			}
+
+			++openTargets[successor];
+		}
+	}
+}
+
+}
+
+}
+
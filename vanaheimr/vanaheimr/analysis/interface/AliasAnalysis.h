@@ -0,0 +1,62 @@
+/*! \file   AliasAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the AliasAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Instruction; } }
+namespace vanaheimr { namespace ir { class Operand;     } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Disambiguates the addresses of memory operations.
+
+	The rules are purely local - accesses to distinct named variables
+	(globals, stack slots) never overlap, variables in different PTX
+	address spaces never overlap, distinct arguments never overlap, and
+	accesses off the same base register are separated by their constant
+	offsets and access widths.  Anything involving an unknown pointer
+	is MayAlias.  DependenceAnalysis uses the verdict to prune memory
+	edges so loads and stores become schedulable */
+class AliasAnalysis : public FunctionAnalysis
+{
+public:
+	enum AliasResult
+	{
+		NoAlias,   // the accesses can never touch the same byte
+		MayAlias,  // nothing is known
+		MustAlias  // the accesses start at the same address
+	};
+
+public:
+	AliasAnalysis();
+
+public:
+	/*! \brief Can the two memory operations access the same bytes?
+		Conservatively MayAlias when either address is not understood */
+	AliasResult alias(const ir::Instruction& first,
+		const ir::Instruction& second) const;
+
+public:
+	/*! \brief The address operand of a load, store, or atomic,
+		nullptr for anything else */
+	static const ir::Operand* getAddress(const ir::Instruction& instruction);
+
+public:
+	virtual void analyze(Function& function);
+
+};
+
+}
+
+}
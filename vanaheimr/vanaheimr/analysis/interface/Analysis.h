@@ -9,6 +9,7 @@
 // Standard Library Includes
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 // Forward Declarations
 namespace vanaheimr { namespace transforms { class PassManager; } }
@@ -34,6 +35,8 @@ public:
 public:
 	typedef std::vector<std::string> StringVector;
 
+	typedef std::unordered_map<std::string, Analysis*> AnalysisMap;
+
 	typedef transforms::PassManager PassManager;
 	typedef ir::Function            Function;
 	typedef ir::Module              Module;
@@ -58,6 +61,11 @@ public:
 public:
 	/*! \brief Set the pass manager used to supply dependent analyses */
 	void setPassManager(PassManager* m);
+
+	/*! \brief Supply dependent analyses directly, bypassing the pass
+		manager.  Used when analyses are computed on worker threads that
+		each own a private map for one function */
+	void setLocalAnalyses(AnalysisMap* analyses);
 	
 	/*! \brief Get an up to date analysis by type */
 	Analysis* getAnalysis(const std::string& name);
@@ -69,11 +77,18 @@ public:
 		need to generate it again for other users */
 	void invalidateAnalysis(const std::string& name);
 
+public:
+	/*! \brief Drop cached results for a single function only.  The
+		default conservatively does nothing, analyses that cache across
+		invalidations override this to scope the damage */
+	virtual void invalidateFunction(Function& function);
+
 public:
 	virtual void configure(const StringVector& );
 
 private:
 	PassManager* _manager;
+	AnalysisMap* _localAnalyses;
 
 };
 
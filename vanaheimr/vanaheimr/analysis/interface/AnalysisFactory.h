@@ -10,6 +10,13 @@
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/Analysis.h>
 
+// Standard Library Includes
+#include <map>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Module;   } }
+namespace vanaheimr { namespace ir { class Function; } }
+
 namespace vanaheimr
 {
 
@@ -21,12 +28,36 @@ class AnalysisFactory
 {
 public:
 	typedef Analysis::StringVector StringVector;
+	typedef Analysis::AnalysisMap  AnalysisMap;
+
+	/*! \brief Per-function analysis results, keyed by function name */
+	typedef std::map<std::string, AnalysisMap> FunctionAnalysisMap;
 
 public:
 	/*! \brief Create a analysis object from the specified name */
 	static Analysis* createAnalysis(const std::string& name,
 		const StringVector& options = StringVector());
 
+	/*! \brief Create and run the named function analyses, plus their
+		transitive dependencies, over every function in the module.
+	
+		Functions are distributed over a pool of worker threads, so the
+		dominator tree of one function is computed concurrently with the
+		live ranges of another.  The caller owns the returned analyses.
+	
+		\param workers The number of worker threads,
+			0 selects the hardware concurrency */
+	static void createAnalysesForModule(ir::Module& module,
+		const StringVector& names, FunctionAnalysisMap& analyses,
+		unsigned int workers = 0);
+
+	/*! \brief Create and run one named function analysis, plus its
+		transitive dependencies, caching everything into the supplied
+		map.  Returns the named analysis, the caller owns the map
+		contents */
+	static Analysis* createAnalysisForFunction(const std::string& name,
+		ir::Function& function, AnalysisMap& analyses);
+
 };
 
 }
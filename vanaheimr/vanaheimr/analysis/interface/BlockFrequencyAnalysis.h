@@ -0,0 +1,62 @@
+/*! \file   BlockFrequencyAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the BlockFrequencyAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Estimates how often each block executes per function entry.
+
+	Probability mass from BranchProbabilityAnalysis is propagated in
+	reverse post order with back edges ignored, then every loop scales
+	its members by an expected trip count - the compile time count when
+	LoopAnalysis knows it, otherwise one derived from the latch branch
+	probability.  Feeds the hot path aware codegen heuristics */
+class BlockFrequencyAnalysis : public FunctionAnalysis
+{
+public:
+	typedef ir::BasicBlock BasicBlock;
+
+public:
+	BlockFrequencyAnalysis();
+
+public:
+	/*! \brief The expected executions of the block per function entry,
+		the entry block is 1.0 */
+	double getFrequency(const BasicBlock& block) const;
+
+	/*! \brief The hottest block frequency in the function */
+	double maxFrequency() const;
+
+public:
+	virtual void analyze(Function& function);
+
+private:
+	typedef std::vector<double> FrequencyVector;
+
+private:
+	FrequencyVector _frequencies; // indexed by block id
+	double          _maxFrequency;
+
+};
+
+}
+
+}
+
@@ -0,0 +1,61 @@
+/*! \file   BranchProbabilityAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the BranchProbabilityAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+#include <vanaheimr/util/interface/SmallMap.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Estimates the probability of each control flow graph edge.
+
+	Measured counts win: a terminator carrying ProfileMetaData (fed back
+	from an archaeopteryx run) is believed outright.  Without a profile,
+	static heuristics apply - edges that stay inside a loop are taken
+	over edges that leave it, everything else splits evenly */
+class BranchProbabilityAnalysis : public FunctionAnalysis
+{
+public:
+	typedef ir::BasicBlock BasicBlock;
+
+public:
+	BranchProbabilityAnalysis();
+
+public:
+	/*! \brief The probability of the edge from head to tail,
+		zero when the edge does not exist */
+	double getEdgeProbability(const BasicBlock& head,
+		const BasicBlock& tail) const;
+
+public:
+	virtual void analyze(Function& function);
+
+private:
+	typedef util::SmallMap<unsigned int, double> SuccessorProbabilityMap;
+	typedef std::vector<SuccessorProbabilityMap> ProbabilityMapVector;
+
+private:
+	ProbabilityMapVector _probabilities; // indexed by head block id
+
+};
+
+}
+
+}
+
@@ -0,0 +1,89 @@
+/*! \file   CallGraphAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CallGraphAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+// Standard Library Includes
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Function; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief The static call graph of a module.
+
+	Edges are discovered from direct call targets.  Strongly connected
+	components are numbered so that recursion is cheap to test, and a
+	bottom-up traversal order (callees before callers) is precomputed
+	for interprocedural passes */
+class CallGraphAnalysis : public ModuleAnalysis
+{
+public:
+	typedef ir::Function Function;
+
+	typedef std::vector<Function*> FunctionVector;
+
+public:
+	CallGraphAnalysis();
+
+public:
+	/*! \brief The functions directly called by the function */
+	const FunctionVector& getCallees(const Function& function) const;
+
+	/*! \brief The functions directly calling the function */
+	const FunctionVector& getCallers(const Function& function) const;
+
+public:
+	/*! \brief Functions ordered callees-first, components in reverse
+		topological order of the condensation */
+	const FunctionVector& getBottomUpOrder() const;
+
+	/*! \brief The strongly connected component of the function */
+	unsigned int getComponent(const Function& function) const;
+
+	/*! \brief Is the function part of a recursive cycle,
+		including direct self recursion? */
+	bool isRecursive(const Function& function) const;
+
+public:
+	virtual void analyze(Module& module);
+
+private:
+	typedef std::unordered_map<const Function*, FunctionVector>
+		FunctionVectorMap;
+	typedef std::unordered_map<const Function*, unsigned int>
+		ComponentMap;
+
+private:
+	void _findComponents();
+
+private:
+	FunctionVectorMap _callees;
+	FunctionVectorMap _callers;
+
+	FunctionVector _bottomUpOrder;
+	ComponentMap   _components;
+
+	std::vector<unsigned int>          _componentSizes;
+	std::unordered_set<const Function*> _selfRecursive;
+
+	FunctionVector _empty;
+};
+
+}
+
+}
+
@@ -11,6 +11,10 @@
 
 #include <vanaheimr/util/interface/SmallSet.h>
 
+// Standard Library Includes
+#include <vector>
+#include <utility>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir { class BasicBlock; } }
 
@@ -50,6 +54,68 @@ public:
 	bool      isBranchEdge(const BasicBlock& head, const BasicBlock& tail);
 	bool isFallthroughEdge(const BasicBlock& head, const BasicBlock& tail);
 
+public:
+	/*! \brief Incremental edge maintenance, for passes that rewrite the
+		graph locally instead of re-running analyze.
+
+		Edits only invalidate the compressed view, so a batch of them
+		costs one lazy rebuild at the next freeze, not one per edit */
+	void    addEdge(BasicBlock* head, BasicBlock* tail);
+	void removeEdge(BasicBlock* head, BasicBlock* tail);
+
+	/*! \brief Disconnect a block from all of its neighbors */
+	void disconnectBlock(BasicBlock* block);
+
+public:
+	/*! \brief Bulk construction, for builders that know the whole graph.
+
+		Edges are collected without touching the per-block sets or the
+		compressed view, then one freeze() sorts the batch and builds
+		the successor and predecessor sets and the CSR form in a single
+		pass.  analyze() itself runs on this path, incremental addEdge
+		and removeEdge remain for passes that edit locally */
+	void beginBulkConstruction(Function& function);
+	void addBulkEdge(BasicBlock* head, BasicBlock* tail);
+	void freeze();
+
+public:
+	/*! \brief A frozen compressed-sparse-row edge layout.
+
+		One flat successor array plus one offset array per direction,
+		indexed by block id.  Traversals stream through contiguous
+		memory instead of chasing per-block heap containers. */
+	class CompressedGraph
+	{
+	public:
+		typedef unsigned int              Id;
+		typedef std::vector<Id>           IdVector;
+		typedef IdVector::const_iterator  const_iterator;
+
+	public:
+		/*! \brief The contiguous successor id range of a block */
+		const_iterator successors_begin(Id block) const;
+		const_iterator successors_end(Id block)   const;
+
+		/*! \brief The contiguous predecessor id range of a block */
+		const_iterator predecessors_begin(Id block) const;
+		const_iterator predecessors_end(Id block)   const;
+
+	public:
+		/*! \brief The number of blocks in the graph */
+		size_t size() const;
+
+	public:
+		IdVector successorOffsets;
+		IdVector successors;
+		IdVector predecessorOffsets;
+		IdVector predecessors;
+	};
+
+public:
+	/*! \brief Get the frozen CSR view of the edges.  It is built once
+		after each analyze() and shared by dominance and dataflow */
+	const CompressedGraph& compressedGraph();
+
 public:
 	      Function* function();
 	const Function* function() const;
@@ -58,16 +124,23 @@ public:
 	virtual void analyze(Function& function);
 
 private:
-	void _initializePredecessorsAndSuccessors(BasicBlock* block,
-		BasicBlock* next);
+	void _addBlockEdges(BasicBlock* block, BasicBlock* next);
 
 private:
 	typedef std::vector<BasicBlockSet> BasicBlockSetVector;
 
+	typedef std::pair<BasicBlock*, BasicBlock*> Edge;
+	typedef std::vector<Edge>                   EdgeVector;
+
 private:
 	BasicBlockSetVector _successors;
 	BasicBlockSetVector _predecessors;
 
+	EdgeVector _bulkEdges;
+
+	CompressedGraph _compressedGraph;
+	bool            _compressedGraphValid;
+
 private:
 	Function* _function;
 };
@@ -11,6 +11,10 @@
 
 #include <vanaheimr/util/interface/SmallSet.h>
 #include <vanaheimr/util/interface/LargeSet.h>
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <vector>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir       { class VirtualRegister;  } }
@@ -44,6 +48,10 @@ public:
 	VirtualRegisterSet  getLiveIns(const BasicBlock&);
 	VirtualRegisterSet getLiveOuts(const BasicBlock&);
 
+public:
+	/*! \brief Test a single live-in bit without materializing the set */
+	bool isLiveIn(const VirtualRegister&, const BasicBlock&) const;
+
 public:
 	InstructionSet getReachingDefinitions(const Instruction&);
 	InstructionSet getReachedUses(const Instruction&);
@@ -62,22 +70,33 @@ public:
 	virtual void analyze(Function& function);
 	
 private:
-	typedef std::vector<VirtualRegisterSet> VirtualRegisterSetVector;
 	typedef std::vector<InstructionSet>     InstructionSetVector;
 	typedef util::LargeSet<BasicBlock*>     BasicBlockSet;
-		
+
+	/*! \brief One word-packed bit row per block, one bit per register.
+		Meet and transfer run as 64-bit word operations */
+	typedef util::BitVector               BitRow;
+	typedef std::vector<BitRow>           BitMatrix;
+	typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+
 private:
 	void _analyzeLiveInsAndOuts(Function& function);
 	void _analyzeReachingDefinitions(Function& function);
 
 private:
-	void _computeLocalLiveInsAndOuts(BasicBlockSet& worklist);
 	bool _recomputeLiveInsAndOutsForBlock(BasicBlock* block);
 
+	VirtualRegisterSet _setFromRow(const BitRow& row) const;
+
 private:
-	VirtualRegisterSetVector _liveins;
-	VirtualRegisterSetVector _liveouts;
-	
+	BitMatrix _liveinBits;
+	BitMatrix _liveoutBits;
+
+	BitMatrix _useBits;
+	BitMatrix _defBits;
+
+	VirtualRegisterVector _registersById;
+
 	InstructionSetVector _reachingDefinitions;
 	InstructionSetVector _reachedUses;
 };
@@ -11,6 +11,7 @@
 
 #include <vanaheimr/util/interface/SmallSet.h>
 #include <vanaheimr/util/interface/LargeMap.h>
+#include <vanaheimr/util/interface/Arena.h>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir { class Instruction; } }
@@ -32,6 +33,46 @@ public:
 
 	typedef util::SmallSet<Instruction*> InstructionSet;
 
+	/*! \brief The dependence DAG of a single block.
+
+		Nodes are indexed by instruction position, edges are arrays
+		carved out of an arena that is reset when the next block's DAG
+		is requested, so scheduling thousands of blocks reuses the same
+		storage */
+	class BlockDependenceDAG
+	{
+	public:
+		class Node
+		{
+		public:
+			Instruction* instruction;
+
+			Node**       predecessors;
+			unsigned int predecessorCount;
+
+			Node**       successors;
+			unsigned int successorCount;
+		};
+
+		typedef std::vector<Node> NodeVector;
+
+		typedef NodeVector::const_iterator const_iterator;
+
+	public:
+		/*! \brief Get the node of an instruction in this block */
+		const Node& getNode(const Instruction& instruction) const;
+
+	public:
+		const_iterator begin() const;
+		const_iterator end()   const;
+
+		size_t size() const;
+
+	public:
+		BasicBlock* block;
+		NodeVector  nodes;
+	};
+
 public:
 	DependenceAnalysis();
 	
@@ -44,6 +85,12 @@ public:
 public:
 	InstructionSet getLocalPredecessors(const Instruction& successor) const;
 	InstructionSet getLocalSuccessors(const Instruction& predecessor) const;
+
+public:
+	/*! \brief Get the dependence DAG of one block, built on demand.
+		Only the most recently requested DAG is alive, asking for a new
+		block resets the arena and reuses its memory */
+	const BlockDependenceDAG& getBlockDAG(BasicBlock& block);
 	
 public:
 	virtual void analyze(Function& function);
@@ -55,10 +102,14 @@ private:
 
 private:
 	void _setLocalDependences(BasicBlock& block);
+	void _buildBlockDAG(BasicBlock& block);
 
 private:
 	BlockToInstructionSetMap _localPredecessors;
 	BlockToInstructionSetMap _localSuccessors;
+
+	BlockDependenceDAG _blockDAG;
+	util::Arena        _dagArena;
 };
 
 }
@@ -50,6 +50,21 @@ public:
 		a specified block */
 	const BasicBlockSet& getDominanceFrontier(const BasicBlock& b);
 		
+public:
+	/*! \brief Update the tree for a CFG edge inserted by a transform.
+
+		Insertion only moves dominators toward the entry, so the
+		iterative recomputation is restricted to the affected region.
+		The ControlFlowGraph analysis must already reflect the edge. */
+	void insertEdge(BasicBlock* from, BasicBlock* to);
+
+	/*! \brief Update the tree for a removed CFG edge.
+
+		When the target keeps a single predecessor that was already its
+		immediate dominator the tree is unchanged and only the derived
+		sets are refreshed; otherwise the analysis is recomputed. */
+	void deleteEdge(BasicBlock* from, BasicBlock* to);
+
 public:
 	virtual void analyze(Function& function);
 
@@ -58,15 +73,20 @@ private:
 	void _determineDominatedSets(Function& function);
 	void _determineDominanceFrontiers(Function& function);
 
+	void _recomputeDerivedSets();
+
 private:
 	typedef std::vector<BasicBlock*>   BasicBlockVector;
 	typedef std::vector<BasicBlockSet> BasicBlockSetVector;
+	typedef std::vector<unsigned int>  IntVector;
 	
 private:
 	BasicBlockVector    _immediateDominators;
 	BasicBlockSetVector _dominatedBlocks;
 	BasicBlockSetVector _dominanceFrontiers;
+	IntVector           _postOrderNumbers;
 
+	Function* _function;
 };
 
 }
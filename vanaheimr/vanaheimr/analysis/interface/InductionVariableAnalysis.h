@@ -0,0 +1,78 @@
+/*! \file   InductionVariableAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the InductionVariableAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Instruction;     } }
+namespace vanaheimr { namespace ir { class Phi;             } }
+namespace vanaheimr { namespace ir { class VirtualRegister; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Finds the basic induction variables of each natural loop.
+
+	A basic induction variable is a header phi whose in-loop source is
+	the phi value advanced by a constant immediate.  The translator
+	emits exactly this shape for PTX counted loops, and strength
+	reduction and unrolling both key off it.  Requires SSA form,
+	functions without phis yield nothing */
+class InductionVariableAnalysis : public FunctionAnalysis
+{
+public:
+	typedef LoopAnalysis::Loop Loop;
+
+	/*! \brief One register advanced by a constant step per iteration */
+	class InductionVariable
+	{
+	public:
+		const Loop*          loop;
+		ir::Phi*             phi;        // the header phi cycling the value
+		ir::VirtualRegister* value;      // the phi destination
+		ir::VirtualRegister* next;       // the advanced back edge value
+		ir::VirtualRegister* initial;    // the value entering the loop
+		ir::Instruction*     advance;    // the add producing next
+		ir::BasicBlock*      latchBlock; // the block the back edge leaves
+		int64_t              step;       // the per iteration increment
+	};
+
+	typedef std::vector<InductionVariable> InductionVariableVector;
+
+public:
+	InductionVariableAnalysis();
+
+public:
+	/*! \brief The basic induction variables of a loop, possibly empty */
+	InductionVariableVector getInductionVariables(const Loop& loop) const;
+
+public:
+	virtual void analyze(Function& function);
+
+private:
+	typedef std::unordered_map<unsigned int,
+		InductionVariableVector> LoopVariableMap;
+
+private:
+	LoopVariableMap _variables; // keyed by loop header id
+
+};
+
+}
+
+}
@@ -10,6 +10,11 @@
 #include <vanaheimr/analysis/interface/Analysis.h>
 
 #include <vanaheimr/util/interface/SmallSet.h>
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <vector>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir { class VirtualRegister;  } }
@@ -35,6 +40,15 @@ public:
 	bool doLiveRangesInterfere(const VirtualRegister&,
 		const VirtualRegister&) const;
 
+public:
+	/*! \brief Record a symmetric interference between two registers.
+		High-degree nodes are promoted to dense bit rows so queries
+		against them are a single word test */
+	void addInterference(VirtualRegister& one, VirtualRegister& two);
+
+	/*! \brief The interference degree of a register, O(1) */
+	size_t getInterferenceDegree(const VirtualRegister&) const;
+
 public:
 	VirtualRegisterSet&       getInterferences(const VirtualRegister&);
 	const VirtualRegisterSet& getInterferences(const VirtualRegister&) const;	
@@ -49,8 +63,20 @@ public:
 private:
 	typedef std::vector<VirtualRegisterSet> VirtualRegisterSetVector;
 
+	/*! \brief Dense word-packed rows for high-degree nodes only, the
+		sparse sets stay authoritative for enumeration */
+	typedef util::BitVector                          BitRow;
+	typedef std::unordered_map<unsigned int, BitRow> BitRowMap;
+
+	static const size_t DenseDegreeThreshold = 64;
+
+private:
+	void _promoteToDenseRow(const VirtualRegister& value);
+
 private:
 	VirtualRegisterSetVector _interferences;
+	BitRowMap                _denseRows;
+	size_t                   _registerCount;
 
 };
 
@@ -11,6 +11,10 @@
 
 #include <vanaheimr/util/interface/SmallSet.h>
 
+// Standard Library Includes
+#include <unordered_map>
+#include <cstdint>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir { class VirtualRegister;  } }
 namespace vanaheimr { namespace ir { class Instruction;      } }
@@ -33,6 +37,23 @@ public:
 	typedef util::SmallSet<Instruction*> InstructionSet;
 	typedef util::SmallSet<BasicBlock*>  BasicBlockSet;
 
+	/*! \brief A half open range [begin, end) of linearized
+		instruction indices over which a value is live */
+	class Interval
+	{
+	public:
+		Interval(uint64_t begin = 0, uint64_t end = 0);
+
+	public:
+		bool overlaps(const Interval& interval) const;
+
+	public:
+		uint64_t begin;
+		uint64_t end;
+	};
+
+	typedef std::vector<Interval> IntervalVector;
+
 	class LiveRange
 	{
 	public:
@@ -49,9 +70,22 @@ public:
 		/* \brief Do live ranges interfere? */
 		bool interferesWith(const LiveRange& range) const;
 
+	public:
+		/*! \brief Do the sorted intervals of two live ranges overlap?
+			O(m log n) in the interval counts, no block sets are touched */
+		bool overlaps(const LiveRange& range) const;
+
+		/*! \brief Is the value live at a linearized instruction index? */
+		bool covers(uint64_t linearIndex) const;
+
 	public:
 		BasicBlockSet fullyCoveredBlocks;
 
+		/*! \brief The live positions as sorted disjoint intervals of
+			linearized instruction indices.  Long lived values spanning
+			thousands of blocks collapse into a handful of entries */
+		IntervalVector intervals;
+
 	public:
 		InstructionSet definingInstructions;
 		InstructionSet usingInstructions;	
@@ -72,6 +106,11 @@ public:
 public:
 	const LiveRange* getLiveRange(const VirtualRegister&) const;
 	      LiveRange* getLiveRange(const VirtualRegister&);
+
+public:
+	/*! \brief The position of an instruction in the linear numbering
+		of the function used by the interval representation */
+	uint64_t getLinearIndex(const Instruction* instruction) const;
 	
 public:
 	virtual void analyze(Function& function);
@@ -91,12 +130,20 @@ public:
 	bool   empty() const;
 	size_t  size() const;
 
+private:
+	typedef std::unordered_map<const Instruction*, uint64_t> LinearIndexMap;
+
 private:
 	void _initializeLiveRanges(ir::Function& );
+	void _numberInstructions(ir::Function& );
+	void _buildIntervals(class DataflowAnalysis* dfg);
 
 private:
 	LiveRangeVector _liveRanges;
 
+	LinearIndexMap _linearIndices;
+	IntervalVector _blockExtents; // indexed by block id
+
 };
 
 typedef LiveRangeAnalysis::LiveRange LiveRange;
@@ -1 +1,143 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   LoopAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LoopAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Standard Library Includes
+#include <vector>
+#include <list>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Discovers the natural loop forest of a function.
+
+	Back edges are found with the dominator tree and each natural loop
+	is the set of blocks that reach the back edge source without passing
+	the header.  Results are cached per function and invalidated with
+	loop-nest granularity, so a transform that rewrites one loop does
+	not force global rediscovery. */
+class LoopAnalysis : public FunctionAnalysis
+{
+public:
+	typedef ir::BasicBlock BasicBlock;
+
+	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+
+	/*! \brief A single natural loop in the nesting forest */
+	class Loop
+	{
+	public:
+		typedef std::vector<Loop*> LoopVector;
+
+	public:
+		Loop(BasicBlock* header, Loop* parent);
+
+	public:
+		/*! \brief Does the loop contain the block,
+			including nested loops? */
+		bool contains(const BasicBlock* block) const;
+
+		/*! \brief The nesting depth, outermost loops have depth 1 */
+		unsigned int depth() const;
+
+	public:
+		/*! \brief The loop header, it dominates every block in the loop */
+		BasicBlock* header;
+
+		/*! \brief The blocks in the loop, including nested loop blocks */
+		BasicBlockSet blocks;
+
+		/*! \brief The enclosing loop, nullptr for outermost loops */
+		Loop* parent;
+
+		/*! \brief Loops nested directly inside this one */
+		LoopVector children;
+	};
+
+	typedef std::list<Loop>              LoopList;
+	typedef LoopList::iterator           iterator;
+	typedef LoopList::const_iterator     const_iterator;
+
+public:
+	LoopAnalysis();
+
+public:
+	iterator       begin();
+	const_iterator begin() const;
+
+	iterator       end();
+	const_iterator end() const;
+
+public:
+	size_t size()  const;
+	bool   empty() const;
+
+public:
+	/*! \brief The innermost loop containing the block,
+		nullptr if the block is not in any loop */
+	Loop* getLoopAt(const BasicBlock& block);
+
+	/*! \brief Is the block contained in any loop? */
+	bool isContainedInLoop(const BasicBlock& block);
+
+	/*! \brief The loop nesting depth of a block, 0 outside of loops */
+	unsigned int getLoopDepth(const BasicBlock& block);
+
+public:
+	/*! \brief The unique in-loop predecessor of the header,
+		nullptr when the loop has more than one back edge */
+	BasicBlock* getLatch(const Loop& loop);
+
+	/*! \brief The compile time trip count of a counted loop.
+
+		Recognizes the canonical rotated form: a phi-cycled counter
+		advanced by an immediate step and tested against an immediate
+		bound by the latch branch.  Returns 0 when the count cannot
+		be determined */
+	uint64_t getTripCount(const Loop& loop);
+
+public:
+	/*! \brief Drop cached results for a single loop nest.  The forest
+		is rediscovered lazily on the next query instead of eagerly,
+		queries against untouched functions keep their cache */
+	void invalidateLoop(Loop* loop);
+
+	/*! \brief Drop all cached results for the function */
+	virtual void invalidateFunction(Function& function);
+
+public:
+	virtual void analyze(Function& function);
+
+private:
+	typedef std::vector<Loop*> LoopPointerVector;
+
+private:
+	void _discoverLoops(Function& function);
+	void _refresh();
+
+private:
+	LoopList          _loops;
+	LoopPointerVector _innermostLoops; // indexed by block id
+
+	Function* _function;
+	bool      _valid;
+};
+
+}
+
+}
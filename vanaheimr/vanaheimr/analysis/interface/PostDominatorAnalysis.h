@@ -7,7 +7,12 @@
 #pragma once
 
 // Vanaheimr Includes
-#include <vanaheimr/analysis/includes/Analysis.h>
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Forward Declaration
+namespace vanaheimr { namespace ir { class BasicBlock; } }
 
 namespace vanaheimr
 {
@@ -15,11 +20,23 @@ namespace vanaheimr
 namespace analysis
 {
 
+/*! \brief Post-dominator analysis, the dominator algorithm described in:
+
+	"A simple and fast dominance algorithm" by
+		Keith D. Cooper, Timothy J. Harvey, and Ken Kennedy
+
+	run over the reversed control flow graph.  Blocks that cannot reach
+	the exit (e.g. infinite loops) have no post-dominator.
+ */
 class PostDominatorAnalysis : public FunctionAnalysis
 {
 public:
+	typedef              ir::BasicBlock BasicBlock;
 	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
-	
+
+public:
+	PostDominatorAnalysis();
+
 public:
 	/*! \brief Is a block post-dominated by another? */
 	bool postDominates(const BasicBlock& b,
@@ -27,17 +44,29 @@ public:
 
 	/*! \brief Find the immediate post dominator of a given block */
 	BasicBlock* getPostDominator(const BasicBlock& b);
-	
+
 	/*! \brief Get the set of blocks immediately post-dominated by this block */
-	BlockSet getPostDominatedBlocks(const BasicBlock& b);
-	
+	const BasicBlockSet& getPostDominatedBlocks(const BasicBlock& b);
+
 public:
 	virtual void analyze(Function& function);
 
+private:
+	void _determineImmediatePostDominators(Function& function);
+	void _determinePostDominatedSets(Function& function);
+
+private:
+	typedef std::vector<BasicBlock*>   BasicBlockVector;
+	typedef std::vector<BasicBlockSet> BasicBlockSetVector;
+	typedef std::vector<unsigned int>  IntVector;
+
+private:
+	BasicBlockVector    _immediatePostDominators;
+	BasicBlockSetVector _postDominatedBlocks;
+	IntVector           _postOrderNumbers;
 };
 
 }
 
 }
 
-
@@ -0,0 +1,67 @@
+/*! \file   RegisterPressureAnalysis.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the RegisterPressureAnalysis class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/analysis/interface/Analysis.h>
+
+// Standard Library Includes
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace analysis
+{
+
+/*! \brief Estimates register pressure from live range intervals.
+
+	A MaxLive sweep over the sorted interval endpoints counts how many
+	values are live at once, for the whole function and inside each
+	block.  Unrolling and inlining consult it as a budget before they
+	create live ranges the allocator would only spill again. */
+class RegisterPressureAnalysis : public FunctionAnalysis
+{
+public:
+	typedef ir::BasicBlock BasicBlock;
+
+public:
+	RegisterPressureAnalysis();
+
+public:
+	/*! \brief The most values simultaneously live in the function */
+	unsigned int maxLive() const;
+
+	/*! \brief The most values simultaneously live within one block */
+	unsigned int maxLiveInBlock(const BasicBlock& block) const;
+
+public:
+	virtual void analyze(Function& function);
+
+private:
+	/*! \brief The live value count from an instruction index onward */
+	typedef std::pair<uint64_t, unsigned int> PressureStep;
+	typedef std::vector<PressureStep>         PressureStepVector;
+	typedef std::pair<uint64_t, uint64_t>     Extent;
+	typedef std::vector<Extent>               ExtentVector;
+
+private:
+	unsigned int       _maxLive;
+	PressureStepVector _steps;
+	ExtentVector       _blockExtents; // indexed by block id
+
+};
+
+}
+
+}
+
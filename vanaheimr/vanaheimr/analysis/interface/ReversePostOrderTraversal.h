@@ -9,6 +9,8 @@
 // Vanaheimr Includes
 #include <vanaheimr/analysis/interface/Analysis.h>
 
+#include <vanaheimr/util/interface/SmallSet.h>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir { class BasicBlock; } }
 
@@ -21,22 +23,45 @@ namespace analysis
 /*! \brief Computes a post order traversal of the CFG.
 
 	Ideally, it does so in parallel 
-*/
+
+	The whole-function ordering is cached and only rebuilt after the CFG
+	of its function is invalidated, repeated requests are free.  Loop
+	passes can order just a sub region instead of the whole function */
 class ReversePostOrderTraversal : public FunctionAnalysis
 {
 public:
 	typedef ir::BasicBlock           BasicBlock;
 	typedef std::vector<BasicBlock*> BasicBlockVector;
 
+	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+
 public:
 	ReversePostOrderTraversal();
 
 public:
 	virtual void analyze(Function& function);
 
+public:
+	/*! \brief Order only the blocks of a sub region (e.g. a loop body
+		from LoopAnalysis) reachable from the given entry.
+	
+		The returned vector is owned by the analysis and reused by the
+		next region query, copy it to keep it */
+	const BasicBlockVector& getRegionOrder(BasicBlock& entry,
+		const BasicBlockSet& region);
+
+public:
+	/*! \brief Drop the cached ordering after a CFG change */
+	virtual void invalidateFunction(Function& function);
+
 public:
 	BasicBlockVector order;
 
+private:
+	BasicBlockVector _regionOrder;
+
+	Function* _function;
+	bool      _valid;
 
 };
 
@@ -7,9 +7,15 @@
 #pragma once
 
 // Vanaheimr Includes
-#include <vanaheimr/analysis/includes/Analysis.h>
+#include <vanaheimr/analysis/interface/Analysis.h>
 
-#include <vanaheimr/util/includes/SmallSet.h>
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
 
 namespace vanaheimr
 {
@@ -17,24 +23,67 @@ namespace vanaheimr
 namespace analysis
 {
 
+/*! \brief Computes thread frontiers for SIMD reconvergence.
+
+	A block is in the thread frontier of another if some thread can be
+	waiting there while other threads execute the block under the chosen
+	scheduling order.  Frontiers and priorities are precomputed into
+	tables indexed by block id, so queries are table lookups and the
+	frontier sweep can be replayed cheaply after minor CFG edits. */
 class ThreadFrontierAnalysis : public FunctionAnalysis
 {
 public:
-	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+	typedef ir::BasicBlock BasicBlock;
+
+	typedef util::SmallSet<BasicBlock*>  BasicBlockSet;
+	typedef std::vector<BasicBlock*>     BasicBlockVector;
+	typedef std::vector<BasicBlockSet>   BasicBlockSetVector;
 	typedef unsigned int Priority;
-	
+
+public:
+	ThreadFrontierAnalysis();
+
 public:
 	/*! \brief Get the blocks in the thread frontier of a specified block */
-	BasicBlockSet getThreadFrontier(const BasicBlock& block) const;
+	const BasicBlockSet& getThreadFrontier(const BasicBlock& block) const;
 	/*! \brief Get the scheduling priorty of a specified block */
 	Priority getPriority(const BasicBlock& block) const;
 	/*! \brief Test if a block is in the thread frontier of another block */
 	bool isInThreadFrontier(const BasicBlock& block,
 		const BasicBlock& potentialBlockInFrontier) const;
-	
+
+public:
+	/*! \brief Get the frontiers of many blocks in one call, results are
+		aligned with the input.  Lets a consumer drain the tables in a
+		single pass instead of querying block by block */
+	BasicBlockSetVector getThreadFrontiers(
+		const BasicBlockVector& blocks) const;
+
+public:
+	/*! \brief Replay the frontier sweep after inserting a CFG edge.  The
+		cached priorities are reused, only the frontier tables change */
+	void insertEdge(BasicBlock* from, BasicBlock* to);
+	/*! \brief Replay the frontier sweep after deleting a CFG edge */
+	void deleteEdge(BasicBlock* from, BasicBlock* to);
+
 public:
 	virtual void analyze(Function& function);
 
+private:
+	typedef std::vector<Priority> PriorityVector;
+
+private:
+	void _computePriorities(Function& function);
+	void _computeFrontiers();
+
+private:
+	BasicBlockSetVector _frontiers;  // indexed by block id
+	PriorityVector      _priorities; // indexed by block id
+
+	BasicBlockVector _schedule; // blocks in descending priority order
+
+	Function* _function;
+
 };
 
 }
@@ -10,6 +10,8 @@
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/util/interface/StringBuffer.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
@@ -38,180 +40,201 @@ void AssemblyWriter::write(std::ostream& stream, const ir::Module& module)
 {
 	report("Writing assembly for module '" << module.name << "'");
 
+	// format into the buffer, flush it between functions once it fills
+	const size_t flushThreshold = 1 << 20;
+
+	util::StringBuffer buffer;
+
 	for(auto function = module.begin(); function != module.end(); ++function)
 	{
-		writeFunction(stream, *function);
+		writeFunction(buffer, *function);
+
+		if(buffer.size() >= flushThreshold) buffer.flush(stream);
 	}
-	
+
 	for(auto global = module.global_begin();
 		global != module.global_end(); ++global)
 	{
-		writeGlobal(stream, *global);
+		writeGlobal(buffer, *global);
+
+		if(buffer.size() >= flushThreshold) buffer.flush(stream);
 	}
+
+	buffer.flush(stream);
 }
 
-void AssemblyWriter::writeFunction(std::ostream& stream,
+void AssemblyWriter::writeFunction(util::StringBuffer& buffer,
 	const ir::Function& function)
 {
 	report(" For function '" << function.name() << "'");
 
-	stream << ".function ";
+	buffer.append(".function ");
 
 	auto attributes = function.attributes();
-	
+
 	for(auto attribute : attributes)
 	{
-		stream << "." << attribute << " ";
+		buffer.append('.');
+		buffer.append(attribute);
+		buffer.append(' ');
 	}
-	
-	writeLinkage(stream, function); 
-	
-	stream << " (";
-	
+
+	writeLinkage(buffer, function);
+
+	buffer.append(" (");
+
 	for(auto argument = function.returned_begin();
 		argument != function.returned_end(); ++argument)
 	{
-		if(argument != function.returned_begin()) stream << ", ";
+		if(argument != function.returned_begin()) buffer.append(", ");
 
-		writeArgument(stream, *argument);
+		writeArgument(buffer, *argument);
 	}
 
-	stream << ") " << function.name() << "(";
-	
+	buffer.append(") ");
+	buffer.append(function.name());
+	buffer.append('(');
+
 	for(ir::Function::const_argument_iterator
 		argument = function.argument_begin();
 		argument != function.argument_end(); ++argument)
 	{
-		if(argument != function.argument_begin()) stream << ", ";
+		if(argument != function.argument_begin()) buffer.append(", ");
 
-		writeArgument(stream, *argument);
+		writeArgument(buffer, *argument);
 	}
-	
-	stream << ")";
-	
+
+	buffer.append(')');
+
 	if(function.size() <= 2)
 	{
-		stream << ";\n";
+		buffer.append(";\n");
 		return;
 	}
-	
-	stream << "\n{\n";
-	
+
+	buffer.append("\n{\n");
+
 	for(ir::Function::const_iterator block = function.begin();
 		block != function.end(); ++block)
 	{
 		if(block == function.exit_block())  continue;
 		if(block == function.entry_block()) continue;
-		writeBasicBlock(stream, *block);
+		writeBasicBlock(buffer, *block);
 	}
-	
-	stream << "}\n";
+
+	buffer.append("}\n");
 }
 
-void AssemblyWriter::writeGlobal(std::ostream& stream, const ir::Global& global)
+void AssemblyWriter::writeGlobal(util::StringBuffer& buffer,
+	const ir::Global& global)
 {
 	report(" For global '" << global.name() << "'");
-	
-	stream << ".global ";
-	
-	writeLinkage(stream, global);
-	writeType(stream, global.type());
-	
-	stream << global.name() << " ";
-	
+
+	buffer.append(".global ");
+
+	writeLinkage(buffer, global);
+	writeType(buffer, global.type());
+
+	buffer.append(global.name());
+	buffer.append(' ');
+
 	if(global.hasInitializer())
 	{
-		stream << " = ";
-		writeInitializer(stream, *global.initializer());
+		buffer.append(" = ");
+		writeInitializer(buffer, *global.initializer());
 	}
 
-	stream << ";\n";
+	buffer.append(";\n");
 }
 
-void AssemblyWriter::writeLinkage(std::ostream& stream,
+void AssemblyWriter::writeLinkage(util::StringBuffer& buffer,
 	const ir::Variable& variable)
 {
 	switch(variable.linkage())
 	{
 	case ir::Variable::ExternalLinkage:
 	{
-		stream << ".external ";
+		buffer.append(".external ");
 		break;
 	}
 	case ir::Variable::LinkOnceAnyLinkage:
 	{
-		stream << ".inline ";
+		buffer.append(".inline ");
 		break;
 	}
 	case ir::Variable::LinkOnceODRLinkage:
 	{
-		stream << ".inline_strict ";
+		buffer.append(".inline_strict ");
 		break;
 	}
 	case ir::Variable::WeakAnyLinkage:
 	{
-		stream << ".weak ";
+		buffer.append(".weak ");
 		break;
 	}
 	case ir::Variable::InternalLinkage:
 	{
-		stream << ".internal ";
+		buffer.append(".internal ");
 		break;
 	}
 	case ir::Variable::PrivateLinkage:
 	{
-		stream << ".private ";
+		buffer.append(".private ");
 		break;
 	}
 	}
-	
+
 	switch(variable.visibility())
 	{
 	case ir::Variable::VisibleVisibility:
 	{
-		stream << ".visible ";
+		buffer.append(".visible ");
 		break;
 	}
 	case ir::Variable::ProtectedVisibility:
 	{
-		stream << ".protected ";
+		buffer.append(".protected ");
 		break;
 	}
 	case ir::Variable::HiddenVisibility:
 	{
-		stream << ".hidden ";
+		buffer.append(".hidden ");
 		break;
 	}
 	}
 }
 
-void AssemblyWriter::writeArgument(std::ostream& stream,
+void AssemblyWriter::writeArgument(util::StringBuffer& buffer,
 	const ir::Argument& argument)
 {
-	writeType(stream, argument.type());
-	
-	stream << " " << argument.name();
+	writeType(buffer, argument.type());
+
+	buffer.append(' ');
+	buffer.append(argument.name());
 }
 
-void AssemblyWriter::writeBasicBlock(std::ostream& stream,
+void AssemblyWriter::writeBasicBlock(util::StringBuffer& buffer,
 	const ir::BasicBlock& block)
 {
-	stream << "\t " << block.name() << ":\n";
-	
+	buffer.append("\t ");
+	buffer.append(block.name());
+	buffer.append(":\n");
+
 	for(auto instruction : block)
 	{
-		stream << "\t\t";
-		stream << instruction->toString();
-		stream << ";\n";
+		buffer.append("\t\t");
+		buffer.append(instruction->toString());
+		buffer.append(";\n");
 	}
 }
 
-void AssemblyWriter::writeType(std::ostream& stream, const ir::Type& type)
+void AssemblyWriter::writeType(util::StringBuffer& buffer, const ir::Type& type)
 {
-	stream << type.name << " ";
+	buffer.append(type.name);
+	buffer.append(' ');
 }
 
-void AssemblyWriter::writeInitializer(std::ostream& stream,
+void AssemblyWriter::writeInitializer(util::StringBuffer& buffer,
 	const ir::Constant& constant)
 {
 	if(constant.type()->isInteger())
@@ -219,7 +242,7 @@ void AssemblyWriter::writeInitializer(std::ostream& stream,
 		const ir::IntegerConstant& integer =
 			static_cast<const ir::IntegerConstant&>(constant);
 
-		stream << (uint64_t) integer;
+		buffer.appendInteger((uint64_t) integer);
 	}
 	else if(constant.type()->isFloatingPoint())
 	{
@@ -228,33 +251,33 @@ void AssemblyWriter::writeInitializer(std::ostream& stream,
 
 		if(constant.type()->isSinglePrecisionFloat())
 		{
-			stream << floating.asFloat();
+			buffer.appendFloat(floating.asFloat());
 		}
 		else
 		{
-			stream << floating.asDouble();
+			buffer.appendFloat(floating.asDouble());
 		}
 	}
 	else if(constant.type()->isArray())
 	{
 		const ir::ArrayConstant& array =
 			static_cast<const ir::ArrayConstant&>(constant);
-	
-		stream << "{ ";
+
+		buffer.append("{ ");
 
 		for(unsigned int i = 0; i != array.size(); ++i)
 		{
-			if(i > 0) stream << ", ";
+			if(i > 0) buffer.append(", ");
 
 			auto temporary = array.getMember(i);
 
-			writeInitializer(stream, *temporary);
+			writeInitializer(buffer, *temporary);
 
 			delete temporary;
 		}
 
-		stream << " }";	
-		
+		buffer.append(" }");
+
 	}
 	else
 	{
@@ -262,12 +285,14 @@ void AssemblyWriter::writeInitializer(std::ostream& stream,
 	}
 }
 
-void AssemblyWriter::writeOpcode(std::ostream& stream, unsigned int opcode)
+void AssemblyWriter::writeOpcode(util::StringBuffer& buffer,
+	unsigned int opcode)
 {
-	stream << ir::Instruction::toString((ir::Instruction::Opcode)opcode);
+	buffer.append(ir::Instruction::toString((ir::Instruction::Opcode)opcode));
 }
 
-void AssemblyWriter::writeOperand(std::ostream& stream, const ir::Operand& o)
+void AssemblyWriter::writeOperand(util::StringBuffer& buffer,
+	const ir::Operand& o)
 {
 	switch(o.mode())
 	{
@@ -275,103 +300,107 @@ void AssemblyWriter::writeOperand(std::ostream& stream, const ir::Operand& o)
 	{
 		const ir::RegisterOperand& operand =
 			static_cast<const ir::RegisterOperand&>(o);
-		
-		writeVirtualRegister(stream, *operand.virtualRegister);
-		
+
+		writeVirtualRegister(buffer, *operand.virtualRegister);
+
 		break;
 	}
 	case ir::Operand::Immediate:
 	{
 		const ir::ImmediateOperand& operand =
 			static_cast<const ir::ImmediateOperand&>(o);
-		
-		writeType(stream, *operand.type());
-		
-		stream << "0x" << std::hex << operand.uint << std::dec;
-		
+
+		writeType(buffer, *operand.type());
+
+		buffer.append("0x");
+		buffer.appendHex(operand.uint);
+
 		break;
 	}
 	case ir::Operand::Predicate:
 	{
 		const ir::PredicateOperand& operand =
 			static_cast<const ir::PredicateOperand&>(o);
-		
+
 		switch(operand.modifier)
 		{
 		case ir::PredicateOperand::InversePredicate:
 		{
-			stream << "!";
-			
+			buffer.append('!');
+
 			// fall through
 		}
 		case ir::PredicateOperand::StraightPredicate:
 		{
-			stream << "@";
-			
-			writeVirtualRegister(stream, *operand.virtualRegister);
+			buffer.append('@');
+
+			writeVirtualRegister(buffer, *operand.virtualRegister);
 
 			break;
 		}
 		case ir::PredicateOperand::PredicateTrue:
 		{
-			stream << "@pt";
+			buffer.append("@pt");
 			break;
 		}
 		case ir::PredicateOperand::PredicateFalse:
 		{
-			stream << "!@pt";
+			buffer.append("!@pt");
 			break;
 		}
 		}
-			
+
 		break;
 	}
 	case ir::Operand::Indirect:
 	{
 		const ir::IndirectOperand& operand =
 			static_cast<const ir::IndirectOperand&>(o);
-		
-		stream << "[ ";
-		writeVirtualRegister(stream, *operand.virtualRegister);
-	
-		stream << " + " << std::hex << operand.offset << std::dec << " ]";
-		
+
+		buffer.append("[ ");
+		writeVirtualRegister(buffer, *operand.virtualRegister);
+
+		buffer.append(" + ");
+		buffer.appendHex(operand.offset);
+		buffer.append(" ]");
+
 		break;
 	}
 	case ir::Operand::Address:
 	{
 		const ir::AddressOperand& operand =
 			static_cast<const ir::AddressOperand&>(o);
-		
-		writeType(stream, operand.globalValue->type());
-		
-		stream << " ";
-		
-		stream << operand.globalValue->name();
-		
+
+		writeType(buffer, operand.globalValue->type());
+
+		buffer.append(' ');
+
+		buffer.append(operand.globalValue->name());
+
 		break;
 	}
 	case ir::Operand::Argument:
 	{
 		const ir::ArgumentOperand& operand =
 			static_cast<const ir::ArgumentOperand&>(o);
-		
-		writeType(stream, operand.argument->type());
-		
-		stream << " ";
-		
-		stream << operand.argument->name();
-		
+
+		writeType(buffer, operand.argument->type());
+
+		buffer.append(' ');
+
+		buffer.append(operand.argument->name());
+
 		break;
 	}
 	}
 }
 
-void AssemblyWriter::writeVirtualRegister(std::ostream& stream,
+void AssemblyWriter::writeVirtualRegister(util::StringBuffer& buffer,
 	const ir::VirtualRegister& v)
 {
-	writeType(stream, *v.type);
-	stream << "%r" << v.id;
+	writeType(buffer, *v.type);
+	buffer.append("%r");
+	buffer.appendInteger((uint64_t)v.id);
 }
 
 }
@@ -18,6 +18,7 @@
 // Standard Library Includes
 #include <stdexcept>
 #include <unordered_set>
+#include <cstring>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -32,25 +33,129 @@ namespace vanaheimr
 namespace as
 {
 
+BinaryReader::BinaryReader()
+: _instructions(nullptr), _instructionCount(0), _dataSection(nullptr),
+	_stringTable(nullptr), _symbolTable(nullptr), _symbolCount(0),
+	_hashIndex(nullptr), _hashSlots(0)
+{
+
+}
+
 ir::Module* BinaryReader::read(std::istream& stream, const std::string& name)
 {
-	      _readHeader(stream);
-	 _readDataSection(stream);
-	 _readStringTable(stream);
-	 _readSymbolTable(stream);
-	_readInstructions(stream);
+	     _readHeader(stream);
+	_readSymbolTable(stream);
+	  _readHashIndex(stream);
+
+	if(_header.flags & BinaryHeader::CompressedSections)
+	{
+		_readCompressedSections(stream);
+	}
+	else
+	{
+		 _readDataSection(stream);
+		 _readStringTable(stream);
+		_readInstructions(stream);
+	}
 
 	ir::Module* module = new ir::Module(name,
 		compiler::Compiler::getSingleton());
 
 	_loadTypes();
 	_initializeModule(*module);
-	
+
 	report("Finished loading binary...");
-	
+
 	return module;
 }
 
+ir::Module* BinaryReader::read(const std::string& filename)
+{
+	report("Mapping binary '" << filename << "'...");
+
+	_file.map(filename);
+
+	_mapSections();
+
+	ir::Module* module = new ir::Module(filename,
+		compiler::Compiler::getSingleton());
+
+	_loadTypes();
+	_initializeModule(*module);
+
+	report("Finished loading binary...");
+
+	return module;
+}
+
+ir::Module* BinaryReader::readFunction(const std::string& filename,
+	const std::string& functionName)
+{
+	report("Mapping binary '" << filename << "'...");
+
+	_file.map(filename);
+
+	_mapSections();
+
+	const SymbolTableEntry* symbol = findSymbol(functionName);
+
+	if(symbol == nullptr || symbol->type != SymbolTableEntry::FunctionType)
+	{
+		throw std::runtime_error("No function named '" + functionName +
+			"' in binary '" + filename + "'.");
+	}
+
+	ir::Module* module = new ir::Module(filename,
+		compiler::Compiler::getSingleton());
+
+	// globals and function shells are loaded so that operands referencing
+	// them resolve, only the requested function's body is decoded
+	_loadTypes();
+	_loadGlobals(*module);
+	_loadFunction(*module, *symbol);
+
+	_variables.clear();
+	_locals.clear();
+
+	report("Finished loading function '" << functionName << "'...");
+
+	return module;
+}
+
+const SymbolTableEntry* BinaryReader::findSymbol(const std::string& name) const
+{
+	if(_hashIndex != nullptr)
+	{
+		uint32_t hash = hashSymbolName(name.c_str());
+
+		for(uint64_t slot = hash & (_hashSlots - 1); ;
+			slot = (slot + 1) & (_hashSlots - 1))
+		{
+			const SymbolHashEntry& entry = _hashIndex[slot];
+
+			if(entry.symbol == SymbolHashEntry::InvalidSymbol) break;
+			if(entry.hash != hash) continue;
+
+			const SymbolTableEntry& symbol = _symbolTable[entry.symbol];
+
+			if(name == _stringTable + symbol.stringOffset) return &symbol;
+		}
+
+		return nullptr;
+	}
+
+	// binaries without a hash index fall back to a linear scan
+	for(size_t i = 0; i != _symbolCount; ++i)
+	{
+		if(name == _stringTable + _symbolTable[i].stringOffset)
+		{
+			return &_symbolTable[i];
+		}
+	}
+
+	return nullptr;
+}
+
 void BinaryReader::_readHeader(std::istream& stream)
 {
 	report("Reading header...");
@@ -85,15 +190,17 @@ void BinaryReader::_readDataSection(std::istream& stream)
 
 	stream.seekg(_header.dataOffset, std::ios::beg);
 
-	_dataSection.resize(dataSize);
+	_dataStorage.resize(dataSize);
 
-	stream.read((char*) _dataSection.data(), dataSize);
+	stream.read((char*) _dataStorage.data(), dataSize);
 
 	if((size_t)stream.gcount() != dataSize)
 	{
 		throw std::runtime_error("Failed to read binary data section, hit"
-			" EOF."); 
+			" EOF.");
 	}
+
+	_dataSection = _dataStorage.data();
 }
 
 void BinaryReader::_readStringTable(std::istream& stream)
@@ -102,14 +209,16 @@ void BinaryReader::_readStringTable(std::istream& stream)
 
 	stream.seekg(_header.stringsOffset, std::ios::beg);
 
-	_stringTable.resize(stringTableSize);
+	_stringStorage.resize(stringTableSize);
 
-	stream.read((char*) _stringTable.data(), stringTableSize);
+	stream.read((char*) _stringStorage.data(), stringTableSize);
 
 	if((size_t)stream.gcount() != stringTableSize)
 	{
 		throw std::runtime_error("Failed to read string table, hit EOF");
 	}
+
+	_stringTable = _stringStorage.data();
 }
 
 void BinaryReader::_readSymbolTable(std::istream& stream)
@@ -118,14 +227,17 @@ void BinaryReader::_readSymbolTable(std::istream& stream)
 
 	stream.seekg(_header.symbolOffset, std::ios::beg);
 
-	_symbolTable.resize(_header.symbols);
+	_symbolStorage.resize(_header.symbols);
 
-	stream.read((char*) _symbolTable.data(), symbolTableSize);
+	stream.read((char*) _symbolStorage.data(), symbolTableSize);
 
 	if((size_t)stream.gcount() != symbolTableSize)
 	{
 		throw std::runtime_error("Failed to read symbol table, hit EOF");
 	}
+
+	_symbolTable = _symbolStorage.data();
+	_symbolCount = _header.symbols;
 }
 
 void BinaryReader::_readInstructions(std::istream& stream)
@@ -134,23 +246,291 @@ void BinaryReader::_readInstructions(std::istream& stream)
 	size_t sizeInInstructions = (dataSize + sizeof(InstructionContainer) - 1) /
 		sizeof(InstructionContainer);
 
-	_instructions.resize(sizeInInstructions);
+	_instructionStorage.resize(sizeInInstructions);
 
 	// TODO obey page alignment
 	stream.seekg(_header.codeOffset, std::ios::beg);
 
-	stream.read((char*) _instructions.data(), dataSize);
+	stream.read((char*) _instructionStorage.data(), dataSize);
 
 	if((size_t)stream.gcount() != dataSize)
 	{
 		throw std::runtime_error("Failed to read code section, hit EOF.");
 	}
+
+	_instructions     = _instructionStorage.data();
+	_instructionCount = sizeInInstructions;
+}
+
+void BinaryReader::_readHashIndex(std::istream& stream)
+{
+	if(_header.hashSlots == 0) return;
+
+	size_t hashIndexSize = sizeof(SymbolHashEntry) * _header.hashSlots;
+
+	stream.seekg(_header.hashOffset, std::ios::beg);
+
+	_hashStorage.resize(_header.hashSlots);
+
+	stream.read((char*) _hashStorage.data(), hashIndexSize);
+
+	if((size_t)stream.gcount() != hashIndexSize)
+	{
+		throw std::runtime_error("Failed to read symbol hash index, hit EOF");
+	}
+
+	_hashIndex = _hashStorage.data();
+	_hashSlots = _header.hashSlots;
+}
+
+void BinaryReader::_readCompressedSections(std::istream& stream)
+{
+	size_t totalPages = _header.dataPages + _header.codePages +
+		_header.stringPages;
+
+	std::vector<CompressedPageEntry> pageTable(totalPages);
+
+	size_t pageTableSize = totalPages * sizeof(CompressedPageEntry);
+
+	stream.seekg(_header.pageTableOffset, std::ios::beg);
+
+	stream.read((char*) pageTable.data(), pageTableSize);
+
+	if((size_t)stream.gcount() != pageTableSize)
+	{
+		throw std::runtime_error("Failed to read page table, hit EOF");
+	}
+
+	size_t codeSize = BinaryHeader::PageSize * _header.codePages;
+
+	size_t instructionCount =
+		(codeSize + sizeof(InstructionContainer) - 1) /
+		sizeof(InstructionContainer);
+
+	       _dataStorage.resize(BinaryHeader::PageSize * _header.dataPages);
+	_instructionStorage.resize(instructionCount);
+	     _stringStorage.resize(BinaryHeader::PageSize * _header.stringPages);
+
+	// the page table covers the data, code, and string sections in order
+	auto entry = pageTable.begin();
+
+	for(size_t page = 0; page != _header.dataPages; ++page)
+	{
+		_readCompressedPage(stream, *entry++,
+			_dataStorage.data() + page * BinaryHeader::PageSize);
+	}
+
+	for(size_t page = 0; page != _header.codePages; ++page)
+	{
+		_readCompressedPage(stream, *entry++,
+			(char*)_instructionStorage.data() +
+			page * BinaryHeader::PageSize);
+	}
+
+	for(size_t page = 0; page != _header.stringPages; ++page)
+	{
+		_readCompressedPage(stream, *entry++,
+			_stringStorage.data() + page * BinaryHeader::PageSize);
+	}
+
+	_dataSection      = _dataStorage.data();
+	_stringTable      = _stringStorage.data();
+	_instructions     = _instructionStorage.data();
+	_instructionCount = instructionCount;
+}
+
+void BinaryReader::_readCompressedPage(std::istream& stream,
+	const CompressedPageEntry& entry, void* page)
+{
+	stream.seekg(entry.offset, std::ios::beg);
+
+	if(entry.size == BinaryHeader::PageSize)
+	{
+		// incompressible pages are stored raw
+		stream.read((char*) page, BinaryHeader::PageSize);
+
+		if((size_t)stream.gcount() != BinaryHeader::PageSize)
+		{
+			throw std::runtime_error("Failed to read compressed page, "
+				"hit EOF");
+		}
+
+		return;
+	}
+
+	std::vector<char> compressed(entry.size);
+
+	stream.read(compressed.data(), entry.size);
+
+	if((size_t)stream.gcount() != entry.size)
+	{
+		throw std::runtime_error("Failed to read compressed page, hit EOF");
+	}
+
+	decompressPage((const unsigned char*)compressed.data(), entry.size, page);
+}
+
+void BinaryReader::_mapSections()
+{
+	if(_file.size() < sizeof(BinaryHeader))
+	{
+		throw std::runtime_error("Failed to read binary "
+			"header, hit EOF.");
+	}
+
+	std::memcpy(&_header, _file.data(), sizeof(BinaryHeader));
+
+	if(_header.magic != BinaryHeader::MagicNumber)
+	{
+		throw std::runtime_error("Failed to read binary "
+			"header, invalid magic number.");
+	}
+
+	size_t symbolSize = sizeof(SymbolTableEntry) * _header.symbols;
+
+	if(_header.symbolOffset + symbolSize > _file.size())
+	{
+		throw std::runtime_error("Binary sections extend "
+			"past the end of the file.");
+	}
+
+	_symbolTable = reinterpret_cast<const SymbolTableEntry*>(
+		_file.data() + _header.symbolOffset);
+	_symbolCount = _header.symbols;
+
+	if(_header.flags & BinaryHeader::CompressedSections)
+	{
+		// compressed sections cannot be used in place, expand them
+		_decompressSections();
+	}
+	else
+	{
+		size_t dataSize   = BinaryHeader::PageSize * _header.dataPages;
+		size_t stringSize = BinaryHeader::PageSize * _header.stringPages;
+		size_t codeSize   = BinaryHeader::PageSize * _header.codePages;
+
+		size_t instructionCount =
+			(codeSize + sizeof(InstructionContainer) - 1) /
+			sizeof(InstructionContainer);
+
+		if(_header.dataOffset    + dataSize   > _file.size() ||
+			_header.stringsOffset + stringSize > _file.size() ||
+			_header.codeOffset +
+				instructionCount * sizeof(InstructionContainer) > _file.size())
+		{
+			throw std::runtime_error("Binary sections extend "
+				"past the end of the file.");
+		}
+
+		// the sections are used in place, no copies are made
+		_dataSection = _file.data() + _header.dataOffset;
+		_stringTable = _file.data() + _header.stringsOffset;
+
+		_instructions = reinterpret_cast<const InstructionContainer*>(
+			_file.data() + _header.codeOffset);
+		_instructionCount = instructionCount;
+	}
+
+	if(_header.hashSlots != 0)
+	{
+		size_t hashIndexSize = sizeof(SymbolHashEntry) * _header.hashSlots;
+
+		if(_header.hashOffset + hashIndexSize > _file.size())
+		{
+			throw std::runtime_error("Binary sections extend "
+				"past the end of the file.");
+		}
+
+		_hashIndex = reinterpret_cast<const SymbolHashEntry*>(
+			_file.data() + _header.hashOffset);
+		_hashSlots = _header.hashSlots;
+	}
+
+	report(" data pages:    " << _header.dataPages);
+	report(" code pages:    " << _header.codePages);
+	report(" symbols:       " << _header.symbols);
+	report(" string pages:  " << _header.stringPages);
+}
+
+void BinaryReader::_decompressSections()
+{
+	size_t totalPages = _header.dataPages + _header.codePages +
+		_header.stringPages;
+
+	size_t pageTableSize = totalPages * sizeof(CompressedPageEntry);
+
+	if(_header.pageTableOffset + pageTableSize > _file.size())
+	{
+		throw std::runtime_error("Binary sections extend "
+			"past the end of the file.");
+	}
+
+	auto pageTable = reinterpret_cast<const CompressedPageEntry*>(
+		_file.data() + _header.pageTableOffset);
+
+	size_t codeSize = BinaryHeader::PageSize * _header.codePages;
+
+	size_t instructionCount =
+		(codeSize + sizeof(InstructionContainer) - 1) /
+		sizeof(InstructionContainer);
+
+	       _dataStorage.resize(BinaryHeader::PageSize * _header.dataPages);
+	_instructionStorage.resize(instructionCount);
+	     _stringStorage.resize(BinaryHeader::PageSize * _header.stringPages);
+
+	// the page table covers the data, code, and string sections in order
+	const CompressedPageEntry* entry = pageTable;
+
+	for(size_t page = 0; page != totalPages; ++page, ++entry)
+	{
+		if(entry->offset + entry->size > _file.size())
+		{
+			throw std::runtime_error("Binary sections extend "
+				"past the end of the file.");
+		}
+
+		char* destination = nullptr;
+
+		if(page < _header.dataPages)
+		{
+			destination = _dataStorage.data() +
+				page * BinaryHeader::PageSize;
+		}
+		else if(page < _header.dataPages + _header.codePages)
+		{
+			destination = (char*)_instructionStorage.data() +
+				(page - _header.dataPages) * BinaryHeader::PageSize;
+		}
+		else
+		{
+			destination = _stringStorage.data() +
+				(page - _header.dataPages - _header.codePages) *
+				BinaryHeader::PageSize;
+		}
+
+		if(entry->size == BinaryHeader::PageSize)
+		{
+			// incompressible pages are stored raw
+			std::memcpy(destination, _file.data() + entry->offset,
+				BinaryHeader::PageSize);
+		}
+		else
+		{
+			decompressPage(reinterpret_cast<const unsigned char*>(
+				_file.data() + entry->offset), entry->size, destination);
+		}
+	}
+
+	_dataSection      = _dataStorage.data();
+	_stringTable      = _stringStorage.data();
+	_instructions     = _instructionStorage.data();
+	_instructionCount = instructionCount;
 }
 
 void BinaryReader::_loadTypes()
 {
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolTable;
+		symbol != _symbolTable + _symbolCount; ++symbol)
 	{
 		compiler::Compiler::getSingleton()->getOrInsertType(
 			_getSymbolTypeName(*symbol));
@@ -170,15 +550,15 @@ void BinaryReader::_loadGlobals(ir::Module& m)
 {
 	report(" Loading global variables from symbol table...");
 	
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolTable;
+		symbol != _symbolTable + _symbolCount; ++symbol)
 	{
 		if(symbol->type != SymbolTableEntry::VariableType &&
 			symbol->type != SymbolTableEntry::FunctionType) continue;
 
 		uint64_t symbolTableOffset = _header.symbolOffset +
 			sizeof(SymbolTableEntry) *
-			std::distance(_symbolTable.begin(), symbol);
+			std::distance(_symbolTable, symbol);
 		
 		report("  loaded " << _getSymbolName(*symbol)
 			<< " at offset " << symbol->offset
@@ -256,148 +636,153 @@ void BinaryReader::_loadGlobals(ir::Module& m)
 
 void BinaryReader::_loadFunctions(ir::Module& m)
 {
-	typedef std::unordered_map<uint64_t, ir::BasicBlock*> PCToBasicBlockMap;
-
 	report(" Loading functions from symbol table...");
 
-	for(auto symbol = _symbolTable.begin();
-		symbol != _symbolTable.end(); ++symbol)
+	for(auto symbol = _symbolTable;
+		symbol != _symbolTable + _symbolCount; ++symbol)
 	{
 		if(symbol->type != SymbolTableEntry::FunctionType) continue;
 
-		report("  loaded function " << _getSymbolName(*symbol));
-
-		uint64_t symbolTableOffset = _header.symbolOffset +
-			sizeof(SymbolTableEntry) *
-			std::distance(_symbolTable.begin(), symbol);
-	
-		ir::Variable* variable = _getVariableAtSymbolOffset(symbolTableOffset);
-		ir::Function* function = static_cast<ir::Function*>(variable);
-		
-		_function = function;
-		
-		report("   loading arguments...");
+		_loadFunction(m, *symbol);
+	}
+}
 
-		for(auto argumentSymbol = _symbolTable.begin();
-			argumentSymbol != _symbolTable.end(); ++argumentSymbol)
-		{
-			if(argumentSymbol->type != SymbolTableEntry::ArgumentType)
-			{
-				continue;
-			}
-			
-			std::string functionName =
-				_getSymbolName(*argumentSymbol).substr(2,
-				function->name().size());
-		
-			if(functionName != function->name()) continue;
+void BinaryReader::_loadFunction(ir::Module& m, const SymbolTableEntry& symbol)
+{
+	typedef std::unordered_map<uint64_t, ir::BasicBlock*> PCToBasicBlockMap;
 
-			uint64_t symbolTableOffset = _header.symbolOffset +
-				sizeof(SymbolTableEntry) *
-				std::distance(_symbolTable.begin(), argumentSymbol);
+	report("  loaded function " << _getSymbolName(symbol));
 
-			std::string name = _getSymbolName(*argumentSymbol).substr(
-				2 + function->name().size());
+	uint64_t symbolTableOffset = _header.symbolOffset +
+		sizeof(SymbolTableEntry) *
+		std::distance(_symbolTable, &symbol);
 
-			report("    loaded argument " << name
-				<< " at offset " << argumentSymbol->offset
-				<< ", symbol offset is " << symbolTableOffset);
+	ir::Variable* variable = _getVariableAtSymbolOffset(symbolTableOffset);
+	ir::Function* function = static_cast<ir::Function*>(variable);
 
-			auto type = _getSymbolType(*argumentSymbol);
+	_function = function;
 
-			if(type == nullptr)
-			{
-				throw std::runtime_error("Could not find type with name '" +
-					_getSymbolTypeName(*argumentSymbol) + "' for symbol '" +
-					name + "'");
-			}
-	
-			auto argument = function->newArgument(type, name);
+	report("   loading arguments...");
 
-			_arguments.insert(std::make_pair(symbolTableOffset,
-				&*argument));
+	for(auto argumentSymbol = _symbolTable;
+		argumentSymbol != _symbolTable + _symbolCount; ++argumentSymbol)
+	{
+		if(argumentSymbol->type != SymbolTableEntry::ArgumentType)
+		{
+			continue;
 		}
 
-		BasicBlockDescriptorVector blocks = _getBasicBlocksInFunction(*symbol);
-	
-		PCToBasicBlockMap blockPCs;
+		std::string functionName =
+			_getSymbolName(*argumentSymbol).substr(2,
+			function->name().size());
 
-		for(auto blockOffset : blocks)
-		{
-			ir::Function::iterator block = function->newBasicBlock(
-				function->end(), blockOffset.name);
+		if(functionName != function->name()) continue;
 
-			blockPCs.insert(std::make_pair(blockOffset.begin, &*block));
+		uint64_t symbolTableOffset = _header.symbolOffset +
+			sizeof(SymbolTableEntry) *
+			std::distance(_symbolTable, argumentSymbol);
 
-			report("   adding basic block " << blockOffset.name
-				<< " using instructions [" 
-				<< blockOffset.begin << ", " << blockOffset.end << "]");
-		
-			for(unsigned int i = blockOffset.begin; i != blockOffset.end; ++i)
-			{
-				assert(i < _instructions.size());
-				_addInstruction(block, _instructions[i]);
-				report("    added instruction '" 
-					<< block->back()->toString() << "'");
-			}
-		}
+		std::string name = _getSymbolName(*argumentSymbol).substr(
+			2 + function->name().size());
+
+		report("    loaded argument " << name
+			<< " at offset " << argumentSymbol->offset
+			<< ", symbol offset is " << symbolTableOffset);
 
-		report("  resolving branch targets...");
+		auto type = _getSymbolType(*argumentSymbol);
 
-		for(auto unresolved : _unresolvedTargets)
+		if(type == nullptr)
 		{
-			// find the symbol with the specified offset
-			const SymbolTableEntry& targetSymbol =
-				_getSymbolEntryAtOffset(unresolved.first);
+			throw std::runtime_error("Could not find type with name '" +
+				_getSymbolTypeName(*argumentSymbol) + "' for symbol '" +
+				name + "'");
+		}
 
-			uint64_t pc = (targetSymbol.offset - _header.codeOffset) /
-				sizeof(InstructionContainer);
-		
-			report("   for branch to pc " << pc);
+		auto argument = function->newArgument(type, name);
 
-			auto block = blockPCs.find(pc);
+		_arguments.insert(std::make_pair(symbolTableOffset,
+			&*argument));
+	}
 
-			if(block == blockPCs.end())
-			{
-				std::stringstream message;
+	BasicBlockDescriptorVector blocks = _getBasicBlocksInFunction(symbol);
 
-				message << "Could not find basic block starting at pc " << pc;
+	PCToBasicBlockMap blockPCs;
 
-				throw std::runtime_error(message.str());
-			}
-			
-			report("    setting target to " << block->second->name());
+	for(auto blockOffset : blocks)
+	{
+		ir::Function::iterator block = function->newBasicBlock(
+			function->end(), blockOffset.name);
+
+		blockPCs.insert(std::make_pair(blockOffset.begin, &*block));
 
-			static_cast<ir::AddressOperand*>(unresolved.second)->globalValue =
-				block->second;
+		report("   adding basic block " << blockOffset.name
+			<< " using instructions [" 
+			<< blockOffset.begin << ", " << blockOffset.end << "]");
+	
+		for(unsigned int i = blockOffset.begin; i != blockOffset.end; ++i)
+		{
+			assert(i < _instructionCount);
+			_addInstruction(block, _instructions[i]);
+			report("    added instruction '" 
+				<< block->back()->toString() << "'");
 		}
+	}
 
-		_unresolvedTargets.clear();
-		_virtualRegisters.clear();
-		_arguments.clear();
-		
-		for(auto local = _locals.begin(); local != _locals.end(); ++local)
+	report("  resolving branch targets...");
+
+	for(auto unresolved : _unresolvedTargets)
+	{
+		// find the symbol with the specified offset
+		const SymbolTableEntry& targetSymbol =
+			_getSymbolEntryAtOffset(unresolved.first);
+
+		uint64_t pc = (targetSymbol.offset - _header.codeOffset) /
+			sizeof(InstructionContainer);
+	
+		report("   for branch to pc " << pc);
+
+		auto block = blockPCs.find(pc);
+
+		if(block == blockPCs.end())
 		{
-			local->second = nullptr;
+			std::stringstream message;
+
+			message << "Could not find basic block starting at pc " << pc;
+
+			throw std::runtime_error(message.str());
 		}
+		
+		report("    setting target to " << block->second->name());
+
+		static_cast<ir::AddressOperand*>(unresolved.second)->globalValue =
+			block->second;
+	}
+
+	_unresolvedTargets.clear();
+	_virtualRegisters.clear();
+	_arguments.clear();
+	
+	for(auto local = _locals.begin(); local != _locals.end(); ++local)
+	{
+		local->second = nullptr;
 	}
 }
 
 std::string BinaryReader::_getSymbolName(const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.stringOffset);
+	return std::string(_stringTable + symbol.stringOffset);
 }
 
 std::string BinaryReader::_getSymbolTypeName(
 	const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.typeOffset);
+	return std::string(_stringTable + symbol.typeOffset);
 }
 
 std::string BinaryReader::_getSymbolAttributes(
 	const SymbolTableEntry& symbol) const
 {
-	return std::string((char*)_stringTable.data() + symbol.attributeOffset);
+	return std::string(_stringTable + symbol.attributeOffset);
 }
 
 ir::Type* BinaryReader::_getSymbolType(const SymbolTableEntry& symbol) const
@@ -745,7 +1130,7 @@ void BinaryReader::_addCallInstruction(ir::Function::iterator block,
 		uint64_t offset = returned * sizeof(OperandContainer) +
 			container.asCall.returnArgumentOffset;
 		const OperandContainer* operand =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(_dataSection + offset);
 	
 		instruction->addReturn(_translateOperand(*operand, instruction));
 	}
@@ -756,7 +1141,7 @@ void BinaryReader::_addCallInstruction(ir::Function::iterator block,
 		uint64_t offset = argument * sizeof(OperandContainer) +
 			container.asCall.argumentOffset;
 		const OperandContainer* operand =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(_dataSection + offset);
 	
 		instruction->addArgument(_translateOperand(*operand, instruction));
 	}
@@ -788,9 +1173,9 @@ void BinaryReader::_addPhiInstruction(ir::Function::iterator block,
 			container.asPhi.sourcesOffset;
 		
 		const OperandContainer* operandSource =
-			reinterpret_cast<OperandContainer*>(&_dataSection[offset]);
+			reinterpret_cast<const OperandContainer*>(_dataSection + offset);
 		const OperandContainer* operandBlock =
-			reinterpret_cast<OperandContainer*>(&_dataSection[blockOffset]);
+			reinterpret_cast<const OperandContainer*>(_dataSection + blockOffset);
 			
 		auto registerSource = static_cast<ir::RegisterOperand*>(
 			_translateOperand(*operandSource, instruction));
@@ -1012,8 +1397,8 @@ const SymbolTableEntry& BinaryReader::_getSymbolEntryAtOffset(
 	uint64_t symbolOffset =
 		(offset - _header.symbolOffset) / sizeof(SymbolTableEntry);
 	
-	assertM(symbolOffset < _symbolTable.size(), "Invalid symbol "
-		<< symbolOffset << " out of " << _symbolTable.size());
+	assertM(symbolOffset < _symbolCount, "Invalid symbol "
+		<< symbolOffset << " out of " << _symbolCount);
 	
 	return _symbolTable[symbolOffset];
 }
@@ -11,9 +11,18 @@
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/analysis/interface/AnalysisFactory.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/PostDominatorAnalysis.h>
+
+#include <vanaheimr/util/interface/Executor.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
+// Standard Library Includes
+#include <cstring>
+
 // Preprocessor Macros
 #ifdef REPORT_BASE
 #undef REPORT_BASE
@@ -35,68 +44,521 @@ BinaryWriter::BinaryWriter()
 
 }
 
-void BinaryWriter::write(std::ostream& binary, const ir::Module& m)
+void BinaryWriter::write(std::ostream& binary, const ir::Module& m,
+	bool compress)
 {
 	m_module = &m;
 
 	report("Serializing module " << m.name << " to binary bytecode...");
 
+	if(compress)
+	{
+		DataVector image;
+
+		layoutImage(image, compress);
+
+		report(" writing " << image.size() << " byte image");
+
+		binary.write(image.data(), image.size());
+
+		return;
+	}
+
+	// Stream the sections out directly, the monolithic image copy is only
+	// needed by the compressed and incremental paths
+	populateSections();
+
+	writeSections(binary);
+}
+
+void BinaryWriter::writeIncremental(std::iostream& binary,
+	const ir::Module& m, bool compress)
+{
+	m_module = &m;
+
+	report("Incrementally serializing module " << m.name
+		<< " to binary bytecode...");
+
+	DataVector image;
+
+	layoutImage(image, compress);
+
+	binary.seekg(0, std::ios::end);
+
+	size_t fileSize = binary.tellg();
+
+	// Rewrite only the pages whose bytes changed, the layout is
+	// deterministic so functions in front of an edit keep their offsets
+	// and their pages are left alone.  A shrinking image leaves stale
+	// bytes behind the last section, readers never look past the page
+	// counts in the header
+	DataVector existing(PageSize);
+
+	size_t pages        = (image.size() + PageSize - 1) / PageSize;
+	size_t pagesWritten = 0;
+
+	for(size_t page = 0; page != pages; ++page)
+	{
+		size_t offset = page * PageSize;
+		size_t bytes  = image.size() - offset;
+
+		if(bytes > PageSize) bytes = PageSize;
+
+		if(offset + bytes <= fileSize)
+		{
+			binary.seekg(offset, std::ios::beg);
+			binary.read(existing.data(), bytes);
+
+			if(std::memcmp(existing.data(),
+				image.data() + offset, bytes) == 0)
+			{
+				continue;
+			}
+		}
+
+		binary.seekp(offset, std::ios::beg);
+		binary.write(image.data() + offset, bytes);
+
+		++pagesWritten;
+	}
+
+	report(" rewrote " << pagesWritten << " of " << pages << " pages");
+}
+
+static std::string flattenAttributes(const ir::Function& function);
+
+void BinaryWriter::beginStreaming(const ir::Module& m)
+{
+	m_module = &m;
+
+	report("Serializing module " << m.name
+		<< " to binary bytecode, streaming one function at a time...");
+
+	// the section buffers grow on demand, sizing them up front would
+	// materialize every function body and defeat the streaming
+	populateData();
+
+	// function symbols go in up front so cross-function references
+	// resolve before any body is materialized
+	report(" Adding function symbols.");
+	for(ir::Module::const_iterator function = m_module->begin();
+		function != m_module->end(); ++function)
+	{
+		report("  " << function->name());
+		addSymbol(SymbolTableEntry::FunctionType, function->linkage(),
+			function->visibility(), ir::Global::InvalidLevel, function->name(),
+			0, 0, function->type().name, flattenAttributes(*function));
+	}
+}
+
+void BinaryWriter::streamFunction(ir::Function& function)
+{
+	report(" Streaming function " << function.name());
+
+	function.materialize();
+
+	// Arguments
+	for(auto argument = function.argument_begin();
+		argument != function.argument_end(); ++argument)
+	{
+		addSymbol(SymbolTableEntry::ArgumentType, 0x0, 0x0,
+			ir::Global::InvalidLevel, argument->mangledName(),
+			m_data.size(), 0x0, argument->type().name);
+		m_data.resize(m_data.size() + argument->type().bytes());
+	}
+
+	// Locals
+	for(auto local = function.local_begin();
+		local != function.local_end(); ++local)
+	{
+		addGlobal(*local);
+	}
+
+	EncodingContext context;
+
+	context.instructionBegin = m_instructions.size();
+
+	size_t instructionOffset = context.instructionBegin;
+
+	// Basic blocks get their symbols up front, encoding only reads
+	for(auto bb = function.begin(); bb != function.end(); ++bb)
+	{
+		uint64_t codeOffset =
+			instructionOffset * sizeof(InstructionContainer);
+
+		context.blockOffsets.insert(
+			std::make_pair(bb->name(), codeOffset));
+		context.blockSymbols.insert(std::make_pair(codeOffset,
+			m_symbolTable.size() * sizeof(SymbolTableEntry) +
+			getSymbolTableOffset()));
+
+		addSymbol(SymbolTableEntry::BasicBlockType, 0x0, 0x0,
+			ir::Global::InvalidLevel, bb->name(), codeOffset, 0,
+			bb->type().name);
+
+		instructionOffset += bb->size();
+	}
+
+	size_t instructionsBegin =
+		context.instructionBegin * sizeof(InstructionContainer);
+
+	patchSymbol(function.name(), instructionsBegin,
+		instructionOffset * sizeof(InstructionContainer)
+		- instructionsBegin);
+
+	addReconvergencePoints(function, context);
+
+	// encode immediately, the operand data lands at the live end of the
+	// data section instead of a precomputed slice
+	context.dataBegin = m_data.size();
+
+	m_instructions.resize(instructionOffset);
+
+	encodeFunction(function, context);
+
+	m_data.insert(m_data.end(), context.data.begin(), context.data.end());
+
+	// the encoded bytes are final, drop the body so only the next
+	// function is ever resident
+	function.clear();
+}
+
+void BinaryWriter::endStreaming(std::ostream& binary)
+{
+	flushReconvergenceTable();
+
+	linkSymbols();
+	populateHashIndex();
+
+	populateHeader();
+
+	writeSections(binary);
+}
+
+void BinaryWriter::layoutImage(DataVector& image, bool compress)
+{
+	populateSections();
+
+	if(compress)
+	{
+		layoutCompressedImage(image);
+
+		return;
+	}
+
+	// All of the section sizes are exact now, lay the entire image out in
+	// a single allocation, the page padding between sections comes along
+	// for free
+	image.resize(getHashIndexOffset() + pageAlign(getHashIndexSize()));
+
+	std::memcpy(image.data() + getHeaderOffset(), &m_header,
+		sizeof(BinaryHeader));
+	std::memcpy(image.data() + getSymbolTableOffset(), m_symbolTable.data(),
+		getSymbolTableSize());
+	std::memcpy(image.data() + getInstructionOffset(), m_instructions.data(),
+		getInstructionStreamSize());
+	std::memcpy(image.data() + getDataOffset(), m_data.data(),
+		getDataSize());
+	std::memcpy(image.data() + getStringTableOffset(), m_stringTable.data(),
+		getStringTableSize());
+	std::memcpy(image.data() + getHashIndexOffset(), m_hashIndex.data(),
+		getHashIndexSize());
+}
+
+void BinaryWriter::populateSections()
+{
+	reserveSections();
+
 	populateData();
 	populateInstructions();
 	linkSymbols();
-	
+	populateHashIndex();
+
 	populateHeader();
+}
+
+void BinaryWriter::writeSections(std::ostream& binary)
+{
+	size_t position = 0;
+
+	DataVector zeros(PageSize);
 
-	report(" writing header");
-	writePage(binary, (const char*)&m_header, sizeof(BinaryHeader));
-	report(" writing symbols");
-	writePage(binary, (const char*)m_symbolTable.data(), getSymbolTableSize());
-	report(" writing instructions");
-	writePage(binary, (const char*)m_instructions.data(),
+	auto writeSection = [&](size_t offset, const void* data, size_t size)
+	{
+		while(position < offset)
+		{
+			size_t bytes = offset - position;
+
+			if(bytes > zeros.size()) bytes = zeros.size();
+
+			binary.write(zeros.data(), bytes);
+
+			position += bytes;
+		}
+
+		if(size != 0) binary.write((const char*)data, size);
+
+		position += size;
+	};
+
+	writeSection(getHeaderOffset(),      &m_header,            sizeof(BinaryHeader));
+	writeSection(getSymbolTableOffset(), m_symbolTable.data(), getSymbolTableSize());
+	writeSection(getInstructionOffset(), m_instructions.data(),
 		getInstructionStreamSize());
-	report(" writing data");
-	writePage(binary, (const char*)m_data.data(), getDataSize());
-	report(" writing string table");
-	writePage(binary, (const char*)m_stringTable.data(), getStringTableSize());
+	writeSection(getDataOffset(),        m_data.data(),        getDataSize());
+	writeSection(getStringTableOffset(), m_stringTable.data(), getStringTableSize());
+	writeSection(getHashIndexOffset(),   m_hashIndex.data(),   getHashIndexSize());
+
+	// trailing padding keeps the file page aligned like the image path
+	writeSection(getHashIndexOffset() + pageAlign(getHashIndexSize()),
+		nullptr, 0);
+
+	report(" streamed " << position << " bytes of sections");
 }
 
-void BinaryWriter::writePage(std::ostream& binary, const void* data,
-	uint64_t size)
+typedef std::vector<char>                ByteVector;
+typedef std::vector<CompressedPageEntry> PageEntryVector;
+
+static void appendLength(ByteVector& out, unsigned int length)
 {
-	uint64_t currentPosition = pageAlign(binary.tellp());
-	
-	report("  page aligning " << binary.tellp() << " to " << currentPosition 
-		<< " before writing.");
+	// the first fifteen are carried in the token nibble
+	for(length -= 15; length >= 255; length -= 255)
+	{
+		out.push_back((char)0xff);
+	}
+
+	out.push_back((char)length);
+}
+
+/*! \brief Compress one page into the sequence format that decompressPage
+	expands, returns the compressed size */
+static size_t compressPage(ByteVector& out, const char* page,
+	size_t size)
+{
+	// greedy parse, hash four byte windows to find earlier occurrences,
+	// positions are stored plus one so that zero means empty
+	const unsigned int hashBits = 12;
 
-	while((uint64_t)binary.tellp() != currentPosition)
+	uint16_t windowTable[1 << hashBits];
+
+	std::memset(windowTable, 0, sizeof(windowTable));
+
+	size_t begin        = out.size();
+	size_t literalStart = 0;
+	size_t position     = 0;
+
+	while(position + 4 <= size)
 	{
-		char temp = 0;
-		binary.write(&temp, 1);
+		uint32_t window = 0;
+
+		std::memcpy(&window, page + position, 4);
+
+		uint32_t hash = (window * 2654435761u) >> (32 - hashBits);
+
+		size_t candidate = windowTable[hash];
+
+		windowTable[hash] = position + 1;
+
+		if(candidate == 0 ||
+			std::memcmp(page + candidate - 1, page + position, 4) != 0)
+		{
+			++position;
+
+			continue;
+		}
+
+		size_t matchStart = candidate - 1;
+		size_t length     = 4;
+
+		while(position + length < size &&
+			page[matchStart + length] == page[position + length])
+		{
+			++length;
+		}
+
+		size_t literals = position - literalStart;
+
+		unsigned int literalNibble = literals   < 15 ? literals   : 15;
+		unsigned int matchNibble   = length - 4 < 15 ? length - 4 : 15;
+
+		out.push_back((char)((literalNibble << 4) | matchNibble));
+
+		if(literals >= 15) appendLength(out, literals);
+
+		out.insert(out.end(), page + literalStart, page + position);
+
+		size_t offset = position - matchStart;
+
+		out.push_back((char)(offset & 0xff));
+		out.push_back((char)(offset >> 8));
+
+		if(length - 4 >= 15) appendLength(out, length - 4);
+
+		position    += length;
+		literalStart = position;
 	}
 
-	binary.write((const char*)data, size);
-	
-	currentPosition = pageAlign(binary.tellp());
-	
-	report("  page aligning " << binary.tellp() << " to " << currentPosition 
-		<< " after writing.");
-	
-	while((uint64_t)binary.tellp() != currentPosition)
+	// the final sequence carries the trailing literals and no match
+	size_t literals = size - literalStart;
+
+	unsigned int literalNibble = literals < 15 ? literals : 15;
+
+	out.push_back((char)(literalNibble << 4));
+
+	if(literals >= 15) appendLength(out, literals);
+
+	out.insert(out.end(), page + literalStart, page + size);
+
+	return out.size() - begin;
+}
+
+static void compressSection(PageEntryVector& pageTable,
+	ByteVector& out, size_t baseOffset, const char* section,
+	size_t size, size_t pages)
+{
+	ByteVector padded(BinaryHeader::PageSize);
+
+	for(size_t page = 0; page != pages; ++page)
 	{
-		char temp = 0;
-		binary.write(&temp, 1);
+		size_t bytes = size - page * BinaryHeader::PageSize;
+
+		if(bytes > BinaryHeader::PageSize) bytes = BinaryHeader::PageSize;
+
+		std::memset(padded.data(), 0, BinaryHeader::PageSize);
+		std::memcpy(padded.data(),
+			section + page * BinaryHeader::PageSize, bytes);
+
+		CompressedPageEntry entry;
+
+		entry.offset = baseOffset + out.size();
+		entry.unused = 0;
+
+		size_t begin = out.size();
+
+		size_t compressedSize = compressPage(out, padded.data(),
+			BinaryHeader::PageSize);
+
+		if(compressedSize >= BinaryHeader::PageSize)
+		{
+			// incompressible, store the page raw
+			out.resize(begin);
+			out.insert(out.end(), padded.begin(), padded.end());
+
+			compressedSize = BinaryHeader::PageSize;
+		}
+
+		entry.size = compressedSize;
+
+		pageTable.push_back(entry);
 	}
 }
 
+void BinaryWriter::layoutCompressedImage(DataVector& image)
+{
+	// The logical section offsets in the header are unchanged so that the
+	// symbol offset arithmetic still works, the compressed pages live
+	// behind the page table and are found through it instead
+	size_t totalPages = m_header.dataPages + m_header.codePages +
+		m_header.stringPages;
+
+	m_header.flags          |= BinaryHeader::CompressedSections;
+	m_header.hashOffset      = pageAlign(getSymbolTableOffset() +
+		getSymbolTableSize());
+	m_header.pageTableOffset = pageAlign(m_header.hashOffset +
+		getHashIndexSize());
+
+	size_t pageDataOffset = pageAlign(m_header.pageTableOffset +
+		totalPages * sizeof(CompressedPageEntry));
+
+	PageEntryVector pageTable;
+	ByteVector      compressed;
+
+	pageTable.reserve(totalPages);
+
+	compressSection(pageTable, compressed, pageDataOffset,
+		m_data.data(), m_data.size(), m_header.dataPages);
+	compressSection(pageTable, compressed, pageDataOffset,
+		(const char*)m_instructions.data(), getInstructionStreamSize(),
+		m_header.codePages);
+	compressSection(pageTable, compressed, pageDataOffset,
+		m_stringTable.data(), m_stringTable.size(), m_header.stringPages);
+
+	image.resize(pageDataOffset + compressed.size());
+
+	std::memcpy(image.data() + getHeaderOffset(), &m_header,
+		sizeof(BinaryHeader));
+	std::memcpy(image.data() + getSymbolTableOffset(), m_symbolTable.data(),
+		getSymbolTableSize());
+	std::memcpy(image.data() + m_header.hashOffset, m_hashIndex.data(),
+		getHashIndexSize());
+	std::memcpy(image.data() + m_header.pageTableOffset, pageTable.data(),
+		totalPages * sizeof(CompressedPageEntry));
+	std::memcpy(image.data() + pageDataOffset, compressed.data(),
+		compressed.size());
+
+	report(" compressed " << totalPages * BinaryHeader::PageSize
+		<< " section bytes down to " << compressed.size());
+}
+
 void BinaryWriter::populateData()
 {
 	report(" Adding global variables...");
 
+	// phase one, serial: fix every global's data extent and symbol
+	typedef std::pair<const ir::Global*, size_t> GlobalPlacement;
+
+	std::vector<GlobalPlacement> placements;
+
+	size_t offset = m_data.size();
+
 	for(ir::Module::const_global_iterator i = m_module->global_begin();
 		i != m_module->global_end(); ++i)
 	{
-		addGlobal(*i);
+		report("  " << i->name());
+
+		addSymbol(SymbolTableEntry::VariableType, i->linkage(),
+			i->visibility(), i->level(), i->name(), offset,
+			i->bytes(), i->type().name);
+
+		placements.push_back(std::make_pair(&*i, offset));
+
+		offset += i->bytes();
 	}
+
+	// zero filled, globals without initializers need no copy at all
+	m_data.resize(offset, 0);
+
+	// phase two, parallel: every extent is fixed, the initializers copy
+	// concurrently into disjoint slices.  Array data moves with a single
+	// memcpy from its packed storage, so bulk tables are emitted at
+	// memory bandwidth instead of serializer speed
+	util::Executor::instance().parallelFor(placements.size(),
+		[&](size_t index)
+	{
+		auto global = placements[index].first;
+
+		if(!global->hasInitializer()) return;
+
+		auto destination = m_data.data() + placements[index].second;
+
+		size_t bytes = global->bytes();
+
+		auto array = dynamic_cast<const ir::ArrayConstant*>(
+			global->initializer());
+
+		if(array != nullptr)
+		{
+			std::memcpy(destination, array->storage(), bytes);
+		}
+		else
+		{
+			auto blob = global->initializer()->data();
+
+			if(blob.size() < bytes) bytes = blob.size();
+
+			std::memcpy(destination, blob.data(), bytes);
+		}
+	});
 }
 
 static std::string flattenAttributes(const ir::Function& function)
@@ -116,6 +578,83 @@ static std::string flattenAttributes(const ir::Function& function)
 	return list.str();
 }
 
+void BinaryWriter::reserveSections()
+{
+	size_t instructions = 0;
+	size_t symbols      = 0;
+	size_t strings      = 0;
+	size_t data         = 0;
+
+	for(auto global = m_module->global_begin();
+		global != m_module->global_end(); ++global)
+	{
+		symbols += 1;
+		strings += global->name().size() + global->type().name.size() + 3;
+		data    += global->bytes();
+	}
+
+	for(auto function = m_module->begin();
+		function != m_module->end(); ++function)
+	{
+		symbols += 1;
+		strings += function->name().size() + function->type().name.size() +
+			flattenAttributes(*function).size() + 3;
+
+		for(auto argument = function->argument_begin();
+			argument != function->argument_end(); ++argument)
+		{
+			symbols += 1;
+			strings += argument->mangledName().size() +
+				argument->type().name.size() + 3;
+			data    += argument->type().bytes();
+		}
+
+		for(auto local = function->local_begin();
+			local != function->local_end(); ++local)
+		{
+			symbols += 1;
+			strings += local->name().size() + local->type().name.size() + 3;
+			data    += local->bytes();
+		}
+
+		for(auto bb = function->begin(); bb != function->end(); ++bb)
+		{
+			instructions += bb->size();
+
+			// every block gains a symbol during layout
+			symbols += 1;
+			strings += bb->name().size() + bb->type().name.size() + 3;
+
+			for(auto inst = bb->begin(); inst != bb->end(); ++inst)
+			{
+				if((*inst)->opcode == ir::Instruction::Call)
+				{
+					auto& call = static_cast<const ir::Call&>(**inst);
+
+					data += sizeof(OperandContainer) *
+						(call.returned().size() + call.arguments().size() + 1);
+				}
+				else if((*inst)->opcode == ir::Instruction::Phi)
+				{
+					auto& phi = static_cast<const ir::Phi&>(**inst);
+
+					data += sizeof(OperandContainer) *
+						(2 * phi.sources().size() + 1);
+				}
+			}
+		}
+	}
+
+	report(" reserving space for " << instructions << " instructions, "
+		<< symbols << " symbols, " << strings << " string bytes, and "
+		<< data << " data bytes");
+
+	m_instructions.reserve(instructions);
+	m_symbolTable.reserve(symbols);
+	m_stringTable.reserve(strings);
+	m_data.reserve(data);
+}
+
 void BinaryWriter::populateInstructions()
 {
 	report(" Adding function symbols.");
@@ -128,12 +667,23 @@ void BinaryWriter::populateInstructions()
 			0, 0, function->type().name, flattenAttributes(*function));
 	}
 	
-	report(" Adding functions.");
+	// phase one, serial: lay out every function so its instruction and
+	// operand data extents are fixed and the symbol and string tables
+	// are final before any encoding starts
+	typedef std::vector<EncodingContext>     ContextVector;
+	typedef std::vector<const ir::Function*> FunctionVector;
+
+	ContextVector  contexts;
+	FunctionVector functions;
+
+	size_t instructionOffset = 0;
+
+	report(" Laying out functions.");
 	for(ir::Module::const_iterator function = m_module->begin();
 		function != m_module->end(); ++function)
 	{
 		report("  " << function->name());
-	
+
 		// Arguments
 		for(auto argument = function->argument_begin();
 			argument != function->argument_end(); ++argument)
@@ -150,37 +700,133 @@ void BinaryWriter::populateInstructions()
 		{
 			addGlobal(*local);
 		}
-		
-		// Instructions
-		unsigned int instructionsBegin =
-			m_instructions.size() * sizeof(InstructionContainer);
-		unsigned int instructionOffset = m_instructions.size();	
+
+		contexts.push_back(EncodingContext());
+		functions.push_back(&*function);
+
+		EncodingContext& context = contexts.back();
+
+		context.instructionBegin = instructionOffset;
+
+		// Basic blocks get their symbols up front, encoding only reads
 		for(auto bb = function->begin(); bb != function->end(); ++bb)
 		{
-			m_basicBlockOffsets.insert(std::make_pair(bb->name(),
-				instructionOffset * sizeof(InstructionContainer)));
+			uint64_t codeOffset =
+				instructionOffset * sizeof(InstructionContainer);
+
+			context.blockOffsets.insert(
+				std::make_pair(bb->name(), codeOffset));
+			context.blockSymbols.insert(std::make_pair(codeOffset,
+				m_symbolTable.size() * sizeof(SymbolTableEntry) +
+				getSymbolTableOffset()));
+
+			addSymbol(SymbolTableEntry::BasicBlockType, 0x0, 0x0,
+				ir::Global::InvalidLevel, bb->name(), codeOffset, 0,
+				bb->type().name);
 
 			instructionOffset += bb->size();
 		}
 
-		unsigned int instructionsSize =
+		size_t instructionsBegin =
+			context.instructionBegin * sizeof(InstructionContainer);
+
+		patchSymbol(function->name(), instructionsBegin,
 			instructionOffset * sizeof(InstructionContainer)
-			- instructionsBegin;
-	
-		for(auto bb = function->begin(); bb != function->end(); ++bb)
+			- instructionsBegin);
+
+		// every block offset is fixed now, record where the function's
+		// divergent branches reconverge
+		addReconvergencePoints(*function, context);
+	}
+
+	// the functions and their blocks lay out in ascending PC order, so
+	// the pairs come out already sorted by branch PC for the simulator's
+	// binary search
+	flushReconvergenceTable();
+
+	// operand data lands after the argument and local data
+	size_t dataCursor = m_data.size();
+
+	for(size_t i = 0; i < functions.size(); ++i)
+	{
+		contexts[i].dataBegin = dataCursor;
+
+		dataCursor += getOperandDataSize(*functions[i], dataCursor);
+	}
+
+	// phase two, parallel: every extent is fixed, the functions encode
+	// concurrently into disjoint slices
+	report(" Encoding functions.");
+
+	m_instructions.resize(instructionOffset);
+
+	util::Executor::instance().parallelFor(functions.size(),
+		[&](size_t index)
+	{
+		encodeFunction(*functions[index], contexts[index]);
+	});
+
+	// phase three, serial: merge the operand data buffers, each lands
+	// exactly at the offset phase one promised it
+	for(size_t i = 0; i < functions.size(); ++i)
+	{
+		assert(m_data.size() == contexts[i].dataBegin);
+
+		m_data.insert(m_data.end(),
+			contexts[i].data.begin(), contexts[i].data.end());
+	}
+
+	assert(m_data.size() == dataCursor);
+}
+
+void BinaryWriter::encodeFunction(const ir::Function& function,
+	EncodingContext& context)
+{
+	size_t offset = context.instructionBegin;
+
+	for(auto bb = function.begin(); bb != function.end(); ++bb)
+	{
+		report("   Basic Block " << bb->name());
+		for(auto inst = bb->begin(); inst != bb->end(); ++inst)
 		{
-			report("   Basic Block " << bb->name());
-			for(auto inst = bb->begin(); inst != bb->end(); ++inst)
+			m_instructions[offset++] = convertToContainer(**inst, context);
+		}
+	}
+}
+
+size_t BinaryWriter::getOperandDataSize(const ir::Function& function,
+	size_t begin) const
+{
+	// mirrors the appends of convertCallInstruction and
+	// convertPhiInstruction without encoding anything
+	size_t cursor = begin;
+
+	for(auto bb = function.begin(); bb != function.end(); ++bb)
+	{
+		for(auto inst = bb->begin(); inst != bb->end(); ++inst)
+		{
+			if((*inst)->opcode == ir::Instruction::Call)
 			{
-				m_instructions.push_back(convertToContainer(**inst));
+				auto& call = static_cast<const ir::Call&>(**inst);
+
+				cursor = align(cursor, sizeof(OperandContainer));
+
+				cursor += sizeof(OperandContainer) *
+					(call.returned().size() + call.arguments().size());
 			}
-		}
+			else if((*inst)->opcode == ir::Instruction::Phi)
+			{
+				auto& phi = static_cast<const ir::Phi&>(**inst);
 
-		patchSymbol(function->name(), instructionsBegin, instructionsSize);
+				cursor = align(cursor, sizeof(OperandContainer));
 
-		m_basicBlockOffsets.clear();
-		m_basicBlockSymbols.clear();
+				cursor += sizeof(OperandContainer) *
+					(phi.sources().size() + phi.blocks().size());
+			}
+		}
 	}
+
+	return cursor - begin;
 }
 
 void BinaryWriter::linkSymbols()
@@ -201,19 +847,60 @@ void BinaryWriter::linkSymbols()
 	}
 }
 
+void BinaryWriter::populateHashIndex()
+{
+	// at least one page of slots and at most half full, probes stay short
+	size_t slots = PageSize / sizeof(SymbolHashEntry);
+
+	while(slots < 2 * m_symbolTable.size()) slots *= 2;
+
+	SymbolHashEntry empty;
+
+	empty.hash   = 0;
+	empty.symbol = SymbolHashEntry::InvalidSymbol;
+
+	m_hashIndex.assign(slots, empty);
+
+	for(size_t i = 0; i != m_symbolTable.size(); ++i)
+	{
+		uint32_t hash = hashSymbolName(
+			&m_stringTable[m_symbolTable[i].stringOffset]);
+
+		size_t slot = hash & (slots - 1);
+
+		while(m_hashIndex[slot].symbol != SymbolHashEntry::InvalidSymbol)
+		{
+			slot = (slot + 1) & (slots - 1);
+		}
+
+		m_hashIndex[slot].hash   = hash;
+		m_hashIndex[slot].symbol = i;
+	}
+
+	report(" built a hash index with " << slots << " slots for "
+		<< m_symbolTable.size() << " symbols");
+}
+
 void BinaryWriter::populateHeader()
 {
 	m_header.magic         = BinaryHeader::MagicNumber;
-	m_header.dataPages     = (m_data.size() + PageSize - 1) / PageSize; 
+	m_header.dataPages     = (m_data.size() + PageSize - 1) / PageSize;
 	m_header.codePages     =
 		((m_instructions.size() * sizeof(InstructionContainer)) + PageSize - 1)
 		/ PageSize;
-	m_header.symbols       = m_symbolTable.size(); 
+	m_header.symbols       = m_symbolTable.size();
 	m_header.stringPages   = (m_stringTable.size() + PageSize - 1) / PageSize;
 	m_header.dataOffset    = getDataOffset();
 	m_header.codeOffset    = getInstructionOffset();
 	m_header.symbolOffset  = getSymbolTableOffset();
 	m_header.stringsOffset = getStringTableOffset();
+	m_header.hashPages     = (getHashIndexSize() + PageSize - 1) / PageSize;
+	m_header.hashSlots     = m_hashIndex.size();
+	m_header.hashOffset    = getHashIndexOffset();
+
+	// writeCompressed overrides these when compression is requested
+	m_header.flags           = 0;
+	m_header.pageTableOffset = 0;
 }
 
 size_t BinaryWriter::getHeaderOffset() const
@@ -261,6 +948,16 @@ size_t BinaryWriter::getStringTableSize() const
 	return m_stringTable.size();
 }
 
+size_t BinaryWriter::getHashIndexOffset() const
+{
+	return pageAlign(getStringTableSize() + getStringTableOffset());
+}
+
+size_t BinaryWriter::getHashIndexSize() const
+{
+	return m_hashIndex.size() * sizeof(SymbolHashEntry);
+}
+
 static Instruction::Opcode convertOpcode(
 	ir::Instruction::Opcode opcode)
 {
@@ -391,7 +1088,7 @@ static PredicateOperand::PredicateModifier convertPredicate(
 }
 
 OperandContainer BinaryWriter::convertOperand(
-	const ir::Operand& operand)
+	const ir::Operand& operand, EncodingContext& context)
 {
 	OperandContainer result;
 
@@ -469,7 +1166,8 @@ OperandContainer BinaryWriter::convertOperand(
 		if(address.globalValue->type().isBasicBlock())
 		{
 			result.asSymbol.symbolTableOffset =
-				getBasicBlockSymbolTableOffset(address.globalValue);
+				getBasicBlockSymbolTableOffset(address.globalValue,
+					context);
 		}
 		else
 		{
@@ -516,33 +1214,33 @@ static bool isComplexInstruction(const ir::Instruction& instruction)
 
 void BinaryWriter::convertComplexInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	switch(instruction.opcode)
 	{
 	case ir::Instruction::Bra:
 	{
-		convertBraInstruction(container, instruction);
+		convertBraInstruction(container, instruction, context);
 		break;
 	}
 	case ir::Instruction::Call:
 	{
-		convertCallInstruction(container, instruction);
+		convertCallInstruction(container, instruction, context);
 		break;
 	}
 	case ir::Instruction::St:
 	{
-		convertStInstruction(container, instruction);
+		convertStInstruction(container, instruction, context);
 		break;
 	}
 	case ir::Instruction::Ret:
 	{
-		convertRetInstruction(container, instruction);
+		convertRetInstruction(container, instruction, context);
 		break;
 	}
 	case ir::Instruction::Phi:
 	{
-		convertPhiInstruction(container, instruction);
+		convertPhiInstruction(container, instruction, context);
 		break;
 	}
 	default: assertM(false, "Translation for "
@@ -552,25 +1250,25 @@ void BinaryWriter::convertComplexInstruction(
 
 void BinaryWriter::convertUnaryInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::UnaryInstruction& unary =
 		static_cast<const ir::UnaryInstruction&>(instruction);
 
-	container.asUnaryInstruction.d = convertOperand(*unary.d());
-	container.asUnaryInstruction.a = convertOperand(*unary.a());
+	container.asUnaryInstruction.d = convertOperand(*unary.d(), context);
+	container.asUnaryInstruction.a = convertOperand(*unary.a(), context);
 }
 
 void BinaryWriter::convertBinaryInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::BinaryInstruction& binary =
 		static_cast<const ir::BinaryInstruction&>(instruction);
 
-	container.asBinaryInstruction.d = convertOperand(*binary.d());
-	container.asBinaryInstruction.a = convertOperand(*binary.a());
-	container.asBinaryInstruction.b = convertOperand(*binary.b());
+	container.asBinaryInstruction.d = convertOperand(*binary.d(), context);
+	container.asBinaryInstruction.a = convertOperand(*binary.a(), context);
+	container.asBinaryInstruction.b = convertOperand(*binary.b(), context);
 }
 
 static ComparisonInstruction::Comparison convertComparison(
@@ -645,21 +1343,24 @@ static ComparisonInstruction::Comparison convertComparison(
 
 void BinaryWriter::convertComparisonInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::ComparisonInstruction& comparison =
 		static_cast<const ir::ComparisonInstruction&>(instruction);
 
-	container.asComparisonInstruction.d = convertOperand(*comparison.d());
-	container.asComparisonInstruction.a = convertOperand(*comparison.a());
-	container.asComparisonInstruction.b = convertOperand(*comparison.b());
+	container.asComparisonInstruction.d =
+		convertOperand(*comparison.d(), context);
+	container.asComparisonInstruction.a =
+		convertOperand(*comparison.a(), context);
+	container.asComparisonInstruction.b =
+		convertOperand(*comparison.b(), context);
 	
 	container.asComparisonInstruction.comparison =
 		convertComparison(comparison.comparison);
 }
 
 InstructionContainer BinaryWriter::convertToContainer(
-	const Instruction& instruction)
+	const Instruction& instruction, EncodingContext& context)
 {
 	report("    " << instruction.toString());
 
@@ -667,23 +1368,23 @@ InstructionContainer BinaryWriter::convertToContainer(
 
 	container.asInstruction.opcode = convertOpcode(instruction.opcode);
 	container.asInstruction.guard  =
-		convertOperand(*instruction.guard()).asPredicate;
+		convertOperand(*instruction.guard(), context).asPredicate;
 
 	if(isComplexInstruction(instruction))
 	{
-		convertComplexInstruction(container, instruction);
+		convertComplexInstruction(container, instruction, context);
 	}
 	else if(instruction.isComparison())
 	{
-		convertComparisonInstruction(container, instruction);
+		convertComparisonInstruction(container, instruction, context);
 	}
 	else if(instruction.isUnary())
 	{
-		convertUnaryInstruction(container, instruction);
+		convertUnaryInstruction(container, instruction, context);
 	}
 	else if(instruction.isBinary())
 	{
-		convertBinaryInstruction(container, instruction);
+		convertBinaryInstruction(container, instruction, context);
 	}
 	else
 	{
@@ -704,25 +1405,15 @@ size_t BinaryWriter::getSymbolTableOffset(const ir::Variable* g)
 	return getSymbolTableOffset(g->name());
 }
 
-size_t BinaryWriter::getBasicBlockSymbolTableOffset(const ir::Variable* g)
+size_t BinaryWriter::getBasicBlockSymbolTableOffset(const ir::Variable* g,
+	EncodingContext& context)
 {
-	auto offset = m_basicBlockOffsets.find(g->name());
-	assert(offset != m_basicBlockOffsets.end());
-
-	auto symbol = m_basicBlockSymbols.find(offset->second);
-	
-	if(symbol == m_basicBlockSymbols.end())
-	{
-		uint64_t symbolOffset = m_symbolTable.size() *
-			sizeof(SymbolTableEntry) + getSymbolTableOffset();
+	// the layout phase already gave every block a symbol
+	auto offset = context.blockOffsets.find(g->name());
+	assert(offset != context.blockOffsets.end());
 
-		symbol = m_basicBlockSymbols.insert(std::make_pair(
-			offset->second, symbolOffset)).first;
-
-		addSymbol(SymbolTableEntry::BasicBlockType, 0x0, 0x0,
-			ir::Global::InvalidLevel, g->name(), offset->second, 0,
-			g->type().name);
-	}
+	auto symbol = context.blockSymbols.find(offset->second);
+	assert(symbol != context.blockSymbols.end());
 
 	return symbol->second;
 }
@@ -771,31 +1462,53 @@ void BinaryWriter::addSymbol(unsigned int type, unsigned int linkage,
 	symbol.attributes.linkage    = linkage;
 	symbol.attributes.visibility = visibility;
 	symbol.attributes.level      = level;
-	symbol.stringOffset          = m_stringTable.size();
+	symbol.stringOffset          = addString(name);
 	symbol.offset                = offset;
 	symbol.size                  = size;
 
-	std::copy(name.begin(), name.end(), std::back_inserter(m_stringTable));
-	m_stringTable.push_back('\0');
-	
 	//	Add the type name string
-	symbol.typeOffset = m_stringTable.size();
-		
-	std::copy(typeName.begin(), typeName.end(),
-		std::back_inserter(m_stringTable));
-	m_stringTable.push_back('\0');
-	
+	symbol.typeOffset = addString(typeName);
+
 	// Add the attribute name string
-	symbol.attributeOffset = m_stringTable.size();
-		
-	std::copy(attributeList.begin(), attributeList.end(),
-		std::back_inserter(m_stringTable));
-	m_stringTable.push_back('\0');
+	symbol.attributeOffset = addString(attributeList);
 
 	// Add the symbol
 	m_symbolTable.push_back(symbol);
 }
 
+size_t BinaryWriter::addString(const std::string& string)
+{
+	// hash consing, a string already in the table (possibly as the tail
+	// of a longer one) is reused rather than copied, our generated
+	// kernel names overlap heavily and the savings are substantial
+	auto existing = m_stringOffsets.find(string);
+
+	if(existing != m_stringOffsets.end())
+	{
+		report("    string '" << string << "' shares the bytes at offset "
+			<< existing->second);
+
+		return existing->second;
+	}
+
+	size_t offset = m_stringTable.size();
+
+	std::copy(string.begin(), string.end(),
+		std::back_inserter(m_stringTable));
+	m_stringTable.push_back('\0');
+
+	// tail merging, every suffix runs into the same terminator, so a
+	// later string that matches one can point into the middle of this
+	// entry and still read back correctly
+	for(size_t begin = 0; begin <= string.size(); ++begin)
+	{
+		m_stringOffsets.insert(
+			std::make_pair(string.substr(begin), offset + begin));
+	}
+
+	return offset;
+}
+
 void BinaryWriter::addGlobal(const ir::Global& global)
 {
 	ir::Constant::DataVector blob;
@@ -819,6 +1532,79 @@ void BinaryWriter::addGlobal(const ir::Global& global)
 	std::copy(blob.begin(), blob.end(), std::back_inserter(m_data));
 }
 
+void BinaryWriter::addReconvergencePoints(const ir::Function& function,
+	EncodingContext& context)
+{
+	// the analyses only read the function
+	ir::Function& mutableFunction = const_cast<ir::Function&>(function);
+
+	analysis::AnalysisFactory::AnalysisMap analyses;
+
+	auto postDominators = static_cast<analysis::PostDominatorAnalysis*>(
+		analysis::AnalysisFactory::createAnalysisForFunction(
+			"PostDominatorAnalysis", mutableFunction, analyses));
+	auto cfg = static_cast<analysis::ControlFlowGraph*>(
+		analysis::AnalysisFactory::createAnalysisForFunction(
+			"ControlFlowGraph", mutableFunction, analyses));
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		if(block->size() == 0) continue;
+
+		// only a block with multiple successors ends in a branch that
+		// can split a warp
+		if(cfg->getSuccessors(*block).size() < 2) continue;
+
+		auto postDominator = postDominators->getPostDominator(*block);
+
+		// a branch that never rejoins, e.g. every side exits
+		if(postDominator == nullptr) continue;
+
+		auto branchOffset = context.blockOffsets.find(block->name());
+		auto reconvergeOffset =
+			context.blockOffsets.find(postDominator->name());
+
+		assert(branchOffset      != context.blockOffsets.end());
+		assert(reconvergeOffset  != context.blockOffsets.end());
+
+		// the branch is the last instruction of its block
+		uint64_t branchPC =
+			branchOffset->second / sizeof(InstructionContainer)
+			+ block->size() - 1;
+		uint64_t reconvergePC =
+			reconvergeOffset->second / sizeof(InstructionContainer);
+
+		report("   branch at pc " << branchPC << " ("
+			<< block->name() << ") reconverges at pc " << reconvergePC
+			<< " (" << postDominator->name() << ")");
+
+		m_reconvergenceTable.push_back(branchPC);
+		m_reconvergenceTable.push_back(reconvergePC);
+	}
+
+	for(auto& analysis : analyses) delete analysis.second;
+}
+
+void BinaryWriter::flushReconvergenceTable()
+{
+	if(m_reconvergenceTable.empty()) return;
+
+	report(" Adding reconvergence point table with "
+		<< (m_reconvergenceTable.size() / 2) << " entries.");
+
+	addSymbol(SymbolTableEntry::VariableType, 0x0, 0x0,
+		ir::Global::InvalidLevel, "_Zreconvergence_point_table",
+		m_data.size(), m_reconvergenceTable.size() * sizeof(uint64_t),
+		"i64");
+
+	const char* tableBegin = reinterpret_cast<const char*>(
+		m_reconvergenceTable.data());
+
+	std::copy(tableBegin,
+		tableBegin + m_reconvergenceTable.size() * sizeof(uint64_t),
+		std::back_inserter(m_data));
+}
+
 void BinaryWriter::patchSymbol(const std::string& name,
 	uint64_t offset, uint64_t size)
 {
@@ -831,31 +1617,32 @@ void BinaryWriter::patchSymbol(const std::string& name,
 	symbol->size   = size;
 }
 
-void BinaryWriter::alignData(uint64_t alignment)
+void BinaryWriter::alignData(EncodingContext& context, uint64_t alignment)
 {
-	uint64_t newSize = align(m_data.size(), alignment);
+	// alignment is against the final data section position
+	uint64_t newSize =
+		align(context.dataBegin + context.data.size(), alignment);
 
-	m_data.resize(newSize);
+	context.data.resize(newSize - context.dataBegin);
 }
 
 void BinaryWriter::convertStInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::St& st = static_cast<const ir::St&>(instruction);
 
-	container.asSt.d = convertOperand(*st.d());
-	container.asSt.a = convertOperand(*st.a());
+	container.asSt.d = convertOperand(*st.d(), context);
+	container.asSt.a = convertOperand(*st.a(), context);
 }
 
 void BinaryWriter::convertBraInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::Bra& bra = static_cast<const ir::Bra&>(instruction);
 
-	container.asBra.target = convertOperand(*bra.target());
-	container.asBra.target = convertOperand(*bra.target());
+	container.asBra.target = convertOperand(*bra.target(), context);
 	
 	switch(bra.modifier)
 	{
@@ -879,37 +1666,40 @@ void BinaryWriter::convertBraInstruction(
 
 void BinaryWriter::convertCallInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::Call& call = static_cast<const ir::Call&>(instruction);
 
-	container.asCall.target = convertOperand(*call.target());
-	
-	alignData(sizeof(OperandContainer));
-	
+	container.asCall.target = convertOperand(*call.target(), context);
+
+	alignData(context, sizeof(OperandContainer));
+
 	auto returnArguments = call.returned();
-	
+
 	container.asCall.returnArguments      = returnArguments.size();
-	container.asCall.returnArgumentOffset = m_data.size();
-	
+	container.asCall.returnArgumentOffset =
+		context.dataBegin + context.data.size();
+
 	for(auto operand : returnArguments)
 	{
-		addOperandToDataSection(convertOperand(*operand));
+		addOperandToDataSection(convertOperand(*operand, context), context);
 	}
-	
+
 	auto arguments = call.arguments();
-	
+
 	container.asCall.arguments      = arguments.size();
-	container.asCall.argumentOffset = m_data.size();
-	
+	container.asCall.argumentOffset =
+		context.dataBegin + context.data.size();
+
 	for(auto operand : arguments)
 	{
-		addOperandToDataSection(convertOperand(*operand));
+		addOperandToDataSection(convertOperand(*operand, context), context);
 	}
 }
 
 void BinaryWriter::convertRetInstruction(
-	InstructionContainer& container, const ir::Instruction& instruction)
+	InstructionContainer& container, const ir::Instruction& instruction,
+	EncodingContext& context)
 {
 	// Currently a NOP
 	// TODO: fix this
@@ -917,38 +1707,41 @@ void BinaryWriter::convertRetInstruction(
 
 void BinaryWriter::convertPhiInstruction(
 	InstructionContainer& container,
-	const ir::Instruction& instruction)
+	const ir::Instruction& instruction, EncodingContext& context)
 {
 	const ir::Phi& phi = static_cast<const ir::Phi&>(instruction);
 
-	container.asPhi.destination = convertOperand(*phi.d());
-	
-	alignData(sizeof(OperandContainer));
-	
+	container.asPhi.destination = convertOperand(*phi.d(), context);
+
+	alignData(context, sizeof(OperandContainer));
+
 	auto sources = phi.sources();
 	auto blocks  = phi.blocks();
-	
+
 	container.asPhi.sources       = sources.size();
-	container.asPhi.sourcesOffset = m_data.size();
-	
+	container.asPhi.sourcesOffset =
+		context.dataBegin + context.data.size();
+
 	for(auto source : sources)
 	{
-		addOperandToDataSection(convertOperand(*source));
+		addOperandToDataSection(convertOperand(*source, context), context);
 	}
-	
+
 	for(auto block : blocks)
 	{
 		addOperandToDataSection(convertOperand(
-			ir::AddressOperand(const_cast<ir::BasicBlock*>(block), nullptr)));
+			ir::AddressOperand(const_cast<ir::BasicBlock*>(block), nullptr),
+			context), context);
 	}
 }
 
-void BinaryWriter::addOperandToDataSection(const OperandContainer& operand)
+void BinaryWriter::addOperandToDataSection(const OperandContainer& operand,
+	EncodingContext& context)
 {
 	const char* begin = reinterpret_cast<const char*>(&operand);
 	const char* end   = begin + sizeof(OperandContainer);
-	
-	std::copy(begin, end, std::back_inserter(m_data));
+
+	std::copy(begin, end, std::back_inserter(context.data));
 }
 
 uint64_t BinaryWriter::align(uint64_t address, uint64_t alignment)
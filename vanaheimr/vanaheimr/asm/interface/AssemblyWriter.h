@@ -10,6 +10,8 @@
 #include <ostream>
 
 // Forward Declarations
+namespace vanaheimr{ namespace util { class StringBuffer;  } }
+
 namespace vanaheimr{ namespace ir { class Module;          } }
 namespace vanaheimr{ namespace ir { class Function;        } }
 namespace vanaheimr{ namespace ir { class Global;          } }
@@ -34,23 +36,25 @@ public:
 	AssemblyWriter();
 
 public:
+	/*! \brief Formatting is batched through an internal character buffer,
+		the stream is only written in large flushes */
 	void write(std::ostream& stream, const ir::Module& m);
 
 private:
-	void writeFunction(std::ostream& stream, const ir::Function& f);
-	void writeGlobal(std::ostream& stream, const ir::Global& g);
+	void writeFunction(util::StringBuffer& buffer, const ir::Function& f);
+	void writeGlobal(util::StringBuffer& buffer, const ir::Global& g);
+
+	void writeLinkage(util::StringBuffer& buffer, const ir::Variable& v);
+	void writeArgument(util::StringBuffer& buffer, const ir::Argument& a);
+	void writeBasicBlock(util::StringBuffer& buffer, const ir::BasicBlock& b);
 
-	void writeLinkage(std::ostream& stream, const ir::Variable& v);
-	void writeArgument(std::ostream& stream, const ir::Argument& a);
-	void writeBasicBlock(std::ostream& stream, const ir::BasicBlock& b);
-	
-	void writeType(std::ostream& stream, const ir::Type& t);
-	void writeInitializer(std::ostream& stream, const ir::Constant& c);
+	void writeType(util::StringBuffer& buffer, const ir::Type& t);
+	void writeInitializer(util::StringBuffer& buffer, const ir::Constant& c);
 
-	void writeOpcode(std::ostream& stream, unsigned int opcode);
-	void writeOperand(std::ostream& stream, const ir::Operand& o);
+	void writeOpcode(util::StringBuffer& buffer, unsigned int opcode);
+	void writeOperand(util::StringBuffer& buffer, const ir::Operand& o);
 
-	void writeVirtualRegister(std::ostream& stream,
+	void writeVirtualRegister(util::StringBuffer& buffer,
 		const ir::VirtualRegister& v);
 };
 
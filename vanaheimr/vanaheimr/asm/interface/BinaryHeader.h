@@ -4,6 +4,8 @@
 	\brief  The header file for the specification of the header of the binary
 */
 
+#pragma once
+
 // Vanaheimr Includes
 #include <vanaheimr/util/interface/IntTypes.h>
 
@@ -21,6 +23,11 @@ public:
 	static const unsigned int PageSize    = (1 << 15); // 32 KB
 	static const uint64_t     MagicNumber = 0x2E5649527F454C46ULL;
 
+public:
+	/*! \brief The data, code, and string sections are stored compressed
+		behind a page table rather than raw at their section offsets */
+	static const uint32_t CompressedSections = 0x1;
+
 public:
 	uint64_t magic          : 64;
 	uint32_t dataPages      : 32;
@@ -32,8 +39,120 @@ public:
 	uint64_t symbolOffset   : 64;
 	uint64_t stringsOffset  : 64;
 	uint64_t nameOffset     : 64;
+	uint32_t hashPages      : 32;
+	uint64_t hashSlots      : 64;
+	uint64_t hashOffset     : 64;
+	uint32_t flags          : 32;
+	uint64_t pageTableOffset : 64;
+};
+
+/*! \brief One slot of the symbol name hash index section of the binary.
+
+	The index is open addressed with linear probing over a power of two
+	slot count.  A probe walks from the masked name hash until it finds a
+	slot with a matching name or an empty slot. */
+class SymbolHashEntry
+{
+public:
+	static const uint32_t InvalidSymbol = 0xffffffff;
+
+public:
+	uint32_t hash   : 32; // the full name hash, for fast rejection
+	uint32_t symbol : 32; // the symbol table index, InvalidSymbol when empty
 };
 
+/*! \brief One entry of the page table of a binary with compressed sections.
+
+	The table holds one entry per page of the data, code, and string
+	sections, in that order. */
+class CompressedPageEntry
+{
+public:
+	uint64_t offset : 64; // absolute file offset of the compressed page
+	uint32_t size   : 32; // compressed bytes, PageSize when stored raw
+	uint32_t unused : 32;
+};
+
+// callable from the host tools and from device code that reads binaries
+#ifdef __CUDACC__
+#define BINARY_FORMAT_DECORATOR __host__ __device__
+#else
+#define BINARY_FORMAT_DECORATOR
+#endif
+
+/*! \brief Hash a symbol name, must match the index emitted by the writer */
+BINARY_FORMAT_DECORATOR inline uint32_t hashSymbolName(const char* name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+
+	for(; *name != '\0'; ++name)
+	{
+		hash ^= (uint32_t)(unsigned char)*name;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/*! \brief Expand one compressed page, the output buffer holds a full page.
+
+	A compressed page is a stream of sequences.  Each sequence is a token
+	byte holding the literal count in the high nibble and the match length
+	minus four in the low nibble, a nibble of fifteen continues in extension
+	bytes that are summed until one is less than 255.  The literals follow
+	the lengths, then a two byte little endian offset back into the output
+	where the match is copied from.  The final sequence of a page has no
+	match, the stream simply ends after its literals. */
+BINARY_FORMAT_DECORATOR inline void decompressPage(
+	const unsigned char* compressed, uint32_t compressedSize, void* page)
+{
+	const unsigned char* in    = compressed;
+	const unsigned char* inEnd = compressed + compressedSize;
+	unsigned char*       out   = (unsigned char*)page;
+
+	while(in != inEnd)
+	{
+		unsigned int token = *in++;
+
+		unsigned int literals = token >> 4;
+
+		if(literals == 15)
+		{
+			unsigned int extension = 0;
+
+			do { extension = *in++; literals += extension; }
+			while(extension == 255);
+		}
+
+		for(; literals != 0; --literals) *out++ = *in++;
+
+		// the final sequence is literals only
+		if(in == inEnd) break;
+
+		unsigned int offset = in[0] | (in[1] << 8);
+
+		in += 2;
+
+		unsigned int match = (token & 0xf) + 4;
+
+		if((token & 0xf) == 15)
+		{
+			unsigned int extension = 0;
+
+			do { extension = *in++; match += extension; }
+			while(extension == 255);
+		}
+
+		// matches may overlap the output they copy from, go byte by byte
+		const unsigned char* source = out - offset;
+
+		for(; match != 0; --match) *out++ = *source++;
+	}
+}
+
+#undef BINARY_FORMAT_DECORATOR
+
 }
 
 }
@@ -15,6 +15,8 @@
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/Global.h>
 
+#include <vanaheimr/util/interface/InputBuffer.h>
+
 // Standard Library Includes
 #include <istream>
 #include <vector>
@@ -31,16 +33,34 @@ namespace as
 /*! \brief Reads in a vanaheimr bytecode file yielding a module. */
 class BinaryReader
 {
+public:
+	BinaryReader();
+
 public:
 	/*! \brief Attempts to read from a binary stream, returns a module */
 	ir::Module* read(std::istream& stream, const std::string& name);
 
+	/*! \brief Reads the named file through a memory mapping, the binary
+		sections are used in place without copying them */
+	ir::Module* read(const std::string& filename);
+
+	/*! \brief Reads only the named function from a mapped binary.  The
+		returned module holds every global and function symbol so that
+		references resolve, but only the requested function's
+		instructions are decoded */
+	ir::Module* readFunction(const std::string& filename,
+		const std::string& functionName);
+
+	/*! \brief Find a symbol by name, using the binary's hash index when
+		it has one, returns nullptr when no such symbol exists */
+	const SymbolTableEntry* findSymbol(const std::string& name) const;
+
 private:
 	typedef std::vector<InstructionContainer>       InstructionVector;
 	typedef std::vector<char>                       DataVector;
 	typedef std::vector<SymbolTableEntry>           SymbolVector;
 
-	typedef SymbolVector::iterator symbol_iterator;
+	typedef const SymbolTableEntry* symbol_iterator;
 
 	class BasicBlockDescriptor
 	{
@@ -62,12 +82,25 @@ private:
 	void _readStringTable(std::istream& stream);
 	void _readSymbolTable(std::istream& stream);
 	void _readInstructions(std::istream& stream);
+	void _readHashIndex(std::istream& stream);
+
+	/*! \brief Expand the compressed sections of a binary from a stream */
+	void _readCompressedSections(std::istream& stream);
+	void _readCompressedPage(std::istream& stream,
+		const CompressedPageEntry& entry, void* page);
+
+	/*! \brief Point the section views directly into the file mapping */
+	void _mapSections();
+
+	/*! \brief Expand the compressed sections of a mapped binary */
+	void _decompressSections();
 
 private:
 	void _loadTypes();
 	void _initializeModule(ir::Module& m);
 	void _loadGlobals(ir::Module& m);
 	void _loadFunctions(ir::Module& m);
+	void _loadFunction(ir::Module& m, const SymbolTableEntry& symbol);
 	
 private:
 	std::string              _getSymbolName(
@@ -121,10 +154,26 @@ private:
 private:
 	BinaryHeader _header;
 
-	InstructionVector _instructions;
-	DataVector        _dataSection;
-	DataVector        _stringTable;
-	SymbolVector      _symbolTable;
+	// the file mapping that backs the section views in mapped mode
+	util::InputBuffer _file;
+
+	// views of the binary sections, pointing either into the mapping or
+	// into the owned storage below
+	const InstructionContainer* _instructions;
+	size_t                      _instructionCount;
+	const char*                 _dataSection;
+	const char*                 _stringTable;
+	const SymbolTableEntry*     _symbolTable;
+	size_t                      _symbolCount;
+	const SymbolHashEntry*      _hashIndex;
+	uint64_t                    _hashSlots;
+
+	// owned copies of the sections, used only by the stream path
+	InstructionVector            _instructionStorage;
+	DataVector                   _dataStorage;
+	DataVector                   _stringStorage;
+	SymbolVector                 _symbolStorage;
+	std::vector<SymbolHashEntry> _hashStorage;
 
 private:
 	typedef std::unordered_map<RegisterType,
@@ -16,10 +16,12 @@
 // Standard Library Includes
 #include <vector>
 #include <unordered_map>
+#include <istream>
 #include <ostream>
 
 // Forward Declarations
 namespace vanaheimr { namespace ir { class Module;      } }
+namespace vanaheimr { namespace ir { class Function;    } }
 namespace vanaheimr { namespace ir { class Global;      } }
 namespace vanaheimr { namespace ir { class Instruction; } }
 namespace vanaheimr { namespace ir { class Operand;     } }
@@ -47,17 +49,74 @@ public:
 
 public:
 	BinaryWriter();
-	void write(std::ostream& binary, const ir::Module& inputModule);
+
+	/*! \brief Serialize a module, optionally compressing the data, code,
+		and string sections a page at a time */
+	void write(std::ostream& binary, const ir::Module& inputModule,
+		bool compress = false);
+
+	/*! \brief Serialize a module over an existing binary, rewriting only
+		the pages whose bytes changed.  Functions in front of an edit keep
+		their offsets, so a small change touches few pages */
+	void writeIncremental(std::iostream& binary,
+		const ir::Module& inputModule, bool compress = false);
+
+	/*! \brief Serialize a module one function at a time.
+
+		beginStreaming fixes the globals and function symbols,
+		streamFunction lays out and encodes one function and then drops
+		its body, and endStreaming finalizes the tables and writes the
+		sections.  Only the function being streamed needs to be
+		materialized, so peak memory stays near the largest single
+		function plus the encoded sections */
+	void beginStreaming(const ir::Module& inputModule);
+	void streamFunction(ir::Function& function);
+	void endStreaming(std::ostream& binary);
 
 private:
-	void writePage(std::ostream& binary, const void* data,
-		uint64_t size);
+	/*! \brief Size the sections up front so filling them never reallocates */
+	void reserveSections();
+
+	/*! \brief Serialize the module into a complete in-memory image */
+	void layoutImage(std::vector<char>& image, bool compress);
+
+	/*! \brief Lay out an image with compressed sections */
+	void layoutCompressedImage(std::vector<char>& image);
+
+	/*! \brief Fill the section buffers and header from the module */
+	void populateSections();
+
+	/*! \brief Per-function encoding state, declared below */
+	class EncodingContext;
+
+	/*! \brief Write the sections to the stream in file order with zero
+		padding between them, no monolithic image is staged */
+	void writeSections(std::ostream& binary);
 
 	void populateHeader();
+
+	/*! \brief Lay out and encode the functions.
+
+		A serial first phase fixes every function's instruction and
+		operand data extents and finalizes the symbol and string tables,
+		then the functions encode concurrently into disjoint slices and
+		their operand data buffers merge at the precomputed offsets */
 	void populateInstructions();
 	void populateData();
 	void linkSymbols();
 
+	/*! \brief Encode one function's instructions into its slice */
+	void encodeFunction(const ir::Function& function,
+		EncodingContext& context);
+
+	/*! \brief The operand data bytes call and phi instructions of the
+		function will append when encoding starts at the given offset */
+	size_t getOperandDataSize(const ir::Function& function,
+		size_t begin) const;
+
+	/*! \brief Build the open addressed symbol name hash index section */
+	void populateHashIndex();
+
 private:
 	size_t getHeaderOffset() const;
 	size_t getInstructionOffset() const;
@@ -69,23 +128,28 @@ private:
 	size_t getInstructionStreamSize() const;
 	size_t getDataSize() const;
 	size_t getStringTableSize() const;
+
+	size_t getHashIndexOffset() const;
+	size_t getHashIndexSize() const;
 	
 	void convertComplexInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertUnaryInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertBinaryInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertComparisonInstruction(InstructionContainer& container,
-		const Instruction& instruction);
-	
-	OperandContainer     convertOperand(const Operand&);
-	InstructionContainer convertToContainer(const Instruction&); 
+		const Instruction& instruction, EncodingContext& context);
+
+	OperandContainer     convertOperand(const Operand&, EncodingContext&);
+	InstructionContainer convertToContainer(const Instruction&,
+		EncodingContext&);
 
 	size_t getSymbolTableOffset(const ir::Argument* a);
 	size_t getSymbolTableOffset(const ir::Variable* g);
 	size_t getSymbolTableOffset(const std::string& name);
-	size_t getBasicBlockSymbolTableOffset(const ir::Variable* g);
+	size_t getBasicBlockSymbolTableOffset(const ir::Variable* g,
+		EncodingContext& context);
 	SymbolTableEntryVector::iterator getSymbol(const std::string& name);
 	
 	void addSymbol(unsigned int type, unsigned int linkage,
@@ -95,22 +159,40 @@ private:
 	void addGlobal(const ir::Global&);
 	void patchSymbol(const std::string& name, uint64_t offset, uint64_t size);
 
-	void alignData(uint64_t alignment);
+	/*! \brief Append a string to the string table, returning its offset.
+
+		Identical strings are stored once, and a string that is a suffix
+		of an already stored one shares its terminator instead of being
+		copied */
+	size_t addString(const std::string& string);
+
+	/*! \brief Record the reconvergence point of every potentially
+		divergent branch of a laid out function, the PC of its immediate
+		post-dominator.  The table is emitted as a data symbol the
+		simulator looks up by name */
+	void addReconvergencePoints(const ir::Function& function,
+		EncodingContext& context);
+
+	/*! \brief Emit the collected reconvergence pairs as a data symbol */
+	void flushReconvergenceTable();
+
+	void alignData(EncodingContext& context, uint64_t alignment);
 
 private:
 	void convertStInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertBraInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertCallInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertRetInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 	void convertPhiInstruction(InstructionContainer& container,
-		const Instruction& instruction);
+		const Instruction& instruction, EncodingContext& context);
 
 private:
-	void addOperandToDataSection(const OperandContainer& operand);
+	void addOperandToDataSection(const OperandContainer& operand,
+		EncodingContext& context);
 
 private:
 	static uint64_t align(uint64_t address, uint64_t alignment);
@@ -120,9 +202,28 @@ private:
 	typedef std::vector<InstructionContainer>         InstructionVector;
 	typedef std::vector<char>                         DataVector;
 	typedef std::vector<SymbolTableEntry>             SymbolVector;
+	typedef std::vector<SymbolHashEntry>              HashEntryVector;
 	typedef std::unordered_map<std::string, uint64_t> OffsetMap;
 	typedef std::unordered_map<uint64_t, uint64_t>    OffsetToSymbolMap;
 
+	/*! \brief The private state one function encodes with.
+
+		All extents are fixed before encoding starts, so concurrent
+		contexts never touch the shared sections */
+	class EncodingContext
+	{
+	public:
+		OffsetMap         blockOffsets; // block name -> code offset
+		OffsetToSymbolMap blockSymbols; // code offset -> symbol offset
+
+		/*! \brief Operand data, merged into the data section afterwards */
+		DataVector data;
+		/*! \brief The data section offset the buffer will land at */
+		size_t     dataBegin;
+		/*! \brief The function's first instruction slot */
+		size_t     instructionBegin;
+	};
+
 private:
 	const ir::Module*  m_module;
 	
@@ -131,10 +232,15 @@ private:
 	DataVector        m_data;
 	SymbolVector      m_symbolTable;
 	DataVector        m_stringTable;
+	HashEntryVector   m_hashIndex;
 
-private:
-	OffsetMap         m_basicBlockOffsets;
-	OffsetToSymbolMap m_basicBlockSymbols;
+	/*! \brief Every suffix of every stored string -> its table offset,
+		for hash consing and tail merging in addString */
+	OffsetMap         m_stringOffsets;
+
+	/*! \brief (branch PC, reconvergence PC) pairs in ascending branch PC
+		order, one per potentially divergent branch of the module */
+	std::vector<uint64_t> m_reconvergenceTable;
 };
 
 }
@@ -45,7 +45,19 @@ void ArchaeopteryxTarget::lower()
 
 	manager.addPass(selector);
 
-	// ABI Lowering	
+	// Peephole cleanup of selection output
+	auto peephole = transforms::PassFactory::createPass(
+		"MachinePeepholeOptimizationPass");
+
+	if(peephole == nullptr)
+	{
+		throw std::runtime_error("Failed to create archaeopteryx"
+			" peephole optimization pass.");
+	}
+
+	manager.addPass(peephole);
+
+	// ABI Lowering
 	auto abiLowering = transforms::PassFactory::createPass(
 		"EnforceArchaeopteryxABIPass");
 
@@ -90,7 +102,8 @@ void ArchaeopteryxTarget::lower()
 	
 	manager.addPass(spiller);
 
-	manager.addDependence(abiLowering->name, selector->name);
+	manager.addDependence(peephole->name,    selector->name);
+	manager.addDependence(abiLowering->name, peephole->name);
 	manager.addDependence(scheduler->name,   abiLowering->name);
 	manager.addDependence(allocator->name,   scheduler->name);
 	manager.addDependence(spiller->name,     allocator->name);
@@ -20,9 +20,10 @@
 #include <vanaheimr/ir/interface/VirtualRegister.h>
 
 #include <vanaheimr/util/interface/SmallSet.h>
+#include <vanaheimr/util/interface/Arena.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
 #include <algorithm>
@@ -105,185 +106,191 @@ const machine::PhysicalRegister*
 class RegisterInfo
 {
 public:
-	RegisterInfo(const ir::VirtualRegister* r, unsigned int d = 0,
-		unsigned int c = 0, unsigned int s = 0, bool f = false)
-	: virtualRegister(r), nodeDegree(d), color(c), schedulingOrder(s),
-		finished(f)
+	RegisterInfo(const ir::VirtualRegister* r, unsigned int d = 0)
+	: virtualRegister(r), nodeDegree(d), color(0), removed(false)
 	{
-	
+
 	}
 
 public:
 	const ir::VirtualRegister* virtualRegister;
 	unsigned int               nodeDegree;
 	unsigned int               color;
-	unsigned int               schedulingOrder;
-	bool                       finished;
+	bool                       removed;
 
 };
 
 typedef std::vector<RegisterInfo> RegisterInfoVector;
-	
-typedef util::SmallSet<unsigned int> ColorSet;
 typedef std::vector<unsigned int> ColorVector;
 
-static unsigned int randomColorThatDoesntCollide(ColorSet& usedColors,
-	unsigned int maxColor)
+/*! \brief A bucket queue over interference graph node degrees.
+
+	One intrusive worklist per degree, with nodes bump-allocated from an
+	arena.  A degree decrement pushes a fresh node at the new degree and
+	leaves the old one behind as stale, popMin filters stale nodes by
+	comparing against the current degree table, so both operations are
+	constant time and the whole simplify phase is linear in the number
+	of interference edges. */
+class DegreeBuckets
 {
-	ColorSet unusedColors;
-	
-	for(unsigned int i = 0; i < maxColor; ++i)
+public:
+	class Node
 	{
-		if(usedColors.count(i) != 0) continue;
-		
-		unusedColors.insert(i);
-	}
-	
-	ColorVector availableColors(unusedColors.begin(), unusedColors.end());
-	
-	return availableColors[std::rand() % availableColors.size()];
-}
+	public:
+		Node(unsigned int r, Node* n) : reg(r), next(n) {}
 
-static unsigned int computeColor(bool& finished, const RegisterInfo& reg,
-	const RegisterInfoVector& registerInfo,
-	const InterferenceAnalysis& interferences)
-{
-	ColorSet usedColors;
+	public:
+		unsigned int reg;
+		Node*        next;
 
-	// Fix the color after the scheduling order window has passed
-	if(reg.finished) return reg.color;
-	
-	auto regInterferences =
-		interferences.getInterferences(*reg.virtualRegister);
-	
-	finished = true;
-	
-	unsigned int predecessorCount = 0;
-	
-	for(auto interference : regInterferences)
+	};
+
+	typedef std::vector<Node*> BucketVector;
+
+public:
+	DegreeBuckets(util::Arena& arena, size_t maxDegree)
+	: _arena(arena), _buckets(maxDegree + 1, nullptr), _minDegree(0)
 	{
-		assert(interference->id < registerInfo.size());
-	
-		const RegisterInfo& info = registerInfo[interference->id];
 
-		if(info.schedulingOrder > reg.schedulingOrder) continue;
-	
-		++predecessorCount;
-	
-		finished &= info.finished;
-	
-		usedColors.insert(info.color);
 	}
-	
-	unsigned int spread = usedColors.size() + 1;
-	
-	// Define the range of possible colors [0 to usedRegisterCount]
-	if(finished && (usedColors.count(reg.color) != 0 || reg.color >= spread))
+
+public:
+	void push(unsigned int reg, unsigned int degree)
 	{
-		return randomColorThatDoesntCollide(usedColors, spread);
+		assert(degree < _buckets.size());
+
+		_buckets[degree] = _arena.construct<Node>(reg, _buckets[degree]);
+
+		_minDegree = std::min(_minDegree, (size_t)degree);
 	}
-	
-	// keep the original color if it doesn't collide
-	if(usedColors.count(reg.color) == 0)
+
+	/*! \brief Pop the live register with the lowest degree */
+	unsigned int popMin(const RegisterInfoVector& registers)
 	{
-		return reg.color;
-	}
-	
-	// Otherwise, assign a new register randomly in the possible window
-	unsigned int maxColor = predecessorCount + 1;
-	
-	return randomColorThatDoesntCollide(usedColors, maxColor);
-}
+		while(true)
+		{
+			while(_buckets[_minDegree] == nullptr)
+			{
+				assert(_minDegree + 1 < _buckets.size());
 
-static bool propagateColorsInParallel(RegisterInfoVector& registers,
-	unsigned int iteration, const InterferenceAnalysis& interferences)
-{
-	report("  -------------------- Iteration "
-		<< iteration << " ------------------");
+				++_minDegree;
+			}
 
-	RegisterInfoVector newRegisters;
-	
-	newRegisters.reserve(registers.size());
-	bool changed = false;
-	
-	for(auto reg = registers.begin(); reg != registers.end(); ++reg)
-	{
-		bool predecessorsFinished = true;
-		unsigned int newColor = computeColor(predecessorsFinished, *reg,
-			registers, interferences);
+			Node* node = _buckets[_minDegree];
 
-		newRegisters.push_back(RegisterInfo(reg->virtualRegister,
-			reg->nodeDegree, newColor, reg->schedulingOrder,
-			predecessorsFinished));
+			_buckets[_minDegree] = node->next;
 
-		changed |= reg->color != newColor;
+			const RegisterInfo& info = registers[node->reg];
 
-		reportE(reg->color != newColor,
-			"   vr" << reg->virtualRegister->id
-			<< " (degree " << reg->nodeDegree
-			<< ") | (color " << reg->color << ") -> (color " << newColor
-			<< ")");
+			// skip nodes made stale by removal or a degree decrement
+			if(info.removed || info.nodeDegree != _minDegree) continue;
+
+			return node->reg;
+		}
 	}
-	
-	registers = std::move(newRegisters);
-	
-	return changed;
-}
 
-static void initializeColors(RegisterInfoVector& registers,
+private:
+	util::Arena& _arena;
+	BucketVector _buckets;
+	size_t       _minDegree;
+
+};
+
+/*! \brief Remove registers from the graph in lowest degree first order.
+
+	Registers are pushed on the select stack even when their degree is
+	not below the color count, in the optimistic hope that their
+	neighbors end up sharing colors. */
+static void simplify(ColorVector& selectStack, RegisterInfoVector& registers,
 	const InterferenceAnalysis& interferences)
 {
-	// initialize the register randomly in the possible range
-	for(auto& reg : registers)
+	util::Arena arena;
+
+	DegreeBuckets buckets(arena, registers.size());
+
+	for(unsigned int reg = 0; reg != registers.size(); ++reg)
 	{
-		auto regInterferences =
-			interferences.getInterferences(*reg.virtualRegister);
-	
-		unsigned int predecessorCount = 0;
-	
+		buckets.push(reg, registers[reg].nodeDegree);
+	}
+
+	selectStack.reserve(registers.size());
+
+	while(selectStack.size() != registers.size())
+	{
+		unsigned int reg = buckets.popMin(registers);
+
+		report("  removing vr" << registers[reg].virtualRegister->id
+			<< " (degree " << registers[reg].nodeDegree << ")");
+
+		registers[reg].removed = true;
+
+		selectStack.push_back(reg);
+
+		auto regInterferences = interferences.getInterferences(
+			*registers[reg].virtualRegister);
+
 		for(auto interference : regInterferences)
 		{
 			assert(interference->id < registers.size());
-	
-			const RegisterInfo& info = registers[interference->id];
 
-			if(info.schedulingOrder > reg.schedulingOrder) continue;
-			
-			++predecessorCount;
+			RegisterInfo& neighbor = registers[interference->id];
+
+			if(neighbor.removed) continue;
+
+			buckets.push(interference->id, --neighbor.nodeDegree);
 		}
-		
-		unsigned int maxColor = predecessorCount + 1;
-	
-		reg.color = std::rand() % maxColor;
 	}
 }
 
-static void initializeSchedulingOrder(RegisterInfoVector& registerInfo)
+/*! \brief Color registers in reverse simplification order, spilling any
+	register whose neighbors exhaust the machine's colors */
+static void select(RegisterAllocator::VirtualRegisterSet& spilled,
+	const ColorVector& selectStack, RegisterInfoVector& registers,
+	const InterferenceAnalysis& interferences, unsigned int colors)
 {
-	typedef std::pair<unsigned int, RegisterInfo*> DegreeAndInfoPair;
-	typedef std::vector<DegreeAndInfoPair>         DegreeAndInfoVector;
-	
-	report(" Ranking registers by interference graph node degree");
-	
-	DegreeAndInfoVector degrees;
-	
-	degrees.reserve(registerInfo.size());
-	
-	for(auto info = registerInfo.begin(); info != registerInfo.end(); ++info)
-	{
-		degrees.push_back(std::make_pair(info->nodeDegree, &*info));
-	}
-	
-	// Sort by node degree (parallel)
-	std::sort(degrees.begin(), degrees.end(),
-		std::greater<DegreeAndInfoPair>());
+	std::vector<bool> usedColors(colors, false);
 
-	for(auto degree = degrees.begin(); degree != degrees.end(); ++degree)
+	for(auto reg = selectStack.rbegin(); reg != selectStack.rend(); ++reg)
 	{
-		report("  vr" << degree->second->virtualRegister->id
-			<< " (" << degree->first << ")");
-		degree->second->schedulingOrder =
-			std::distance(degrees.begin(), degree);
+		RegisterInfo& info = registers[*reg];
+
+		usedColors.assign(colors, false);
+
+		auto regInterferences = interferences.getInterferences(
+			*info.virtualRegister);
+
+		for(auto interference : regInterferences)
+		{
+			const RegisterInfo& neighbor = registers[interference->id];
+
+			if(neighbor.removed) continue;
+
+			if(neighbor.color < colors) usedColors[neighbor.color] = true;
+		}
+
+		unsigned int color = 0;
+
+		for(; color != colors; ++color)
+		{
+			if(!usedColors[color]) break;
+		}
+
+		if(color == colors)
+		{
+			report("  spilling vr" << info.virtualRegister->id
+				<< ", all " << colors << " colors are live around it");
+
+			spilled.insert(const_cast<ir::VirtualRegister*>(
+				info.virtualRegister));
+
+			continue;
+		}
+
+		info.color   = color;
+		info.removed = false;
+
+		report("  vr" << info.virtualRegister->id
+			<< " -> (color " << color << ")");
 	}
 }
 
@@ -291,62 +298,48 @@ static void color(RegisterAllocator::VirtualRegisterSet& spilled,
 	RegisterMap& allocated, const ir::Function& function,
 	const InterferenceAnalysis& interferences, unsigned int colors)
 {
-	//std::srand(std::time(0));
-	std::srand(0);
-	
 	// Create a map from node degree to virtual register
 	RegisterInfoVector registers;
-	
+
 	registers.reserve(function.register_size());
-	
+
 	for(auto reg = function.register_begin();
 		reg != function.register_end(); ++reg)
 	{
 		registers.push_back(RegisterInfo(&*reg,
 			interferences.getInterferences(*reg).size()));
 	}
-	
-	// Initialize scheduling order for each node
-	initializeSchedulingOrder(registers);
-	
-	// Initialize the colors
-	initializeColors(registers, interferences);
-	
-	// Propagate colors until converged
-	report(" Propating colors until converged.");
-	
-	unsigned int iteration = 0;
-	bool changed = true;
-	
-	while(changed)
-	{
-		changed = propagateColorsInParallel(registers,
-			iteration++, interferences);
-		
-		// Check iteration count
-		assertM(iteration <= colors, "Too many iterations: " << iteration);
-	}
-	
-	report("  -------------------- Iteration Count "
-		<< iteration << " ------------------");
-	
+
+	// Remove registers from the graph, cheapest first
+	report(" Simplifying the interference graph.");
+
+	ColorVector selectStack;
+
+	simplify(selectStack, registers, interferences);
+
+	// Color in reverse removal order
+	report(" Selecting colors.");
+
+	select(spilled, selectStack, registers, interferences, colors);
+
 	// finish
 	report("  Final report");
 	unsigned int score = 0;
-	
+
 	for(auto& reg : registers)
 	{
+		if(reg.removed) continue; // spilled
+
 		allocated.insert(std::make_pair(reg.virtualRegister->id, reg.color));
-		
+
 		score += reg.color;
-		
+
 		report("   vr" << reg.virtualRegister->id
-			<< " (degree " << reg.nodeDegree
-			<< ") | (color " << reg.color << ")");
+			<< " | (color " << reg.color << ")");
 	}
 
 	report("  allocation score " << score);
-	
+
 }
 
 static void replaceVirtualRegisterWithPhysical(ir::Operand*& operand,
@@ -374,8 +367,8 @@ static void replaceVirtualRegisterWithPhysical(ir::Operand*& operand,
 			registerOperand->virtualRegister, registerOperand->instruction);
 	}
 
-	delete operand;
-	
+	ir::Operand::dispose(operand);
+
 	operand = newOperand;
 }
 
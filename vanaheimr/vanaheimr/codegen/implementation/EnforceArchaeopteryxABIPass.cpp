@@ -15,8 +15,8 @@
 #include <vanaheimr/util/interface/LargeMap.h>
 #include <vanaheimr/util/interface/SmallMap.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
 #include <cstring>
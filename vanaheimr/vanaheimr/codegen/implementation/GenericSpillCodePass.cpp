@@ -9,8 +9,33 @@
 
 #include <vanaheimr/codegen/interface/RegisterAllocator.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Local.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
 
 namespace vanaheimr
 {
@@ -19,19 +44,298 @@ namespace codegen
 {
 
 GenericSpillCodePass::GenericSpillCodePass()
-: FunctionPass({}, "GenericSpillCodePass")
+: FunctionPass({"ControlFlowGraph", "LiveRangeAnalysis", "LoopAnalysis"},
+	"GenericSpillCodePass")
+{
+
+}
+
+typedef analysis::ControlFlowGraph  ControlFlowGraph;
+typedef analysis::LiveRangeAnalysis LiveRangeAnalysis;
+typedef analysis::LoopAnalysis      LoopAnalysis;
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::Instruction     Instruction;
+typedef ir::VirtualRegister VirtualRegister;
+
+typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+
+typedef std::map<BasicBlock*, std::vector<Instruction*>> BlockToUsesMap;
+
+/*! \brief The cost of one memory access in a block, weighted
+	exponentially by loop depth */
+static uint64_t blockWeight(unsigned int loopDepth)
+{
+	uint64_t weight = 1;
+
+	while(loopDepth-- != 0) weight *= 10;
+
+	return weight;
+}
+
+static void replaceRegister(ir::Operand* operand,
+	VirtualRegister* from, VirtualRegister* to)
+{
+	if(!operand->isRegister() &&
+		operand->mode() != ir::Operand::Predicate) return;
+
+	auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
+
+	if(registerOperand->virtualRegister != from) return;
+
+	registerOperand->setVirtualRegister(to);
+}
+
+static void replaceUses(Instruction* instruction,
+	VirtualRegister* from, VirtualRegister* to)
+{
+	for(auto read : instruction->reads)
+	{
+		replaceRegister(read, from, to);
+	}
+
+	// indirect writes read the address register
+	for(auto write : instruction->writes)
+	{
+		replaceRegister(write, from, to);
+	}
+}
+
+static void insertStore(BasicBlock* block, BasicBlock::iterator position,
+	ir::Variable* slot, VirtualRegister* value)
+{
+	auto store = new ir::St(block);
+
+	store->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, store));
+	store->setD(new ir::AddressOperand(slot, store));
+	store->setA(new ir::RegisterOperand(value, store));
+
+	block->insert(position, store);
+}
+
+static void insertLoad(BasicBlock* block, BasicBlock::iterator position,
+	VirtualRegister* destination, ir::Variable* slot)
+{
+	auto load = new ir::Ld(block);
+
+	load->setGuard(new ir::PredicateOperand(
+		ir::PredicateOperand::PredicateTrue, load));
+	load->setD(new ir::RegisterOperand(destination, load));
+	load->setA(new ir::AddressOperand(slot, load));
+
+	block->insert(position, load);
+}
+
+/*! \brief The unique predecessor of the loop header outside the loop,
+	nullptr when the loop cannot be entered through a single edge */
+static BasicBlock* getPreheader(LoopAnalysis::Loop* loop,
+	ControlFlowGraph* cfg)
+{
+	BasicBlock* preheader = nullptr;
+
+	for(auto predecessor : cfg->getPredecessors(*loop->header))
+	{
+		if(loop->contains(predecessor)) continue;
+
+		if(preheader != nullptr) return nullptr;
+
+		preheader = predecessor;
+	}
+
+	return preheader;
+}
+
+static bool definesInLoop(const LiveRangeAnalysis::LiveRange& range,
+	const LoopAnalysis::Loop* loop)
+{
+	for(auto definition : range.definingInstructions)
+	{
+		if(loop->contains(definition->block)) return true;
+	}
+
+	return false;
+}
+
+/*! \brief The outermost enclosing loop the reload of a use block could
+	be hoisted out of, nullptr when it has to stay in place.
+
+	A reload can move above a loop when the loop holds no store to the
+	slot and the loop is entered through a single preheader edge */
+static LoopAnalysis::Loop* findHoistableLoop(BasicBlock* block,
+	const LiveRangeAnalysis::LiveRange& range, LoopAnalysis* loopAnalysis,
+	ControlFlowGraph* cfg)
 {
+	LoopAnalysis::Loop* candidate = nullptr;
+
+	for(auto loop = loopAnalysis->getLoopAt(*block);
+		loop != nullptr; loop = loop->parent)
+	{
+		if(definesInLoop(range, loop))         break;
+		if(getPreheader(loop, cfg) == nullptr) break;
 
+		candidate = loop;
+	}
+
+	return candidate;
+}
+
+static void spillRange(ir::Function& function,
+	const LiveRangeAnalysis::LiveRange& range, LoopAnalysis* loopAnalysis,
+	ControlFlowGraph* cfg)
+{
+	auto virtualRegister = range.virtualRegister();
+
+	std::stringstream slotName;
+
+	slotName << "_Zspill_vr" << virtualRegister->id;
+
+	auto slot = function.newLocalValue(slotName.str(),
+		virtualRegister->type, ir::Variable::InternalLinkage,
+		ir::Global::Shared);
+
+	report("  spilling vr" << virtualRegister->id
+		<< " to '" << slotName.str() << "'");
+
+	// store the value after every definition
+	for(auto definition : range.definingInstructions)
+	{
+		auto position = definition->block->getIterator(definition);
+
+		insertStore(definition->block, ++position, &*slot, virtualRegister);
+	}
+
+	// gather the uses block by block
+	BlockToUsesMap usesByBlock;
+
+	for(auto use : range.usingInstructions)
+	{
+		usesByBlock[use->block].push_back(use);
+	}
+
+	BasicBlockSet covered;
+
+	for(auto& blockAndUses : usesByBlock)
+	{
+		auto block = blockAndUses.first;
+
+		if(covered.count(block) != 0) continue;
+
+		// try to split the range above the enclosing loop nest
+		auto loop = findHoistableLoop(block, range, loopAnalysis, cfg);
+
+		if(loop != nullptr)
+		{
+			auto preheader = getPreheader(loop, cfg);
+
+			uint64_t hoistedCost = blockWeight(
+				loopAnalysis->getLoopDepth(*preheader));
+
+			uint64_t inPlaceCost = 0;
+
+			for(auto& candidate : usesByBlock)
+			{
+				if(!loop->contains(candidate.first)) continue;
+
+				inPlaceCost += blockWeight(
+					loopAnalysis->getLoopDepth(*candidate.first));
+			}
+
+			if(hoistedCost < inPlaceCost)
+			{
+				report("   reloading once in preheader '"
+					<< preheader->name() << "' (cost " << hoistedCost
+					<< ") instead of per block in the loop (cost "
+					<< inPlaceCost << ")");
+
+				auto split = function.newVirtualRegister(
+					virtualRegister->type);
+
+				auto position = preheader->end();
+
+				if(preheader->terminator() != nullptr) --position;
+
+				insertLoad(preheader, position, &*split, &*slot);
+
+				for(auto& candidate : usesByBlock)
+				{
+					if(!loop->contains(candidate.first)) continue;
+
+					for(auto use : candidate.second)
+					{
+						replaceUses(use, virtualRegister, &*split);
+					}
+
+					covered.insert(candidate.first);
+				}
+
+				continue;
+			}
+		}
+
+		// reload before the first use in the block
+		report("   reloading before the first use in block '"
+			<< block->name() << "'");
+
+		auto split = function.newVirtualRegister(virtualRegister->type);
+
+		Instruction* firstUse = nullptr;
+
+		for(auto instruction : *block)
+		{
+			if(std::find(blockAndUses.second.begin(),
+				blockAndUses.second.end(), instruction) ==
+				blockAndUses.second.end()) continue;
+
+			firstUse = instruction;
+
+			break;
+		}
+
+		assert(firstUse != nullptr);
+
+		insertLoad(block, block->getIterator(firstUse), &*split, &*slot);
+
+		for(auto use : blockAndUses.second)
+		{
+			replaceUses(use, virtualRegister, &*split);
+		}
+
+		covered.insert(block);
+	}
 }
 
 void GenericSpillCodePass::runOnFunction(Function& f)
 {
 	auto pass = static_cast<RegisterAllocator*>(getPass("register-allocator"));
 	assert(pass != nullptr);
-	
+
 	auto spilled = pass->getSpilledRegisters();
-	
-	assertM(spilled.empty(), "Spilling not implemented");	
+
+	if(spilled.empty()) return;
+
+	report("Inserting spill code into '" << f.name() << "'");
+
+	auto liveRangeAnalysis = static_cast<LiveRangeAnalysis*>(
+		getAnalysis("LiveRangeAnalysis"));
+	auto loopAnalysis = static_cast<LoopAnalysis*>(
+		getAnalysis("LoopAnalysis"));
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	for(auto virtualRegister : spilled)
+	{
+		auto range = liveRangeAnalysis->getLiveRange(*virtualRegister);
+		assert(range != nullptr);
+
+		spillRange(f, *range, loopAnalysis, cfg);
+	}
+
+	// the split ranges need a fresh allocation round
+	invalidateAnalysis("DataflowAnalysis");
+	invalidateAnalysis("LiveRangeAnalysis");
+	invalidateAnalysis("InterferenceAnalysis");
+	invalidateAnalysis("DependenceAnalysis");
 }
 
 transforms::Pass* GenericSpillCodePass::clone() const
@@ -42,5 +346,3 @@ transforms::Pass* GenericSpillCodePass::clone() const
 }
 
 }
-
-
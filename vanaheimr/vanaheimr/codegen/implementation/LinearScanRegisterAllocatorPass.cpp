@@ -0,0 +1,280 @@
+/*! \file   LinearScanRegisterAllocatorPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LinearScanRegisterAllocatorPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/LinearScanRegisterAllocatorPass.h>
+
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/machine/interface/PhysicalRegisterOperand.h>
+#include <vanaheimr/machine/interface/PhysicalIndirectOperand.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <map>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+typedef analysis::LiveRangeAnalysis LiveRangeAnalysis;
+typedef util::LargeMap<unsigned int, unsigned int> RegisterMap;
+
+LinearScanRegisterAllocatorPass::LinearScanRegisterAllocatorPass()
+: RegisterAllocator({"LiveRangeAnalysis"},
+	"LinearScanRegisterAllocatorPass"), _machine(nullptr)
+{
+
+}
+
+/*! \brief A live range flattened to one covering interval.
+
+	Holes in the range are ignored, which costs quality, the scan stays
+	a single pass in exchange */
+class FlatInterval
+{
+public:
+	FlatInterval(ir::VirtualRegister* r, uint64_t b, uint64_t e)
+	: virtualRegister(r), begin(b), end(e)
+	{
+
+	}
+
+public:
+	ir::VirtualRegister* virtualRegister;
+	uint64_t             begin;
+	uint64_t             end;
+
+};
+
+typedef std::vector<FlatInterval> FlatIntervalVector;
+
+// active intervals, keyed by their end position so the earliest
+// expiring one is always in front and the furthest is in back
+typedef std::multimap<uint64_t,
+	std::pair<unsigned int, unsigned int>> ActiveMap;
+
+static void scan(RegisterAllocator::VirtualRegisterSet& spilled,
+	RegisterMap& allocated, FlatIntervalVector& intervals,
+	unsigned int colors)
+{
+	std::sort(intervals.begin(), intervals.end(),
+		[](const FlatInterval& left, const FlatInterval& right)
+		{
+			return left.begin < right.begin;
+		});
+
+	std::vector<unsigned int> freeColors;
+
+	freeColors.reserve(colors);
+
+	for(unsigned int color = colors; color != 0; --color)
+	{
+		freeColors.push_back(color - 1);
+	}
+
+	ActiveMap active;
+
+	for(auto& interval : intervals)
+	{
+		// expire intervals that ended before this one starts
+		while(!active.empty() && active.begin()->first <= interval.begin)
+		{
+			freeColors.push_back(active.begin()->second.first);
+
+			active.erase(active.begin());
+		}
+
+		if(freeColors.empty())
+		{
+			// spill whichever of the current and the furthest reaching
+			// active interval lives longest
+			auto furthest = std::prev(active.end());
+
+			if(furthest->first > interval.end)
+			{
+				report("  spilling vr" << furthest->second.second
+					<< ", it reaches past position " << interval.end);
+
+				unsigned int color = furthest->second.first;
+
+				spilled.insert(
+					intervals[furthest->second.second].virtualRegister);
+
+				allocated.erase(
+					intervals[furthest->second.second].virtualRegister->id);
+
+				active.erase(furthest);
+
+				allocated.insert(std::make_pair(
+					interval.virtualRegister->id, color));
+
+				active.insert(std::make_pair(interval.end,
+					std::make_pair(color,
+					(unsigned int)(&interval - intervals.data()))));
+			}
+			else
+			{
+				report("  spilling vr" << interval.virtualRegister->id
+					<< ", all " << colors << " registers reach past it");
+
+				spilled.insert(interval.virtualRegister);
+			}
+
+			continue;
+		}
+
+		unsigned int color = freeColors.back();
+
+		freeColors.pop_back();
+
+		allocated.insert(std::make_pair(interval.virtualRegister->id, color));
+
+		active.insert(std::make_pair(interval.end, std::make_pair(color,
+			(unsigned int)(&interval - intervals.data()))));
+
+		report("  vr" << interval.virtualRegister->id
+			<< " [" << interval.begin << ", " << interval.end
+			<< ") -> (color " << color << ")");
+	}
+}
+
+static void replaceVirtualRegisterWithPhysical(ir::Operand*& operand,
+	const LinearScanRegisterAllocatorPass& allocator)
+{
+	if(!operand->isRegister()) return;
+
+	auto newOperand = operand;
+
+	if(operand->isIndirect())
+	{
+		auto indirectOperand = static_cast<ir::IndirectOperand*>(operand);
+
+		newOperand = new machine::PhysicalIndirectOperand(
+			allocator.getPhysicalRegister(*indirectOperand->virtualRegister),
+			indirectOperand->virtualRegister, indirectOperand->offset,
+			indirectOperand->instruction);
+	}
+	else
+	{
+		auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
+
+		newOperand = new machine::PhysicalRegisterOperand(
+			allocator.getPhysicalRegister(*registerOperand->virtualRegister),
+			registerOperand->virtualRegister, registerOperand->instruction);
+	}
+
+	ir::Operand::dispose(operand);
+
+	operand = newOperand;
+}
+
+static void assignRegisters(ir::Function& f,
+	const LinearScanRegisterAllocatorPass& allocator)
+{
+	for(auto& block : f)
+	{
+		for(auto& instruction : block)
+		{
+			for(auto& read : instruction->reads)
+			{
+				replaceVirtualRegisterWithPhysical(read, allocator);
+			}
+
+			for(auto& write : instruction->writes)
+			{
+				replaceVirtualRegisterWithPhysical(write, allocator);
+			}
+		}
+	}
+}
+
+void LinearScanRegisterAllocatorPass::runOnFunction(Function& f)
+{
+	report("Running linear scan register allocator on " << f.name());
+
+	auto liveRangeAnalysis = static_cast<LiveRangeAnalysis*>(
+		getAnalysis("LiveRangeAnalysis"));
+	assert(liveRangeAnalysis != nullptr);
+
+	_machine = compiler::Compiler::getSingleton()->getMachineModel();
+
+	// flatten each live range to one interval
+	FlatIntervalVector intervals;
+
+	intervals.reserve(liveRangeAnalysis->size());
+
+	for(auto& range : *liveRangeAnalysis)
+	{
+		uint64_t begin = 0;
+		uint64_t end   = 0;
+
+		if(!range.intervals.empty())
+		{
+			begin = range.intervals.front().begin;
+			end   = range.intervals.back().end;
+		}
+
+		intervals.push_back(FlatInterval(range.virtualRegister(),
+			begin, end));
+	}
+
+	// allocate in one scan over the intervals
+	scan(_spilled, _allocated, intervals, _machine->totalRegisterCount());
+
+	// TODO: spill if allocation fails
+	assertM(_spilled.empty(), "No support for spills yet.");
+
+	// Assign registers
+	assignRegisters(f, *this);
+}
+
+transforms::Pass* LinearScanRegisterAllocatorPass::clone() const
+{
+	return new LinearScanRegisterAllocatorPass;
+}
+
+RegisterAllocator::VirtualRegisterSet
+	LinearScanRegisterAllocatorPass::getSpilledRegisters()
+{
+	return _spilled;
+}
+
+const machine::PhysicalRegister*
+	LinearScanRegisterAllocatorPass::getPhysicalRegister(
+	const ir::VirtualRegister& vr) const
+{
+	auto allocatedRegister = _allocated.find(vr.id);
+
+	if(allocatedRegister == _allocated.end()) return nullptr;
+
+	return _machine->getPhysicalRegister(allocatedRegister->second);
+}
+
+}
+
+}
+
+
@@ -9,16 +9,22 @@
 
 #include <vanaheimr/analysis/interface/DependenceAnalysis.h>
 
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
 
 #include <vanaheimr/util/interface/LargeSet.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -39,90 +45,130 @@ ListInstructionSchedulerPass::ListInstructionSchedulerPass()
 
 }
 
-typedef util::LargeSet<ir::Instruction*> InstructionSet;
-	
-static bool anyDependencies(ir::Instruction* instruction,
-	analysis::DependenceAnalysis& dep, const InstructionSet& remaining)
+typedef analysis::DependenceAnalysis::BlockDependenceDAG BlockDependenceDAG;
+
+static size_t nodeIndex(const BlockDependenceDAG& dag,
+	const BlockDependenceDAG::Node* node)
 {
-	auto predecessors = dep.getLocalPredecessors(*instruction);
+	return node - dag.nodes.data();
+}
+
+/*! \brief Rank nodes by the latency weighted length of their longest
+	path to a DAG leaf, the critical path below them.
 
-	for(auto writer : predecessors)
+	Edges only point forward in block order, so one reverse sweep over
+	the nodes sees every successor before its predecessors. */
+static void computePriorities(std::vector<uint64_t>& priorities,
+	const BlockDependenceDAG& dag, const machine::MachineModel& machine)
+{
+	priorities.assign(dag.size(), 0);
+
+	for(size_t i = dag.size(); i != 0; --i)
 	{
-		if(writer->block != instruction->block) continue;
-		       if(remaining.count(writer) == 0) continue;
-		
-		assertM(writer->index() < instruction->index(), "Instruction '"
-			<< writer->toString() << "' has a higher sequence number than '"
-			<< instruction->toString() << "'");
-
-		return true;
+		auto& node = dag.nodes[i - 1];
+
+		uint64_t successorHeight = 0;
+
+		for(unsigned int s = 0; s != node.successorCount; ++s)
+		{
+			successorHeight = std::max(successorHeight,
+				priorities[nodeIndex(dag, node.successors[s])]);
+		}
+
+		priorities[i - 1] = successorHeight +
+			machine.instructionLatency(*node.instruction);
 	}
-	
-	return false;
 }
 
-static void schedule(ir::BasicBlock& block, analysis::DependenceAnalysis& dep)
+static void schedule(ir::BasicBlock& block, analysis::DependenceAnalysis& dep,
+	const machine::MachineModel& machine)
 {
 	report(" Scheduling basic block '" << block.name() << "'");
 
-	// TODO sort by priority, sort in parallel
+	auto& dag = dep.getBlockDAG(block);
+
+	std::vector<uint64_t> priorities;
+
+	computePriorities(priorities, dag, machine);
+
+	std::vector<unsigned int> remainingPredecessors(dag.size());
+	std::vector<uint64_t>     readyTimes(dag.size(), 0);
+
+	std::vector<size_t> ready;
+
+	for(size_t i = 0; i != dag.size(); ++i)
+	{
+		remainingPredecessors[i] = dag.nodes[i].predecessorCount;
+
+		if(remainingPredecessors[i] == 0) ready.push_back(i);
+	}
+
 	ir::BasicBlock::InstructionList newInstructions;
-	
-	InstructionSet readyInstructions;
-	
-	InstructionSet remainingInstructions;
-	
-	remainingInstructions.insert(block.begin(), block.end());
-
-	report("  Getting instructions with no dependencies...");
-	
-	for(auto instruction : block)
+
+	uint64_t cycle = 0;
+
+	while(!ready.empty())
 	{
-		if(!anyDependencies(instruction, dep, remainingInstructions))
+		// pick the ready instruction on the longest critical path whose
+		// operands have arrived, ties go to the original order
+		auto selected = ready.end();
+
+		uint64_t earliestReadyTime = (uint64_t)-1;
+
+		for(auto candidate = ready.begin();
+			candidate != ready.end(); ++candidate)
 		{
-			report("   " << instruction->toString());
-		
-			readyInstructions.insert(instruction);
+			earliestReadyTime = std::min(earliestReadyTime,
+				readyTimes[*candidate]);
+
+			if(readyTimes[*candidate] > cycle) continue;
+
+			if(selected == ready.end() ||
+				priorities[*candidate] > priorities[*selected] ||
+				(priorities[*candidate] == priorities[*selected] &&
+					*candidate < *selected))
+			{
+				selected = candidate;
+			}
 		}
-	}
-	
-	// Remove them from the set of remaining instructions
-	for(auto instruction : readyInstructions)
-	{
-		auto remaining = remainingInstructions.find(instruction);
 
-		assert(remaining != remainingInstructions.end());
+		// everything ready is still waiting on a result, stall
+		if(selected == ready.end())
+		{
+			cycle = earliestReadyTime;
 
-		remainingInstructions.erase(remaining);
-	}
+			continue;
+		}
 
-	report("  Scheduling remaining instructions...");
-	
-	while(!readyInstructions.empty())
-	{
-		auto next = *readyInstructions.begin();
-		readyInstructions.erase(readyInstructions.begin());
+		size_t next = *selected;
+
+		ready.erase(selected);
 
-		report("   " << next->toString());
+		auto& node = dag.nodes[next];
 
-		newInstructions.push_back(next);
+		report("   (cycle " << cycle << ", priority " << priorities[next]
+			<< ") " << node.instruction->toString());
 
-		// free dependent instructions
-		auto successors = dep.getLocalSuccessors(*next);
+		newInstructions.push_back(node.instruction);
 
-		for(auto successor : successors)
+		uint64_t finish = cycle +
+			machine.instructionLatency(*node.instruction);
+
+		cycle += machine.instructionThroughput(*node.instruction);
+
+		// release dependent instructions
+		for(unsigned int s = 0; s != node.successorCount; ++s)
 		{
-			auto remaining = remainingInstructions.find(successor);
+			size_t successor = nodeIndex(dag, node.successors[s]);
 
-			if(remaining == remainingInstructions.end()) continue;
+			readyTimes[successor] = std::max(readyTimes[successor], finish);
 
-			if(!anyDependencies(successor, dep, remainingInstructions))
+			if(--remainingPredecessors[successor] == 0)
 			{
-				remainingInstructions.erase(remaining);
-				
-				report("    released '" << successor->toString() << "'");
+				report("    released '"
+					<< dag.nodes[successor].instruction->toString() << "'");
 
-				readyInstructions.insert(successor);
+				ready.push_back(successor);
 			}
 		}
 	}
@@ -136,13 +182,15 @@ void ListInstructionSchedulerPass::runOnFunction(Function& f)
 {
 	auto dep = static_cast<analysis::DependenceAnalysis*>(
 		getAnalysis("DependenceAnalysis"));
-	
+
+	auto machine = compiler::Compiler::getSingleton()->getMachineModel();
+
 	report("Running list scheduling on '" << f.name() << "'");
-	
+
 	// for all blocks
 	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		schedule(*block, *dep);
+		schedule(*block, *dep, *machine);
 	}
 }
 
@@ -0,0 +1,413 @@
+/*! \file   MachinePeepholeOptimizationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the MachinePeepholeOptimizationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/MachinePeepholeOptimizationPass.h>
+
+#include <vanaheimr/analysis/interface/DataflowAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+MachinePeepholeOptimizationPass::MachinePeepholeOptimizationPass()
+: FunctionPass({"DataflowAnalysis"}, "MachinePeepholeOptimizationPass")
+{
+
+}
+
+typedef ir::Instruction     Instruction;
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::VirtualRegister VirtualRegister;
+
+typedef std::unordered_map<VirtualRegister*, VirtualRegister*> CopyMap;
+
+static ir::RegisterOperand* asRegister(ir::Operand* operand)
+{
+	if(operand == nullptr)                           return nullptr;
+	if(operand->mode() != ir::Operand::Register)     return nullptr;
+
+	return static_cast<ir::RegisterOperand*>(operand);
+}
+
+static bool isImmediate(const ir::Operand* operand, uint64_t value)
+{
+	if(operand->mode() != ir::Operand::Immediate) return false;
+
+	return static_cast<const ir::ImmediateOperand*>(operand)->uint == value;
+}
+
+static ir::RegisterOperand* getDestination(Instruction* instruction)
+{
+	if(instruction->writes.size() != 1) return nullptr;
+
+	return asRegister(instruction->writes[0]);
+}
+
+/*! \brief Match an unconditional register to register move */
+static ir::RegisterOperand* matchMove(Instruction* instruction)
+{
+	if(instruction->reads.size() != 2) return nullptr;
+
+	auto name = instruction->opcodeString();
+
+	if(name != "bitcast" && name != "mov" && name != "move") return nullptr;
+
+	return asRegister(instruction->reads[1]);
+}
+
+/*! \brief Match additive identities: add/sub/or/xor with zero */
+static ir::RegisterOperand* matchIdentityAdd(Instruction* instruction)
+{
+	if(instruction->reads.size() != 3) return nullptr;
+
+	auto name = instruction->opcodeString();
+
+	if(name != "add" && name != "sub" &&
+		name != "or" && name != "xor") return nullptr;
+
+	if(isImmediate(instruction->reads[2], 0))
+	{
+		return asRegister(instruction->reads[1]);
+	}
+
+	// addition commutes
+	if(name == "add" && isImmediate(instruction->reads[1], 0))
+	{
+		return asRegister(instruction->reads[2]);
+	}
+
+	return nullptr;
+}
+
+/*! \brief Match multiplicative identities: mul/div by one */
+static ir::RegisterOperand* matchIdentityMul(Instruction* instruction)
+{
+	if(instruction->reads.size() != 3) return nullptr;
+
+	auto name = instruction->opcodeString();
+
+	if(name != "mul" && name != "udiv" && name != "sdiv") return nullptr;
+
+	if(isImmediate(instruction->reads[2], 1))
+	{
+		return asRegister(instruction->reads[1]);
+	}
+
+	if(name == "mul" && isImmediate(instruction->reads[1], 1))
+	{
+		return asRegister(instruction->reads[2]);
+	}
+
+	return nullptr;
+}
+
+/*! \brief Match shifts by zero */
+static ir::RegisterOperand* matchIdentityShift(Instruction* instruction)
+{
+	if(instruction->reads.size() != 3) return nullptr;
+
+	auto name = instruction->opcodeString();
+
+	if(name != "shl" && name != "lshr" && name != "ashr") return nullptr;
+
+	if(isImmediate(instruction->reads[2], 0))
+	{
+		return asRegister(instruction->reads[1]);
+	}
+
+	return nullptr;
+}
+
+/*! \brief A declarative pattern recognizing one copy-like shape.
+
+	The matcher returns the forwarded source operand when the
+	instruction is just a copy of it, nullptr otherwise */
+class PeepholePattern
+{
+public:
+	const char* name;
+
+	ir::RegisterOperand* (*matchCopy)(Instruction*);
+};
+
+static const PeepholePattern peepholePatterns[] =
+{
+	{"move",           matchMove},
+	{"identity-add",   matchIdentityAdd},
+	{"identity-mul",   matchIdentityMul},
+	{"identity-shift", matchIdentityShift}
+};
+
+/*! \brief The source register the instruction merely copies,
+	nullptr when no pattern applies */
+static VirtualRegister* matchCopySource(Instruction* instruction)
+{
+	if(!instruction->guard()->isAlwaysTrue()) return nullptr;
+
+	if(getDestination(instruction) == nullptr) return nullptr;
+
+	for(auto& pattern : peepholePatterns)
+	{
+		auto source = pattern.matchCopy(instruction);
+
+		if(source == nullptr || source->virtualRegister == nullptr) continue;
+
+		reportE(REPORT_BASE > 1, "   '" << instruction->toString()
+			<< "' matches pattern '" << pattern.name << "'");
+
+		return source->virtualRegister;
+	}
+
+	return nullptr;
+}
+
+static VirtualRegister* resolve(const CopyMap& copies, VirtualRegister* reg)
+{
+	auto copy = copies.find(reg);
+
+	return copy == copies.end() ? reg : copy->second;
+}
+
+static void forwardOperand(ir::Operand* operand, const CopyMap& copies)
+{
+	if(operand->mode() != ir::Operand::Register &&
+		operand->mode() != ir::Operand::Indirect &&
+		operand->mode() != ir::Operand::Predicate) return;
+
+	auto registerOperand = static_cast<ir::RegisterOperand*>(operand);
+
+	if(registerOperand->virtualRegister == nullptr) return;
+
+	auto source = resolve(copies, registerOperand->virtualRegister);
+
+	if(source == registerOperand->virtualRegister) return;
+
+	registerOperand->setVirtualRegister(source);
+}
+
+static void killCopies(CopyMap& copies, VirtualRegister* definedRegister)
+{
+	for(auto copy = copies.begin(); copy != copies.end(); )
+	{
+		if(copy->first == definedRegister ||
+			copy->second == definedRegister)
+		{
+			copy = copies.erase(copy);
+		}
+		else
+		{
+			++copy;
+		}
+	}
+}
+
+/*! \brief Forward copy sources through the block's reads */
+static bool propagateCopies(BasicBlock& block)
+{
+	CopyMap copies;
+
+	for(auto instruction : block)
+	{
+		for(auto read : instruction->reads)
+		{
+			forwardOperand(read, copies);
+		}
+
+		// indirect writes read their address register
+		for(auto write : instruction->writes)
+		{
+			if(write->mode() == ir::Operand::Indirect)
+			{
+				forwardOperand(write, copies);
+			}
+		}
+
+		for(auto write : instruction->writes)
+		{
+			auto destination = asRegister(write);
+
+			if(destination == nullptr) continue;
+
+			killCopies(copies, destination->virtualRegister);
+		}
+
+		auto source = matchCopySource(instruction);
+
+		if(source != nullptr)
+		{
+			copies.insert(std::make_pair(
+				getDestination(instruction)->virtualRegister, source));
+		}
+	}
+
+	return !copies.empty();
+}
+
+static bool readsRegister(Instruction* instruction, VirtualRegister* reg)
+{
+	for(auto read : instruction->reads)
+	{
+		auto registerRead = static_cast<ir::RegisterOperand*>(read);
+
+		if(read->mode() != ir::Operand::Register &&
+			read->mode() != ir::Operand::Indirect &&
+			read->mode() != ir::Operand::Predicate) continue;
+
+		if(registerRead->virtualRegister == reg) return true;
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write->mode() != ir::Operand::Indirect) continue;
+
+		if(static_cast<ir::IndirectOperand*>(
+			write)->virtualRegister == reg) return true;
+	}
+
+	return false;
+}
+
+static bool isReadBelow(BasicBlock& block, BasicBlock::iterator position,
+	VirtualRegister* reg)
+{
+	for(; position != block.end(); ++position)
+	{
+		if(readsRegister(*position, reg)) return true;
+	}
+
+	return false;
+}
+
+static void unlinkRegisterOperands(Instruction* instruction)
+{
+	for(auto read : instruction->reads)
+	{
+		auto registerRead = asRegister(read);
+
+		if(registerRead != nullptr)
+		{
+			registerRead->setVirtualRegister(nullptr);
+		}
+	}
+
+	for(auto write : instruction->writes)
+	{
+		auto registerWrite = asRegister(write);
+
+		if(registerWrite != nullptr)
+		{
+			registerWrite->setVirtualRegister(nullptr);
+		}
+	}
+}
+
+/*! \brief Erase copies whose results are dead after propagation */
+static unsigned int eraseDeadCopies(BasicBlock& block,
+	analysis::DataflowAnalysis* dfg)
+{
+	auto liveOuts = dfg->getLiveOuts(block);
+
+	unsigned int erased = 0;
+
+	for(auto instruction = block.begin(); instruction != block.end(); )
+	{
+		auto source = matchCopySource(*instruction);
+
+		if(source == nullptr)
+		{
+			++instruction;
+
+			continue;
+		}
+
+		auto destination = getDestination(*instruction)->virtualRegister;
+
+		bool selfCopy = destination == source;
+
+		bool dead = !selfCopy && liveOuts.count(destination) == 0 &&
+			!isReadBelow(block, std::next(instruction), destination);
+
+		if(!selfCopy && !dead)
+		{
+			++instruction;
+
+			continue;
+		}
+
+		report("   erasing '" << (*instruction)->toString() << "'");
+
+		unlinkRegisterOperands(*instruction);
+
+		instruction = block.erase(instruction);
+
+		++erased;
+	}
+
+	return erased;
+}
+
+void MachinePeepholeOptimizationPass::runOnFunction(Function& f)
+{
+	report("Running peephole optimization on '" << f.name() << "'");
+
+	auto dfg = static_cast<analysis::DataflowAnalysis*>(
+		getAnalysis("DataflowAnalysis"));
+	assert(dfg != nullptr);
+
+	unsigned int erased = 0;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		report("  block '" << block->name() << "'");
+
+		propagateCopies(*block);
+
+		erased += eraseDeadCopies(*block, dfg);
+	}
+
+	report(" erased " << erased << " instructions");
+
+	if(erased != 0)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DependenceAnalysis");
+		invalidateAnalysis("LiveRangeAnalysis");
+		invalidateAnalysis("InterferenceAnalysis");
+	}
+}
+
+transforms::Pass* MachinePeepholeOptimizationPass::clone() const
+{
+	return new MachinePeepholeOptimizationPass;
+}
+
+}
+
+}
+
+
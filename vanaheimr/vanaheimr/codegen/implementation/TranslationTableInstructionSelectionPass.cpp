@@ -16,8 +16,8 @@
 
 #include <vanaheimr/ir/interface/Function.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
 #include <stdexcept>
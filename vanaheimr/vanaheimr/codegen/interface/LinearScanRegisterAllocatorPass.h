@@ -0,0 +1,64 @@
+/*! \file   LinearScanRegisterAllocatorPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LinearScanRegisterAllocatorPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/codegen/interface/RegisterAllocator.h>
+
+#include <vanaheimr/util/interface/LargeMap.h>
+
+// Forward Declarations
+namespace vanaheimr { namespace machine { class MachineModel; } }
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+/*! \brief Allocates registers with a single scan over live intervals.
+
+	Allocation quality is worse than graph coloring because interval
+	holes are ignored, but the scan is a sort plus one pass, so it is
+	the allocator of choice when kernels are compiled just-in-time
+	before simulation and codegen latency dominates. */
+class LinearScanRegisterAllocatorPass : public RegisterAllocator
+{
+public:
+	LinearScanRegisterAllocatorPass();
+
+public:
+	/*! \brief Run the pass on a specific function in the module */
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+public:
+	/*! \brief Get the set of values that were spilled during allocation */
+	VirtualRegisterSet getSpilledRegisters();
+
+	/*! \brief Get the mapping of a value to a named physical register */
+	const machine::PhysicalRegister* getPhysicalRegister(
+		const ir::VirtualRegister&) const;
+
+private:
+	typedef util::LargeMap<unsigned int, unsigned int> RegisterMap;
+
+private:
+	VirtualRegisterSet _spilled;
+	RegisterMap        _allocated;
+
+private:
+	const machine::MachineModel* _machine;
+};
+
+}
+
+}
+
+
@@ -0,0 +1,42 @@
+/*! \file   MachinePeepholeOptimizationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the MachinePeepholeOptimizationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace codegen
+{
+
+/*! \brief Cleans up redundancies left behind by instruction selection.
+
+	A declarative pattern table recognizes copy-like instructions
+	(moves, identity adds, multiplies by one, shifts by zero).  Their
+	sources are forwarded through each block, and copies whose results
+	are dead afterwards are erased, so move chains never reach the
+	assembly or binary writers. */
+class MachinePeepholeOptimizationPass : public transforms::FunctionPass
+{
+public:
+	MachinePeepholeOptimizationPass();
+
+public:
+	/*! \brief Run the pass on a specific function in the module */
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+};
+
+}
+
+}
+
+
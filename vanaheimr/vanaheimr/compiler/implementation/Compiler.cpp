@@ -52,6 +52,12 @@ Compiler::Compiler()
 	_types.push_back(new ir::BasicBlockType(this));
 	_types.push_back(new ir::VoidType(this));
 
+	for(size_t i = 0; i < _types.size(); ++i)
+	{
+		_typeIndices.insert(std::make_pair(_types[i]->name, i));
+		_typeIndex.insert(_types[i]->name, _types[i]);
+	}
+
 	// Create the machine model
 	_machineModel = machine::MachineModelFactory::createDefaultMachine();
 
@@ -117,30 +123,47 @@ Compiler::const_module_iterator Compiler::module_end() const
 
 Compiler::module_iterator Compiler::newModule(const std::string& name)
 {
-	return _modules.insert(_modules.end(), ir::Module(name, this));
+	std::lock_guard<std::mutex> lock(_moduleLock);
+
+	auto module = _modules.insert(_modules.end(), ir::Module(name, this));
+
+	_moduleIndex.insert(name, module);
+
+	return module;
 }
 	
 Compiler::iterator Compiler::newType(const ir::Type& type)
 {
+	std::lock_guard<std::recursive_mutex> lock(_typeLock);
+
 	assert(getType(type.name) == nullptr);
 
 	report("Added type: '" << type.name << "'");
-	
-	return _types.insert(_types.end(), type.clone());
+
+	_typeIndices.insert(std::make_pair(type.name, _types.size()));
+
+	auto inserted = _types.insert(_types.end(), type.clone());
+
+	_typeIndex.insert(type.name, *inserted);
+
+	return inserted;
 }
 
 Compiler::iterator Compiler::getOrInsertType(const ir::Type& type)
 {
-	for(iterator t = begin(); t != end(); ++t)
-	{
-		if(type.name == (*t)->name) return t;
-	}
+	std::lock_guard<std::recursive_mutex> lock(_typeLock);
+
+	auto index = _typeIndices.find(type.name);
+	
+	if(index != _typeIndices.end()) return begin() + index->second;
 
 	return newType(type);
 }
 
 Compiler::iterator Compiler::getOrInsertType(const std::string& signature)
 {
+	std::lock_guard<std::recursive_mutex> lock(_typeLock);
+
 	report("Parsing type with signature: '" << signature << "'");
 	
 	parser::TypeParser parser(this);
@@ -154,49 +177,38 @@ Compiler::iterator Compiler::getOrInsertType(const std::string& signature)
 
 Compiler::module_iterator Compiler::getModule(const std::string& name)
 {
-	for(module_iterator module = module_begin();
-		module != module_end(); ++module)
-	{
-		if(module->name == name) return module;
-	}
-	
+	auto module = _moduleIndex.find(name);
+
+	if(module != nullptr) return *module;
+
 	return module_end();
 }
 
 Compiler::const_module_iterator Compiler::getModule(
 	const std::string& name) const
 {
-	const_module_iterator module = module_end();
-	
-	for( ; module != module_end(); ++module)
-	{
-		if(module->name == name) break;
-	}
-	
-	return module;
+	auto module = _moduleIndex.find(name);
+
+	if(module != nullptr) return *module;
+
+	return module_end();
 }
 
 ir::Type* Compiler::getType(const std::string& name)
 {
-	iterator type = _types.begin();
-	
-	for( ; type != _types.end(); ++type)
-	{
-		if((*type)->name == name) return *type;
-	}
-	
+	auto type = _typeIndex.find(name);
+
+	if(type != nullptr) return *type;
+
 	return 0;
 }
 
 const ir::Type* Compiler::getType(const std::string& typeName) const
 {
-	const_iterator type = _types.begin();
-	
-	for( ; type != _types.end(); ++type)
-	{
-		if((*type)->name == typeName) return *type;
-	}
-	
+	auto type = _typeIndex.find(typeName);
+
+	if(type != nullptr) return *type;
+
 	return 0;
 }
 
@@ -224,6 +236,16 @@ void Compiler::switchToNewMachineModel(const std::string& name)
 	assert(_machineModel != nullptr);
 }
 
+util::StringPool& Compiler::stringPool()
+{
+	return _stringPool;
+}
+
+const util::StringPool& Compiler::stringPool() const
+{
+	return _stringPool;
+}
+
 Compiler* Compiler::getSingleton()
 {
 	return &singleton;
@@ -5,9 +5,16 @@
 	
 */
 
-// Standard Library Includes
+// Vanaheimr Includes
 #include <vanaheimr/ir/interface/Module.h>
 
+#include <vanaheimr/util/interface/StringPool.h>
+#include <vanaheimr/util/interface/ConcurrentMap.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <mutex>
+
 // Forward Declarations
 namespace vanaheimr { namespace ir      { class Type;         } }
 namespace vanaheimr { namespace machine { class MachineModel; } }
@@ -25,6 +32,11 @@ class Compiler
 public:
 	typedef std::vector<ir::Type*> TypeVector;
 	typedef std::list<ir::Module>  ModuleList;
+
+	/*! \brief Hash-consing table from type signature to position in the
+		type vector.  Each structurally-distinct type is created exactly
+		once, so type equality reduces to pointer comparison. */
+	typedef std::unordered_map<std::string, size_t> TypeIndexMap;
 	
 	typedef TypeVector::iterator       iterator;
 	typedef TypeVector::const_iterator const_iterator;
@@ -71,7 +83,8 @@ public:
 	iterator getOrInsertType(const std::string& signature);
 	
 public:
-	/*! \brief Lookup a type by name, return 0 if it doesn't exist */
+	/*! \brief Lookup a type by name, return 0 if it doesn't exist.
+		Reads are lock-free, parallel phases may call this freely */
 	ir::Type*       getType(const std::string& name);
 	/*! \brief Lookup a type by name, return 0 if it doesn't exist */
 	const ir::Type* getType(const std::string& typeName) const;
@@ -87,15 +100,40 @@ public:
 public:
 	void switchToNewMachineModel(const std::string& name);
 
+public:
+	/*! \brief The pool of interned IR value and register names */
+	      util::StringPool& stringPool();
+	const util::StringPool& stringPool() const;
+
 public:
 	static Compiler* getSingleton();
 
+private:
+	/*! \brief Sharded name registries shared by parallel phases.  Reads
+		(getType/getModule) are lock-free, inserts lock one shard */
+	typedef util::ConcurrentMap<std::string, ir::Type*>    TypeIndex;
+	typedef util::ConcurrentMap<std::string, module_iterator> ModuleIndex;
+
+private:
+	/*! \brief Guards the type vector and uniquing table on the insert
+		path, translation runs kernels on concurrent workers.  Recursive
+		because the uniquing entry points call through each other. */
+	mutable std::recursive_mutex _typeLock;
+
+	/*! \brief Guards the module list on the insert path, batch tools
+		load and register modules from concurrent workers */
+	mutable std::mutex _moduleLock;
+
 private:
 	TypeVector             _types;
+	TypeIndexMap           _typeIndices;
+	TypeIndex              _typeIndex;
 	ModuleList             _modules;
+	ModuleIndex            _moduleIndex;
+	util::StringPool       _stringPool;
 	machine::MachineModel* _machineModel;
 
-};	
+};
 
 }
 
@@ -0,0 +1,146 @@
+################################################################################
+#
+# \file   Daemon.py
+# \author Gregory Diamos <solusstultus@gmail.com>
+# \date   Saturday August 29, 2026
+# \brief  A long lived compile server for the vanaheimr compiler driver.
+#
+# Every invocation of vir-compiler pays the full startup cost: the python
+#  interpreter, module imports, tool discovery, and driver setup.  For many
+#  small compiles that startup dominates the latency, so the daemon keeps one
+#  warm process alive and accepts compile requests over a local unix socket.
+#
+# The protocol is one JSON object per line.  A request carries a list of
+#  module compiles so that callers can batch:
+#
+#   {"modules" : [{"input_file" : "a.cpp", "output_file" : "a.bc"}, ...]}
+#
+#  and the reply mirrors the batch, one result per module in order:
+#
+#   {"results" : [{"output_file" : "a.bc", "ok" : True}, ...]}
+#
+#  A module request accepts the same keys as the vir-compiler command line
+#  arguments and unspecified keys take the same defaults.
+#
+################################################################################
+
+from CompilerDriver import CompilerDriver
+
+import json
+import os
+import socket
+
+# The default location of the daemon socket, per user
+def defaultSocketPath():
+	return os.path.join('/tmp', 'vir-compiler-daemon-' +
+		str(os.getuid()) + '.socket')
+
+# The default values of the vir-compiler command line arguments
+def defaultArguments():
+	return {
+		'input_file'         : '',
+		'output_file'        : '',
+		'optimization_level' : '1',
+		'assembly'           : False,
+		'machine_model'      : 'mdf',
+		'knob'               : [],
+		'clean'              : False,
+		'keep'               : False,
+		'verbose'            : False
+	}
+
+# Compile one module request, returns its result entry
+def compileModule(request):
+	arguments = defaultArguments()
+
+	arguments.update(request)
+
+	result = {'output_file' : arguments['output_file']}
+
+	try:
+		driver = CompilerDriver(arguments)
+
+		driver.run()
+
+		result['ok'] = True
+
+	except Exception as e:
+		result['ok']    = False
+		result['error'] = str(e)
+
+	return result
+
+# The compile server.  Requests are served one at a time, the compiles
+#  themselves are serial anyway
+class CompilerDaemon:
+	def __init__(self, socketPath = None):
+		if socketPath == None:
+			socketPath = defaultSocketPath()
+
+		self.socketPath = socketPath
+
+	def run(self):
+		if os.path.exists(self.socketPath):
+			os.remove(self.socketPath)
+
+		server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+
+		server.bind(self.socketPath)
+		server.listen(4)
+
+		print "vir-compiler daemon listening on " + self.socketPath
+
+		try:
+			while True:
+				connection, address = server.accept()
+
+				try:
+					self.serve(connection)
+				finally:
+					connection.close()
+		finally:
+			server.close()
+			os.remove(self.socketPath)
+
+	def serve(self, connection):
+		request = json.loads(receiveLine(connection))
+
+		if 'shutdown' in request:
+			connection.sendall(json.dumps({'ok' : True}) + '\n')
+			raise SystemExit
+
+		results = [compileModule(module) for module in
+			request.get('modules', [])]
+
+		connection.sendall(json.dumps({'results' : results}) + '\n')
+
+# Send a batch of module requests to a running daemon, returns the results
+def submit(modules, socketPath = None):
+	if socketPath == None:
+		socketPath = defaultSocketPath()
+
+	connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+
+	try:
+		connection.connect(socketPath)
+
+		connection.sendall(json.dumps({'modules' : modules}) + '\n')
+
+		reply = json.loads(receiveLine(connection))
+	finally:
+		connection.close()
+
+	return reply['results']
+
+def receiveLine(connection):
+	data = ''
+
+	while not data.endswith('\n'):
+		chunk = connection.recv(4096)
+
+		if len(chunk) == 0:
+			break
+
+		data += chunk
+
+	return data
@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/BasicBlock.h>
 #include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/PackedBasicBlock.h>
 
 #include <vanaheimr/compiler/interface/Compiler.h>
 
@@ -22,7 +23,7 @@ namespace ir
 BasicBlock::BasicBlock(Function* f, Id i, const std::string& name)
 : Variable(name, f->module(),
 	compiler::Compiler::getSingleton()->getBasicBlockType(),
-	InternalLinkage, HiddenVisibility), _function(f), _id(i)
+	InternalLinkage, HiddenVisibility), _function(f), _id(i), _size(0)
 {
 
 }
@@ -33,7 +34,7 @@ BasicBlock::~BasicBlock()
 }
 
 BasicBlock::BasicBlock(const BasicBlock& bb)
-: Variable(bb), _function(bb.function()), _id(bb.id())
+: Variable(bb), _function(bb.function()), _id(bb.id()), _size(0)
 {
 	for(auto instruction : bb)
 	{
@@ -82,7 +83,7 @@ void BasicBlock::setTerminator(Instruction* i)
 {
 	if(terminator() != 0)
 	{
-		delete back();
+		Instruction::dispose(back());
 		back() = i->clone();
 	}
 	else
@@ -180,7 +181,7 @@ bool BasicBlock::empty() const
 
 size_t BasicBlock::size() const
 {
-	return _instructions.size();
+	return _size;
 }
 
 BasicBlock::Id BasicBlock::id() const
@@ -196,25 +197,41 @@ Function* BasicBlock::function() const
 void BasicBlock::push_back(Instruction* i)
 {
 	i->block = this;
-	
+
 	_instructions.push_back(i);
+
+	++_size;
+
+	_invalidateFunctionCount();
 }
 
 void BasicBlock::push_front(Instruction* i)
 {
 	i->block = this;
-	
+
 	_instructions.push_front(i);
+
+	++_size;
+
+	_invalidateFunctionCount();
 }
 
 void BasicBlock::pop_back()
 {
 	_instructions.pop_back();
+
+	--_size;
+
+	_invalidateFunctionCount();
 }
 
 void BasicBlock::pop_front()
 {
 	_instructions.pop_front();
+
+	--_size;
+
+	_invalidateFunctionCount();
 }
 
 BasicBlock::iterator BasicBlock::insert(
@@ -227,12 +244,21 @@ BasicBlock::iterator BasicBlock::insert(
 
 BasicBlock::iterator BasicBlock::insert(iterator position, Instruction* i)
 {
+	++_size;
+
+	_invalidateFunctionCount();
+
 	return _instructions.insert(position, i);
 }
 
 BasicBlock::iterator BasicBlock::erase(iterator position)
 {
-	delete *position;
+	Instruction::dispose(*position);
+
+	--_size;
+
+	_invalidateFunctionCount();
+
 	return _instructions.erase(position);
 }
 
@@ -244,12 +270,63 @@ BasicBlock::iterator BasicBlock::erase(const Instruction* pointer)
 }
 	
 
+void BasicBlock::splice(iterator position, BasicBlock& from)
+{
+	splice(position, from, from.begin(), from.end());
+}
+
+void BasicBlock::splice(iterator position, BasicBlock& from,
+	iterator instruction)
+{
+	(*instruction)->block = this;
+
+	_instructions.splice(position, from._instructions, instruction);
+
+	--from._size;
+	++_size;
+
+	from._invalidateFunctionCount();
+	_invalidateFunctionCount();
+}
+
+void BasicBlock::splice(iterator position, BasicBlock& from,
+	iterator first, iterator last)
+{
+	size_t moved = 0;
+
+	for(iterator instruction = first; instruction != last; ++instruction)
+	{
+		(*instruction)->block = this;
+
+		++moved;
+	}
+
+	_instructions.splice(position, from._instructions, first, last);
+
+	from._size -= moved;
+	_size      += moved;
+
+	from._invalidateFunctionCount();
+	_invalidateFunctionCount();
+}
+
+PackedBasicBlock BasicBlock::seal()
+{
+	return PackedBasicBlock(*this);
+}
+
 void BasicBlock::clear()
 {
 	for(auto instruction : *this)
 	{
-		delete instruction;
+		Instruction::dispose(instruction);
 	}
+
+	_instructions.clear();
+
+	_size = 0;
+
+	_invalidateFunctionCount();
 }
 
 void BasicBlock::setFunction(Function* f)
@@ -262,6 +339,11 @@ void BasicBlock::setName(const std::string& n)
 	_setName(n);
 }
 
+void BasicBlock::_invalidateFunctionCount()
+{
+	if(_function != 0) _function->invalidateInstructionCount();
+}
+
 }
 
 }
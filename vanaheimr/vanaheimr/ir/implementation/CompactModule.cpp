@@ -0,0 +1,175 @@
+/*! \file   CompactModule.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the CompactModule class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/CompactModule.h>
+#include <vanaheimr/ir/interface/Module.h>
+
+// Standard Library Includes
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+static CompactModule::Id registerIdOfOperand(Operand* operand)
+{
+	if(operand == nullptr || !operand->isRegister())
+	{
+		return CompactModule::InvalidId;
+	}
+
+	auto registerOperand = static_cast<RegisterOperand*>(operand);
+
+	if(registerOperand->virtualRegister == nullptr)
+	{
+		return CompactModule::InvalidId;
+	}
+
+	return registerOperand->virtualRegister->id;
+}
+
+CompactModule::CompactModule(Module& module)
+{
+	for(auto function = module.begin();
+		function != module.end(); ++function)
+	{
+		function->materialize();
+
+		CompactFunction compactFunction;
+
+		compactFunction.blockBegin    = blocks.size();
+		compactFunction.registerCount = function->register_size();
+
+		Id functionId = functions.size();
+
+		for(auto block = function->begin();
+			block != function->end(); ++block)
+		{
+			CompactBasicBlock compactBlock;
+
+			compactBlock.function         = functionId;
+			compactBlock.instructionBegin = instructions.size();
+
+			Id blockId = blocks.size();
+
+			for(auto instruction : *block)
+			{
+				CompactInstruction compactInstruction;
+
+				compactInstruction.opcode = instruction->opcode;
+				compactInstruction.block  = blockId;
+				compactInstruction.guard  =
+					registerIdOfOperand(instruction->guard());
+
+				compactInstruction.readBegin = operandRegisters.size();
+
+				// skip the guard, reads[0], it is recorded separately
+				for(unsigned int read = 1;
+					read < instruction->reads.size(); ++read)
+				{
+					operandRegisters.push_back(
+						registerIdOfOperand(instruction->reads[read]));
+				}
+
+				compactInstruction.readEnd    = operandRegisters.size();
+				compactInstruction.writeBegin = operandRegisters.size();
+
+				for(auto write : instruction->writes)
+				{
+					operandRegisters.push_back(registerIdOfOperand(write));
+				}
+
+				compactInstruction.writeEnd = operandRegisters.size();
+
+				instructions.push_back(compactInstruction);
+				_instructions.push_back(instruction);
+			}
+
+			compactBlock.instructionEnd = instructions.size();
+
+			blocks.push_back(compactBlock);
+			_blocks.push_back(&*block);
+		}
+
+		compactFunction.blockEnd = blocks.size();
+
+		functions.push_back(compactFunction);
+		_functions.push_back(&*function);
+	}
+}
+
+CompactModule::iterator CompactModule::begin() const
+{
+	return functions.begin();
+}
+
+CompactModule::iterator CompactModule::end() const
+{
+	return functions.end();
+}
+
+CompactModule::block_iterator CompactModule::block_begin() const
+{
+	return blocks.begin();
+}
+
+CompactModule::block_iterator CompactModule::block_end() const
+{
+	return blocks.end();
+}
+
+CompactModule::instruction_iterator CompactModule::instruction_begin() const
+{
+	return instructions.begin();
+}
+
+CompactModule::instruction_iterator CompactModule::instruction_end() const
+{
+	return instructions.end();
+}
+
+size_t CompactModule::size() const
+{
+	return functions.size();
+}
+
+size_t CompactModule::block_size() const
+{
+	return blocks.size();
+}
+
+size_t CompactModule::instruction_size() const
+{
+	return instructions.size();
+}
+
+Function* CompactModule::function(Id id) const
+{
+	assert(id < _functions.size());
+
+	return _functions[id];
+}
+
+BasicBlock* CompactModule::basicBlock(Id id) const
+{
+	assert(id < _blocks.size());
+
+	return _blocks[id];
+}
+
+Instruction* CompactModule::instruction(Id id) const
+{
+	assert(id < _instructions.size());
+
+	return _instructions[id];
+}
+
+}
+
+}
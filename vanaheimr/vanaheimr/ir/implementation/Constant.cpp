@@ -249,6 +249,16 @@ void* ArrayConstant::storage()
 	return _value.data();
 }
 
+const void* ArrayConstant::storage() const
+{
+	return _value.data();
+}
+
+size_t ArrayConstant::bytes() const
+{
+	return _value.size();
+}
+
 }
 
 }
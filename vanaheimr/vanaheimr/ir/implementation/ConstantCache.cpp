@@ -0,0 +1,106 @@
+/*! \file   ConstantCache.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ConstantCache class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/ConstantCache.h>
+#include <vanaheimr/ir/interface/Constant.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+ConstantCache::ConstantCache()
+{
+
+}
+
+ConstantCache::~ConstantCache()
+{
+	for(auto& constant : _constants) delete constant.second;
+}
+
+const Constant* ConstantCache::getOrInsert(const Constant& constant)
+{
+	std::string key = _key(constant);
+
+	auto existing = _constants.find(key);
+
+	if(existing != _constants.end()) return existing->second;
+
+	auto inserted = _constants.insert(
+		std::make_pair(key, constant.clone()));
+
+	return inserted.first->second;
+}
+
+const Constant* ConstantCache::getFoldedValue(unsigned int opcode,
+	const ConstantVector& operands) const
+{
+	auto fold = _folds.find(_foldKey(opcode, operands));
+
+	if(fold != _folds.end()) return fold->second;
+
+	return nullptr;
+}
+
+const Constant* ConstantCache::insertFoldedValue(unsigned int opcode,
+	const ConstantVector& operands, const Constant& value)
+{
+	const Constant* uniqued = getOrInsert(value);
+
+	_folds.insert(std::make_pair(_foldKey(opcode, operands), uniqued));
+
+	return uniqued;
+}
+
+size_t ConstantCache::size() const
+{
+	return _constants.size();
+}
+
+bool ConstantCache::empty() const
+{
+	return _constants.empty();
+}
+
+std::string ConstantCache::_key(const Constant& constant)
+{
+	std::string key;
+
+	if(constant.type() != nullptr)
+	{
+		key = constant.type()->name;
+	}
+
+	key.push_back(':');
+
+	auto data = constant.data();
+
+	key.append(data.begin(), data.end());
+
+	return key;
+}
+
+std::string ConstantCache::_foldKey(unsigned int opcode,
+	const ConstantVector& operands)
+{
+	std::string key(1, (char)opcode);
+
+	for(auto operand : operands)
+	{
+		key.push_back('|');
+		key += _key(*operand);
+	}
+
+	return key;
+}
+
+}
+
+}
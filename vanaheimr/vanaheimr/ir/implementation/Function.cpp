@@ -6,6 +6,8 @@
 
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/FunctionMaterializer.h>
+#include <vanaheimr/ir/interface/FunctionCloneMaterializer.h>
 #include <vanaheimr/ir/interface/Type.h>
 
 #include <vanaheimr/compiler/interface/Compiler.h>
@@ -31,18 +33,25 @@ namespace ir
 
 Function::Function(const std::string& n, Module* m, Linkage l, Visibility v,
 	const Type* t)
-: Variable(n, m, t, l, v), _nextBlockId(0), _nextRegisterId(0)
+: Variable(n, m, t, l, v), _nextBlockId(0), _nextRegisterId(0),
+	_materializer(nullptr), _instructionCount(0), _instructionCountValid(true)
 {
 	_entry = newBasicBlock(end(), "__Entry");
 	_exit  = newBasicBlock(end(), "__Exit");
 }
 
 Function::Function(const Function& f)
-: Variable(f), _nextBlockId(0), _nextRegisterId(0)
+: Variable(f), _nextBlockId(0), _nextRegisterId(0), _materializer(nullptr),
+	_instructionCount(0), _instructionCountValid(true)
 {
 	operator=(f);
 }
 
+Function::~Function()
+{
+	delete _materializer;
+}
+
 Function& Function::operator=(const Function& f)
 {
 	typedef std::unordered_map<VirtualRegister::Id,
@@ -53,9 +62,17 @@ Function& Function::operator=(const Function& f)
 		BasicBlock*> BasicBlockMap;
 
 	if(&f == this) return *this;
-	
+
+	// deep copies need the source body, force it in
+	const_cast<Function&>(f).materialize();
+
 	clear();
-	
+
+	// a pending deferred body would overwrite this copy when it ran
+	delete _materializer;
+
+	_materializer = nullptr;
+
 	_nextBlockId = f._nextBlockId;
 
 	BasicBlockMap basicBlockMapping;
@@ -123,7 +140,7 @@ Function& Function::operator=(const Function& f)
 						registerMapping.find(reg->virtualRegister->id);
 					assert(mapping != registerMapping.end());
 					
-					reg->virtualRegister = mapping->second;
+					reg->setVirtualRegister(mapping->second);
 				}
 
 				if(operand->isArgument())
@@ -165,12 +182,15 @@ Function& Function::operator=(const Function& f)
 						registerMapping.find(reg->virtualRegister->id);
 					assert(mapping != registerMapping.end());
 					
-					reg->virtualRegister = mapping->second;
+					reg->setVirtualRegister(mapping->second);
 				}
 			}
 		}
 	}
-	
+
+	// the copied blocks notified the source function, not this one
+	invalidateInstructionCount();
+
 	return *this;
 }
 
@@ -456,6 +476,17 @@ void Function::moveBasicBlock(iterator position, iterator block)
 	_blocks.splice(position, _blocks, block);
 }
 
+Function::iterator Function::erase(iterator block)
+{
+	assert(block != _entry);
+	assert(block != _exit);
+
+	invalidateInstructionCount();
+
+	// the block's destructor disposes of its instructions
+	return _blocks.erase(block);
+}
+
 Function::local_iterator Function::local_begin()
 {
 	return _locals.begin();
@@ -492,10 +523,38 @@ Function::local_iterator Function::findLocalValue(const std::string& name)
 	{
 		if(local->name() == name) return local;
 	}
-	
+
 	return local_end();
 }
 
+size_t Function::instruction_size() const
+{
+	if(!_instructionCountValid)
+	{
+		size_t count = 0;
+
+		for(auto block = begin(); block != end(); ++block)
+		{
+			count += block->size();
+		}
+
+		_instructionCount      = count;
+		_instructionCountValid = true;
+	}
+
+	return _instructionCount;
+}
+
+bool Function::instruction_empty() const
+{
+	return instruction_size() == 0;
+}
+
+void Function::invalidateInstructionCount()
+{
+	_instructionCountValid = false;
+}
+
 Function::Id Function::id() const
 {
 	for(auto function = module()->begin();
@@ -521,6 +580,59 @@ void Function::clear()
 
 	_entry = newBasicBlock(end(), "__Entry");
 	_exit  = newBasicBlock(end(), "__Exit" );
+
+	invalidateInstructionCount();
+}
+
+bool Function::isMaterialized() const
+{
+	return _materializer == nullptr;
+}
+
+void Function::setMaterializer(FunctionMaterializer* materializer)
+{
+	_materializer = materializer;
+}
+
+void Function::materialize()
+{
+	if(_materializer == nullptr) return;
+	
+	// clear first so a materializer failure cannot run twice
+	auto materializer = _materializer;
+	
+	_materializer = nullptr;
+	
+	materializer->materializeFunction(*this);
+
+	delete materializer;
+}
+
+void Function::assignDeferred(const Function& f)
+{
+	if(&f == this) return;
+
+	clear();
+
+	delete _materializer;
+
+	// the signature is copied eagerly, call sites and cost models read
+	// it without forcing the body in
+	_arguments    = f._arguments;
+	_returnValues = f._returnValues;
+
+	for(auto argument = argument_begin();
+		argument != argument_end(); ++argument)
+	{
+		argument->setFunction(this);
+	}
+
+	for(auto value = returned_begin(); value != returned_end(); ++value)
+	{
+		value->setFunction(this);
+	}
+
+	_materializer = new FunctionCloneMaterializer(f);
 }
 
 void Function::interpretType()
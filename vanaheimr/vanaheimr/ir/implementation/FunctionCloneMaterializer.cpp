@@ -0,0 +1,31 @@
+/*! \file   FunctionCloneMaterializer.cpp
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the FunctionCloneMaterializer class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/FunctionCloneMaterializer.h>
+#include <vanaheimr/ir/interface/Function.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+FunctionCloneMaterializer::FunctionCloneMaterializer(const Function& source)
+: _source(&source)
+{
+
+}
+
+void FunctionCloneMaterializer::materializeFunction(Function& function)
+{
+	// the assignment forces the source in and deep copies it
+	function = *_source;
+}
+
+}
+
+}
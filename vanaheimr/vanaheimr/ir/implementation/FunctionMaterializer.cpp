@@ -0,0 +1,23 @@
+/*! \file   FunctionMaterializer.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the FunctionMaterializer class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/FunctionMaterializer.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+FunctionMaterializer::~FunctionMaterializer()
+{
+
+}
+
+}
+
+}
@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/Instruction.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Module.h>
 
 #include <vanaheimr/ir/interface/MetaData.h>
 #include <vanaheimr/ir/interface/Type.h>
@@ -27,7 +28,7 @@ namespace ir
 {
 
 Instruction::Instruction(Opcode o, BasicBlock* b, Id id)
-: opcode(o), block(b), _id(id), _metadata(nullptr)
+: opcode(o), block(b), _id(id), _metadata(nullptr), _inArena(false)
 {
 	reads.push_back(nullptr); // for the guard
 }
@@ -38,7 +39,8 @@ Instruction::~Instruction()
 }
 
 Instruction::Instruction(const Instruction& i)
-: opcode(i.opcode), block(i.block), _id(i.id())
+: opcode(i.opcode), block(i.block), _id(i.id()), _metadata(nullptr),
+	_inArena(false)
 {
 	for(auto operand : i.reads)
 	{
@@ -113,7 +115,7 @@ Instruction& Instruction::operator=(const Instruction& i)
 
 void Instruction::setGuard(PredicateOperand* p)
 {
-	delete guard();
+	Operand::dispose(guard());
 	
 	reads[0] = p;
 }
@@ -177,7 +179,7 @@ void Instruction::replaceOperand(Operand* original, Operand* newOperand)
 	{
 		if(*read == original)
 		{
-			delete *read;
+			Operand::dispose(*read);
 			*read = newOperand;
 			return;
 		}
@@ -187,7 +189,7 @@ void Instruction::replaceOperand(Operand* original, Operand* newOperand)
 	{
 		if(*write == original)
 		{
-			delete *write;
+			Operand::dispose(*write);
 			*write = newOperand;
 			return;
 		}
@@ -342,8 +344,8 @@ void Instruction::eraseFromBlock()
 
 void Instruction::clear()
 {
-	for(auto operand : reads)  delete operand;
-	for(auto operand : writes) delete operand;
+	for(auto operand : reads)  Operand::dispose(operand);
+	for(auto operand : writes) Operand::dispose(operand);
 	
 	 reads.clear();
 	writes.clear();
@@ -456,51 +458,78 @@ std::string Instruction::toString(Opcode o)
 	return "InvalidOpcode";
 }
 
+/*! \brief Allocate an instruction from the module arena when the block is
+	attached to a module, otherwise fall back on the global heap */
+template<typename T>
+static Instruction* createInstruction(BasicBlock* b)
+{
+	if(b != nullptr && b->module() != nullptr)
+	{
+		T* instruction = b->module()->arena().construct<T>();
+		
+		instruction->markAsArenaAllocated();
+		
+		return instruction;
+	}
+	
+	return new T;
+}
+
+bool Instruction::isArenaAllocated() const
+{
+	return _inArena;
+}
+
+void Instruction::markAsArenaAllocated()
+{
+	_inArena = true;
+}
+
 Instruction* Instruction::create(Opcode o, BasicBlock* b)
 {
 	ir::Instruction* instruction = nullptr;
 
 	switch(o)
 	{
-	case Add:           instruction = new ir::Add;           break;
-	case And:           instruction = new ir::And;           break;
-	case Ashr:          instruction = new ir::Ashr;          break;
-	case Atom:          instruction = new ir::Atom;          break;
-	case Bar:           instruction = new ir::Bar;           break;
-	case Bitcast:       instruction = new ir::Bitcast;       break;
-	case Bra:           instruction = new ir::Bra;           break;
-	case Call:          instruction = new ir::Call;          break;
-	case Fdiv:          instruction = new ir::Fdiv;          break;
-	case Fmul:          instruction = new ir::Fmul;          break;
-	case Fpext:         instruction = new ir::Fpext;         break;
-	case Fptosi:        instruction = new ir::Fptosi;        break;
-	case Fptoui:        instruction = new ir::Fptoui;        break;
-	case Fptrunc:       instruction = new ir::Fptrunc;       break;
-	case Frem:          instruction = new ir::Frem;          break;
-	case Getelementptr: instruction = new ir::Getelementptr; break;
-	case Launch:        instruction = new ir::Launch;        break;
-	case Ld:            instruction = new ir::Ld;            break;
-	case Lshr:          instruction = new ir::Lshr;          break;
-	case Membar:        instruction = new ir::Membar;        break;
-	case Mul:           instruction = new ir::Mul;           break;
-	case Or:            instruction = new ir::Or;            break;
-	case Ret:           instruction = new ir::Ret;           break;
-	case Setp:          instruction = new ir::Setp;          break;
-	case Sext:          instruction = new ir::Sext;          break;
-	case Sdiv:          instruction = new ir::Sdiv;          break;
-	case Shl:           instruction = new ir::Shl;           break;
-	case Sitofp:        instruction = new ir::Sitofp;        break;
-	case Srem:          instruction = new ir::Srem;          break;
-	case St:            instruction = new ir::St;            break;
-	case Sub:           instruction = new ir::Sub;           break;
-	case Trunc:         instruction = new ir::Trunc;         break;
-	case Udiv:          instruction = new ir::Udiv;          break;
-	case Uitofp:        instruction = new ir::Uitofp;        break;
-	case Urem:          instruction = new ir::Urem;          break;
-	case Xor:           instruction = new ir::Xor;           break;
-	case Zext:          instruction = new ir::Zext;          break;
-	case Phi:           instruction = new ir::Phi;           break;
-	case Psi:           instruction = new ir::Psi;           break;
+	case Add:           instruction = createInstruction<ir::Add>(b);           break;
+	case And:           instruction = createInstruction<ir::And>(b);           break;
+	case Ashr:          instruction = createInstruction<ir::Ashr>(b);          break;
+	case Atom:          instruction = createInstruction<ir::Atom>(b);          break;
+	case Bar:           instruction = createInstruction<ir::Bar>(b);           break;
+	case Bitcast:       instruction = createInstruction<ir::Bitcast>(b);       break;
+	case Bra:           instruction = createInstruction<ir::Bra>(b);           break;
+	case Call:          instruction = createInstruction<ir::Call>(b);          break;
+	case Fdiv:          instruction = createInstruction<ir::Fdiv>(b);          break;
+	case Fmul:          instruction = createInstruction<ir::Fmul>(b);          break;
+	case Fpext:         instruction = createInstruction<ir::Fpext>(b);         break;
+	case Fptosi:        instruction = createInstruction<ir::Fptosi>(b);        break;
+	case Fptoui:        instruction = createInstruction<ir::Fptoui>(b);        break;
+	case Fptrunc:       instruction = createInstruction<ir::Fptrunc>(b);       break;
+	case Frem:          instruction = createInstruction<ir::Frem>(b);          break;
+	case Getelementptr: instruction = createInstruction<ir::Getelementptr>(b); break;
+	case Launch:        instruction = createInstruction<ir::Launch>(b);        break;
+	case Ld:            instruction = createInstruction<ir::Ld>(b);            break;
+	case Lshr:          instruction = createInstruction<ir::Lshr>(b);          break;
+	case Membar:        instruction = createInstruction<ir::Membar>(b);        break;
+	case Mul:           instruction = createInstruction<ir::Mul>(b);           break;
+	case Or:            instruction = createInstruction<ir::Or>(b);            break;
+	case Ret:           instruction = createInstruction<ir::Ret>(b);           break;
+	case Setp:          instruction = createInstruction<ir::Setp>(b);          break;
+	case Sext:          instruction = createInstruction<ir::Sext>(b);          break;
+	case Sdiv:          instruction = createInstruction<ir::Sdiv>(b);          break;
+	case Shl:           instruction = createInstruction<ir::Shl>(b);           break;
+	case Sitofp:        instruction = createInstruction<ir::Sitofp>(b);        break;
+	case Srem:          instruction = createInstruction<ir::Srem>(b);          break;
+	case St:            instruction = createInstruction<ir::St>(b);            break;
+	case Sub:           instruction = createInstruction<ir::Sub>(b);           break;
+	case Trunc:         instruction = createInstruction<ir::Trunc>(b);         break;
+	case Udiv:          instruction = createInstruction<ir::Udiv>(b);          break;
+	case Uitofp:        instruction = createInstruction<ir::Uitofp>(b);        break;
+	case Urem:          instruction = createInstruction<ir::Urem>(b);          break;
+	case Xor:           instruction = createInstruction<ir::Xor>(b);           break;
+	case Zext:          instruction = createInstruction<ir::Zext>(b);          break;
+	case Phi:           instruction = createInstruction<ir::Phi>(b);           break;
+	case Psi:           instruction = createInstruction<ir::Psi>(b);           break;
 	case Machine:       break;
 	case InvalidOpcode: break;
 	}
@@ -517,6 +546,14 @@ Instruction* Instruction::create(const std::string& opcode, BasicBlock* b)
 	return create(parseOpcode(opcode), b);
 }
 
+void Instruction::dispose(Instruction* i)
+{
+	if(i == nullptr) return;
+	
+	// arena instructions are destroyed when the owning module is
+	if(!i->isArenaAllocated()) delete i;
+}
+
 UnaryInstruction::UnaryInstruction(Opcode o, BasicBlock* b)
 : Instruction(o, b)
 {
@@ -526,14 +563,14 @@ UnaryInstruction::UnaryInstruction(Opcode o, BasicBlock* b)
 
 void UnaryInstruction::setD(Operand* o)
 {
-	delete d();
+	Operand::dispose(d());
 	
 	d() = o;
 }
 
 void UnaryInstruction::setA(Operand* o)
 {
-	delete a();
+	Operand::dispose(a());
 	
 	a() = o;
 }
@@ -576,21 +613,21 @@ BinaryInstruction::BinaryInstruction(Opcode o, BasicBlock* bb)
 
 void BinaryInstruction::setD(Operand* o)
 {
-	delete d();
+	Operand::dispose(d());
 	
 	d() = o;
 }
 
 void BinaryInstruction::setA(Operand* o)
 {
-	delete a();
+	Operand::dispose(a());
 	
 	a() = o;
 }
 
 void BinaryInstruction::setB(Operand* o)
 {
-	delete b();
+	Operand::dispose(b());
 	
 	b() = o;
 }	
@@ -758,7 +795,7 @@ Bra::Bra(BranchModifier m, BasicBlock* b)
 
 void Bra::setTarget(Operand* o)
 {
-	delete target();
+	Operand::dispose(target());
 
 	target() = o;
 }
@@ -827,7 +864,7 @@ bool Call::isIntrinsic() const
 
 void Call::setTarget(Operand* o)
 {
-	delete target();
+	Operand::dispose(target());
 
 	target() = o;	
 }
@@ -858,7 +895,7 @@ const Instruction::OperandPointer& Call::target() const
 
 Call::OperandVector Call::returned()
 {
-	return writes;
+	return OperandVector(writes.begin(), writes.end());
 }
 
 Call::ConstOperandVector Call::returned() const
@@ -1198,14 +1235,14 @@ St::St(BasicBlock* b)
 
 void St::setD(Operand* o)
 {
-	delete d();
+	Operand::dispose(d());
 	
 	d() = o;
 }
 
 void St::setA(Operand* o)
 {
-	delete a();
+	Operand::dispose(a());
 	
 	a() = o;
 }
@@ -1351,7 +1388,7 @@ Phi& Phi::operator=(const Phi& i)
 
 void Phi::setD(RegisterOperand* o)
 {
-	delete d();
+	Operand::dispose(d());
 	
 	writes[0] = o;
 }
@@ -1375,9 +1412,9 @@ void Phi::removeSource(BasicBlock* predecessor)
 		if(operand->globalValue != predecessor) continue;
 		
 		--readPosition;
-		delete *readPosition;
+		Operand::dispose(*readPosition);
 		readPosition = reads.erase(readPosition);
-		delete *readPosition;
+		Operand::dispose(*readPosition);
 		reads.erase(readPosition);
 		
 		break;
@@ -1524,7 +1561,7 @@ Psi::Psi(BasicBlock* b)
 
 void Psi::setD(RegisterOperand* o)
 {
-	delete d();
+	Operand::dispose(d());
 	
 	writes[0] = o;
 }
@@ -46,24 +46,30 @@ Module& Module::operator=(const Module& m)
 	
 	name      = m.name;
 	_compiler = m._compiler;
-	
-	for(auto function : _functions)
+
+	for(auto& function : m._functions)
 	{
-		_functions.push_back(function);
-		_functions.back().setModule(this);
+		auto copy = _functions.insert(_functions.end(), function);
+
+		copy->setModule(this);
+
+		_functionIndex[copy->name()] = copy;
 	}
-	
-	for(auto global : _globals)
+
+	for(auto& global : m._globals)
 	{
-		_globals.push_back(global);
-		_globals.back().setModule(this);
+		auto copy = _globals.insert(_globals.end(), global);
+
+		copy->setModule(this);
+
+		_globalIndex[copy->name()] = copy;
 	}
-	
-	for(auto constant : _constants)
+
+	for(auto constant : m._constants)
 	{
 		_constants.push_back(constant->clone());
 	}
-	
+
 	return *this;
 }
 
@@ -78,89 +84,114 @@ Module::~Module()
 
 Module::iterator Module::getFunction(const std::string& name)
 {
-	for(iterator function = begin(); function != end(); ++function)
-	{
-		if(function->name() == name) return function;
-	}
-	
-	return end();
+	auto entry = _functionIndex.find(name);
+
+	if(entry == _functionIndex.end()) return end();
+
+	entry->second->materialize();
+
+	return entry->second;
 }
 
 Module::const_iterator Module::getFunction(const std::string& name) const
 {
-	for(const_iterator function = begin(); function != end(); ++function)
-	{
-		if(function->name() == name) return function;
-	}
-	
-	return end();
+	auto entry = _functionIndex.find(name);
+
+	if(entry == _functionIndex.end()) return end();
+
+	return entry->second;
 }
 
 Module::iterator Module::insertFunction(iterator position, const Function& f)
 {
-	return _functions.insert(position, f);
+	iterator function = _functions.insert(position, f);
+
+	_functionIndex[function->name()] = function;
+
+	return function;
 }
 
 Module::iterator Module::newFunction(const std::string& name,
 	Variable::Linkage l, Variable::Visibility v, const ir::Type* t)
 {
 	assert(getFunction(name) == end());
-	
-	return _functions.insert(end(), Function(name, this, l, v, t));
+
+	return insertFunction(end(), Function(name, this, l, v, t));
 }
 
 Module::iterator Module::removeFunction(iterator f)
 {
+	auto entry = _functionIndex.find(f->name());
+
+	if(entry != _functionIndex.end() && entry->second == f)
+	{
+		_functionIndex.erase(entry);
+	}
+
 	return _functions.erase(f);
 }
 
 Module::global_iterator Module::getGlobal(const std::string& name)
 {
-	for(global_iterator global = global_begin();
-		global != global_end(); ++global)
-	{
-		if(global->name() == name) return global;
-	}
-	
-	return global_end();
+	auto entry = _globalIndex.find(name);
+
+	if(entry == _globalIndex.end()) return global_end();
+
+	return entry->second;
 }
 
 Module::const_global_iterator Module::getGlobal(const std::string& name) const
 {
-	for(const_global_iterator global = global_begin();
-		global != global_end(); ++global)
-	{
-		if(global->name() == name) return global;
-	}
-	
-	return global_end();
+	auto entry = _globalIndex.find(name);
+
+	if(entry == _globalIndex.end()) return global_end();
+
+	return entry->second;
 }
 
 Module::global_iterator Module::insertGlobal(global_iterator position,
 	const Global& g)
 {
-	return _globals.insert(position, g);	
+	global_iterator global = _globals.insert(position, g);
+
+	_globalIndex[global->name()] = global;
+
+	return global;
 }
 
 Module::global_iterator Module::newGlobal(const std::string& name,
 	const Type* t, Variable::Linkage l, ir::Global::Level le)
 {
-	return _globals.insert(_globals.end(), Global(name, this, t, l,
+	return insertGlobal(_globals.end(), Global(name, this, t, l,
 		Variable::HiddenVisibility, 0, le));
 }
 
 Module::global_iterator Module::removeGlobal(global_iterator g)
 {
+	auto entry = _globalIndex.find(g->name());
+
+	if(entry != _globalIndex.end() && entry->second == g)
+	{
+		_globalIndex.erase(entry);
+	}
+
 	return _globals.erase(g);
 }
 
 void Module::writeBinary(std::ostream& stream) const
 {
 	as::BinaryWriter writer;
-	
+
 	writer.write(stream, *this);
 }
 
+void Module::patchBinary(std::iostream& stream) const
+{
+	as::BinaryWriter writer;
+
+	writer.writeIncremental(stream, *this);
+}
+
 void Module::writeAssembly(std::ostream& stream) const
 {
 	as::AssemblyWriter writer;
@@ -265,6 +296,39 @@ void Module::clear()
 	_functions.clear();
 	_globals.clear();
 	_constants.clear();
+
+	_functionIndex.clear();
+	_globalIndex.clear();
+
+	_arena.clear();
+}
+
+void Module::materializeAll()
+{
+	for(auto function = begin(); function != end(); ++function)
+	{
+		function->materialize();
+	}
+}
+
+util::Arena& Module::arena()
+{
+	return _arena;
+}
+
+const util::Arena& Module::arena() const
+{
+	return _arena;
+}
+
+ConstantCache& Module::constantCache()
+{
+	return _constantCache;
+}
+
+const ConstantCache& Module::constantCache() const
+{
+	return _constantCache;
 }
 
 }
@@ -22,14 +22,38 @@ namespace ir
 {
 
 Operand::Operand(OperandMode mode, Instruction* i)
-: instruction(i), _mode(mode)
+: instruction(i), _mode(mode), _inArena(false)
+{
+
+}
+
+Operand::Operand(const Operand& o)
+: instruction(o.instruction), _mode(o._mode), _inArena(false)
 {
 
 }
 
 Operand::~Operand()
 {
-	
+
+}
+
+bool Operand::isArenaAllocated() const
+{
+	return _inArena;
+}
+
+void Operand::markAsArenaAllocated()
+{
+	_inArena = true;
+}
+
+void Operand::dispose(Operand* operand)
+{
+	if(operand == nullptr) return;
+
+	// arena operands are destroyed when the owning module is
+	if(!operand->isArenaAllocated()) delete operand;
 }
 
 bool Operand::isRegister() const
@@ -95,9 +119,80 @@ Constant* Operand::getConstantValue() const
 }
 
 RegisterOperand::RegisterOperand(VirtualRegister* reg, Instruction* i)
-: Operand(Register, i), virtualRegister(reg)
+: Operand(Register, i), virtualRegister(reg),
+	_nextUse(nullptr), _prevUse(nullptr)
 {
+	_linkUse();
+}
+
+RegisterOperand::RegisterOperand(const RegisterOperand& r)
+: Operand(r), virtualRegister(r.virtualRegister),
+	_nextUse(nullptr), _prevUse(nullptr)
+{
+	_linkUse();
+}
+
+RegisterOperand::~RegisterOperand()
+{
+	_unlinkUse();
+}
+
+RegisterOperand& RegisterOperand::operator=(const RegisterOperand& r)
+{
+	if(this == &r) return *this;
+	
+	Operand::operator=(r);
+	
+	setVirtualRegister(r.virtualRegister);
 	
+	return *this;
+}
+
+void RegisterOperand::setVirtualRegister(VirtualRegister* reg)
+{
+	if(reg == virtualRegister) return;
+	
+	_unlinkUse();
+	
+	virtualRegister = reg;
+	
+	_linkUse();
+}
+
+RegisterOperand* RegisterOperand::nextUse() const
+{
+	return _nextUse;
+}
+
+void RegisterOperand::_linkUse()
+{
+	if(virtualRegister == nullptr) return;
+	
+	_prevUse = nullptr;
+	_nextUse = virtualRegister->_firstUse;
+	
+	if(_nextUse != nullptr) _nextUse->_prevUse = this;
+	
+	virtualRegister->_firstUse = this;
+}
+
+void RegisterOperand::_unlinkUse()
+{
+	if(virtualRegister == nullptr) return;
+	
+	if(_prevUse != nullptr)
+	{
+		_prevUse->_nextUse = _nextUse;
+	}
+	else if(virtualRegister->_firstUse == this)
+	{
+		virtualRegister->_firstUse = _nextUse;
+	}
+	
+	if(_nextUse != nullptr) _nextUse->_prevUse = _prevUse;
+	
+	_nextUse = nullptr;
+	_prevUse = nullptr;
 }
 
 const Type* RegisterOperand::type() const
@@ -117,9 +212,10 @@ std::string RegisterOperand::toString() const
 
 RegisterOperand::RegisterOperand(VirtualRegister* reg, Instruction* i,
 	OperandMode m)
-: Operand(m, i), virtualRegister(reg)
+: Operand(m, i), virtualRegister(reg),
+	_nextUse(nullptr), _prevUse(nullptr)
 {
-
+	_linkUse();
 }
 
 ImmediateOperand::ImmediateOperand(uint64_t v, Instruction* i, const Type* t)
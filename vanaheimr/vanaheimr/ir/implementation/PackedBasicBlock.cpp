@@ -0,0 +1,81 @@
+/*! \file   PackedBasicBlock.cpp
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the PackedBasicBlock class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/PackedBasicBlock.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Standard Library Includes
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+PackedBasicBlock::PackedBasicBlock(BasicBlock& block)
+: _block(&block)
+{
+	opcodes.reserve(block.size());
+	guards.reserve(block.size());
+	operandRanges.reserve(block.size());
+	_instructions.reserve(block.size());
+
+	for(auto instruction : block)
+	{
+		OperandRange range;
+
+		range.readBegin = operands.size();
+
+		// skip the guard, reads[0], it is packed separately
+		for(unsigned int read = 1; read < instruction->reads.size(); ++read)
+		{
+			operands.push_back(instruction->reads[read]);
+		}
+
+		range.readEnd     = operands.size();
+		range.writeBegin  = operands.size();
+
+		for(auto write : instruction->writes)
+		{
+			operands.push_back(write);
+		}
+
+		range.writeEnd = operands.size();
+
+		opcodes.push_back(instruction->opcode);
+		guards.push_back(instruction->guard());
+		operandRanges.push_back(range);
+		_instructions.push_back(instruction);
+	}
+}
+
+size_t PackedBasicBlock::size() const
+{
+	return opcodes.size();
+}
+
+bool PackedBasicBlock::empty() const
+{
+	return opcodes.empty();
+}
+
+BasicBlock* PackedBasicBlock::block() const
+{
+	return _block;
+}
+
+Instruction* PackedBasicBlock::instruction(unsigned int index) const
+{
+	assert(index < _instructions.size());
+
+	return _instructions[index];
+}
+
+}
+
+}
@@ -0,0 +1,30 @@
+/*!	\file   ProfileMetaData.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ProfileMetaData class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/ProfileMetaData.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+ProfileMetaData::ProfileMetaData(uint64_t e, uint64_t t)
+: executions(e), taken(t)
+{
+
+}
+
+MetaData* ProfileMetaData::clone() const
+{
+	return new ProfileMetaData(*this);
+}
+
+}
+
+}
+
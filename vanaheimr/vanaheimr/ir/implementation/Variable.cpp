@@ -7,6 +7,8 @@
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/Variable.h>
 
+#include <vanaheimr/compiler/interface/Compiler.h>
+
 namespace vanaheimr
 {
 
@@ -15,7 +17,9 @@ namespace ir
 
 Variable::Variable(const std::string& name, Module* module,
 	const Type* t, Linkage linkage, Visibility v)
-: _name(name), _module(module), _linkage(linkage), _visibility(v), _type(t)
+: _name(name),
+	_nameId(compiler::Compiler::getSingleton()->stringPool().intern(name)),
+	_module(module), _linkage(linkage), _visibility(v), _type(t)
 {
 
 }
@@ -30,6 +34,11 @@ const std::string& Variable::name() const
 	return _name;
 }
 
+util::StringPool::StringId Variable::nameId() const
+{
+	return _nameId;
+}
+
 Module* Variable::module() const
 {
 	return _module;
@@ -57,7 +66,8 @@ void Variable::_setType(const Type* t)
 
 void Variable::_setName(const std::string& n)
 {
-	_name = n;
+	_name   = n;
+	_nameId = compiler::Compiler::getSingleton()->stringPool().intern(n);
 }
 
 }
@@ -6,8 +6,11 @@
 
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Operand.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/compiler/interface/Compiler.h>
+
 // Standard Library Includes
 #include <sstream>
 
@@ -19,9 +22,53 @@ namespace ir
 
 VirtualRegister::VirtualRegister(const std::string& n, Id i,
 	Function* f, const Type* t)
-: name(n), id(i), function(f), type(t)
+: name(n),
+	nameId(compiler::Compiler::getSingleton()->stringPool().intern(n)),
+	id(i), function(f), type(t), _firstUse(nullptr)
+{
+
+}
+
+VirtualRegister::VirtualRegister(const VirtualRegister& r)
+: name(r.name), nameId(r.nameId), id(r.id), function(r.function),
+	type(r.type), _firstUse(nullptr)
+{
+	// uses refer to specific operand objects, they are not copied
+}
+
+VirtualRegister& VirtualRegister::operator=(const VirtualRegister& r)
 {
+	if(this == &r) return *this;
+	
+	name     = r.name;
+	nameId   = r.nameId;
+	id       = r.id;
+	function = r.function;
+	type     = r.type;
+	
+	return *this;
+}
+
+RegisterOperand* VirtualRegister::firstUse() const
+{
+	return _firstUse;
+}
 
+bool VirtualRegister::hasUses() const
+{
+	return _firstUse != nullptr;
+}
+
+size_t VirtualRegister::useCount() const
+{
+	size_t count = 0;
+	
+	for(auto use = _firstUse; use != nullptr; use = use->nextUse())
+	{
+		++count;
+	}
+	
+	return count;
 }
 
 std::string VirtualRegister::toString() const
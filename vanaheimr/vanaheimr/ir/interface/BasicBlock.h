@@ -14,7 +14,8 @@
 #include <list>
 
 // Forward Declarations
-namespace vanaheimr { namespace ir { class Function; } }
+namespace vanaheimr { namespace ir { class Function;         } }
+namespace vanaheimr { namespace ir { class PackedBasicBlock; } }
 
 namespace vanaheimr
 {
@@ -81,6 +82,8 @@ public:
 
 public:
 	bool   empty() const;
+	/*! \brief The instruction count, maintained incrementally so cost
+		models can poll it without walking the list */
 	size_t size()  const;
 
 public:
@@ -112,11 +115,26 @@ public:
 	/*! \brief Erase an instruction from the block, deleting it */
 	iterator erase(const Instruction* position);
 	
+public:
+	/*! \brief Move all instructions from another block to before
+		position.  Ownership transfers without cloning */
+	void splice(iterator position, BasicBlock& from);
+	/*! \brief Move a single instruction from another block */
+	void splice(iterator position, BasicBlock& from, iterator instruction);
+	/*! \brief Move the range [first, last) from another block */
+	void splice(iterator position, BasicBlock& from,
+		iterator first, iterator last);
+
 public:
 	/*! \brief Assign instructions to the block */
 	template <typename Iterator>
 	void assign(Iterator begin, Iterator end);
 	
+public:
+	/*! \brief Seal the block into a packed struct-of-arrays snapshot
+		for analysis-heavy linear sweeps, the block is unchanged */
+	PackedBasicBlock seal();
+
 public:
 	/*! \brief Delete all instructions within the block */
 	void clear();
@@ -127,16 +145,26 @@ public:
 	/*! \brief Set the name of the basic block */
 	void setName(const std::string& name);
 
+private:
+	/*! \brief Tell the owning function that its cached instruction
+		count is stale */
+	void _invalidateFunctionCount();
+
 private:
 	Function*       _function;
 	InstructionList _instructions;
 	Id              _id;
+	size_t          _size;
 };
 
 template <typename Iterator>
 void BasicBlock::assign(Iterator begin, Iterator end)
 {
 	_instructions.assign(begin, end);
+
+	_size = _instructions.size();
+
+	_invalidateFunctionCount();
 }
 
 }
@@ -0,0 +1,149 @@
+/*! \file   CompactModule.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the CompactModule class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Instruction.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Module;     } }
+namespace vanaheimr { namespace ir { class Function;   } }
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief A compact, index-based snapshot of an entire module.
+
+	Entities live in per-module vectors and reference each other with
+	32-bit indices instead of 64-bit pointers, halving the working set
+	that analysis-heavy passes drag through the cache.  The snapshot is
+	read-only; each record keeps an index back to the original object so
+	results can be applied to the mutable IR afterwards. */
+class CompactModule
+{
+public:
+	/*! \brief A 32-bit index into one of the entity vectors */
+	typedef unsigned int Id;
+
+	static const Id InvalidId = (Id)-1;
+
+	/*! \brief A register operand reference, InvalidId when the operand
+		is not a register (immediate, address, ...) */
+	typedef Id OperandId;
+
+	class CompactInstruction
+	{
+	public:
+		Instruction::Opcode opcode;
+
+		/*! \brief The owning block */
+		Id block;
+
+		/*! \brief The guard register, InvalidId when unguarded */
+		Id guard;
+
+		/*! \brief Half-open ranges into operandRegisters */
+		Id readBegin;
+		Id readEnd;
+		Id writeBegin;
+		Id writeEnd;
+	};
+
+	class CompactBasicBlock
+	{
+	public:
+		/*! \brief The owning function */
+		Id function;
+
+		/*! \brief Half-open instruction range, instructions of one
+			block are contiguous */
+		Id instructionBegin;
+		Id instructionEnd;
+	};
+
+	class CompactFunction
+	{
+	public:
+		/*! \brief Half-open block range, blocks of one
+			function are contiguous */
+		Id blockBegin;
+		Id blockEnd;
+
+		/*! \brief The number of virtual registers in the function */
+		Id registerCount;
+	};
+
+	typedef std::vector<CompactInstruction> CompactInstructionVector;
+	typedef std::vector<CompactBasicBlock>  CompactBasicBlockVector;
+	typedef std::vector<CompactFunction>    CompactFunctionVector;
+	typedef std::vector<Id>                 IdVector;
+
+	typedef CompactFunctionVector::const_iterator    iterator;
+	typedef CompactBasicBlockVector::const_iterator  block_iterator;
+	typedef CompactInstructionVector::const_iterator instruction_iterator;
+
+public:
+	/*! \brief Snapshot the module, it is not modified */
+	explicit CompactModule(Module& module);
+
+public:
+	iterator begin() const;
+	iterator end()   const;
+
+	block_iterator block_begin() const;
+	block_iterator block_end()   const;
+
+	instruction_iterator instruction_begin() const;
+	instruction_iterator instruction_end()   const;
+
+public:
+	size_t size()             const;
+	size_t block_size()       const;
+	size_t instruction_size() const;
+
+public:
+	/*! \brief Map a compact id back to the original entity */
+	Function*    function(Id id)    const;
+	BasicBlock*  basicBlock(Id id)  const;
+	Instruction* instruction(Id id) const;
+
+public:
+	/*! \brief The packed function records */
+	CompactFunctionVector functions;
+
+	/*! \brief The packed block records, grouped by function */
+	CompactBasicBlockVector blocks;
+
+	/*! \brief The packed instruction records, grouped by block */
+	CompactInstructionVector instructions;
+
+	/*! \brief Flattened register ids of register operands, indexed by
+		the read/write ranges of each instruction.  Register ids are
+		function-local VirtualRegister ids. */
+	IdVector operandRegisters;
+
+private:
+	typedef std::vector<Function*>    FunctionVector;
+	typedef std::vector<BasicBlock*>  BasicBlockVector;
+	typedef std::vector<Instruction*> InstructionVector;
+
+private:
+	FunctionVector    _functions;
+	BasicBlockVector  _blocks;
+	InstructionVector _instructions;
+};
+
+}
+
+}
@@ -182,6 +182,12 @@ public:
 
 public:
 	void* storage();
+	/*! \brief Direct read access to the packed element storage */
+	const void* storage() const;
+
+public:
+	/*! \brief The packed size of the array data, in bytes */
+	virtual size_t bytes() const;
 
 public:
 	virtual bool isNullValue() const;
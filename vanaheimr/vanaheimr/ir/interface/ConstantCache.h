@@ -0,0 +1,76 @@
+/*! \file   ConstantCache.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ConstantCache class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Constant; } }
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief A per-module uniquing table and fold cache for constants.
+
+	Identical literals (0, 1, -1) appear millions of times in large
+	modules; uniquing stores each distinct value once so that equality
+	checks reduce to pointer comparison.  The fold cache memoizes
+	constant folding results keyed on (opcode, constant operands) so
+	repeated folds in constant propagation are a single hash probe. */
+class ConstantCache
+{
+public:
+	typedef std::vector<const Constant*> ConstantVector;
+
+public:
+	ConstantCache();
+	~ConstantCache();
+
+	ConstantCache(const ConstantCache&) = delete;
+	ConstantCache& operator=(const ConstantCache&) = delete;
+
+public:
+	/*! \brief Get the uniqued constant equal to the example,
+		the returned constant is owned by the cache */
+	const Constant* getOrInsert(const Constant& constant);
+
+	/*! \brief Look up a memoized fold result,
+		returns nullptr if it was never recorded */
+	const Constant* getFoldedValue(unsigned int opcode,
+		const ConstantVector& operands) const;
+
+	/*! \brief Record a fold result, the value is uniqued first */
+	const Constant* insertFoldedValue(unsigned int opcode,
+		const ConstantVector& operands, const Constant& value);
+
+public:
+	size_t size()  const;
+	bool   empty() const;
+
+private:
+	typedef std::unordered_map<std::string, Constant*>       ConstantMap;
+	typedef std::unordered_map<std::string, const Constant*> FoldMap;
+
+private:
+	static std::string _key(const Constant& constant);
+	static std::string _foldKey(unsigned int opcode,
+		const ConstantVector& operands);
+
+private:
+	ConstantMap _constants;
+	FoldMap     _folds;
+};
+
+}
+
+}
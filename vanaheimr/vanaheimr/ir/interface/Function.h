@@ -16,6 +16,9 @@
 #include <list>
 #include <set>
 
+// Forward Declarations
+namespace vanaheimr { namespace ir { class FunctionMaterializer; } }
+
 namespace vanaheimr
 {
 
@@ -52,7 +55,17 @@ public:
 		const Type* type = 0);
 	Function(const Function& f);
 	Function& operator=(const Function& f);
-	
+	~Function();
+
+public:
+	/*! \brief Make this function a deferred copy of another.
+
+		Only the signature is copied eagerly, the body is deep copied
+		when it is first materialized.  A speculative clone that is
+		rejected and discarded unmaterialized costs almost nothing.
+		The source must stay alive and unmodified until then */
+	void assignDeferred(const Function& f);
+
 public:
 	iterator       begin();
 	const_iterator begin() const;
@@ -137,6 +150,11 @@ public:
 	register_iterator erase(const register_iterator&);
 	register_iterator erase(const VirtualRegister*);
 
+public:
+	/*! \brief Remove a basic block, deleting its instructions.  The
+		entry and exit blocks cannot be removed */
+	iterator erase(iterator block);
+
 public:
 	register_iterator findVirtualRegister(const std::string& name);
 	         iterator findBasicBlock(const std::string& name);
@@ -160,9 +178,15 @@ public:
 	local_iterator findLocalValue(const std::string& name);
 
 public:
+	/*! \brief The total instruction count over all blocks, cached and
+		recomputed lazily when a block changes */
 	size_t instruction_size()  const;
 	bool   instruction_empty() const;
-	
+
+	/*! \brief Mark the cached instruction count stale, blocks call this
+		when their instruction lists change */
+	void invalidateInstructionCount();
+
 public:
 	/*! \brief Get a unique ID for the function in the module */
 	Id id() const;
@@ -170,6 +194,18 @@ public:
 public:
 	void clear();
 
+public:
+	/*! \brief Has the function body been loaded?  Functions without a
+		registered materializer are always materialized */
+	bool isMaterialized() const;
+
+	/*! \brief Defer the function body, the materializer fills it in on
+		first use.  The function owns the materializer */
+	void setMaterializer(FunctionMaterializer* materializer);
+
+	/*! \brief Load the body now if it is deferred, otherwise a no-op */
+	void materialize();
+
 public:
 	/*! \brief Set the type of the function by examining the arguments. */
 	void interpretType();
@@ -190,6 +226,11 @@ private:
 
 	BasicBlock::Id      _nextBlockId;
 	VirtualRegister::Id _nextRegisterId;
+
+	FunctionMaterializer* _materializer;
+
+	mutable size_t _instructionCount;
+	mutable bool   _instructionCountValid;
 };
 
 }
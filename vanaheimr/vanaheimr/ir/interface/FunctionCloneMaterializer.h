@@ -0,0 +1,40 @@
+/*! \file   FunctionCloneMaterializer.h
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the FunctionCloneMaterializer class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/FunctionMaterializer.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief Builds a function body by deep copying another function.
+
+	Backs deferred clones: a speculative copy shares nothing up front
+	and only pays for the deep copy - blocks, registers, instructions,
+	operand remapping - when its body is actually touched.  A clone
+	that is rejected and discarded unmaterialized costs only its
+	signature.  The source must stay alive and unmodified until the
+	copy materializes */
+class FunctionCloneMaterializer : public FunctionMaterializer
+{
+public:
+	explicit FunctionCloneMaterializer(const Function& source);
+
+public:
+	virtual void materializeFunction(Function& function);
+
+private:
+	const Function* _source;
+};
+
+}
+
+}
@@ -0,0 +1,40 @@
+/*! \file   FunctionMaterializer.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the FunctionMaterializer class.
+*/
+
+#pragma once
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Function; } }
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief Fills in deferred function bodies on first use.
+
+	Module readers can create functions as empty shells and register a
+	materializer that decodes the recorded instruction range only when a
+	pass first touches the function.  Runs that optimize a handful of
+	kernels out of a large module never pay the parse and memory cost for
+	the rest.  The materializer must outlive any lazy functions that
+	still reference it (call Module::materializeAll() before discarding
+	a reader). */
+class FunctionMaterializer
+{
+public:
+	virtual ~FunctionMaterializer();
+
+public:
+	/*! \brief Build the body (blocks, instructions, registers)
+		of a deferred function */
+	virtual void materializeFunction(Function& function) = 0;
+};
+
+}
+
+}
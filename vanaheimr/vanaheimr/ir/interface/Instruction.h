@@ -9,7 +9,9 @@
 // Vanaheimr Includes
 #include <vanaheimr/ir/interface/Operand.h>
 
-// Standard Library Includes 
+#include <vanaheimr/util/interface/SmallVector.h>
+
+// Standard Library Includes
 #include <vector>
 #include <string>
 
@@ -81,7 +83,10 @@ public:
 	};
 
 	typedef Operand* OperandPointer;
-	typedef std::vector<OperandPointer> OperandVector;
+
+	/*! \brief Operand lists have inline storage for the common case
+		(a guard plus up to three operands) and allocate nothing */
+	typedef util::SmallVector<OperandPointer, 4> OperandVector;
 	typedef PredicateOperand* PredicateOperandPointer;
 	
 	typedef unsigned int Id;
@@ -162,6 +167,14 @@ public:
 	/*! \brief Get access to the instruction metadata  */
 	const MetaData* metadata() const;	
 
+public:
+	/*! \brief Was the instruction allocated from a module arena?
+		Arena instructions are destroyed with the module,
+		not individually */
+	bool isArenaAllocated() const;
+	/*! \brief Mark the instruction as owned by a module arena */
+	void markAsArenaAllocated();
+
 public:
 	virtual Instruction* clone() const = 0;
 
@@ -171,6 +184,9 @@ public:
 	static Instruction* create(Opcode o, BasicBlock* b);
 	static Instruction* create(const std::string& opcode, BasicBlock* b);
 
+	/*! \brief Destroy an instruction, respecting arena ownership */
+	static void dispose(Instruction* i);
+
 public:
 	/*! \brief The instruction opcode */
 	Opcode opcode;
@@ -188,6 +204,7 @@ public:
 private:
 	Id        _id;
 	MetaData* _metadata;
+	bool      _inArena;
 
 };
 
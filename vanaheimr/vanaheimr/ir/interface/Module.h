@@ -11,6 +11,11 @@
 #include <vanaheimr/ir/interface/Global.h>
 #include <vanaheimr/ir/interface/Constant.h>
 
+#include <vanaheimr/ir/interface/ConstantCache.h>
+
+#include <vanaheimr/util/interface/Arena.h>
+#include <vanaheimr/util/interface/LargeMap.h>
+
 // Forward Declarations
 namespace vanaheimr { namespace compiler { class Compiler; } }
 
@@ -64,7 +69,9 @@ public:
 	Module& operator=(const Module& r);
 	
 public:
-	/*! \brief Get a named function in the module, return 0 if not found */
+	/*! \brief Get a named function in the module, return 0 if not found.
+		Lookups go through a hash index maintained on insertion and
+		removal rather than a walk over the function list */
 	iterator getFunction(const std::string& name);
 
 	/*! \brief Get a named function in the module, return 0 if not found */
@@ -101,6 +108,10 @@ public:
 	/*! \brief Write the module to a binary */
 	void writeBinary(std::ostream&) const;
 
+	/*! \brief Write the module over an existing binary, rewriting only
+		the pages whose bytes changed */
+	void patchBinary(std::iostream&) const;
+
 	/*! \brief Write the module as IR to an assembly file */
 	void writeAssembly(std::ostream&) const;
 
@@ -145,17 +156,44 @@ public:
 	
 public:
 	void clear();
-	
+
+public:
+	/*! \brief Force in the bodies of all lazily-loaded functions,
+		required before the reader that created them goes away */
+	void materializeAll();
+
+public:
+	/*! \brief The arena that owns IR objects created for this module,
+		it is torn down in one shot when the module is destroyed */
+	      util::Arena& arena();
+	const util::Arena& arena() const;
+
+	/*! \brief The uniquing table and fold cache for constants used by
+		this module */
+	      ConstantCache& constantCache();
+	const ConstantCache& constantCache() const;
+
 public:
 	std::string name;
-	
+
+private:
+	typedef util::LargeMap<std::string, iterator>        FunctionIndex;
+	typedef util::LargeMap<std::string, global_iterator> GlobalIndex;
+
 private:
 	FunctionList _functions;
 	GlobalList   _globals;
 	ConstantList _constants;
-	
+
+	FunctionIndex _functionIndex;
+	GlobalIndex   _globalIndex;
+
 private:
 	compiler::Compiler* _compiler;
+
+private:
+	util::Arena   _arena;
+	ConstantCache _constantCache;
 };
 
 }
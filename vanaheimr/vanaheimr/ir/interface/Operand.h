@@ -44,6 +44,9 @@ public:
 
 public:
 	Operand(OperandMode mode, Instruction* instruction);
+	/*! \brief Copies never inherit arena ownership, clones of arena
+		operands live on the heap */
+	Operand(const Operand& o);
 	virtual ~Operand();
 
 public:
@@ -85,13 +88,25 @@ public:
 public:
 	virtual Operand* clone() const = 0;
 	virtual std::string toString() const = 0;
-	
+
+public:
+	/*! \brief Was the operand allocated from a module arena?
+		Arena operands are destroyed with the module,
+		they are never deleted individually */
+	bool isArenaAllocated() const;
+	/*! \brief Mark the operand as owned by a module arena */
+	void markAsArenaAllocated();
+
+	/*! \brief Destroy an operand, respecting arena ownership */
+	static void dispose(Operand* operand);
+
 public:
 	/*! \brief The owning instruction */
 	Instruction* instruction;
 
 private:
 	OperandMode  _mode;
+	bool         _inArena;
 };
 
 typedef Operand::RegisterType RegisterType;
@@ -101,6 +116,10 @@ class RegisterOperand : public Operand
 {
 public:
 	RegisterOperand(VirtualRegister* reg, Instruction* i);
+	RegisterOperand(const RegisterOperand& r);
+	virtual ~RegisterOperand();
+
+	RegisterOperand& operator=(const RegisterOperand& r);
 
 public:
 	virtual const Type* type() const;
@@ -108,12 +127,30 @@ public:
 	virtual std::string toString() const;
 
 public:
-	/*! \brief The register being accessed */
+	/*! \brief Point the operand at a different register,
+		the use lists of both registers are updated */
+	void setVirtualRegister(VirtualRegister* reg);
+
+	/*! \brief The next operand using the same virtual register */
+	RegisterOperand* nextUse() const;
+
+public:
+	/*! \brief The register being accessed.  Use setVirtualRegister to
+		retarget the operand so that register use lists stay consistent */
 	VirtualRegister* virtualRegister;
 
 protected:
 	RegisterOperand(VirtualRegister* reg, Instruction* i, OperandMode m);
 
+private:
+	void _linkUse();
+	void _unlinkUse();
+
+private:
+	RegisterOperand* _nextUse;
+	RegisterOperand* _prevUse;
+
+	friend class VirtualRegister;
 };
 
 /*! \brief An immediate operand */
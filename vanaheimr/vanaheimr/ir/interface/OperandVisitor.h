@@ -0,0 +1,103 @@
+/*! \file   OperandVisitor.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the operand visitor functions.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief Dispatch a visitor over the closed set of operand kinds.
+
+	The visitor supplies one call operator per concrete operand class,
+	overload resolution happens at compile time and the kind test lowers
+	to a single dense indexed jump instead of the hand rolled mode
+	comparison chains pass inner loops tend to grow.  Predicate and
+	indirect operands dispatch as their own kinds even though their
+	classes derive from RegisterOperand */
+template<typename Visitor>
+auto visitOperand(const Operand& operand, Visitor&& visitor)
+	-> decltype(visitor(static_cast<const RegisterOperand&>(operand)))
+{
+	switch(operand.mode())
+	{
+	case Operand::Register:
+		return visitor(static_cast<const RegisterOperand&>(operand));
+	case Operand::Immediate:
+		return visitor(static_cast<const ImmediateOperand&>(operand));
+	case Operand::Predicate:
+		return visitor(static_cast<const PredicateOperand&>(operand));
+	case Operand::Indirect:
+		return visitor(static_cast<const IndirectOperand&>(operand));
+	case Operand::Address:
+		return visitor(static_cast<const AddressOperand&>(operand));
+	case Operand::Argument:
+	default:
+		return visitor(static_cast<const ArgumentOperand&>(operand));
+	}
+}
+
+template<typename Visitor>
+auto visitOperand(Operand& operand, Visitor&& visitor)
+	-> decltype(visitor(static_cast<RegisterOperand&>(operand)))
+{
+	switch(operand.mode())
+	{
+	case Operand::Register:
+		return visitor(static_cast<RegisterOperand&>(operand));
+	case Operand::Immediate:
+		return visitor(static_cast<ImmediateOperand&>(operand));
+	case Operand::Predicate:
+		return visitor(static_cast<PredicateOperand&>(operand));
+	case Operand::Indirect:
+		return visitor(static_cast<IndirectOperand&>(operand));
+	case Operand::Address:
+		return visitor(static_cast<AddressOperand&>(operand));
+	case Operand::Argument:
+	default:
+		return visitor(static_cast<ArgumentOperand&>(operand));
+	}
+}
+
+/*! \brief Visit every operand an instruction writes, then every operand
+	it reads, in list order */
+template<typename Visitor>
+void visitOperands(const Instruction& instruction, Visitor&& visitor)
+{
+	for(auto write : instruction.writes)
+	{
+		visitOperand(*write, visitor);
+	}
+
+	for(auto read : instruction.reads)
+	{
+		visitOperand(*read, visitor);
+	}
+}
+
+template<typename Visitor>
+void visitOperands(Instruction& instruction, Visitor&& visitor)
+{
+	for(auto write : instruction.writes)
+	{
+		visitOperand(*write, visitor);
+	}
+
+	for(auto read : instruction.reads)
+	{
+		visitOperand(*read, visitor);
+	}
+}
+
+}
+
+}
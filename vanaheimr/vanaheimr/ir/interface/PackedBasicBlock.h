@@ -0,0 +1,93 @@
+/*! \file   PackedBasicBlock.h
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the PackedBasicBlock class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/Instruction.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief A struct-of-arrays snapshot of a basic block.
+
+	Linear sweeps over a block (dead code elimination, constant
+	propagation) only touch opcodes, guards, and operand lists, but the
+	pointer-based representation spreads these over many cache lines and
+	pays a virtual dispatch per instruction.  Sealing a block gathers
+	this state into packed parallel arrays that analysis-heavy phases can
+	stream over, while keeping a pointer back to each original
+	instruction so that the block can be mutated afterwards. */
+class PackedBasicBlock
+{
+public:
+	typedef Instruction::Opcode Opcode;
+
+	typedef std::vector<Opcode>            OpcodeVector;
+	typedef std::vector<Operand*>          OperandVector;
+	typedef std::vector<PredicateOperand*> GuardVector;
+	typedef std::vector<Instruction*>      InstructionVector;
+
+	/*! \brief Half-open ranges into the flattened operand array */
+	class OperandRange
+	{
+	public:
+		unsigned int readBegin;
+		unsigned int readEnd;
+		unsigned int writeBegin;
+		unsigned int writeEnd;
+	};
+
+	typedef std::vector<OperandRange> OperandRangeVector;
+
+public:
+	/*! \brief Seal the block into packed form, the block is unchanged */
+	explicit PackedBasicBlock(BasicBlock& block);
+
+public:
+	/*! \brief The number of packed instructions */
+	size_t size()  const;
+	bool   empty() const;
+
+public:
+	/*! \brief The block that was sealed */
+	BasicBlock* block() const;
+
+	/*! \brief The original instruction at the packed index,
+		used to convert back for mutation */
+	Instruction* instruction(unsigned int index) const;
+
+public:
+	/*! \brief One opcode per instruction, in block order */
+	OpcodeVector opcodes;
+
+	/*! \brief One guard predicate per instruction, in block order */
+	GuardVector guards;
+
+	/*! \brief Flattened operand pointers, indexed via operandRanges.
+		Guards are excluded, they live in the guard array. */
+	OperandVector operands;
+
+	/*! \brief Read/write operand ranges, one per instruction */
+	OperandRangeVector operandRanges;
+
+private:
+	BasicBlock*       _block;
+	InstructionVector _instructions;
+};
+
+}
+
+}
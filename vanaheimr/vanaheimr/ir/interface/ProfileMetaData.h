@@ -0,0 +1,47 @@
+/*!	\file   ProfileMetaData.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ProfileMetaData class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/ir/interface/MetaData.h>
+
+// Standard Library Includes
+#include <cstdint>
+
+namespace vanaheimr
+{
+
+namespace ir
+{
+
+/*! \brief Measured execution counts for a branch.
+
+	A profiling run (e.g. an archaeopteryx simulation) attaches this to
+	a terminator to feed measured frequencies back into the compiler.
+	BranchProbabilityAnalysis prefers these counts over its static
+	heuristics whenever they are present */
+class ProfileMetaData : public MetaData
+{
+public:
+	ProfileMetaData(uint64_t executions = 0, uint64_t taken = 0);
+
+public:
+	virtual MetaData* clone() const;
+
+public:
+	/*! \brief The times the terminator executed */
+	uint64_t executions;
+
+	/*! \brief The times the branch was taken */
+	uint64_t taken;
+
+};
+
+}
+
+}
+
@@ -6,6 +6,9 @@
 
 #pragma once 
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringPool.h>
+
 // Standard Library Includes
 #include <string>
 
@@ -49,6 +52,9 @@ public:
 
 public:
 	const std::string& name() const;
+	/*! \brief The interned id of the name, stable for the lifetime of
+		the compiler.  Id comparison replaces string comparison in maps */
+	util::StringPool::StringId nameId() const;
 	Module*            module() const;
 	Linkage            linkage() const;
 	Visibility         visibility() const;
@@ -60,6 +66,9 @@ protected:
 
 private:
 	std::string _name;
+
+	util::StringPool::StringId _nameId;
+
 	Module*     _module;
 	Linkage     _linkage;
 	Visibility  _visibility;
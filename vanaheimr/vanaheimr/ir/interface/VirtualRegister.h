@@ -6,12 +6,16 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringPool.h>
+
 // Standard Library Includes
 #include <string>
 
 // Forward Declarations
-namespace vanaheimr { namespace ir { class Function; } }
-namespace vanaheimr { namespace ir { class Type;     } }
+namespace vanaheimr { namespace ir { class Function;        } }
+namespace vanaheimr { namespace ir { class Type;            } }
+namespace vanaheimr { namespace ir { class RegisterOperand; } }
 
 namespace vanaheimr
 {
@@ -28,15 +32,39 @@ public:
 public:
 	VirtualRegister(const std::string& name, Id id,
 		Function* function, const Type* t);
+	VirtualRegister(const VirtualRegister& r);
+
+	VirtualRegister& operator=(const VirtualRegister& r);
 
 public:
 	std::string toString() const;
 
+public:
+	/*! \brief The head of the intrusive list of operands using this
+		register, maintained as operands are created and retargeted.
+		Walk it with RegisterOperand::nextUse() */
+	RegisterOperand* firstUse() const;
+
+	/*! \brief Does any operand use this register? */
+	bool hasUses() const;
+
+	/*! \brief Count the uses of this register, O(uses) */
+	size_t useCount() const;
+
 public:
 	std::string name;
+
+	/*! \brief The interned id of the name, cheap to copy and compare */
+	util::StringPool::StringId nameId;
+
 	Id          id;
 	Function*   function;
 	const Type* type;
+
+private:
+	RegisterOperand* _firstUse;
+
+	friend class RegisterOperand;
 };
 
 }
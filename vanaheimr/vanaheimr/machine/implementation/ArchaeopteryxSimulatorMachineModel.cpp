@@ -6,6 +6,7 @@
 
 // Vanahieimr Includes
 #include <vanaheimr/machine/interface/ArchaeopteryxSimulatorMachineModel.h>
+#include <vanaheimr/machine/interface/ArchaeopteryxMachineDescription.h>
 
 namespace vanaheimr
 {
@@ -13,10 +14,28 @@ namespace vanaheimr
 namespace machine
 {
 
+// the constexpr table needs one definition for odr uses
+constexpr OperationDescription
+	ArchaeopteryxMachineDescription::Operations[];
+
 ArchaeopteryxSimulatorMachineModel::ArchaeopteryxSimulatorMachineModel()
 : MachineModel("ArchaeopteryxSimulator")
 {
-	addRegisterFile("rf", 64);
+	typedef ArchaeopteryxMachineDescription Description;
+
+	addRegisterFile("rf", Description::RegisterCount);
+
+	// the simulator executes threads in warps of lockstep lanes
+	_laneWidth = Description::LaneWidth;
+
+	// populate the dynamic timing tables from the static description
+	for(size_t i = 0; i != Description::OperationCount; ++i)
+	{
+		auto& operation = Description::Operations[i];
+
+		addOperation(Operation(operation.name, "",
+			operation.latency, operation.throughput));
+	}
 }
 
 MachineModel* ArchaeopteryxSimulatorMachineModel::clone() const
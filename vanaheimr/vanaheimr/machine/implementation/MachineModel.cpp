@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/machine/interface/MachineModel.h>
 #include <vanaheimr/machine/interface/TranslationTable.h>
+#include <vanaheimr/machine/interface/Instruction.h>
 
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
@@ -18,7 +19,7 @@ namespace machine
 {
 
 MachineModel::MachineModel(const std::string& n)
-: name(n), _translationTable(nullptr)
+: name(n), _translationTable(nullptr), _laneWidth(1)
 {
 
 }
@@ -51,6 +52,49 @@ unsigned int MachineModel::totalRegisterCount() const
 	return _idToRegisters.size();
 }
 
+unsigned int MachineModel::laneWidth() const
+{
+	return _laneWidth;
+}
+
+unsigned int MachineModel::instructionLatency(
+	const ir::Instruction& instruction) const
+{
+	if(instruction.isMachineInstruction())
+	{
+		auto operation = static_cast<const machine::Instruction&>(
+			instruction).operation;
+
+		if(operation != nullptr && operation->latency != 0)
+		{
+			return operation->latency;
+		}
+	}
+
+	// opcode class defaults for operations with no timing entry
+	if(instruction.accessesMemory()) return 100;
+	if(instruction.isCall())         return 20;
+
+	return 1;
+}
+
+unsigned int MachineModel::instructionThroughput(
+	const ir::Instruction& instruction) const
+{
+	if(instruction.isMachineInstruction())
+	{
+		auto operation = static_cast<const machine::Instruction&>(
+			instruction).operation;
+
+		if(operation != nullptr && operation->throughput != 0)
+		{
+			return operation->throughput;
+		}
+	}
+
+	return 1;
+}
+
 const TranslationTable* MachineModel::translationTable() const
 {
 	return _translationTable;
@@ -13,8 +13,9 @@ namespace vanaheimr
 namespace machine
 {
 
-Operation::Operation(const std::string& n, const std::string& s, unsigned int l)
-: name(n), special(s), latency(l)
+Operation::Operation(const std::string& n, const std::string& s,
+	unsigned int l, unsigned int t)
+: name(n), special(s), latency(l), throughput(t)
 {
 
 }
@@ -69,11 +69,17 @@ StaticTranslationTableEntry::Translation::Translation(const Operation* l)
 }
 
 StaticTranslationTableEntry::StaticTranslationTableEntry(const std::string& n)
-: TranslationTableEntry(n)
+: TranslationTableEntry(n), _prepared(false)
 {
 
 }
 
+void StaticTranslationTableEntry::prepare()
+{
+	_temporaries = getTemporaries();
+	_prepared    = true;
+}
+
 typedef std::vector<ir::VirtualRegister*> RegisterVector;
 
 static void mapOperands(ir::Instruction* newInstruction,
@@ -151,10 +157,16 @@ StaticTranslationTableEntry::MachineInstructionVector
 	// Create temporary registers
 	RegisterVector temporaries;
 
-	auto temps = getTemporaries();
-	
+	// prepared entries reuse the cached template, unregistered ones
+	// recompute it
+	ArgumentVector computedTemps;
+
+	if(!_prepared) computedTemps = getTemporaries();
+
+	const ArgumentVector& temps = _prepared ? _temporaries : computedTemps;
+
 	auto function = instruction->block->function();
-	
+
 	for(auto temp : temps)
 	{
 		assert(temp.index == temporaries.size());
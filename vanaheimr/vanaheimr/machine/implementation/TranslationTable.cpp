@@ -7,11 +7,14 @@
 // Vanaheimr Includes
 #include <vanaheimr/machine/interface/TranslationTable.h>
 #include <vanaheimr/machine/interface/TranslationTableEntry.h>
+#include <vanaheimr/machine/interface/Instruction.h>
 
 #include <vanaheimr/ir/interface/Instruction.h>
 
+#include <vanaheimr/util/interface/ConcurrentMap.h>
+
 // Standard Library Includes
-#include <map>
+#include <unordered_map>
 #include <cassert>
 
 namespace vanaheimr
@@ -23,16 +26,37 @@ namespace machine
 class TranslationTableMap
 {
 public:
-	typedef std::map<std::string, TranslationTableEntry*> Map;
+	typedef std::unordered_map<std::string, TranslationTableEntry*> Map;
+	typedef std::vector<const TranslationTableEntry*> DispatchVector;
+	typedef util::ConcurrentMap<const Operation*,
+		const TranslationTableEntry*> OperationMap;
 
 public:
-	~TranslationTableMap();	
+	TranslationTableMap();
+	~TranslationTableMap();
 
 public:
 	Map opcodeToTranslation;
 
+	/*! \brief Entries for plain opcode names indexed by the opcode
+		enum, so selection of an IR instruction is one array load
+		instead of a name lookup.  Built as entries are added, once
+		per machine model load */
+	DispatchVector opcodeDispatch;
+
+	/*! \brief Resolutions for machine operations, keyed by the operation
+		so repeated selections skip the name lookup.  Filled on first
+		use, concurrent function passes share it */
+	OperationMap operationToTranslation;
+
 };
 
+TranslationTableMap::TranslationTableMap()
+: opcodeDispatch(ir::Instruction::InvalidOpcode + 1, nullptr)
+{
+
+}
+
 TranslationTableMap::~TranslationTableMap()
 {
 	for(auto translation : opcodeToTranslation)
@@ -56,8 +80,41 @@ TranslationTable::MachineInstructionVector
 	TranslationTable::translateInstruction(
 	const ir::Instruction* instruction) const
 {
-	auto translation = getTranslation(instruction->opcodeString());
-	
+	// IR opcode strings are fixed, so their entries come straight out
+	// of the dispatch index
+	const TranslationTableEntry* translation =
+		_translations->opcodeDispatch[instruction->opcode];
+
+	if(translation == nullptr &&
+		instruction->opcode == ir::Instruction::Machine)
+	{
+		// machine operations resolve by name once, then by pointer
+		auto machineInstruction =
+			static_cast<const machine::Instruction*>(instruction);
+
+		auto cached = _translations->operationToTranslation.find(
+			machineInstruction->operation);
+
+		if(cached != nullptr)
+		{
+			translation = *cached;
+		}
+		else
+		{
+			translation = getTranslation(instruction->opcodeString());
+
+			// misses are cached too, the operation set is fixed once
+			// the machine model is loaded
+			_translations->operationToTranslation.insert(
+				machineInstruction->operation, translation);
+		}
+	}
+	else if(translation == nullptr)
+	{
+		// modified names fall back to the hash map
+		translation = getTranslation(instruction->opcodeString());
+	}
+
 	if(translation == nullptr)
 	{
 		// Fail the translation by returning nothing
@@ -84,8 +141,23 @@ void TranslationTable::addTranslation(const TranslationTableEntry* entry)
 {
 	assert(_translations->opcodeToTranslation.count(entry->name) == 0);
 
-	_translations->opcodeToTranslation.insert(
-		std::make_pair(entry->name, entry->clone()));
+	auto translation = _translations->opcodeToTranslation.insert(
+		std::make_pair(entry->name, entry->clone())).first;
+
+	// let the stored copy precompute selection state up front
+	translation->second->prepare();
+
+	// index entries named after plain opcodes for constant time dispatch
+	for(unsigned int opcode = 0;
+		opcode != ir::Instruction::InvalidOpcode; ++opcode)
+	{
+		if(ir::Instruction::toString(
+			(ir::Instruction::Opcode)opcode) != entry->name) continue;
+
+		_translations->opcodeDispatch[opcode] = translation->second;
+
+		break;
+	}
 }
 
 }
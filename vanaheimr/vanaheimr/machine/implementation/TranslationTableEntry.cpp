@@ -26,6 +26,11 @@ TranslationTableEntry::~TranslationTableEntry()
 
 }
 
+void TranslationTableEntry::prepare()
+{
+	// entries with nothing to precompute ignore the call
+}
+
 }
 
 }
@@ -0,0 +1,104 @@
+/*! \file   ArchaeopteryxMachineDescription.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ArchaeopteryxMachineDescription class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstddef>
+
+namespace vanaheimr
+{
+
+namespace machine
+{
+
+/*! \brief One opcode's static properties in a machine description */
+class OperationDescription
+{
+public:
+	const char*  name;       // the opcode string
+	unsigned int latency;    // latency in cycles
+	unsigned int throughput; // cycles between back to back issues
+};
+
+/*! \brief The compile time description of the archaeopteryx simulator.
+
+	Register counts, the lane width, and the opcode timing table are
+	constexpr, so property queries against the description fold into
+	constants in the hottest codegen loops.  The dynamic MachineModel
+	is populated from this table in one sweep when the model is
+	constructed, nothing about the machine is recomputed per compile */
+class ArchaeopteryxMachineDescription
+{
+public:
+	static const unsigned int RegisterCount = 64;
+	static const unsigned int LaneWidth     = 32;
+
+	static const size_t OperationCount = 37;
+
+	static constexpr OperationDescription Operations[OperationCount] =
+	{
+		{"add",           1,   1},
+		{"and",           1,   1},
+		{"ashr",          1,   1},
+		{"atom",        200,   4},
+		{"bar",          50,   1},
+		{"bitcast",       1,   1},
+		{"bra",           2,   1},
+		{"call",         20,   2},
+		{"fdiv",         20,   8},
+		{"fmul",          4,   1},
+		{"fpext",         2,   1},
+		{"fptosi",        2,   1},
+		{"fptoui",        2,   1},
+		{"fptrunc",       2,   1},
+		{"frem",         30,   8},
+		{"getelementptr", 2,   1},
+		{"launch",      200,   8},
+		{"ld",          100,   4},
+		{"lshr",          1,   1},
+		{"membar",       10,   1},
+		{"mul",           4,   1},
+		{"or",            1,   1},
+		{"ret",           5,   1},
+		{"setp",          2,   1},
+		{"sext",          1,   1},
+		{"sdiv",         20,   8},
+		{"shl",           1,   1},
+		{"sitofp",        2,   1},
+		{"srem",         20,   8},
+		{"st",          100,   4},
+		{"sub",           1,   1},
+		{"trunc",         1,   1},
+		{"udiv",         20,   8},
+		{"uitofp",        2,   1},
+		{"urem",         20,   8},
+		{"xor",           1,   1},
+		{"zext",          1,   1}
+	};
+
+public:
+	/*! \brief The latency of a table entry, usable in constant
+		expressions */
+	static constexpr unsigned int latency(size_t operation)
+	{
+		return Operations[operation].latency;
+	}
+
+	/*! \brief The inverse throughput of a table entry, usable in
+		constant expressions */
+	static constexpr unsigned int throughput(size_t operation)
+	{
+		return Operations[operation].throughput;
+	}
+
+};
+
+}
+
+}
+
+
@@ -19,6 +19,7 @@
 // Forward Declarations
 namespace vanaheimr { namespace machine { class PhysicalRegister; } }
 namespace vanaheimr { namespace machine { class TranslationTable; } }
+namespace vanaheimr { namespace ir      { class Instruction;      } }
 
 namespace vanaheimr
 {
@@ -54,6 +55,23 @@ public:
 	/*! \brief Get the total register count */
 	unsigned int totalRegisterCount() const;
 
+	/*! \brief Get the number of SIMD lanes that execute threads in
+		lockstep, 1 for a scalar machine */
+	unsigned int laneWidth() const;
+
+public:
+	/*! \brief Get the latency of an instruction in cycles.
+
+		Machine instructions use their operation's timing table,
+		instructions with no machine binding yet fall back on opcode
+		class defaults */
+	unsigned int instructionLatency(const ir::Instruction& instruction) const;
+
+	/*! \brief Get the inverse throughput of an instruction, the cycles
+		between back to back issues */
+	unsigned int instructionThroughput(
+		const ir::Instruction& instruction) const;
+
 public:
 	const TranslationTable* translationTable() const;
 
@@ -89,6 +107,9 @@ protected:
 protected:
 	TranslationTable* _translationTable;
 
+	/*! \brief The SIMD width, set by subclasses that model SIMD machines */
+	unsigned int _laneWidth;
+
 };
 
 }
@@ -27,12 +27,15 @@ public:
 
 public:
 	Operation(const std::string& _name,  const std::string& _special = "",
-		unsigned int _latency = 0);
+		unsigned int _latency = 0, unsigned int _throughput = 1);
 
 public:
 	std::string  name;    // fully qualified name including modifiers
 	std::string  special; // special property (if any)
 	unsigned int latency; // latency in cycles
+
+	/*! \brief inverse throughput, cycles between back to back issues */
+	unsigned int throughput;
 	
 	/*! \brief all possible bindings to HW */
 	FunctionalUnitOperationVector functionalUnitOperations;
@@ -36,6 +36,11 @@ public:
 public:
 	virtual TranslationTableEntry* clone() const;
 
+public:
+	/*! \brief Precompute the temporary register template, selection
+		revisits it per translated instruction */
+	virtual void prepare();
+
 public:
 	typedef ir::Type     Type;
 	typedef ir::Constant Constant;
@@ -114,6 +119,10 @@ public:
 	
 public:
 	TranslationVector translations; // translation into logical ops
+
+private:
+	ArgumentVector _temporaries; // cached by prepare()
+	bool           _prepared;
 };
 
 }
@@ -39,6 +39,11 @@ public:
 	/*! \brief Clone the entry */
 	virtual TranslationTableEntry* clone() const = 0;
 
+public:
+	/*! \brief Precompute any per-entry selection state, the table calls
+		this once when the entry is registered */
+	virtual void prepare();
+
 public:
 	std::string name; // name of the VIR operation to translate
 };
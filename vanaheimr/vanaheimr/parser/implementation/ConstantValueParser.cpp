@@ -13,11 +13,15 @@
 #include <vanaheimr/ir/interface/Type.h>
 #include <vanaheimr/ir/interface/Constant.h>
 
+#include <vanaheimr/util/interface/StringRef.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
 #include <stdexcept>
+#include <cstring>
+#include <cstdlib>
 
 namespace vanaheimr
 {
@@ -25,6 +29,7 @@ namespace vanaheimr
 namespace parser
 {
 
+typedef util::StringRef StringRef;
 
 ConstantValueParser::ConstantValueParser(std::istream* stream)
 : _parsedConstant(nullptr), _lexer(nullptr), _stream(stream)
@@ -122,7 +127,7 @@ static bool isNumeric(char c)
 		c == '6' || c == '7' || c == '8' || c == '9' || c == '1';
 }
 
-static bool isInteger(const std::string& integer)
+static bool isInteger(const StringRef& integer)
 {
 	for(auto character : integer)
 	{
@@ -132,7 +137,7 @@ static bool isInteger(const std::string& integer)
 	return true;
 }
 
-static bool isString(const std::string& string)
+static bool isString(const StringRef& string)
 {
 	if(string.size() < 2) return false;
 	
@@ -144,14 +149,14 @@ static bool isString(const std::string& string)
 	return string.front() == '\"' && string.back() == '\"';
 }
 
-static bool isFloatingPoint(const std::string& token)
+static bool isFloatingPoint(const StringRef& token)
 {
 	return !token.empty() && isNumeric(token[0]) && !isInteger(token);
 }
 
 ir::Constant* ConstantValueParser::_parseConstant()
 {
-	std::string nextToken = _lexer->peek();
+	auto nextToken = _lexer->peek();
 	
 	ir::Constant* constant = nullptr;
 	
@@ -203,11 +208,16 @@ static ir::Constant* createZeroInitializer(const ir::Type* type)
 	return nullptr;
 }
 
-static bool isZeroInitializer(const std::string& token)
+static bool isZeroInitializer(const StringRef& token)
 {
 	return token == "zeroinitializer";
 }
 
+static bool isArray(const StringRef& token)
+{
+	return token == "[";
+}
+
 ir::Constant* ConstantValueParser::_parseConstant(const ir::Type* type)
 {
 	auto nextToken = _lexer->peek();
@@ -223,7 +233,11 @@ ir::Constant* ConstantValueParser::_parseConstant(const ir::Type* type)
 	{
 		constant = _parseStringConstant(type);
 	}
-	
+	else if(isArray(nextToken))
+	{
+		constant = _parseArrayConstant(type);
+	}
+
 	if(constant == nullptr)
 	{
 		throw std::runtime_error("Failed to parse constant.");
@@ -293,6 +307,120 @@ ir::Constant* ConstantValueParser::_parseStringConstant(const ir::Type* type)
 	return new ir::ArrayConstant(token.c_str(), token.size(), type);
 }
 
+static uint64_t scanIntegerValue(const StringRef& token)
+{
+	uint64_t value = 0;
+
+	for(auto character : token)
+	{
+		value = value * 10 + (character - '0');
+	}
+
+	return value;
+}
+
+static double scanFloatValue(const StringRef& token)
+{
+	// tokens are slices of the input buffer rather than terminated
+	// strings, so stage the digits through a small buffer for strtod
+	char buffer[64];
+
+	size_t size = token.size() < sizeof(buffer) - 1 ?
+		token.size() : sizeof(buffer) - 1;
+
+	std::memcpy(buffer, token.data(), size);
+
+	buffer[size] = '\0';
+
+	return std::strtod(buffer, nullptr);
+}
+
+ir::Constant* ConstantValueParser::_parseArrayConstant(const ir::Type* type)
+{
+	assertM(type->isArray(), "Array initializer requires an array type, "
+		"but was given '" << type->name << "'");
+
+	auto arrayType = static_cast<const ir::ArrayType*>(type);
+
+	auto elementType  = arrayType->getTypeAtIndex(0);
+	auto elementBytes = elementType->bytes();
+
+	// Preallocate contiguous storage for the entire array and decode the
+	// initializer elements into it in place, rather than wrapping each
+	// element in a constant of its own
+	auto array = new ir::ArrayConstant(arrayType->bytes(), type);
+
+	auto storage = (char*)array->storage();
+
+	uint64_t element = 0;
+
+	try
+	{
+		_lexer->scanThrow("[");
+
+		if(!_lexer->scan("]"))
+		{
+			do
+			{
+				if(element >= arrayType->elementsInArray())
+				{
+					throw std::runtime_error("Too many initializer elements "
+						"for '" + type->name + "' at " + _lexer->location());
+				}
+
+				// skip the element type annotation
+				_lexer->nextToken();
+
+				auto valueToken = _lexer->nextToken();
+
+				if(elementType->isInteger())
+				{
+					// store the low bytes, all targets are little endian
+					uint64_t value = scanIntegerValue(valueToken);
+
+					std::memcpy(storage + element * elementBytes,
+						&value, elementBytes);
+				}
+				else if(elementType->isSinglePrecisionFloat())
+				{
+					float value = scanFloatValue(valueToken);
+
+					std::memcpy(storage + element * elementBytes,
+						&value, sizeof(float));
+				}
+				else if(elementType->isDoublePrecisionFloat())
+				{
+					double value = scanFloatValue(valueToken);
+
+					std::memcpy(storage + element * elementBytes,
+						&value, sizeof(double));
+				}
+				else
+				{
+					throw std::runtime_error("Array initializers over '" +
+						elementType->name + "' elements are not supported.");
+				}
+
+				++element;
+			}
+			while(_lexer->scan(","));
+
+			_lexer->scanThrow("]");
+		}
+	}
+	catch(...)
+	{
+		delete array;
+
+		throw;
+	}
+
+	hydrazine::log("ConstantValueParser::Parser")
+		<< " parsed array constant with " << element << " elements\n";
+
+	return array;
+}
+
 }
 
 }
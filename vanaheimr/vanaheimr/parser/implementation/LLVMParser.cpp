@@ -17,11 +17,12 @@
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/util/interface/StringRef.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
-#include <fstream>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -48,13 +49,15 @@ typedef ir::Global       Global;
 typedef ir::FunctionType FunctionType;
 typedef ir::Constant     Constant;
 
+typedef util::StringRef StringRef;
+
 class LLVMParserEngine
 {
 public:
 	LLVMParserEngine(compiler::Compiler* compiler, const std::string& filename);
 
 public:
-	void parse(std::istream& stream);
+	void parse(const std::string& filename);
 
 public:
 	std::string moduleName;
@@ -62,12 +65,12 @@ public:
 private:
 	void _parseTypedefs();
 
-	void _parseTopLevelDeclaration(const std::string& declaration);
+	void _parseTopLevelDeclaration(const StringRef& declaration);
 	
-	void _parseGlobalVariable(const std::string& token);
-	void _parseTypedef(const std::string& token);
+	void _parseGlobalVariable(const StringRef& token);
+	void _parseTypedef(const StringRef& token);
 	void _parseFunction();
-	void _parsePrototype(const std::string& linkage);
+	void _parsePrototype(const StringRef& linkage);
 	void _parseTarget();
 	void _parseMetadata();
 
@@ -110,6 +113,8 @@ private:
 	TypeAliasSet _typedefs;
 	StringMap    _typedefStrings;
 
+	TypeParser::SignatureCache _typeCache;
+
 private:
 	// Lexer Working State
 	Lexer _lexer;
@@ -117,17 +122,9 @@ private:
 
 void LLVMParser::parse(const std::string& filename)
 {
-	std::ifstream file(filename.c_str());
-	
-	if(!file.is_open())
-	{
-		throw std::runtime_error("LLVM Parser: Could not open file '" +
-			filename + "' for reading.");
-	}
-
 	LLVMParserEngine engine(_compiler, filename);
 
-	engine.parse(file);
+	engine.parse(filename);
 
 	_moduleName = engine.moduleName;
 }
@@ -175,7 +172,7 @@ LLVMParserEngine::LLVMParserEngine(Compiler* compiler,
 	_lexer.addWhitespaceRules(" \t\n\r");
 }
 
-static bool isTopLevelDeclaration(const std::string& token)
+static bool isTopLevelDeclaration(const StringRef& token)
 {
 	if(token == "define" || token == "declare" ||
 		token == "!" || token == "target")
@@ -196,11 +193,12 @@ static bool isTopLevelDeclaration(const std::string& token)
 	return false;
 }
 
-void LLVMParserEngine::parse(std::istream& stream)
+void LLVMParserEngine::parse(const std::string& filename)
 {
 	_module = &*_compiler->newModule(moduleName);
 
-	_lexer.setStream(&stream);
+	// map the file, tokens are zero-copy slices of the mapping
+	_lexer.setFileName(filename);
 
 	_parseTypedefs();
 
@@ -246,7 +244,7 @@ void LLVMParserEngine::_parseTypedefs()
 	_lexer.reset();
 }
 
-void LLVMParserEngine::_parseTopLevelDeclaration(const std::string& token)
+void LLVMParserEngine::_parseTopLevelDeclaration(const StringRef& token)
 {
 	if(token.find("@") == 0)
 	{
@@ -274,7 +272,7 @@ void LLVMParserEngine::_parseTopLevelDeclaration(const std::string& token)
 	}
 }
 
-static bool isLinkage(const std::string& token)
+static bool isLinkage(const StringRef& token)
 {
 	return token == "private" ||
 		token == "linker_private" ||
@@ -294,7 +292,7 @@ static bool isLinkage(const std::string& token)
 		token == "dllexport";
 }
 
-static Variable::Linkage translateLinkage(const std::string& token)
+static Variable::Linkage translateLinkage(const StringRef& token)
 {
 	if(token == "internal") return Variable::InternalLinkage;
 	if(token == "external") return Variable::ExternalLinkage;
@@ -386,7 +384,7 @@ void LLVMParserEngine::_resolveTypeAliasesInSubtypes(
 	}
 }
 
-void LLVMParserEngine::_parseGlobalVariable(const std::string& token)
+void LLVMParserEngine::_parseGlobalVariable(const StringRef& token)
 {
 	auto name = token.substr(1);
 
@@ -427,7 +425,7 @@ void LLVMParserEngine::_parseGlobalVariable(const std::string& token)
 	_parseAlignment(&*global);
 }
 
-void LLVMParserEngine::_parseTypedef(const std::string& token)
+void LLVMParserEngine::_parseTypedef(const StringRef& token)
 {
 	auto name = token.substr(1);
 	
@@ -471,7 +469,7 @@ void LLVMParserEngine::_parseFunction()
 	_lexer.scanThrow("}");
 }
 
-void LLVMParserEngine::_parsePrototype(const std::string& linkage)
+void LLVMParserEngine::_parsePrototype(const StringRef& linkage)
 {
 	auto returnType = _parseType();
 	
@@ -537,7 +535,7 @@ void LLVMParserEngine::_parseMetadata()
 	assertM(false, "Not Implemented.");
 }
 
-static bool isGlobalAttribute(const std::string& token)
+static bool isGlobalAttribute(const StringRef& token)
 {
 	if(token == "internal")     return true;
 	if(token == "external")     return true;
@@ -570,7 +568,7 @@ LLVMParserEngine::StringList LLVMParserEngine::_parseGlobalAttributes()
 	return attributes;
 }
 
-static bool isConstant(const std::string& token)
+static bool isConstant(const StringRef& token)
 {
 	if(token == "zeroinitializer") return true;
 	if(token.find("c\"") == 0)     return true;
@@ -611,8 +609,8 @@ void LLVMParserEngine::_parseAlignment(ir::Global* global)
 
 const Type* LLVMParserEngine::_parseType()
 {
-	TypeParser parser(_compiler, &_typedefs);
-	
+	TypeParser parser(_compiler, &_typedefs, &_typeCache);
+
 	parser.parse(&_lexer);
 	
 	hydrazine::log("LLVM::Parser") << "Parsed type '"
@@ -627,6 +625,9 @@ void LLVMParserEngine::_addTypeAlias(const std::string& alias, const Type* type)
 		<< type->name << "'\n";
 
 	_typedefs.addAlias(alias, type);
+
+	// memoized signatures may mention the alias, recall them from scratch
+	_typeCache.clear();
 }
 
 void LLVMParserEngine::_parseFunctionAttributes()
@@ -637,7 +638,7 @@ void LLVMParserEngine::_parseFunctionAttributes()
 	}
 }
 
-static bool isFunctionAttribute(const std::string& token)
+static bool isFunctionAttribute(const StringRef& token)
 {
 	return (token == "section"
 		|| token == "#");
@@ -677,7 +678,7 @@ void LLVMParserEngine::_parseFunctionBody()
 	}
 }
 
-static bool isLabel(const std::string& token)
+static bool isLabel(const StringRef& token)
 {
 	if(token.empty()) return false;
 	
@@ -686,12 +687,12 @@ static bool isLabel(const std::string& token)
 
 static std::set<std::string> opcodes = {"call", "ret"};
 
-static bool isOpcode(const std::string& token)
+static bool isOpcode(const StringRef& token)
 {
 	return opcodes.count(token) != 0;
 }
 
-static bool isInstruction(const std::string& token)
+static bool isInstruction(const StringRef& token)
 {
 	if(isOpcode(token)) return true;
 	
@@ -7,16 +7,20 @@
 // Vanaheimr Includes
 #include <vanaheimr/parser/interface/Lexer.h>
 #include <vanaheimr/parser/interface/LexerRule.h>
+#include <vanaheimr/util/interface/InputBuffer.h>
+
+#include <vanaheimr/util/interface/ByteClass.h>
+#include <vanaheimr/util/interface/Executor.h>
 
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
 // Standard Library Includes
 #include <vector>
+#include <map>
 #include <sstream>
 #include <cassert>
 #include <stdexcept>
-#include <set>
 #include <algorithm>
 
 namespace vanaheimr
@@ -28,52 +32,18 @@ namespace parser
 class LexerEngine
 {
 public:
-	// TODO: Consider a rule representation that uses a state machine
-	// rather than an explicit set of rules that could be matched
-	typedef std::set<LexerRule*> RuleSet;
+	/*! \brief A token lexed from the input text.
 
-	class TokenDescriptor
+		Only buffer offsets are recorded, line and column are recovered
+		by re-scanning the buffer when an error message needs them */
+	class Token
 	{
-	public:
-		explicit TokenDescriptor(LexerEngine* engine);
-		TokenDescriptor(const TokenDescriptor& left,
-			const TokenDescriptor& right);
-	
 	public:
 		size_t beginPosition;
 		size_t endPosition;
-	
-	public:
-		size_t line;
-		size_t column;
-		
-	public:
-		RuleSet possibleMatches;
-	
-	public:
-		LexerEngine* engine;
-	
-	public:
-		bool tokenIsMatched;
-	
-	public:
-		bool   isEndMatched()   const;
-		bool   isBeginMatched() const;
-		size_t size()           const;
-	
-	public:	
-		bool   isMatched() const;
-		bool   isMatched();
-		bool   isMatched(const TokenDescriptor& next);
-	
-	public:
-		LexerRule* getMatchedRule();
-	
-	public:
-		std::string getString() const;
 	};
-	
-	typedef std::vector<TokenDescriptor> TokenVector;
+
+	typedef std::vector<Token> TokenVector;
 	typedef TokenVector::iterator LexerContext;
 
 	typedef std::vector<LexerContext> LexerContextVector;
@@ -83,9 +53,6 @@ public:
 public:
 	std::istream* stream;
 
-	size_t line;
-	size_t column;
-
 	LexerContextVector checkpoints;
 
 public:
@@ -93,53 +60,65 @@ public:
 	RuleVector whitespaceRules;
 
 public:
-	std::string nextToken();
-	std::string peek();
+	util::StringRef nextToken();
+	util::StringRef peek();
 	bool hitEndOfStream() const;
 
+	size_t tokenIndex() const;
+	util::StringRef tokenRange(size_t begin, size_t end) const;
+	void skipToToken(size_t index);
+
+	/*! \brief The buffer offset of the next token, or the buffer size
+		at the end of the stream */
+	size_t currentOffset() const;
+
+	/*! \brief Recover the line and column of a buffer offset by
+		re-scanning the input, only error paths pay for it */
+	void getLocation(size_t offset, size_t& line, size_t& column) const;
+
 public:
-	void reset(std::istream* s);
+	void setStream(std::istream* s);
+	void mapFile(const std::string& filename);
+
+	void reset();
 
 	void checkpoint();
 	void restore();
 
 private:
+	typedef std::vector<int> StateVector;
+
+private:
+	util::InputBuffer _input;
+
 	TokenVector           _tokens;
 	TokenVector::iterator _nextToken;
 
 private:
-	void _createTokens();
-	void _mergeTokens();
-	void _removeWhitespace();
-	
-	char _snext();
+	/*! The rules compiled into a single DFA, scanned in one forward pass.
+		States are rows of 256 transitions, -1 rejects.  Accepting states
+		record the highest priority (lowest index) matched rule, token
+		rules first, whitespace rules after them. */
+	StateVector _transitions;
+	StateVector _acceptingRules;
+
+	// per state, the bytes that transition back to the same state,
+	// used to scan runs (identifiers, digits, comments) in blocks
+	std::vector<util::ByteClass> _selfLoops;
+
+	// true when no token rule can match a newline, so chunked lexing
+	// can split the input right after one
+	bool _newlineIsSafeBreak;
 
 private:
-	void _filterWithNeighbors(const LexerContext& token);
-
-	TokenDescriptor _mergeWithEnd(const LexerContext& token);
-	TokenDescriptor _mergeWithNext(const LexerContext& token,
-		const LexerContext& next);
-	
-	bool _isAMergePossible(const LexerContext& token,
-		const LexerContext& next);
-	bool _canMerge(const LexerContext& token,
-		const LexerContext& next);
-	
-	bool _isNewToken(const LexerContext& token);
-	bool _couldBeTokenEnd(const LexerContext& token);
-	bool _couldBeTokenBegin(const LexerContext& token);
-	bool _formsLargerMatchOfTheSameRule(const LexerContext& left,
-		const LexerContext& right);
-	bool _nextCantMatchOtherwise(const LexerContext& left,
-		const LexerContext& right);
-	
-	const LexerRule* _getRuleThatMatchesWithEnd(const LexerContext&) const;
-	const LexerRule* _getRuleThatMatchesWithBegin(const LexerContext&) const;
-
-	bool _canMatch(const std::string& rule,
-		const std::string& text);
-	
+	void _compileRules();
+	void _lexText();
+	void _lexTextInParallel(unsigned int workerCount);
+	void _lexRange(size_t begin, size_t end, TokenVector& tokens);
+
+	std::string _locationString(size_t offset) const;
+
+	bool _isWhitespaceRule(int rule) const;
 };
 
 Lexer::Lexer()
@@ -155,26 +134,56 @@ Lexer::~Lexer()
 
 void Lexer::setStream(std::istream* stream)
 {
-	_engine->reset(stream);
-}	
+	_engine->setStream(stream);
+}
+
+void Lexer::setFileName(const std::string& filename)
+{
+	_engine->mapFile(filename);
+}
 
-std::string Lexer::peek()
+Lexer::StringRef Lexer::peek()
 {
 	return _engine->peek();
 }
 
 std::string Lexer::location() const
 {
+	size_t line   = 0;
+	size_t column = 0;
+
+	_engine->getLocation(_engine->currentOffset(), line, column);
+
 	std::stringstream stream;
-	
-	stream << "(" << _engine->line << ":" << _engine->column << ")";
-	
+
+	stream << "(" << line << ":" << column << ")";
+
 	return stream.str();
 }
 
-std::string Lexer::nextToken()
+size_t Lexer::line() const
+{
+	size_t line   = 0;
+	size_t column = 0;
+
+	_engine->getLocation(_engine->currentOffset(), line, column);
+
+	return line;
+}
+
+size_t Lexer::column() const
 {
-	auto result = _engine->nextToken();	
+	size_t line   = 0;
+	size_t column = 0;
+
+	_engine->getLocation(_engine->currentOffset(), line, column);
+
+	return column;
+}
+
+Lexer::StringRef Lexer::nextToken()
+{
+	auto result = _engine->nextToken();
 
 	hydrazine::log("Lexer") << "scanned token '" << result << "'\n";
 
@@ -186,14 +195,14 @@ bool Lexer::hitEndOfStream() const
 	return _engine->hitEndOfStream();
 }
 
-bool Lexer::scan(const std::string& token)
+bool Lexer::scan(const StringRef& token)
 {
 	hydrazine::log("Lexer") << "scanning for token '" << token << "'\n";
-	
+
 	return nextToken() == token;
 }
 
-void Lexer::scanThrow(const std::string& token)
+void Lexer::scanThrow(const StringRef& token)
 {
 	if(!scan(token))
 	{
@@ -201,16 +210,31 @@ void Lexer::scanThrow(const std::string& token)
 	}
 }
 
-bool Lexer::scanPeek(const std::string& token)
+bool Lexer::scanPeek(const StringRef& token)
 {
 	hydrazine::log("Lexer") << "scanning/peek for token '" << token << "'\n";
-	
+
 	return peek() == token;
 }
 
+size_t Lexer::tokenIndex() const
+{
+	return _engine->tokenIndex();
+}
+
+Lexer::StringRef Lexer::tokenRange(size_t begin, size_t end) const
+{
+	return _engine->tokenRange(begin, end);
+}
+
+void Lexer::skipToToken(size_t index)
+{
+	_engine->skipToToken(index);
+}
+
 void Lexer::reset()
 {
-	_engine->reset(_engine->stream);
+	_engine->reset();
 }
 
 void Lexer::checkpoint()
@@ -252,22 +276,33 @@ void Lexer::addTokens(const StringList& regexes)
 	}
 }
 
-void LexerEngine::reset(std::istream* s)
+void LexerEngine::setStream(std::istream* s)
 {
 	stream = s;
-	
-	stream->clear();
-	stream->seekg(0, std::ios::beg);
-	
-	line   = 0;
-	column = 0;
-	
+
+	_input.read(*s);
+
+	reset();
+}
+
+void LexerEngine::mapFile(const std::string& filename)
+{
+	stream = nullptr;
+
+	_input.map(filename);
+
+	reset();
+}
+
+void LexerEngine::reset()
+{
 	checkpoints.clear();
-	
-	// Create the entire set of tokens
-	_createTokens();
-	_mergeTokens();
-	_removeWhitespace();
+
+	// Compile the rules into a DFA, then scan the text in a single pass
+	_compileRules();
+	_lexText();
+
+	_nextToken = _tokens.begin();
 }
 
 void LexerEngine::checkpoint()
@@ -284,27 +319,21 @@ void LexerEngine::restore()
 	checkpoints.pop_back();
 }
 
-std::string LexerEngine::nextToken()
+util::StringRef LexerEngine::nextToken()
 {
 	auto result = peek();
-	
+
 	if(_nextToken != _tokens.end()) ++_nextToken;
-	
+
 	return result;
 }
 
-std::string LexerEngine::peek()
+util::StringRef LexerEngine::peek()
 {
-	if(hitEndOfStream()) return "";
+	if(hitEndOfStream()) return util::StringRef();
 
-	std::string result(_nextToken->endPosition -
-		_nextToken->beginPosition, ' ');
-
-	stream->seekg(_nextToken->beginPosition);
-	
-	stream->read((char*)result.data(), result.size());
-	
-	return result;
+	return util::StringRef(_input.data() + _nextToken->beginPosition,
+		_nextToken->endPosition - _nextToken->beginPosition);
 }
 
 bool LexerEngine::hitEndOfStream() const
@@ -312,752 +341,418 @@ bool LexerEngine::hitEndOfStream() const
 	return _nextToken == _tokens.end();
 }
 
-void LexerEngine::_createTokens()
+size_t LexerEngine::tokenIndex() const
 {
-	_tokens.clear();
-
-	hydrazine::log("Lexer") << "Creating initial tokens...\n";
-
-	stream->seekg(0, std::ios::end);
-
-	size_t streamSize = stream->tellg();
+	return _nextToken - _tokens.begin();
+}
 
-	stream->seekg(0, std::ios::beg);
+util::StringRef LexerEngine::tokenRange(size_t begin, size_t end) const
+{
+	if(begin >= end || end > _tokens.size()) return util::StringRef();
 
-	for(size_t i = 0; i < streamSize; ++i)
-	{
-		_tokens.push_back(TokenDescriptor(this));
-			
-		_snext();
-	}
+	return util::StringRef(_input.data() + _tokens[begin].beginPosition,
+		_tokens[end - 1].endPosition - _tokens[begin].beginPosition);
 }
 
-void LexerEngine::_mergeTokens()
+void LexerEngine::skipToToken(size_t index)
 {
-	hydrazine::log("Lexer") << "Merging partial tokens together...\n";
+	assert(index <= _tokens.size());
 
-	unsigned int counter = 0;
-	unsigned int unmatchedTokenCount = _tokens.size();
-	
-	while(true)
-	{
-		hydrazine::log("Lexer") << "============== Iteration "
-			<< counter++ << " ==============\n";
-
-		hydrazine::log("Lexer") << " Filtering out matched tokens:\n";
-		
-		// Filter out matched tokens
-		// Parallel for-all, start from previous unmatched count
-		unsigned int unmatchedCount = 0;
-		for(auto token = _tokens.begin(); token != _tokens.end(); ++token)
-		{
-			auto next = token; ++next;
-			
-			if(next != _tokens.end())
-			{
-				if(token->isMatched(*next)) continue;
-			}
-			else
-			{
-				if(token->isMatched()) continue;
-			}
-			
-			_filterWithNeighbors(token);
-			
-			bool isMatched = false;
-			
-			if(next != _tokens.end())
-			{
-				isMatched = token->isMatched(*next);
-			}
-			else
-			{
-				isMatched = token->isMatched();
-			}
-			
-			if(isMatched)
-			{
-				hydrazine::log("Lexer") << "  Token '" << token->getString()
-					<< "' after filtering matched rule '"
-					<< (*token->possibleMatches.begin())->toString()
-					<< "'\n";
-		
-				continue;
-			}
-			
-			++unmatchedCount;
-		}
+	_nextToken = _tokens.begin() + index;
+}
 
-		hydrazine::log("Lexer") << " unmatched token count "
-			<< unmatchedCount << "\n";
-		
-		if(unmatchedCount == 0) break;
-		
-		assertM(counter < 2 || unmatchedCount < unmatchedTokenCount,
-			"Lexing did not make enough progress during this iteration ("
-			<< unmatchedCount << " vs " << unmatchedTokenCount << ").");
-
-		unmatchedTokenCount = unmatchedCount;
-		
-		TokenVector newTokens;
-	
-		hydrazine::log("Lexer") << " Merging unmatched tokens with neighbors\n";
-		
-		// merge with neighbors
-		// Parallel for-all
-		for(auto token = _tokens.begin(); token != _tokens.end(); ++token)
-		{
-			auto next = token; ++next;
-			
-			if(next == _tokens.end())
-			{
-				if(token->isMatched())
-				{
-					newTokens.push_back(*token);
-					continue;
-				}
-			}
-			else
-			{
-				if(token->isMatched(*next))
-				{
-					newTokens.push_back(*token);
-					continue;
-				}
-			}
+size_t LexerEngine::currentOffset() const
+{
+	if(_nextToken == _tokens.end()) return _input.size();
 
-			hydrazine::log("Lexer") << "  For unmatched token '"
-				<< token->getString() << "' "
-				<< (_isNewToken(token) ? " (starts new token)":"") << "\n";
-			
-			if(next == _tokens.end())
-			{
-				hydrazine::log("Lexer") << "   attempting to merge with "
-					"end of stream.\n";
-				newTokens.push_back(_mergeWithEnd(token));
-				
-				continue;
-			}
-			else
-			{
-				hydrazine::log("Lexer") << "   attempting to merge with '" <<
-					next->getString() << "'\n";
-				
-				if(_canMerge(token, next))
-				{
-					hydrazine::log("Lexer") << "    success: merging '"
-						<< token->getString() << "' with '"
-						<< next->getString() << "'\n";
-					
-					auto merged = _mergeWithNext(token, next);
-					
-					assertM(!merged.possibleMatches.empty(), 
-						"No possible matches for merged token '"
-						<< merged.getString() << "'");
-					
-					newTokens.push_back(merged);
-				}
-				else
-				{
-					hydrazine::log("Lexer") << "    failed\n";
-					newTokens.push_back(*token);
-					newTokens.push_back(*next );
-				}
-			}
-			
-			++token;
-		}
-		
-		// Update tokens
-		// Parallel stream compaction
-		_tokens = std::move(newTokens);
-	}
-	
-	_nextToken = _tokens.begin();
+	return _nextToken->beginPosition;
 }
 
-void LexerEngine::_removeWhitespace()
+void LexerEngine::getLocation(size_t offset, size_t& line,
+	size_t& column) const
 {
-	hydrazine::log("Lexer") << "Removing whitespace matches\n";
-				
-	RuleSet whitespaceRuleSet;
-	
-	for(auto& rule : whitespaceRules)
-	{
-		whitespaceRuleSet.insert(&rule);
-	}
-	
-	// Parallel remove + stream compact
-	TokenVector newTokens;
+	const char* text = _input.data();
 
-	for(auto& token : _tokens)
+	if(offset > _input.size()) offset = _input.size();
+
+	line = 0;
+
+	size_t lineStart = 0;
+
+	for(size_t i = 0; i < offset; ++i)
 	{
-		if(whitespaceRuleSet.count(token.getMatchedRule()) == 0)
-		{
-			hydrazine::log("Lexer") << " lexed '"
-				<< token.getString() << "'\n";
-			newTokens.push_back(token);
-		}
-		else
+		if(text[i] == '\n')
 		{
-			hydrazine::log("Lexer") << "  removed '"
-				<< token.getString() << "'\n";
+			++line;
+
+			lineStart = i + 1;
 		}
 	}
-	
-	_tokens = std::move(newTokens);
 
-	_nextToken = _tokens.begin();
+	column = offset - lineStart;
 }
 
-char LexerEngine::_snext()
-{
-	char c = stream->get();
-	
-	if(c == '\n')
-	{
-		++line;
-		column = 0;
-	}
-	else
-	{
-		++column;
-	}
-	
-	return c;
-}
+typedef std::vector<unsigned int> PositionVector;
+
+static const unsigned int CharacterLimit = 256;
 
-void LexerEngine::_filterWithNeighbors(const LexerContext& token)
+/*! \brief An NFA over regex element positions of all rules, laid out
+	rule after rule with an extra accepting position past each rule's
+	last element.  This is the input to subset construction. */
+class RulePositions
 {
-	hydrazine::log("Lexer") << "  checking token possible matches for '" <<
-		token->getString() << "'\n";
-	
-	bool isNewToken = _isNewToken(token);
-
-	auto next = token; ++next;
-	
-	bool isTokenEnd = next == _tokens.end();
-	
-	if(!isTokenEnd)
-	{
-		isTokenEnd = !_isAMergePossible(token, next);
-	}
+public:
+	typedef std::vector<bool> BoolVector;
 
-	hydrazine::log("Lexer") << "   possible matches for '" <<
-		token->getString() << "'"
-		<< (isNewToken ? " (starts new token)":"") 
-		<< (isTokenEnd ? " (ends current token)":"") << "\n";
+public:
+	std::vector<BoolVector> matches;        // position -> character -> match
+	BoolVector              repeated;
+	std::vector<int>        acceptingRules; // -1 for interior positions
 
-	LexerEngine::RuleSet remainingRules;
+public:
+	void addClosure(unsigned int position, PositionVector& set) const;
+};
 
-	auto tokenString = token->getString();
+void RulePositions::addClosure(unsigned int position,
+	PositionVector& set) const
+{
+	set.push_back(position);
 
-	for(auto rule : token->possibleMatches)
+	// repeated elements match zero instances, fall through to the next
+	while(repeated[position])
 	{
-		if(isNewToken && !rule->canMatchWithBegin(tokenString))
-		{
-			hydrazine::log("Lexer") << "    filtered out rule '" <<
-				rule->toString() << "', can't match with begin.\n";;
-
-			continue;
-		}
-		
-		if(isTokenEnd &&   !rule->canMatchWithEnd(tokenString))
-		{
-			hydrazine::log("Lexer") << "    filtered out rule '" <<
-				rule->toString() << "', can't match with end.\n";;
-
-			continue;
-		}
-		
-		if(!rule->canMatch(tokenString))
-		{
-			hydrazine::log("Lexer") << "    filtered out rule '" <<
-				rule->toString() << "', can't at all.\n";;
-
-			continue;
-		}
-		
-		hydrazine::log("Lexer") << "    '" << rule->toString() << "'\n";
-	
-		remainingRules.insert(rule);
+		set.push_back(++position);
 	}
-	
-	assertM(!remainingRules.empty(), "No possible matched for token '"
-		<< token->getString() << "'");
-	
-	token->possibleMatches = std::move(remainingRules);
 }
 
-LexerEngine::TokenDescriptor LexerEngine::_mergeWithEnd(
-	const LexerContext& token)
+static void addRuleToNfa(RulePositions& nfa, PositionVector& startSet,
+	const LexerRule& rule, int ruleIndex)
 {
-	auto string = token->getString();
-	
-	TokenDescriptor newToken(*token);
+	unsigned int begin = nfa.repeated.size();
 
-	hydrazine::log("Lexer") << "   possible matches:\n";
-	
-	for(auto rule : token->possibleMatches)
+	for(size_t element = 0; element != rule.elementCount(); ++element)
 	{
-		if(rule->canMatchWithEnd(string))
+		RulePositions::BoolVector row(CharacterLimit, false);
+
+		for(unsigned int c = 0; c != CharacterLimit; ++c)
 		{
-			hydrazine::log("Lexer") << "    '" << rule->toString() << "'\n";
-			newToken.possibleMatches.insert(rule);
+			row[c] = rule.elementMatches(element, (char)c);
 		}
+
+		nfa.matches.push_back(std::move(row));
+		nfa.repeated.push_back(rule.elementIsRepeated(element));
+		nfa.acceptingRules.push_back(-1);
 	}
-	
-	if(newToken.isMatched())
-	{
-		hydrazine::log("Lexer") << "   Token '" << newToken.getString()
-			<< "' after merging with end matched rule '"
-			<< (*newToken.possibleMatches.begin())->toString()
-			<< "'\n";
-	}
-	
-	return newToken;
-}
 
-static LexerEngine::RuleSet intersection(const LexerEngine::RuleSet& left,
-	const LexerEngine::RuleSet& right)
-{
-	LexerEngine::RuleSet result;
-	
-	std::set_intersection(left.begin(), left.end(), right.begin(), right.end(),
-		std::inserter(result, result.end()));
-	
-	return result;
+	// the position past the last element accepts the rule
+	nfa.matches.push_back(RulePositions::BoolVector(CharacterLimit, false));
+	nfa.repeated.push_back(false);
+	nfa.acceptingRules.push_back(ruleIndex);
+
+	nfa.addClosure(begin, startSet);
 }
 
-LexerEngine::TokenDescriptor LexerEngine::_mergeWithNext(
-	const LexerContext& token,
-	const LexerContext& next)
+static void sortAndUnique(PositionVector& set)
 {
-	hydrazine::log("Lexer") << "   merging '" << token->getString()
-		<< "' with '" << next->getString() << "':\n";
-	
-	TokenDescriptor newToken(*token, *next);
-	
-	auto string = newToken.getString();
-	
-	// The set of possible matches is the intersection of the two tokens
-	auto possibleMatches = intersection(token->possibleMatches,
-		next->possibleMatches);
-	
-	// Only keep matches that handle the combined string
-	hydrazine::log("Lexer") << "    possible rule matches:\n";
-	for(auto rule : possibleMatches)
-	{
-		if(rule->canMatch(string))
-		{
-			hydrazine::log("Lexer") << "     '" << rule->toString() << "'\n";
-			newToken.possibleMatches.insert(rule);
-		}
-	}
-	
-	if(newToken.isMatched())
-	{
-		hydrazine::log("Lexer") << "   Token '" << newToken.getString()
-			<< "' after merging matched rule '"
-			<< (*newToken.possibleMatches.begin())->toString()
-			<< "'\n";
-	}
-	
-	return newToken;
+	std::sort(set.begin(), set.end());
+
+	set.erase(std::unique(set.begin(), set.end()), set.end());
 }
 
-bool LexerEngine::_isAMergePossible(
-	const LexerContext& token,
-	const LexerContext& next)
+static int acceptingRule(const RulePositions& nfa, const PositionVector& set)
 {
-	hydrazine::log("Lexer") << "   checking if '" << token->getString()
-		<< "' can merge with '" << next->getString() << "':\n";
-	
-	auto possibleMatches = intersection(token->possibleMatches,
-		next->possibleMatches);
-		
-	if(possibleMatches.empty())
+	int rule = -1;
+
+	for(auto position : set)
 	{
-		hydrazine::log("Lexer") << "    can't merge, no shared rules.\n";
-		return false;
+		int candidate = nfa.acceptingRules[position];
+
+		if(candidate == -1) continue;
+
+		if(rule == -1 || candidate < rule) rule = candidate;
 	}
-	
-	hydrazine::log("Lexer") << "    merge is possible.\n";
-	return true;
+
+	return rule;
 }
 
-bool LexerEngine::_canMerge(
-	const LexerContext& token,
-	const LexerContext& next)
+void LexerEngine::_compileRules()
 {
-	// Can merge if the right token cannot start a new token
-	if(!_couldBeTokenBegin(next))
-	{
-		return true;
-	}
-	
-	// Can't merge if there is ambiguity about the left being a token end
-	if(_couldBeTokenEnd(token))
-	{
-		bool canStillMerge = false;
-
-		// allow 't' to join with 'arget', even though 't' matches the end
-		canStillMerge |= _formsLargerMatchOfTheSameRule(token, next);
-		
-		// allow '%' to join with '_identifier', if '%' is a rule
-		// TODO: add general purpose way of handling short rules that are subsets
-		//       of longer rules
-		canStillMerge |= _nextCantMatchOtherwise(token, next);
-	
-		if(!canStillMerge)
-		{
-			hydrazine::log("Lexer") << "     can't merge, "
-				"left could be a token end ("
-				<< _getRuleThatMatchesWithEnd(token)->toString() << ").\n";
-			return false;
-		}
-		
-	}
-	
-	// Or the right being a token begin
-	if(!_isNewToken(token) && !token->isBeginMatched())
+	hydrazine::log("Lexer") << "Compiling rules into a DFA...\n";
+
+	RulePositions  nfa;
+	PositionVector startSet;
+
+	int ruleIndex = 0;
+
+	for(auto& rule : tokenRules)
 	{
-		if(_couldBeTokenBegin(next))
-		{
-			hydrazine::log("Lexer") << "     can't merge, "
-				"right could be a token begin ("
-				<< _getRuleThatMatchesWithBegin(next)->toString() << ").\n";
-			return false;
-		}
+		addRuleToNfa(nfa, startSet, rule, ruleIndex++);
 	}
-	
-	return true;
-}
-
-bool LexerEngine::_isNewToken(const LexerContext& token)
-{
-	bool isNewToken = (token == _tokens.begin());
 
-	if(!isNewToken)
+	for(auto& rule : whitespaceRules)
 	{
-		auto previous = token; --previous;
-		
-		if(previous->isEndMatched())
-		{
-			return true;
-		}
+		addRuleToNfa(nfa, startSet, rule, ruleIndex++);
 	}
-	
-	return isNewToken;
-}	
 
-bool LexerEngine::_couldBeTokenEnd(const LexerContext& token)
-{
-	return _getRuleThatMatchesWithEnd(token) != nullptr;
-}
+	sortAndUnique(startSet);
 
-bool LexerEngine::_couldBeTokenBegin(const LexerContext& token)
-{
-	return _getRuleThatMatchesWithBegin(token) != nullptr;
-}
+	typedef std::map<PositionVector, int> StateIdMap;
 
-bool LexerEngine::_formsLargerMatchOfTheSameRule(
-	const LexerContext& left,
-	const LexerContext& right)
-{
-	auto string = left->getString();
+	StateIdMap stateIds;
 
-	// find end matching rules
-	RuleSet endMatchingRules;
+	std::vector<PositionVector> worklist;
 
-	for(auto rule : left->possibleMatches)
-	{
-		if(rule->canMatchWithEnd(string))
-		{
-			endMatchingRules.insert(rule);
-		}
-	}
+	_transitions.clear();
+	_acceptingRules.clear();
+
+	stateIds.insert(std::make_pair(startSet, 0));
+	worklist.push_back(startSet);
 
-	auto combined = string + right->getString();
+	_transitions.resize(CharacterLimit, -1);
+	_acceptingRules.push_back(acceptingRule(nfa, startSet));
 
-	if(_isNewToken(left))
+	for(unsigned int state = 0; state != worklist.size(); ++state)
 	{
-		// Does at least one of the rules still match the merged token
-		bool atLeastOneMatch = false;
+		// copy, the worklist grows while transitions are added
+		auto positions = worklist[state];
 
-		for(auto rule : endMatchingRules)
+		for(unsigned int c = 0; c != CharacterLimit; ++c)
 		{
-			hydrazine::log("Lexer") << "      checking rule '"
-				<< rule->toString() << "' against '" << combined << "'\n";
-			
-			if(rule->isExactMatch(string))
+			PositionVector next;
+
+			for(auto position : positions)
 			{
-				if(rule->isExactMatch(combined))
+				if(!nfa.matches[position][c]) continue;
+
+				if(nfa.repeated[position])
 				{
-					hydrazine::log("Lexer") << "      exact match\n";
-					atLeastOneMatch = true;
-					break;
+					nfa.addClosure(position, next);
+				}
+				else
+				{
+					nfa.addClosure(position + 1, next);
 				}
 			}
-		}
 
-		if(atLeastOneMatch) return true;
+			if(next.empty()) continue;
 
-		// find begin matching rules
-		RuleSet beginMatchingRules;
+			sortAndUnique(next);
 
-		for(auto rule : left->possibleMatches)
-		{
-			if(rule->canMatchWithBegin(string) && !rule->isExactMatch(string))
+			auto id = stateIds.insert(
+				std::make_pair(next, (int)stateIds.size()));
+
+			if(id.second)
 			{
-				beginMatchingRules.insert(rule);
+				worklist.push_back(next);
+
+				_transitions.resize(
+					_transitions.size() + CharacterLimit, -1);
+				_acceptingRules.push_back(acceptingRule(nfa, next));
 			}
+
+			_transitions[state * CharacterLimit + c] = id.first->second;
 		}
-		
-		for(auto rule : beginMatchingRules)
+	}
+
+	// gather the self looping bytes of every state for block scanning
+	_selfLoops.assign(_acceptingRules.size(), util::ByteClass());
+
+	for(size_t state = 0; state != _acceptingRules.size(); ++state)
+	{
+		for(unsigned int c = 0; c != CharacterLimit; ++c)
 		{
-			if(rule->canMatchWithBegin(combined))
+			if(_transitions[state * CharacterLimit + c] == (int)state)
 			{
-				hydrazine::log("Lexer") << "      match with begin\n";
-				atLeastOneMatch = true;
-				break;
+				_selfLoops[state].insert((unsigned char)c);
 			}
 		}
-
-		return atLeastOneMatch;
 	}
-	else
+
+	// a character only matched by single character whitespace rules can
+	// never appear inside a token, so lexing may restart right after one
+	_newlineIsSafeBreak = false;
+
+	for(auto& rule : whitespaceRules)
 	{
-		// Do all of the rules still match the merged token?
-		for(auto rule : endMatchingRules)
+		if(rule.elementCount() == 1 && rule.elementMatches(0, '\n'))
 		{
-			hydrazine::log("Lexer") << "      checking rule "
-				<< rule->toString() << " against " << combined << "\n";
-			
-			if(!rule->canMatch(combined))
-			{
-				hydrazine::log("Lexer") << "      failed\n";
-				return false;
-			}
+			_newlineIsSafeBreak = true;
+		}
+	}
 
-			if(rule->isExactMatch(string) && !rule->isExactMatch(combined))
+	for(auto& rule : tokenRules)
+	{
+		for(size_t element = 0; element != rule.elementCount(); ++element)
+		{
+			if(rule.elementMatches(element, '\n'))
 			{
-				hydrazine::log("Lexer")
-					<< "      failed, not exact match with ("
-					<< rule->toString() << ")\n";
-				return false;
+				_newlineIsSafeBreak = false;
 			}
 		}
 	}
 
-	return true;
+	hydrazine::log("Lexer") << " compiled " << ruleIndex << " rules into "
+		<< _acceptingRules.size() << " dfa states\n";
 }
 
-bool LexerEngine::_nextCantMatchOtherwise(
-	const LexerContext& left,
-	const LexerContext& right)
+bool LexerEngine::_isWhitespaceRule(int rule) const
 {
-	return false;
+	return rule >= (int)tokenRules.size();
 }
 
-const LexerRule* LexerEngine::_getRuleThatMatchesWithBegin(
-	const LexerContext& token) const
+void LexerEngine::_lexText()
 {
-	auto string = token->getString();
-	
-	for(auto rule : token->possibleMatches)
-	{
-		if(rule->canMatchWithBegin(string)) return rule;
-	}
-	
-	return nullptr;
-}
+	_tokens.clear();
 
-const LexerRule* LexerEngine::_getRuleThatMatchesWithEnd(
-	const LexerContext& token) const
-{
-	auto string = token->getString();
-	
-	for(auto rule : token->possibleMatches)
-	{
-		if(rule->canMatchWithEnd(string)) return rule;
-	}
-	
-	return nullptr;
-}
+	// a chunk per worker pays off once the text spans many pages
+	const size_t minimumParallelSize = 1 << 20;
 
-LexerEngine::TokenDescriptor::TokenDescriptor(LexerEngine* e)
-: beginPosition(e->stream->tellg()),
-  endPosition((size_t)e->stream->tellg() + 1),
-  line(e->line), column(e->column), engine(e), tokenIsMatched(false)
-{
-	hydrazine::log("Lexer") << " created new token '"
-		<< getString() << "'\n";
+	unsigned int workerCount = util::Executor::instance().workers();
 
-	for(auto& rule : engine->tokenRules)
+	if(_newlineIsSafeBreak && workerCount > 1 &&
+		_input.size() >= minimumParallelSize)
 	{
-		hydrazine::log("Lexer") << "  could match rule '"
-			<< rule.toString() << "'\n";
-		possibleMatches.insert(&rule);
+		_lexTextInParallel(workerCount);
 	}
-	
-	for(auto& rule : engine->whitespaceRules)
-	{
-		hydrazine::log("Lexer") << "  could match rule '"
-			<< rule.toString() << "'\n";
-		possibleMatches.insert(&rule);
-	}
-	
-	if(isMatched())
+	else
 	{
-		hydrazine::log("Lexer") << "  Token '" << getString()
-			<< "' during creation matched rule '" << getMatchedRule()->toString()
-			<< "'\n";
+		hydrazine::log("Lexer") << "Lexing the text in a single pass...\n";
+
+		_lexRange(0, _input.size(), _tokens);
 	}
 }
 
-LexerEngine::TokenDescriptor::TokenDescriptor(const TokenDescriptor& left,
-	const TokenDescriptor& right)
-: beginPosition(left.beginPosition),
-  endPosition(right.endPosition),
-  line(left.line), column(right.column), engine(left.engine),
-  tokenIsMatched(false)
+void LexerEngine::_lexTextInParallel(unsigned int workerCount)
 {
-	assert(left.endPosition == right.beginPosition);
-}
+	const char*  text     = _input.data();
+	const size_t textSize = _input.size();
 
-bool LexerEngine::TokenDescriptor::isBeginMatched() const
-{
-	assertM(!possibleMatches.empty(), "No possible matched for token '"
-		<< getString() << "'");
-	
-	if(possibleMatches.size() > 1) return false;
+	// chunks begin just after a newline, which no token rule can match,
+	// so every chunk starts exactly on a token boundary at column zero
+	std::vector<size_t> boundaries;
 
-	auto firstRule = (*possibleMatches.begin());
+	boundaries.push_back(0);
 
-	return firstRule->canOnlyMatchWithBegin(getString());
-}
+	size_t target = textSize / workerCount;
 
-bool LexerEngine::TokenDescriptor::isEndMatched() const
-{
-	assertM(!possibleMatches.empty(), "No possible matched for token '"
-		<< getString() << "'");
-		
-	if(isMatched())
+	for(unsigned int i = 1; i < workerCount; ++i)
 	{
-		return true;
-	}
+		size_t position = std::max(boundaries.back(), i * target);
 
-	if(possibleMatches.size() > 1) return false;
+		while(position < textSize && text[position] != '\n') ++position;
 
-	auto firstRule = (*possibleMatches.begin());
+		if(position + 1 >= textSize) break;
 
-	if(firstRule->isEndRepeated()) return false;
+		boundaries.push_back(position + 1);
+	}
 
-	return firstRule->canOnlyMatchWithEnd(getString());
-}
+	boundaries.push_back(textSize);
 
-size_t LexerEngine::TokenDescriptor::size() const
-{
-	return endPosition - beginPosition;
-}
+	size_t chunkCount = boundaries.size() - 1;
 
-bool LexerEngine::TokenDescriptor::isMatched() const
-{
-	assertM(!possibleMatches.empty(), "No possible matched for token '"
-		<< getString() << "'");
-	
-	if(tokenIsMatched) return true;
-		
-	if(possibleMatches.size() > 1) return false;
+	hydrazine::log("Lexer") << "Lexing " << chunkCount
+		<< " chunks in parallel...\n";
 
-	auto firstRule = (*possibleMatches.begin());
+	std::vector<TokenVector> chunkTokens(chunkCount);
 
-	if(firstRule->isEndRepeated()) return false;
+	util::Executor::instance().parallelFor(chunkCount, [&](size_t i)
+	{
+		_lexRange(boundaries[i], boundaries[i + 1], chunkTokens[i]);
+	});
 
-	bool match = firstRule->isExactMatch(getString());
+	// merge, tokens carry buffer offsets so no adjustment is needed
+	size_t totalTokens = 0;
 
-	return match;
-}
+	for(auto& tokens : chunkTokens) totalTokens += tokens.size();
 
-bool LexerEngine::TokenDescriptor::isMatched()
-{
-	if(const_cast<const TokenDescriptor*>(this)->isMatched())
+	_tokens.reserve(totalTokens);
+
+	for(auto& tokens : chunkTokens)
 	{
-		if(!tokenIsMatched)
-		{
-			tokenIsMatched = true;
-			hydrazine::log("Lexer") << "  Token '" << getString()
-				<< "' is matched exactly\n";
-		}
+		_tokens.insert(_tokens.end(), tokens.begin(), tokens.end());
 	}
-
-	return tokenIsMatched;
 }
 
-bool LexerEngine::TokenDescriptor::isMatched(const TokenDescriptor& next)
+void LexerEngine::_lexRange(size_t begin, size_t end, TokenVector& tokens)
 {
-	if(tokenIsMatched) return true;
-	
-	if(possibleMatches.size() > 1) return false;
-	
-	auto firstRule = (*possibleMatches.begin());
-	
-	auto string = getString();
-
-	if(firstRule->isExactMatch(string))
+	const char* text = _input.data();
+
+	const size_t textSize = end;
+
+	size_t position = begin;
+
+	while(position != textSize)
 	{
-		if(firstRule->isEndRepeated())
+		// run the DFA greedily, remembering the last accepting state
+		int    state        = 0;
+		int    acceptedRule = -1;
+		size_t current      = position;
+		size_t acceptedEnd  = position;
+
+		while(current != textSize)
 		{
-			auto combined = string + next.getString();
+			state = _transitions[state * CharacterLimit +
+				(unsigned char)text[current]];
 
-			if(firstRule->isExactMatch(combined))
+			if(state == -1) break;
+
+			++current;
+
+			int rule = _acceptingRules[state];
+
+			if(rule != -1)
 			{
-				return false;
+				acceptedRule = rule;
+				acceptedEnd  = current;
+			}
+
+			// consume the whole run of bytes that stay in this state
+			auto& selfLoop = _selfLoops[state];
+
+			if(!selfLoop.empty())
+			{
+				current = selfLoop.scan(text, current, textSize);
+
+				if(rule != -1) acceptedEnd = current;
 			}
 		}
-		
-		hydrazine::log("Lexer") << "  Token '" << getString()
-			<< "' is matched exactly when considering next token '"
-			<< next.getString() << "'\n";
-		
-		tokenIsMatched = true;
-		return true;
-	}
 
-	return false;
+		assertM(acceptedRule != -1, _locationString(position)
+			<< ": no rule matches text starting with '"
+			<< text[position] << "'");
 
-}
+		if(!_isWhitespaceRule(acceptedRule))
+		{
+			Token token;
 
-LexerRule* LexerEngine::TokenDescriptor::getMatchedRule()
-{
-	assertM(!possibleMatches.empty(), "No possible matched for token '"
-		<< getString() << "'");
-		
-	if(possibleMatches.size() == 1) return *possibleMatches.begin();
+			token.beginPosition = position;
+			token.endPosition   = acceptedEnd;
 
-	return nullptr;
+			hydrazine::log("Lexer") << " lexed '" << util::StringRef(
+				text + position, acceptedEnd - position) << "'\n";
+
+			tokens.push_back(token);
+		}
+
+		position = acceptedEnd;
+	}
 }
 
-std::string LexerEngine::TokenDescriptor::getString() const
+std::string LexerEngine::_locationString(size_t offset) const
 {
-	auto mutableEngine = const_cast<LexerEngine*>(engine);
+	size_t line   = 0;
+	size_t column = 0;
 
-	std::string result(size(), ' ');
+	getLocation(offset, line, column);
 
-	auto position = mutableEngine->stream->tellg();
+	std::stringstream stream;
 
-	mutableEngine->stream->seekg(beginPosition, std::ios::beg);
-	
-	mutableEngine->stream->read((char*)(result.data()), size());
+	stream << "(" << line << ":" << column << ")";
 
-	mutableEngine->stream->seekg(position, std::ios::beg);
-	
-	return result;
+	return stream.str();
 }
 
 }
 
 }
 
-
@@ -119,6 +119,33 @@ bool LexerRule::isEndRepeated() const
 	return (*regex_rbegin())->isRepeated();
 }
 
+size_t LexerRule::elementCount() const
+{
+	return _regex.size();
+}
+
+bool LexerRule::elementMatches(size_t element, char c) const
+{
+	assert(element < _regex.size());
+
+	std::string text(1, c);
+
+	const_iterator position = text.begin();
+
+	_regex[element]->matches(position, text.end());
+
+	// repeated elements match zero instances vacuously, so test
+	// whether the character was consumed instead of the return value
+	return position != text.begin();
+}
+
+bool LexerRule::elementIsRepeated(size_t element) const
+{
+	assert(element < _regex.size());
+
+	return _regex[element]->isRepeated();
+}
+
 const std::string& LexerRule::toString() const
 {
 	return _rawString;
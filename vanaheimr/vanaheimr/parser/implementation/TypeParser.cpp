@@ -13,6 +13,8 @@
 
 #include <vanaheimr/ir/interface/Type.h>
 
+#include <vanaheimr/util/interface/StringRef.h>
+
 // Hydrazine Includes
 #include <hydrazine/interface/debug.h>
 
@@ -25,8 +27,12 @@ namespace vanaheimr
 namespace parser
 {
 
-TypeParser::TypeParser(Compiler* c, const TypeAliasSet* a)
-: _compiler(c), _parsedType(nullptr), _typedefs(a), _lexer(nullptr)
+typedef util::StringRef StringRef;
+
+TypeParser::TypeParser(Compiler* c, const TypeAliasSet* a,
+	SignatureCache* cache)
+: _compiler(c), _parsedType(nullptr), _typedefs(a), _cache(cache),
+	_lexer(nullptr)
 {
 
 }
@@ -53,8 +59,8 @@ void TypeParser::parse(Lexer* lexer)
 	_parsedType = nullptr;
 
 	_lexer = lexer;
-	
-	_parsedType = _parseType();
+
+	_parsedType = _parseMemoizedType();
 
 	_lexer = nullptr;
 }
@@ -66,42 +72,42 @@ const ir::Type* TypeParser::parsedType() const
 	return _parsedType;
 }
 
-static bool isFunction(const std::string& token)
+static bool isFunction(const StringRef& token)
 {
 	return token.find("(") == 0;
 }
 
-static bool isStructure(const std::string& token)
+static bool isStructure(const StringRef& token)
 {
 	return token.find("{") == 0;
 }
 
-static bool isArray(const std::string& token)
+static bool isArray(const StringRef& token)
 {
 	return token.find("[") == 0;
 }
 
-static bool isPointer(const std::string& token)
+static bool isPointer(const StringRef& token)
 {
 	return token.find("*") == 0;
 }
 
-static bool isVariadic(const std::string& token)
+static bool isVariadic(const StringRef& token)
 {
 	return token == "...";
 }
 
-static bool isTypeAlias(const std::string& token)
+static bool isTypeAlias(const StringRef& token)
 {
 	return token.find("%") == 0;
 }
 
-static bool isOpaqueType(const std::string& token)
+static bool isOpaqueType(const StringRef& token)
 {
 	return token.find("opaque") == 0;
 }
 
-static bool isPrimitive(compiler::Compiler* compiler, const std::string& token)
+static bool isPrimitive(compiler::Compiler* compiler, const StringRef& token)
 {
 	hydrazine::log("TypeParser::Parser") << "Checking if " << token
 		<< " is a primitive type.\n";
@@ -113,9 +119,56 @@ static bool isPrimitive(compiler::Compiler* compiler, const std::string& token)
 	return primitive->isPrimitive() || primitive->isBasicBlock();
 }
 
+ir::Type* TypeParser::_parseMemoizedType()
+{
+	if(_cache == nullptr) return _parseType();
+
+	std::string leadingToken = _lexer->peek();
+
+	// a hit is an upcoming token range with exactly the same raw text as a
+	// previously parsed signature, skip over it and reuse the parsed type
+	auto candidates = _cache->find(leadingToken);
+
+	if(candidates != _cache->end())
+	{
+		auto begin = _lexer->tokenIndex();
+
+		for(auto& candidate : candidates->second)
+		{
+			auto slice = _lexer->tokenRange(begin, begin + candidate.tokens);
+
+			if(slice == candidate.signature)
+			{
+				_lexer->skipToToken(begin + candidate.tokens);
+
+				hydrazine::log("TypeParser::Parser") << "Recalled type "
+					<< candidate.type->name << " from the signature cache.\n";
+
+				return candidate.type;
+			}
+		}
+	}
+
+	auto begin = _lexer->tokenIndex();
+
+	auto type = _parseType();
+
+	auto end = _lexer->tokenIndex();
+
+	CachedSignature entry;
+
+	entry.signature = _lexer->tokenRange(begin, end);
+	entry.tokens    = end - begin;
+	entry.type      = type;
+
+	(*_cache)[leadingToken].push_back(entry);
+
+	return type;
+}
+
 ir::Type* TypeParser::_parseType()
 {
-	std::string nextToken = _lexer->peek();
+	auto nextToken = _lexer->peek();
 	
 	ir::Type* type = nullptr;
 	
@@ -189,7 +242,7 @@ ir::Type* TypeParser::_parseFunction()
 			"type, expecting '('.");
 	}
 
-	std::string closeBrace = _lexer->peek();
+	auto closeBrace = _lexer->peek();
 
 	if(closeBrace != ")")
 	{
@@ -216,7 +269,7 @@ ir::Type* TypeParser::_parseFunction()
 		{
 			argumentTypes.push_back(_parseType());
 		
-			std::string comma = _lexer->peek();
+			auto comma = _lexer->peek();
 			
 			if(comma == ",")
 			{
@@ -258,7 +311,7 @@ ir::Type* TypeParser::_parseFunction(const ir::Type* returnType)
 		{
 			argumentTypes.push_back(_parseType());
 	       
-			std::string comma = _lexer->peek();
+			auto comma = _lexer->peek();
 		       
 			if(comma == ",")
 			{
@@ -300,7 +353,7 @@ ir::Type* TypeParser::_parseStructure()
 		{
 			types.push_back(_parseType());
 		
-			std::string comma = _lexer->peek();
+			auto comma = _lexer->peek();
 			
 			if(comma == ",")
 			{
@@ -364,7 +417,7 @@ ir::Type* TypeParser::_parseArray()
 			"type, expecting '['.");
 	}
 	
-	std::string dimensionToken = _lexer->nextToken();
+	auto dimensionToken = _lexer->nextToken();
 	
 	unsigned int dimension = parseInteger(dimensionToken);
 	
@@ -411,7 +464,7 @@ ir::Type* TypeParser::_parseTypeAlias()
 	}
 	
 	std::string token = _lexer->nextToken();
-	
+
 	auto alias = _getTypeAlias(token);
 
 	if(alias == nullptr)
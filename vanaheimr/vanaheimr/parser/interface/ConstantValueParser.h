@@ -48,6 +48,7 @@ private:
 	ir::Constant* _parseIntegerConstant();
 	ir::Constant* _parseFloatingPointConstant();
 	ir::Constant* _parseStringConstant(const ir::Type* type);
+	ir::Constant* _parseArrayConstant(const ir::Type* type);
 
 private:
 	ir::Constant* _parsedConstant;
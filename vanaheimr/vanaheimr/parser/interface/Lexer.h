@@ -6,6 +6,9 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringRef.h>
+
 // Forward Declarations
 namespace vanaheimr { namespace parser { class LexerEngine; } }
 
@@ -24,6 +27,7 @@ class Lexer
 {
 public:
 	typedef std::list<std::string> StringList;
+	typedef util::StringRef        StringRef;
 
 public:
 	Lexer();
@@ -35,7 +39,10 @@ public:
 
 public:
 	/*! brief Set the stream being lexed */
-	void setStream(std::istream* stream);	
+	void setStream(std::istream* stream);
+
+	/*! \brief Lex the named file directly through a memory mapping */
+	void setFileName(const std::string& filename);
 
 public:
 	/*! \brief Add a rule for lexing whitespace */
@@ -48,14 +55,26 @@ public:
 	void addTokenRegex(const std::string& regex);
 
 public:
-	std::string peek();
+	// tokens are slices of the input buffer, no copies are made
+	StringRef peek();
+	StringRef nextToken();
+
 	std::string location() const;
-	std::string nextToken();
 	bool hitEndOfStream() const;
 
-	bool scan(const std::string& token);
-	void scanThrow(const std::string& token);
-	bool scanPeek(const std::string& token);
+	bool scan(const StringRef& token);
+	void scanThrow(const StringRef& token);
+	bool scanPeek(const StringRef& token);
+
+public:
+	/*! \brief The index of the next token in the stream */
+	size_t tokenIndex() const;
+
+	/*! \brief The raw input text spanned by tokens [begin, end) */
+	StringRef tokenRange(size_t begin, size_t end) const;
+
+	/*! \brief Jump directly to the token with the specified index */
+	void skipToToken(size_t index);
 
 public:
 	size_t   line() const;
@@ -41,6 +41,16 @@ public:
 public:
 	bool isEndRepeated() const;
 
+public:
+	/*! \brief The number of regex elements in the rule */
+	size_t elementCount() const;
+
+	/*! \brief Can the specified regex element match the character? */
+	bool elementMatches(size_t element, char c) const;
+
+	/*! \brief Is the specified regex element repeated (zero or more)? */
+	bool elementIsRepeated(size_t element) const;
+
 public:
 	const std::string& toString() const;
 	
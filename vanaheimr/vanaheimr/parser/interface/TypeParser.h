@@ -8,6 +8,9 @@
 
 // Standard Library Includes
 #include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // Forward Declarations
 namespace vanaheimr { namespace compiler { class Compiler;     } }
@@ -26,9 +29,27 @@ class TypeParser
 {
 public:
 	typedef compiler::Compiler Compiler;
-	
+
+public:
+	/*! \brief A previously parsed signature slice */
+	class CachedSignature
+	{
+	public:
+		std::string signature; // the raw input text spanned by the type
+		size_t      tokens;    // the number of tokens in the signature
+		ir::Type*   type;      // the hash-consed parsed type
+	};
+
+	typedef std::vector<CachedSignature> CachedSignatureVector;
+
+	/*! \brief Parsed types memoized by signature slice, grouped by
+		their leading token */
+	typedef std::unordered_map<std::string, CachedSignatureVector>
+		SignatureCache;
+
 public:
-	TypeParser(Compiler* c, const TypeAliasSet* a = nullptr);
+	TypeParser(Compiler* c, const TypeAliasSet* a = nullptr,
+		SignatureCache* cache = nullptr);
 	~TypeParser();
 
 public:
@@ -44,6 +65,7 @@ public:
 
 private:
 	// High Level Parser methods
+	ir::Type* _parseMemoizedType();
 	ir::Type* _parseType();
 
 	ir::Type* _parseFunction();
@@ -59,8 +81,9 @@ private:
 private:
 	Compiler*    _compiler;
 	ir::Type*    _parsedType;
-	
+
 	const TypeAliasSet* _typedefs;
+	SignatureCache*     _cache;
 
 private:
 	Lexer* _lexer;
@@ -31,7 +31,8 @@ static bool isTraceFile(const std::string& path)
 	return extension == "trace";
 }
 
-static std::string translatePTX(const std::string& ptxFileName)
+static std::string translatePTX(const std::string& ptxFileName,
+	unsigned int workerThreads)
 {
 	// Load the PTX module
 	::ir::Module ptxModule(ptxFileName);
@@ -43,7 +44,7 @@ static std::string translatePTX(const std::string& ptxFileName)
 	
 	try
 	{
-		translator.translate(ptxModule);
+		translator.translate(ptxModule, workerThreads);
 	}
 	catch(const std::exception& e)
 	{
@@ -80,7 +81,7 @@ static std::string translateTrace(const std::string& traceFileName)
 
 /*! \brief Load a PTX module, translate it to VIR, output the result */
 static void translate(const std::string& virFileName,
-	const std::string& ptxFileName, bool binary)
+	const std::string& ptxFileName, bool binary, unsigned int workerThreads)
 {
 	// is this a ptx or trace file?
 	bool isTrace = isTraceFile(ptxFileName);
@@ -96,7 +97,7 @@ static void translate(const std::string& virFileName,
 		}
 		else
 		{
-			ptxModuleName = translatePTX(ptxFileName);
+			ptxModuleName = translatePTX(ptxFileName, workerThreads);
 		}
 	}
 	catch(const std::exception& e)
@@ -158,6 +159,7 @@ int main(int argc, char** argv)
 	std::string ptxFileName;
 	std::string virFileName;
 	bool writeBinary;
+	unsigned int workerThreads;
 
 	parser.description("This program compiles a PTX file into a VIR binary.");
 
@@ -167,9 +169,13 @@ int main(int argc, char** argv)
 	parser.parse("-b", "--use-binary-format", writeBinary,
 		false, "Output a VIR binary "
 		"bytecode file rather than an assembly file.");
+	parser.parse("-j", "--worker-threads", workerThreads, 1,
+		"The number of threads used to translate kernels "
+		"(0 = one per hardware thread).");
 	parser.parse();
 	
-	vanaheimr::translate(virFileName, ptxFileName, writeBinary);
+	vanaheimr::translate(virFileName, ptxFileName, writeBinary,
+		workerThreads);
 
 	return 0;
 }
@@ -0,0 +1,388 @@
+/*! \file   vir-benchmark.cpp
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\date   Saturday August 29, 2026
+	\brief  The source file for the vir-benchmark tool.
+
+	Runs passes and analyses over a corpus of modules with warmup and
+	repeated iterations, and reports min/median/mean/stddev wall clock
+	times as JSON.  Built by the 'scons benchmarks' target.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/PassManager.h>
+#include <vanaheimr/transforms/interface/PassFactory.h>
+
+#include <vanaheimr/analysis/interface/AnalysisFactory.h>
+
+#include <vanaheimr/parser/interface/LLVMParser.h>
+
+#include <vanaheimr/asm/interface/BinaryReader.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+
+// Hydrazine Includes
+#include <hydrazine/interface/ArgumentParser.h>
+#include <hydrazine/interface/string.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace vanaheimr
+{
+
+/*! \brief The timing samples for one pass or analysis on one input */
+class BenchmarkResult
+{
+public:
+	std::string         inputFileName;
+	std::string         kind;
+	std::string         name;
+	std::vector<double> seconds;
+};
+
+typedef std::vector<BenchmarkResult> BenchmarkResultVector;
+
+static double now()
+{
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ir::Module* loadBinaryModule(const std::string& inputFileName)
+{
+	try
+	{
+		as::BinaryReader reader;
+
+		return reader.read(inputFileName);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "VIR Benchmark Failed: binary reading failed.\n";
+		std::cerr << "  Message: " << e.what() << "\n";
+	}
+
+	return nullptr;
+}
+
+static ir::Module* loadAssemblyModule(const std::string& inputFileName)
+{
+	try
+	{
+		parser::LLVMParser parser(compiler::Compiler::getSingleton());
+
+		parser.parse(inputFileName);
+
+		return &*compiler::Compiler::getSingleton()->getModule(inputFileName);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "VIR Benchmark Failed: llvm parsing failed.\n";
+		std::cerr << "  Message: " << e.what() << "\n";
+	}
+
+	return nullptr;
+}
+
+static std::string getExt(const std::string& path)
+{
+	auto segments = hydrazine::split(path, ".");
+
+	if(!segments.empty()) return segments.back();
+
+	return "";
+}
+
+static ir::Module* loadModule(const std::string& inputFileName)
+{
+	if(getExt(inputFileName) == "llvm")
+	{
+		return loadAssemblyModule(inputFileName);
+	}
+
+	return loadBinaryModule(inputFileName);
+}
+
+/*! \brief Time one pass over a module, on a fresh deep copy per run so
+	that every iteration transforms the same input */
+static bool benchmarkPass(BenchmarkResult& result, ir::Module* module,
+	const std::string& passName, unsigned int warmup, unsigned int iterations)
+{
+	for(unsigned int i = 0; i < warmup + iterations; ++i)
+	{
+		ir::Module copy(*module);
+
+		auto pass = transforms::PassFactory::createPass(passName);
+
+		if(pass == nullptr)
+		{
+			std::cerr << "VIR Benchmark: skipped unknown pass '"
+				<< passName << "'\n";
+
+			return false;
+		}
+
+		transforms::PassManager manager(&copy);
+
+		manager.addPass(pass);
+
+		double start = now();
+
+		manager.runOnModule();
+
+		double end = now();
+
+		if(i >= warmup) result.seconds.push_back(end - start);
+	}
+
+	return true;
+}
+
+/*! \brief Time one analysis, plus its transitive dependencies, over
+	every function in a module.  Analyses do not mutate the module, so
+	every iteration sees the same input without a copy */
+static bool benchmarkAnalysis(BenchmarkResult& result, ir::Module* module,
+	const std::string& analysisName, unsigned int warmup,
+	unsigned int iterations)
+{
+	typedef analysis::AnalysisFactory AnalysisFactory;
+
+	for(unsigned int i = 0; i < warmup + iterations; ++i)
+	{
+		AnalysisFactory::FunctionAnalysisMap analyses;
+
+		double start = now();
+
+		AnalysisFactory::createAnalysesForModule(*module,
+			{analysisName}, analyses, 1);
+
+		double end = now();
+
+		// the caller owns the results, deletion is not timed
+		for(auto& function : analyses)
+		{
+			for(auto& analysis : function.second)
+			{
+				delete analysis.second;
+			}
+		}
+
+		if(i >= warmup) result.seconds.push_back(end - start);
+	}
+
+	return true;
+}
+
+static double minimum(std::vector<double> samples)
+{
+	return *std::min_element(samples.begin(), samples.end());
+}
+
+static double median(std::vector<double> samples)
+{
+	std::sort(samples.begin(), samples.end());
+
+	size_t middle = samples.size() / 2;
+
+	if(samples.size() % 2 == 1) return samples[middle];
+
+	return (samples[middle - 1] + samples[middle]) / 2.0;
+}
+
+static double mean(const std::vector<double>& samples)
+{
+	double sum = 0.0;
+
+	for(auto sample : samples) sum += sample;
+
+	return sum / samples.size();
+}
+
+static double stddev(const std::vector<double>& samples)
+{
+	double average = mean(samples);
+
+	double sum = 0.0;
+
+	for(auto sample : samples)
+	{
+		sum += (sample - average) * (sample - average);
+	}
+
+	return std::sqrt(sum / samples.size());
+}
+
+static void writeResults(std::ostream& stream,
+	const BenchmarkResultVector& results,
+	unsigned int warmup, unsigned int iterations)
+{
+	stream << "[";
+
+	bool first = true;
+
+	for(auto& result : results)
+	{
+		if(!first) stream << ",";
+
+		first = false;
+
+		stream << "\n\t{"
+			<<   "\"input\": \""      << result.inputFileName << "\""
+			<< ", \"kind\": \""       << result.kind          << "\""
+			<< ", \"name\": \""       << result.name          << "\""
+			<< ", \"warmup\": "       << warmup
+			<< ", \"iterations\": "   << iterations
+			<< ", \"min\": "          << minimum(result.seconds)
+			<< ", \"median\": "       << median(result.seconds)
+			<< ", \"mean\": "         << mean(result.seconds)
+			<< ", \"stddev\": "       << stddev(result.seconds)
+			<< "}";
+	}
+
+	stream << "\n]\n";
+}
+
+static void benchmark(const std::string& inputFileNames,
+	const std::string& passNames, const std::string& analysisNames,
+	unsigned int warmup, unsigned int iterations,
+	const std::string& outputFileName)
+{
+	auto inputs   = hydrazine::split(inputFileNames, ",");
+	auto passes   = hydrazine::split(passNames,      ",");
+	auto analyses = hydrazine::split(analysisNames,  ",");
+
+	if(inputs.empty())
+	{
+		throw std::runtime_error("No input modules specified.");
+	}
+
+	BenchmarkResultVector results;
+
+	for(auto& input : inputs)
+	{
+		ir::Module* module = loadModule(input);
+
+		if(module == nullptr) continue;
+
+		for(auto& passName : passes)
+		{
+			BenchmarkResult result;
+
+			result.inputFileName = input;
+			result.kind          = "pass";
+			result.name          = passName;
+
+			try
+			{
+				if(benchmarkPass(result, module, passName,
+					warmup, iterations))
+				{
+					results.push_back(result);
+				}
+			}
+			catch(const std::exception& e)
+			{
+				std::cerr << "VIR Benchmark: pass '" << passName
+					<< "' failed on '" << input << "'.\n";
+				std::cerr << "  Message: " << e.what() << "\n";
+			}
+		}
+
+		for(auto& analysisName : analyses)
+		{
+			BenchmarkResult result;
+
+			result.inputFileName = input;
+			result.kind          = "analysis";
+			result.name          = analysisName;
+
+			try
+			{
+				if(benchmarkAnalysis(result, module, analysisName,
+					warmup, iterations))
+				{
+					results.push_back(result);
+				}
+			}
+			catch(const std::exception& e)
+			{
+				std::cerr << "VIR Benchmark: analysis '" << analysisName
+					<< "' failed on '" << input << "'.\n";
+				std::cerr << "  Message: " << e.what() << "\n";
+			}
+		}
+	}
+
+	if(outputFileName.empty())
+	{
+		writeResults(std::cout, results, warmup, iterations);
+
+		return;
+	}
+
+	std::ofstream outputFile(outputFileName.c_str());
+
+	if(!outputFile.is_open())
+	{
+		throw std::runtime_error("Could not open output file '"
+			+ outputFileName + "' for writing.");
+	}
+
+	writeResults(outputFile, results, warmup, iterations);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	hydrazine::ArgumentParser parser(argc, argv);
+
+	std::string inputFileNames;
+	std::string outputFileName;
+	std::string passNames;
+	std::string analysisNames;
+
+	unsigned int warmup     = 0;
+	unsigned int iterations = 0;
+
+	parser.description("This program times passes and analyses over a "
+		"corpus of VIR binaries and reports the results as JSON.");
+
+	parser.parse("-i", "--input", inputFileNames,
+		"", "Comma separated list of VIR binary (or .llvm) corpus files.");
+	parser.parse("-o", "--output", outputFileName,
+		"", "The JSON report file path (defaults to stdout).");
+	parser.parse("", "--passes", passNames,
+		"SimplifyControlFlowPass,ConvertToSSAPass,DeadCodeEliminationPass",
+		"Comma separated list of passes to time.");
+	parser.parse("", "--analyses", analysisNames,
+		"ControlFlowGraph,DominatorAnalysis,DataflowAnalysis,LoopAnalysis",
+		"Comma separated list of analyses to time.");
+	parser.parse("-w", "--warmup", warmup, 1,
+		"Untimed runs before measurement starts.");
+	parser.parse("-n", "--iterations", iterations, 10,
+		"Timed runs per pass or analysis.");
+	parser.parse();
+
+	try
+	{
+		vanaheimr::benchmark(inputFileNames, passNames, analysisNames,
+			warmup, iterations, outputFileName);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "VIR Benchmark Failed: " << e.what() << "\n";
+
+		return 1;
+	}
+
+	return 0;
+}
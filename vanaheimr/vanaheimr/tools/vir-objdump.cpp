@@ -13,32 +13,32 @@
 #include <hydrazine/interface/ArgumentParser.h>
 
 // Standard Library Includes
-#include <fstream>
+#include <iostream>
+#include <vector>
 
 namespace vanaheimr
 {
 
-static void dump(const std::string& name)
-{	
-	std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary;
-	
-	std::ifstream virFile(name.c_str(), mode);
-	
-	if(!virFile.is_open())
-	{
-		std::cerr << "ObjDump Failed: could not open VIR file '"
-			<< name << "' for reading.\n"; 
-		return;
-	}
-	
+static void dump(const std::string& name, const std::string& symbolName)
+{
 	ir::Module* module = 0;
 
 	try
 	{
 		as::BinaryReader reader;
 
-		module = reader.read(virFile, name);
-	
+		// map the file, the binary sections are used in place
+		if(symbolName.empty())
+		{
+			module = reader.read(name);
+		}
+		else
+		{
+			// resolve the symbol through the hash index and decode only
+			// the pages its instructions live on
+			module = reader.readFunction(name, symbolName);
+		}
+
 		module->writeAssembly(std::cout);
 	}
 	catch(const std::exception& e)
@@ -58,14 +58,25 @@ int main(int argc, char** argv)
 	hydrazine::ArgumentParser parser(argc, argv);
 
 	std::string virFileName;
+	std::string symbolName;
 
 	parser.description("This program prints out an assembly "
 		"representation of a VIR binary.");
 
 	parser.parse("-i", "--input",  virFileName, "", "The input VIR file path.");
+	parser.parse("-s", "--symbol", symbolName,  "",
+		"Only disassemble the named function.");
 	parser.parse();
-	
-	vanaheimr::dump(virFileName);
+
+	// batch the output into a large buffer rather than inserting into an
+	// unbuffered stream an operand at a time
+	std::ios_base::sync_with_stdio(false);
+
+	std::vector<char> outputBuffer(1 << 20);
+
+	std::cout.rdbuf()->pubsetbuf(outputBuffer.data(), outputBuffer.size());
+
+	vanaheimr::dump(virFileName, symbolName);
 
 	return 0;
 }
@@ -7,10 +7,21 @@
 // Vanaheimr Includes
 #include <vanaheimr/transforms/interface/PassManager.h>
 #include <vanaheimr/transforms/interface/PassFactory.h>
+#include <vanaheimr/transforms/interface/StaticPipeline.h>
+
+#include <vanaheimr/transforms/interface/SimplifyControlFlowPass.h>
+#include <vanaheimr/transforms/interface/ConvertToSSAPass.h>
+#include <vanaheimr/transforms/interface/ConvertFromSSAPass.h>
+#include <vanaheimr/transforms/interface/ConstantPropagationPass.h>
+#include <vanaheimr/transforms/interface/GlobalValueNumberingPass.h>
+#include <vanaheimr/transforms/interface/PartialRedundancyEliminationPass.h>
+#include <vanaheimr/transforms/interface/DeadCodeEliminationPass.h>
+#include <vanaheimr/transforms/interface/GlobalDeadCodeEliminationPass.h>
 
 #include <vanaheimr/parser/interface/LLVMParser.h>
 
 #include <vanaheimr/asm/interface/BinaryReader.h>
+#include <vanaheimr/asm/interface/BinaryWriter.h>
 
 #include <vanaheimr/compiler/interface/Compiler.h>
 
@@ -21,17 +32,36 @@
 
 // Standard Library Includes
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 namespace vanaheimr
 {
 
-static void optimizeModule(ir::Module* module, const std::string& optimizations)
+// The fixed -O pipelines, assembled and order-checked at compile time
+typedef transforms::StaticPipeline<
+	transforms::GlobalDeadCodeEliminationPass,
+	transforms::SimplifyControlFlowPass,
+	transforms::DeadCodeEliminationPass> O1Pipeline;
+
+typedef transforms::StaticPipeline<
+	transforms::GlobalDeadCodeEliminationPass,
+	transforms::SimplifyControlFlowPass,
+	transforms::ConvertToSSAPass,
+	transforms::ConstantPropagationPass,
+	transforms::GlobalValueNumberingPass,
+	transforms::PartialRedundancyEliminationPass,
+	transforms::DeadCodeEliminationPass,
+	transforms::ConvertFromSSAPass> O2Pipeline;
+
+static void setupPassManager(transforms::PassManager& manager,
+	const std::string& optimizations, unsigned int optimizationLevel)
 {
 	auto optimizationList = hydrazine::split(optimizations, ",");
-	
-	transforms::PassManager manager(module);
-	
+
 	for(auto optimization : optimizationList)
 	{
 		auto pass = transforms::PassFactory::createPass(optimization);
@@ -44,27 +74,55 @@ static void optimizeModule(ir::Module* module, const std::string& optimizations)
 
 		manager.addPass(pass);
 	}
-	
-	manager.runOnModule();
+
+	if(optimizationList.empty())
+	{
+		if(optimizationLevel == 1)
+		{
+			O1Pipeline::addTo(manager);
+		}
+		else if(optimizationLevel >= 2)
+		{
+			O2Pipeline::addTo(manager);
+		}
+	}
 }
 
-static ir::Module* loadBinaryModule(const std::string& inputFileName)
+static void optimizeModule(ir::Module* module, const std::string& optimizations,
+	unsigned int optimizationLevel, const std::string& statisticsFileName)
 {
-	std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary;
-	
-	std::ifstream virFile(inputFileName.c_str(), mode);
-	
-	if(!virFile.is_open())
+	transforms::PassManager manager(module);
+
+	setupPassManager(manager, optimizations, optimizationLevel);
+
+	manager.setInstrumentationEnabled(!statisticsFileName.empty());
+
+	manager.runOnModule();
+
+	if(!statisticsFileName.empty())
 	{
-		std::cerr << "VIR Optimizer Failed: could not open VIR bytecode file '"
-			<< inputFileName << "' for reading.\n"; 
+		std::ofstream statisticsFile(statisticsFileName.c_str());
+
+		if(!statisticsFile.is_open())
+		{
+			std::cerr << "VIR Optimizer: could not open statistics file '"
+				<< statisticsFileName << "' for writing.\n";
+
+			return;
+		}
+
+		manager.writeStatistics(statisticsFile);
 	}
-	
+}
+
+static ir::Module* loadBinaryModule(const std::string& inputFileName)
+{
 	try
 	{
 		as::BinaryReader reader;
 
-		return reader.read(virFile, inputFileName);
+		// map the file, the binary sections are used in place
+		return reader.read(inputFileName);
 	}
 	catch(const std::exception& e)
 	{
@@ -119,29 +177,109 @@ static ir::Module* loadModule(const std::string& inputFileName)
 
 }
 
+static void optimizeStreaming(const std::string& inputFileName,
+	const std::string& outputFileName,
+	const std::string& optimizations,
+	unsigned int optimizationLevel)
+{
+	ir::Module* module = loadModule(inputFileName);
+
+	if(module == nullptr) return;
+
+	std::ios_base::openmode oMode = std::ios_base::out | std::ios_base::binary;
+
+	std::ofstream outputVirFile(outputFileName.c_str(), oMode);
+
+	if(!outputVirFile.is_open())
+	{
+		std::cerr << "VIR Optimizer Failed: could not open VIR file '"
+			<< outputFileName << "' for writing.\n";
+
+		return;
+	}
+
+	try
+	{
+		transforms::PassManager manager(module);
+
+		setupPassManager(manager, optimizations, optimizationLevel);
+
+		as::BinaryWriter writer;
+
+		writer.beginStreaming(*module);
+
+		// optimize and encode one function at a time, each body is
+		// dropped as soon as its encoded bytes are final, so only the
+		// function in flight is resident
+		for(auto function = module->begin();
+			function != module->end(); ++function)
+		{
+			manager.runOnFunction(*function);
+
+			writer.streamFunction(*function);
+		}
+
+		writer.endStreaming(outputVirFile);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "VIR Optimizer Failed: streaming compile failed.\n";
+		std::cerr << "  Message: " << e.what() << "\n";
+	}
+}
+
 static void optimize(const std::string& inputFileName,
 	const std::string& outputFileName,
-	const std::string& optimizations)
-{	
-	
+	const std::string& optimizations,
+	unsigned int optimizationLevel,
+	const std::string& statisticsFileName,
+	bool incremental)
+{
+
 	ir::Module* module = loadModule(inputFileName);
 
 	if(module == nullptr) return;
-	
+
 	try
 	{
-		optimizeModule(module, optimizations);
+		optimizeModule(module, optimizations, optimizationLevel,
+			statisticsFileName);
 	}
 	catch(const std::exception& e)
 	{
-		std::cerr << "VIR Optimizer Failed: optimization failed.\n"; 
-		std::cerr << "  Message: " << e.what() << "\n"; 
+		std::cerr << "VIR Optimizer Failed: optimization failed.\n";
+		std::cerr << "  Message: " << e.what() << "\n";
 
 		return;
 	}
-	
-	std::ios_base::openmode oMode = std::ios_base::out | std::ios_base::binary;	
-	
+
+	if(incremental)
+	{
+		std::ios_base::openmode pMode = std::ios_base::in |
+			std::ios_base::out | std::ios_base::binary;
+
+		std::fstream outputVirFile(outputFileName.c_str(), pMode);
+
+		// patch the existing binary, fall through to a full write when
+		// there is nothing to patch yet
+		if(outputVirFile.is_open())
+		{
+			try
+			{
+				module->patchBinary(outputVirFile);
+			}
+			catch(const std::exception& e)
+			{
+				std::cerr << "ObjDump Failed: binary patching failed.\n";
+				std::cerr << "  Message: " << e.what() << "\n";
+			}
+
+			return;
+		}
+	}
+
+	std::ios_base::openmode oMode = std::ios_base::out | std::ios_base::binary;
+
 	std::ofstream outputVirFile(outputFileName.c_str(), oMode);
 	
 	if(!outputVirFile.is_open())
@@ -165,6 +303,116 @@ static void optimize(const std::string& inputFileName,
 	
 }
 
+/*! rief One entry in a batch manifest */
+class BatchJob
+{
+public:
+	std::string inputFileName;
+	std::string outputFileName;
+};
+
+typedef std::vector<BatchJob> BatchJobVector;
+
+/*! rief Parse a manifest with one job per line:
+
+	<input> [<output>]
+
+	The output defaults to the input (optimize in place), blank lines and
+	lines starting with '#' are skipped */
+static BatchJobVector readManifest(const std::string& manifestFileName)
+{
+	std::ifstream manifest(manifestFileName.c_str());
+
+	if(!manifest.is_open())
+	{
+		throw std::runtime_error("Could not open batch manifest file '"
+			+ manifestFileName + "' for reading.");
+	}
+
+	BatchJobVector jobs;
+
+	std::string line;
+
+	while(std::getline(manifest, line))
+	{
+		std::stringstream stream(line);
+
+		BatchJob job;
+
+		stream >> job.inputFileName;
+
+		if(job.inputFileName.empty())        continue;
+		if(job.inputFileName.front() == '#') continue;
+
+		stream >> job.outputFileName;
+
+		if(job.outputFileName.empty()) job.outputFileName = job.inputFileName;
+
+		jobs.push_back(job);
+	}
+
+	return jobs;
+}
+
+static void optimizeBatch(const std::string& manifestFileName,
+	const std::string& optimizations,
+	unsigned int optimizationLevel,
+	const std::string& statisticsFileName,
+	bool incremental,
+	unsigned int workerCount)
+{
+	auto jobs = readManifest(manifestFileName);
+
+	if(workerCount == 0) workerCount = std::thread::hardware_concurrency();
+	if(workerCount > jobs.size()) workerCount = jobs.size();
+	if(workerCount == 0) return;
+
+	// Modules are independent, one PassManager each.  The compiler's
+	// type, string, and module tables are internally locked, so workers
+	// only share the process and the warm machine model
+	std::atomic<size_t> nextJob(0);
+
+	auto worker = [&]()
+	{
+		while(true)
+		{
+			size_t index = nextJob++;
+
+			if(index >= jobs.size()) break;
+
+			std::string jobStatisticsFileName;
+
+			if(!statisticsFileName.empty())
+			{
+				// one statistics file per module, suffixed by job index
+				std::stringstream name;
+
+				name << statisticsFileName << "." << index;
+
+				jobStatisticsFileName = name.str();
+			}
+
+			optimize(jobs[index].inputFileName, jobs[index].outputFileName,
+				optimizations, optimizationLevel, jobStatisticsFileName,
+				incremental);
+		}
+	};
+
+	std::vector<std::thread> threads;
+
+	threads.reserve(workerCount);
+
+	for(unsigned int i = 0; i < workerCount; ++i)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	for(auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
 }
 
 int main(int argc, char** argv)
@@ -174,8 +422,15 @@ int main(int argc, char** argv)
 	std::string virFileName;
 	std::string outputFileName;
 	std::string optimizations;
+	std::string statisticsFileName;
+	std::string manifestFileName;
+
+	unsigned int optimizationLevel = 0;
+	unsigned int workerThreads     = 0;
 
-	bool verbose = false;
+	bool verbose     = false;
+	bool incremental = false;
+	bool streaming   = false;
 
 	parser.description("This program reads in a VIR binary, optimizes it, "
 		"and writes it out again a new binary.");
@@ -188,6 +443,26 @@ int main(int argc, char** argv)
 		"Print out log messages during execution");
 	parser.parse("", "--optimizations",  optimizations,
 		"", "Comma separated list of optimizations (ConvertToSSA).");
+	parser.parse("-O", "--optimization-level", optimizationLevel, 0,
+		"The fixed optimization pipeline to run (1 or 2) when no "
+		"explicit optimization list is given.");
+	parser.parse("", "--instrument", statisticsFileName,
+		"", "Write per-pass timing and memory statistics "
+			"to this file as JSON.");
+	parser.parse("", "--incremental", incremental, false,
+		"Patch the output file in place when it already exists, only "
+		"pages whose bytes changed are rewritten.");
+	parser.parse("", "--streaming", streaming, false,
+		"Optimize and write one function at a time, holding only the "
+		"function in flight in memory.  Caps peak memory near the "
+		"largest single function.");
+	parser.parse("", "--batch", manifestFileName,
+		"", "Optimize every binary listed in this manifest file "
+		"(one '<input> [<output>]' pair per line) over a shared "
+		"thread pool instead of a single input.");
+	parser.parse("-j", "--worker-threads", workerThreads, 0,
+		"The number of threads used in batch mode "
+		"(0 = one per hardware thread).");
 	parser.parse();
 
 	if(verbose)
@@ -195,7 +470,32 @@ int main(int argc, char** argv)
 		hydrazine::enableAllLogs();
 	}
 	
-	vanaheimr::optimize(virFileName, outputFileName, optimizations);
+	if(!manifestFileName.empty())
+	{
+		try
+		{
+			vanaheimr::optimizeBatch(manifestFileName, optimizations,
+				optimizationLevel, statisticsFileName, incremental,
+				workerThreads);
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "VIR Optimizer Failed: " << e.what() << "\n";
+		}
+
+		return 0;
+	}
+
+	if(streaming)
+	{
+		vanaheimr::optimizeStreaming(virFileName, outputFileName,
+			optimizations, optimizationLevel);
+
+		return 0;
+	}
+
+	vanaheimr::optimize(virFileName, outputFileName, optimizations,
+		optimizationLevel, statisticsFileName, incremental);
 
 	return 0;
 }
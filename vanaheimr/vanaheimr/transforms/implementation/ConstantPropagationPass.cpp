@@ -0,0 +1,774 @@
+/*! \file   ConstantPropagationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ConstantPropagationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/ConstantPropagationPass.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::ControlFlowGraph ControlFlowGraph;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::Operand          Operand;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::ImmediateOperand ImmediateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+
+/*! \brief One lattice cell: unknown, a known constant, or overdefined */
+class Cell
+{
+public:
+	enum State
+	{
+		Top,
+		ConstantValue,
+		Bottom
+	};
+
+public:
+	Cell() : state(Top), value(0) {}
+
+public:
+	State    state;
+	uint64_t value;
+};
+
+class SCCPEngine
+{
+public:
+	typedef std::vector<Cell>             CellVector;
+	typedef std::vector<bool>             BoolVector;
+	typedef std::vector<BasicBlock*>      BasicBlockVector;
+	typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+	typedef std::unordered_set<uint64_t>  EdgeSet;
+
+public:
+	ir::Function*     function;
+	ControlFlowGraph* cfg;
+
+	CellVector       values;          // indexed by register id
+	BoolVector       blockExecutable; // indexed by block id
+	BasicBlockVector nextBlock;       // fallthrough, indexed by block id
+	EdgeSet          executableEdges;
+
+	BasicBlockVector      blockWorklist;
+	VirtualRegisterVector ssaWorklist;
+};
+
+static uint64_t edgeKey(const BasicBlock* from, const BasicBlock* to)
+{
+	return ((uint64_t)from->id() << 32) | to->id();
+}
+
+static void visitInstruction(SCCPEngine& engine, Instruction* instruction);
+
+static void markEdgeExecutable(SCCPEngine& engine,
+	BasicBlock* from, BasicBlock* to)
+{
+	if(!engine.executableEdges.insert(edgeKey(from, to)).second) return;
+
+	report("  edge '" << from->name() << "' -> '"
+		<< to->name() << "' is executable");
+
+	if(!engine.blockExecutable[to->id()])
+	{
+		engine.blockExecutable[to->id()] = true;
+		engine.blockWorklist.push_back(to);
+
+		return;
+	}
+
+	// already-visited phis merge over executable edges only
+	for(auto instruction : *to)
+	{
+		if(!instruction->isPhi()) break;
+
+		visitInstruction(engine, instruction);
+	}
+}
+
+/*! \brief Lower a register's cell, queueing its uses when it changes */
+static void updateCell(SCCPEngine& engine, VirtualRegister* virtualRegister,
+	const Cell& cell)
+{
+	auto& existing = engine.values[virtualRegister->id];
+
+	Cell merged = existing;
+
+	if(cell.state == Cell::Bottom)
+	{
+		merged.state = Cell::Bottom;
+	}
+	else if(cell.state == Cell::ConstantValue)
+	{
+		if(existing.state == Cell::Top)
+		{
+			merged = cell;
+		}
+		else if(existing.state == Cell::ConstantValue &&
+			existing.value != cell.value)
+		{
+			merged.state = Cell::Bottom;
+		}
+	}
+
+	if(merged.state == existing.state && merged.value == existing.value)
+	{
+		return;
+	}
+
+	existing = merged;
+
+	engine.ssaWorklist.push_back(virtualRegister);
+}
+
+static Cell operandCell(SCCPEngine& engine, const Operand* operand)
+{
+	Cell cell;
+
+	if(operand->isImmediate())
+	{
+		cell.state = Cell::ConstantValue;
+		cell.value = static_cast<const ImmediateOperand*>(operand)->uint;
+
+		return cell;
+	}
+
+	if(operand->isRegister() && operand->mode() == Operand::Register)
+	{
+		auto virtualRegister = static_cast<const RegisterOperand*>(
+			operand)->virtualRegister;
+
+		if(virtualRegister != nullptr)
+		{
+			return engine.values[virtualRegister->id];
+		}
+	}
+
+	cell.state = Cell::Bottom;
+
+	return cell;
+}
+
+/*! \brief The guard cell: true/false when decided, Bottom when unknown */
+static Cell guardCell(SCCPEngine& engine, const Instruction* instruction)
+{
+	Cell cell;
+
+	auto guard = instruction->guard();
+
+	if(guard == nullptr || guard->modifier == PredicateOperand::PredicateTrue)
+	{
+		cell.state = Cell::ConstantValue;
+		cell.value = 1;
+
+		return cell;
+	}
+
+	if(guard->modifier == PredicateOperand::PredicateFalse)
+	{
+		cell.state = Cell::ConstantValue;
+		cell.value = 0;
+
+		return cell;
+	}
+
+	if(guard->virtualRegister == nullptr)
+	{
+		cell.state = Cell::Bottom;
+
+		return cell;
+	}
+
+	cell = engine.values[guard->virtualRegister->id];
+
+	if(cell.state == Cell::ConstantValue &&
+		guard->modifier == PredicateOperand::InversePredicate)
+	{
+		cell.value = cell.value == 0 ? 1 : 0;
+	}
+
+	return cell;
+}
+
+static uint64_t maskToType(uint64_t value, const ir::Type* type)
+{
+	if(type == nullptr) return value;
+
+	size_t bytes = type->bytes();
+
+	if(bytes >= 8) return value;
+
+	return value & ((1ull << (bytes * 8)) - 1);
+}
+
+/*! \brief The width of the type in bits, 64 when unknown */
+static size_t typeBits(const ir::Type* type)
+{
+	if(type == nullptr) return 64;
+
+	size_t bytes = type->bytes();
+
+	if(bytes >= 8) return 64;
+
+	return bytes * 8;
+}
+
+/*! \brief Reinterpret a zero-masked cell as a signed value of the type.
+
+	Cells store sub-64-bit values zero-masked, so an i32 -1 is
+	0xFFFFFFFF and a plain cast to int64_t would read it as positive */
+static int64_t signExtend(uint64_t value, const ir::Type* type)
+{
+	size_t bits = typeBits(type);
+
+	if(bits >= 64) return (int64_t)value;
+
+	uint64_t sign = (uint64_t)1 << (bits - 1);
+
+	return (int64_t)((value ^ sign) - sign);
+}
+
+static Cell evaluateComparison(const ir::ComparisonInstruction* comparison,
+	uint64_t a, uint64_t b, const ir::Type* type)
+{
+	typedef ir::ComparisonInstruction Cmp;
+
+	Cell cell;
+
+	cell.state = Cell::ConstantValue;
+
+	int64_t sa = signExtend(a, type);
+	int64_t sb = signExtend(b, type);
+
+	switch(comparison->comparison)
+	{
+	case Cmp::OrderedEqual:            cell.value = a == b;   break;
+	case Cmp::OrderedNotEqual:         cell.value = a != b;   break;
+	case Cmp::OrderedLessThan:         cell.value = sa <  sb; break;
+	case Cmp::OrderedLessOrEqual:      cell.value = sa <= sb; break;
+	case Cmp::OrderedGreaterThan:      cell.value = sa >  sb; break;
+	case Cmp::OrderedGreaterOrEqual:   cell.value = sa >= sb; break;
+	case Cmp::UnorderedEqual:          cell.value = a == b;   break;
+	case Cmp::UnorderedNotEqual:       cell.value = a != b;   break;
+	case Cmp::UnorderedLessThan:       cell.value = a <  b;   break;
+	case Cmp::UnorderedLessOrEqual:    cell.value = a <= b;   break;
+	case Cmp::UnorderedGreaterThan:    cell.value = a >  b;   break;
+	case Cmp::UnorderedGreaterOrEqual: cell.value = a >= b;   break;
+	default: cell.state = Cell::Bottom; break;
+	}
+
+	return cell;
+}
+
+/*! \brief Fold one instruction given constant operand values */
+static Cell evaluate(const Instruction* instruction, uint64_t a, uint64_t b)
+{
+	Cell cell;
+
+	cell.state = Cell::ConstantValue;
+
+	// the operand type, signed folds and shifts need its width back
+	const ir::Type* type = instruction->reads.size() > 1 ?
+		instruction->reads[1]->type() : nullptr;
+
+	uint64_t shift = b & (typeBits(type) - 1);
+
+	switch(instruction->opcode)
+	{
+	case Instruction::Add:     cell.value = a + b;            break;
+	case Instruction::Sub:     cell.value = a - b;            break;
+	case Instruction::Mul:     cell.value = a * b;            break;
+	case Instruction::And:     cell.value = a & b;            break;
+	case Instruction::Or:      cell.value = a | b;            break;
+	case Instruction::Xor:     cell.value = a ^ b;            break;
+	case Instruction::Shl:     cell.value = a << shift;       break;
+	case Instruction::Lshr:    cell.value = a >> shift;       break;
+	case Instruction::Ashr:
+		cell.value = (uint64_t)(signExtend(a, type) >> shift);
+	break;
+	case Instruction::Bitcast: cell.value = a;                break;
+	case Instruction::Udiv:
+	{
+		if(b == 0) { cell.state = Cell::Bottom; break; }
+
+		cell.value = a / b;
+	}
+	break;
+	case Instruction::Urem:
+	{
+		if(b == 0) { cell.state = Cell::Bottom; break; }
+
+		cell.value = a % b;
+	}
+	break;
+	case Instruction::Sdiv:
+	{
+		if(b == 0) { cell.state = Cell::Bottom; break; }
+
+		cell.value = (uint64_t)(signExtend(a, type) / signExtend(b, type));
+	}
+	break;
+	case Instruction::Srem:
+	{
+		if(b == 0) { cell.state = Cell::Bottom; break; }
+
+		cell.value = (uint64_t)(signExtend(a, type) % signExtend(b, type));
+	}
+	break;
+	case Instruction::Setp:
+	{
+		cell = evaluateComparison(
+			static_cast<const ir::ComparisonInstruction*>(instruction),
+			a, b, type);
+	}
+	break;
+	default: cell.state = Cell::Bottom; break;
+	}
+
+	if(cell.state == Cell::ConstantValue && !instruction->writes.empty())
+	{
+		cell.value = maskToType(cell.value, instruction->writes[0]->type());
+	}
+
+	return cell;
+}
+
+static void visitBranch(SCCPEngine& engine, Instruction* instruction)
+{
+	auto branch = static_cast<ir::Bra*>(instruction);
+	auto block  = instruction->block;
+
+	auto target      = branch->targetBasicBlock();
+	auto fallthrough = engine.nextBlock[block->id()];
+
+	if(branch->isUnconditional())
+	{
+		if(target != nullptr) markEdgeExecutable(engine, block, target);
+
+		return;
+	}
+
+	auto guard = guardCell(engine, instruction);
+
+	// an undecided condition keeps both edges dormant, optimistically
+	if(guard.state == Cell::Top) return;
+
+	if(guard.state == Cell::Bottom)
+	{
+		if(target != nullptr)
+		{
+			markEdgeExecutable(engine, block, target);
+		}
+
+		if(fallthrough != nullptr)
+		{
+			markEdgeExecutable(engine, block, fallthrough);
+		}
+
+		return;
+	}
+
+	auto taken = guard.value != 0 ? target : fallthrough;
+
+	if(taken != nullptr) markEdgeExecutable(engine, block, taken);
+}
+
+static void visitPhi(SCCPEngine& engine, ir::Phi* phi)
+{
+	if(phi->d() == nullptr || phi->d()->virtualRegister == nullptr) return;
+
+	auto sources      = phi->sources();
+	auto predecessors = phi->blocks();
+
+	Cell merged;
+
+	for(unsigned int source = 0; source != sources.size(); ++source)
+	{
+		if(source >= predecessors.size()) break;
+
+		// only executable incoming edges contribute
+		if(engine.executableEdges.count(edgeKey(
+			predecessors[source], phi->block)) == 0)
+		{
+			continue;
+		}
+
+		auto cell = operandCell(engine, sources[source]);
+
+		if(cell.state == Cell::Bottom)
+		{
+			merged.state = Cell::Bottom;
+			break;
+		}
+
+		if(cell.state == Cell::Top) continue;
+
+		if(merged.state == Cell::Top)
+		{
+			merged = cell;
+		}
+		else if(merged.value != cell.value)
+		{
+			merged.state = Cell::Bottom;
+			break;
+		}
+	}
+
+	updateCell(engine, phi->d()->virtualRegister, merged);
+}
+
+static void visitInstruction(SCCPEngine& engine, Instruction* instruction)
+{
+	if(instruction->isPhi())
+	{
+		visitPhi(engine, static_cast<ir::Phi*>(instruction));
+
+		return;
+	}
+
+	if(instruction->isBranch() && !instruction->isCall() &&
+		!instruction->isMachineInstruction())
+	{
+		visitBranch(engine, instruction);
+
+		return;
+	}
+
+	if(instruction->writes.size() != 1)      return;
+	if(!instruction->writes[0]->isRegister()) return;
+
+	auto defined = static_cast<RegisterOperand*>(
+		instruction->writes[0])->virtualRegister;
+
+	if(defined == nullptr) return;
+
+	auto guard = guardCell(engine, instruction);
+
+	// the write never happens
+	if(guard.state == Cell::ConstantValue && guard.value == 0) return;
+
+	Cell result;
+
+	result.state = Cell::Bottom;
+
+	bool foldable = guard.state == Cell::ConstantValue &&
+		instruction->accessesMemory() == false &&
+		!instruction->isCall() && !instruction->isIntrinsic();
+
+	if(foldable)
+	{
+		// gather up to two value operands past the guard
+		uint64_t operands[2] = {0, 0};
+		unsigned int count   = 0;
+
+		foldable = instruction->reads.size() <= 3;
+
+		for(unsigned int read = 1;
+			foldable && read < instruction->reads.size(); ++read)
+		{
+			auto cell = operandCell(engine, instruction->reads[read]);
+
+			if(cell.state == Cell::Top)
+			{
+				// optimistically wait for the operand to resolve
+				return;
+			}
+
+			if(cell.state == Cell::Bottom)
+			{
+				foldable = false;
+				break;
+			}
+
+			operands[count++] = cell.value;
+		}
+
+		if(foldable)
+		{
+			result = evaluate(instruction, operands[0], operands[1]);
+		}
+	}
+
+	updateCell(engine, defined, result);
+}
+
+static void visitBlock(SCCPEngine& engine, BasicBlock* block)
+{
+	report(" visiting block '" << block->name() << "'");
+
+	for(auto instruction : *block)
+	{
+		visitInstruction(engine, instruction);
+	}
+
+	// blocks without a decided branch fall through
+	auto terminator = block->terminator();
+
+	bool branches = terminator != nullptr && terminator->isBranch() &&
+		!terminator->isCall() && !terminator->isMachineInstruction();
+
+	if(!branches)
+	{
+		if(terminator != nullptr && terminator->isReturn())
+		{
+			markEdgeExecutable(engine, block,
+				&*engine.function->exit_block());
+		}
+		else if(engine.nextBlock[block->id()] != nullptr)
+		{
+			markEdgeExecutable(engine, block,
+				engine.nextBlock[block->id()]);
+		}
+	}
+	else if(!static_cast<ir::Bra*>(terminator)->isUnconditional())
+	{
+		// conditionals also fall through when not taken
+		auto guard = guardCell(engine, terminator);
+
+		if(guard.state == Cell::Bottom &&
+			engine.nextBlock[block->id()] != nullptr)
+		{
+			markEdgeExecutable(engine, block,
+				engine.nextBlock[block->id()]);
+		}
+	}
+}
+
+static void solve(SCCPEngine& engine)
+{
+	while(!engine.blockWorklist.empty() || !engine.ssaWorklist.empty())
+	{
+		while(!engine.blockWorklist.empty())
+		{
+			auto block = engine.blockWorklist.back();
+
+			engine.blockWorklist.pop_back();
+
+			visitBlock(engine, block);
+		}
+
+		while(!engine.ssaWorklist.empty())
+		{
+			auto virtualRegister = engine.ssaWorklist.back();
+
+			engine.ssaWorklist.pop_back();
+
+			// revisit only uses inside reachable blocks
+			for(auto use = virtualRegister->firstUse();
+				use != nullptr; use = use->nextUse())
+			{
+				auto instruction = use->instruction;
+
+				if(instruction == nullptr)          continue;
+				if(instruction->block == nullptr)   continue;
+
+				if(!engine.blockExecutable[instruction->block->id()])
+				{
+					continue;
+				}
+
+				visitInstruction(engine, instruction);
+			}
+		}
+	}
+}
+
+/*! \brief Replace constant register reads with immediates */
+static unsigned int rewriteOperands(SCCPEngine& engine, BasicBlock* block)
+{
+	unsigned int rewritten = 0;
+
+	for(auto instruction : *block)
+	{
+		if(instruction->isPhi() || instruction->isPsi()) continue;
+
+		// skip the guard, reads[0]
+		for(unsigned int read = 1;
+			read < instruction->reads.size(); ++read)
+		{
+			auto operand = instruction->reads[read];
+
+			if(!operand->isRegister()) continue;
+			if(operand->mode() != Operand::Register) continue;
+
+			auto registerOperand = static_cast<RegisterOperand*>(operand);
+
+			if(registerOperand->virtualRegister == nullptr) continue;
+
+			auto& cell =
+				engine.values[registerOperand->virtualRegister->id];
+
+			if(cell.state != Cell::ConstantValue) continue;
+
+			auto immediate = new ImmediateOperand(cell.value,
+				instruction, registerOperand->type());
+
+			registerOperand->setVirtualRegister(nullptr);
+
+			ir::Operand::dispose(registerOperand);
+
+			instruction->reads[read] = immediate;
+
+			++rewritten;
+		}
+	}
+
+	return rewritten;
+}
+
+/*! \brief Rewrite a decided conditional branch */
+static bool foldBranch(SCCPEngine& engine, BasicBlock* block)
+{
+	auto terminator = block->terminator();
+
+	if(terminator == nullptr)               return false;
+	if(!terminator->isBranch())             return false;
+	if(terminator->isCall())                return false;
+	if(terminator->isMachineInstruction())  return false;
+
+	auto branch = static_cast<ir::Bra*>(terminator);
+
+	if(branch->isUnconditional()) return false;
+
+	auto guard = guardCell(engine, branch);
+
+	if(guard.state != Cell::ConstantValue) return false;
+
+	if(guard.value != 0)
+	{
+		// always taken, drop the condition
+		report("  branch in '" << block->name() << "' is always taken");
+
+		branch->setGuard(new PredicateOperand(
+			PredicateOperand::PredicateTrue, branch));
+	}
+	else
+	{
+		// never taken, the block just falls through
+		report("  branch in '" << block->name() << "' never fires");
+
+		branch->eraseFromBlock();
+	}
+
+	return true;
+}
+
+ConstantPropagationPass::ConstantPropagationPass()
+: FunctionPass(StringVector({"ControlFlowGraph"}),
+  "ConstantPropagationPass")
+{
+
+}
+
+void ConstantPropagationPass::runOnFunction(Function& f)
+{
+	if(f.empty()) return;
+
+	report("Running sparse conditional constant propagation on '"
+		<< f.name() << "'");
+
+	SCCPEngine engine;
+
+	engine.function = &f;
+	engine.cfg      = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+
+	engine.values.assign(f.register_size(), Cell());
+	engine.blockExecutable.assign(f.size(), false);
+	engine.nextBlock.assign(f.size(), nullptr);
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		auto next = block; ++next;
+
+		if(next != f.end()) engine.nextBlock[block->id()] = &*next;
+	}
+
+	auto entry = &*f.entry_block();
+
+	engine.blockExecutable[entry->id()] = true;
+	engine.blockWorklist.push_back(entry);
+
+	solve(engine);
+
+	// rewrite the function using the fixed point
+	unsigned int rewritten = 0;
+	unsigned int folded    = 0;
+	unsigned int emptied   = 0;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		if(!engine.blockExecutable[block->id()])
+		{
+			// never reached, empty it out for the CFG simplifier
+			if(!block->empty())
+			{
+				block->clear();
+				++emptied;
+			}
+
+			continue;
+		}
+
+		rewritten += rewriteOperands(engine, &*block);
+
+		if(foldBranch(engine, &*block)) ++folded;
+	}
+
+	report(" rewrote " << rewritten << " operands, folded " << folded
+		<< " branches, emptied " << emptied << " unreachable blocks");
+
+	if(rewritten != 0 || folded != 0 || emptied != 0)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+	}
+
+	if(folded != 0 || emptied != 0)
+	{
+		invalidateAnalysis("ControlFlowGraph");
+	}
+}
+
+Pass* ConstantPropagationPass::clone() const
+{
+	return new ConstantPropagationPass;
+}
+
+}
+
+}
+
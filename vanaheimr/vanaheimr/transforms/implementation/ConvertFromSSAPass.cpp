@@ -7,15 +7,27 @@
 // Vanaheimr Includes
 #include <vanaheimr/transforms/interface/ConvertFromSSAPass.h>
 
-#include <vanaheimr/analysis/interface/DataflowAnalysis.h>
+#include <vanaheimr/analysis/interface/LiveRangeAnalysis.h>
 
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
 
 #include <vanaheimr/util/interface/SmallSet.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <map>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
 
 namespace vanaheimr
 {
@@ -23,17 +35,35 @@ namespace vanaheimr
 namespace transforms
 {
 
+typedef analysis::LiveRangeAnalysis LiveRangeAnalysis;
+
+typedef LiveRangeAnalysis::Interval       Interval;
+typedef LiveRangeAnalysis::IntervalVector IntervalVector;
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::VirtualRegister VirtualRegister;
+
+typedef std::vector<unsigned int>     IdVector;
+typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+typedef std::vector<IntervalVector>   IntervalVectorVector;
+
 ConvertFromSSAPass::ConvertFromSSAPass()
-: FunctionPass(StringVector({"DataflowAnalysis"}),
+: FunctionPass(StringVector({"DataflowAnalysis", "LiveRangeAnalysis"}),
   "ConvertFromSSAPass")
 {
-	
+
 }
 
 void ConvertFromSSAPass::runOnFunction(Function& f)
 {
+	report("Running ConvertFromSSA pass on function '" << f.name() << "'");
+
+	_coalescePhis(f);
 	_removePhis(f);
 	_removePsis(f);
+
+	invalidateAnalysis("DataflowAnalysis");
+	invalidateAnalysis("LiveRangeAnalysis");
 }
 
 Pass* ConvertFromSSAPass::clone() const
@@ -41,168 +71,379 @@ Pass* ConvertFromSSAPass::clone() const
 	return new ConvertFromSSAPass;
 }
 
-void ConvertFromSSAPass::_removePhis(Function& f)
+static unsigned int findRepresentative(IdVector& parents, unsigned int id)
 {
-	// TODO split critical edges
-
-	// for all
-	for(auto block = f.begin(); block != f.end(); ++block)
+	while(parents[id] != id)
 	{
-		_removePhis(*block);
+		// path halving
+		parents[id] = parents[parents[id]];
+
+		id = parents[id];
 	}
+
+	return id;
 }
 
-void ConvertFromSSAPass::_removePsis(Function& f)
+/*! \brief Do two sorted disjoint interval sets overlap? */
+static bool intervalsOverlap(const IntervalVector& left,
+	const IntervalVector& right)
 {
-	// for all
-	for(auto block = f.begin(); block != f.end(); ++block)
+	auto l = left.begin();
+	auto r = right.begin();
+
+	while(l != left.end() && r != right.end())
 	{
-		// for all?
-		for(auto instruction : *block)
+		if(l->overlaps(*r)) return true;
+
+		if(l->end <= r->begin)
 		{
-			if(!instruction->isPsi()) continue;
-			
-			_removePsi(static_cast<ir::Psi&>(*instruction));
+			++l;
+		}
+		else
+		{
+			++r;
 		}
 	}
+
+	return false;
 }
 
-static ir::BasicBlock::iterator getFirstNonPhiInstruction(ir::BasicBlock& block)
+/*! \brief Merge sorted disjoint interval sets, coalescing neighbors */
+static IntervalVector mergeIntervals(const IntervalVector& left,
+	const IntervalVector& right)
 {
-	for(auto instruction = block.begin();
-		instruction != block.end(); ++instruction)
+	IntervalVector merged;
+
+	merged.reserve(left.size() + right.size());
+
+	auto l = left.begin();
+	auto r = right.begin();
+
+	while(l != left.end() || r != right.end())
 	{
-		if(!(*instruction)->isPhi()) return instruction;
-	}
-	
-	return block.end();
-}
+		Interval next;
 
-typedef util::SmallSet<ir::Phi*> PhiSet;
+		if(r == right.end() || (l != left.end() && l->begin <= r->begin))
+		{
+			next = *l++;
+		}
+		else
+		{
+			next = *r++;
+		}
 
-static ir::VirtualRegister* lookupOrCreatePhiSourceRegister(
-	ir::Phi* phi, PhiSet& phis)
-{
-	// TODO actually look for a duplicate phi
-	phis.insert(phi);
-	
-	auto newRegister = phi->block->function()->newVirtualRegister(
-		phi->d()->type());
+		if(!merged.empty() && next.begin <= merged.back().end)
+		{
+			merged.back().end = std::max(merged.back().end, next.end);
+		}
+		else
+		{
+			merged.push_back(next);
+		}
+	}
 
-	return &*newRegister;
+	return merged;
 }
 
-typedef analysis::DataflowAnalysis DataflowAnalysis;
-
-static ir::BasicBlock::iterator determineInsertionPosition(
-	ir::BasicBlock* block, ir::VirtualRegister* source, DataflowAnalysis* dfg)
+void ConvertFromSSAPass::_coalescePhis(Function& f)
 {
-	if(block->empty()) return block->begin();
+	report(" Coalescing phi webs");
+
+	auto liveRanges = static_cast<LiveRangeAnalysis*>(
+		getAnalysis("LiveRangeAnalysis"));
+	assert(liveRanges != nullptr);
+
+	// union-find over register ids, each class carries merged intervals
+	IdVector              parents(f.register_size());
+	VirtualRegisterVector registersById(f.register_size(), nullptr);
+	IntervalVectorVector  classIntervals(f.register_size());
 
-	// Discover defs/uses in the block
-	auto defs = dfg->getReachingDefinitions(*source);
-	auto uses = dfg->getReachedUses(*source);
-	
-	DataflowAnalysis::InstructionSet defUsesInThisBlock;
-	
-	for(auto def : defs)
+	for(auto value = f.register_begin(); value != f.register_end(); ++value)
 	{
-		if(def->block == block) defUsesInThisBlock.insert(def);
+		parents[value->id]       = value->id;
+		registersById[value->id] = &*value;
+
+		auto range = liveRanges->getLiveRange(*value);
+
+		if(range != nullptr) classIntervals[value->id] = range->intervals;
 	}
-	
-	for(auto use : uses)
+
+	unsigned int coalescedCount = 0;
+
+	// try to merge each phi destination with each of its sources, merges
+	// are rejected when the combined live ranges would interfere
+	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		if(use->block == block) defUsesInThisBlock.insert(use);
+		for(auto instruction : *block)
+		{
+			if(!instruction->isPhi()) break;
+
+			auto phi = static_cast<ir::Phi*>(instruction);
+
+			if(phi->d() == nullptr) continue;
+
+			auto destination = phi->d()->virtualRegister;
+
+			if(destination == nullptr) continue;
+
+			for(auto source : phi->sources())
+			{
+				if(source->virtualRegister == nullptr) continue;
+
+				auto destinationClass = findRepresentative(parents,
+					destination->id);
+				auto sourceClass = findRepresentative(parents,
+					source->virtualRegister->id);
+
+				if(destinationClass == sourceClass) continue;
+
+				if(intervalsOverlap(classIntervals[destinationClass],
+					classIntervals[sourceClass]))
+				{
+					continue;
+				}
+
+				report("  coalescing r" << source->virtualRegister->id
+					<< " into r" << destination->id);
+
+				parents[sourceClass] = destinationClass;
+
+				classIntervals[destinationClass] = mergeIntervals(
+					classIntervals[destinationClass],
+					classIntervals[sourceClass]);
+
+				classIntervals[sourceClass].clear();
+
+				++coalescedCount;
+			}
+		}
 	}
-	
-	// start at the beginning
-	auto position = block->begin();
-	
-	if(!defUsesInThisBlock.empty())
+
+	if(coalescedCount == 0) return;
+
+	report("  rewriting operands of " << coalescedCount
+		<< " coalesced registers");
+
+	// retarget every operand of a merged register at its representative
+	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		// rewind from the end
-		position = block->end();
-		
-		while(defUsesInThisBlock.count(*--position) == 0);
-		
-		++position;
+		for(auto instruction : *block)
+		{
+			for(auto operand : instruction->reads)
+			{
+				if(!operand->isRegister()) continue;
+
+				auto registerOperand =
+					static_cast<ir::RegisterOperand*>(operand);
+
+				if(registerOperand->virtualRegister == nullptr) continue;
+
+				auto representative = findRepresentative(parents,
+					registerOperand->virtualRegister->id);
+
+				if(representative == registerOperand->virtualRegister->id)
+				{
+					continue;
+				}
+
+				registerOperand->setVirtualRegister(
+					registersById[representative]);
+			}
+
+			for(auto operand : instruction->writes)
+			{
+				if(!operand->isRegister()) continue;
+
+				auto registerOperand =
+					static_cast<ir::RegisterOperand*>(operand);
+
+				if(registerOperand->virtualRegister == nullptr) continue;
+
+				auto representative = findRepresentative(parents,
+					registerOperand->virtualRegister->id);
+
+				if(representative == registerOperand->virtualRegister->id)
+				{
+					continue;
+				}
+
+				registerOperand->setVirtualRegister(
+					registersById[representative]);
+			}
+		}
 	}
-	
-	// skip phis
-	if((*position)->isPhi())
+
+	// the merged registers have no remaining uses
+	for(unsigned int id = 0; id != parents.size(); ++id)
 	{
-		position = getFirstNonPhiInstruction(*block);
+		if(findRepresentative(parents, id) == id) continue;
+
+		f.erase(registersById[id]);
 	}
-	
-	return position;	
 }
 
-static void removeFirstPhi(ir::BasicBlock& block,
-	const ir::BasicBlock::iterator& phiEnd, PhiSet& phis, DataflowAnalysis* dfg)
+/*! \brief One assignment of an edge's parallel copy */
+class Copy
 {
-	auto phi = static_cast<ir::Phi*>(block.front());
+public:
+	VirtualRegister* destination;
+	VirtualRegister* source;
+};
 
-	//  Try to reuse an existing phi (updates phi set)
-	auto sourceRegister = lookupOrCreatePhiSourceRegister(phi, phis);
+typedef std::vector<Copy>                  CopyVector;
+typedef std::map<BasicBlock*, CopyVector>  BlockCopyMap;
+
+static ir::BasicBlock::iterator getCopyInsertionPoint(BasicBlock* block)
+{
+	auto position = block->end();
 
-	// Create a register-to-register copy of a source into the PHI destination
+	// copies go before the terminator so that they execute on the edge
+	if(!block->empty() && block->back()->isBranch()) --position;
+
+	return position;
+}
+
+static void emitCopy(BasicBlock* block, ir::BasicBlock::iterator position,
+	VirtualRegister* destination, VirtualRegister* source)
+{
 	auto copy = new ir::Bitcast;
-	
+
 	copy->setGuard(new ir::PredicateOperand(
 		ir::PredicateOperand::PredicateTrue, copy));
-	copy->setD(new ir::RegisterOperand(phi->d()->virtualRegister, copy));
-	copy->setA(new ir::RegisterOperand(sourceRegister, copy));
-
-	// Insert the copy before the non-phi first instruction
-	block.insert(phiEnd, copy);
-
-	// Add move instructions of the PHI source values into the copied
-	//  register in the predecessors
-	auto sources = phi->sources();
-	auto blocks  = phi->blocks();
-	
-	assert(sources.size() == blocks.size());
-	
-	auto predecessor = blocks.begin();
-	for(auto source = sources.begin(); source != sources.end();
-		++source, ++predecessor)
+	copy->setD(new ir::RegisterOperand(destination, copy));
+	copy->setA(new ir::RegisterOperand(source, copy));
+
+	block->insert(position, copy);
+}
+
+/*! \brief Emit an edge's copies so they read their values as if they all
+	executed at once, cycles are broken with one temporary */
+static void sequentializeParallelCopy(ir::Function& f,
+	BasicBlock* block, CopyVector& copies)
+{
+	auto position = getCopyInsertionPoint(block);
+
+	while(!copies.empty())
+	{
+		bool progress = false;
+
+		for(auto copy = copies.begin(); copy != copies.end(); )
+		{
+			bool destinationIsRead = false;
+
+			for(auto& other : copies)
+			{
+				if(other.source == copy->destination)
+				{
+					destinationIsRead = true;
+					break;
+				}
+			}
+
+			if(destinationIsRead)
+			{
+				++copy;
+				continue;
+			}
+
+			emitCopy(block, position, copy->destination, copy->source);
+
+			copy = copies.erase(copy);
+
+			progress = true;
+		}
+
+		if(progress || copies.empty()) continue;
+
+		// every remaining destination is still read, break the cycle by
+		// saving one destination in a temporary
+		auto& cycleCopy = copies.front();
+
+		auto temporary = &*f.newVirtualRegister(cycleCopy.destination->type);
+
+		report("   breaking copy cycle in block '" << block->name()
+			<< "' with temporary r" << temporary->id);
+
+		emitCopy(block, position, temporary, cycleCopy.destination);
+
+		for(auto& copy : copies)
+		{
+			if(copy.source == cycleCopy.destination)
+			{
+				copy.source = temporary;
+			}
+		}
+	}
+}
+
+void ConvertFromSSAPass::_removePhis(Function& f)
+{
+	// TODO split critical edges
+
+	report(" Lowering phis to copies");
+
+	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		auto insertPosition = determineInsertionPosition(*predecessor,
-			(*source)->virtualRegister, dfg);
-	
-		auto copy = new ir::Bitcast;
-	
-		copy->setGuard(new ir::PredicateOperand(
-			ir::PredicateOperand::PredicateTrue, copy));
-		copy->setD(new ir::RegisterOperand(sourceRegister, copy));
-		copy->setA(new ir::RegisterOperand((*source)->virtualRegister, copy));
-
-		(*predecessor)->insert(insertPosition, copy);
+		// gather the phis, they read their sources in parallel on entry
+		BlockCopyMap edgeCopies;
+
+		while(!block->empty() && block->front()->isPhi())
+		{
+			auto phi = static_cast<ir::Phi*>(block->front());
+
+			auto destination = phi->d()->virtualRegister;
+
+			auto sources      = phi->sources();
+			auto predecessors = phi->blocks();
+
+			assert(sources.size() == predecessors.size());
+
+			auto predecessor = predecessors.begin();
+
+			for(auto source = sources.begin(); source != sources.end();
+				++source, ++predecessor)
+			{
+				// coalesced away entirely
+				if((*source)->virtualRegister == destination) continue;
+
+				edgeCopies[*predecessor].push_back(
+					Copy{destination, (*source)->virtualRegister});
+			}
+
+			// unlink the operands so that deferred destruction of arena
+			// allocated phis cannot corrupt the use chains
+			for(auto source : sources)
+			{
+				source->setVirtualRegister(nullptr);
+			}
+
+			phi->d()->setVirtualRegister(nullptr);
+
+			block->pop_front();
+
+			// arena-allocated phis are destroyed with the module, a raw
+			// delete here would double-destroy them
+			ir::Instruction::dispose(phi);
+		}
+
+		for(auto& edge : edgeCopies)
+		{
+			sequentializeParallelCopy(f, edge.first, edge.second);
+		}
 	}
-	
-	// Delete the phi from the block
-	block.pop_front();	
 }
 
-void ConvertFromSSAPass::_removePhis(ir::BasicBlock& block)
+void ConvertFromSSAPass::_removePsis(Function& f)
 {
-	// get the first instruction after the phi
-	auto phiEnd = getFirstNonPhiInstruction(block);
-	
-	auto dfg = static_cast<DataflowAnalysis*>(getAnalysis("DataflowAnalysis"));
-		
-	// possibly do this in parallel, but have to be careful about dependencies
-	while(!block.empty() && block.front()->isPhi())
+	// for all
+	for(auto block = f.begin(); block != f.end(); ++block)
 	{
-		PhiSet phis;
-		
-		removeFirstPhi(block, phiEnd, phis, dfg);
-		
-		//  1) It will be necessary to destroy these in a post-pass after
-		//      removing the phis from blocks first to avoid read-after-deletes
-		for(auto phi : phis)
+		// for all?
+		for(auto instruction : *block)
 		{
-			delete phi;
+			if(!instruction->isPsi()) continue;
+
+			_removePsi(static_cast<ir::Psi&>(*instruction));
 		}
 	}
 }
@@ -217,4 +458,3 @@ void ConvertFromSSAPass::_removePsi(ir::Psi& psi)
 
 }
 
-
@@ -0,0 +1,191 @@
+/*! \file   ConvertThreadsToSIMDPass.cpp
+	\author Gregory Diamos <solusstutlus@gmail.com>
+	\date   Tuesday September 11, 2012
+	\brief  The source file for the ConvertThreadsToSIMDPass class.
+*/
+
+// Vanahimer Includes
+#include <vanaheimr/transforms/interface/ConvertThreadsToSIMDPass.h>
+
+#include <vanaheimr/analysis/interface/ThreadFrontierAnalysis.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::ThreadFrontierAnalysis ThreadFrontierAnalysis;
+
+typedef std::vector<ir::BasicBlock*> BasicBlockVector;
+typedef std::vector<uint64_t>        CostVector;
+
+ConvertThreadsToSIMDPass::ConvertThreadsToSIMDPass()
+: FunctionPass(StringVector({"ControlFlowGraph", "ThreadFrontierAnalysis"}),
+	"ConvertThreadsToSIMDPass")
+{
+
+}
+
+/*! \brief Cost a region in both modes and pick the cheaper one.
+
+	Scalar execution runs every lane's thread through the region
+	serially, so it pays the lane width on every instruction.  SIMD
+	execution pays each instruction once, plus a re-execution for every
+	block in a member's thread frontier, since each of those blocks can
+	hold waiting threads that force the member to run again with a
+	partial set of lanes. */
+static ConvertThreadsToSIMDPass::ExecutionMode chooseMode(
+	const BasicBlockVector& region, const CostVector& frontierSizes,
+	unsigned int laneWidth)
+{
+	uint64_t scalarCost = 0;
+	uint64_t simdCost   = 0;
+
+	for(auto block : region)
+	{
+		uint64_t instructions = block->size();
+
+		scalarCost += instructions * laneWidth;
+		simdCost   += instructions * (1 + frontierSizes[block->id()]);
+	}
+
+	return simdCost < scalarCost ?
+		ConvertThreadsToSIMDPass::SIMD : ConvertThreadsToSIMDPass::Scalar;
+}
+
+void ConvertThreadsToSIMDPass::runOnFunction(Function& f)
+{
+	report("Choosing SIMD or scalar execution for regions of '"
+		<< f.name() << "'");
+
+	auto threadFrontierAnalysis = static_cast<ThreadFrontierAnalysis*>(
+		getAnalysis("ThreadFrontierAnalysis"));
+	assert(threadFrontierAnalysis != nullptr);
+
+	auto machine = compiler::Compiler::getSingleton()->getMachineModel();
+
+	unsigned int laneWidth = machine->laneWidth();
+
+	size_t blockIdLimit = 0;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		blockIdLimit = std::max(blockIdLimit, (size_t)block->id() + 1);
+	}
+
+	_modes.assign(blockIdLimit, Scalar);
+
+	// a scalar machine has no lanes to pack threads into
+	if(laneWidth < 2)
+	{
+		report(" machine '" << machine->name << "' is scalar, done");
+
+		return;
+	}
+
+	// visit blocks in the same order the SIMD scheduler would
+	BasicBlockVector blocks;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		blocks.push_back(&*block);
+	}
+
+	std::stable_sort(blocks.begin(), blocks.end(),
+		[=](const ir::BasicBlock* left, const ir::BasicBlock* right)
+		{
+			return threadFrontierAnalysis->getPriority(*left) >
+				threadFrontierAnalysis->getPriority(*right);
+		});
+
+	auto frontiers = threadFrontierAnalysis->getThreadFrontiers(blocks);
+
+	// a block in no frontier is a reconvergence point, all lanes are
+	// back together there, so it opens a new region
+	std::vector<bool> inSomeFrontier(blockIdLimit, false);
+
+	CostVector frontierSizes(blockIdLimit, 0);
+
+	for(unsigned int i = 0; i != blocks.size(); ++i)
+	{
+		frontierSizes[blocks[i]->id()] = frontiers[i].size();
+
+		for(auto member : frontiers[i])
+		{
+			inSomeFrontier[member->id()] = true;
+		}
+	}
+
+	BasicBlockVector region;
+
+	auto closeRegion = [&]()
+	{
+		if(region.empty()) return;
+
+		auto mode = chooseMode(region, frontierSizes, laneWidth);
+
+		reportE(mode == SIMD, " region at '" << region.front()->name()
+			<< "' (" << region.size() << " blocks) runs SIMD");
+		reportE(mode == Scalar, " region at '" << region.front()->name()
+			<< "' (" << region.size() << " blocks) stays scalar");
+
+		for(auto block : region)
+		{
+			_modes[block->id()] = mode;
+		}
+
+		region.clear();
+	};
+
+	for(auto block : blocks)
+	{
+		if(!inSomeFrontier[block->id()]) closeRegion();
+
+		region.push_back(block);
+	}
+
+	closeRegion();
+}
+
+Pass* ConvertThreadsToSIMDPass::clone() const
+{
+	return new ConvertThreadsToSIMDPass;
+}
+
+ConvertThreadsToSIMDPass::ExecutionMode
+	ConvertThreadsToSIMDPass::getExecutionMode(
+	const ir::BasicBlock& block) const
+{
+	if(block.id() >= _modes.size()) return Scalar;
+
+	return _modes[block.id()];
+}
+
+}
+
+}
+
+
@@ -14,8 +14,8 @@
 #include <vanaheimr/ir/interface/Function.h>
 #include <vanaheimr/ir/interface/BasicBlock.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
 #include <algorithm>
@@ -62,18 +62,22 @@ void ConvertToSSAPass::_insertPhis(Function& function)
 	report(" Inserting PHIs");
 
 	typedef util::SmallSet<BasicBlock*> BasicBlockSet;
+	typedef std::vector<VirtualRegisterVector> BlockPhiVector;
 
 	// Insert Phis for live ins that are in the dominance frontier of
-	//     any definition
-	// 
+	//     any definition (pruned SSA, dead phis are never placed)
+	//
 	// Caveat: PHI placement may create additional definitions, so blocks in
 	//         the DF of newly-placed PHIs need to be checked again
-	
+
 	// Get dependent analyses
 	auto dfg = static_cast<DataflowAnalysis*>(getAnalysis("DataflowAnalysis"));
 	auto dominatorAnalysis = static_cast<DominatorAnalysis*>(
 		getAnalysis("DominatorAnalysis"));
-	
+
+	// phi placements, gathered by block and inserted in one batch
+	BlockPhiVector pendingPhis(function.size());
+
 	// parallel for-all values
 	for(auto value = function.register_begin();
 		value != function.register_end(); ++value)
@@ -81,43 +85,51 @@ void ConvertToSSAPass::_insertPhis(Function& function)
 		auto definingBlocks = _getBlocksThatDefineThisValue(*value);
 
 		BasicBlockSet blocksThatNeedPhis;
-				
+
 		// The inner loop is sequential
 		while(!definingBlocks.empty())
 		{
 			auto definingBlock = *definingBlocks.begin();
 			definingBlocks.erase(definingBlocks.begin());
-			
+
 			auto dominanceFrontier = dominatorAnalysis->getDominanceFrontier(
 				*definingBlock);
-			
+
 			// iterated dominance frontier
 			for(auto frontierBlock : dominanceFrontier)
 			{
-				// the value needs a PHI if it is live-in here
-				auto liveIns = dfg->getLiveIns(*frontierBlock);
-				
-				if(liveIns.count(&*value) != 0)
+				// the value needs a PHI only if it is live-in here
+				if(!dfg->isLiveIn(*value, *frontierBlock)) continue;
+
+				if(blocksThatNeedPhis.insert(frontierBlock).second)
 				{
-					if(blocksThatNeedPhis.insert(frontierBlock).second)
-					{
-						definingBlocks.insert(frontierBlock);
-					}
+					definingBlocks.insert(frontierBlock);
 				}
 			}
 		}
-		
-		// parallel version: sort by block and bulk-insert the phis
+
+		if(blocksThatNeedPhis.empty()) continue;
+
 		for(auto block : blocksThatNeedPhis)
 		{
-			_insertPhi(*value, *block);
-			
+			pendingPhis[block->id()].push_back(&*value);
+
 			report("  PHI needed for R" << value->id << " in block "
 				<< block->name());
-			
-			// parallel: Do this with a local update, and then a final gather
-			_registersNeedingRenaming.insert(&*value);
 		}
+
+		// parallel: Do this with a local update, and then a final gather
+		_registersNeedingRenaming.insert(&*value);
+	}
+
+	// bulk-insert the phis, one pass per block
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto& values = pendingPhis[block->id()];
+
+		if(values.empty()) continue;
+
+		_insertPhis(*block, values);
 	}
 }
 
@@ -168,35 +180,42 @@ void ConvertToSSAPass::_insertPsis(Function& function)
 	}
 }
 
-void ConvertToSSAPass::_insertPhi(VirtualRegister& vr, BasicBlock& block)
+void ConvertToSSAPass::_insertPhis(BasicBlock& block,
+	const VirtualRegisterVector& values)
 {
-	auto phi = new ir::Phi(&block);
-	
-	phi->setD(new ir::RegisterOperand(&vr, phi));
-	phi->setGuard(new ir::PredicateOperand(
-		ir::PredicateOperand::PredicateTrue, phi));
-
-	// add sources for each predecessor
 	auto cfg = static_cast<ControlFlowGraph*>(getAnalysis("ControlFlowGraph"));
 	assert(cfg != nullptr);
 
+	auto dfg = static_cast<DataflowAnalysis*>(getAnalysis("DataflowAnalysis"));
+	assert(dfg != nullptr);
+
+	// one predecessor query serves every phi in the block
 	auto predecessors = cfg->getPredecessors(block);
 
-	for(auto predecessor : predecessors)
+	auto insertionPoint = block.begin();
+
+	for(auto value : values)
 	{
-		phi->addSource(new ir::RegisterOperand(&vr, phi),
-			new ir::AddressOperand(predecessor, phi));
-	}
-	
-	// update reaching defs, serial is fine since each value is processed
-	// independently
-	auto dfg = static_cast<DataflowAnalysis*>(getAnalysis("DataflowAnalysis"));
-	assert(dfg != nullptr);
-	
-	dfg->addReachingDefinition(vr, *phi);
+		auto phi = new ir::Phi(&block);
 
-	// parallel version: atomic
-	block.push_front(phi);
+		phi->setD(new ir::RegisterOperand(value, phi));
+		phi->setGuard(new ir::PredicateOperand(
+			ir::PredicateOperand::PredicateTrue, phi));
+
+		// add sources for each predecessor
+		for(auto predecessor : predecessors)
+		{
+			phi->addSource(new ir::RegisterOperand(value, phi),
+				new ir::AddressOperand(predecessor, phi));
+		}
+
+		// update reaching defs, serial is fine since each value is processed
+		// independently
+		dfg->addReachingDefinition(*value, *phi);
+
+		insertionPoint = block.insert(insertionPoint, phi);
+		++insertionPoint;
+	}
 }
 
 void ConvertToSSAPass::_rename(Function& f)
@@ -343,7 +362,7 @@ void ConvertToSSAPass::_updateDefinition(Instruction& definingInstruction,
 		if(writeOperand->virtualRegister != &value) continue;
 		
 		// rename the register
-		writeOperand->virtualRegister = &newValue;
+		writeOperand->setVirtualRegister(&newValue);
 	}
 }
 
@@ -380,7 +399,7 @@ bool ConvertToSSAPass::_updateUsesInThisBlock(Instruction& definingInstruction,
 				<< (*instruction)->toString() << "'");
 			
 			// update the value
-			readOperand->virtualRegister = &newValue;
+			readOperand->setVirtualRegister(&newValue);
 		}
 		
 		// stop on the first def
@@ -445,7 +464,7 @@ void ConvertToSSAPass::_renameValuesInBlock(
 				<< renamedValue->second->id << " in '"
 				<< instruction->toString() << "'");
 	
-			readOperand->virtualRegister = renamedValue->second;
+			readOperand->setVirtualRegister(renamedValue->second);
 		}
 			
 		// kill the update on writes
@@ -586,7 +605,7 @@ void ConvertToSSAPass::_renamePhiInputs(BasicBlock* block,
 						<< block->name());
 					
 					foundPhi = true;
-					source->virtualRegister = value.second;
+					source->setVirtualRegister(value.second);
 					break;
 				}
 				
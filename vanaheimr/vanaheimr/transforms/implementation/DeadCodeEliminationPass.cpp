@@ -0,0 +1,200 @@
+/*! \file   DeadCodeEliminationPass.cpp
+	\date   Monday September 10, 2012
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the DeadCodeEliminationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/DeadCodeEliminationPass.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+#include <vanaheimr/util/interface/SmallSet.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+DeadCodeEliminationPass::DeadCodeEliminationPass()
+: FunctionPass(StringVector(), "DeadCodeEliminationPass")
+{
+
+}
+
+typedef ir::Instruction          Instruction;
+typedef ir::RegisterOperand      RegisterOperand;
+typedef ir::VirtualRegister      VirtualRegister;
+
+typedef std::vector<Instruction*>        InstructionVector;
+typedef util::SmallSet<Instruction*>     InstructionSet;
+typedef util::SmallSet<VirtualRegister*> VirtualRegisterSet;
+
+static bool isWriteOperand(const RegisterOperand* operand)
+{
+	for(auto write : operand->instruction->writes)
+	{
+		if(write == operand) return true;
+	}
+
+	return false;
+}
+
+/*! \brief Does any instruction read the register? */
+static bool hasLiveUses(const VirtualRegister& virtualRegister)
+{
+	for(auto use = virtualRegister.firstUse();
+		use != nullptr; use = use->nextUse())
+	{
+		if(!isWriteOperand(use)) return true;
+	}
+
+	return false;
+}
+
+static bool isDead(const Instruction& instruction)
+{
+	// anything that touches control flow or memory is kept
+	if(instruction.isBranch())        return false;
+	if(instruction.isStore())         return false;
+	if(instruction.isCall())          return false;
+	if(instruction.isReturn())        return false;
+	if(instruction.isMemoryBarrier()) return false;
+	if(instruction.isIntrinsic())     return false;
+
+	if(instruction.writes.empty()) return false;
+
+	for(auto write : instruction.writes)
+	{
+		if(!write->isRegister()) return false;
+
+		auto virtualRegister =
+			static_cast<const RegisterOperand*>(write)->virtualRegister;
+
+		if(virtualRegister == nullptr) continue;
+
+		if(hasLiveUses(*virtualRegister)) return false;
+	}
+
+	return true;
+}
+
+static void removeInstruction(Instruction* instruction,
+	InstructionVector& worklist, InstructionSet& queued)
+{
+	report("  removing '" << instruction->toString() << "'");
+
+	// registers the instruction reads may become dead below
+	VirtualRegisterSet readRegisters;
+
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		auto virtualRegister =
+			static_cast<RegisterOperand*>(read)->virtualRegister;
+
+		if(virtualRegister != nullptr)
+		{
+			readRegisters.insert(virtualRegister);
+		}
+	}
+
+	// unlink the operands explicitly, arena-allocated instructions skip
+	// their destructors until the arena is cleared
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+
+	instruction->eraseFromBlock();
+
+	// propagate through the use-def chains, the remaining links on a
+	// register without live uses are its definitions
+	for(auto virtualRegister : readRegisters)
+	{
+		if(hasLiveUses(*virtualRegister)) continue;
+
+		for(auto use = virtualRegister->firstUse();
+			use != nullptr; use = use->nextUse())
+		{
+			auto definition = use->instruction;
+
+			if(!isDead(*definition))          continue;
+			if(!queued.insert(definition).second) continue;
+
+			worklist.push_back(definition);
+		}
+	}
+}
+
+void DeadCodeEliminationPass::runOnFunction(Function& f)
+{
+	report("Running dead code elimination on function '"
+		<< f.name() << "'");
+
+	InstructionVector worklist;
+	InstructionSet    queued;
+
+	// seed with trivially dead definitions
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		for(auto instruction : *block)
+		{
+			if(!isDead(*instruction)) continue;
+
+			if(queued.insert(instruction).second)
+			{
+				worklist.push_back(instruction);
+			}
+		}
+	}
+
+	report(" seeded worklist with " << worklist.size() << " instructions");
+
+	while(!worklist.empty())
+	{
+		auto instruction = worklist.back();
+
+		worklist.pop_back();
+
+		removeInstruction(instruction, worklist, queued);
+	}
+}
+
+Pass* DeadCodeEliminationPass::clone() const
+{
+	return new DeadCodeEliminationPass;
+}
+
+}
+
+}
+
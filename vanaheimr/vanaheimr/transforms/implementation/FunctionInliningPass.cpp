@@ -0,0 +1,415 @@
+/*! \file   FunctionInliningPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the FunctionInliningPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/FunctionInliningPass.h>
+
+#include <vanaheimr/analysis/interface/CallGraphAnalysis.h>
+#include <vanaheimr/analysis/interface/RegisterPressureAnalysis.h>
+#include <vanaheimr/analysis/interface/AnalysisFactory.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <vector>
+#include <sstream>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::CallGraphAnalysis        CallGraphAnalysis;
+typedef analysis::RegisterPressureAnalysis RegisterPressureAnalysis;
+typedef analysis::AnalysisFactory          AnalysisFactory;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::Operand          Operand;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::AddressOperand   AddressOperand;
+typedef ir::ArgumentOperand  ArgumentOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+
+typedef std::unordered_map<const ir::Variable*, BasicBlock*>   BlockMap;
+typedef std::unordered_map<VirtualRegister*, VirtualRegister*> RegisterMap;
+typedef std::unordered_map<const ir::Argument*, Operand*>      ArgumentMap;
+
+FunctionInliningPass::FunctionInliningPass()
+: ModulePass(StringVector({"CallGraphAnalysis"}), "FunctionInliningPass"),
+  inliningThreshold(32), pressureThreshold(32)
+{
+	auto machine = compiler::Compiler::getSingleton()->getMachineModel();
+
+	if(machine != nullptr)
+	{
+		pressureThreshold = machine->totalRegisterCount() / 2;
+	}
+}
+
+/*! \brief Rewrite one operand of a cloned instruction for the caller's
+	context, returns the replacement (possibly the operand itself) */
+static Operand* remapOperand(Operand* operand, Instruction* instruction,
+	const RegisterMap& registers, const BlockMap& blocks,
+	const ArgumentMap& arguments)
+{
+	if(operand == nullptr) return operand;
+
+	if(operand->isRegister())
+	{
+		auto registerOperand = static_cast<RegisterOperand*>(operand);
+
+		auto mapped = registers.find(registerOperand->virtualRegister);
+
+		if(mapped != registers.end())
+		{
+			registerOperand->setVirtualRegister(mapped->second);
+		}
+
+		return operand;
+	}
+
+	if(operand->mode() == Operand::Address)
+	{
+		auto addressOperand = static_cast<AddressOperand*>(operand);
+
+		auto mapped = blocks.find(addressOperand->globalValue);
+
+		if(mapped != blocks.end())
+		{
+			addressOperand->globalValue = mapped->second;
+		}
+
+		return operand;
+	}
+
+	if(operand->mode() == Operand::Argument)
+	{
+		auto argumentOperand = static_cast<ArgumentOperand*>(operand);
+
+		auto actual = arguments.find(argumentOperand->argument);
+
+		if(actual != arguments.end())
+		{
+			auto replacement = actual->second->clone();
+
+			replacement->instruction = instruction;
+
+			ir::Operand::dispose(operand);
+
+			return replacement;
+		}
+	}
+
+	return operand;
+}
+
+/*! \brief Splice the callee's body into the caller at the call site */
+static void inlineCallSite(ir::Function& caller,
+	ir::Function::iterator block, ir::Call* call, ir::Function& callee)
+{
+	report("  inlining '" << callee.name() << "' into '"
+		<< caller.name() << "'");
+
+	// the continuation receives everything after the call
+	std::stringstream continuationName;
+
+	continuationName << block->name() << "_" << callee.name() << "_cont";
+
+	auto next = block; ++next;
+
+	auto continuation = caller.newBasicBlock(next, continuationName.str());
+
+	while(block->back() != call)
+	{
+		auto instruction = block->back();
+
+		block->pop_back();
+
+		instruction->block = &*continuation;
+
+		continuation->push_front(instruction);
+	}
+
+	// formal arguments and return slots map to the call's operands
+	ArgumentMap arguments;
+
+	auto callArguments = call->arguments();
+
+	auto formal = callee.argument_begin();
+
+	for(auto actual = callArguments.begin(); actual != callArguments.end()
+		&& formal != callee.argument_end(); ++actual, ++formal)
+	{
+		arguments[&*formal] = *actual;
+	}
+
+	auto callReturned = call->returned();
+
+	auto slot = callee.returned_begin();
+
+	for(auto actual = callReturned.begin(); actual != callReturned.end()
+		&& slot != callee.returned_end(); ++actual, ++slot)
+	{
+		arguments[&*slot] = *actual;
+	}
+
+	// fresh registers for the callee's values
+	RegisterMap registers;
+
+	for(auto value = callee.register_begin();
+		value != callee.register_end(); ++value)
+	{
+		registers[&*value] = &*caller.newVirtualRegister(value->type);
+	}
+
+	// fresh blocks, in the callee's order so fallthroughs are preserved
+	BlockMap blocks;
+
+	blocks[&*callee.exit_block()] = &*continuation;
+
+	for(auto calleeBlock = callee.begin();
+		calleeBlock != callee.end(); ++calleeBlock)
+	{
+		if(calleeBlock == callee.exit_block()) continue;
+
+		std::stringstream name;
+
+		name << callee.name() << "_" << calleeBlock->name()
+			<< "_inlined";
+
+		auto cloned = caller.newBasicBlock(continuation, name.str());
+
+		blocks[&*calleeBlock] = &*cloned;
+	}
+
+	// clone the body
+	for(auto calleeBlock = callee.begin();
+		calleeBlock != callee.end(); ++calleeBlock)
+	{
+		if(calleeBlock == callee.exit_block()) continue;
+
+		auto cloned = blocks[&*calleeBlock];
+
+		for(auto instruction : *calleeBlock)
+		{
+			if(instruction->isReturn())
+			{
+				// returns become branches to the continuation
+				auto branch = new ir::Bra(ir::Bra::UniformBranch);
+
+				branch->block = cloned;
+
+				branch->setGuard(static_cast<PredicateOperand*>(
+					remapOperand(instruction->guard()->clone(),
+						branch, registers, blocks, arguments)));
+				branch->setTarget(new AddressOperand(
+					&*continuation, branch));
+
+				cloned->push_back(branch);
+
+				continue;
+			}
+
+			auto copy = instruction->clone();
+
+			copy->block = cloned;
+
+			for(auto read = copy->reads.begin();
+				read != copy->reads.end(); ++read)
+			{
+				*read = remapOperand(*read, copy,
+					registers, blocks, arguments);
+			}
+
+			for(auto write = copy->writes.begin();
+				write != copy->writes.end(); ++write)
+			{
+				*write = remapOperand(*write, copy,
+					registers, blocks, arguments);
+			}
+
+			cloned->push_back(copy);
+		}
+	}
+
+	// drop the call, the block falls through into the inlined entry
+	for(auto read : call->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : call->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+
+	call->eraseFromBlock();
+}
+
+bool FunctionInliningPass::_inlineCallsIn(ir::Function& function,
+	const FunctionSummaryMap& summaries)
+{
+	auto callGraph = static_cast<CallGraphAnalysis*>(
+		getAnalysis("CallGraphAnalysis"));
+
+	bool changed = false;
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		// one candidate per block per sweep, splitting the block ends it
+		ir::Call*     candidateCall   = nullptr;
+		ir::Function* candidateCallee = nullptr;
+
+		for(auto instruction : *block)
+		{
+			if(!instruction->isCall())     continue;
+			if(instruction->isIntrinsic()) continue;
+
+			// only unpredicated direct calls are inlined
+			if(!instruction->guard()->isAlwaysTrue()) continue;
+
+			auto call = static_cast<ir::Call*>(instruction);
+
+			auto target = call->target();
+
+			if(target == nullptr)                      continue;
+			if(target->mode() != Operand::Address)     continue;
+
+			auto value = static_cast<AddressOperand*>(
+				target)->globalValue;
+
+			if(value == nullptr) continue;
+
+			auto callee = function.module()->getFunction(value->name());
+
+			if(callee == function.module()->end()) continue;
+			if(&*callee != value)                  continue;
+
+			if(&*callee == &function)       continue;
+			if(callee->empty())             continue;
+			if(callee->isPrototype())       continue;
+
+			if(callGraph->isRecursive(*callee)) continue;
+
+			// the decision is a summary lookup, measured exactly once
+			auto summary = summaries.find(&*callee);
+
+			if(summary == summaries.end()) continue;
+
+			if(summary->second.size > inliningThreshold) continue;
+
+			if(summary->second.registerPressure > pressureThreshold)
+			{
+				continue;
+			}
+
+			candidateCall   = call;
+			candidateCallee = &*callee;
+
+			break;
+		}
+
+		if(candidateCall == nullptr) continue;
+
+		inlineCallSite(function, block, candidateCall, *candidateCallee);
+
+		changed = true;
+	}
+
+	return changed;
+}
+
+void FunctionInliningPass::runOnModule(Module& m)
+{
+	report("Running function inlining on module '" << m.name << "'");
+
+	auto callGraph = static_cast<CallGraphAnalysis*>(
+		getAnalysis("CallGraphAnalysis"));
+	assert(callGraph != nullptr);
+
+	FunctionSummaryMap summaries;
+
+	bool changed = false;
+
+	// callees first, so every summary is final when callers read it
+	for(auto function : callGraph->getBottomUpOrder())
+	{
+		if(!function->empty())
+		{
+			changed |= _inlineCallsIn(*function, summaries);
+		}
+
+		FunctionSummary summary;
+
+		summary.registerPressure = function->register_size();
+		summary.size             = function->instruction_size();
+
+		// real pressure is only worth measuring for bodies small enough
+		// to inline, larger ones are rejected on size alone
+		if(!function->empty() && summary.size <= inliningThreshold)
+		{
+			AnalysisFactory::AnalysisMap functionAnalyses;
+
+			auto pressure = static_cast<RegisterPressureAnalysis*>(
+				AnalysisFactory::createAnalysisForFunction(
+					"RegisterPressureAnalysis", *function,
+					functionAnalyses));
+
+			summary.registerPressure = pressure->maxLive();
+
+			for(auto& analysis : functionAnalyses)
+			{
+				delete analysis.second;
+			}
+		}
+
+		summaries.insert(std::make_pair(function, summary));
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("ControlFlowGraph");
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("CallGraphAnalysis");
+	}
+}
+
+Pass* FunctionInliningPass::clone() const
+{
+	return new FunctionInliningPass;
+}
+
+}
+
+}
+
@@ -0,0 +1,220 @@
+/*! \file   GlobalDeadCodeEliminationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the GlobalDeadCodeEliminationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/GlobalDeadCodeEliminationPass.h>
+
+#include <vanaheimr/abi/interface/ApplicationBinaryInterface.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/Global.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_set>
+#include <algorithm>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef ir::Function       Function;
+typedef ir::Global         Global;
+typedef ir::Variable       Variable;
+typedef ir::Instruction    Instruction;
+typedef ir::Operand        Operand;
+typedef ir::AddressOperand AddressOperand;
+
+typedef std::unordered_set<const Variable*> VariableSet;
+typedef std::vector<Function*>              FunctionVector;
+
+GlobalDeadCodeEliminationPass::GlobalDeadCodeEliminationPass()
+: ModulePass(StringVector(), "GlobalDeadCodeEliminationPass")
+{
+
+}
+
+void GlobalDeadCodeEliminationPass::configure(const StringVector& options)
+{
+	for(auto& option : options)
+	{
+		if(option.compare(0, 5, "keep=") == 0)
+		{
+			_keptSymbols.push_back(option.substr(5));
+		}
+	}
+}
+
+/*! \brief Mark every function and global the function references,
+	queueing newly discovered functions for their own scan */
+static void markReferences(Function& function, const VariableSet& functions,
+	const VariableSet& globals, VariableSet& live, FunctionVector& worklist)
+{
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto operand : instruction->reads)
+			{
+				if(operand == nullptr)                   continue;
+				if(operand->mode() != Operand::Address)  continue;
+
+				auto target = static_cast<AddressOperand*>(
+					operand)->globalValue;
+
+				if(target == nullptr)            continue;
+				if(live.count(target) != 0)      continue;
+
+				// basic blocks are variables too, skip their labels
+				if(functions.count(target) != 0)
+				{
+					live.insert(target);
+
+					worklist.push_back(static_cast<Function*>(target));
+				}
+				else if(globals.count(target) != 0)
+				{
+					live.insert(target);
+				}
+			}
+		}
+	}
+}
+
+void GlobalDeadCodeEliminationPass::runOnModule(Module& m)
+{
+	report("Running global dead code elimination on '" << m.name << "'");
+
+	VariableSet functions;
+	VariableSet globals;
+
+	for(auto function = m.begin(); function != m.end(); ++function)
+	{
+		functions.insert(&*function);
+	}
+
+	for(auto global = m.global_begin(); global != m.global_end(); ++global)
+	{
+		globals.insert(&*global);
+	}
+
+	VariableSet    live;
+	FunctionVector worklist;
+
+	for(auto function = m.begin(); function != m.end(); ++function)
+	{
+		bool kept = std::find(_keptSymbols.begin(), _keptSymbols.end(),
+			function->name()) != _keptSymbols.end();
+
+		if(function->hasAttribute("kernel") || kept)
+		{
+			report(" rooting kernel '" << function->name() << "'");
+
+			live.insert(&*function);
+
+			worklist.push_back(&*function);
+		}
+	}
+
+	if(worklist.empty())
+	{
+		// a module with no entry points is a library, anything in it
+		// may still be referenced by a later link
+		report(" no kernel entry points, leaving the module alone");
+
+		return;
+	}
+
+	auto abi = abi::ApplicationBinaryInterface::getABI("archaeopteryx");
+
+	for(auto global = m.global_begin(); global != m.global_end(); ++global)
+	{
+		// the simulator binds ABI variables by name, a reference can
+		// appear from outside the module
+		bool bound = abi != nullptr &&
+			abi->findVariable(global->name()) != nullptr;
+
+		bool kept = std::find(_keptSymbols.begin(), _keptSymbols.end(),
+			global->name()) != _keptSymbols.end();
+
+		if(bound || kept)
+		{
+			live.insert(&*global);
+		}
+	}
+
+	while(!worklist.empty())
+	{
+		auto function = worklist.back();
+
+		worklist.pop_back();
+
+		markReferences(*function, functions, globals, live, worklist);
+	}
+
+	unsigned int removedFunctions = 0;
+	unsigned int removedGlobals   = 0;
+
+	for(auto function = m.begin(); function != m.end(); )
+	{
+		if(live.count(&*function) == 0)
+		{
+			report(" removing function '" << function->name() << "'");
+
+			function = m.removeFunction(function);
+
+			++removedFunctions;
+		}
+		else
+		{
+			++function;
+		}
+	}
+
+	for(auto global = m.global_begin(); global != m.global_end(); )
+	{
+		if(live.count(&*global) == 0)
+		{
+			report(" removing global '" << global->name() << "'");
+
+			global = m.removeGlobal(global);
+
+			++removedGlobals;
+		}
+		else
+		{
+			++global;
+		}
+	}
+
+	report(" removed " << removedFunctions << " functions and "
+		<< removedGlobals << " globals");
+}
+
+Pass* GlobalDeadCodeEliminationPass::clone() const
+{
+	return new GlobalDeadCodeEliminationPass(*this);
+}
+
+}
+
+}
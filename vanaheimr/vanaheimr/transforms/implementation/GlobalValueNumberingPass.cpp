@@ -0,0 +1,364 @@
+/*! \file   GlobalValueNumberingPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the GlobalValueNumberingPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/GlobalValueNumberingPass.h>
+
+#include <vanaheimr/analysis/interface/DominatorAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+#include <vanaheimr/util/interface/ScopedHashTable.h>
+#include <vanaheimr/util/interface/SmallVector.h>
+#include <vanaheimr/util/interface/Arena.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <vector>
+#include <cstdint>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::DominatorAnalysis DominatorAnalysis;
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::Instruction     Instruction;
+typedef ir::Operand         Operand;
+typedef ir::RegisterOperand RegisterOperand;
+typedef ir::VirtualRegister VirtualRegister;
+
+/*! \brief A flat word array describing one computation, the words live
+	in an arena owned by the pass */
+class Expression
+{
+public:
+	const uint64_t* words;
+	unsigned int    size;
+};
+
+class ExpressionHash
+{
+public:
+	size_t operator()(const Expression& expression) const
+	{
+		// FNV-1a over the words
+		uint64_t hash = 14695981039346656037ull;
+
+		for(unsigned int w = 0; w != expression.size; ++w)
+		{
+			hash ^= expression.words[w];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+};
+
+class ExpressionEqual
+{
+public:
+	bool operator()(const Expression& left, const Expression& right) const
+	{
+		if(left.size != right.size) return false;
+
+		for(unsigned int w = 0; w != left.size; ++w)
+		{
+			if(left.words[w] != right.words[w]) return false;
+		}
+
+		return true;
+	}
+};
+
+typedef util::ScopedHashTable<Expression, VirtualRegister*,
+	ExpressionHash, ExpressionEqual> ValueTable;
+
+typedef util::SmallVector<uint64_t, 16>  WordVector;
+typedef std::vector<VirtualRegister*>    VirtualRegisterVector;
+typedef std::vector<RegisterOperand*>    RegisterOperandVector;
+
+class ValueNumberingState
+{
+public:
+	ValueTable            table;
+	util::Arena*          arena;
+	VirtualRegisterVector leaders; // indexed by register id
+	DominatorAnalysis*    dominators;
+	unsigned int          removedCount;
+};
+
+static VirtualRegister* leaderOf(ValueNumberingState& state,
+	VirtualRegister* virtualRegister)
+{
+	if(virtualRegister->id >= state.leaders.size()) return virtualRegister;
+
+	auto leader = state.leaders[virtualRegister->id];
+
+	return leader == nullptr ? virtualRegister : leader;
+}
+
+static bool isCommutative(Instruction::Opcode opcode)
+{
+	switch(opcode)
+	{
+	case Instruction::Add:  // fall through
+	case Instruction::And:  // fall through
+	case Instruction::Fmul: // fall through
+	case Instruction::Mul:  // fall through
+	case Instruction::Or:   // fall through
+	case Instruction::Xor:  return true;
+	default:                return false;
+	}
+}
+
+/*! \brief Encode the computation as words, false if it has operands
+	value numbering cannot reason about */
+static bool buildExpression(WordVector& words, ValueNumberingState& state,
+	Instruction& instruction)
+{
+	enum
+	{
+		RegisterTag  = 1,
+		ImmediateTag = 2
+	};
+
+	words.clear();
+
+	words.push_back(instruction.opcode);
+
+	// the result type distinguishes conversions with identical inputs
+	words.push_back(reinterpret_cast<uint64_t>(
+		instruction.writes[0]->type()));
+
+	// skip the guard, reads[0], eligible instructions are unpredicated
+	for(unsigned int read = 1; read < instruction.reads.size(); ++read)
+	{
+		auto operand = instruction.reads[read];
+
+		if(operand->isRegister() &&
+			operand->mode() != Operand::Predicate &&
+			operand->mode() != Operand::Indirect)
+		{
+			auto virtualRegister = leaderOf(state,
+				static_cast<RegisterOperand*>(operand)->virtualRegister);
+
+			words.push_back(RegisterTag);
+			words.push_back(virtualRegister->id);
+		}
+		else if(operand->isImmediate())
+		{
+			words.push_back(ImmediateTag);
+			words.push_back(static_cast<ir::ImmediateOperand*>(
+				operand)->uint);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// canonicalize commutative operations
+	if(words.size() == 6 && isCommutative(instruction.opcode))
+	{
+		if(words[4] < words[2] ||
+			(words[4] == words[2] && words[5] < words[3]))
+		{
+			std::swap(words[2], words[4]);
+			std::swap(words[3], words[5]);
+		}
+	}
+
+	return true;
+}
+
+static bool isEligible(const Instruction& instruction)
+{
+	if(instruction.isBranch())        return false;
+	if(instruction.isLoad())          return false;
+	if(instruction.isStore())         return false;
+	if(instruction.isCall())          return false;
+	if(instruction.isReturn())        return false;
+	if(instruction.isMemoryBarrier()) return false;
+	if(instruction.isIntrinsic())     return false;
+	if(instruction.isPhi())           return false;
+	if(instruction.isPsi())           return false;
+
+	if(!instruction.guard()->isAlwaysTrue()) return false;
+
+	if(instruction.writes.size() != 1)     return false;
+	if(!instruction.writes[0]->isRegister()) return false;
+
+	return static_cast<const RegisterOperand*>(
+		instruction.writes[0])->virtualRegister != nullptr;
+}
+
+static void replaceWithLeader(ValueNumberingState& state,
+	Instruction* instruction, VirtualRegister* leader)
+{
+	auto defined = static_cast<RegisterOperand*>(
+		instruction->writes[0])->virtualRegister;
+
+	report("  replacing '" << instruction->toString()
+		<< "' with leader r" << leader->id);
+
+	if(defined->id < state.leaders.size())
+	{
+		state.leaders[defined->id] = leader;
+	}
+
+	// collect first, retargeting relinks the use chain
+	RegisterOperandVector uses;
+
+	for(auto use = defined->firstUse(); use != nullptr; use = use->nextUse())
+	{
+		if(use->instruction == instruction) continue;
+
+		uses.push_back(use);
+	}
+
+	for(auto use : uses)
+	{
+		use->setVirtualRegister(leader);
+	}
+
+	// unlink explicitly, arena-allocated instructions defer destructors
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+
+	instruction->eraseFromBlock();
+
+	++state.removedCount;
+}
+
+static void numberBlock(ValueNumberingState& state, BasicBlock& block)
+{
+	state.table.pushScope();
+
+	report(" visiting block '" << block.name() << "'");
+
+	WordVector words;
+
+	// snapshot, redundant instructions are erased while walking
+	std::vector<Instruction*> instructions(block.begin(), block.end());
+
+	for(auto instruction : instructions)
+	{
+		if(!isEligible(*instruction)) continue;
+
+		if(!buildExpression(words, state, *instruction)) continue;
+
+		Expression key{words.data(), (unsigned int)words.size()};
+
+		auto existing = state.table.lookup(key);
+
+		if(existing != nullptr)
+		{
+			replaceWithLeader(state, instruction, *existing);
+
+			continue;
+		}
+
+		// first sighting, key words move into the arena
+		auto stable = static_cast<uint64_t*>(state.arena->allocate(
+			sizeof(uint64_t) * words.size(), alignof(uint64_t)));
+
+		for(unsigned int w = 0; w != words.size(); ++w)
+		{
+			stable[w] = words[w];
+		}
+
+		state.table.insert(Expression{stable, key.size},
+			static_cast<RegisterOperand*>(
+				instruction->writes[0])->virtualRegister);
+	}
+
+	// children in the dominator tree see this block's expressions
+	auto children = state.dominators->getDominatedBlocks(block);
+
+	for(auto child : children)
+	{
+		if(child == &block) continue;
+
+		numberBlock(state, *child);
+	}
+
+	state.table.popScope();
+}
+
+GlobalValueNumberingPass::GlobalValueNumberingPass()
+: FunctionPass(StringVector({"DominatorAnalysis"}),
+  "GlobalValueNumberingPass")
+{
+
+}
+
+void GlobalValueNumberingPass::runOnFunction(Function& f)
+{
+	if(f.empty()) return;
+
+	report("Running global value numbering on function '" << f.name() << "'");
+
+	ValueNumberingState state;
+
+	// prefer the manager-owned scratch arena, it is presized from the
+	// high-water mark of previous runs of this pass
+	util::Arena localArena;
+
+	state.arena = scratch() != nullptr ? scratch() : &localArena;
+
+	state.dominators = static_cast<DominatorAnalysis*>(
+		getAnalysis("DominatorAnalysis"));
+	state.leaders.assign(f.register_size(), nullptr);
+	state.removedCount = 0;
+
+	numberBlock(state, *f.entry_block());
+
+	report(" removed " << state.removedCount
+		<< " redundant instructions");
+
+	if(state.removedCount != 0)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+	}
+}
+
+Pass* GlobalValueNumberingPass::clone() const
+{
+	return new GlobalValueNumberingPass;
+}
+
+}
+
+}
+
@@ -0,0 +1,415 @@
+/*! \file   IfConversionPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the IfConversionPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/IfConversionPass.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+#include <vanaheimr/analysis/interface/ThreadFrontierAnalysis.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdlib>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::ControlFlowGraph       ControlFlowGraph;
+typedef analysis::ThreadFrontierAnalysis ThreadFrontierAnalysis;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+typedef ir::Function         Function;
+
+typedef std::unordered_map<const BasicBlock*,
+	Function::iterator> BlockIteratorMap;
+typedef std::unordered_set<const BasicBlock*> BlockSet;
+
+IfConversionPass::IfConversionPass()
+: FunctionPass(StringVector({"ControlFlowGraph",
+	"ThreadFrontierAnalysis"}), "IfConversionPass"), _maxLegSize(4)
+{
+
+}
+
+void IfConversionPass::configure(const StringVector& options)
+{
+	for(auto& option : options)
+	{
+		if(option.compare(0, 5, "size=") == 0)
+		{
+			_maxLegSize = std::atoi(option.c_str() + 5);
+		}
+	}
+}
+
+static ir::Bra* getBranch(BasicBlock* block)
+{
+	auto terminator = block->terminator();
+
+	if(terminator == nullptr)              return nullptr;
+	if(!terminator->isBranch())            return nullptr;
+	if(terminator->isCall())               return nullptr;
+	if(terminator->isMachineInstruction()) return nullptr;
+
+	return static_cast<ir::Bra*>(terminator);
+}
+
+static bool hasPhis(Function& function)
+{
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		if(block->empty()) continue;
+
+		if((*block->begin())->isPhi()) return true;
+	}
+
+	return false;
+}
+
+/*! \brief Can every instruction of the leg take a guard, leaving the
+	trailing unconditional branch alone? */
+static bool isPredicable(BasicBlock* leg, const VirtualRegister* predicate,
+	unsigned int maxSize)
+{
+	if(leg->size() > maxSize) return false;
+
+	for(auto instruction : *leg)
+	{
+		if(instruction->isBranch())
+		{
+			// only a trailing unconditional branch to the join survives
+			if(instruction != leg->terminator())   return false;
+			if(instruction->isCall())              return false;
+
+			auto branch = static_cast<ir::Bra*>(instruction);
+
+			if(!branch->isUnconditional()) return false;
+
+			continue;
+		}
+
+		if(instruction->isReturn())             return false;
+		if(instruction->isPhi())                return false;
+		if(instruction->isPsi())                return false;
+		if(instruction->isMemoryBarrier())      return false;
+		if(instruction->isMachineInstruction()) return false;
+
+		if(instruction->opcode == Instruction::Launch) return false;
+
+		// an existing guard would need to be anded with the predicate
+		if(instruction->guard() == nullptr)       return false;
+		if(!instruction->guard()->isAlwaysTrue()) return false;
+
+		// redefining the predicate would change the guards downstream
+		for(auto write : instruction->writes)
+		{
+			if(write == nullptr || !write->isRegister()) continue;
+
+			if(static_cast<RegisterOperand*>(
+				write)->virtualRegister == predicate)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*! \brief Guard every instruction of the leg except a trailing branch */
+static void predicateBlock(BasicBlock* leg, VirtualRegister* predicate,
+	PredicateOperand::PredicateModifier modifier)
+{
+	for(auto instruction : *leg)
+	{
+		if(instruction->isBranch()) continue;
+
+		instruction->setGuard(new PredicateOperand(
+			predicate, modifier, instruction));
+	}
+}
+
+/*! \brief The unique successor of a leg, nullptr when there are many */
+static BasicBlock* getSingleSuccessor(BasicBlock* block,
+	ControlFlowGraph* cfg)
+{
+	auto successors = cfg->getSuccessors(*block);
+
+	if(successors.size() != 1) return nullptr;
+
+	return *successors.begin();
+}
+
+class Candidate
+{
+public:
+	BasicBlock* head;
+	BasicBlock* fallthrough; // the leg guarded with the inverse
+	BasicBlock* taken;       // the branch target, nullptr for triangles
+	BasicBlock* join;
+};
+
+typedef std::vector<Candidate> CandidateVector;
+
+/*! \brief Apply one conversion, folding the legs into the head */
+static void convert(Function& f, const Candidate& candidate,
+	ControlFlowGraph* cfg, BlockIteratorMap& iterators)
+{
+	auto head = candidate.head;
+
+	auto branch = getBranch(head);
+
+	auto predicate = branch->guard()->virtualRegister;
+	auto modifier  = branch->guard()->modifier;
+
+	auto inverse = modifier == PredicateOperand::StraightPredicate
+		? PredicateOperand::InversePredicate
+		: PredicateOperand::StraightPredicate;
+
+	// the fallthrough leg runs when the branch is not taken
+	predicateBlock(candidate.fallthrough, predicate, inverse);
+
+	if(candidate.taken != nullptr)
+	{
+		predicateBlock(candidate.taken, predicate, modifier);
+	}
+
+	// the conditional branch is subsumed by the guards
+	for(auto read : branch->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	head->erase(branch);
+
+	auto fallthrough = iterators.find(candidate.fallthrough)->second;
+
+	head->splice(head->end(), *fallthrough);
+
+	cfg->removeEdge(head, candidate.fallthrough);
+	cfg->removeEdge(candidate.fallthrough, candidate.join);
+
+	if(candidate.taken != nullptr)
+	{
+		// the fallthrough leg's branch to the join is subsumed by the
+		// taken leg's, which becomes the new terminator
+		auto trailing = getBranch(head);
+
+		if(trailing != nullptr) head->erase(trailing);
+
+		auto taken = iterators.find(candidate.taken)->second;
+
+		head->splice(head->end(), *taken);
+
+		cfg->removeEdge(head, candidate.taken);
+		cfg->removeEdge(candidate.taken, candidate.join);
+
+		cfg->addEdge(head, candidate.join);
+
+		iterators.erase(candidate.taken);
+
+		f.erase(taken);
+	}
+
+	iterators.erase(candidate.fallthrough);
+
+	f.erase(fallthrough);
+}
+
+void IfConversionPass::runOnFunction(Function& f)
+{
+	// guards cannot express the value selection phis perform
+	if(hasPhis(f)) return;
+
+	report("Running if-conversion on '" << f.name() << "'");
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto frontiers = static_cast<ThreadFrontierAnalysis*>(
+		getAnalysis("ThreadFrontierAnalysis"));
+	assert(frontiers != nullptr);
+
+	BlockIteratorMap iterators;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		iterators[&*block] = block;
+	}
+
+	// gather first, the conversions invalidate the frontier tables
+	CandidateVector candidates;
+
+	BlockSet claimed;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		auto head = &*block;
+
+		auto branch = getBranch(head);
+
+		if(branch == nullptr)            continue;
+		if(branch->isUnconditional())    continue;
+
+		auto guard = branch->guard();
+
+		if(guard == nullptr)                  continue;
+		if(guard->virtualRegister == nullptr) continue;
+
+		if(guard->modifier != PredicateOperand::StraightPredicate &&
+			guard->modifier != PredicateOperand::InversePredicate)
+		{
+			continue;
+		}
+
+		auto next = block; ++next;
+
+		if(next == f.end()) continue;
+
+		auto taken       = branch->targetBasicBlock();
+		auto fallthrough = &*next;
+
+		if(taken == nullptr)            continue;
+		if(taken == fallthrough)        continue;
+		if(taken == head)               continue;
+		if(fallthrough == &*f.exit_block()) continue;
+
+		// the fallthrough leg must belong to this branch alone
+		if(cfg->getPredecessors(*fallthrough).size() != 1) continue;
+
+		auto join = getSingleSuccessor(fallthrough, cfg);
+
+		if(join == nullptr) continue;
+
+		Candidate candidate;
+
+		candidate.head        = head;
+		candidate.fallthrough = fallthrough;
+		candidate.join        = join;
+
+		if(taken == join)
+		{
+			// a triangle, the branch skips the fallthrough leg
+			candidate.taken = nullptr;
+		}
+		else
+		{
+			// a diamond, the legs must rejoin and the taken leg must
+			// branch back explicitly since its copy lands off its
+			// fallthrough position
+			if(cfg->getPredecessors(*taken).size() != 1)    continue;
+			if(getSingleSuccessor(taken, cfg) != join)      continue;
+
+			auto takenBranch = getBranch(taken);
+
+			if(takenBranch == nullptr)                      continue;
+			if(!takenBranch->isUnconditional())             continue;
+			if(takenBranch->targetBasicBlock() != join)     continue;
+
+			if(!isPredicable(taken, guard->virtualRegister,
+				_maxLegSize))
+			{
+				continue;
+			}
+
+			if(frontiers->isInThreadFrontier(*fallthrough, *taken) ||
+				frontiers->isInThreadFrontier(*taken, *fallthrough))
+			{
+				// the legs can leave threads waiting on each other
+			}
+			else continue;
+		}
+
+		if(!isPredicable(fallthrough, guard->virtualRegister,
+			_maxLegSize))
+		{
+			continue;
+		}
+
+		if(candidate.taken == nullptr)
+		{
+			// divergence only costs when the join waits on the leg
+			if(!frontiers->isInThreadFrontier(*fallthrough, *join))
+			{
+				continue;
+			}
+		}
+
+		// conversions must not share blocks, later ones see stale shapes
+		if(claimed.count(head) != 0)        continue;
+		if(claimed.count(fallthrough) != 0) continue;
+		if(claimed.count(join) != 0)        continue;
+
+		if(candidate.taken != nullptr &&
+			claimed.count(candidate.taken) != 0)
+		{
+			continue;
+		}
+
+		claimed.insert(head);
+		claimed.insert(fallthrough);
+		claimed.insert(join);
+
+		if(candidate.taken != nullptr) claimed.insert(candidate.taken);
+
+		report(" converting " << (candidate.taken == nullptr
+			? "triangle" : "diamond") << " at '" << head->name()
+			<< "', join '" << join->name() << "'");
+
+		candidates.push_back(candidate);
+	}
+
+	for(auto& candidate : candidates)
+	{
+		convert(f, candidate, cfg, iterators);
+	}
+
+	if(!candidates.empty())
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DominatorAnalysis");
+		invalidateAnalysis("PostDominatorAnalysis");
+		invalidateAnalysis("LoopAnalysis");
+		invalidateAnalysis("ThreadFrontierAnalysis");
+		invalidateAnalysis("DependenceAnalysis");
+	}
+}
+
+Pass* IfConversionPass::clone() const
+{
+	return new IfConversionPass(*this);
+}
+
+}
+
+}
@@ -0,0 +1,360 @@
+/*! \file   LoopInvariantCodeMotionPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LoopInvariantCodeMotionPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/LoopInvariantCodeMotionPass.h>
+
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+#include <vanaheimr/analysis/interface/AliasAnalysis.h>
+#include <vanaheimr/analysis/interface/DataflowAnalysis.h>
+#include <vanaheimr/analysis/interface/RegisterPressureAnalysis.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::LoopAnalysis             LoopAnalysis;
+typedef analysis::AliasAnalysis            AliasAnalysis;
+typedef analysis::DataflowAnalysis         DataflowAnalysis;
+typedef analysis::RegisterPressureAnalysis RegisterPressureAnalysis;
+typedef analysis::ControlFlowGraph         ControlFlowGraph;
+
+typedef LoopAnalysis::Loop Loop;
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::Instruction     Instruction;
+typedef ir::RegisterOperand RegisterOperand;
+typedef ir::VirtualRegister VirtualRegister;
+typedef ir::Function        Function;
+
+typedef std::unordered_map<const VirtualRegister*,
+	unsigned int> WriteCountMap;
+typedef std::vector<Loop*> LoopVector;
+typedef std::vector<const Instruction*> InstructionVector;
+
+LoopInvariantCodeMotionPass::LoopInvariantCodeMotionPass()
+: FunctionPass(StringVector({"LoopAnalysis", "AliasAnalysis",
+	"DataflowAnalysis", "RegisterPressureAnalysis", "ControlFlowGraph"}),
+	"LoopInvariantCodeMotionPass"), _pressureLimit(48)
+{
+
+}
+
+void LoopInvariantCodeMotionPass::configure(const StringVector& options)
+{
+	for(auto& option : options)
+	{
+		if(option.compare(0, 9, "pressure=") == 0)
+		{
+			_pressureLimit = std::atoi(option.c_str() + 9);
+		}
+	}
+}
+
+/*! \brief The unique out of loop predecessor of the header, it must
+	branch nowhere else so hoisted code only runs entering the loop */
+static BasicBlock* getPreheader(Loop& loop, ControlFlowGraph* cfg)
+{
+	BasicBlock* preheader = nullptr;
+
+	auto predecessors = cfg->getPredecessors(*loop.header);
+
+	for(auto predecessor : predecessors)
+	{
+		if(loop.contains(predecessor)) continue;
+
+		if(preheader != nullptr) return nullptr;
+
+		preheader = predecessor;
+	}
+
+	if(preheader == nullptr) return nullptr;
+
+	if(cfg->getSuccessors(*preheader).size() != 1) return nullptr;
+
+	return preheader;
+}
+
+/*! \brief Free of side effects and faults, safe to execute early */
+static bool isPure(const Instruction& instruction)
+{
+	if(instruction.isBranch())             return false;
+	if(instruction.isReturn())             return false;
+	if(instruction.isPhi())                return false;
+	if(instruction.isPsi())                return false;
+	if(instruction.accessesMemory())       return false;
+	if(instruction.isMemoryBarrier())      return false;
+	if(instruction.isMachineInstruction()) return false;
+
+	if(instruction.opcode == Instruction::Launch) return false;
+
+	return true;
+}
+
+/*! \brief Can any store in the loop touch the bytes the load reads? */
+static bool isLoadClobbered(const Instruction& load, const Loop& loop,
+	const AliasAnalysis* aliases)
+{
+	for(auto block : loop.blocks)
+	{
+		for(auto instruction : *block)
+		{
+			// calls and barriers clobber everything
+			if(instruction->isCall())          return true;
+			if(instruction->isMemoryBarrier()) return true;
+
+			if(!instruction->isStore()) continue;
+
+			if(aliases->alias(load, *instruction) !=
+				AliasAnalysis::NoAlias)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool isInvariant(const Instruction& instruction, const Loop& loop,
+	const WriteCountMap& writes,
+	const DataflowAnalysis::VirtualRegisterSet& headerLiveIns,
+	const AliasAnalysis* aliases)
+{
+	if(instruction.isLoad())
+	{
+		// a load is only known to execute, and to see the same bytes
+		// every iteration, from the header of a store free loop
+		if(instruction.block != loop.header) return false;
+
+		if(isLoadClobbered(instruction, loop, aliases)) return false;
+	}
+	else if(!isPure(instruction))
+	{
+		return false;
+	}
+
+	// a guarded instruction may not execute at all
+	if(instruction.guard() == nullptr)        return false;
+	if(!instruction.guard()->isAlwaysTrue())  return false;
+
+	for(auto read : instruction.reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		auto reg = static_cast<const RegisterOperand*>(
+			read)->virtualRegister;
+
+		if(reg == nullptr) continue;
+
+		if(writes.count(reg) != 0) return false;
+	}
+
+	for(auto write : instruction.writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		auto reg = static_cast<const RegisterOperand*>(
+			write)->virtualRegister;
+
+		if(reg == nullptr) return false;
+
+		// another definition in the loop would be reordered past this
+		// one, a live in value would be clobbered before its last read
+		auto count = writes.find(reg);
+
+		if(count == writes.end() || count->second != 1) return false;
+
+		if(headerLiveIns.count(const_cast<VirtualRegister*>(reg)) != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*! \brief Hoist what this loop allows, the budget shrinks as hoisted
+	values stretch their live ranges across the loop body */
+static bool hoistFromLoop(Loop& loop, ControlFlowGraph* cfg,
+	const AliasAnalysis* aliases, DataflowAnalysis* dfg,
+	unsigned int budget)
+{
+	auto preheader = getPreheader(loop, cfg);
+
+	if(preheader == nullptr) return false;
+
+	report(" loop with header '" << loop.header->name()
+		<< "', preheader '" << preheader->name()
+		<< "', budget " << budget);
+
+	auto headerLiveIns = dfg->getLiveIns(*loop.header);
+
+	WriteCountMap writes;
+
+	for(auto block : loop.blocks)
+	{
+		for(auto instruction : *block)
+		{
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr || !write->isRegister()) continue;
+
+				auto reg = static_cast<const RegisterOperand*>(
+					write)->virtualRegister;
+
+				if(reg != nullptr) ++writes[reg];
+			}
+		}
+	}
+
+	bool hoisted = false;
+
+	// hoisting a definition can free up its dependents, sweep until a
+	// round moves nothing
+	bool changed = true;
+
+	while(changed && budget != 0)
+	{
+		changed = false;
+
+		for(auto block : loop.blocks)
+		{
+			auto instruction = block->begin();
+
+			while(instruction != block->end() && budget != 0)
+			{
+				auto next = instruction; ++next;
+
+				if(isInvariant(**instruction, loop, writes,
+					headerLiveIns, aliases))
+				{
+					report("  hoisting '" << (*instruction)->toString()
+						<< "' from block '" << block->name() << "'");
+
+					auto position = preheader->end();
+
+					if(preheader->terminator() != nullptr) --position;
+
+					for(auto write : (*instruction)->writes)
+					{
+						if(write == nullptr ||
+							!write->isRegister()) continue;
+
+						auto reg = static_cast<const RegisterOperand*>(
+							write)->virtualRegister;
+
+						if(reg != nullptr) writes.erase(reg);
+					}
+
+					preheader->splice(position, *block, instruction);
+
+					--budget;
+
+					changed = true;
+					hoisted = true;
+				}
+
+				instruction = next;
+			}
+		}
+	}
+
+	return hoisted;
+}
+
+void LoopInvariantCodeMotionPass::runOnFunction(Function& f)
+{
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	if(loops->empty()) return;
+
+	report("Running loop invariant code motion on '" << f.name() << "'");
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto aliases = static_cast<const AliasAnalysis*>(
+		getAnalysis("AliasAnalysis"));
+	assert(aliases != nullptr);
+
+	auto dfg = static_cast<DataflowAnalysis*>(
+		getAnalysis("DataflowAnalysis"));
+	assert(dfg != nullptr);
+
+	auto pressure = static_cast<RegisterPressureAnalysis*>(
+		getAnalysis("RegisterPressureAnalysis"));
+	assert(pressure != nullptr);
+
+	LoopVector loopOrder;
+
+	for(auto& loop : *loops)
+	{
+		loopOrder.push_back(&loop);
+	}
+
+	// innermost first, their invariants bubble outward a level at a time
+	std::sort(loopOrder.begin(), loopOrder.end(),
+		[](const Loop* left, const Loop* right)
+		{
+			return left->depth() > right->depth();
+		});
+
+	bool changed = false;
+
+	for(auto loop : loopOrder)
+	{
+		unsigned int live = pressure->maxLiveInBlock(*loop->header);
+
+		if(live >= _pressureLimit) continue;
+
+		changed |= hoistFromLoop(*loop, cfg, aliases, dfg,
+			_pressureLimit - live);
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DependenceAnalysis");
+		invalidateAnalysis("LiveRangeAnalysis");
+		invalidateAnalysis("RegisterPressureAnalysis");
+	}
+}
+
+Pass* LoopInvariantCodeMotionPass::clone() const
+{
+	return new LoopInvariantCodeMotionPass(*this);
+}
+
+}
+
+}
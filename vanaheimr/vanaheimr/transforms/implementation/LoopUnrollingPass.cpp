@@ -0,0 +1,627 @@
+/*! \file   LoopUnrollingPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the LoopUnrollingPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/LoopUnrollingPass.h>
+
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+#include <vanaheimr/analysis/interface/RegisterPressureAnalysis.h>
+
+#include <vanaheimr/machine/interface/MachineModel.h>
+
+#include <vanaheimr/compiler/interface/Compiler.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <vector>
+#include <sstream>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::LoopAnalysis             LoopAnalysis;
+typedef analysis::RegisterPressureAnalysis RegisterPressureAnalysis;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+
+typedef std::unordered_map<VirtualRegister*, VirtualRegister*> ValueMap;
+typedef std::vector<Instruction*>                              InstructionVector;
+
+UnrollCostModel::UnrollCostModel(const machine::MachineModel* machine)
+: maxUnrolledSize(256), maxUnrollFactor(8), registerBudget(64)
+{
+	// small register files cannot hold the extra live ranges
+	if(machine != nullptr && machine->totalRegisterCount() < 64)
+	{
+		maxUnrollFactor = 4;
+	}
+
+	if(machine != nullptr)
+	{
+		registerBudget = machine->totalRegisterCount();
+	}
+}
+
+unsigned int UnrollCostModel::selectUnrollFactor(unsigned int bodySize,
+	uint64_t tripCount, unsigned int bodyPressure) const
+{
+	if(bodySize == 0) return 1;
+
+	// unrolling multiplies the live ranges, stay under the register file
+	uint64_t pressureLimit = maxUnrollFactor;
+
+	if(bodyPressure != 0)
+	{
+		pressureLimit = registerBudget / bodyPressure;
+
+		if(pressureLimit < 1) pressureLimit = 1;
+	}
+
+	if(tripCount != 0 && tripCount * bodySize <= maxUnrolledSize &&
+		tripCount <= pressureLimit)
+	{
+		return tripCount;
+	}
+
+	unsigned int largestFactor = maxUnrollFactor;
+
+	if(pressureLimit < largestFactor) largestFactor = pressureLimit;
+
+	for(unsigned int factor = largestFactor; factor > 1; --factor)
+	{
+		if(factor * bodySize > maxUnrolledSize) continue;
+
+		if(tripCount != 0 && tripCount % factor != 0) continue;
+
+		return factor;
+	}
+
+	return 1;
+}
+
+/*! \brief One phi cycling a value around the loop back edge */
+class PhiCycle
+{
+public:
+	ir::Phi*          phi;
+	VirtualRegister*  destination;
+	RegisterOperand*  latchOperand;
+	ir::AddressOperand* latchBlockOperand;
+	VirtualRegister*  latchSource;
+	VirtualRegister*  initialSource;
+};
+
+typedef std::vector<PhiCycle> PhiCycleVector;
+
+/*! \brief One use of a loop value from outside the loop */
+class OutsideUse
+{
+public:
+	RegisterOperand* operand;
+	VirtualRegister* value;
+	bool             isPhiDestination;
+};
+
+typedef std::vector<OutsideUse> OutsideUseVector;
+
+static VirtualRegister* lookup(const ValueMap& values, VirtualRegister* value)
+{
+	auto mapped = values.find(value);
+
+	return mapped == values.end() ? value : mapped->second;
+}
+
+static void unlinkAndErase(BasicBlock* block, Instruction* instruction)
+{
+	// unlink explicitly, arena-allocated instructions defer destructors
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+
+	instruction->eraseFromBlock();
+}
+
+/*! \brief Clone one body instruction, remapping reads and defining
+	fresh registers for the writes */
+static Instruction* cloneInstruction(ir::Function& f,
+	Instruction* instruction, ValueMap& values)
+{
+	auto copy = instruction->clone();
+
+	for(auto read : copy->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		auto registerOperand = static_cast<RegisterOperand*>(read);
+
+		if(registerOperand->virtualRegister == nullptr) continue;
+
+		auto mapped = values.find(registerOperand->virtualRegister);
+
+		if(mapped == values.end()) continue;
+
+		registerOperand->setVirtualRegister(mapped->second);
+	}
+
+	for(auto write : copy->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		auto registerOperand = static_cast<RegisterOperand*>(write);
+
+		if(registerOperand->virtualRegister == nullptr) continue;
+
+		auto fresh = &*f.newVirtualRegister(
+			registerOperand->virtualRegister->type);
+
+		values[registerOperand->virtualRegister] = fresh;
+
+		registerOperand->setVirtualRegister(fresh);
+	}
+
+	return copy;
+}
+
+/*! \brief Advance the phi values into the next unrolled iteration */
+static void advancePhis(const PhiCycleVector& cycles, ValueMap& values,
+	ValueMap& lastPhiInputs)
+{
+	// read every input before writing any, phis swap in parallel
+	ValueMap nextInputs;
+
+	for(auto& cycle : cycles)
+	{
+		nextInputs[cycle.destination] = lookup(values, cycle.latchSource);
+	}
+
+	for(auto& cycle : cycles)
+	{
+		auto input = nextInputs[cycle.destination];
+
+		values[cycle.destination]        = input;
+		lastPhiInputs[cycle.destination] = input;
+	}
+}
+
+/*! \brief Retarget uses of loop values from outside the loop at the
+	values of the final iteration */
+static void fixupOutsideUses(const OutsideUseVector& uses,
+	const ValueMap& values, const ValueMap& lastPhiInputs)
+{
+	for(auto& use : uses)
+	{
+		auto replacement = use.isPhiDestination
+			? lookup(lastPhiInputs, use.value)
+			: lookup(values, use.value);
+
+		if(replacement == use.value) continue;
+
+		use.operand->setVirtualRegister(replacement);
+	}
+}
+
+/*! \brief Unroll a counted single-block loop in place.  The interior
+	exit tests are elided, legal because the factor divides the trip
+	count, full unrolls also erase the phis and the branch */
+static void unrollCountedLoop(ir::Function& f, BasicBlock* header,
+	const PhiCycleVector& cycles, const InstructionVector& body,
+	ir::Bra* terminator, const OutsideUseVector& outsideUses,
+	unsigned int factor, bool full)
+{
+	ValueMap values;
+	ValueMap lastPhiInputs;
+
+	for(unsigned int copy = 2; copy <= factor; ++copy)
+	{
+		advancePhis(cycles, values, lastPhiInputs);
+
+		for(auto instruction : body)
+		{
+			auto clone = cloneInstruction(f, instruction, values);
+
+			header->insert(terminator, clone);
+		}
+	}
+
+	if(full)
+	{
+		// the loop is straight line code now, phis become copies of
+		// their loop entry values and the back edge disappears
+		for(auto& cycle : cycles)
+		{
+			auto copy = new ir::Bitcast;
+
+			copy->block = header;
+
+			copy->setGuard(new PredicateOperand(
+				PredicateOperand::PredicateTrue, copy));
+			copy->setD(new RegisterOperand(cycle.destination, copy));
+			copy->setA(new RegisterOperand(cycle.initialSource, copy));
+
+			header->insert(cycle.phi, copy);
+
+			unlinkAndErase(header, cycle.phi);
+		}
+
+		unlinkAndErase(header, terminator);
+	}
+	else
+	{
+		// the back edge now carries the final copy's values
+		for(auto& cycle : cycles)
+		{
+			cycle.latchOperand->setVirtualRegister(
+				lookup(values, cycle.latchSource));
+		}
+
+		// the exit test reads the final copy's counter
+		auto guard = terminator->guard();
+
+		if(guard->virtualRegister != nullptr)
+		{
+			terminator->setGuard(new PredicateOperand(
+				lookup(values, guard->virtualRegister),
+				guard->modifier, terminator));
+		}
+	}
+
+	fixupOutsideUses(outsideUses, values, lastPhiInputs);
+}
+
+/*! \brief Unroll a single-block loop with an unknown trip count by
+	chaining copies of the body, each keeping its exit test */
+static void unrollRuntimeLoop(ir::Function& f,
+	ir::Function::iterator header, const PhiCycleVector& cycles,
+	const InstructionVector& body, ir::Bra* terminator,
+	unsigned int factor)
+{
+	auto exitPosition = header; ++exitPosition;
+
+	auto exitBlock = &*exitPosition;
+
+	auto continueRegister = terminator->guard()->virtualRegister;
+	auto continueModifier = terminator->guard()->modifier;
+
+	auto invertedModifier =
+		continueModifier == PredicateOperand::StraightPredicate
+			? PredicateOperand::InversePredicate
+			: PredicateOperand::StraightPredicate;
+
+	// the header now exits directly and falls through into the chain
+	terminator->setGuard(new PredicateOperand(continueRegister,
+		invertedModifier, terminator));
+	terminator->setTarget(new ir::AddressOperand(exitBlock, terminator));
+
+	ValueMap values;
+	ValueMap lastPhiInputs;
+
+	BasicBlock* lastCopy = nullptr;
+
+	for(unsigned int copy = 2; copy <= factor; ++copy)
+	{
+		std::stringstream name;
+
+		name << header->name() << "_unrolled_" << copy;
+
+		auto block = f.newBasicBlock(exitPosition, name.str());
+
+		lastCopy = &*block;
+
+		advancePhis(cycles, values, lastPhiInputs);
+
+		for(auto instruction : body)
+		{
+			auto clone = cloneInstruction(f, instruction, values);
+
+			clone->block = lastCopy;
+
+			lastCopy->push_back(clone);
+		}
+
+		// the clone inherits the header's inverted exit test, which is
+		// exactly what interior copies need
+		auto branch = static_cast<ir::Bra*>(
+			cloneInstruction(f, terminator, values));
+
+		branch->block = lastCopy;
+
+		if(copy == factor)
+		{
+			// the final copy carries the back edge
+			branch->setGuard(new PredicateOperand(
+				branch->guard()->virtualRegister,
+				continueModifier, branch));
+			branch->setTarget(new ir::AddressOperand(&*header, branch));
+		}
+
+		lastCopy->push_back(branch);
+	}
+
+	// the phis now merge over the new back edge block
+	for(auto& cycle : cycles)
+	{
+		cycle.latchOperand->setVirtualRegister(
+			lookup(values, cycle.latchSource));
+
+		cycle.latchBlockOperand->globalValue = lastCopy;
+	}
+}
+
+LoopUnrollingPass::LoopUnrollingPass()
+: FunctionPass(StringVector({"ControlFlowGraph", "LoopAnalysis",
+  "RegisterPressureAnalysis"}), "LoopUnrollingPass")
+{
+
+}
+
+/*! \brief Gather the phi cycles of a single-block loop,
+	false when the phis do not fit the expected shape */
+static bool gatherPhiCycles(BasicBlock* header, PhiCycleVector& cycles)
+{
+	for(auto instruction : *header)
+	{
+		if(!instruction->isPhi()) break;
+
+		auto phi = static_cast<ir::Phi*>(instruction);
+
+		if(phi->d() == nullptr) return false;
+
+		PhiCycle cycle;
+
+		cycle.phi               = phi;
+		cycle.destination       = phi->d()->virtualRegister;
+		cycle.latchOperand      = nullptr;
+		cycle.latchBlockOperand = nullptr;
+		cycle.latchSource       = nullptr;
+		cycle.initialSource     = nullptr;
+
+		if(cycle.destination == nullptr) return false;
+
+		auto sources       = phi->sources();
+		auto blockOperands = phi->blockOperands();
+
+		if(sources.size() != 2) return false;
+
+		for(unsigned int source = 0; source != sources.size(); ++source)
+		{
+			if(blockOperands[source]->globalValue == header)
+			{
+				cycle.latchOperand      = sources[source];
+				cycle.latchBlockOperand = blockOperands[source];
+				cycle.latchSource       = sources[source]->virtualRegister;
+			}
+			else
+			{
+				cycle.initialSource = sources[source]->virtualRegister;
+			}
+		}
+
+		if(cycle.latchSource   == nullptr) return false;
+		if(cycle.initialSource == nullptr) return false;
+
+		cycles.push_back(cycle);
+	}
+
+	return true;
+}
+
+/*! \brief Gather uses of loop-defined values from outside the loop */
+static void gatherOutsideUses(BasicBlock* header,
+	const PhiCycleVector& cycles, const InstructionVector& body,
+	OutsideUseVector& uses)
+{
+	auto gather = [&](VirtualRegister* value, bool isPhiDestination)
+	{
+		for(auto use = value->firstUse(); use != nullptr;
+			use = use->nextUse())
+		{
+			if(use->instruction == nullptr)        continue;
+			if(use->instruction->block == header)  continue;
+
+			uses.push_back(OutsideUse{use, value, isPhiDestination});
+		}
+	};
+
+	for(auto& cycle : cycles)
+	{
+		gather(cycle.destination, true);
+	}
+
+	for(auto instruction : body)
+	{
+		for(auto write : instruction->writes)
+		{
+			if(!write->isRegister()) continue;
+
+			auto value = static_cast<RegisterOperand*>(
+				write)->virtualRegister;
+
+			if(value != nullptr) gather(value, false);
+		}
+	}
+}
+
+void LoopUnrollingPass::runOnFunction(Function& f)
+{
+	report("Running loop unrolling on function '" << f.name() << "'");
+
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	auto pressure = static_cast<RegisterPressureAnalysis*>(
+		getAnalysis("RegisterPressureAnalysis"));
+	assert(pressure != nullptr);
+
+	UnrollCostModel model(
+		compiler::Compiler::getSingleton()->getMachineModel());
+
+	/*! \brief An unrolling decision, applied after all loops are scanned
+		so rewriting one loop cannot skew discovery of the others */
+	class Candidate
+	{
+	public:
+		BasicBlock*  header;
+		uint64_t     tripCount;
+		unsigned int factor;
+	};
+
+	std::vector<Candidate> candidates;
+
+	for(auto loop = loops->begin(); loop != loops->end(); ++loop)
+	{
+		// innermost single-block loops only
+		if(!loop->children.empty())  continue;
+		if(loop->blocks.size() != 1) continue;
+
+		auto header = loop->header;
+
+		auto terminator = header->terminator();
+
+		if(terminator == nullptr || !terminator->isBranch()) continue;
+
+		auto branch = static_cast<ir::Bra*>(terminator);
+
+		if(branch->isUnconditional())             continue;
+		if(branch->targetBasicBlock() != header)  continue;
+
+		auto guard = branch->guard();
+
+		if(guard->modifier != PredicateOperand::StraightPredicate &&
+			guard->modifier != PredicateOperand::InversePredicate)
+		{
+			continue;
+		}
+
+		auto tripCount = loops->getTripCount(*loop);
+
+		unsigned int bodySize = 0;
+
+		for(auto instruction : *header)
+		{
+			if(instruction->isPhi())           continue;
+			if(instruction == terminator)      continue;
+
+			++bodySize;
+		}
+
+		auto factor = model.selectUnrollFactor(bodySize, tripCount,
+			pressure->maxLiveInBlock(*header));
+
+		if(factor < 2) continue;
+
+		report(" loop at '" << header->name() << "' trip count "
+			<< tripCount << ", unrolling by " << factor);
+
+		candidates.push_back(Candidate{header, tripCount, factor});
+	}
+
+	bool changed = false;
+
+	for(auto& candidate : candidates)
+	{
+		auto header = candidate.header;
+
+		PhiCycleVector cycles;
+
+		if(!gatherPhiCycles(header, cycles)) continue;
+
+		auto terminator = static_cast<ir::Bra*>(header->terminator());
+
+		InstructionVector body;
+
+		for(auto instruction : *header)
+		{
+			if(instruction->isPhi())      continue;
+			if(instruction == terminator) continue;
+
+			body.push_back(instruction);
+		}
+
+		OutsideUseVector outsideUses;
+
+		gatherOutsideUses(header, cycles, body, outsideUses);
+
+		if(candidate.tripCount != 0)
+		{
+			bool full = candidate.factor == candidate.tripCount;
+
+			unrollCountedLoop(f, header, cycles, body, terminator,
+				outsideUses, candidate.factor, full);
+
+			changed = true;
+		}
+		else
+		{
+			// exits from interior copies would bypass the fixups, so
+			// runtime unrolling requires all uses to stay in the loop
+			if(!outsideUses.empty()) continue;
+
+			auto headerPosition = f.begin();
+
+			while(&*headerPosition != header) ++headerPosition;
+
+			auto exitPosition = headerPosition; ++exitPosition;
+
+			// the chain falls through to the lexical exit block
+			if(exitPosition == f.end()) continue;
+
+			unrollRuntimeLoop(f, headerPosition, cycles, body,
+				terminator, candidate.factor);
+
+			changed = true;
+		}
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("ControlFlowGraph");
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("LoopAnalysis");
+	}
+}
+
+Pass* LoopUnrollingPass::clone() const
+{
+	return new LoopUnrollingPass;
+}
+
+}
+
+}
+
@@ -11,8 +11,8 @@
 
 #include <vanaheimr/ir/interface/Instruction.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 namespace vanaheimr
 {
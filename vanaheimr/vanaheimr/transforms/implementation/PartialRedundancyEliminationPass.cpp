@@ -0,0 +1,762 @@
+/*! \file   PartialRedundancyEliminationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the PartialRedundancyEliminationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/PartialRedundancyEliminationPass.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/BitVector.h>
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::ControlFlowGraph ControlFlowGraph;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::ImmediateOperand ImmediateOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+typedef ir::Function         Function;
+
+/*! \brief One word-packed bit row, one bit per lexical expression */
+typedef util::BitVector     BitRow;
+typedef std::vector<BitRow> BitMatrix;
+
+typedef std::vector<unsigned int> IdVector;
+
+/*! \brief A pure, unpredicated computation eligible for code motion */
+class Expression
+{
+public:
+	Instruction* representative;
+	IdVector     usedRegisters;
+
+	/*! \brief All occurrences, in program order */
+	std::vector<Instruction*> occurrences;
+};
+
+typedef std::vector<Expression>                        ExpressionVector;
+typedef std::unordered_map<std::string, unsigned int>  ExpressionIdMap;
+typedef std::unordered_map<Instruction*, unsigned int> OccurrenceMap;
+typedef std::unordered_map<unsigned int, Instruction*> ExposedMap;
+
+class Edge
+{
+public:
+	BasicBlock* head;
+	BasicBlock* tail;
+
+	BitRow earliest;
+	BitRow later;
+};
+
+typedef std::vector<Edge> EdgeVector;
+
+/*! \brief Everything the solves need, gathered in one linear sweep */
+class PREProblem
+{
+public:
+	ExpressionVector expressions;
+	ExpressionIdMap  expressionIds;
+	OccurrenceMap    occurrenceIds;
+
+	/*! \brief Expression ids reading each register, by register id */
+	std::vector<IdVector> expressionsUsingRegister;
+
+	BitMatrix transparent;
+	BitMatrix locallyAnticipable;
+	BitMatrix downwardExposed;
+
+	BitMatrix availableIn;
+	BitMatrix availableOut;
+	BitMatrix anticipableIn;
+	BitMatrix anticipableOut;
+
+	BitMatrix laterIn;
+
+	EdgeVector edges;
+
+	/*! \brief The first upward-exposed occurrence per block per
+		expression, the one a deletion replaces */
+	std::vector<ExposedMap> upwardExposed;
+};
+
+PartialRedundancyEliminationPass::PartialRedundancyEliminationPass()
+: FunctionPass(StringVector({"ControlFlowGraph"}),
+	"PartialRedundancyEliminationPass")
+{
+
+}
+
+/*! \brief The lexical identity of an eligible computation, "" otherwise */
+static std::string expressionKey(Instruction* instruction)
+{
+	if(!instruction->isBinary())              return "";
+	if( instruction->isMachineInstruction())  return "";
+	if( instruction->accessesMemory())        return "";
+	if(!instruction->guard()->isAlwaysTrue()) return "";
+
+	if(instruction->writes.size() != 1) return "";
+	if(instruction-> reads.size() != 3) return "";
+
+	auto destination = instruction->writes[0];
+
+	if(destination == nullptr || !destination->isRegister()) return "";
+
+	if(static_cast<RegisterOperand*>(
+		destination)->virtualRegister == nullptr) return "";
+
+	std::stringstream key;
+
+	key << instruction->opcode;
+
+	if(instruction->isComparison())
+	{
+		key << "." << static_cast<ir::ComparisonInstruction*>(
+			instruction)->comparison;
+	}
+
+	for(size_t read = 1; read != instruction->reads.size(); ++read)
+	{
+		auto operand = instruction->reads[read];
+
+		if(operand == nullptr) return "";
+
+		if(operand->mode() == ir::Operand::Register)
+		{
+			key << " r" << static_cast<RegisterOperand*>(
+				operand)->virtualRegister->id;
+		}
+		else if(operand->mode() == ir::Operand::Immediate)
+		{
+			auto immediate = static_cast<ImmediateOperand*>(operand);
+
+			key << " i" << immediate->uint << ":" << immediate->dataType;
+		}
+		else
+		{
+			return "";
+		}
+	}
+
+	return key.str();
+}
+
+static void gatherExpressions(Function& function, PREProblem& problem,
+	size_t registerCount)
+{
+	problem.expressionsUsingRegister.resize(registerCount);
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		for(auto instruction : *block)
+		{
+			auto key = expressionKey(instruction);
+
+			if(key.empty()) continue;
+
+			auto id = problem.expressionIds.find(key);
+
+			if(id == problem.expressionIds.end())
+			{
+				id = problem.expressionIds.insert(std::make_pair(
+					key, problem.expressions.size())).first;
+
+				Expression expression;
+
+				expression.representative = instruction;
+
+				for(size_t read = 1;
+					read != instruction->reads.size(); ++read)
+				{
+					auto operand = instruction->reads[read];
+
+					if(operand->mode() != ir::Operand::Register) continue;
+
+					auto value = static_cast<RegisterOperand*>(
+						operand)->virtualRegister;
+
+					expression.usedRegisters.push_back(value->id);
+
+					problem.expressionsUsingRegister[value->id].push_back(
+						id->second);
+				}
+
+				problem.expressions.push_back(expression);
+			}
+
+			problem.expressions[id->second].occurrences.push_back(
+				instruction);
+
+			problem.occurrenceIds.insert(
+				std::make_pair(instruction, id->second));
+		}
+	}
+}
+
+static void appendWrittenRegisters(Instruction* instruction, IdVector& writes)
+{
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		auto value = static_cast<RegisterOperand*>(write)->virtualRegister;
+
+		if(value == nullptr) continue;
+
+		writes.push_back(value->id);
+	}
+}
+
+static void computeLocalSets(Function& function, PREProblem& problem,
+	size_t registerCount)
+{
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto& transparent = problem.transparent       [block->id()];
+		auto& anticipable = problem.locallyAnticipable[block->id()];
+		auto& exposed     = problem.downwardExposed   [block->id()];
+
+		// upward-exposed computations become locally anticipable
+		BitRow writtenAbove(registerCount);
+
+		for(auto instruction : *block)
+		{
+			auto id = problem.occurrenceIds.find(instruction);
+
+			if(id != problem.occurrenceIds.end())
+			{
+				auto& expression = problem.expressions[id->second];
+
+				bool killed = false;
+
+				for(auto value : expression.usedRegisters)
+				{
+					if(writtenAbove.test(value))
+					{
+						killed = true;
+						break;
+					}
+				}
+
+				if(!killed)
+				{
+					anticipable.set(id->second);
+
+					problem.upwardExposed[block->id()].insert(
+						std::make_pair(id->second, instruction));
+				}
+			}
+
+			IdVector writes;
+
+			appendWrittenRegisters(instruction, writes);
+
+			for(auto value : writes)
+			{
+				writtenAbove.set(value);
+
+				// any write kills the transparency of its readers
+				for(auto reader :
+					problem.expressionsUsingRegister[value])
+				{
+					transparent.reset(reader);
+				}
+			}
+		}
+
+		// downward-exposed computations, found with a reverse sweep
+		BitRow writtenBelow(registerCount);
+
+		for(auto instruction = block->rbegin();
+			instruction != block->rend(); ++instruction)
+		{
+			IdVector writes;
+
+			appendWrittenRegisters(*instruction, writes);
+
+			for(auto value : writes)
+			{
+				writtenBelow.set(value);
+			}
+
+			auto id = problem.occurrenceIds.find(*instruction);
+
+			if(id == problem.occurrenceIds.end()) continue;
+
+			auto& expression = problem.expressions[id->second];
+
+			bool killed = false;
+
+			for(auto value : expression.usedRegisters)
+			{
+				if(writtenBelow.test(value))
+				{
+					killed = true;
+					break;
+				}
+			}
+
+			if(!killed) exposed.set(id->second);
+		}
+	}
+}
+
+static void solveAvailability(Function& function, PREProblem& problem,
+	ControlFlowGraph* cfg)
+{
+	bool changed = true;
+
+	while(changed)
+	{
+		changed = false;
+
+		for(auto block = function.begin();
+			block != function.end(); ++block)
+		{
+			auto& in  = problem.availableIn [block->id()];
+			auto& out = problem.availableOut[block->id()];
+
+			auto predecessors = cfg->getPredecessors(*block);
+
+			BitRow newIn(in.size(), !predecessors.empty());
+
+			for(auto predecessor : predecessors)
+			{
+				newIn.intersectWith(problem.availableOut[predecessor->id()]);
+			}
+
+			if(newIn != in)
+			{
+				in = newIn;
+			}
+
+			// out = exposed | (in & transparent)
+			BitRow newOut = in;
+
+			newOut.intersectWith(problem.transparent    [block->id()]);
+			newOut.unionWith    (problem.downwardExposed[block->id()]);
+
+			changed |= newOut != out;
+
+			out = newOut;
+		}
+	}
+}
+
+static void solveAnticipability(Function& function, PREProblem& problem,
+	ControlFlowGraph* cfg)
+{
+	bool changed = true;
+
+	while(changed)
+	{
+		changed = false;
+
+		for(auto block = function.begin();
+			block != function.end(); ++block)
+		{
+			auto& in  = problem.anticipableIn [block->id()];
+			auto& out = problem.anticipableOut[block->id()];
+
+			auto successors = cfg->getSuccessors(*block);
+
+			BitRow newOut(out.size(), !successors.empty());
+
+			for(auto successor : successors)
+			{
+				newOut.intersectWith(problem.anticipableIn[successor->id()]);
+			}
+
+			if(newOut != out)
+			{
+				out = newOut;
+			}
+
+			// in = anticipable | (out & transparent)
+			BitRow newIn = out;
+
+			newIn.intersectWith(problem.transparent       [block->id()]);
+			newIn.unionWith    (problem.locallyAnticipable[block->id()]);
+
+			changed |= newIn != in;
+
+			in = newIn;
+		}
+	}
+}
+
+/*! \brief The later/later-in fixpoint of lazy code motion, placements
+	sink as far as they can without adding recomputations */
+static void solvePlacement(Function& function, PREProblem& problem,
+	ControlFlowGraph* cfg)
+{
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto successors = cfg->getSuccessors(*block);
+
+		for(auto successor : successors)
+		{
+			Edge edge;
+
+			edge.head = &*block;
+			edge.tail = successor;
+
+			// earliest = anticipated in the tail, not available out of
+			// the head, and not movable further up through the head
+			edge.earliest = problem.anticipableIn[successor->id()];
+
+			edge.earliest.subtract(problem.availableOut[block->id()]);
+
+			BitRow movable = problem.transparent[block->id()];
+
+			movable.intersectWith(problem.anticipableOut[block->id()]);
+
+			edge.earliest.subtract(movable);
+
+			edge.later = edge.earliest;
+
+			problem.edges.push_back(edge);
+		}
+	}
+
+	auto entryId = function.entry_block()->id();
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		auto& laterIn = problem.laterIn[block->id()];
+
+		laterIn = BitRow(laterIn.size(), block->id() != entryId);
+	}
+
+	bool changed = true;
+
+	while(changed)
+	{
+		changed = false;
+
+		for(auto& edge : problem.edges)
+		{
+			// later = earliest | (later-in & ~locally-anticipable)
+			BitRow later = problem.laterIn[edge.head->id()];
+
+			later.subtract(problem.locallyAnticipable[edge.head->id()]);
+			later.unionWith(edge.earliest);
+
+			changed |= later != edge.later;
+
+			edge.later = later;
+		}
+
+		for(auto& edge : problem.edges)
+		{
+			if(edge.tail->id() == entryId) continue;
+
+			changed |= problem.laterIn[edge.tail->id()].intersectWith(
+				edge.later);
+		}
+	}
+}
+
+static void unlinkRegisterOperands(Instruction* instruction)
+{
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+}
+
+static void emitCopy(BasicBlock* block, BasicBlock::iterator position,
+	VirtualRegister* destination, VirtualRegister* source)
+{
+	auto copy = new ir::Bitcast;
+
+	copy->block = block;
+
+	copy->setGuard(new PredicateOperand(
+		PredicateOperand::PredicateTrue, copy));
+	copy->setD(new RegisterOperand(destination, copy));
+	copy->setA(new RegisterOperand(source, copy));
+
+	block->insert(position, copy);
+}
+
+/*! \brief Place a computation of the expression into the temporary on
+	the edge, in whichever end block makes the placement unconditional */
+static void insertComputation(Expression& expression, Edge& edge,
+	VirtualRegister* temporary, ControlFlowGraph* cfg)
+{
+	auto computation = expression.representative->clone();
+
+	static_cast<RegisterOperand*>(
+		computation->writes[0])->setVirtualRegister(temporary);
+
+	if(cfg->getPredecessors(*edge.tail).size() == 1)
+	{
+		auto position = edge.tail->begin();
+
+		while(position != edge.tail->end() && (*position)->isPhi())
+		{
+			++position;
+		}
+
+		computation->block = edge.tail;
+
+		edge.tail->insert(position, computation);
+
+		return;
+	}
+
+	auto terminator = edge.head->terminator();
+
+	computation->block = edge.head;
+
+	if(terminator != nullptr && terminator->isBranch())
+	{
+		edge.head->insert(edge.head->getIterator(terminator),
+			computation);
+	}
+	else
+	{
+		edge.head->push_back(computation);
+	}
+}
+
+void PartialRedundancyEliminationPass::runOnFunction(Function& f)
+{
+	report("Eliminating partial redundancies in function '"
+		<< f.name() << "'");
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	size_t blockCount = 0;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		blockCount = std::max(blockCount, (size_t)block->id() + 1);
+	}
+
+	size_t registerCount = 0;
+
+	for(auto value = f.register_begin();
+		value != f.register_end(); ++value)
+	{
+		registerCount = std::max(registerCount, (size_t)value->id + 1);
+	}
+
+	PREProblem problem;
+
+	gatherExpressions(f, problem, registerCount);
+
+	if(problem.expressions.empty()) return;
+
+	report(" found " << problem.expressions.size() << " expressions");
+
+	size_t expressionCount = problem.expressions.size();
+
+	problem.transparent.assign(blockCount,
+		BitRow(expressionCount, true));
+	problem.locallyAnticipable.assign(blockCount,
+		BitRow(expressionCount));
+	problem.downwardExposed.assign(blockCount,
+		BitRow(expressionCount));
+
+	problem.availableIn   .assign(blockCount, BitRow(expressionCount));
+	problem.availableOut  .assign(blockCount, BitRow(expressionCount, true));
+	problem.anticipableIn .assign(blockCount, BitRow(expressionCount, true));
+	problem.anticipableOut.assign(blockCount, BitRow(expressionCount));
+
+	problem.laterIn.assign(blockCount, BitRow(expressionCount));
+
+	problem.upwardExposed.resize(blockCount);
+
+	computeLocalSets(f, problem, registerCount);
+
+	solveAvailability   (f, problem, cfg);
+	solveAnticipability (f, problem, cfg);
+	solvePlacement      (f, problem, cfg);
+
+	// expressions whose placement needs a critical edge are abandoned,
+	// inserting in either end block would change some path
+	BitRow invalid(expressionCount);
+
+	for(auto& edge : problem.edges)
+	{
+		BitRow insert = edge.later;
+
+		insert.subtract(problem.laterIn[edge.tail->id()]);
+
+		if(insert.none()) continue;
+
+		if(cfg->getSuccessors  (*edge.head).size() > 1 &&
+			cfg->getPredecessors(*edge.tail).size() > 1)
+		{
+			invalid.unionWith(insert);
+		}
+	}
+
+	// a placement only pays off if it deletes a computation somewhere
+	BitRow profitable(expressionCount);
+
+	auto entryId = f.entry_block()->id();
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		if(block->id() == entryId) continue;
+
+		BitRow deletable = problem.locallyAnticipable[block->id()];
+
+		deletable.subtract(problem.laterIn[block->id()]);
+
+		profitable.unionWith(deletable);
+	}
+
+	profitable.subtract(invalid);
+
+	if(profitable.none()) return;
+
+	// one temporary per transformed expression
+	std::vector<VirtualRegister*> temporaries(
+		problem.expressions.size(), nullptr);
+
+	for(size_t id = 0; id != problem.expressions.size(); ++id)
+	{
+		if(!profitable.test(id)) continue;
+
+		auto type = static_cast<RegisterOperand*>(problem.expressions[
+			id].representative->writes[0])->virtualRegister->type;
+
+		temporaries[id] = &*f.newVirtualRegister(type);
+	}
+
+	// place the inserted computations
+	for(auto& edge : problem.edges)
+	{
+		auto& laterIn = problem.laterIn[edge.tail->id()];
+
+		for(size_t id = 0; id != problem.expressions.size(); ++id)
+		{
+			if(!profitable.test(id))      continue;
+			if(!edge.later.test(id))      continue;
+			if( laterIn.test(id))         continue;
+
+			insertComputation(problem.expressions[id], edge,
+				temporaries[id], cfg);
+		}
+	}
+
+	// delete the covered computations and keep the temporary current at
+	// the computations that remain
+	std::unordered_set<Instruction*> deleted;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		if(block->id() == entryId) continue;
+
+		auto& anticipable = problem.locallyAnticipable[block->id()];
+		auto& laterIn     = problem.laterIn           [block->id()];
+
+		for(auto& exposed : problem.upwardExposed[block->id()])
+		{
+			if(!profitable.test(exposed.first))  continue;
+			if(!anticipable.test(exposed.first)) continue;
+			if( laterIn.test(exposed.first))     continue;
+
+			deleted.insert(exposed.second);
+		}
+	}
+
+	unsigned int eliminated = 0;
+
+	for(size_t id = 0; id != problem.expressions.size(); ++id)
+	{
+		if(!profitable.test(id)) continue;
+
+		for(auto occurrence : problem.expressions[id].occurrences)
+		{
+			auto block = occurrence->block;
+
+			auto destination = static_cast<RegisterOperand*>(
+				occurrence->writes[0])->virtualRegister;
+
+			if(deleted.count(occurrence) != 0)
+			{
+				emitCopy(block, block->getIterator(occurrence),
+					destination, temporaries[id]);
+
+				unlinkRegisterOperands(occurrence);
+
+				block->erase(occurrence);
+
+				++eliminated;
+			}
+			else
+			{
+				auto position = block->getIterator(occurrence);
+
+				emitCopy(block, ++position, temporaries[id],
+					destination);
+			}
+		}
+	}
+
+	report(" eliminated " << eliminated << " computations");
+
+	if(eliminated > 0)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+	}
+}
+
+Pass* PartialRedundancyEliminationPass::clone() const
+{
+	return new PartialRedundancyEliminationPass;
+}
+
+}
+
+}
+
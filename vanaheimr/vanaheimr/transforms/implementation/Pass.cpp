@@ -8,8 +8,11 @@
 #include <vanaheimr/transforms/interface/PassManager.h>
 #include <vanaheimr/transforms/interface/Pass.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 namespace vanaheimr
 {
@@ -19,7 +22,7 @@ namespace transforms
 
 Pass::Pass(Type t, const StringVector& a, const std::string& n,
 	const StringVector& c)
-	: type(t), analyses(a), name(n), classes(c), _manager(0)
+	: type(t), analyses(a), name(n), classes(c), _manager(0), _scratch(0)
 {
 
 }
@@ -34,6 +37,16 @@ void Pass::setPassManager(PassManager* m)
 	_manager = m;
 }
 
+util::Arena* Pass::scratch()
+{
+	return _scratch;
+}
+
+void Pass::setScratchArena(util::Arena* arena)
+{
+	_scratch = arena;
+}
+
 Pass::Analysis* Pass::getAnalysis(const std::string& type)
 {
 	assert(_manager != 0);
@@ -130,6 +143,34 @@ void FunctionPass::finalize()
 
 }
 
+InstructionSweepPass::InstructionSweepPass(const StringVector& a,
+	const std::string& n, const StringVector& c)
+: FunctionPass(a, n, c)
+{
+
+}
+
+InstructionSweepPass::~InstructionSweepPass()
+{
+
+}
+
+void InstructionSweepPass::runOnFunction(Function& f)
+{
+	typedef std::vector<ir::Instruction*> InstructionVector;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		// snapshot the block, the visitor may insert or remove
+		InstructionVector instructions(block->begin(), block->end());
+
+		for(auto instruction : instructions)
+		{
+			visit(instruction);
+		}
+	}
+}
+
 ImmutableFunctionPass::ImmutableFunctionPass(
 	const StringVector& a, const std::string& n, const StringVector& c)
  : Pass(Pass::ImmutableFunctionPass, a, n, c)
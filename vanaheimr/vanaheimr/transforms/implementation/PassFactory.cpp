@@ -10,15 +10,33 @@
 
 #include <vanaheimr/transforms/interface/ConvertToSSAPass.h>
 #include <vanaheimr/transforms/interface/ConvertFromSSAPass.h>
+#include <vanaheimr/transforms/interface/ConstantPropagationPass.h>
+#include <vanaheimr/transforms/interface/DeadCodeEliminationPass.h>
+#include <vanaheimr/transforms/interface/GlobalValueNumberingPass.h>
+#include <vanaheimr/transforms/interface/FunctionInliningPass.h>
+#include <vanaheimr/transforms/interface/LoopUnrollingPass.h>
+#include <vanaheimr/transforms/interface/SimplifyControlFlowPass.h>
+#include <vanaheimr/transforms/interface/PartialRedundancyEliminationPass.h>
+#include <vanaheimr/transforms/interface/ConvertThreadsToSIMDPass.h>
+#include <vanaheimr/transforms/interface/ProfileAnnotationPass.h>
+#include <vanaheimr/transforms/interface/VerifierPass.h>
+#include <vanaheimr/transforms/interface/SuperblockFormationPass.h>
+#include <vanaheimr/transforms/interface/LoopInvariantCodeMotionPass.h>
+#include <vanaheimr/transforms/interface/StrengthReductionPass.h>
+#include <vanaheimr/transforms/interface/IfConversionPass.h>
+#include <vanaheimr/transforms/interface/GlobalDeadCodeEliminationPass.h>
 
 #include <vanaheimr/codegen/interface/EnforceArchaeopteryxABIPass.h>
 #include <vanaheimr/codegen/interface/ListInstructionSchedulerPass.h>
 #include <vanaheimr/codegen/interface/ChaitinBriggsRegisterAllocatorPass.h>
+#include <vanaheimr/codegen/interface/LinearScanRegisterAllocatorPass.h>
 #include <vanaheimr/codegen/interface/GenericSpillCodePass.h>
+#include <vanaheimr/codegen/interface/MachinePeepholeOptimizationPass.h>
 #include <vanaheimr/codegen/interface/TranslationTableInstructionSelectionPass.h>
 
 // Standard Library Includes
 #include <cassert>
+#include <map>
 
 namespace vanaheimr
 {
@@ -63,6 +81,81 @@ Pass* PassFactory::createPass(const std::string& name,
 		pass = new ConvertFromSSAPass();
 	}
 	
+	if(name == "dce" || name == "DeadCodeEliminationPass")
+	{
+		pass = new DeadCodeEliminationPass();
+	}
+	
+	if(name == "gvn" || name == "GlobalValueNumberingPass")
+	{
+		pass = new GlobalValueNumberingPass();
+	}
+
+	if(name == "sccp" || name == "ConstantPropagationPass")
+	{
+		pass = new ConstantPropagationPass();
+	}
+
+	if(name == "unroll" || name == "LoopUnrollingPass")
+	{
+		pass = new LoopUnrollingPass();
+	}
+
+	if(name == "pre" || name == "PartialRedundancyEliminationPass")
+	{
+		pass = new PartialRedundancyEliminationPass();
+	}
+
+	if(name == "simplify-cfg" || name == "SimplifyControlFlowPass")
+	{
+		pass = new SimplifyControlFlowPass();
+	}
+
+	if(name == "simd" || name == "ConvertThreadsToSIMDPass")
+	{
+		pass = new ConvertThreadsToSIMDPass();
+	}
+
+	if(name == "inline" || name == "FunctionInliningPass")
+	{
+		pass = new FunctionInliningPass();
+	}
+
+	if(name == "profile-annotation" || name == "ProfileAnnotationPass")
+	{
+		pass = new ProfileAnnotationPass();
+	}
+
+	if(name == "verify" || name == "VerifierPass")
+	{
+		pass = new VerifierPass();
+	}
+
+	if(name == "superblocks" || name == "SuperblockFormationPass")
+	{
+		pass = new SuperblockFormationPass();
+	}
+
+	if(name == "licm" || name == "LoopInvariantCodeMotionPass")
+	{
+		pass = new LoopInvariantCodeMotionPass();
+	}
+
+	if(name == "strength-reduction" || name == "StrengthReductionPass")
+	{
+		pass = new StrengthReductionPass();
+	}
+
+	if(name == "if-conversion" || name == "IfConversionPass")
+	{
+		pass = new IfConversionPass();
+	}
+
+	if(name == "global-dce" || name == "GlobalDeadCodeEliminationPass")
+	{
+		pass = new GlobalDeadCodeEliminationPass();
+	}
+
 	if(name == "EnforceArchaeopteryxABIPass")
 	{
 		pass = new codegen::EnforceArchaeopteryxABIPass();
@@ -78,11 +171,21 @@ Pass* PassFactory::createPass(const std::string& name,
 		pass = new codegen::ChaitinBriggsRegisterAllocatorPass();
 	}
 	
+	if(name == "linear-scan" || name == "LinearScanRegisterAllocatorPass")
+	{
+		pass = new codegen::LinearScanRegisterAllocatorPass();
+	}
+
 	if(name == "generic-spiller" || name == "GenericSpillCodePass")
 	{
 		pass = new codegen::GenericSpillCodePass();
 	}
 	
+	if(name == "peephole" || name == "MachinePeepholeOptimizationPass")
+	{
+		pass = new codegen::MachinePeepholeOptimizationPass();
+	}
+
 	if(name == "translation-table" ||
 		name == "TranslationTableInstructionSelectionPass")
 	{
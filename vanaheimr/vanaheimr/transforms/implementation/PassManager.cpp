@@ -7,6 +7,7 @@
 // Vanaheimr Includes
 #include <vanaheimr/transforms/interface/PassManager.h>
 #include <vanaheimr/transforms/interface/PassFactory.h>
+#include <vanaheimr/transforms/interface/PassResultCache.h>
 #include <vanaheimr/transforms/interface/Pass.h>
 
 #include <vanaheimr/analysis/interface/Analysis.h>
@@ -14,12 +15,22 @@
 
 #include <vanaheimr/ir/interface/Module.h>
 #include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
 
-// Hydrazine Includes
-#include <hydrazine/interface/debug.h>
+#include <vanaheimr/util/interface/Arena.h>
+#include <vanaheimr/util/interface/NumaTopology.h>
+#include <vanaheimr/util/interface/Executor.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
 
 // Standard Library Includes
 #include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <ostream>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -285,6 +296,8 @@ static void runFunctionPass(Function* function, Pass* pass)
 
 static void runFunctionPass(Module* module, Function* function, Pass* pass)
 {
+	function->materialize();
+
 	switch(pass->type)
 	{
 	case Pass::ImmutablePass: /* fall through */
@@ -325,6 +338,32 @@ static void runFunctionPass(Module* module, Function* function, Pass* pass)
 	}
 }
 
+/*! \brief One function's speculatively precomputed analyses.
+
+	While a transform mutates one function, idle pool workers fill slots
+	for functions later in the visit order with the analyses the wave's
+	next pass has declared.  The serial loop claims a slot when it
+	reaches the function - a claim that beats the worker cancels the
+	task, a claim that loses merges the finished result instead of
+	recomputing it */
+enum PrefetchState
+{
+	PrefetchPending,
+	PrefetchRunning,
+	PrefetchDone,
+	PrefetchCancelled
+};
+
+class PrefetchSlot
+{
+public:
+	PrefetchSlot() : state(PrefetchPending) {}
+
+public:
+	std::atomic<int> state;
+	AnalysisMap      analyses;
+};
+
 static void initializeFunctionPass(Module* module, Pass* pass)
 {
 	switch(pass->type)
@@ -391,6 +430,35 @@ static void finalizeFunctionPass(Module* module, Pass* pass)
 	}
 }
 
+typedef std::vector<InstructionSweepPass*> SweepPassVector;
+
+static void runFusedSweep(Function* function, const SweepPassVector& passes)
+{
+	typedef std::vector<ir::Instruction*> InstructionVector;
+
+	report("  Running fused sweep of " << passes.size()
+		<< " passes on function '" << function->name() << "'");
+
+	for(auto block = function->begin(); block != function->end(); ++block)
+	{
+		// snapshot the block, visitors may insert or remove
+		InstructionVector instructions(block->begin(), block->end());
+
+		for(auto instruction : instructions)
+		{
+			auto live = instruction;
+
+			for(auto pass : passes)
+			{
+				live = pass->visit(live);
+
+				// removed, later visitors skip it
+				if(live == nullptr) break;
+			}
+		}
+	}
+}
+
 static void runModulePass(Module* module, Pass* pass)
 {
 	report("  Running module pass '" << pass->toString() << "'" );
@@ -416,8 +484,71 @@ static void runModulePass(Module* module, Pass* pass)
 	}
 }
 
+typedef PassManager::PassStatistics PassStatistics;
+
+static size_t countInstructions(Function* function)
+{
+	size_t count = 0;
+
+	for(auto block = function->begin(); block != function->end(); ++block)
+	{
+		count += block->size();
+	}
+
+	return count;
+}
+
+static double wallClockSeconds()
+{
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*! \brief Snapshot the counters before a pass runs, the deltas are
+	resolved in endSample */
+static void beginSample(PassStatistics& sample, const std::string& passName,
+	Function* function)
+{
+	sample.passName     = passName;
+	sample.functionName = function != nullptr ? function->name() : "<module>";
+
+	sample.instructionsBefore = function != nullptr ?
+		countInstructions(function) : 0;
+	sample.instructionsAfter  = sample.instructionsBefore;
+
+	sample.arenaBytes = util::Arena::globalBytesReserved();
+	sample.seconds    = wallClockSeconds();
+}
+
+static void endSample(PassStatistics& sample, Function* function)
+{
+	sample.seconds    = wallClockSeconds() - sample.seconds;
+	sample.arenaBytes = util::Arena::globalBytesReserved()
+		- sample.arenaBytes;
+
+	if(function != nullptr)
+	{
+		sample.instructionsAfter = countInstructions(function);
+	}
+}
+
+static std::string fusedSweepName(const SweepPassVector& passes)
+{
+	std::string name = "fused(";
+
+	for(auto pass : passes)
+	{
+		if(pass != passes.front()) name += "+";
+
+		name += pass->name;
+	}
+
+	return name + ")";
+}
+
 PassManager::PassManager(Module* module) :
-	_module(module), _analyses(0)
+	_module(module), _analyses(0), _workers(1), _instrument(false),
+	_resultCache(nullptr)
 {
 	assert(_module != 0);
 }
@@ -484,6 +615,26 @@ void PassManager::runOnFunction(Function& function)
 {
 	report("Running pass manager on function " << function.name());
 
+	// lazily-loaded functions need their bodies before passes touch them
+	function.materialize();
+
+	// an unchanged function whose optimized body is cached skips the
+	// entire pipeline
+	bool useCache = _resultCache != nullptr && _isCacheablePipeline();
+
+	PassResultCache::Hash hash = 0;
+
+	std::string signature;
+
+	if(useCache)
+	{
+		signature = _pipelineSignature();
+
+		hash = PassResultCache::hashFunction(function);
+
+		if(_resultCache->lookup(signature, hash, function)) return;
+	}
+
 	PassWaveList passes = _schedulePasses();
 	
 	PassUseCountMap passesUseCounts = getPassUseCounts(passes);
@@ -500,16 +651,96 @@ void PassManager::runOnFunction(Function& function)
 		_analyses = &analyses;
 		_function = &function;
 	
-		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
+		for(auto pass = wave->begin(); pass != wave->end(); )
 		{
+			// fuse runs of consecutive sweep passes into one traversal
+			SweepPassVector sweeps;
+
+			auto last = pass;
+
+			while(last != wave->end())
+			{
+				auto sweep = dynamic_cast<InstructionSweepPass*>(*last);
+
+				if(sweep == nullptr) break;
+
+				sweeps.push_back(sweep);
+				++last;
+			}
+
+			if(sweeps.size() > 1)
+			{
+				for(auto fused = pass; fused != last; ++fused)
+				{
+					allocateNewDataStructures(passesUseCounts, analyses,
+						&function, (*fused)->analyses, this);
+
+					_prepareScratch(*fused);
+				}
+
+				PassStatistics sample;
+
+				if(_instrument)
+				{
+					beginSample(sample, fusedSweepName(sweeps), &function);
+				}
+
+				runFusedSweep(&function, sweeps);
+
+				if(_instrument)
+				{
+					endSample(sample, &function);
+
+					_statistics.push_back(sample);
+				}
+
+				for(auto fused = pass; fused != last; ++fused)
+				{
+					_previouslyRunPasses[(*fused)->name] = *fused;
+
+					_releaseScratch(*fused);
+
+					freeUnusedDataStructures(passesUseCounts, analyses,
+						(*fused)->analyses);
+				}
+
+				_scratch.clear();
+
+				pass = last;
+				continue;
+			}
+
 			allocateNewDataStructures(passesUseCounts, analyses,
 				&function, (*pass)->analyses, this);
-		
+
+			_prepareScratch(*pass);
+
+			PassStatistics sample;
+
+			if(_instrument)
+			{
+				beginSample(sample, (*pass)->name, &function);
+			}
+
 			runFunctionPass(&function, *pass);
+
+			if(_instrument)
+			{
+				endSample(sample, &function);
+
+				_statistics.push_back(sample);
+			}
+
 			_previouslyRunPasses[(*pass)->name] = *pass;
-			
+
+			_releaseScratch(*pass);
+
+			_scratch.clear();
+
 			freeUnusedDataStructures(passesUseCounts, analyses,
 			 	(*pass)->analyses);
+
+			++pass;
 		}
 
 		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
@@ -522,12 +753,30 @@ void PassManager::runOnFunction(Function& function)
 	}
 	
 	_previouslyRunPasses.clear();
+
+	if(useCache)
+	{
+		_resultCache->insert(signature, hash, function);
+	}
 }
 
 void PassManager::runOnModule()
 {
 	report("Running pass manager on module " << _module->name);
 
+	// with a cache attached, a function-level pipeline replays through
+	// runOnFunction so every function gets a lookup
+	if(_resultCache != nullptr && _isCacheablePipeline())
+	{
+		for(auto function = _module->begin();
+			function != _module->end(); ++function)
+		{
+			runOnFunction(*function);
+		}
+
+		return;
+	}
+
 	typedef std::map<std::string, AnalysisMap> AnalysisMapMap;
 	
 	AnalysisMapMap functionAnalyses;
@@ -556,11 +805,101 @@ void PassManager::runOnModule()
 			}
 			
 			_previouslyRunPasses[(*pass)->name] = *pass;
-			
+
+			PassStatistics sample;
+
+			if(_instrument)
+			{
+				beginSample(sample, (*pass)->name, nullptr);
+			}
+
 			runModulePass(_module, *pass);
+
+			if(_instrument)
+			{
+				endSample(sample, nullptr);
+
+				_statistics.push_back(sample);
+			}
 		}
-	
-		// Run all function and bb passes
+
+		// Run all function and bb passes, serially when instrumenting so
+		// that the samples land in this manager's vector
+		if(!_instrument && _workers > 1 && _runWaveInParallel(*wave))
+		{
+			continue;
+		}
+
+		// the wave runs serially from here, but when more workers were
+		// requested the pool's cores are idle - let them precompute the
+		// analyses the wave's first function pass will request for
+		// functions later in the visit order
+		Pass* prefetchedPass = nullptr;
+
+		for(auto pass = wave->begin(); pass != wave->end(); ++pass)
+		{
+			if((*pass)->type == Pass::ImmutablePass) continue;
+			if((*pass)->type == Pass::ModulePass)    continue;
+
+			prefetchedPass = *pass;
+			break;
+		}
+
+		bool prefetch = !_instrument && _workers > 1 &&
+			prefetchedPass != nullptr && !prefetchedPass->analyses.empty();
+
+		std::map<Function*, PrefetchSlot> prefetchSlots;
+
+		if(prefetch)
+		{
+			for(auto function = _module->begin();
+				function != _module->end(); ++function)
+			{
+				// binary reads are not thread safe, deferred bodies are
+				// left for the serial loop to load
+				if(!function->isMaterialized()) continue;
+
+				auto& slot = prefetchSlots[&*function];
+
+				Function* target = &*function;
+				auto      types  = prefetchedPass->analyses;
+
+				util::Executor::instance().run(
+					[this, target, &slot, types]()
+				{
+					int expected = PrefetchPending;
+
+					if(!slot.state.compare_exchange_strong(expected,
+						PrefetchRunning))
+					{
+						return;
+					}
+
+					report(" Prefetching analyses for function '"
+						<< target->name() << "'");
+
+					// a private manager resolves analysis dependences
+					// against the slot's own map
+					PassManager manager(_module);
+
+					manager._analyses = &slot.analyses;
+					manager._function = target;
+
+					PassUseCountMap uses;
+
+					for(auto& type : types)
+					{
+						uses.insert(std::make_pair(type, 1));
+					}
+
+					allocateNewDataStructures(uses, slot.analyses,
+						target, types, &manager);
+
+					slot.state.store(PrefetchDone);
+				});
+			}
+		}
+
 		for(auto function = _module->begin();
 			function != _module->end(); ++function)
 		{
@@ -571,38 +910,358 @@ void PassManager::runOnModule()
 		
 			auto analyses = functionAnalyses.insert(std::make_pair(
 					function->name(), AnalysisMap())).first;
-				
+
 			_analyses = &analyses->second;
 			_function = &*function;
-		
-			for(auto pass = wave->begin(); pass != wave->end(); ++pass)
+
+			// claim this function's prefetch, cancelling a task that has
+			// not started and adopting the result of one that finished
+			auto slot = prefetchSlots.find(&*function);
+
+			if(slot != prefetchSlots.end())
 			{
-				if((*pass)->type == Pass::ImmutablePass) continue;
-				if((*pass)->type == Pass::ModulePass)    continue;
-			
+				int expected = PrefetchPending;
+
+				if(!slot->second.state.compare_exchange_strong(expected,
+					PrefetchCancelled))
+				{
+					while(slot->second.state.load() == PrefetchRunning)
+					{
+						std::this_thread::yield();
+					}
+
+					for(auto& analysis : slot->second.analyses)
+					{
+						if(!analyses->second.insert(analysis).second)
+						{
+							// a module pass already built this one, the
+							// speculative copy loses
+							delete analysis.second;
+
+							continue;
+						}
+
+						// re-point the analysis at this manager, the
+						// private one it was built against is gone
+						analysis.second->setPassManager(this);
+					}
+
+					slot->second.analyses.clear();
+				}
+			}
+
+			for(auto pass = wave->begin(); pass != wave->end(); )
+			{
+				if((*pass)->type == Pass::ImmutablePass) { ++pass; continue; }
+				if((*pass)->type == Pass::ModulePass)    { ++pass; continue; }
+
+				// fuse runs of consecutive sweep passes into one traversal
+				SweepPassVector sweeps;
+
+				auto last = pass;
+
+				while(last != wave->end())
+				{
+					auto sweep = dynamic_cast<InstructionSweepPass*>(*last);
+
+					if(sweep == nullptr) break;
+
+					sweeps.push_back(sweep);
+					++last;
+				}
+
+				if(sweeps.size() > 1)
+				{
+					for(auto fused = pass; fused != last; ++fused)
+					{
+						allocateNewDataStructures(passesUseCounts,
+							analyses->second, &*function,
+							(*fused)->analyses, this);
+
+						_prepareScratch(*fused);
+					}
+
+					function->materialize();
+
+					PassStatistics sample;
+
+					if(_instrument)
+					{
+						beginSample(sample, fusedSweepName(sweeps),
+							&*function);
+					}
+
+					runFusedSweep(&*function, sweeps);
+
+					if(_instrument)
+					{
+						endSample(sample, &*function);
+
+						_statistics.push_back(sample);
+					}
+
+					for(auto fused = pass; fused != last; ++fused)
+					{
+						_previouslyRunPasses[(*fused)->name] = *fused;
+
+						_releaseScratch(*fused);
+
+						freeUnusedDataStructures(passesUseCounts,
+							analyses->second, (*fused)->analyses);
+					}
+
+					_scratch.clear();
+
+					pass = last;
+					continue;
+				}
+
 				allocateNewDataStructures(passesUseCounts, analyses->second,
 					&*function, (*pass)->analyses, this);
-			
+
+				_prepareScratch(*pass);
+
+				PassStatistics sample;
+
+				if(_instrument)
+				{
+					// materialize first, the body is counted next
+					function->materialize();
+
+					beginSample(sample, (*pass)->name, &*function);
+				}
+
 				runFunctionPass(_module, &*function, *pass);
+
+				if(_instrument)
+				{
+					endSample(sample, &*function);
+
+					_statistics.push_back(sample);
+				}
+
 				_previouslyRunPasses[(*pass)->name] = *pass;
-			
+
+				_releaseScratch(*pass);
+				_scratch.clear();
+
 				freeUnusedDataStructures(passesUseCounts, analyses->second,
 					(*pass)->analyses);
+
+				++pass;
 			}
 
 			for(auto pass = wave->begin(); pass != wave->end(); ++pass)
 			{
 				finalizeFunctionPass(_module, *pass);
 			}
-		
+
 			_analyses = 0;
 			_function = 0;
 		}
+
+		// cancelled tasks still queued in the pool reference the slots,
+		// drain them before the slots go out of scope
+		if(prefetch)
+		{
+			util::Executor::instance().wait();
+		}
 	}
-	
+
 	_previouslyRunPasses.clear();
 }
 
+void PassManager::setResultCache(PassResultCache* cache)
+{
+	_resultCache = cache;
+}
+
+bool PassManager::_isCacheablePipeline() const
+{
+	for(auto pass : _passes)
+	{
+		if(pass->type == Pass::ImmutablePass) return false;
+		if(pass->type == Pass::ModulePass)    return false;
+	}
+
+	return !_passes.empty();
+}
+
+std::string PassManager::_pipelineSignature() const
+{
+	std::string signature;
+
+	for(auto pass : _passes)
+	{
+		if(!signature.empty()) signature += ",";
+
+		signature += pass->name;
+	}
+
+	return signature;
+}
+
+void PassManager::setInstrumentationEnabled(bool enabled)
+{
+	_instrument = enabled;
+}
+
+const PassManager::PassStatisticsVector& PassManager::statistics() const
+{
+	return _statistics;
+}
+
+void PassManager::writeStatistics(std::ostream& stream) const
+{
+	// a flat record array is simple enough to emit directly
+	stream << "[";
+
+	for(auto sample = _statistics.begin();
+		sample != _statistics.end(); ++sample)
+	{
+		if(sample != _statistics.begin()) stream << ",";
+
+		stream << "\n\t{\"pass\": \""          << sample->passName
+			<< "\", \"function\": \""          << sample->functionName
+			<< "\", \"seconds\": "             << sample->seconds
+			<< ", \"arenaBytes\": "            << sample->arenaBytes
+			<< ", \"instructionsBefore\": "    << sample->instructionsBefore
+			<< ", \"instructionsAfter\": "     << sample->instructionsAfter
+			<< "}";
+	}
+
+	stream << "\n]\n";
+}
+
+void PassManager::setWorkerCount(unsigned int workers)
+{
+	_workers = workers == 0 ? util::Executor::instance().workers() : workers;
+
+	if(_workers == 0) _workers = 1;
+}
+
+bool PassManager::_runWaveInParallel(const PassVector& wave)
+{
+	typedef std::vector<Function*> FunctionVector;
+
+	PassVector functionPasses;
+
+	for(auto pass : wave)
+	{
+		if(pass->type == Pass::ImmutablePass) continue;
+		if(pass->type == Pass::ModulePass)    continue;
+
+		functionPasses.push_back(pass);
+	}
+
+	if(functionPasses.empty()) return true;
+
+	// every pass must be recreatable by the factory so each worker can
+	// own private instances, otherwise fall back to the serial path
+	for(auto pass : functionPasses)
+	{
+		auto copy = PassFactory::createPass(pass->name);
+
+		if(copy == nullptr)
+		{
+			report(" Cannot run wave in parallel, no factory for pass '"
+				<< pass->name << "'");
+
+			return false;
+		}
+
+		delete copy;
+	}
+
+	report(" Running wave over functions on " << _workers << " workers");
+
+	// materialize serially, binary reads are not thread safe
+	FunctionVector functions;
+
+	for(auto function = _module->begin();
+		function != _module->end(); ++function)
+	{
+		function->materialize();
+
+		functions.push_back(&*function);
+	}
+
+	// functions map to memory nodes by a stable rule, so every wave
+	// touches a function's IR and analyses from the same socket
+	unsigned int nodes = util::NumaTopology::nodeCount();
+
+	if(nodes > _workers) nodes = _workers;
+
+	std::vector<FunctionVector> nodeFunctions(nodes);
+
+	for(size_t i = 0; i < functions.size(); ++i)
+	{
+		nodeFunctions[i % nodes].push_back(functions[i]);
+	}
+
+	std::unique_ptr<std::atomic<size_t>[]> nextFunction(
+		new std::atomic<size_t>[nodes]());
+
+	// workers drain their own node first, then help the others
+	auto worker = [&](unsigned int)
+	{
+		// the pool's threads are pinned round robin over the nodes, a
+		// worker starts on the queue its pages are local to
+		unsigned int node = util::Executor::currentNode() % nodes;
+
+		PassManager manager(_module);
+
+		for(auto pass : functionPasses)
+		{
+			manager.addPass(PassFactory::createPass(pass->name));
+		}
+
+		manager._extraDependences = _extraDependences;
+
+		for(unsigned int distance = 0; distance < nodes; ++distance)
+		{
+			unsigned int target = (node + distance) % nodes;
+
+			while(true)
+			{
+				size_t index = nextFunction[target]++;
+
+				if(index >= nodeFunctions[target].size()) break;
+
+				manager.runOnFunction(*nodeFunctions[target][index]);
+			}
+		}
+	};
+
+	util::Executor::instance().parallelExecute(_workers, worker);
+
+	return true;
+}
+
+void PassManager::_prepareScratch(Pass* pass)
+{
+	auto highWater = _scratchHighWater.find(pass->name);
+
+	if(highWater != _scratchHighWater.end())
+	{
+		_scratch.reserve(highWater->second);
+	}
+
+	pass->setScratchArena(&_scratch);
+}
+
+void PassManager::_releaseScratch(Pass* pass)
+{
+	auto& highWater = _scratchHighWater[pass->name];
+
+	if(_scratch.allocated() > highWater)
+	{
+		highWater = _scratch.allocated();
+	}
+
+	pass->setScratchArena(nullptr);
+}
+
 PassManager::Analysis* PassManager::getAnalysis(const std::string& type)
 {
 	assert(_analyses != 0);
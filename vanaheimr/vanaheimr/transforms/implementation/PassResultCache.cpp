@@ -0,0 +1,230 @@
+/*! \file   PassResultCache.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the PassResultCache class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/PassResultCache.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/OperandVisitor.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+#include <vanaheimr/ir/interface/Type.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+// FNV-1a, the same mixing the asm symbol tables use for interning
+static void mix(uint64_t& hash, uint64_t value)
+{
+	for(unsigned int byte = 0; byte != 8; ++byte)
+	{
+		hash ^= (value >> (8 * byte)) & 0xff;
+		hash *= 1099511628211ULL;
+	}
+}
+
+static void mix(uint64_t& hash, const std::string& string)
+{
+	for(auto character : string)
+	{
+		hash ^= (uint8_t)character;
+		hash *= 1099511628211ULL;
+	}
+
+	mix(hash, string.size());
+}
+
+/*! \brief Mixes one operand kind's payload into the running hash, the
+	kind dispatch happens once in visitOperand */
+class OperandHashVisitor
+{
+public:
+	OperandHashVisitor(uint64_t& hash) : _hash(hash) {}
+
+public:
+	void operator()(const ir::RegisterOperand& reg) const
+	{
+		mix(_hash, reg.virtualRegister == nullptr ?
+			(uint64_t)-1 : reg.virtualRegister->id);
+	}
+
+	void operator()(const ir::ImmediateOperand& immediate) const
+	{
+		mix(_hash, immediate.uint);
+		mix(_hash, immediate.dataType->name);
+	}
+
+	void operator()(const ir::PredicateOperand& predicate) const
+	{
+		mix(_hash, predicate.modifier);
+		mix(_hash, predicate.virtualRegister == nullptr ?
+			(uint64_t)-1 : predicate.virtualRegister->id);
+	}
+
+	void operator()(const ir::IndirectOperand& indirect) const
+	{
+		mix(_hash, indirect.virtualRegister == nullptr ?
+			(uint64_t)-1 : indirect.virtualRegister->id);
+		mix(_hash, (uint64_t)indirect.offset);
+	}
+
+	void operator()(const ir::AddressOperand& address) const
+	{
+		mix(_hash, address.globalValue == nullptr ?
+			std::string() : address.globalValue->name());
+	}
+
+	void operator()(const ir::ArgumentOperand& argument) const
+	{
+		mix(_hash, argument.argument == nullptr ?
+			std::string() : argument.argument->name());
+	}
+
+private:
+	uint64_t& _hash;
+};
+
+/*! \brief Mix an operand in the order the binary encoding lays it out:
+	mode tag first, then the mode's payload */
+static void mixOperand(uint64_t& hash, const ir::Operand* operand)
+{
+	if(operand == nullptr)
+	{
+		mix(hash, (uint64_t)-1);
+
+		return;
+	}
+
+	mix(hash, operand->mode());
+
+	ir::visitOperand(*operand, OperandHashVisitor(hash));
+}
+
+static void mixInstruction(uint64_t& hash,
+	const ir::Instruction* instruction)
+{
+	mix(hash, instruction->opcode);
+
+	if(instruction->isComparison())
+	{
+		mix(hash, static_cast<const ir::ComparisonInstruction*>(
+			instruction)->comparison);
+	}
+
+	mix(hash, instruction->writes.size());
+
+	for(auto write : instruction->writes)
+	{
+		mixOperand(hash, write);
+	}
+
+	mix(hash, instruction->reads.size());
+
+	for(auto read : instruction->reads)
+	{
+		mixOperand(hash, read);
+	}
+}
+
+PassResultCache::Hash PassResultCache::hashFunction(ir::Function& function)
+{
+	function.materialize();
+
+	uint64_t hash = 14695981039346656037ULL;
+
+	mix(hash, function.argument_size());
+
+	for(auto argument = function.argument_begin();
+		argument != function.argument_end(); ++argument)
+	{
+		mix(hash, argument->name());
+		mix(hash, argument->type().name);
+	}
+
+	mix(hash, function.returned_size());
+
+	for(auto value = function.returned_begin();
+		value != function.returned_end(); ++value)
+	{
+		mix(hash, value->name());
+		mix(hash, value->type().name);
+	}
+
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		mix(hash, block->name());
+		mix(hash, block->size());
+
+		for(auto instruction : *block)
+		{
+			mixInstruction(hash, instruction);
+		}
+	}
+
+	return hash;
+}
+
+bool PassResultCache::lookup(const std::string& pipeline, Hash hash,
+	ir::Function& function) const
+{
+	auto entry = _entries.find(Key(pipeline, hash));
+
+	if(entry == _entries.end()) return false;
+
+	report("Cache hit for function '" << function.name()
+		<< "' (hash 0x" << std::hex << hash << std::dec << ")");
+
+	// the body is replaced, the name and module binding are kept
+	function = *entry->second;
+
+	return true;
+}
+
+void PassResultCache::insert(const std::string& pipeline, Hash hash,
+	const ir::Function& function)
+{
+	Key key(pipeline, hash);
+
+	if(_entries.count(key) != 0) return;
+
+	report("Caching optimized body of function '" << function.name()
+		<< "' (hash 0x" << std::hex << hash << std::dec << ")");
+
+	auto artifact = _artifacts.insert(_artifacts.end(), function);
+
+	_entries.insert(std::make_pair(key, artifact));
+}
+
+size_t PassResultCache::size() const
+{
+	return _entries.size();
+}
+
+void PassResultCache::clear()
+{
+	_entries.clear();
+	_artifacts.clear();
+}
+
+}
+
+}
+
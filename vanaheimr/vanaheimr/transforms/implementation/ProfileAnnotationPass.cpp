@@ -0,0 +1,159 @@
+/*! \file   ProfileAnnotationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ProfileAnnotationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/ProfileAnnotationPass.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/ProfileMetaData.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief The on-disk profile layout, mirrored from the archaeopteryx
+	InstructionProfile dump */
+class FileHeader
+{
+public:
+	char     magic[8]; // "VIRPROF0"
+	uint64_t symbols;
+};
+
+class SymbolRecord
+{
+public:
+	char     name[64];
+	uint64_t instructions;
+};
+
+class Counter
+{
+public:
+	uint64_t executions;
+	uint64_t taken;
+};
+
+ProfileAnnotationPass::ProfileAnnotationPass()
+: ModulePass(StringVector(), "ProfileAnnotationPass")
+{
+
+}
+
+void ProfileAnnotationPass::runOnModule(Module& m)
+{
+	typedef std::vector<Counter> CounterVector;
+
+	if(profileFileName.empty()) return;
+
+	report("Annotating module '" << m.name << "' with profile '"
+		<< profileFileName << "'");
+
+	std::ifstream file(profileFileName.c_str(), std::ios::binary);
+
+	if(!file.is_open())
+	{
+		report(" could not open the profile, skipping annotation");
+
+		return;
+	}
+
+	FileHeader header;
+
+	file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+	if(!file || std::memcmp(header.magic, "VIRPROF0",
+		sizeof(header.magic)) != 0)
+	{
+		report(" not a profile file, skipping annotation");
+
+		return;
+	}
+
+	for(uint64_t symbol = 0; symbol < header.symbols; ++symbol)
+	{
+		SymbolRecord record;
+
+		file.read(reinterpret_cast<char*>(&record), sizeof(SymbolRecord));
+
+		if(!file) break;
+
+		record.name[sizeof(record.name) - 1] = '\0';
+
+		CounterVector counters(record.instructions);
+
+		file.read(reinterpret_cast<char*>(counters.data()),
+			record.instructions * sizeof(Counter));
+
+		if(!file) break;
+
+		auto function = m.getFunction(record.name);
+
+		if(function == m.end())
+		{
+			report(" no function named '" << record.name
+				<< "', skipping its record");
+
+			continue;
+		}
+
+		report(" annotating function '" << record.name << "' ("
+			<< record.instructions << " counters)");
+
+		// counters are keyed by PC, which is the position of the
+		// instruction in linear order
+		auto counter = counters.begin();
+
+		for(auto block = function->begin();
+			block != function->end() && counter != counters.end(); ++block)
+		{
+			for(auto instruction : *block)
+			{
+				if(counter == counters.end()) break;
+
+				instruction->addMetadata(new ir::ProfileMetaData(
+					counter->executions, counter->taken));
+
+				++counter;
+			}
+		}
+	}
+}
+
+void ProfileAnnotationPass::configure(const StringVector& options)
+{
+	if(!options.empty()) profileFileName = options.front();
+}
+
+Pass* ProfileAnnotationPass::clone() const
+{
+	return new ProfileAnnotationPass(*this);
+}
+
+}
+
+}
+
@@ -0,0 +1,420 @@
+/*! \file   SimplifyControlFlowPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the SimplifyControlFlowPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/SimplifyControlFlowPass.h>
+
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::ControlFlowGraph ControlFlowGraph;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::Function         Function;
+
+typedef std::unordered_map<const BasicBlock*,
+	Function::iterator> BlockIteratorMap;
+typedef std::vector<BasicBlock*> BlockVector;
+
+/*! \brief A FIFO worklist of blocks with cheap membership tests */
+class BlockWorklist
+{
+public:
+	BlockWorklist()
+	: _next(0)
+	{
+
+	}
+
+public:
+	void push(BasicBlock* block)
+	{
+		if(_members.insert(block).second) _order.push_back(block);
+	}
+
+	BasicBlock* pop()
+	{
+		while(_next < _order.size())
+		{
+			auto block = _order[_next++];
+
+			// skip entries that were erased after being queued
+			if(_members.erase(block) != 0) return block;
+		}
+
+		return nullptr;
+	}
+
+	void remove(BasicBlock* block)
+	{
+		_members.erase(block);
+	}
+
+private:
+	typedef std::unordered_set<BasicBlock*> BlockSet;
+
+private:
+	BlockVector _order;
+	BlockSet    _members;
+	size_t      _next;
+};
+
+SimplifyControlFlowPass::SimplifyControlFlowPass()
+: FunctionPass(StringVector({"ControlFlowGraph"}),
+	"SimplifyControlFlowPass")
+{
+
+}
+
+static ir::Bra* getBranch(BasicBlock* block)
+{
+	auto terminator = block->terminator();
+
+	if(terminator == nullptr)               return nullptr;
+	if(!terminator->isBranch())             return nullptr;
+	if( terminator->isCall())               return nullptr;
+	if( terminator->isMachineInstruction()) return nullptr;
+
+	return static_cast<ir::Bra*>(terminator);
+}
+
+/*! \brief Unlink register operands so that deferred destruction of arena
+	allocated instructions cannot corrupt the use chains */
+static void unlinkRegisterOperands(Instruction* instruction)
+{
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+}
+
+static void eraseInstruction(BasicBlock* block, Instruction* instruction)
+{
+	unlinkRegisterOperands(instruction);
+
+	block->erase(instruction);
+}
+
+static void removePhiSources(BasicBlock* block, BasicBlock* predecessor)
+{
+	for(auto instruction : *block)
+	{
+		if(!instruction->isPhi()) break;
+
+		static_cast<ir::Phi*>(instruction)->removeSource(predecessor);
+	}
+}
+
+static void retargetPhiSources(BasicBlock* block, BasicBlock* from,
+	BasicBlock* to)
+{
+	for(auto instruction : *block)
+	{
+		if(!instruction->isPhi()) break;
+
+		for(auto operand : static_cast<ir::Phi*>(
+			instruction)->blockOperands())
+		{
+			if(operand->globalValue == from) operand->globalValue = to;
+		}
+	}
+}
+
+/*! \brief Re-derive the outgoing edges of a block after its terminator
+	changed, requeueing every neighbor whose edges moved */
+static void recomputeSuccessors(Function& function,
+	Function::iterator block, ControlFlowGraph* cfg,
+	BlockWorklist& worklist)
+{
+	typedef ControlFlowGraph::BasicBlockSet BasicBlockSet;
+
+	BasicBlockSet successors;
+
+	auto branch = getBranch(&*block);
+
+	auto terminator = block->terminator();
+
+	if(terminator != nullptr && terminator->isReturn())
+	{
+		successors.insert(&*function.exit_block());
+	}
+
+	if(branch != nullptr)
+	{
+		successors.insert(branch->targetBasicBlock());
+	}
+
+	// mirrors analyze(), which keeps the fallthrough edge unless an
+	// unconditional branch ends the block
+	if(branch == nullptr || !branch->isUnconditional())
+	{
+		auto next = block; ++next;
+
+		if(next != function.end())
+		{
+			successors.insert(&*next);
+		}
+	}
+
+	auto existing = cfg->getSuccessors(*block);
+
+	for(auto successor : existing)
+	{
+		if(successors.count(successor) != 0) continue;
+
+		cfg->removeEdge(&*block, successor);
+
+		removePhiSources(successor, &*block);
+
+		worklist.push(successor);
+	}
+
+	for(auto successor : successors)
+	{
+		if(existing.count(successor) != 0) continue;
+
+		cfg->addEdge(&*block, successor);
+
+		worklist.push(successor);
+	}
+}
+
+/*! \brief Delete a block no edge reaches, requeueing its successors */
+static void removeUnreachableBlock(Function& function,
+	Function::iterator block, ControlFlowGraph* cfg,
+	BlockIteratorMap& iterators, BlockWorklist& worklist)
+{
+	report("  removing unreachable block '" << block->name() << "'");
+
+	auto successors = cfg->getSuccessors(*block);
+
+	for(auto successor : successors)
+	{
+		removePhiSources(successor, &*block);
+
+		worklist.push(successor);
+	}
+
+	cfg->disconnectBlock(&*block);
+
+	for(auto instruction : *block)
+	{
+		unlinkRegisterOperands(instruction);
+	}
+
+	worklist.remove(&*block);
+	iterators.erase(&*block);
+
+	function.erase(block);
+}
+
+/*! \brief Merge the unique, lexically adjacent successor into the block */
+static void mergeWithSuccessor(Function& function,
+	Function::iterator block, Function::iterator successor,
+	ControlFlowGraph* cfg, BlockIteratorMap& iterators,
+	BlockWorklist& worklist)
+{
+	report("  merging block '" << successor->name() << "' into '"
+		<< block->name() << "'");
+
+	auto branch = getBranch(&*block);
+
+	if(branch != nullptr)
+	{
+		eraseInstruction(&*block, branch);
+	}
+
+	block->splice(block->end(), *successor);
+
+	cfg->removeEdge(&*block, &*successor);
+
+	auto targets = cfg->getSuccessors(*successor);
+
+	for(auto target : targets)
+	{
+		cfg->removeEdge(&*successor, target);
+		cfg->addEdge(&*block, target);
+
+		retargetPhiSources(target, &*successor, &*block);
+
+		worklist.push(target);
+	}
+
+	worklist.remove(&*successor);
+	worklist.push(&*block);
+
+	iterators.erase(&*successor);
+
+	function.erase(successor);
+}
+
+static bool simplifyBlock(Function& function, Function::iterator block,
+	ControlFlowGraph* cfg, BlockIteratorMap& iterators,
+	BlockWorklist& worklist)
+{
+	// unreachable blocks are deleted outright
+	if(cfg->getPredecessors(*block).empty())
+	{
+		removeUnreachableBlock(function, block, cfg, iterators, worklist);
+
+		return true;
+	}
+
+	bool changed = false;
+
+	auto branch = getBranch(&*block);
+
+	// a branch that can never be taken is erased
+	if(branch != nullptr &&
+		branch->guard()->modifier == PredicateOperand::PredicateFalse)
+	{
+		report("  erasing never-taken branch in block '"
+			<< block->name() << "'");
+
+		eraseInstruction(&*block, branch);
+
+		recomputeSuccessors(function, block, cfg, worklist);
+
+		changed = true;
+		branch  = nullptr;
+	}
+
+	// a branch to the next block is a fallthrough
+	if(branch != nullptr && branch->isUnconditional())
+	{
+		auto next = block; ++next;
+
+		if(next != function.end() &&
+			branch->targetBasicBlock() == &*next)
+		{
+			report("  erasing branch to next block in '"
+				<< block->name() << "'");
+
+			eraseInstruction(&*block, branch);
+
+			recomputeSuccessors(function, block, cfg, worklist);
+
+			changed = true;
+		}
+	}
+
+	// merge a unique, lexically adjacent successor with no other
+	// predecessors, phis in it would be degenerate but are left alone
+	auto successors = cfg->getSuccessors(*block);
+
+	if(successors.size() == 1)
+	{
+		auto successor = *successors.begin();
+
+		auto next = block; ++next;
+
+		if(next != function.end() && successor == &*next &&
+			successor != &*function.exit_block()  &&
+			successor != &*function.entry_block() &&
+			successor != &*block                  &&
+			cfg->getPredecessors(*successor).size() == 1 &&
+			(successor->empty() || !successor->front()->isPhi()))
+		{
+			auto successorIterator = iterators.find(successor);
+			assert(successorIterator != iterators.end());
+
+			mergeWithSuccessor(function, block,
+				successorIterator->second, cfg, iterators, worklist);
+
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+void SimplifyControlFlowPass::runOnFunction(Function& f)
+{
+	report("Simplifying control flow in function '" << f.name() << "'");
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	BlockIteratorMap iterators;
+	BlockWorklist    worklist;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		iterators[&*block] = block;
+
+		worklist.push(&*block);
+	}
+
+	bool changed = false;
+
+	while(auto block = worklist.pop())
+	{
+		// the sentinel blocks are never simplified
+		if(block == &*f.entry_block()) continue;
+		if(block == &*f.exit_block())  continue;
+
+		auto iterator = iterators.find(block);
+		assert(iterator != iterators.end());
+
+		changed |= simplifyBlock(f, iterator->second, cfg,
+			iterators, worklist);
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DominatorAnalysis");
+		invalidateAnalysis("LoopAnalysis");
+	}
+}
+
+Pass* SimplifyControlFlowPass::clone() const
+{
+	return new SimplifyControlFlowPass;
+}
+
+}
+
+}
+
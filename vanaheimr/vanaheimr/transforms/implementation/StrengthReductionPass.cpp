@@ -0,0 +1,397 @@
+/*! \file   StrengthReductionPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the StrengthReductionPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/StrengthReductionPass.h>
+
+#include <vanaheimr/analysis/interface/InductionVariableAnalysis.h>
+#include <vanaheimr/analysis/interface/LoopAnalysis.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::InductionVariableAnalysis InductionVariableAnalysis;
+typedef analysis::LoopAnalysis              LoopAnalysis;
+typedef analysis::ControlFlowGraph          ControlFlowGraph;
+
+typedef InductionVariableAnalysis::InductionVariable InductionVariable;
+typedef LoopAnalysis::Loop Loop;
+
+typedef ir::BasicBlock       BasicBlock;
+typedef ir::Instruction      Instruction;
+typedef ir::RegisterOperand  RegisterOperand;
+typedef ir::ImmediateOperand ImmediateOperand;
+typedef ir::PredicateOperand PredicateOperand;
+typedef ir::VirtualRegister  VirtualRegister;
+typedef ir::Function         Function;
+
+typedef std::vector<RegisterOperand*> OperandVector;
+
+StrengthReductionPass::StrengthReductionPass()
+: FunctionPass(StringVector({"InductionVariableAnalysis", "LoopAnalysis",
+	"ControlFlowGraph"}), "StrengthReductionPass")
+{
+
+}
+
+/*! \brief The unique out of loop predecessor of the header, it must
+	branch nowhere else so initial values only run entering the loop */
+static BasicBlock* getPreheader(const Loop& loop, ControlFlowGraph* cfg)
+{
+	BasicBlock* preheader = nullptr;
+
+	auto predecessors = cfg->getPredecessors(*loop.header);
+
+	for(auto predecessor : predecessors)
+	{
+		if(loop.contains(predecessor)) continue;
+
+		if(preheader != nullptr) return nullptr;
+
+		preheader = predecessor;
+	}
+
+	if(preheader == nullptr) return nullptr;
+
+	if(cfg->getSuccessors(*preheader).size() != 1) return nullptr;
+
+	return preheader;
+}
+
+static void unlinkAndErase(Instruction* instruction)
+{
+	// unlink explicitly, arena-allocated instructions defer destructors
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+
+	instruction->eraseFromBlock();
+}
+
+/*! \brief Retarget every use of a value outside the skipped
+	instructions, the use list is copied first since retargeting
+	rewrites it */
+static void replaceUses(VirtualRegister* value, VirtualRegister* replacement,
+	const Instruction* skip = nullptr, const Instruction* alsoSkip = nullptr)
+{
+	OperandVector uses;
+
+	for(auto use = value->firstUse(); use != nullptr; use = use->nextUse())
+	{
+		if(use->instruction == skip)     continue;
+		if(use->instruction == alsoSkip) continue;
+
+		uses.push_back(use);
+	}
+
+	for(auto use : uses)
+	{
+		use->setVirtualRegister(replacement);
+	}
+}
+
+/*! \brief A multiply or shift of an induction variable by an immediate */
+class Candidate
+{
+public:
+	Instruction*             instruction;
+	const InductionVariable* variable;
+	int64_t                  scaledStep; // the derived variable's step
+};
+
+typedef std::vector<Candidate> CandidateVector;
+
+static bool matchCandidate(Instruction* instruction,
+	const InductionVariableAnalysis::InductionVariableVector& variables,
+	Candidate& candidate)
+{
+	bool isMul = instruction->opcode == Instruction::Mul;
+	bool isShl = instruction->opcode == Instruction::Shl;
+
+	if(!isMul && !isShl)               return false;
+	if(instruction->reads.size() != 3) return false;
+	if(instruction->writes.size() != 1) return false;
+
+	if(instruction->guard() == nullptr)       return false;
+	if(!instruction->guard()->isAlwaysTrue()) return false;
+
+	const RegisterOperand*  value     = nullptr;
+	const ImmediateOperand* immediate = nullptr;
+
+	if(instruction->reads[1]->isRegister() &&
+		instruction->reads[2]->isImmediate())
+	{
+		value = static_cast<const RegisterOperand*>(instruction->reads[1]);
+		immediate = static_cast<const ImmediateOperand*>(
+			instruction->reads[2]);
+	}
+	else if(isMul && instruction->reads[2]->isRegister() &&
+		instruction->reads[1]->isImmediate())
+	{
+		// shifts are not commutative, only the multiply may swap
+		value = static_cast<const RegisterOperand*>(instruction->reads[2]);
+		immediate = static_cast<const ImmediateOperand*>(
+			instruction->reads[1]);
+	}
+	else
+	{
+		return false;
+	}
+
+	for(auto& variable : variables)
+	{
+		if(value->virtualRegister != variable.value) continue;
+
+		candidate.instruction = instruction;
+		candidate.variable    = &variable;
+		candidate.scaledStep  = isMul
+			? variable.step * (int64_t)immediate->uint
+			: variable.step << immediate->uint;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*! \brief Turn the candidate into its own induction variable */
+static void reduceCandidate(Function& f, const Candidate& candidate,
+	BasicBlock* preheader)
+{
+	auto& variable    = *candidate.variable;
+	auto  instruction = candidate.instruction;
+
+	report("  reducing '" << instruction->toString() << "'");
+
+	auto destination = static_cast<RegisterOperand*>(
+		instruction->writes[0])->virtualRegister;
+
+	auto type = destination->type;
+
+	auto initial = &*f.newVirtualRegister(type);
+	auto value   = &*f.newVirtualRegister(type);
+	auto next    = &*f.newVirtualRegister(type);
+
+	// the initial product runs once in the preheader
+	auto init = instruction->clone();
+
+	init->block = preheader;
+
+	for(auto read : init->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		auto registerOperand = static_cast<RegisterOperand*>(read);
+
+		if(registerOperand->virtualRegister == variable.value)
+		{
+			registerOperand->setVirtualRegister(variable.initial);
+		}
+	}
+
+	static_cast<RegisterOperand*>(init->writes[0])->setVirtualRegister(
+		initial);
+
+	auto position = preheader->end();
+
+	if(preheader->terminator() != nullptr) --position;
+
+	preheader->insert(position, init);
+
+	// the recurrence cycles through a header phi
+	auto phi = new ir::Phi(variable.loop->header);
+
+	phi->setGuard(new PredicateOperand(
+		PredicateOperand::PredicateTrue, phi));
+	phi->setD(new RegisterOperand(value, phi));
+	phi->addSource(new RegisterOperand(initial, phi),
+		new ir::AddressOperand(preheader, phi));
+	phi->addSource(new RegisterOperand(next, phi),
+		new ir::AddressOperand(variable.latchBlock, phi));
+
+	variable.loop->header->insert(variable.loop->header->begin(), phi);
+
+	// the back edge value advances by the scaled step, right after the
+	// original variable advances so it dominates the latch
+	auto advance = new ir::Add;
+
+	advance->setGuard(new PredicateOperand(
+		PredicateOperand::PredicateTrue, advance));
+	advance->setD(new RegisterOperand(next, advance));
+	advance->setA(new RegisterOperand(value, advance));
+	advance->setB(new ImmediateOperand(
+		(uint64_t)candidate.scaledStep, advance, type));
+
+	auto advanceBlock = variable.advance->block;
+
+	auto advancePosition = advanceBlock->begin();
+
+	while(*advancePosition != variable.advance) ++advancePosition;
+
+	++advancePosition;
+
+	advance->block = advanceBlock;
+
+	advanceBlock->insert(advancePosition, advance);
+
+	// the body reads the recurrence now, the multiply disappears
+	replaceUses(destination, value, instruction);
+
+	unlinkAndErase(instruction);
+}
+
+/*! \brief Fold induction variables advancing identically into one phi */
+static bool coalesceVariables(
+	const InductionVariableAnalysis::InductionVariableVector& variables)
+{
+	bool changed = false;
+
+	std::vector<bool> folded(variables.size(), false);
+
+	for(unsigned int keep = 0; keep != variables.size(); ++keep)
+	{
+		if(folded[keep]) continue;
+
+		auto& keeper = variables[keep];
+
+		for(unsigned int fold = keep + 1; fold != variables.size(); ++fold)
+		{
+			if(folded[fold]) continue;
+
+			auto& duplicate = variables[fold];
+
+			if(duplicate.initial != keeper.initial)         continue;
+			if(duplicate.step != keeper.step)               continue;
+			if(duplicate.value->type != keeper.value->type) continue;
+
+			report("  coalescing '" << duplicate.value->toString()
+				<< "' into '" << keeper.value->toString() << "'");
+
+			replaceUses(duplicate.value, keeper.value,
+				duplicate.phi, duplicate.advance);
+			replaceUses(duplicate.next, keeper.next,
+				duplicate.phi, duplicate.advance);
+
+			unlinkAndErase(duplicate.phi);
+			unlinkAndErase(duplicate.advance);
+
+			folded[fold] = true;
+
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+void StrengthReductionPass::runOnFunction(Function& f)
+{
+	auto loops = static_cast<LoopAnalysis*>(getAnalysis("LoopAnalysis"));
+	assert(loops != nullptr);
+
+	if(loops->empty()) return;
+
+	auto inductionVariables = static_cast<InductionVariableAnalysis*>(
+		getAnalysis("InductionVariableAnalysis"));
+	assert(inductionVariables != nullptr);
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	report("Running strength reduction on '" << f.name() << "'");
+
+	bool changed = false;
+
+	for(auto& loop : *loops)
+	{
+		auto variables = inductionVariables->getInductionVariables(loop);
+
+		if(variables.empty()) continue;
+
+		auto preheader = getPreheader(loop, cfg);
+
+		if(preheader == nullptr) continue;
+
+		report(" loop at '" << loop.header->name() << "' with "
+			<< variables.size() << " induction variables");
+
+		CandidateVector candidates;
+
+		for(auto block : loop.blocks)
+		{
+			for(auto instruction : *block)
+			{
+				Candidate candidate;
+
+				if(matchCandidate(instruction, variables, candidate))
+				{
+					candidates.push_back(candidate);
+				}
+			}
+		}
+
+		for(auto& candidate : candidates)
+		{
+			reduceCandidate(f, candidate, preheader);
+
+			changed = true;
+		}
+
+		changed |= coalesceVariables(variables);
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DependenceAnalysis");
+		invalidateAnalysis("LiveRangeAnalysis");
+		invalidateAnalysis("RegisterPressureAnalysis");
+		invalidateAnalysis("InductionVariableAnalysis");
+	}
+}
+
+Pass* StrengthReductionPass::clone() const
+{
+	return new StrengthReductionPass;
+}
+
+}
+
+}
@@ -0,0 +1,340 @@
+/*! \file   SuperblockFormationPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the SuperblockFormationPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/SuperblockFormationPass.h>
+
+#include <vanaheimr/analysis/interface/BlockFrequencyAnalysis.h>
+#include <vanaheimr/analysis/interface/ControlFlowGraph.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+typedef analysis::BlockFrequencyAnalysis BlockFrequencyAnalysis;
+typedef analysis::ControlFlowGraph       ControlFlowGraph;
+
+typedef ir::BasicBlock      BasicBlock;
+typedef ir::Instruction     Instruction;
+typedef ir::RegisterOperand RegisterOperand;
+typedef ir::Function        Function;
+
+typedef std::unordered_map<const BasicBlock*,
+	Function::iterator> BlockIteratorMap;
+typedef std::unordered_set<const BasicBlock*> BlockSet;
+typedef std::vector<BasicBlock*> BlockVector;
+
+SuperblockFormationPass::SuperblockFormationPass()
+: FunctionPass(StringVector({"BlockFrequencyAnalysis", "ControlFlowGraph"}),
+	"SuperblockFormationPass"), _duplicationBudget(64), _hotFraction(0.5)
+{
+
+}
+
+void SuperblockFormationPass::configure(const StringVector& options)
+{
+	for(auto& option : options)
+	{
+		if(option.compare(0, 7, "budget=") == 0)
+		{
+			_duplicationBudget = std::atoi(option.c_str() + 7);
+		}
+
+		if(option.compare(0, 4, "hot=") == 0)
+		{
+			_hotFraction = std::atof(option.c_str() + 4);
+		}
+	}
+}
+
+static ir::Bra* getBranch(BasicBlock* block)
+{
+	auto terminator = block->terminator();
+
+	if(terminator == nullptr)          return nullptr;
+	if(!terminator->isBranch())        return nullptr;
+	if(terminator->isCall())           return nullptr;
+	if(terminator->isMachineInstruction()) return nullptr;
+
+	return static_cast<ir::Bra*>(terminator);
+}
+
+static void unlinkRegisterOperands(Instruction* instruction)
+{
+	for(auto read : instruction->reads)
+	{
+		if(read == nullptr || !read->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(read)->setVirtualRegister(nullptr);
+	}
+
+	for(auto write : instruction->writes)
+	{
+		if(write == nullptr || !write->isRegister()) continue;
+
+		static_cast<RegisterOperand*>(write)->setVirtualRegister(nullptr);
+	}
+}
+
+static void eraseInstruction(BasicBlock* block, Instruction* instruction)
+{
+	unlinkRegisterOperands(instruction);
+
+	block->erase(instruction);
+}
+
+/*! \brief Does duplicating the definitions need register renaming? */
+static bool hasPhis(Function& function)
+{
+	for(auto block = function.begin(); block != function.end(); ++block)
+	{
+		if(block->empty()) continue;
+
+		if((*block->begin())->isPhi()) return true;
+	}
+
+	return false;
+}
+
+/*! \brief Does control leave the block without relying on fallthrough
+	to the lexically next block? */
+static bool exitsExplicitly(BasicBlock* block)
+{
+	auto branch = getBranch(block);
+
+	if(branch != nullptr) return branch->isUnconditional();
+
+	auto terminator = block->terminator();
+
+	return terminator != nullptr && terminator->isReturn();
+}
+
+/*! \brief The single block the trace continues at, nullptr when the
+	head ends in a conditional branch or a return */
+static BasicBlock* getLinkTarget(Function& function, Function::iterator head)
+{
+	auto branch = getBranch(&*head);
+
+	if(branch != nullptr)
+	{
+		if(!branch->isUnconditional()) return nullptr;
+
+		return branch->targetBasicBlock();
+	}
+
+	auto terminator = head->terminator();
+
+	if(terminator != nullptr && terminator->isReturn()) return nullptr;
+
+	auto next = head; ++next;
+
+	if(next == function.end()) return nullptr;
+
+	return &*next;
+}
+
+/*! \brief Absorb the tail, the head's unique successor, into the head */
+static void mergeTail(Function& function, Function::iterator head,
+	Function::iterator tail, ControlFlowGraph* cfg)
+{
+	report("  merging block '" << tail->name() << "' into '"
+		<< head->name() << "'");
+
+	auto branch = getBranch(&*head);
+
+	if(branch != nullptr)
+	{
+		eraseInstruction(&*head, branch);
+	}
+
+	head->splice(head->end(), *tail);
+
+	cfg->removeEdge(&*head, &*tail);
+
+	auto targets = cfg->getSuccessors(*tail);
+
+	for(auto target : targets)
+	{
+		cfg->removeEdge(&*tail, target);
+		cfg->addEdge(&*head, target);
+	}
+
+	function.erase(tail);
+}
+
+/*! \brief Append a copy of the tail to the head, leaving the original
+	in place for its other predecessors */
+static void duplicateTail(Function::iterator head, BasicBlock* tail,
+	ControlFlowGraph* cfg)
+{
+	report("  duplicating block '" << tail->name() << "' into '"
+		<< head->name() << "' (" << tail->size() << " instructions)");
+
+	auto branch = getBranch(&*head);
+
+	if(branch != nullptr)
+	{
+		eraseInstruction(&*head, branch);
+	}
+
+	for(auto instruction : *tail)
+	{
+		head->push_back(instruction->clone());
+	}
+
+	cfg->removeEdge(&*head, tail);
+
+	auto targets = cfg->getSuccessors(*tail);
+
+	for(auto target : targets)
+	{
+		cfg->addEdge(&*head, target);
+	}
+}
+
+void SuperblockFormationPass::runOnFunction(Function& f)
+{
+	// duplicated definitions would need renaming in SSA form
+	if(hasPhis(f)) return;
+
+	report("Forming superblocks in function '" << f.name() << "'");
+
+	auto cfg = static_cast<ControlFlowGraph*>(
+		getAnalysis("ControlFlowGraph"));
+	assert(cfg != nullptr);
+
+	auto frequencies = static_cast<BlockFrequencyAnalysis*>(
+		getAnalysis("BlockFrequencyAnalysis"));
+	assert(frequencies != nullptr);
+
+	BlockIteratorMap iterators;
+	BlockVector      seeds;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		iterators[&*block] = block;
+
+		if(block == f.entry_block()) continue;
+		if(block == f.exit_block())  continue;
+
+		seeds.push_back(&*block);
+	}
+
+	// traces are grown hottest first, so the hot path gets the budget
+	std::sort(seeds.begin(), seeds.end(),
+		[=](const BasicBlock* left, const BasicBlock* right)
+		{
+			return frequencies->getFrequency(*left) >
+				frequencies->getFrequency(*right);
+		});
+
+	double hotThreshold = _hotFraction * frequencies->maxFrequency();
+
+	unsigned int budget = _duplicationBudget;
+
+	BlockSet visited;
+
+	bool changed = false;
+
+	for(auto seed : seeds)
+	{
+		if(visited.count(seed) != 0) continue;
+
+		auto head = iterators.find(seed)->second;
+
+		visited.insert(seed);
+
+		report(" growing trace at '" << head->name() << "'");
+
+		while(true)
+		{
+			auto tail = getLinkTarget(f, head);
+
+			if(tail == nullptr)            break;
+			if(tail == &*head)             break;
+			if(tail == &*f.entry_block())  break;
+			if(tail == &*f.exit_block())   break;
+			if(visited.count(tail) != 0)   break;
+
+			auto tailIterator = iterators.find(tail)->second;
+
+			auto next = head; ++next;
+
+			bool adjacent = next == tailIterator;
+
+			if(cfg->getPredecessors(*tail).size() == 1)
+			{
+				// merging moves the tail's implicit fallthrough edge
+				// unless the head sits directly above it
+				if(!exitsExplicitly(tail) && !adjacent) break;
+
+				mergeTail(f, head, tailIterator, cfg);
+
+				iterators.erase(tail);
+			}
+			else
+			{
+				// the copy lands at the head, a fallthrough out of the
+				// tail would resolve to the wrong block there
+				if(!exitsExplicitly(tail))  break;
+
+				if(frequencies->getFrequency(*tail) < hotThreshold) break;
+
+				if(tail->size() > budget) break;
+
+				duplicateTail(head, tail, cfg);
+
+				budget -= tail->size();
+			}
+
+			visited.insert(tail);
+
+			changed = true;
+		}
+	}
+
+	if(changed)
+	{
+		invalidateAnalysis("DataflowAnalysis");
+		invalidateAnalysis("DominatorAnalysis");
+		invalidateAnalysis("LoopAnalysis");
+		invalidateAnalysis("BranchProbabilityAnalysis");
+		invalidateAnalysis("BlockFrequencyAnalysis");
+	}
+}
+
+Pass* SuperblockFormationPass::clone() const
+{
+	return new SuperblockFormationPass(*this);
+}
+
+}
+
+}
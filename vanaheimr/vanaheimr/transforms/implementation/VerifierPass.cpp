@@ -0,0 +1,217 @@
+/*! \file   VerifierPass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the VerifierPass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/VerifierPass.h>
+#include <vanaheimr/transforms/interface/PassResultCache.h>
+
+#include <vanaheimr/ir/interface/Function.h>
+#include <vanaheimr/ir/interface/BasicBlock.h>
+#include <vanaheimr/ir/interface/Instruction.h>
+#include <vanaheimr/ir/interface/Operand.h>
+#include <vanaheimr/ir/interface/VirtualRegister.h>
+
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <stdexcept>
+#include <sstream>
+
+// Preprocessor Macros
+#ifdef REPORT_BASE
+#undef REPORT_BASE
+#endif
+
+#define REPORT_BASE 0
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+VerifierPass::VerifierPass()
+: FunctionPass(StringVector(), "VerifierPass"), _incremental(true)
+{
+
+}
+
+void VerifierPass::configure(const StringVector& options)
+{
+	for(auto& option : options)
+	{
+		if(option == "full")        _incremental = false;
+		if(option == "incremental") _incremental = true;
+	}
+}
+
+void VerifierPass::runOnFunction(Function& f)
+{
+	uint64_t hash = PassResultCache::hashFunction(f);
+
+	if(_incremental)
+	{
+		auto verified = _verified.find(f.name());
+
+		if(verified != _verified.end() && verified->second == hash)
+		{
+			report("Skipping verification of unchanged function '"
+				<< f.name() << "'");
+
+			return;
+		}
+	}
+
+	_verify(f);
+
+	_verified[f.name()] = hash;
+}
+
+static void fail(const ir::Function& function, const ir::BasicBlock& block,
+	const std::string& message)
+{
+	std::stringstream stream;
+
+	stream << "Verification failed in function '" << function.name()
+		<< "', block '" << block.name() << "': " << message;
+
+	throw std::runtime_error(stream.str());
+}
+
+void VerifierPass::_verify(Function& f)
+{
+	report("Verifying function '" << f.name() << "'");
+
+	typedef std::unordered_map<ir::VirtualRegister::Id,
+		unsigned int> DefinitionCountMap;
+
+	DefinitionCountMap definitions;
+
+	bool inSsaForm = false;
+
+	for(auto block = f.begin(); block != f.end(); ++block)
+	{
+		for(auto entry = block->begin(); entry != block->end(); ++entry)
+		{
+			ir::Instruction* instruction = *entry;
+
+			if(instruction == nullptr)
+			{
+				fail(f, *block, "null instruction in block");
+			}
+
+			if(instruction->block != &*block)
+			{
+				fail(f, *block, "instruction '" + instruction->toString()
+					+ "' does not point back at its block");
+			}
+
+			// only a terminator may branch
+			if(instruction->isBranch() &&
+				instruction != block->terminator())
+			{
+				fail(f, *block, "branch '" + instruction->toString()
+					+ "' is not the block terminator");
+			}
+
+			if(instruction->isPhi()) inSsaForm = true;
+
+			for(auto write : instruction->writes)
+			{
+				if(write == nullptr)
+				{
+					fail(f, *block, "null write operand in '"
+						+ instruction->toString() + "'");
+				}
+
+				if(write->instruction != instruction)
+				{
+					fail(f, *block, "write operand of '"
+						+ instruction->toString()
+						+ "' does not point back at its instruction");
+				}
+
+				if(write->isRegister())
+				{
+					auto reg = static_cast<ir::RegisterOperand*>(
+						write)->virtualRegister;
+
+					if(reg != nullptr)
+					{
+						if(reg->function != &f)
+						{
+							fail(f, *block, "write operand of '"
+								+ instruction->toString() + "' references a "
+								"register owned by another function");
+						}
+
+						++definitions[reg->id];
+					}
+				}
+			}
+
+			for(auto read : instruction->reads)
+			{
+				if(read == nullptr)
+				{
+					fail(f, *block, "null read operand in '"
+						+ instruction->toString() + "'");
+				}
+
+				if(read->instruction != instruction)
+				{
+					fail(f, *block, "read operand of '"
+						+ instruction->toString()
+						+ "' does not point back at its instruction");
+				}
+
+				if(read->isRegister())
+				{
+					auto reg = static_cast<ir::RegisterOperand*>(
+						read)->virtualRegister;
+
+					if(reg != nullptr && reg->function != &f)
+					{
+						fail(f, *block, "read operand of '"
+							+ instruction->toString() + "' references a "
+							"register owned by another function");
+					}
+				}
+			}
+		}
+	}
+
+	// phis mark the function as being in SSA form, every register then
+	// has exactly one definition
+	if(inSsaForm)
+	{
+		for(auto& definition : definitions)
+		{
+			if(definition.second > 1)
+			{
+				std::stringstream stream;
+
+				stream << "Verification failed in function '" << f.name()
+					<< "': register r" << definition.first << " has "
+					<< definition.second << " definitions in SSA form";
+
+				throw std::runtime_error(stream.str());
+			}
+		}
+	}
+
+	report(" verified");
+}
+
+Pass* VerifierPass::clone() const
+{
+	return new VerifierPass(*this);
+}
+
+}
+
+}
@@ -1 +1,43 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   ConstantPropagationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ConstantPropagationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Sparse conditional constant propagation.
+
+	Runs the classic SCCP engine: lattice cells are tracked only for
+	registers in reachable blocks, edges become executable as branch
+	conditions resolve, and the two worklists (blocks and changed
+	registers) keep the cost proportional to what actually changes.
+	After the fixed point, constant reads are replaced by immediates,
+	decided branches are folded and unreachable blocks are emptied so
+	downstream passes see a smaller CFG. */
+class ConstantPropagationPass : public FunctionPass
+{
+public:
+	ConstantPropagationPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+};
+
+}
+
+}
+
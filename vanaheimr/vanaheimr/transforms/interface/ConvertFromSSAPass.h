@@ -30,12 +30,13 @@ public:
 	virtual Pass* clone() const;
 
 private:
+	/*! \brief Merge phi sources into their destinations when the combined
+		live ranges do not interfere, eliminating the copies entirely */
+	void _coalescePhis(Function& f);
+
 	void _removePhis(Function& f);
 	void _removePsis(Function& f);
 
-private:
-	void _removePhis(ir::BasicBlock& block);
-
 private:
 	void _removePsi(ir::Psi& psi);
 
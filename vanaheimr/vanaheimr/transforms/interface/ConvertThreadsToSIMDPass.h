@@ -9,27 +9,62 @@
 // Vanahimer Includes
 #include <vanaheimr/transforms/interface/Pass.h>
 
+// Standard Library Includes
+#include <vector>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class BasicBlock; } }
+
 namespace vanaheimr
 {
 
 namespace transforms
 {
 
+/*! \brief Chooses between SIMD and scalar thread execution per region.
+
+	The function is partitioned into regions along reconvergence points,
+	and each region is costed in both execution modes using the machine
+	model's lane width and a divergence estimate driven by thread
+	frontier sizes.  Regions where divergence would serialize away the
+	lane parallelism stay scalar, the rest are marked for SIMD
+	execution.  Lowering consults getExecutionMode when emitting code
+	for a block. */
 class ConvertThreadsToSIMDPass : public FunctionPass
 {
+public:
+	/*! \brief The execution mode chosen for a region of blocks */
+	enum ExecutionMode
+	{
+		Scalar = 0,
+		SIMD   = 1
+	};
+
 public:
 	ConvertThreadsToSIMDPass();
-	
+
 public:
 	virtual void runOnFunction(Function& f);
 
 public:
 	virtual Pass* clone() const;
 
+public:
+	/*! \brief Get the execution mode chosen for the block's region.
+
+		Blocks the pass has not seen default to Scalar */
+	ExecutionMode getExecutionMode(const ir::BasicBlock& block) const;
+
+private:
+	typedef std::vector<ExecutionMode> ExecutionModeVector;
+
+private:
+	ExecutionModeVector _modes; // indexed by block id
+
 };
 
 }
 
 }
 
- 
+
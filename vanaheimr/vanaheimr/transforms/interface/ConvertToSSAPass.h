@@ -61,11 +61,13 @@ private:
 	typedef util::SmallMap<VirtualRegister*, VirtualRegister*>
 		VirtualRegisterMap;
 
+	typedef std::vector<VirtualRegister*> VirtualRegisterVector;
+
 private:
 	void _insertPhis(Function& f);
 	void _insertPsis(Function& f);
-	
-	void _insertPhi(VirtualRegister& vr, BasicBlock& block);
+
+	void _insertPhis(BasicBlock& block, const VirtualRegisterVector& values);
 
 private:
 	void _rename(Function& f);
@@ -7,7 +7,7 @@
 #pragma once
 
 // Vanaheimr Includes
-#include <vanaheimr/transforms/include/Pass.h>
+#include <vanaheimr/transforms/interface/Pass.h>
 
 namespace vanaheimr
 {
@@ -15,6 +15,12 @@ namespace vanaheimr
 namespace transforms
 {
 
+/*! \brief Removes instructions whose results are never used.
+
+	Uses the classic worklist formulation: the list is seeded with
+	trivially dead definitions and deletions propagate backwards through
+	the use-def chains, so the cost is proportional to the amount of dead
+	code removed rather than to function size times iterations. */
 class DeadCodeEliminationPass : public FunctionPass
 {
 public:
@@ -1 +1,74 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   FunctionInliningPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the FunctionInliningPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+// Standard Library Includes
+#include <unordered_map>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Function; } }
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Inlines small functions into their callers.
+
+	Functions are processed bottom-up over the strongly connected
+	components of the CallGraphAnalysis, so every callee is finalized
+	and summarized (size, register pressure) exactly once before any
+	of its callers look at it.  A decision per call site is then a
+	cached summary lookup.  Recursive cycles are never inlined */
+class FunctionInliningPass : public ModulePass
+{
+public:
+	FunctionInliningPass();
+
+public:
+	virtual void runOnModule(Module& m);
+
+public:
+	virtual Pass* clone() const;
+
+public:
+	/*! \brief The largest callee body worth duplicating, instructions */
+	unsigned int inliningThreshold;
+
+	/*! \brief The largest callee peak live value count worth duplicating.
+
+		Inlining a high pressure callee pushes the caller toward spilling,
+		which costs more than the call being removed.  Defaults to half
+		the machine register file */
+	unsigned int pressureThreshold;
+
+private:
+	/*! \brief A cached measurement of a finalized function */
+	class FunctionSummary
+	{
+	public:
+		unsigned int size;
+		unsigned int registerPressure;
+	};
+
+	typedef std::unordered_map<const ir::Function*, FunctionSummary>
+		FunctionSummaryMap;
+
+private:
+	bool _inlineCallsIn(ir::Function& function,
+		const FunctionSummaryMap& summaries);
+
+};
+
+}
+
+}
+
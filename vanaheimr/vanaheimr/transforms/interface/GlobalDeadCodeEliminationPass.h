@@ -0,0 +1,51 @@
+/*! \file   GlobalDeadCodeEliminationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the GlobalDeadCodeEliminationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Removes functions and globals that no entry point can reach.
+
+	Linked modules drag every utility function and global from the
+	input through the whole pipeline and into the final binary, where
+	the simulator then pages them in.  The pass seeds liveness from
+	the kernel entry points (the functions the archaeopteryx ABI can
+	actually launch) and from globals the ABI binds by name, follows
+	every direct call and address reference transitively, and erases
+	the rest of the module.  Running it first shrinks everything
+	downstream.  A module with no kernels is treated as a library and
+	left alone */
+class GlobalDeadCodeEliminationPass : public ModulePass
+{
+public:
+	GlobalDeadCodeEliminationPass();
+
+public:
+	virtual void runOnModule(Module& m);
+
+public:
+	/*! \brief Recognized options: "keep=name" roots the named function
+		or global in addition to the kernel entry points */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	StringVector _keptSymbols;
+};
+
+}
+
+}
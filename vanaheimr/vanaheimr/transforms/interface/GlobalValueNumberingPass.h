@@ -1 +1,41 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   GlobalValueNumberingPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the GlobalValueNumberingPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Eliminates redundant computations by value numbering.
+
+	Walks the dominator tree with a scoped open-addressing hash table:
+	entering a block pushes a scope, leaving it pops the scope, so every
+	lookup only sees expressions computed by dominators.  Expression keys
+	are flat word arrays carved out of an arena, no per-candidate node
+	allocations or ordered-map lookups. */
+class GlobalValueNumberingPass : public FunctionPass
+{
+public:
+	GlobalValueNumberingPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+};
+
+}
+
+}
+
@@ -0,0 +1,51 @@
+/*! \file   IfConversionPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the IfConversionPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Replaces small branchy diamonds with predicated code.
+
+	Every VIR instruction carries a guard, so a conditional branch over
+	a few instructions can become straight line code guarded by the
+	branch predicate and its inverse.  Triangles and diamonds are
+	converted when the legs are small, unguarded, free of control flow,
+	and do not redefine the predicate.  ThreadFrontierAnalysis supplies
+	the divergence estimate - only branches whose legs can actually
+	leave threads waiting at a frontier are converted, a uniform branch
+	costs the simulator nothing and keeps its dynamic instruction count.
+	Runs on non-SSA form, functions containing phis are left alone */
+class IfConversionPass : public FunctionPass
+{
+public:
+	IfConversionPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	/*! \brief Recognized options: "size=N" the largest leg, in
+		instructions, worth predicating */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	unsigned int _maxLegSize;
+};
+
+}
+
+}
@@ -0,0 +1,52 @@
+/*! \file   LoopInvariantCodeMotionPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LoopInvariantCodeMotionPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Hoists loop invariant computations into loop preheaders.
+
+	An instruction is invariant when it is pure, unguarded, reads no
+	register defined in the loop, and is the only definition of its
+	results in the loop with none of them live into the header.  Loads
+	in the header are hoisted too when AliasAnalysis proves no store in
+	the loop can touch them.  Hoisting extends live ranges across the
+	whole loop, so it stops once the register pressure estimate for the
+	header plus the hoisted values reaches a configurable limit - the
+	allocator spilling inside the loop would cost more than the saved
+	recomputation.  Innermost loops are processed first so invariants
+	bubble outward one nest level per hoisting round */
+class LoopInvariantCodeMotionPass : public FunctionPass
+{
+public:
+	LoopInvariantCodeMotionPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	/*! \brief Recognized options: "pressure=N" the live value limit
+		that stops hoisting */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	unsigned int _pressureLimit;
+};
+
+}
+
+}
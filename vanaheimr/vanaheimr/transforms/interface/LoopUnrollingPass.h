@@ -1 +1,85 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   LoopUnrollingPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the LoopUnrollingPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+// Standard Library Includes
+#include <cstdint>
+
+// Forward Declarations
+namespace vanaheimr { namespace machine { class MachineModel; } }
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Chooses unroll factors from loop size and trip count.
+
+	The budget is tied to the machine model: wider register files leave
+	headroom for the extra live ranges unrolling creates, so they allow
+	larger factors */
+class UnrollCostModel
+{
+public:
+	UnrollCostModel(const machine::MachineModel* machine = nullptr);
+
+public:
+	/*! \brief The unroll factor for a loop, 1 leaves the loop alone.
+
+		Loops with known trip counts are fully unrolled when the whole
+		body fits the size budget, otherwise partially by the largest
+		factor that divides the trip count.  Unknown trip counts get
+		the largest factor fitting the budget, the unroller keeps the
+		exit tests in that case.
+
+		\param bodyPressure The peak live value count of the body, from
+			RegisterPressureAnalysis.  Unrolling multiplies it, so the
+			factor is capped to stay under the register budget.  Zero
+			means unknown and skips the cap */
+	unsigned int selectUnrollFactor(unsigned int bodySize,
+		uint64_t tripCount, unsigned int bodyPressure = 0) const;
+
+public:
+	/*! \brief The most instructions an unrolled loop may grow to */
+	unsigned int maxUnrolledSize;
+
+	/*! \brief The largest partial or runtime unroll factor */
+	unsigned int maxUnrollFactor;
+
+	/*! \brief The live values the unrolled body may grow to, from the
+		machine register file */
+	unsigned int registerBudget;
+};
+
+/*! \brief Unrolls innermost single-block loops.
+
+	Counted loops are unrolled fully or by a factor dividing the trip
+	count, eliding the interior exit tests.  Loops with unknown trip
+	counts are unrolled with their exit tests kept, which still exposes
+	instruction level parallelism across iterations to the scheduler.
+	Factors come from the UnrollCostModel */
+class LoopUnrollingPass : public FunctionPass
+{
+public:
+	LoopUnrollingPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+
+};
+
+}
+
+}
+
@@ -1 +1,42 @@
-// TODO: this is a placeholder, not implemented yet
+/*! \file   PartialRedundancyEliminationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the PartialRedundancyEliminationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Eliminates partially redundant expressions with lazy code motion.
+
+	Expressions are numbered lexically and every dataflow set is a
+	word-packed bitvector with one bit per expression, so the
+	anticipability, availability, and placement solves run as 64-bit
+	word operations and scale to the expression counts in unrolled
+	kernels.  Insertions that would require splitting a critical edge
+	are abandoned for that expression instead of moving code onto paths
+	that never needed it */
+class PartialRedundancyEliminationPass : public FunctionPass
+{
+public:
+	PartialRedundancyEliminationPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+};
+
+}
+
+}
+
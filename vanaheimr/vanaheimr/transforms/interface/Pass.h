@@ -15,8 +15,10 @@
 namespace vanaheimr { namespace ir         { class Function;    } }
 namespace vanaheimr { namespace ir         { class Module;      } }
 namespace vanaheimr { namespace ir         { class BasicBlock;  } }
+namespace vanaheimr { namespace ir         { class Instruction; } }
 namespace vanaheimr { namespace transforms { class PassManager; } }
 namespace vanaheimr { namespace analysis   { class Analysis;    } }
+namespace vanaheimr { namespace util       { class Arena;       } }
 
 namespace vanaheimr
 {
@@ -104,13 +106,24 @@ public:
 	/*! \brief Report the name of the pass */
 	std::string toString() const;
 
+public:
+	/*! \brief Scratch storage for per-function temporaries, presized by
+		the pass manager from this pass's previous high-water mark.  It
+		is cleared between functions, nothing in it survives the run.
+		Null when no pass manager is driving the pass */
+	util::Arena* scratch();
+
 public:
 	/*! \brief Set the pass manager used to supply dependent analyses */
 	void setPassManager(PassManager* m);
 
+	/*! \brief Attach scratch storage, called by the pass manager */
+	void setScratchArena(util::Arena* arena);
+
 private:
 	PassManager* _manager;
-	
+	util::Arena* _scratch;
+
 };
 
 
@@ -167,6 +180,34 @@ public:
 	virtual void finalize();
 };
 
+/*! \brief A function pass expressed as a per-instruction visitor.
+
+	Consecutive sweep passes in a wave are fused by the pass manager into
+	a single traversal of the function, so several peephole-style passes
+	(dead code elimination, constant propagation, simple folds) share one
+	cache-friendly sweep instead of walking a large function once each. */
+class InstructionSweepPass : public FunctionPass
+{
+public:
+	/*! \brief The default constructor sets the type */
+	InstructionSweepPass(const StringVector& analyses = StringVector(),
+		const std::string& n = "",
+		const StringVector& classes = StringVector());
+	/*! \brief Virtual destructor */
+	virtual ~InstructionSweepPass();
+	
+public:
+	/*! \brief Visit one instruction.  Return the surviving instruction,
+		possibly a replacement, or nullptr when it was removed so that
+		later fused visitors skip it */
+	virtual ir::Instruction* visit(ir::Instruction* instruction) = 0;
+
+public:
+	/*! \brief Sweeps every instruction through visit() when the pass
+		runs on its own */
+	virtual void runOnFunction(Function& f);
+};
+
 /*! \brief An immutable pass over a single function in a module */
 class ImmutableFunctionPass : public Pass
 {
@@ -6,18 +6,24 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Arena.h>
+
 // Standard Library Includes
 #include <map>
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <list>
+#include <iosfwd>
+#include <cstddef>
 
 // Forward Declarations
 namespace vanaheimr { namespace analysis   { class Analysis; } }
 namespace vanaheimr { namespace ir         { class Module;   } }
 namespace vanaheimr { namespace ir         { class Function; } }
-namespace vanaheimr { namespace transforms { class Pass;     } }
+namespace vanaheimr { namespace transforms { class Pass;            } }
+namespace vanaheimr { namespace transforms { class PassResultCache; } }
 
 namespace vanaheimr
 {
@@ -40,6 +46,25 @@ public:
 	typedef std::vector<Pass*> PassVector;
 	typedef std::list<PassVector> PassWaveList;
 
+public:
+	/*! \brief One instrumented pass execution on one function */
+	class PassStatistics
+	{
+	public:
+		std::string passName;
+		/*! \brief The function the pass ran on, "<module>" for module
+			passes */
+		std::string functionName;
+		/*! \brief Wall clock time spent in the pass, in seconds */
+		double      seconds;
+		/*! \brief Arena bytes reserved process-wide while it ran */
+		size_t      arenaBytes;
+		size_t      instructionsBefore;
+		size_t      instructionsAfter;
+	};
+
+	typedef std::vector<PassStatistics> PassStatisticsVector;
+
 public:
 	/*! \brief The constructor creates an empty pass manager associated
 		with an existing Module.  
@@ -96,6 +121,40 @@ public:
 	/*! \brief Runs passes on the entire module. */
 	void runOnModule();
 
+	/*! \brief Set the number of worker threads used by runOnModule to
+		run function pass pipelines on different functions concurrently.
+	
+		Pass dependences still hold within each function.  The default
+		is 1, fully serial, 0 selects the hardware concurrency */
+	void setWorkerCount(unsigned int workers);
+
+public:
+	/*! \brief Share a result cache of optimized function bodies.
+
+		Functions are hashed over their serialized contents before the
+		pipeline runs, a hit copies the cached artifact in and skips
+		the pipeline entirely.  Only pipelines made up of function
+		level passes are cached, module passes see every function at
+		once and cannot be replayed per function.  The cache is not
+		owned by the manager and may outlive it */
+	void setResultCache(PassResultCache* cache);
+
+public:
+	/*! \brief Enable or disable per-pass instrumentation.
+
+		When enabled, every pass execution records its wall clock time,
+		the arena bytes reserved while it ran, and the function's
+		instruction count before and after.  Instrumented module runs
+		stay serial so that the samples land in one vector.  The default
+		is off, and the disabled checks are a single branch per pass */
+	void setInstrumentationEnabled(bool enabled);
+
+	/*! \brief The samples gathered by instrumented runs */
+	const PassStatisticsVector& statistics() const;
+
+	/*! \brief Write the gathered samples to a stream as a JSON array */
+	void writeStatistics(std::ostream& stream) const;
+
 public:
 	/*! \brief Get an up to date analysis by type */
 	Analysis* getAnalysis(const std::string& type);
@@ -129,6 +188,16 @@ private:
 	PassWaveList _schedulePasses();
 	StringVector _getAllDependentPasses(Pass* p);
 	Pass*        _findPass(const std::string& name);
+	bool         _runWaveInParallel(const PassVector& wave);
+	bool         _isCacheablePipeline() const;
+	std::string  _pipelineSignature() const;
+
+	/*! \brief Attach the scratch arena, presized from the pass's
+		previous high-water mark */
+	void _prepareScratch(Pass* pass);
+	/*! \brief Record the high-water mark and detach, the caller clears
+		the arena once every sharing pass has released it */
+	void _releaseScratch(Pass* pass);
 
 private:
 	PassVector    _passes;
@@ -138,6 +207,21 @@ private:
 	PassVector    _ownedTemporaryPasses;
 	DependenceMap _extraDependences;
 	PassMap       _previouslyRunPasses;
+	unsigned int  _workers;
+	bool          _instrument;
+
+	PassResultCache* _resultCache;
+
+	PassStatisticsVector _statistics;
+
+	/*! \brief Scratch storage handed to passes for per-function
+		temporaries, cleared between functions and presized from each
+		pass's high-water mark so reruns never regrow from cold */
+	util::Arena _scratch;
+
+	typedef std::map<std::string, size_t> HighWaterMap;
+
+	HighWaterMap _scratchHighWater;
 };
 
 }
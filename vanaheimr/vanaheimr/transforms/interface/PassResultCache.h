@@ -0,0 +1,74 @@
+/*! \file   PassResultCache.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the PassResultCache class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <map>
+#include <list>
+#include <cstdint>
+
+// Forward Declarations
+namespace vanaheimr { namespace ir { class Function; } }
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Caches optimized function bodies by content hash.
+
+	A function is hashed over its serialized form - arguments, blocks,
+	and instruction operands in the same order the binary encoding
+	lays them out - so two textually identical functions collide
+	regardless of which module they came from.  A hit replaces the
+	function body with a copy of the cached artifact and the whole
+	pipeline is skipped.  Entries are keyed by the pass pipeline as
+	well, different pipelines never share artifacts.
+
+	The cache is shared by reference, the PassManager does not own it,
+	so one cache can back many managers in a long-lived compile
+	service */
+class PassResultCache
+{
+public:
+	typedef uint64_t Hash;
+
+public:
+	/*! \brief Hash the function contents, materializing it if needed */
+	static Hash hashFunction(ir::Function& function);
+
+public:
+	/*! \brief Copy the cached body into the function on a hit */
+	bool lookup(const std::string& pipeline, Hash hash,
+		ir::Function& function) const;
+
+	/*! \brief Store a copy of the optimized function */
+	void insert(const std::string& pipeline, Hash hash,
+		const ir::Function& function);
+
+public:
+	size_t size() const;
+	void   clear();
+
+private:
+	typedef std::pair<std::string, Hash>  Key;
+	typedef std::list<ir::Function>       FunctionList;
+	typedef std::map<Key, FunctionList::iterator> EntryMap;
+
+private:
+	/*! \brief The artifacts live in a list, Function is not assignable
+		into map storage without a default constructor */
+	FunctionList _artifacts;
+	EntryMap     _entries;
+};
+
+}
+
+}
+
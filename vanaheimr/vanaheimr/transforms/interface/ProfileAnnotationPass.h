@@ -0,0 +1,52 @@
+/*! \file   ProfileAnnotationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ProfileAnnotationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Attaches simulator measured execution counts to the IR.
+
+	Reads the per-PC profile an archaeopteryx run dumped (the
+	simulator-instruction-profile knob), matches each record to a
+	function by VIR symbol name, and attaches a ProfileMetaData with
+	the measured execution and taken counts to every instruction in
+	linear order.  BranchProbabilityAnalysis and the frequency driven
+	heuristics downstream of it then prefer the measured counts over
+	their static guesses, closing the PGO loop */
+class ProfileAnnotationPass : public ModulePass
+{
+public:
+	ProfileAnnotationPass();
+
+public:
+	virtual void runOnModule(Module& m);
+
+public:
+	/*! \brief The first option names the profile file */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+public:
+	/*! \brief The profile file to read, nothing is attached when the
+		file is missing or empty */
+	std::string profileFileName;
+
+};
+
+}
+
+}
+
@@ -0,0 +1,42 @@
+/*! \file   SimplifyControlFlowPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SimplifyControlFlowPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Cleans up the control flow graph, mainly after translation.
+
+	Removes unreachable blocks, folds branches with constant guards,
+	erases branches to the next block, and merges blocks into their
+	unique predecessors.  The pass is worklist driven, simplifying a
+	block only requeues its neighbors, so the deep branch chains left
+	by translators cost linear work instead of repeated whole-function
+	sweeps.  Edges are updated in the ControlFlowGraph in place rather
+	than recomputing the analysis after every change */
+class SimplifyControlFlowPass : public FunctionPass
+{
+public:
+	SimplifyControlFlowPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+};
+
+}
+
+}
+
@@ -0,0 +1,169 @@
+/*! \file   StaticPipeline.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StaticPipeline class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/PassManager.h>
+
+#include <vanaheimr/ir/interface/Module.h>
+
+// Standard Library Includes
+#include <type_traits>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+class Pass;
+
+/*! \brief A compile-time list of pass types */
+template<typename... Types>
+class TypeList
+{
+
+};
+
+/*! \brief Does the list contain the type? */
+template<typename T, typename List>
+class ListContains;
+
+template<typename T>
+class ListContains<T, TypeList<>>
+{
+public:
+	static const bool value = false;
+};
+
+template<typename T, typename Head, typename... Tail>
+class ListContains<T, TypeList<Head, Tail...>>
+{
+public:
+	static const bool value = std::is_same<T, Head>::value ||
+		ListContains<T, TypeList<Tail...>>::value;
+};
+
+/*! \brief Append a type to a list */
+template<typename List, typename T>
+class ListAppend;
+
+template<typename... Types, typename T>
+class ListAppend<TypeList<Types...>, T>
+{
+public:
+	typedef TypeList<Types..., T> type;
+};
+
+/*! \brief Is every type in the list also in the other list? */
+template<typename List, typename Other>
+class ListIsSubsetOf;
+
+template<typename Other>
+class ListIsSubsetOf<TypeList<>, Other>
+{
+public:
+	static const bool value = true;
+};
+
+template<typename Head, typename... Tail, typename Other>
+class ListIsSubsetOf<TypeList<Head, Tail...>, Other>
+{
+public:
+	static const bool value = ListContains<Head, Other>::value &&
+		ListIsSubsetOf<TypeList<Tail...>, Other>::value;
+};
+
+/*! \brief Static ordering constraints of a pass.  Specialize RunsAfter
+	for passes that must follow other passes in a fixed pipeline, the
+	constraint is then enforced at compile time */
+template<typename PassType>
+class StaticPassTraits
+{
+public:
+	typedef TypeList<> RunsAfter;
+};
+
+// SSA form has to be built before passes that destroy it can run
+class ConvertToSSAPass;
+class ConvertFromSSAPass;
+
+template<>
+class StaticPassTraits<ConvertFromSSAPass>
+{
+public:
+	typedef TypeList<ConvertToSSAPass> RunsAfter;
+};
+
+/*! \brief Check that every pass appears after the passes it runs after */
+template<typename Seen, typename... Rest>
+class ValidatePassOrder;
+
+template<typename Seen>
+class ValidatePassOrder<Seen>
+{
+public:
+	static const bool value = true;
+};
+
+template<typename Seen, typename First, typename... Rest>
+class ValidatePassOrder<Seen, First, Rest...>
+{
+public:
+	static const bool satisfied = ListIsSubsetOf<
+		typename StaticPassTraits<First>::RunsAfter, Seen>::value;
+
+	static_assert(satisfied,
+		"Pass is scheduled before a pass it must run after");
+
+	static const bool value = satisfied && ValidatePassOrder<
+		typename ListAppend<Seen, First>::type, Rest...>::value;
+};
+
+/*! \brief A fixed pass pipeline assembled at compile time.
+
+	The pass types are instantiated with direct constructor calls, so
+	building the pipeline involves no factory lookups or string
+	compares, and the ordering constraints declared through
+	StaticPassTraits are checked when the program is compiled instead
+	of when the pipeline runs.  Analysis management still goes through
+	the PassManager the passes are added to */
+template<typename... Passes>
+class StaticPipeline
+{
+public:
+	static_assert(ValidatePassOrder<TypeList<>, Passes...>::value,
+		"Static pipeline violates its declared pass ordering");
+
+public:
+	/*! \brief Add the pipeline's passes to a manager, which owns them */
+	static void addTo(PassManager& manager)
+	{
+		// the array form guarantees left-to-right construction order
+		Pass* passes[] = {nullptr, new Passes()...};
+
+		for(auto pass : passes)
+		{
+			if(pass != nullptr) manager.addPass(pass);
+		}
+	}
+
+	/*! \brief Run the pipeline over a module with a private manager */
+	static void run(ir::Module& module)
+	{
+		PassManager manager(&module);
+
+		addTo(manager);
+
+		manager.runOnModule();
+	}
+};
+
+}
+
+}
+
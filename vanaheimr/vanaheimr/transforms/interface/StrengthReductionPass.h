@@ -0,0 +1,42 @@
+/*! \file   StrengthReductionPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StrengthReductionPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Rewrites induction variable multiplies as add recurrences.
+
+	The translator's address arithmetic multiplies the loop counter by
+	an element size every iteration.  Each 'mul iv, c' or 'shl iv, c'
+	found by InductionVariableAnalysis becomes its own induction
+	variable - the product of the initial value in the preheader, a
+	header phi, and an add of step*c on the back edge - so the loop
+	body pays one add instead of a multiply.  Duplicate induction
+	variables with the same initial value and step are then coalesced
+	onto a single phi.  Requires SSA form */
+class StrengthReductionPass : public FunctionPass
+{
+public:
+	StrengthReductionPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	virtual Pass* clone() const;
+};
+
+}
+
+}
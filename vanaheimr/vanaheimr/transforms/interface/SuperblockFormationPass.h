@@ -0,0 +1,56 @@
+/*! \file   SuperblockFormationPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SuperblockFormationPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Enlarges basic blocks along hot paths so the instruction
+	scheduler sees bigger regions.
+
+	Traces are grown from the hottest unvisited block downward, following
+	unconditional branches and fallthrough edges.  A successor with a
+	single predecessor is merged outright, a hot successor with several
+	predecessors is tail duplicated into the trace under a per function
+	instruction budget, leaving the original in place for its side
+	entrances.  Translated PTX is full of tiny blocks linked by
+	unconditional branches, so the per block list scheduler starves
+	without this.
+
+	Runs on non-SSA form only, functions containing phis are left
+	untouched rather than renaming duplicated definitions */
+class SuperblockFormationPass : public FunctionPass
+{
+public:
+	SuperblockFormationPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	/*! \brief Recognized options: "budget=N" duplicated instruction
+		limit per function, "hot=F" fraction of the hottest block
+		frequency a block needs to be worth duplicating */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	unsigned int _duplicationBudget;
+	double       _hotFraction;
+};
+
+}
+
+}
@@ -0,0 +1,66 @@
+/*! \file   VerifierPass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the VerifierPass class.
+*/
+
+#pragma once
+
+// Vanaheimr Includes
+#include <vanaheimr/transforms/interface/Pass.h>
+
+// Standard Library Includes
+#include <unordered_map>
+#include <cstdint>
+
+namespace vanaheimr
+{
+
+namespace transforms
+{
+
+/*! \brief Checks the structural invariants of the IR, throwing on the
+	first violation.
+
+	Verified per instruction: operand pointers are non-null, operands
+	point back at their owning instruction, instructions point back at
+	their owning block, register operands reference registers owned by
+	the function, and branches only terminate blocks.  When the function
+	contains phis it is taken to be in SSA form and every register must
+	have exactly one definition.
+
+	In incremental mode (the default) the pass remembers the content
+	hash of every function it has verified, so a function no pass has
+	touched since the last run is skipped and always-on verification
+	costs proportional to the amount of changed code.  Configure with
+	"full" to re-verify everything on every run. */
+class VerifierPass : public FunctionPass
+{
+public:
+	VerifierPass();
+
+public:
+	virtual void runOnFunction(Function& f);
+
+public:
+	/*! \brief Recognized options: "full", "incremental" */
+	virtual void configure(const StringVector& options);
+
+public:
+	virtual Pass* clone() const;
+
+private:
+	typedef std::unordered_map<std::string, uint64_t> HashMap;
+
+private:
+	void _verify(Function& f);
+
+private:
+	/*! \brief Content hash of each function at its last verification */
+	HashMap _verified;
+	bool    _incremental;
+};
+
+}
+
+}
@@ -45,7 +45,7 @@ OcelotToVIRTraceTranslator::OcelotToVIRTraceTranslator(compiler::Compiler* c)
 static void translatePTX(compiler::Compiler* compiler,
 	const ExtractedDeviceState& state);
 static void addVariablesForTraceData(compiler::Compiler* compiler,
-	const ExtractedDeviceState& state);
+	ExtractedDeviceState& state);
 static void archaeopteryxCodeGen(compiler::Compiler* compiler,
 	const ExtractedDeviceState& state);
 
@@ -216,7 +216,7 @@ static void addLaunch(compiler::Compiler* compiler,
 }
 
 static void addAllocations(compiler::Compiler* compiler,
-	const ExtractedDeviceState& state)
+	ExtractedDeviceState& state)
 {
 	if(!state.globalVariables.empty())
 	{
@@ -231,11 +231,15 @@ static void addAllocations(compiler::Compiler* compiler,
 		name << "simulated-allocation-" << allocation->second->devicePointer;
 	
 		addGlobal(compiler, state, name.str(), allocation->second->data);
+		
+		// the bytes now live in the global's initializer, release the
+		// trace side copy so only one allocation is ever held twice
+		::util::ByteVector().swap(allocation->second->data);
 	}
 }
 
 static void addAllocationChecks(compiler::Compiler* compiler,
-	const ExtractedDeviceState& state)
+	ExtractedDeviceState& state)
 {
 	if(!state.postLaunchGlobalVariables.empty())
 	{
@@ -251,14 +255,19 @@ static void addAllocationChecks(compiler::Compiler* compiler,
 			<< allocation->second->devicePointer;
 	
 		addGlobal(compiler, state, name.str(), allocation->second->data);
+		
+		::util::ByteVector().swap(allocation->second->data);
 	}
 }
 
 static void addVariablesForTraceData(compiler::Compiler* compiler,
-	const ExtractedDeviceState& state)
+	ExtractedDeviceState& state)
 {
 	addTextures(compiler, state);
 	addLaunch(compiler, state);
+	
+	// Allocations dominate large traces, they are consumed one record at
+	// a time and released as each simulated global is emitted
 	addAllocations(compiler, state);
 	addAllocationChecks(compiler, state);
 }
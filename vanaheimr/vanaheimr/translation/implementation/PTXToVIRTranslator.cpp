@@ -11,6 +11,9 @@
 
 #include <vanaheimr/compiler/interface/Compiler.h>
 
+#include <vanaheimr/util/interface/NumaTopology.h>
+#include <vanaheimr/util/interface/Executor.h>
+
 #include <configure.h>
 
 // Ocelot Includes
@@ -27,6 +30,10 @@
 
 // Standard Library Includes
 #include <stdexcept>
+#include <cstdio>
+#include <atomic>
+#include <memory>
+#include <unordered_set>
 
 // Preprocessor Macros
 #ifdef REPORT_BASE
@@ -42,13 +49,47 @@ namespace translation
 {
 
 PTXToVIRTranslator::PTXToVIRTranslator(compiler::Compiler* compiler)
-: _compiler(compiler)
+: _compiler(compiler), _moduleLock(nullptr)
+{
+
+}
+
+std::unique_lock<std::mutex> PTXToVIRTranslator::_lockModule() const
 {
+	if(_moduleLock == nullptr) return std::unique_lock<std::mutex>();
+
+	return std::unique_lock<std::mutex>(*_moduleLock);
+}
+
+template<typename OperandType, typename... Args>
+OperandType* PTXToVIRTranslator::_newOperand(Args&&... args)
+{
+	// the arena's bump pointer is shared by all workers
+	auto lock = _lockModule();
+
+	auto operand = _module->arena().construct<OperandType>(
+		std::forward<Args>(args)...);
 
+	operand->markAsArenaAllocated();
+
+	return operand;
 }
 
 void PTXToVIRTranslator::translate(const PTXModule& m)
 {
+	translate(m, 1);
+}
+
+void PTXToVIRTranslator::translate(const PTXModule& m,
+	unsigned int workerCount)
+{
+	typedef std::vector<const PTXKernel*> KernelVector;
+
+	if(workerCount == 0)
+	{
+		workerCount = util::Executor::instance().workers();
+	}
+
 	report("Translating PTX module '"  << m.path() << "'");
 
 	_ptx    = &m;
@@ -61,12 +102,95 @@ void PTXToVIRTranslator::translate(const PTXModule& m)
 		_translateGlobal(global->second);
 	}
 	
-	// Translate kernel functions
+	KernelVector kernels;
+	
+	kernels.reserve(m.kernels().size());
+	
 	for(PTXModule::KernelMap::const_iterator kernel = m.kernels().begin();
 		kernel != m.kernels().end(); ++kernel)
 	{
-		_translateKernel(*kernel->second);
+		kernels.push_back(kernel->second);
 	}
+	
+	// Translate kernel functions, they map to independent functions
+	if(workerCount <= 1 || kernels.size() < 2)
+	{
+		for(auto kernel : kernels)
+		{
+			_translateKernel(*kernel);
+		}
+		
+		return;
+	}
+	
+	if(workerCount > kernels.size()) workerCount = kernels.size();
+	
+	report(" translating " << kernels.size() << " kernels on "
+		<< workerCount << " workers");
+	
+	// kernels map to memory nodes by a stable rule, so a function's IR
+	// is first touched on the socket that keeps processing it later
+	unsigned int nodes = util::NumaTopology::nodeCount();
+
+	if(nodes > workerCount) nodes = workerCount;
+
+	std::vector<KernelVector> nodeKernels(nodes);
+
+	for(size_t i = 0; i < kernels.size(); ++i)
+	{
+		nodeKernels[i % nodes].push_back(kernels[i]);
+	}
+
+	std::mutex         moduleLock;
+	std::exception_ptr error;
+
+	std::unique_ptr<std::atomic<size_t>[]> nextKernel(
+		new std::atomic<size_t>[nodes]());
+
+	// workers drain their own node first, then help the others
+	auto worker = [&](unsigned int)
+	{
+		// the pool's threads are pinned round robin over the nodes, a
+		// worker starts on the queue its pages are local to
+		unsigned int node = util::Executor::currentNode() % nodes;
+
+		// Workers keep private per-kernel state, shared module and
+		// compiler structures are guarded by the module lock
+		PTXToVIRTranslator translator(_compiler);
+
+		translator._ptx        = _ptx;
+		translator._module     = _module;
+		translator._moduleLock = &moduleLock;
+
+		for(unsigned int distance = 0; distance < nodes; ++distance)
+		{
+			unsigned int target = (node + distance) % nodes;
+
+			while(true)
+			{
+				size_t index = nextKernel[target]++;
+
+				if(index >= nodeKernels[target].size()) break;
+
+				try
+				{
+					translator._translateKernel(*nodeKernels[target][index]);
+				}
+				catch(...)
+				{
+					std::lock_guard<std::mutex> lock(moduleLock);
+
+					if(!error) error = std::current_exception();
+
+					return;
+				}
+			}
+		}
+	};
+
+	util::Executor::instance().parallelExecute(workerCount, worker);
+
+	if(error) std::rethrow_exception(error);
 }
 
 void PTXToVIRTranslator::_translateParameter(const PTXParameter& parameter)
@@ -121,19 +245,27 @@ void PTXToVIRTranslator::_translateKernel(const PTXKernel& kernel)
 {
 	report(" Translating PTX kernel '" << kernel.getPrototype().toString());
 
-	ir::Module::iterator function = _module->getFunction(kernel.name);
+	ir::Module::iterator function = _module->end();
 	
-	if(function != _module->end())
 	{
-		assert(function->isPrototype());
+		// function creation rewires the module's shared function list
+		auto lock = _lockModule();
 		
-		function->removeAttribute("prototype");
-	}
-	else
-	{
-		function = _module->newFunction(kernel.name,
-			_translateLinkingDirective(kernel.getPrototype().linkingDirective),
-			_translateVisibility(kernel.getPrototype().linkingDirective));
+		function = _module->getFunction(kernel.name);
+		
+		if(function != _module->end())
+		{
+			assert(function->isPrototype());
+			
+			function->removeAttribute("prototype");
+		}
+		else
+		{
+			function = _module->newFunction(kernel.name,
+				_translateLinkingDirective(
+					kernel.getPrototype().linkingDirective),
+				_translateVisibility(kernel.getPrototype().linkingDirective));
+		}
 	}
 	
 	_function = &*function;
@@ -156,6 +288,8 @@ void PTXToVIRTranslator::_translateKernel(const PTXKernel& kernel)
 	// Translate Values
 	PTXKernel::RegisterVector registers = kernel.getReferencedRegisters();
 	
+	_registers.reserve(registers.size());
+	
 	for(PTXKernel::RegisterVector::iterator reg = registers.begin();
 		reg != registers.end(); ++reg)
 	{
@@ -173,6 +307,8 @@ void PTXToVIRTranslator::_translateKernel(const PTXKernel& kernel)
 		getBlockSequence(kernel);
 
 	// Keep a record of blocks
+	_blocks.reserve(sequence.size());
+	
 	for(::ir::ControlFlowGraph::BlockPointerVector::iterator
 		block = sequence.begin(); block != sequence.end(); ++block)
 	{
@@ -190,7 +326,9 @@ void PTXToVIRTranslator::_translateKernel(const PTXKernel& kernel)
 
 		_translateBasicBlock(**block);
 	}
-	
+
+	_simplifyControlFlow();
+
 	_registers.clear();
 	_blocks.clear();
 }
@@ -213,22 +351,20 @@ void PTXToVIRTranslator::_translateRegisterValue(PTXRegisterId reg,
 		<< PTXOperand::toString((PTXOperand::DataType) type)
 		<< " r" << reg);
 
-	std::stringstream name;
+	char name[32];
 	
-	name << "r"  << reg;
-	
-	if(_registers.count(reg) != 0)
-	{
-		throw std::runtime_error("Added duplicate virtual register '"
-			+ name.str() + "'");
-	}
+	std::snprintf(name, sizeof(name), "r%u", reg);
 	
 	ir::Function::register_iterator newRegister = _function->newVirtualRegister(
-		_getType(type), name.str());
+		_getType(type), name);
 
 	report("    to " << newRegister->type->name << " r" << newRegister->id);
 
-	_registers.insert(std::make_pair(reg, newRegister));
+	if(!_registers.insert(std::make_pair(reg, newRegister)).second)
+	{
+		throw std::runtime_error("Added duplicate virtual register '"
+			+ std::string(name) + "'");
+	}
 }
 
 void PTXToVIRTranslator::_recordBasicBlock(const PTXBasicBlock& basicBlock)
@@ -238,13 +374,11 @@ void PTXToVIRTranslator::_recordBasicBlock(const PTXBasicBlock& basicBlock)
 	ir::Function::iterator block = _function->newBasicBlock(
 		_function->exit_block(), basicBlock.label());	
 
-	if(_blocks.count(basicBlock.label()) != 0)
+	if(!_blocks.insert(std::make_pair(basicBlock.label(), block)).second)
 	{
 		throw std::runtime_error("Added duplicate basic block '"
 			+ basicBlock.label() + "'");
 	}
-	
-	_blocks.insert(std::make_pair(basicBlock.label(), block));
 }
 
 void PTXToVIRTranslator::_translateBasicBlock(const PTXBasicBlock& basicBlock)
@@ -272,6 +406,151 @@ void PTXToVIRTranslator::_translateBasicBlock(const PTXBasicBlock& basicBlock)
 	}
 }
 
+/*! \brief Does control never fall out of the bottom of the block? */
+static bool endsExplicitly(ir::BasicBlock& block)
+{
+	auto terminator = block.terminator();
+
+	if(terminator == nullptr) return false;
+
+	if(terminator->isReturn())
+	{
+		return terminator->guard()->isAlwaysTrue();
+	}
+
+	if(terminator->isBranch() && !terminator->isCall())
+	{
+		return static_cast<ir::Bra*>(terminator)->isUnconditional();
+	}
+
+	return false;
+}
+
+void PTXToVIRTranslator::_simplifyControlFlow()
+{
+	typedef std::unordered_map<ir::BasicBlock*,
+		ir::BasicBlock*> ForwardingMap;
+	typedef std::unordered_set<ir::BasicBlock*> BlockSet;
+	typedef std::vector<ir::Function::iterator> BlockIteratorVector;
+
+	// the labels PTX carries turn into empty blocks and single branch
+	// forwarders, thread them away here so every downstream pass starts
+	// from a sane graph instead of rediscovering this per kernel
+	ForwardingMap forwards;
+
+	for(auto block = _function->begin(); block != _function->end(); ++block)
+	{
+		if(block == _function->entry_block()) continue;
+		if(block == _function->exit_block())  continue;
+
+		if(block->empty())
+		{
+			auto next = block; ++next;
+
+			if(next == _function->end())        continue;
+			if(next == _function->exit_block()) continue;
+
+			forwards.insert(std::make_pair(&*block, &*next));
+
+			continue;
+		}
+
+		if(block->size() != 1) continue;
+
+		auto instruction = *block->begin();
+
+		if(!instruction->isBranch() || instruction->isCall()) continue;
+
+		auto branch = static_cast<ir::Bra*>(instruction);
+
+		if(!branch->isUnconditional())            continue;
+		if(branch->targetBasicBlock() == nullptr) continue;
+
+		forwards.insert(std::make_pair(&*block,
+			branch->targetBasicBlock()));
+	}
+
+	if(forwards.empty()) return;
+
+	report("  Threading " << forwards.size()
+		<< " forwarding blocks out of '" << _function->name() << "'");
+
+	// compress forwarder chains, a cycle of branches keeps spinning at
+	// whatever block the walk stops on
+	for(auto& forward : forwards)
+	{
+		BlockSet visited;
+
+		visited.insert(forward.first);
+
+		auto target = forward.second;
+
+		while(visited.insert(target).second)
+		{
+			auto next = forwards.find(target);
+
+			if(next == forwards.end()) break;
+
+			target = next->second;
+		}
+
+		forward.second = target;
+	}
+
+	// branches into a forwarder jump straight to the final target
+	BlockSet targeted;
+
+	for(auto block = _function->begin(); block != _function->end(); ++block)
+	{
+		for(auto instruction : *block)
+		{
+			if(!instruction->isBranch() || instruction->isCall()) continue;
+
+			auto branch = static_cast<ir::Bra*>(instruction);
+
+			auto target = forwards.find(branch->targetBasicBlock());
+
+			if(target != forwards.end() && target->second != &*block)
+			{
+				report("   threading branch in '" << block->name()
+					<< "' past '" << target->first->name() << "' to '"
+					<< target->second->name() << "'");
+
+				static_cast<ir::AddressOperand*>(
+					branch->target())->globalValue = target->second;
+			}
+
+			targeted.insert(branch->targetBasicBlock());
+		}
+	}
+
+	// forwarders nothing branches to fold away, a branch-only one also
+	// needs no fallthrough entering it since it redirected that path
+	BlockIteratorVector removable;
+
+	for(auto block = _function->begin(); block != _function->end(); ++block)
+	{
+		if(forwards.count(&*block) == 0) continue;
+		if(targeted.count(&*block) != 0) continue;
+
+		if(!block->empty())
+		{
+			auto previous = block; --previous;
+
+			if(!endsExplicitly(*previous)) continue;
+		}
+
+		removable.push_back(block);
+	}
+
+	for(auto block : removable)
+	{
+		report("   removing forwarding block '" << block->name() << "'");
+
+		_function->erase(block);
+	}
+}
+
 void PTXToVIRTranslator::_translateInstruction(const PTXInstruction& ptx)
 {
 	report("   Translating PTX instruction " << ptx.toString());
@@ -782,7 +1061,8 @@ void PTXToVIRTranslator::_translateNeg(const PTXInstruction& ptx)
 	sub->setGuard(_translatePredicateOperand(ptx.pg));
 	
 	sub->setD(_newTranslatedOperand(ptx.d));
-	sub->setA(new ir::ImmediateOperand((uint64_t)0, sub, _getType(ptx.type)));
+	sub->setA(_newOperand<ir::ImmediateOperand>((uint64_t)0, sub,
+		_getType(ptx.type)));
 	sub->setB(_newTranslatedOperand(ptx.a));
 
 	report("    to " << sub->toString());
@@ -797,7 +1077,7 @@ void PTXToVIRTranslator::_translateNot(const PTXInstruction& ptx)
 	xxor->setGuard(_translatePredicateOperand(ptx.pg));
 	
 	xxor->setD(_newTranslatedOperand(ptx.d));
-	xxor->setA(new ir::ImmediateOperand((uint64_t)0xffffffffffffffffULL,
+	xxor->setA(_newOperand<ir::ImmediateOperand>((uint64_t)0xffffffffffffffffULL,
 		xxor, _getType(ptx.type)));
 	xxor->setB(_newTranslatedOperand(ptx.a));
 
@@ -1076,7 +1356,7 @@ void PTXToVIRTranslator::_translateSimpleIntrinsic(const PTXInstruction& ptx)
 	
 	_addPrototype(stream.str(), *call);
 	
-	call->setTarget(new ir::AddressOperand(_getGlobal(stream.str()),
+	call->setTarget(_newOperand<ir::AddressOperand>(_getGlobal(stream.str()),
 		_instruction));
 
 	_block->push_back(call);
@@ -1100,7 +1380,7 @@ void PTXToVIRTranslator::_translateCall(const PTXInstruction& ptx)
 			
 		assert(function != nullptr);
 		
-		call->setTarget(new ir::AddressOperand(function, _instruction));
+		call->setTarget(_newOperand<ir::AddressOperand>(function, _instruction));
 	}
 	else
 	{
@@ -1135,40 +1415,42 @@ ir::Operand* PTXToVIRTranslator::_newTranslatedOperand(const PTXOperand& ptx)
 	{
 	case PTXOperand::Register:
 	{
-		return new ir::RegisterOperand(_getRegister(ptx.reg), _instruction);
+		return _newOperand<ir::RegisterOperand>(
+			_getRegister(ptx.reg), _instruction);
 	}
 	case PTXOperand::Indirect:
 	{
-		return new ir::IndirectOperand(_getRegister(ptx.reg),
+		return _newOperand<ir::IndirectOperand>(_getRegister(ptx.reg),
 			ptx.offset, _instruction);
 	}
 	case PTXOperand::Immediate:
 	{
-		return new ir::ImmediateOperand((uint64_t)ptx.imm_uint, _instruction,
-			_getType(ptx.type));
+		return _newOperand<ir::ImmediateOperand>((uint64_t)ptx.imm_uint,
+			_instruction, _getType(ptx.type));
 	}
 	case PTXOperand::Address:
 	{
 		if(_ptxInstruction->addressSpace == PTXInstruction::Param &&
 			_isArgument(ptx.identifier))
 		{
-			return new ir::ArgumentOperand(_getArgument(ptx.identifier),
+			return _newOperand<ir::ArgumentOperand>(_getArgument(ptx.identifier),
 				_instruction);
 		}
 		else
 		{
-			return new ir::AddressOperand(
+			return _newOperand<ir::AddressOperand>(
 				_getGlobal(ptx.identifier), _instruction);
 		}
 	}
 	case PTXOperand::Label:
 	{
-		return new ir::AddressOperand(_getBasicBlock(ptx.identifier),
+		return _newOperand<ir::AddressOperand>(_getBasicBlock(ptx.identifier),
 			_instruction);
 	}
 	case PTXOperand::FunctionName:
 	{
-		return new ir::AddressOperand(_getGlobal(ptx.identifier), _instruction);
+		return _newOperand<ir::AddressOperand>(
+			_getGlobal(ptx.identifier), _instruction);
 	}
 	case PTXOperand::Special:
 	{
@@ -1176,7 +1458,7 @@ ir::Operand* PTXToVIRTranslator::_newTranslatedOperand(const PTXOperand& ptx)
 	}
 	case PTXOperand::BitBucket:
 	{
-		return new ir::RegisterOperand(_newTemporaryRegister("i64"),
+		return _newOperand<ir::RegisterOperand>(_newTemporaryRegister("i64"),
 			_instruction);
 	}
 	default: break;
@@ -1222,14 +1504,14 @@ ir::PredicateOperand* PTXToVIRTranslator::_translatePredicateOperand(
 		predicateRegister = _getRegister(ptx.reg);
 	}
 	
-	return new ir::PredicateOperand(predicateRegister,
+	return _newOperand<ir::PredicateOperand>(predicateRegister,
 		translatePredicateCondition(ptx.condition), _instruction);
 }
 
 ir::PredicateOperand* PTXToVIRTranslator::_translatePredicateOperand(
 	unsigned int condition)
 {
-	return new ir::PredicateOperand(nullptr,
+	return _newOperand<ir::PredicateOperand>(nullptr,
 		translatePredicateCondition((PTXOperand::PredicateCondition)condition),
 		_instruction);
 }
@@ -1278,12 +1560,12 @@ ir::VirtualRegister* PTXToVIRTranslator::_getSpecialVirtualRegister(
 	
 	call->setGuard(_translatePredicateOperand(PTXOperand::PT));
 
-	ir::RegisterOperand* specialValue = new ir::RegisterOperand(
+	ir::RegisterOperand* specialValue = _newOperand<ir::RegisterOperand>(
 		_newTemporaryRegister("i32"), call);
 
 	call->addReturn(specialValue);
 	
-	call->setTarget(new ir::AddressOperand(
+	call->setTarget(_newOperand<ir::AddressOperand>(
 		_getGlobal(stream.str()), _instruction));
 
 	_block->push_back(call);
@@ -1316,6 +1598,9 @@ ir::Variable* PTXToVIRTranslator::_getGlobal(const std::string& name)
 
 	if(local != _function->local_end()) return &*local;
 
+	// another worker may be adding prototypes to the function list
+	auto lock = _lockModule();
+
 	ir::Module::iterator function = _module->getFunction(name);
 
 	if(function != _module->end()) return &*function;
@@ -1367,7 +1652,7 @@ ir::Argument* PTXToVIRTranslator::_getArgument(const std::string& name)
 ir::Operand* PTXToVIRTranslator::_getSpecialValueOperand(
 	unsigned int id, unsigned int vIndex)
 {
-	return new ir::RegisterOperand(
+	return _newOperand<ir::RegisterOperand>(
 		_getSpecialVirtualRegister(id, vIndex), _instruction);
 }
 
@@ -1536,6 +1821,8 @@ bool PTXToVIRTranslator::_isArgument(const std::string& name)
 
 void PTXToVIRTranslator::_addSpecialPrototype(const std::string& name)
 {
+	auto lock = _lockModule();
+
 	auto prototype = _module->getFunction(name);
 	
 	if(prototype != _module->end()) return;
@@ -1554,6 +1841,8 @@ void PTXToVIRTranslator::_addSpecialPrototype(const std::string& name)
 void PTXToVIRTranslator::_addPrototype(const std::string& name,
 	const ir::Call& call)
 {
+	auto lock = _lockModule();
+
 	auto prototype = _module->getFunction(name);
 	
 	if(prototype != _module->end()) return;
@@ -13,6 +13,7 @@
 // Standard Library Includes
 #include <unordered_map>
 #include <string>
+#include <mutex>
 
 // Forward Declarations
                       namespace ir       { class Module;           }
@@ -49,6 +50,14 @@ public:
 		vanaheimr compiler */
 	void translate(const PTXModule& m);
 
+	/*! \brief Translate kernels concurrently on the specified number of
+		worker threads (0 selects one per hardware thread).
+
+		Each kernel maps to an independent function, so workers only
+		synchronize on module-level mutations and on the compiler
+		type and string uniquing tables. */
+	void translate(const PTXModule& m, unsigned int workerCount);
+
 private:
 	typedef ::ir::PTXKernel      PTXKernel;
 	typedef ::ir::Global         PTXGlobal;
@@ -74,6 +83,7 @@ private:
 	void _translateRegisterValue(PTXRegisterId, PTXDataType);
 	void _recordBasicBlock(const PTXBasicBlock&);
 	void _translateBasicBlock(const PTXBasicBlock&);
+	void _simplifyControlFlow();
 
 private:
 	void _translateInstruction(const PTXInstruction& );
@@ -99,6 +109,13 @@ private:
 	typedef std::unordered_map<std::string,
 		ir::Function::iterator> BasicBlockMap;
 
+private:
+	/*! \brief Allocate an operand from the module arena.  Translated
+		operands live exactly as long as the module, so they are bump
+		allocated rather than individually heap allocated */
+	template<typename OperandType, typename... Args>
+	OperandType* _newOperand(Args&&... args);
+
 private:
 	ir::Operand*          _newTranslatedOperand(const PTXOperand& ptx);
 	ir::PredicateOperand* _translatePredicateOperand(const PTXOperand& ptx);
@@ -126,7 +143,12 @@ private:
 	void                  _addSpecialPrototype(const std::string& name);
 	void                  _addPrototype(const std::string& name,
 	                                    const Call& call);
-	
+
+private:
+	/*! \brief Take the shared module lock, returns an unlocked guard
+		when translation is single threaded */
+	std::unique_lock<std::mutex> _lockModule() const;
+
 private:
 	compiler::Compiler* _compiler;
 	ir::Module*         _module;
@@ -139,7 +161,11 @@ private:
 	
 	RegisterMap   _registers;
 	BasicBlockMap _blocks;
-	
+
+	/*! \brief Guards the module during concurrent kernel translation,
+		null when translation is single threaded */
+	std::mutex* _moduleLock;
+
 };
 
 }
@@ -0,0 +1,129 @@
+/*! \file   Arena.cpp
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the Arena class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Arena.h>
+
+// Standard Library Includes
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+static std::atomic<size_t> globalReservedBytes(0);
+
+Arena::Arena(size_t chunkSize)
+: _next(nullptr), _end(nullptr), _chunkSize(chunkSize), _allocated(0),
+	_capacity(0)
+{
+
+}
+
+Arena::~Arena()
+{
+	clear();
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+	uintptr_t address = reinterpret_cast<uintptr_t>(_next);
+	uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+
+	if(_next == nullptr || aligned + size > reinterpret_cast<uintptr_t>(_end))
+	{
+		_addChunk(size + alignment);
+
+		address = reinterpret_cast<uintptr_t>(_next);
+		aligned = (address + alignment - 1) & ~(alignment - 1);
+	}
+
+	_next       = reinterpret_cast<char*>(aligned + size);
+	_allocated += size;
+
+	return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::reserve(size_t bytes)
+{
+	size_t remaining = _end - _next;
+
+	if(remaining >= bytes) return;
+
+	_addChunk(bytes);
+}
+
+void Arena::clear()
+{
+	// run destructors in reverse construction order
+	for(auto destructor = _destructors.rbegin();
+		destructor != _destructors.rend(); ++destructor)
+	{
+		destructor->second(destructor->first);
+	}
+
+	_destructors.clear();
+
+	for(auto chunk : _chunks)
+	{
+		delete[] chunk;
+	}
+
+	_chunks.clear();
+
+	_next      = nullptr;
+	_end       = nullptr;
+	_allocated = 0;
+	_capacity  = 0;
+}
+
+size_t Arena::capacity() const
+{
+	return _capacity;
+}
+
+size_t Arena::allocated() const
+{
+	return _allocated;
+}
+
+size_t Arena::globalBytesReserved()
+{
+	return globalReservedBytes.load(std::memory_order_relaxed);
+}
+
+void Arena::_registerDestructor(void* object, DestructorCallback destructor)
+{
+	_destructors.push_back(DestructorRecord(object, destructor));
+}
+
+void Arena::_addChunk(size_t minimumSize)
+{
+	if(minimumSize < _chunkSize) minimumSize = _chunkSize;
+
+	char* chunk = new char[minimumSize];
+
+	// fault the pages in from this thread, under a first touch policy
+	// they land on the allocating thread's memory node
+	std::memset(chunk, 0, minimumSize);
+
+	_chunks.push_back(chunk);
+
+	_capacity += minimumSize;
+
+	globalReservedBytes.fetch_add(minimumSize, std::memory_order_relaxed);
+
+	_next = chunk;
+	_end  = chunk + minimumSize;
+}
+
+}
+
+}
@@ -0,0 +1,331 @@
+/*! \file   BitVector.cpp
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the BitVector class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/BitVector.h>
+
+// Standard Library Includes
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief The bits at and above the specified position in one word */
+static uint64_t maskFrom(size_t bit)
+{
+	return ~(uint64_t)0 << bit;
+}
+
+/*! \brief The bits below the specified position in one word */
+static uint64_t maskBelow(size_t bit)
+{
+	if(bit == 0) return 0;
+
+	return ~(uint64_t)0 >> (BitVector::BitsPerWord - bit);
+}
+
+BitVector::BitVector()
+: _words(_inlineWords), _bits(0)
+{
+
+}
+
+BitVector::BitVector(size_t bits, bool value)
+: _words(_inlineWords), _bits(0)
+{
+	_allocate(bits);
+
+	if(value)
+	{
+		setAll();
+	}
+	else
+	{
+		resetAll();
+	}
+}
+
+BitVector::BitVector(const BitVector& v)
+: _words(_inlineWords), _bits(0)
+{
+	_allocate(v._bits);
+
+	std::memcpy(_words, v._words, words() * sizeof(uint64_t));
+}
+
+BitVector::BitVector(BitVector&& v)
+: _words(_inlineWords), _bits(v._bits)
+{
+	if(v._isInline())
+	{
+		std::memcpy(_inlineWords, v._inlineWords, sizeof(_inlineWords));
+	}
+	else
+	{
+		_words = v._words;
+
+		v._words = v._inlineWords;
+	}
+
+	v._bits = 0;
+}
+
+BitVector::~BitVector()
+{
+	_release();
+}
+
+BitVector& BitVector::operator=(const BitVector& v)
+{
+	if(this == &v) return *this;
+
+	if(words() != v.words())
+	{
+		_release();
+		_allocate(v._bits);
+	}
+
+	_bits = v._bits;
+
+	std::memcpy(_words, v._words, words() * sizeof(uint64_t));
+
+	return *this;
+}
+
+BitVector& BitVector::operator=(BitVector&& v)
+{
+	if(this == &v) return *this;
+
+	_release();
+
+	_bits = v._bits;
+
+	if(v._isInline())
+	{
+		std::memcpy(_inlineWords, v._inlineWords, sizeof(_inlineWords));
+	}
+	else
+	{
+		_words = v._words;
+
+		v._words = v._inlineWords;
+	}
+
+	v._bits = 0;
+
+	return *this;
+}
+
+void BitVector::setAll()
+{
+	std::memset(_words, 0xff, words() * sizeof(uint64_t));
+
+	_clearTrailingBits();
+}
+
+void BitVector::resetAll()
+{
+	std::memset(_words, 0, words() * sizeof(uint64_t));
+}
+
+void BitVector::setRange(size_t begin, size_t end)
+{
+	assert(end <= _bits);
+
+	if(begin >= end) return;
+
+	size_t firstWord = begin / BitsPerWord;
+	size_t lastWord  = (end - 1) / BitsPerWord;
+
+	uint64_t firstMask = maskFrom(begin % BitsPerWord);
+	uint64_t lastMask  = maskBelow(((end - 1) % BitsPerWord) + 1);
+
+	if(firstWord == lastWord)
+	{
+		_words[firstWord] |= firstMask & lastMask;
+		return;
+	}
+
+	_words[firstWord] |= firstMask;
+
+	for(size_t word = firstWord + 1; word != lastWord; ++word)
+	{
+		_words[word] = ~(uint64_t)0;
+	}
+
+	_words[lastWord] |= lastMask;
+}
+
+void BitVector::resetRange(size_t begin, size_t end)
+{
+	assert(end <= _bits);
+
+	if(begin >= end) return;
+
+	size_t firstWord = begin / BitsPerWord;
+	size_t lastWord  = (end - 1) / BitsPerWord;
+
+	uint64_t firstMask = maskFrom(begin % BitsPerWord);
+	uint64_t lastMask  = maskBelow(((end - 1) % BitsPerWord) + 1);
+
+	if(firstWord == lastWord)
+	{
+		_words[firstWord] &= ~(firstMask & lastMask);
+		return;
+	}
+
+	_words[firstWord] &= ~firstMask;
+
+	for(size_t word = firstWord + 1; word != lastWord; ++word)
+	{
+		_words[word] = 0;
+	}
+
+	_words[lastWord] &= ~lastMask;
+}
+
+bool BitVector::unionWith(const BitVector& v)
+{
+	assert(_bits == v._bits);
+
+	bool changed = false;
+
+	size_t wordCount = words();
+
+	for(size_t word = 0; word != wordCount; ++word)
+	{
+		uint64_t value = _words[word] | v._words[word];
+
+		changed     |= value != _words[word];
+		_words[word] = value;
+	}
+
+	return changed;
+}
+
+bool BitVector::intersectWith(const BitVector& v)
+{
+	assert(_bits == v._bits);
+
+	bool changed = false;
+
+	size_t wordCount = words();
+
+	for(size_t word = 0; word != wordCount; ++word)
+	{
+		uint64_t value = _words[word] & v._words[word];
+
+		changed     |= value != _words[word];
+		_words[word] = value;
+	}
+
+	return changed;
+}
+
+bool BitVector::subtract(const BitVector& v)
+{
+	assert(_bits == v._bits);
+
+	bool changed = false;
+
+	size_t wordCount = words();
+
+	for(size_t word = 0; word != wordCount; ++word)
+	{
+		uint64_t value = _words[word] & ~v._words[word];
+
+		changed     |= value != _words[word];
+		_words[word] = value;
+	}
+
+	return changed;
+}
+
+bool BitVector::none() const
+{
+	size_t wordCount = words();
+
+	for(size_t word = 0; word != wordCount; ++word)
+	{
+		if(_words[word] != 0) return false;
+	}
+
+	return true;
+}
+
+size_t BitVector::count() const
+{
+	size_t setBits = 0;
+
+	size_t wordCount = words();
+
+	for(size_t word = 0; word != wordCount; ++word)
+	{
+		setBits += __builtin_popcountll(_words[word]);
+	}
+
+	return setBits;
+}
+
+bool BitVector::operator==(const BitVector& v) const
+{
+	if(_bits != v._bits) return false;
+
+	return std::memcmp(_words, v._words, words() * sizeof(uint64_t)) == 0;
+}
+
+void BitVector::_allocate(size_t bits)
+{
+	_bits = bits;
+
+	size_t wordCount = words();
+
+	if(wordCount <= InlineWords)
+	{
+		_words = _inlineWords;
+		return;
+	}
+
+	// round heap storage up to whole cache lines and align it, a row
+	// never straddles an extra line during the solver sweeps
+	size_t lines = (wordCount + InlineWords - 1) / InlineWords;
+
+	void* storage = nullptr;
+
+	if(posix_memalign(&storage, 64, lines * 64) != 0)
+	{
+		throw std::bad_alloc();
+	}
+
+	_words = static_cast<uint64_t*>(storage);
+}
+
+void BitVector::_release()
+{
+	if(!_isInline())
+	{
+		std::free(_words);
+	}
+
+	_words = _inlineWords;
+	_bits  = 0;
+}
+
+void BitVector::_clearTrailingBits()
+{
+	if(_bits % BitsPerWord == 0) return;
+
+	_words[words() - 1] &= maskBelow(_bits % BitsPerWord);
+}
+
+}
+
+}
@@ -0,0 +1,118 @@
+/*! \file   ByteClass.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the ByteClass class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/ByteClass.h>
+
+// Standard Library Includes
+#include <cstring>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+ByteClass::ByteClass()
+: _ascii(true), _empty(true)
+{
+	std::memset(_bits,       0, sizeof(_bits));
+	std::memset(_columnBits, 0, sizeof(_columnBits));
+}
+
+void ByteClass::insert(unsigned char byte)
+{
+	_bits[byte >> 3] |= 1 << (byte & 7);
+
+	if(byte >= 0x80)
+	{
+		_ascii = false;
+	}
+	else
+	{
+		_columnBits[byte & 0xf] |= 1 << (byte >> 4);
+	}
+
+	_empty = false;
+}
+
+bool ByteClass::contains(unsigned char byte) const
+{
+	return (_bits[byte >> 3] >> (byte & 7)) & 1;
+}
+
+bool ByteClass::empty() const
+{
+	return _empty;
+}
+
+size_t ByteClass::scan(const char* text, size_t position, size_t end) const
+{
+	#ifdef __SSSE3__
+	if(_ascii)
+	{
+		// classify sixteen bytes at a time: look up the member row bits
+		// by low nibble, the row select bit by high nibble, and stop at
+		// the first byte whose row bit is not among its members
+		const __m128i columns = _mm_loadu_si128((const __m128i*)_columnBits);
+		const __m128i rows    = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64,
+			(char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i lowNibble = _mm_set1_epi8(0x0f);
+
+		while(position + 16 <= end)
+		{
+			__m128i bytes = _mm_loadu_si128(
+				(const __m128i*)(text + position));
+
+			__m128i low  = _mm_and_si128(bytes, lowNibble);
+			__m128i high = _mm_and_si128(
+				_mm_srli_epi16(bytes, 4), lowNibble);
+
+			__m128i members = _mm_and_si128(
+				_mm_shuffle_epi8(columns, low),
+				_mm_shuffle_epi8(rows,    high));
+
+			int stops = _mm_movemask_epi8(
+				_mm_cmpeq_epi8(members, _mm_setzero_si128()));
+
+			if(stops != 0) return position + __builtin_ctz(stops);
+
+			position += 16;
+		}
+	}
+	#else
+	// branch free block test, eight bytes per step
+	while(position + 8 <= end)
+	{
+		unsigned int members = 0;
+
+		for(unsigned int i = 0; i < 8; ++i)
+		{
+			members += contains((unsigned char)text[position + i]);
+		}
+
+		if(members != 8) break;
+
+		position += 8;
+	}
+	#endif
+
+	while(position != end && contains((unsigned char)text[position]))
+	{
+		++position;
+	}
+
+	return position;
+}
+
+}
+
+}
+
@@ -0,0 +1,38 @@
+/*! \file   Debug.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\brief  The source file for compile-time leveled reporting.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Debug.h>
+
+// Standard Library Includes
+#include <cstdlib>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+static unsigned int readThreshold()
+{
+	const char* filter = std::getenv("VANAHEIMR_REPORT_FILTER");
+
+	if(filter == 0) return VANAHEIMR_REPORT_LEVEL;
+
+	return (unsigned int)std::atoi(filter);
+}
+
+unsigned int reportThreshold()
+{
+	// read once, reports sit on hot paths even in debugging builds
+	static unsigned int threshold = readThreshold();
+
+	return threshold;
+}
+
+}
+
+}
@@ -0,0 +1,242 @@
+/*! \file   Executor.cpp
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the Executor class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/Executor.h>
+#include <vanaheimr/util/interface/NumaTopology.h>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+// The calling thread's slot in the pool, pool threads start at 1, the
+// main thread and any foreign thread share slot 0
+static thread_local unsigned int threadWorkerIndex = 0;
+static thread_local unsigned int threadNode        = 0;
+
+Executor& Executor::instance()
+{
+	static Executor executor;
+
+	return executor;
+}
+
+Executor::Executor()
+: _queuedTasks(0), _pendingTasks(0), _shutdown(false)
+{
+	unsigned int workerCount = std::thread::hardware_concurrency();
+
+	if(workerCount == 0) workerCount = 1;
+
+	for(unsigned int w = 0; w < workerCount; ++w)
+	{
+		_workerStates.push_back(
+			std::unique_ptr<WorkerState>(new WorkerState));
+	}
+
+	// slot 0 belongs to the calling thread
+	for(unsigned int w = 1; w < workerCount; ++w)
+	{
+		_threads.push_back(std::thread(&Executor::_workerLoop, this, w));
+	}
+}
+
+Executor::~Executor()
+{
+	_shutdown = true;
+
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+	}
+
+	_wake.notify_all();
+
+	for(auto& thread : _threads)
+	{
+		thread.join();
+	}
+}
+
+unsigned int Executor::workers() const
+{
+	return _workerStates.size();
+}
+
+unsigned int Executor::currentNode()
+{
+	return threadNode;
+}
+
+void Executor::run(Task task)
+{
+	_push(threadWorkerIndex, std::move(task));
+}
+
+void Executor::wait()
+{
+	while(_pendingTasks.load() != 0)
+	{
+		if(!_runOneTask(threadWorkerIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void Executor::parallelExecute(unsigned int count,
+	const WorkerFunction& function)
+{
+	if(count == 0) return;
+
+	std::atomic<unsigned int> remaining(count - 1);
+
+	for(unsigned int w = 1; w < count; ++w)
+	{
+		run([&function, &remaining, w]()
+		{
+			function(w);
+
+			--remaining;
+		});
+	}
+
+	function(0);
+
+	// help with the region's tasks (or anything else that is queued)
+	// until the last of them retires
+	while(remaining.load() != 0)
+	{
+		if(!_runOneTask(threadWorkerIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void Executor::parallelFor(size_t count, const IndexFunction& function)
+{
+	if(count == 0) return;
+
+	size_t participants = workers();
+
+	if(participants > count) participants = count;
+
+	std::atomic<size_t> next(0);
+
+	parallelExecute(participants, [&](unsigned int)
+	{
+		while(true)
+		{
+			size_t index = next++;
+
+			if(index >= count) break;
+
+			function(index);
+		}
+	});
+}
+
+void Executor::_workerLoop(unsigned int workerIndex)
+{
+	threadWorkerIndex = workerIndex;
+
+	// the pool threads spread round robin over the memory nodes and
+	// stay there, phases that place work by node rely on the mapping
+	unsigned int nodes = NumaTopology::nodeCount();
+
+	threadNode = workerIndex % nodes;
+
+	if(nodes > 1)
+	{
+		NumaTopology::pinCurrentThreadToNode(threadNode);
+	}
+
+	while(true)
+	{
+		if(_runOneTask(workerIndex)) continue;
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+
+		_wake.wait(lock, [this]()
+		{
+			return _shutdown.load() || _queuedTasks.load() != 0;
+		});
+
+		if(_shutdown.load() && _queuedTasks.load() == 0) break;
+	}
+}
+
+bool Executor::_runOneTask(unsigned int workerIndex)
+{
+	Task task;
+	bool found = false;
+
+	// the owner works the bottom of its own deque
+	{
+		auto& state = *_workerStates[workerIndex];
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		if(!state.tasks.empty())
+		{
+			task = std::move(state.tasks.back());
+			state.tasks.pop_back();
+
+			found = true;
+		}
+	}
+
+	// steal from the top of someone else's
+	for(size_t victim = 0; !found && victim < _workerStates.size(); ++victim)
+	{
+		if(victim == workerIndex) continue;
+
+		auto& state = *_workerStates[victim];
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		if(!state.tasks.empty())
+		{
+			task = std::move(state.tasks.front());
+			state.tasks.pop_front();
+
+			found = true;
+		}
+	}
+
+	if(!found) return false;
+
+	--_queuedTasks;
+
+	task();
+
+	--_pendingTasks;
+
+	return true;
+}
+
+void Executor::_push(unsigned int workerIndex, Task task)
+{
+	++_pendingTasks;
+
+	{
+		auto& state = *_workerStates[workerIndex];
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		state.tasks.push_back(std::move(task));
+	}
+
+	++_queuedTasks;
+
+	_wake.notify_one();
+}
+
+}
+
+}
@@ -0,0 +1,137 @@
+/*! \file   InputBuffer.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the InputBuffer class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/InputBuffer.h>
+
+// Standard Library Includes
+#include <istream>
+#include <stdexcept>
+
+// System Includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+InputBuffer::InputBuffer()
+: _data(nullptr), _size(0), _mapping(nullptr), _mappingSize(0)
+{
+
+}
+
+InputBuffer::~InputBuffer()
+{
+	clear();
+}
+
+void InputBuffer::map(const std::string& filename)
+{
+	clear();
+
+	int file = open(filename.c_str(), O_RDONLY);
+
+	if(file < 0)
+	{
+		throw std::runtime_error("Could not open file '" +
+			filename + "' for reading.");
+	}
+
+	struct stat fileInfo;
+
+	if(fstat(file, &fileInfo) != 0)
+	{
+		close(file);
+
+		throw std::runtime_error("Could not stat file '" + filename + "'.");
+	}
+
+	size_t fileSize = fileInfo.st_size;
+
+	if(fileSize == 0)
+	{
+		close(file);
+
+		return;
+	}
+
+	void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+
+	// the descriptor is not needed once the mapping exists
+	close(file);
+
+	if(mapping == MAP_FAILED)
+	{
+		throw std::runtime_error("Could not map file '" + filename + "'.");
+	}
+
+	_mapping     = mapping;
+	_mappingSize = fileSize;
+
+	_data = (const char*)mapping;
+	_size = fileSize;
+}
+
+void InputBuffer::read(std::istream& stream)
+{
+	clear();
+
+	stream.clear();
+	stream.seekg(0, std::ios::end);
+
+	size_t streamSize = stream.tellg();
+
+	stream.seekg(0, std::ios::beg);
+
+	_ownedText.resize(streamSize);
+
+	stream.read((char*)_ownedText.data(), streamSize);
+
+	_data = _ownedText.data();
+	_size = _ownedText.size();
+}
+
+const char* InputBuffer::data() const
+{
+	return _data;
+}
+
+size_t InputBuffer::size() const
+{
+	return _size;
+}
+
+bool InputBuffer::empty() const
+{
+	return _size == 0;
+}
+
+void InputBuffer::clear()
+{
+	if(_mapping != nullptr)
+	{
+		munmap(_mapping, _mappingSize);
+
+		_mapping     = nullptr;
+		_mappingSize = 0;
+	}
+
+	_ownedText.clear();
+
+	_data = nullptr;
+	_size = 0;
+}
+
+}
+
+}
+
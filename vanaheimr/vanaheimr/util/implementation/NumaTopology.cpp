@@ -0,0 +1,118 @@
+/*! \file   NumaTopology.cpp
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the NumaTopology class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/NumaTopology.h>
+
+// Standard Library Includes
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+// System Includes
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+#ifdef __linux__
+
+static std::string nodePath(unsigned int node)
+{
+	std::stringstream path;
+
+	path << "/sys/devices/system/node/node" << node << "/cpulist";
+
+	return path.str();
+}
+
+static unsigned int countNodes()
+{
+	unsigned int count = 0;
+
+	while(std::ifstream(nodePath(count)).is_open())
+	{
+		++count;
+	}
+
+	return count == 0 ? 1 : count;
+}
+
+unsigned int NumaTopology::nodeCount()
+{
+	static const unsigned int count = countNodes();
+
+	return count;
+}
+
+void NumaTopology::pinCurrentThreadToNode(unsigned int node)
+{
+	std::ifstream file(nodePath(node));
+
+	if(!file.is_open()) return;
+
+	std::string list;
+
+	std::getline(file, list);
+
+	cpu_set_t cpus;
+
+	CPU_ZERO(&cpus);
+
+	bool any = false;
+
+	// the list is comma separated ranges, e.g. "0-7,16-23"
+	std::stringstream stream(list);
+	std::string       range;
+
+	while(std::getline(stream, range, ','))
+	{
+		unsigned int begin = std::atoi(range.c_str());
+		unsigned int end   = begin;
+
+		auto dash = range.find('-');
+
+		if(dash != std::string::npos)
+		{
+			end = std::atoi(range.c_str() + dash + 1);
+		}
+
+		for(unsigned int cpu = begin; cpu <= end && cpu < CPU_SETSIZE; ++cpu)
+		{
+			CPU_SET(cpu, &cpus);
+
+			any = true;
+		}
+	}
+
+	if(!any) return;
+
+	sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+
+#else
+
+unsigned int NumaTopology::nodeCount()
+{
+	return 1;
+}
+
+void NumaTopology::pinCurrentThreadToNode(unsigned int)
+{
+
+}
+
+#endif
+
+}
+
+}
@@ -0,0 +1,131 @@
+/*! \file   StringBuffer.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the StringBuffer class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringBuffer.h>
+
+// Standard Library Includes
+#include <cstring>
+#include <cstdio>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+StringBuffer::StringBuffer()
+{
+
+}
+
+void StringBuffer::append(char character)
+{
+	_data.push_back(character);
+}
+
+void StringBuffer::append(const char* text)
+{
+	_data.insert(_data.end(), text, text + std::strlen(text));
+}
+
+void StringBuffer::append(const char* begin, const char* end)
+{
+	_data.insert(_data.end(), begin, end);
+}
+
+void StringBuffer::append(const std::string& text)
+{
+	_data.insert(_data.end(), text.begin(), text.end());
+}
+
+void StringBuffer::appendInteger(int64_t value)
+{
+	if(value < 0)
+	{
+		_data.push_back('-');
+
+		value = -value;
+	}
+
+	appendInteger((uint64_t)value);
+}
+
+void StringBuffer::appendInteger(uint64_t value)
+{
+	// format the digits backwards into a scratch buffer
+	char digits[20];
+
+	char* digit = digits;
+
+	do
+	{
+		*digit++ = '0' + value % 10;
+
+		value /= 10;
+	}
+	while(value != 0);
+
+	while(digit != digits) _data.push_back(*--digit);
+}
+
+void StringBuffer::appendHex(uint64_t value)
+{
+	char digits[16];
+
+	char* digit = digits;
+
+	do
+	{
+		*digit++ = "0123456789abcdef"[value & 0xf];
+
+		value >>= 4;
+	}
+	while(value != 0);
+
+	while(digit != digits) _data.push_back(*--digit);
+}
+
+void StringBuffer::appendFloat(double value)
+{
+	// matches the six significant digit default of ostream insertion
+	char buffer[32];
+
+	int size = std::snprintf(buffer, sizeof(buffer), "%g", value);
+
+	_data.insert(_data.end(), buffer, buffer + size);
+}
+
+const char* StringBuffer::data() const
+{
+	return _data.data();
+}
+
+size_t StringBuffer::size() const
+{
+	return _data.size();
+}
+
+bool StringBuffer::empty() const
+{
+	return _data.empty();
+}
+
+void StringBuffer::clear()
+{
+	_data.clear();
+}
+
+void StringBuffer::flush(std::ostream& stream)
+{
+	stream.write(_data.data(), _data.size());
+
+	_data.clear();
+}
+
+}
+
+}
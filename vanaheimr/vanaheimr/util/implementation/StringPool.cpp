@@ -0,0 +1,72 @@
+/*! \file   StringPool.cpp
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the StringPool class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringPool.h>
+
+// Standard Library Includes
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+StringPool::StringPool()
+{
+
+}
+
+StringPool::StringId StringPool::intern(const std::string& string)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto existing = _ids.find(string);
+
+	if(existing != _ids.end()) return existing->second;
+
+	StringId id = _strings.size();
+
+	auto inserted = _ids.insert(std::make_pair(string, id));
+
+	// the map node owns the string, the deque only indexes it
+	_strings.push_back(&inserted.first->first);
+
+	return id;
+}
+
+StringPool::StringId StringPool::lookup(const std::string& string) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto existing = _ids.find(string);
+
+	if(existing != _ids.end()) return existing->second;
+
+	return InvalidStringId;
+}
+
+const std::string& StringPool::string(StringId id) const
+{
+	assert(id < _strings.size());
+
+	return *_strings[id];
+}
+
+size_t StringPool::size() const
+{
+	return _strings.size();
+}
+
+bool StringPool::empty() const
+{
+	return _strings.empty();
+}
+
+}
+
+}
@@ -0,0 +1,236 @@
+/*! \file   StringRef.cpp
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The source file for the StringRef class.
+*/
+
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/StringRef.h>
+
+// Standard Library Includes
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+const size_t StringRef::npos;
+
+StringRef::StringRef()
+: _data(nullptr), _size(0)
+{
+
+}
+
+StringRef::StringRef(const char* data, size_t size)
+: _data(data), _size(size)
+{
+
+}
+
+StringRef::StringRef(const char* cString)
+: _data(cString), _size(std::strlen(cString))
+{
+
+}
+
+StringRef::StringRef(const std::string& string)
+: _data(string.data()), _size(string.size())
+{
+
+}
+
+const char* StringRef::data() const
+{
+	return _data;
+}
+
+size_t StringRef::size() const
+{
+	return _size;
+}
+
+bool StringRef::empty() const
+{
+	return _size == 0;
+}
+
+char StringRef::operator[](size_t index) const
+{
+	assert(index < _size);
+
+	return _data[index];
+}
+
+char StringRef::front() const
+{
+	assert(!empty());
+
+	return _data[0];
+}
+
+char StringRef::back() const
+{
+	assert(!empty());
+
+	return _data[_size - 1];
+}
+
+const char* StringRef::begin() const
+{
+	return _data;
+}
+
+const char* StringRef::end() const
+{
+	return _data + _size;
+}
+
+StringRef StringRef::substr(size_t position, size_t length) const
+{
+	assert(position <= _size);
+
+	return StringRef(_data + position, std::min(length, _size - position));
+}
+
+size_t StringRef::find(char character, size_t position) const
+{
+	for(; position < _size; ++position)
+	{
+		if(_data[position] == character) return position;
+	}
+
+	return npos;
+}
+
+size_t StringRef::find(const StringRef& string, size_t position) const
+{
+	if(string.size() > _size) return npos;
+
+	for(; position + string.size() <= _size; ++position)
+	{
+		if(std::memcmp(_data + position,
+			string.data(), string.size()) == 0)
+		{
+			return position;
+		}
+	}
+
+	return npos;
+}
+
+int StringRef::compare(const StringRef& string) const
+{
+	int result = std::memcmp(_data, string._data,
+		std::min(_size, string._size));
+
+	if(result != 0) return result;
+
+	if(_size < string._size) return -1;
+	if(_size > string._size) return  1;
+
+	return 0;
+}
+
+bool StringRef::operator==(const StringRef& string) const
+{
+	if(_size != string._size) return false;
+
+	return std::memcmp(_data, string._data, _size) == 0;
+}
+
+bool StringRef::operator!=(const StringRef& string) const
+{
+	return !(*this == string);
+}
+
+bool StringRef::operator==(const char* string) const
+{
+	return *this == StringRef(string);
+}
+
+bool StringRef::operator!=(const char* string) const
+{
+	return !(*this == string);
+}
+
+bool StringRef::operator==(const std::string& string) const
+{
+	return *this == StringRef(string);
+}
+
+bool StringRef::operator!=(const std::string& string) const
+{
+	return !(*this == string);
+}
+
+bool StringRef::operator<(const StringRef& string) const
+{
+	return compare(string) < 0;
+}
+
+std::string StringRef::str() const
+{
+	return std::string(_data, _size);
+}
+
+StringRef::operator std::string() const
+{
+	return str();
+}
+
+bool operator==(const char* left, const StringRef& right)
+{
+	return right == left;
+}
+
+bool operator!=(const char* left, const StringRef& right)
+{
+	return right != left;
+}
+
+bool operator==(const std::string& left, const StringRef& right)
+{
+	return right == left;
+}
+
+bool operator!=(const std::string& left, const StringRef& right)
+{
+	return right != left;
+}
+
+std::string operator+(const std::string& left, const StringRef& right)
+{
+	return left + right.str();
+}
+
+std::string operator+(const StringRef& left, const std::string& right)
+{
+	return left.str() + right;
+}
+
+std::string operator+(const char* left, const StringRef& right)
+{
+	return left + right.str();
+}
+
+std::string operator+(const StringRef& left, const char* right)
+{
+	return left.str() + right;
+}
+
+std::ostream& operator<<(std::ostream& stream, const StringRef& string)
+{
+	stream.write(string.data(), string.size());
+
+	return stream;
+}
+
+}
+
+}
+
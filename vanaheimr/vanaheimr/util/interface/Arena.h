@@ -0,0 +1,110 @@
+/*! \file   Arena.h
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the Arena class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A chunked bump allocator.  Objects are allocated with a pointer
+	increment and are never freed individually, the entire arena is torn
+	down at once.  This trades individual deallocation for fast allocation
+	and dense placement of objects that are built and traversed together. */
+class Arena
+{
+public:
+	/*! \brief Create an arena, optionally overriding the chunk size */
+	explicit Arena(size_t chunkSize = DefaultChunkSize);
+	~Arena();
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+public:
+	/*! \brief Allocate raw storage with the specified alignment */
+	void* allocate(size_t size, size_t alignment = sizeof(void*));
+
+	/*! \brief Construct an object in the arena, its destructor is run
+		when the arena is cleared or destroyed */
+	template<typename T, typename... Args>
+	T* construct(Args&&... args)
+	{
+		void* storage = allocate(sizeof(T), alignof(T));
+
+		T* object = new(storage) T(std::forward<Args>(args)...);
+
+		_registerDestructor(object, &_destroy<T>);
+
+		return object;
+	}
+
+	/*! \brief Ensure the specified number of bytes can be allocated
+		without growing.  One right-sized chunk up front replaces the
+		series of growth chunks a cold arena would pay for */
+	void reserve(size_t bytes);
+
+	/*! \brief Run all registered destructors and release all chunks */
+	void clear();
+
+public:
+	/*! \brief The total number of bytes reserved by the arena */
+	size_t capacity() const;
+	/*! \brief The total number of bytes handed out to objects */
+	size_t allocated() const;
+
+public:
+	/*! \brief The total bytes reserved by every arena since process start.
+
+		The counter is monotonic and chunk granular, so the difference
+		across an interval bounds the arena memory touched during it.
+		It is maintained in _addChunk, so allocate itself stays free of
+		bookkeeping */
+	static size_t globalBytesReserved();
+
+public:
+	static const size_t DefaultChunkSize = 1 << 16;
+
+private:
+	typedef void (*DestructorCallback)(void*);
+
+	typedef std::pair<void*, DestructorCallback> DestructorRecord;
+
+	typedef std::vector<char*>            ChunkVector;
+	typedef std::vector<DestructorRecord> DestructorVector;
+
+private:
+	template<typename T>
+	static void _destroy(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+
+	void _registerDestructor(void* object, DestructorCallback destructor);
+	void _addChunk(size_t minimumSize);
+
+private:
+	ChunkVector      _chunks;
+	DestructorVector _destructors;
+
+	char*  _next;
+	char*  _end;
+	size_t _chunkSize;
+	size_t _allocated;
+	size_t _capacity;
+};
+
+}
+
+}
@@ -0,0 +1,158 @@
+/*! \file   BitVector.h
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the BitVector class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A dense word-packed bitset shared by the dataflow-style analyses.
+
+	The meet and transfer operators run as 64-bit word operations, set bits
+	are enumerated with count-trailing-zeros.  One cache line of words
+	lives inside the object, so the per-block rows of a small function
+	never touch the heap, and heap storage is cache-line-aligned so that
+	one row never straddles lines during the solver sweeps. */
+class BitVector
+{
+public:
+	static const size_t BitsPerWord = 64;
+	/*! \brief Inline storage, one full cache line of words */
+	static const size_t InlineWords = 8;
+
+public:
+	BitVector();
+	/*! \brief Create a vector of the specified bit count, all bits are
+		initialized to the specified value */
+	explicit BitVector(size_t bits, bool value = false);
+	BitVector(const BitVector&);
+	BitVector(BitVector&&);
+	~BitVector();
+
+	BitVector& operator=(const BitVector&);
+	BitVector& operator=(BitVector&&);
+
+public:
+	/*! \brief The size in bits */
+	size_t size() const { return _bits; }
+	bool   empty() const { return _bits == 0; }
+
+	/*! \brief The number of packed words backing the bits */
+	size_t words() const
+	{
+		return (_bits + BitsPerWord - 1) / BitsPerWord;
+	}
+
+public:
+	bool test(size_t bit) const
+	{
+		assert(bit < _bits);
+
+		return (_words[bit / BitsPerWord] &
+			((uint64_t)1 << (bit % BitsPerWord))) != 0;
+	}
+
+	void set(size_t bit)
+	{
+		assert(bit < _bits);
+
+		_words[bit / BitsPerWord] |= (uint64_t)1 << (bit % BitsPerWord);
+	}
+
+	void reset(size_t bit)
+	{
+		assert(bit < _bits);
+
+		_words[bit / BitsPerWord] &= ~((uint64_t)1 << (bit % BitsPerWord));
+	}
+
+public:
+	void setAll();
+	void resetAll();
+
+	/*! \brief Set the bits in [begin, end) */
+	void setRange(size_t begin, size_t end);
+	/*! \brief Clear the bits in [begin, end) */
+	void resetRange(size_t begin, size_t end);
+
+public:
+	/*! \brief Word-parallel or with an equally sized vector, returns
+		true if any bit changed */
+	bool unionWith(const BitVector&);
+	/*! \brief Word-parallel and with an equally sized vector, returns
+		true if any bit changed */
+	bool intersectWith(const BitVector&);
+	/*! \brief Word-parallel and-not with an equally sized vector, returns
+		true if any bit changed */
+	bool subtract(const BitVector&);
+
+public:
+	/*! \brief Are all bits clear? */
+	bool none() const;
+	/*! \brief The number of set bits */
+	size_t count() const;
+
+	bool operator==(const BitVector&) const;
+	bool operator!=(const BitVector& v) const { return !(*this == v); }
+
+public:
+	/*! \brief Call the visitor with the index of every set bit, in
+		increasing order.  Words are scanned with count-trailing-zeros, so
+		the cost is proportional to the number of set bits */
+	template<typename Visitor>
+	void forEachSetBit(Visitor visit) const
+	{
+		size_t wordCount = words();
+
+		for(size_t word = 0; word != wordCount; ++word)
+		{
+			uint64_t bits = _words[word];
+
+			while(bits != 0)
+			{
+				unsigned int bit = __builtin_ctzll(bits);
+
+				visit(word * BitsPerWord + bit);
+
+				bits &= bits - 1;
+			}
+		}
+	}
+
+public:
+	/*! \brief The packed words, exposed for fused multi-operand kernels
+		(e.g. in = use | (out & ~def) in one sweep).  Bits beyond size()
+		in the last word are always zero */
+	      uint64_t* data()       { return _words; }
+	const uint64_t* data() const { return _words; }
+
+private:
+	bool _isInline() const { return _words == _inlineWords; }
+
+	void _allocate(size_t bits);
+	void _release();
+	/*! \brief Keep the bits beyond size() in the last word zero, so that
+		count, none, and comparison never see them */
+	void _clearTrailingBits();
+
+private:
+	uint64_t* _words;
+	size_t    _bits;
+
+	alignas(64) uint64_t _inlineWords[InlineWords];
+};
+
+}
+
+}
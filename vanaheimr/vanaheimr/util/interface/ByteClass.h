@@ -0,0 +1,53 @@
+/*! \file   ByteClass.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ByteClass class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstddef>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A set of byte values laid out for fast run scanning.
+
+	Membership is stored both as a 256-bit bitmap and as a 16-byte
+	nibble table, so scanning a run of member bytes can classify
+	sixteen bytes per step with SSE shuffles when the compiler targets
+	them, or an unrolled block test otherwise. */
+class ByteClass
+{
+public:
+	ByteClass();
+
+public:
+	void insert(unsigned char byte);
+
+	bool contains(unsigned char byte) const;
+
+	bool empty() const;
+
+public:
+	/*! \brief Advance over a run of member bytes,
+		returns the position of the first byte not in the class */
+	size_t scan(const char* text, size_t position, size_t end) const;
+
+private:
+	unsigned char _bits[32];       // 256-bit membership bitmap
+	unsigned char _columnBits[16]; // row bits of members, by low nibble
+
+	bool _ascii; // the shuffle path only classifies 7-bit members
+	bool _empty;
+
+};
+
+}
+
+}
+
@@ -0,0 +1,197 @@
+/*! \file   ConcurrentMap.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ConcurrentMap class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief An insert-only map shared by concurrent readers and writers.
+
+	The table is split into shards of hash buckets.  Entries are nodes
+	pushed onto per-bucket chains with a release store, so readers walk
+	the chains with a single acquire load and no lock.  Writers only
+	take the lock of the shard they insert into, so unrelated inserts
+	do not serialize.  Nodes are never removed or rehashed, which is
+	what makes the lock-free reads safe; use this for registries that
+	only grow, not for general purpose maps. */
+template<typename Key, typename Value>
+class ConcurrentMap
+{
+public:
+	typedef std::pair<const Key, Value> value_type;
+
+public:
+	ConcurrentMap() : _size(0)
+	{
+		for(size_t shard = 0; shard < ShardCount; ++shard)
+		{
+			for(size_t bucket = 0; bucket < BucketsPerShard; ++bucket)
+			{
+				_shards[shard].buckets[bucket].store(nullptr,
+					std::memory_order_relaxed);
+			}
+		}
+	}
+
+	~ConcurrentMap()
+	{
+		for(size_t shard = 0; shard < ShardCount; ++shard)
+		{
+			for(size_t bucket = 0; bucket < BucketsPerShard; ++bucket)
+			{
+				Node* node = _shards[shard].buckets[bucket].load(
+					std::memory_order_relaxed);
+
+				while(node != nullptr)
+				{
+					Node* next = node->next;
+
+					delete node;
+
+					node = next;
+				}
+			}
+		}
+	}
+
+public:
+	ConcurrentMap(const ConcurrentMap&) = delete;
+	ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+public:
+	/*! \brief Look a key up without locking, returns the mapped value
+		or null.  The pointer stays valid for the life of the map */
+	Value* find(const Key& key)
+	{
+		Node* node = _findNode(key);
+
+		return node == nullptr ? nullptr : &node->entry.second;
+	}
+
+	const Value* find(const Key& key) const
+	{
+		Node* node = _findNode(key);
+
+		return node == nullptr ? nullptr : &node->entry.second;
+	}
+
+	/*! \brief Insert under the owning shard's lock.  Returns the mapped
+		value and whether this call inserted it */
+	std::pair<Value*, bool> insert(const Key& key, const Value& value)
+	{
+		size_t hash = _hash(key);
+
+		Shard& shard = _shards[_shardIndex(hash)];
+
+		std::lock_guard<std::mutex> guard(shard.lock);
+
+		std::atomic<Node*>& bucket = shard.buckets[_bucketIndex(hash)];
+
+		for(Node* node = bucket.load(std::memory_order_relaxed);
+			node != nullptr; node = node->next)
+		{
+			if(node->entry.first == key)
+			{
+				return std::make_pair(&node->entry.second, false);
+			}
+		}
+
+		Node* node = new Node(key, value,
+			bucket.load(std::memory_order_relaxed));
+
+		// publish the node, readers that see it see its entry
+		bucket.store(node, std::memory_order_release);
+
+		_size.fetch_add(1, std::memory_order_relaxed);
+
+		return std::make_pair(&node->entry.second, true);
+	}
+
+public:
+	size_t size() const
+	{
+		return _size.load(std::memory_order_relaxed);
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+private:
+	static const size_t ShardCount      = 16;
+	static const size_t BucketsPerShard = 64;
+
+	struct Node
+	{
+		Node(const Key& key, const Value& value, Node* n)
+		: entry(key, value), next(n) {}
+
+		value_type entry;
+		Node*      next;
+	};
+
+	struct Shard
+	{
+		std::mutex         lock;
+		std::atomic<Node*> buckets[BucketsPerShard];
+	};
+
+private:
+	static size_t _hash(const Key& key)
+	{
+		// spread the low bits before masking into shards and buckets
+		return std::hash<Key>()(key) * 0x9e3779b97f4a7c15ull;
+	}
+
+	static size_t _shardIndex(size_t hash)
+	{
+		return hash & (ShardCount - 1);
+	}
+
+	static size_t _bucketIndex(size_t hash)
+	{
+		return (hash / ShardCount) & (BucketsPerShard - 1);
+	}
+
+	Node* _findNode(const Key& key) const
+	{
+		size_t hash = _hash(key);
+
+		const Shard& shard = _shards[_shardIndex(hash)];
+
+		// an acquire load of the head orders the walk after the
+		// publishing stores
+		for(Node* node = shard.buckets[_bucketIndex(hash)].load(
+			std::memory_order_acquire); node != nullptr; node = node->next)
+		{
+			if(node->entry.first == key) return node;
+		}
+
+		return nullptr;
+	}
+
+private:
+	Shard _shards[ShardCount];
+
+	std::atomic<size_t> _size;
+};
+
+}
+
+}
+
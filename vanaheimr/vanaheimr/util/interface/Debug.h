@@ -0,0 +1,80 @@
+/*! \file   Debug.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <gregory.diamos@gatech.edu>
+	\brief  The header file for compile-time leveled reporting.
+
+	Each translation unit declares its verbosity with REPORT_BASE as
+	before, but the report macros here test it against the build-wide
+	VANAHEIMR_REPORT_LEVEL ceiling.  Both sides of the test are integral
+	constants, so a level the build strips removes the whole statement,
+	message construction included.  Release (NDEBUG) builds default the
+	ceiling to zero and contain no logging code at all.
+
+	Debugging builds retain a runtime filter on top, set the
+	VANAHEIMR_REPORT_FILTER environment variable to silence levels the
+	build kept.
+*/
+
+#pragma once
+
+// Hydrazine Includes
+#include <hydrazine/interface/debug.h>
+
+// Standard Library Includes
+#include <iostream>
+
+#ifndef VANAHEIMR_REPORT_LEVEL
+	#ifdef NDEBUG
+		#define VANAHEIMR_REPORT_LEVEL 0
+	#else
+		#define VANAHEIMR_REPORT_LEVEL 10
+	#endif
+#endif
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief The compile-time enable switch for one reporting level */
+template<unsigned int level>
+class ReportLevel
+{
+public:
+	enum { enabled = (level > 0) && (level <= VANAHEIMR_REPORT_LEVEL) };
+};
+
+/*! \brief The runtime reporting threshold.
+
+	Read once from the VANAHEIMR_REPORT_FILTER environment variable, it
+	defaults to everything the build kept */
+unsigned int reportThreshold();
+
+}
+
+}
+
+// Replace hydrazine's runtime-only macros with the leveled versions
+#ifdef report
+#undef report
+#endif
+
+#ifdef reportE
+#undef reportE
+#endif
+
+#define report(y) \
+	if(::vanaheimr::util::ReportLevel<(REPORT_BASE)>::enabled && \
+		(unsigned int)(REPORT_BASE) <= ::vanaheimr::util::reportThreshold()) \
+	{ \
+		std::cout << __FILE__ << ":" << __LINE__ << ": " << y << "\n"; \
+	}
+
+#define reportE(x, y) \
+	if(::vanaheimr::util::ReportLevel<(REPORT_BASE)>::enabled && \
+		(unsigned int)(REPORT_BASE) <= ::vanaheimr::util::reportThreshold() \
+		&& (x)) \
+	{ \
+		std::cout << __FILE__ << ":" << __LINE__ << ": " << y << "\n"; \
+	}
@@ -0,0 +1,118 @@
+/*! \file   Executor.h
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the Executor class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief The process wide work stealing thread pool.
+
+	There is one pool per process, shared by every parallel phase, so
+	the compiler never oversubscribes the machine with competing ad hoc
+	pools.  Each worker owns a deque, it pushes and pops tasks at the
+	bottom while idle workers steal from the top, which keeps the common
+	case contention free.  The pool threads are pinned round robin over
+	the memory nodes, and a thread's node is stable for the life of the
+	process, so phases that place work by node can rely on it.
+
+	The calling thread always participates, submitting a parallel region
+	from a pool worker nests instead of deadlocking */
+class Executor
+{
+public:
+	typedef std::function<void()>             Task;
+	typedef std::function<void(unsigned int)> WorkerFunction;
+	typedef std::function<void(size_t)>       IndexFunction;
+
+public:
+	/*! \brief The pool, started on first use */
+	static Executor& instance();
+
+public:
+	Executor(const Executor&) = delete;
+	Executor& operator=(const Executor&) = delete;
+
+public:
+	/*! \brief The number of workers, the calling thread included */
+	unsigned int workers() const;
+
+	/*! \brief The memory node the calling thread is pinned to, 0 for
+		threads outside the pool */
+	static unsigned int currentNode();
+
+public:
+	/*! \brief Submit one task, it runs on any worker */
+	void run(Task task);
+
+	/*! \brief Help run tasks until every submitted task has finished */
+	void wait();
+
+public:
+	/*! \brief Run a functor once per worker index in [0, count), the
+		calling thread runs index 0 and helps until the rest finish */
+	void parallelExecute(unsigned int count, const WorkerFunction& function);
+
+	/*! \brief Apply a functor to every index in [0, count), the indexes
+		are claimed dynamically so uneven work balances itself */
+	void parallelFor(size_t count, const IndexFunction& function);
+
+private:
+	Executor();
+	~Executor();
+
+private:
+	/*! \brief One worker's deque, the owner uses the bottom and
+		thieves take from the top */
+	class WorkerState
+	{
+	public:
+		std::deque<Task> tasks;
+		std::mutex       mutex;
+	};
+
+	typedef std::vector<std::unique_ptr<WorkerState>> WorkerStateVector;
+
+private:
+	void _workerLoop(unsigned int workerIndex);
+
+	/*! \brief Pop a local task or steal one and run it, false when
+		every deque is empty */
+	bool _runOneTask(unsigned int workerIndex);
+
+	void _push(unsigned int workerIndex, Task task);
+
+private:
+	WorkerStateVector        _workerStates;
+	std::vector<std::thread> _threads;
+
+	/*! \brief Tasks sitting in deques, the workers sleep when it is 0 */
+	std::atomic<size_t> _queuedTasks;
+	/*! \brief Submitted tasks that have not finished running */
+	std::atomic<size_t> _pendingTasks;
+
+	std::mutex              _sleepMutex;
+	std::condition_variable _wake;
+
+	std::atomic<bool> _shutdown;
+};
+
+}
+
+}
@@ -0,0 +1,66 @@
+/*! \file   InputBuffer.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the InputBuffer class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <iosfwd>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A contiguous view of an input file or stream.
+
+	Named files are memory mapped so the reader works out of the kernel's
+	page cache directly, no copy of the file is ever made.  Arbitrary
+	streams fall back to a single read into an owned buffer. */
+class InputBuffer
+{
+public:
+	InputBuffer();
+	~InputBuffer();
+
+public:
+	InputBuffer(const InputBuffer&) = delete;
+	InputBuffer& operator=(const InputBuffer&) = delete;
+
+public:
+	/*! \brief Memory map the named file, replacing the current contents */
+	void map(const std::string& filename);
+
+	/*! \brief Read an entire stream, replacing the current contents */
+	void read(std::istream& stream);
+
+public:
+	const char* data() const;
+	size_t      size() const;
+	bool       empty() const;
+
+public:
+	void clear();
+
+private:
+	const char* _data;
+	size_t      _size;
+
+private:
+	// non-null when the buffer is a file mapping
+	void*  _mapping;
+	size_t _mappingSize;
+
+	// used when the contents were read from a stream
+	std::string _ownedText;
+
+};
+
+}
+
+}
+
@@ -7,7 +7,10 @@
 #pragma once
 
 // Standard Library Includes
-#include <map>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -16,15 +19,404 @@ namespace util
 {
 
 
-/*! \brief A class optimized to store a large unique map of objects */
+/*! \brief A class optimized to store a large unique map of objects.
+
+	The entries live in one flat open-addressing hash table with linear
+	probing, so a lookup is a hash and a short scan over contiguous
+	memory instead of a pointer chase through tree nodes, and the only
+	allocation is the slot array itself.  Erased slots are tombstoned
+	and reclaimed on the next rehash.  Iteration order follows the table,
+	not the key order. */
 template<typename Key, typename Value>
-class LargeMap : public std::map<Key, Value>
+class LargeMap
 {
+public:
+	typedef std::pair<Key, Value> value_type;
+
+	typedef Key   key_type;
+	typedef Value mapped_type;
+
+public:
+	class const_iterator;
+
+	class iterator
+	{
+	public:
+		iterator() : _map(0), _index(0) {}
+
+	public:
+		value_type& operator*()  const { return  _map->_slots[_index]; }
+		value_type* operator->() const { return &_map->_slots[_index]; }
+
+		iterator& operator++()
+		{
+			_index = _map->_nextFull(_index + 1);
+
+			return *this;
+		}
+
+		bool operator==(const iterator& i) const
+		{
+			return _index == i._index;
+		}
+
+		bool operator!=(const iterator& i) const
+		{
+			return _index != i._index;
+		}
+
+	private:
+		iterator(LargeMap* map, size_t index) : _map(map), _index(index) {}
+
+	private:
+		LargeMap* _map;
+		size_t    _index;
+
+		friend class LargeMap;
+		friend class const_iterator;
+	};
+
+	class const_iterator
+	{
+	public:
+		const_iterator() : _map(0), _index(0) {}
+
+		const_iterator(const iterator& i) : _map(i._map), _index(i._index) {}
+
+	public:
+		const value_type& operator*()  const { return  _map->_slots[_index]; }
+		const value_type* operator->() const { return &_map->_slots[_index]; }
+
+		const_iterator& operator++()
+		{
+			_index = _map->_nextFull(_index + 1);
+
+			return *this;
+		}
+
+		bool operator==(const const_iterator& i) const
+		{
+			return _index == i._index;
+		}
+
+		bool operator!=(const const_iterator& i) const
+		{
+			return _index != i._index;
+		}
+
+	private:
+		const_iterator(const LargeMap* map, size_t index)
+		: _map(map), _index(index) {}
+
+	private:
+		const LargeMap* _map;
+		size_t          _index;
+
+		friend class LargeMap;
+	};
+
+public:
+	LargeMap() : _slots(0), _states(0), _capacity(0), _size(0), _deleted(0) {}
+
+	LargeMap(const LargeMap& m)
+	: _slots(0), _states(0), _capacity(0), _size(0), _deleted(0)
+	{
+		reserve(m.size());
+
+		for(const_iterator i = m.begin(); i != m.end(); ++i) insert(*i);
+	}
+
+	LargeMap& operator=(const LargeMap& m)
+	{
+		if(this == &m) return *this;
+
+		clear();
+		reserve(m.size());
+
+		for(const_iterator i = m.begin(); i != m.end(); ++i) insert(*i);
+
+		return *this;
+	}
+
+	~LargeMap()
+	{
+		clear();
+
+		::operator delete(_slots);
+		delete[] _states;
+	}
+
+public:
+	iterator       begin()       { return iterator(this, _nextFull(0));       }
+	const_iterator begin() const { return const_iterator(this, _nextFull(0)); }
+	iterator       end()         { return iterator(this, _capacity);          }
+	const_iterator end()   const { return const_iterator(this, _capacity);    }
+
+public:
+	size_t size()  const { return _size;      }
+	bool   empty() const { return _size == 0; }
+
+	void clear()
+	{
+		for(size_t i = 0; i < _capacity; ++i)
+		{
+			if(_states[i] == Full) _slots[i].~value_type();
+
+			_states[i] = Empty;
+		}
+
+		_size    = 0;
+		_deleted = 0;
+	}
+
+	/*! \brief Size the table for the expected entry count up front, so
+		that filling it rehashes nothing */
+	void reserve(size_t expectedSize)
+	{
+		size_t needed = MinimumCapacity;
+
+		// grow until the expected entries fit under the load limit
+		while(needed * MaxLoadNumerator
+			< expectedSize * MaxLoadDenominator)
+		{
+			needed *= 2;
+		}
+
+		if(needed > _capacity) _rehash(needed);
+	}
+
+public:
+	Value& operator[](const Key& key)
+	{
+		_growIfNeeded();
+
+		bool found = false;
+
+		size_t index = _findSlot(key, found);
+
+		if(found) return _slots[index].second;
+
+		_fillSlot(index, value_type(key, Value()));
+
+		return _slots[index].second;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& value)
+	{
+		_growIfNeeded();
+
+		bool found = false;
+
+		size_t index = _findSlot(value.first, found);
+
+		if(found) return std::make_pair(iterator(this, index), false);
+
+		_fillSlot(index, value);
 
+		return std::make_pair(iterator(this, index), true);
+	}
+
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		for(; first != last; ++first) insert(*first);
+	}
+
+public:
+	iterator find(const Key& key)
+	{
+		return iterator(this, _findExisting(key));
+	}
+
+	const_iterator find(const Key& key) const
+	{
+		return const_iterator(this, _findExisting(key));
+	}
+
+	size_t count(const Key& key) const
+	{
+		return _findExisting(key) == _capacity ? 0 : 1;
+	}
+
+public:
+	iterator erase(iterator position)
+	{
+		_eraseSlot(position._index);
+
+		return iterator(this, _nextFull(position._index + 1));
+	}
+
+	size_t erase(const Key& key)
+	{
+		size_t index = _findExisting(key);
+
+		if(index == _capacity) return 0;
+
+		_eraseSlot(index);
+
+		return 1;
+	}
+
+private:
+	enum SlotState
+	{
+		Empty   = 0,
+		Full    = 1,
+		Deleted = 2
+	};
+
+	static const size_t MinimumCapacity    = 16;
+	static const size_t MaxLoadNumerator   = 7;
+	static const size_t MaxLoadDenominator = 10;
+
+private:
+	static size_t _hash(const Key& key)
+	{
+		// spread the low bits before masking to a power of two table
+		return std::hash<Key>()(key) * 0x9e3779b97f4a7c15ull;
+	}
+
+	size_t _nextFull(size_t index) const
+	{
+		while(index < _capacity && _states[index] != Full) ++index;
+
+		return index;
+	}
+
+	/*! \brief Probe for a key, reporting the matching slot or the best
+		slot to insert it into */
+	size_t _findSlot(const Key& key, bool& found) const
+	{
+		size_t mask      = _capacity - 1;
+		size_t index     = _hash(key) & mask;
+		size_t insertion = _capacity;
+
+		while(true)
+		{
+			if(_states[index] == Empty)
+			{
+				found = false;
+
+				return insertion != _capacity ? insertion : index;
+			}
+
+			if(_states[index] == Deleted)
+			{
+				if(insertion == _capacity) insertion = index;
+			}
+			else if(_slots[index].first == key)
+			{
+				found = true;
+
+				return index;
+			}
+
+			index = (index + 1) & mask;
+		}
+	}
+
+	size_t _findExisting(const Key& key) const
+	{
+		if(_size == 0) return _capacity;
+
+		bool found = false;
+
+		size_t index = _findSlot(key, found);
+
+		return found ? index : _capacity;
+	}
+
+	void _fillSlot(size_t index, const value_type& value)
+	{
+		if(_states[index] == Deleted) --_deleted;
+
+		new(_slots + index) value_type(value);
+
+		_states[index] = Full;
+
+		++_size;
+	}
+
+	void _eraseSlot(size_t index)
+	{
+		_slots[index].~value_type();
+
+		_states[index] = Deleted;
+
+		--_size;
+		++_deleted;
+	}
+
+	void _growIfNeeded()
+	{
+		if(_capacity == 0)
+		{
+			_rehash(MinimumCapacity);
+
+			return;
+		}
+
+		// tombstones count against the load so probes stay short
+		if((_size + _deleted + 1) * MaxLoadDenominator
+			> _capacity * MaxLoadNumerator)
+		{
+			// grow only when the live entries need it, otherwise rehash
+			// at the same size to flush the tombstones
+			size_t newCapacity = _capacity;
+
+			if(2 * (_size + 1) * MaxLoadDenominator
+				> _capacity * MaxLoadNumerator)
+			{
+				newCapacity *= 2;
+			}
+
+			_rehash(newCapacity);
+		}
+	}
+
+	void _rehash(size_t newCapacity)
+	{
+		value_type*    oldSlots    = _slots;
+		unsigned char* oldStates   = _states;
+		size_t         oldCapacity = _capacity;
+
+		_slots = static_cast<value_type*>(
+			::operator new(newCapacity * sizeof(value_type)));
+		_states   = new unsigned char[newCapacity]();
+		_capacity = newCapacity;
+		_size     = 0;
+		_deleted  = 0;
+
+		for(size_t i = 0; i < oldCapacity; ++i)
+		{
+			if(oldStates[i] != Full) continue;
+
+			bool found = false;
+
+			size_t index = _findSlot(oldSlots[i].first, found);
+
+			new(_slots + index) value_type(std::move(oldSlots[i]));
+
+			_states[index] = Full;
+
+			++_size;
+
+			oldSlots[i].~value_type();
+		}
+
+		::operator delete(oldSlots);
+		delete[] oldStates;
+	}
+
+private:
+	value_type*    _slots;
+	unsigned char* _states;
+	size_t         _capacity;
+	size_t         _size;
+	size_t         _deleted;
 };
 
 }
 
 }
 
-
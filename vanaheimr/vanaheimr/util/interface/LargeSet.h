@@ -7,7 +7,10 @@
 #pragma once
 
 // Standard Library Includes
-#include <set>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -15,14 +18,338 @@ namespace vanaheimr
 namespace util
 {
 
+/*! \brief A class optimized to store a large unique set of objects.
+
+	The elements live in one flat open-addressing hash table with linear
+	probing, so a membership test is a hash and a short scan over
+	contiguous memory instead of a pointer chase through tree nodes, and
+	the only allocation is the slot array itself.  Erased slots are
+	tombstoned and reclaimed on the next rehash.  Iteration order follows
+	the table, not the element order. */
 template<typename T>
-class LargeSet : public std::set<T>
+class LargeSet
 {
+public:
+	typedef T value_type;
+
+public:
+	class const_iterator
+	{
+	public:
+		const_iterator() : _set(0), _index(0) {}
+
+	public:
+		const T& operator*()  const { return  _set->_slots[_index]; }
+		const T* operator->() const { return &_set->_slots[_index]; }
+
+		const_iterator& operator++()
+		{
+			_index = _set->_nextFull(_index + 1);
+
+			return *this;
+		}
+
+		bool operator==(const const_iterator& i) const
+		{
+			return _index == i._index;
+		}
+
+		bool operator!=(const const_iterator& i) const
+		{
+			return _index != i._index;
+		}
+
+	private:
+		const_iterator(const LargeSet* set, size_t index)
+		: _set(set), _index(index) {}
+
+	private:
+		const LargeSet* _set;
+		size_t          _index;
+
+		friend class LargeSet;
+	};
+
+	// set elements are keys, they are never mutated in place
+	typedef const_iterator iterator;
+
+public:
+	LargeSet() : _slots(0), _states(0), _capacity(0), _size(0), _deleted(0) {}
+
+	LargeSet(const LargeSet& s)
+	: _slots(0), _states(0), _capacity(0), _size(0), _deleted(0)
+	{
+		reserve(s.size());
+
+		for(const_iterator i = s.begin(); i != s.end(); ++i) insert(*i);
+	}
+
+	LargeSet& operator=(const LargeSet& s)
+	{
+		if(this == &s) return *this;
+
+		clear();
+		reserve(s.size());
+
+		for(const_iterator i = s.begin(); i != s.end(); ++i) insert(*i);
+
+		return *this;
+	}
+
+	~LargeSet()
+	{
+		clear();
+
+		::operator delete(_slots);
+		delete[] _states;
+	}
+
+public:
+	const_iterator begin() const { return const_iterator(this, _nextFull(0)); }
+	const_iterator end()   const { return const_iterator(this, _capacity);    }
+
+public:
+	size_t size()  const { return _size;      }
+	bool   empty() const { return _size == 0; }
+
+	void clear()
+	{
+		for(size_t i = 0; i < _capacity; ++i)
+		{
+			if(_states[i] == Full) _slots[i].~T();
+
+			_states[i] = Empty;
+		}
+
+		_size    = 0;
+		_deleted = 0;
+	}
+
+	/*! \brief Size the table for the expected element count up front, so
+		that filling it rehashes nothing */
+	void reserve(size_t expectedSize)
+	{
+		size_t needed = MinimumCapacity;
+
+		// grow until the expected elements fit under the load limit
+		while(needed * MaxLoadNumerator
+			< expectedSize * MaxLoadDenominator)
+		{
+			needed *= 2;
+		}
+
+		if(needed > _capacity) _rehash(needed);
+	}
+
+public:
+	std::pair<const_iterator, bool> insert(const T& value)
+	{
+		_growIfNeeded();
+
+		bool found = false;
+
+		size_t index = _findSlot(value, found);
+
+		if(found)
+		{
+			return std::make_pair(const_iterator(this, index), false);
+		}
+
+		if(_states[index] == Deleted) --_deleted;
+
+		new(_slots + index) T(value);
+
+		_states[index] = Full;
+
+		++_size;
+
+		return std::make_pair(const_iterator(this, index), true);
+	}
+
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		for(; first != last; ++first) insert(*first);
+	}
+
+public:
+	const_iterator find(const T& value) const
+	{
+		return const_iterator(this, _findExisting(value));
+	}
+
+	size_t count(const T& value) const
+	{
+		return _findExisting(value) == _capacity ? 0 : 1;
+	}
 
+public:
+	const_iterator erase(const_iterator position)
+	{
+		_eraseSlot(position._index);
+
+		return const_iterator(this, _nextFull(position._index + 1));
+	}
+
+	size_t erase(const T& value)
+	{
+		size_t index = _findExisting(value);
+
+		if(index == _capacity) return 0;
+
+		_eraseSlot(index);
+
+		return 1;
+	}
+
+private:
+	enum SlotState
+	{
+		Empty   = 0,
+		Full    = 1,
+		Deleted = 2
+	};
+
+	static const size_t MinimumCapacity    = 16;
+	static const size_t MaxLoadNumerator   = 7;
+	static const size_t MaxLoadDenominator = 10;
+
+private:
+	static size_t _hash(const T& value)
+	{
+		// spread the low bits before masking to a power of two table
+		return std::hash<T>()(value) * 0x9e3779b97f4a7c15ull;
+	}
+
+	size_t _nextFull(size_t index) const
+	{
+		while(index < _capacity && _states[index] != Full) ++index;
+
+		return index;
+	}
+
+	/*! \brief Probe for an element, reporting the matching slot or the
+		best slot to insert it into */
+	size_t _findSlot(const T& value, bool& found) const
+	{
+		size_t mask      = _capacity - 1;
+		size_t index     = _hash(value) & mask;
+		size_t insertion = _capacity;
+
+		while(true)
+		{
+			if(_states[index] == Empty)
+			{
+				found = false;
+
+				return insertion != _capacity ? insertion : index;
+			}
+
+			if(_states[index] == Deleted)
+			{
+				if(insertion == _capacity) insertion = index;
+			}
+			else if(_slots[index] == value)
+			{
+				found = true;
+
+				return index;
+			}
+
+			index = (index + 1) & mask;
+		}
+	}
+
+	size_t _findExisting(const T& value) const
+	{
+		if(_size == 0) return _capacity;
+
+		bool found = false;
+
+		size_t index = _findSlot(value, found);
+
+		return found ? index : _capacity;
+	}
+
+	void _eraseSlot(size_t index)
+	{
+		_slots[index].~T();
+
+		_states[index] = Deleted;
+
+		--_size;
+		++_deleted;
+	}
+
+	void _growIfNeeded()
+	{
+		if(_capacity == 0)
+		{
+			_rehash(MinimumCapacity);
+
+			return;
+		}
+
+		// tombstones count against the load so probes stay short
+		if((_size + _deleted + 1) * MaxLoadDenominator
+			> _capacity * MaxLoadNumerator)
+		{
+			// grow only when the live elements need it, otherwise rehash
+			// at the same size to flush the tombstones
+			size_t newCapacity = _capacity;
+
+			if(2 * (_size + 1) * MaxLoadDenominator
+				> _capacity * MaxLoadNumerator)
+			{
+				newCapacity *= 2;
+			}
+
+			_rehash(newCapacity);
+		}
+	}
+
+	void _rehash(size_t newCapacity)
+	{
+		T*             oldSlots    = _slots;
+		unsigned char* oldStates   = _states;
+		size_t         oldCapacity = _capacity;
+
+		_slots = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+		_states   = new unsigned char[newCapacity]();
+		_capacity = newCapacity;
+		_size     = 0;
+		_deleted  = 0;
+
+		for(size_t i = 0; i < oldCapacity; ++i)
+		{
+			if(oldStates[i] != Full) continue;
+
+			bool found = false;
+
+			size_t index = _findSlot(oldSlots[i], found);
+
+			new(_slots + index) T(std::move(oldSlots[i]));
+
+			_states[index] = Full;
+
+			++_size;
+
+			oldSlots[i].~T();
+		}
+
+		::operator delete(oldSlots);
+		delete[] oldStates;
+	}
+
+private:
+	T*             _slots;
+	unsigned char* _states;
+	size_t         _capacity;
+	size_t         _size;
+	size_t         _deleted;
 };
 
 }
 
 }
 
-
@@ -0,0 +1,34 @@
+/*! \file   NumaTopology.h
+	\date   Sunday August 30, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the NumaTopology class.
+*/
+
+#pragma once
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief The machine's memory node layout.
+
+	Parallel phases pin their workers to nodes so that the pages a
+	worker first touches stay local to the socket processing them,
+	instead of thrashing the interconnect on multi socket machines.
+	On systems without NUMA, or where the topology cannot be
+	discovered, there is a single node and pinning is a no-op */
+class NumaTopology
+{
+public:
+	/*! \brief The number of memory nodes, at least 1 */
+	static unsigned int nodeCount();
+
+	/*! \brief Restrict the calling thread to the processors of the node */
+	static void pinCurrentThreadToNode(unsigned int node);
+};
+
+}
+
+}
@@ -0,0 +1,271 @@
+/*! \file   ScopedHashTable.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the ScopedHashTable class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <vector>
+#include <functional>
+#include <cassert>
+#include <cstddef>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief An open-addressing hash table with nested scopes.
+
+	pushScope() opens a scope and popScope() undoes every insertion made
+	since the matching push, restoring shadowed values.  Lookups see all
+	entries of the active scopes.  Designed for dominator-tree walks
+	(value numbering, scoped renaming) where scope lifetimes nest
+	strictly, so deletions are always LIFO.
+
+	Insertion and lookup probe linearly over one flat array, erased
+	entries leave tombstones that are collected on rehash. */
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+	typename Equal = std::equal_to<Key>>
+class ScopedHashTable
+{
+public:
+	ScopedHashTable() : _entries(InitialCapacity), _size(0), _tombstones(0)
+	{
+
+	}
+
+	ScopedHashTable(const ScopedHashTable&) = delete;
+	ScopedHashTable& operator=(const ScopedHashTable&) = delete;
+
+public:
+	/*! \brief Open a new scope, insertions are undone when it closes */
+	void pushScope()
+	{
+		_scopeMarkers.push_back(_undoLog.size());
+	}
+
+	/*! \brief Close the current scope, undoing its insertions and
+		restoring values it shadowed */
+	void popScope()
+	{
+		assert(!_scopeMarkers.empty());
+
+		size_t marker = _scopeMarkers.back();
+
+		_scopeMarkers.pop_back();
+
+		while(_undoLog.size() > marker)
+		{
+			auto& undo = _undoLog.back();
+
+			auto entry = _find(undo.key);
+
+			assert(entry != nullptr);
+
+			if(undo.hadPreviousValue)
+			{
+				entry->value = undo.previousValue;
+			}
+			else
+			{
+				entry->state = Tombstone;
+
+				--_size;
+				++_tombstones;
+			}
+
+			_undoLog.pop_back();
+		}
+	}
+
+public:
+	/*! \brief Insert or overwrite a binding in the current scope */
+	void insert(const Key& key, const Value& value)
+	{
+		assert(!_scopeMarkers.empty());
+
+		if((_size + _tombstones) * 10 >= _entries.size() * 7)
+		{
+			_rehash();
+		}
+
+		auto entry = _findSlot(key);
+
+		if(entry->state == Occupied)
+		{
+			_undoLog.push_back(UndoRecord{key, entry->value, true});
+
+			entry->value = value;
+
+			return;
+		}
+
+		if(entry->state == Tombstone) --_tombstones;
+
+		entry->key   = key;
+		entry->value = value;
+		entry->state = Occupied;
+
+		++_size;
+
+		_undoLog.push_back(UndoRecord{key, Value(), false});
+	}
+
+	/*! \brief Find a binding visible in any active scope,
+		returns nullptr if there is none */
+	const Value* lookup(const Key& key) const
+	{
+		auto entry = const_cast<ScopedHashTable*>(this)->_find(key);
+
+		return entry == nullptr ? nullptr : &entry->value;
+	}
+
+public:
+	size_t size()  const { return _size;      }
+	bool   empty() const { return _size == 0; }
+
+	/*! \brief Discard all entries and scopes */
+	void clear()
+	{
+		_entries.assign(InitialCapacity, Entry());
+
+		_scopeMarkers.clear();
+		_undoLog.clear();
+
+		_size       = 0;
+		_tombstones = 0;
+	}
+
+private:
+	enum EntryState
+	{
+		Empty,
+		Occupied,
+		Tombstone
+	};
+
+	class Entry
+	{
+	public:
+		Entry() : state(Empty) {}
+
+	public:
+		Key        key;
+		Value      value;
+		EntryState state;
+	};
+
+	class UndoRecord
+	{
+	public:
+		Key   key;
+		Value previousValue;
+		bool  hadPreviousValue;
+	};
+
+	static const size_t InitialCapacity = 64;
+
+private:
+	Entry* _find(const Key& key)
+	{
+		size_t mask  = _entries.size() - 1;
+		size_t index = Hash()(key) & mask;
+
+		while(true)
+		{
+			auto& entry = _entries[index];
+
+			if(entry.state == Empty) return nullptr;
+
+			if(entry.state == Occupied && Equal()(entry.key, key))
+			{
+				return &entry;
+			}
+
+			index = (index + 1) & mask;
+		}
+	}
+
+	/*! \brief The slot holding the key, or the first free slot on its
+		probe path */
+	Entry* _findSlot(const Key& key)
+	{
+		size_t mask  = _entries.size() - 1;
+		size_t index = Hash()(key) & mask;
+
+		Entry* firstFree = nullptr;
+
+		while(true)
+		{
+			auto& entry = _entries[index];
+
+			if(entry.state == Empty)
+			{
+				return firstFree != nullptr ? firstFree : &entry;
+			}
+
+			if(entry.state == Tombstone)
+			{
+				if(firstFree == nullptr) firstFree = &entry;
+			}
+			else if(Equal()(entry.key, key))
+			{
+				return &entry;
+			}
+
+			index = (index + 1) & mask;
+		}
+	}
+
+	void _rehash()
+	{
+		std::vector<Entry> old(std::move(_entries));
+
+		// tombstones are dropped, only grow when actually full
+		size_t capacity = old.size();
+
+		if(_size * 10 >= capacity * 5) capacity *= 2;
+
+		_entries.assign(capacity, Entry());
+
+		size_t mask = capacity - 1;
+
+		for(auto& entry : old)
+		{
+			if(entry.state != Occupied) continue;
+
+			size_t index = Hash()(entry.key) & mask;
+
+			while(_entries[index].state == Occupied)
+			{
+				index = (index + 1) & mask;
+			}
+
+			_entries[index] = entry;
+		}
+
+		_tombstones = 0;
+	}
+
+private:
+	typedef std::vector<Entry>      EntryVector;
+	typedef std::vector<UndoRecord> UndoRecordVector;
+	typedef std::vector<size_t>     SizeVector;
+
+private:
+	EntryVector      _entries;
+	UndoRecordVector _undoLog;
+	SizeVector       _scopeMarkers;
+
+	size_t _size;
+	size_t _tombstones;
+};
+
+}
+
+}
+
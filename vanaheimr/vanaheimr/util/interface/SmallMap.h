@@ -6,8 +6,12 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallVector.h>
+
 // Standard Library Includes
-#include <map>
+#include <algorithm>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -17,15 +21,136 @@ namespace util
 
 
 /*! \brief A class optimized to store a small unique map of objects with
-	zero mallocs, it falls back on a std::map if the set grows large */
-template<typename Key, typename Value>
-class SmallMap : public std::map<Key, Value>
+	zero mallocs, it falls back on heap storage if the map grows large.
+
+	The entries are kept sorted by key in a SmallVector, lookups are a
+	binary search over contiguous storage, and iteration visits the
+	entries in key order, like std::map.  Insertions and removals shift
+	the tail of the array, which is cheap at the sizes this class is
+	meant for (renaming tables, live value maps, and the like). */
+template<typename Key, typename Value, unsigned int InlineCapacity = 4>
+class SmallMap
 {
-// TODO specialize
+public:
+	typedef std::pair<Key, Value> value_type;
+
+	typedef SmallVector<value_type, InlineCapacity> EntryVector;
+
+	typedef Key   key_type;
+	typedef Value mapped_type;
+
+	typedef typename EntryVector::iterator       iterator;
+	typedef typename EntryVector::const_iterator const_iterator;
+
+public:
+	iterator       begin()       { return _entries.begin(); }
+	const_iterator begin() const { return _entries.begin(); }
+	iterator       end()         { return _entries.end();   }
+	const_iterator end()   const { return _entries.end();   }
+
+public:
+	size_t size()  const { return _entries.size();  }
+	bool   empty() const { return _entries.empty(); }
+
+	void clear() { _entries.clear(); }
+
+public:
+	Value& operator[](const Key& key)
+	{
+		iterator position = _lowerBound(key);
+
+		if(position != end() && !(key < position->first))
+		{
+			return position->second;
+		}
+
+		position = _entries.insert(position, value_type(key, Value()));
+
+		return position->second;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& value)
+	{
+		iterator position = _lowerBound(value.first);
+
+		if(position != end() && !(value.first < position->first))
+		{
+			return std::make_pair(position, false);
+		}
+
+		position = _entries.insert(position, value);
+
+		return std::make_pair(position, true);
+	}
+
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		for(; first != last; ++first) insert(*first);
+	}
+
+public:
+	iterator find(const Key& key)
+	{
+		iterator position = _lowerBound(key);
+
+		if(position != end() && !(key < position->first)) return position;
+
+		return end();
+	}
+
+	const_iterator find(const Key& key) const
+	{
+		const_iterator position = _lowerBound(key);
+
+		if(position != end() && !(key < position->first)) return position;
+
+		return end();
+	}
+
+	size_t count(const Key& key) const
+	{
+		return find(key) == end() ? 0 : 1;
+	}
+
+public:
+	iterator erase(iterator position)
+	{
+		return _entries.erase(position);
+	}
+
+	size_t erase(const Key& key)
+	{
+		iterator position = find(key);
+
+		if(position == end()) return 0;
+
+		_entries.erase(position);
+
+		return 1;
+	}
+
+private:
+	static bool _compareKey(const value_type& entry, const Key& key)
+	{
+		return entry.first < key;
+	}
+
+	iterator _lowerBound(const Key& key)
+	{
+		return std::lower_bound(begin(), end(), key, _compareKey);
+	}
+
+	const_iterator _lowerBound(const Key& key) const
+	{
+		return std::lower_bound(begin(), end(), key, _compareKey);
+	}
+
+private:
+	EntryVector _entries;
 };
 
 }
 
 }
 
-
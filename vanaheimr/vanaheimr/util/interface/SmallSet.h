@@ -6,8 +6,12 @@
 
 #pragma once
 
+// Vanaheimr Includes
+#include <vanaheimr/util/interface/SmallVector.h>
+
 // Standard Library Includes
-#include <set>
+#include <algorithm>
+#include <utility>
 
 namespace vanaheimr
 {
@@ -17,15 +21,102 @@ namespace util
 
 
 /*! \brief A class optimized to store a small unique set of objects with
-	zero mallocs, it falls back on a std::set if the set grows large */
-template<typename T>
-class SmallSet : public std::set<T>
+	zero mallocs, it falls back on heap storage if the set grows large.
+
+	The elements are kept sorted in a SmallVector, so membership tests
+	are a binary search over contiguous storage and iteration visits the
+	elements in order, like std::set.  Insertions and removals shift the
+	tail of the array, which is cheap at the sizes this class is meant
+	for (dominance frontiers, def-use worklists, and the like). */
+template<typename T, unsigned int InlineCapacity = 8>
+class SmallSet
 {
-// TODO specialize
+public:
+	typedef SmallVector<T, InlineCapacity> ElementVector;
+
+	typedef T                                      value_type;
+	typedef typename ElementVector::iterator       iterator;
+	typedef typename ElementVector::const_iterator const_iterator;
+
+public:
+	iterator       begin()       { return _elements.begin(); }
+	const_iterator begin() const { return _elements.begin(); }
+	iterator       end()         { return _elements.end();   }
+	const_iterator end()   const { return _elements.end();   }
+
+public:
+	size_t size()  const { return _elements.size();  }
+	bool   empty() const { return _elements.empty(); }
+
+	void clear() { _elements.clear(); }
+
+public:
+	std::pair<iterator, bool> insert(const T& value)
+	{
+		iterator position = std::lower_bound(begin(), end(), value);
+
+		if(position != end() && !(value < *position))
+		{
+			return std::make_pair(position, false);
+		}
+
+		position = _elements.insert(position, value);
+
+		return std::make_pair(position, true);
+	}
+
+	template<typename Iterator>
+	void insert(Iterator first, Iterator last)
+	{
+		for(; first != last; ++first) insert(*first);
+	}
+
+public:
+	iterator find(const T& value)
+	{
+		iterator position = std::lower_bound(begin(), end(), value);
+
+		if(position != end() && !(value < *position)) return position;
+
+		return end();
+	}
+
+	const_iterator find(const T& value) const
+	{
+		const_iterator position = std::lower_bound(begin(), end(), value);
+
+		if(position != end() && !(value < *position)) return position;
+
+		return end();
+	}
+
+	size_t count(const T& value) const
+	{
+		return find(value) == end() ? 0 : 1;
+	}
+
+public:
+	iterator erase(iterator position)
+	{
+		return _elements.erase(position);
+	}
+
+	size_t erase(const T& value)
+	{
+		iterator position = find(value);
+
+		if(position == end()) return 0;
+
+		_elements.erase(position);
+
+		return 1;
+	}
+
+private:
+	ElementVector _elements;
 };
 
 }
 
 }
 
-
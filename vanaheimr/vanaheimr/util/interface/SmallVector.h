@@ -0,0 +1,206 @@
+/*! \file   SmallVector.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the SmallVector class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <new>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A vector with inline storage for a small number of elements.
+
+	Elements live inside the object until the inline capacity is
+	exceeded, at which point storage spills to the heap.  This avoids
+	any allocation for the common case (e.g. instruction operand lists,
+	95% of which hold three or fewer entries). */
+template<typename T, unsigned int InlineCapacity = 4>
+class SmallVector
+{
+public:
+	typedef T        value_type;
+	typedef T*       iterator;
+	typedef const T* const_iterator;
+
+public:
+	SmallVector()
+	: _begin(_inlineStorage()), _size(0), _capacity(InlineCapacity)
+	{
+
+	}
+
+	SmallVector(const SmallVector& v)
+	: _begin(_inlineStorage()), _size(0), _capacity(InlineCapacity)
+	{
+		reserve(v.size());
+
+		for(auto& element : v) push_back(element);
+	}
+
+	SmallVector& operator=(const SmallVector& v)
+	{
+		if(this == &v) return *this;
+
+		clear();
+		reserve(v.size());
+
+		for(auto& element : v) push_back(element);
+
+		return *this;
+	}
+
+	~SmallVector()
+	{
+		clear();
+
+		if(!_isInline()) ::operator delete(_begin);
+	}
+
+public:
+	iterator       begin()       { return _begin;         }
+	const_iterator begin() const { return _begin;         }
+	iterator       end()         { return _begin + _size; }
+	const_iterator end()   const { return _begin + _size; }
+
+public:
+	size_t size()     const { return _size;      }
+	bool   empty()    const { return _size == 0; }
+	size_t capacity() const { return _capacity;  }
+
+public:
+	      T& operator[](size_t index)       { return _begin[index]; }
+	const T& operator[](size_t index) const { return _begin[index]; }
+
+	      T* data()       { return _begin; }
+	const T* data() const { return _begin; }
+
+	      T& front()       { return _begin[0]; }
+	const T& front() const { return _begin[0]; }
+
+	      T& back()       { return _begin[_size - 1]; }
+	const T& back() const { return _begin[_size - 1]; }
+
+public:
+	void push_back(const T& element)
+	{
+		if(_size == _capacity) reserve(_capacity * 2);
+
+		new(_begin + _size) T(element);
+
+		++_size;
+	}
+
+	void pop_back()
+	{
+		assert(_size != 0);
+
+		_begin[--_size].~T();
+	}
+
+	iterator insert(iterator position, const T& element)
+	{
+		size_t offset = position - _begin;
+
+		push_back(element);
+
+		for(size_t i = _size - 1; i > offset; --i)
+		{
+			std::swap(_begin[i], _begin[i - 1]);
+		}
+
+		return _begin + offset;
+	}
+
+	template<typename Iterator>
+	iterator insert(iterator position, Iterator first, Iterator last)
+	{
+		size_t offset = position - _begin;
+
+		for(size_t inserted = 0; first != last; ++first, ++inserted)
+		{
+			insert(_begin + offset + inserted, *first);
+		}
+
+		return _begin + offset;
+	}
+
+	iterator erase(iterator position)
+	{
+		assert(position >= _begin && position < end());
+
+		for(iterator next = position + 1; next != end(); ++next)
+		{
+			*(next - 1) = std::move(*next);
+		}
+
+		pop_back();
+
+		return position;
+	}
+
+	void clear()
+	{
+		for(size_t i = 0; i < _size; ++i) _begin[i].~T();
+
+		_size = 0;
+	}
+
+	void resize(size_t newSize, const T& element = T())
+	{
+		while(_size > newSize) pop_back();
+
+		reserve(newSize);
+
+		while(_size < newSize) push_back(element);
+	}
+
+	void reserve(size_t newCapacity)
+	{
+		if(newCapacity <= _capacity) return;
+
+		T* storage = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+
+		for(size_t i = 0; i < _size; ++i)
+		{
+			new(storage + i) T(std::move(_begin[i]));
+			_begin[i].~T();
+		}
+
+		if(!_isInline()) ::operator delete(_begin);
+
+		_begin    = storage;
+		_capacity = newCapacity;
+	}
+
+private:
+	T* _inlineStorage()
+	{
+		return reinterpret_cast<T*>(_storage);
+	}
+
+	bool _isInline() const
+	{
+		return _begin == reinterpret_cast<const T*>(_storage);
+	}
+
+private:
+	T*     _begin;
+	size_t _size;
+	size_t _capacity;
+
+	alignas(T) char _storage[InlineCapacity * sizeof(T)];
+};
+
+}
+
+}
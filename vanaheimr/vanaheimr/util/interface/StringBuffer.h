@@ -0,0 +1,64 @@
+/*! \file   StringBuffer.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StringBuffer class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include <cstdint>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief An append-only character buffer with direct formatting routines.
+
+	Writers batch their output here and flush it to a stream in one call,
+	avoiding the locale machinery and per-insert virtual dispatch of
+	std::ostream formatting. */
+class StringBuffer
+{
+public:
+	StringBuffer();
+
+public:
+	void append(char character);
+	void append(const char* text);
+	void append(const char* begin, const char* end);
+	void append(const std::string& text);
+
+	/*! \brief Format a decimal integer directly into the buffer */
+	void appendInteger(int64_t value);
+	void appendInteger(uint64_t value);
+
+	/*! \brief Format a hexadecimal integer, without a base prefix */
+	void appendHex(uint64_t value);
+
+	/*! \brief Format a float with ostream-equivalent default precision */
+	void appendFloat(double value);
+
+public:
+	const char* data()  const;
+	size_t      size()  const;
+	bool        empty() const;
+
+	void clear();
+
+	/*! \brief Write the contents to a stream in one call and clear */
+	void flush(std::ostream& stream);
+
+private:
+	std::vector<char> _data;
+};
+
+}
+
+}
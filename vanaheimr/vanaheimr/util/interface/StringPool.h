@@ -0,0 +1,69 @@
+/*! \file   StringPool.h
+	\date   Friday August 28, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StringPool class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief An interning pool that maps each distinct string to a stable
+	32-bit id.  Interned strings are stored exactly once, so id comparison
+	replaces byte-wise string comparison and map keys shrink to one word.
+
+	Interning is guarded by a mutex, worker threads creating values
+	concurrently share one pool safely. */
+class StringPool
+{
+public:
+	typedef unsigned int StringId;
+
+public:
+	static const StringId InvalidStringId = (StringId)-1;
+
+public:
+	StringPool();
+
+	StringPool(const StringPool&) = delete;
+	StringPool& operator=(const StringPool&) = delete;
+
+public:
+	/*! \brief Intern a string, returning its stable id */
+	StringId intern(const std::string& string);
+
+	/*! \brief Look up an id without interning,
+		returns InvalidStringId if the string was never interned */
+	StringId lookup(const std::string& string) const;
+
+	/*! \brief Get the string for a previously interned id */
+	const std::string& string(StringId id) const;
+
+public:
+	size_t size()  const;
+	bool   empty() const;
+
+private:
+	typedef std::unordered_map<std::string, StringId> StringToIdMap;
+	typedef std::deque<const std::string*>            IdToStringVector;
+
+private:
+	StringToIdMap    _ids;
+	IdToStringVector _strings;
+
+	mutable std::mutex _mutex;
+};
+
+}
+
+}
@@ -0,0 +1,95 @@
+/*! \file   StringRef.h
+	\date   Saturday August 29, 2026
+	\author Gregory Diamos <solusstultus@gmail.com>
+	\brief  The header file for the StringRef class.
+*/
+
+#pragma once
+
+// Standard Library Includes
+#include <string>
+#include <ostream>
+
+namespace vanaheimr
+{
+
+namespace util
+{
+
+/*! \brief A non-owning reference to a range of characters.
+
+	The referenced characters are not copied and are not guaranteed to be
+	null terminated, so comparisons and slicing never allocate.  The owner
+	of the underlying storage must outlive the reference. */
+class StringRef
+{
+public:
+	static const size_t npos = (size_t)-1;
+
+public:
+	StringRef();
+	StringRef(const char* data, size_t size);
+	StringRef(const char* cString);
+	StringRef(const std::string& string);
+
+public:
+	const char* data() const;
+	size_t      size() const;
+	bool       empty() const;
+
+public:
+	char operator[](size_t index) const;
+
+	char front() const;
+	char back()  const;
+
+	const char* begin() const;
+	const char* end()   const;
+
+public:
+	/*! \brief Get a reference to a substring, no copy is made */
+	StringRef substr(size_t position, size_t length = npos) const;
+
+	size_t find(char character, size_t position = 0) const;
+	size_t find(const StringRef& string, size_t position = 0) const;
+
+public:
+	int compare(const StringRef& string) const;
+
+	bool operator==(const StringRef& string) const;
+	bool operator!=(const StringRef& string) const;
+	bool operator==(const char* string) const;
+	bool operator!=(const char* string) const;
+	bool operator==(const std::string& string) const;
+	bool operator!=(const std::string& string) const;
+
+	bool operator<(const StringRef& string) const;
+
+public:
+	/*! \brief Copy the referenced characters into an owning string */
+	std::string str() const;
+
+	operator std::string() const;
+
+private:
+	const char* _data;
+	size_t      _size;
+
+};
+
+bool operator==(const char* left, const StringRef& right);
+bool operator!=(const char* left, const StringRef& right);
+bool operator==(const std::string& left, const StringRef& right);
+bool operator!=(const std::string& left, const StringRef& right);
+
+std::string operator+(const std::string& left, const StringRef& right);
+std::string operator+(const StringRef& left, const std::string& right);
+std::string operator+(const char* left, const StringRef& right);
+std::string operator+(const StringRef& left, const char* right);
+
+std::ostream& operator<<(std::ostream& stream, const StringRef& string);
+
+}
+
+}
+